@@ -2,6 +2,8 @@ import bpy
 import bpy_extras
 import math
 import json
+import os
+import struct
 
 # オペレータ シーン出力
 class MYADDON_OT_export_scene(bpy.types.Operator, bpy_extras.io_utils.ExportHelper):
@@ -11,6 +13,27 @@ class MYADDON_OT_export_scene(bpy.types.Operator, bpy_extras.io_utils.ExportHelp
     #出力するファイルの拡張子
     filename_ext = ".json"
 
+    #バイナリレベル(.level)も出力するか
+    use_binary: bpy.props.BoolProperty(
+        name = "バイナリ出力",
+        description = "JSONと同じ名前でバイナリレベル(.level)も出力します",
+        default = False,
+    )
+
+    #バイナリレベルに書き込むモデルのディレクトリ名 (Resources/Models以下)
+    model_directory: bpy.props.StringProperty(
+        name = "モデルのディレクトリ",
+        description = "バイナリレベルに書き込むモデルのディレクトリ名 (Resources/Models以下)",
+        default = "Levels",
+    )
+
+    #バイナリレベルのファイル識別子 "LEVL" (エンジンのLevelFileFormatと揃える)
+    LEVEL_MAGIC = 0x4C56454C
+    #バイナリレベルのバージョン (エンジンのLevelFileFormat::kVersionと揃える)
+    LEVEL_VERSION = 1
+    #モデルのベースディレクトリ (エンジンのModelManagerと揃える)
+    MODEL_BASE_DIRECTORY = "Resources/Models"
+
     def write_and_print(self, file, str):
         print(str)
 
@@ -172,6 +195,136 @@ class MYADDON_OT_export_scene(bpy.types.Operator, bpy_extras.io_utils.ExportHelp
             #ファイルに文字列を書き込む
             file.write(json_text)
 
+    def make_asset_id(self, path):
+        """エンジンのAssetRegistry::MakeIDと同じFNV-1a 64bitハッシュ"""
+
+        hash = 14695981039346656037
+        #区切り文字は'/'に揃える
+        for c in path.replace("\\", "/").encode("utf-8"):
+            hash ^= c
+            hash = (hash * 1099511628211) & 0xFFFFFFFFFFFFFFFF
+
+        #無効IDとは被らないようにする
+        return 1 if hash == 0 else hash
+
+    def add_string(self, data, text):
+        """文字列テーブルに追加して(位置, 長さ)を返す"""
+
+        encoded = text.encode("utf-8")
+        offset = len(data["strings"])
+        data["strings"] += encoded
+        return offset, len(encoded)
+
+    def parse_scene_recursive_binary(self, data, object):
+        """バイナリレベル用の再帰関数 (エンジンのLoaderと同じ規則で変換して詰める)"""
+
+        #無効なオブジェクトは子ごと出力しない
+        if "disabled" in object and object["disabled"]:
+            return
+
+        #オブジェクトの種類
+        if "type" in object: #カスタムプロパティで指定された場合
+            object_type = object["type"]
+        else:
+            object_type = object.type
+
+        #ローカルトランスフォーム行列から平行移動、回転、スケーリングを抽出
+        trans, rot, scale = object.matrix_local.decompose()
+        rot = rot.to_euler()
+
+        #エンジンの座標系に合わせてYとZを入れ替える (回転はラジアンのまま)
+        translation = (trans.x, trans.z, trans.y)
+        rotation = (rot.x, rot.z, rot.y)
+        scaling = (scale.x, scale.z, scale.y)
+
+        if object_type == "MESH":
+
+            #モデルテーブルに登録 (同じモデルは1つにまとめる)
+            if object.name not in data["model_indices"]:
+                name_offset, name_length = self.add_string(data, object.name)
+                path = "%s/%s/%s.obj" % (self.MODEL_BASE_DIRECTORY, self.model_directory, object.name)
+                data["model_indices"][object.name] = len(data["models"])
+                data["models"].append(struct.pack("<QIIII", self.make_asset_id(path), data["directory"][0], data["directory"][1], name_offset, name_length))
+
+            #コライダー (今はBOXのみ)
+            collider_type = 0
+            collider_center = (0.0, 0.0, 0.0)
+            collider_size = (0.0, 0.0, 0.0)
+            if "collider" in object and object["collider"] == "BOX":
+                collider_type = 1
+                center = object["collider_center"]
+                size = object["collider_size"]
+                collider_center = (center[0], center[2], center[1])
+                collider_size = (size[0], size[2], size[1])
+
+            data["objects"].append(struct.pack("<3f3f3fII3f3f", *translation, *rotation, *scaling, data["model_indices"][object.name], collider_type, *collider_center, *collider_size))
+
+        elif object_type == "PlayerSpawn":
+            data["players"].append(struct.pack("<3f3f", *translation, *rotation))
+
+        elif object_type == "EnemySpawn":
+            data["enemies"].append(struct.pack("<3f3f", *translation, *rotation))
+
+        #子ノードへ進む
+        for child in object.children:
+            self.parse_scene_recursive_binary(data, child)
+
+    def export_binary(self):
+        """バイナリ形式でファイルに出力"""
+
+        #JSONと同じ名前で拡張子だけ変える
+        filepath = os.path.splitext(self.filepath)[0] + ".level"
+
+        print("バイナリレベル出力開始... %r" % filepath)
+
+        #書き出す内容をまとめるdict
+        data = dict()
+        data["models"] = list()
+        data["model_indices"] = dict()
+        data["objects"] = list()
+        data["players"] = list()
+        data["enemies"] = list()
+        data["strings"] = bytearray()
+
+        #モデルのディレクトリ名は全モデル共通なので先に文字列テーブルに入れておく
+        data["directory"] = self.add_string(data, self.model_directory)
+
+        #シーン内の全オブジェクトについて
+        for object in bpy.context.scene.objects:
+
+            #親オブジェクトがあるものはスキップ(代わりに親から呼び出すから)
+            if(object.parent):
+                continue
+
+            self.parse_scene_recursive_binary(data, object)
+
+        #各配列の位置を計算 (ヘッダーの直後から順に並べる)
+        header_size = 72
+        model_offset = header_size
+        object_offset = model_offset + 24 * len(data["models"])
+        player_offset = object_offset + 68 * len(data["objects"])
+        enemy_offset = player_offset + 24 * len(data["players"])
+        string_table_offset = enemy_offset + 24 * len(data["enemies"])
+
+        #ヘッダー
+        header = struct.pack("<8I5Q",
+            self.LEVEL_MAGIC, self.LEVEL_VERSION,
+            len(data["models"]), len(data["objects"]), len(data["players"]), len(data["enemies"]),
+            len(data["strings"]), 0,
+            model_offset, object_offset, player_offset, enemy_offset, string_table_offset)
+
+        #ファイルをバイナリ形式で書き出し用にオープン
+        with open(filepath, "wb") as file:
+
+            file.write(header)
+            file.write(b"".join(data["models"]))
+            file.write(b"".join(data["objects"]))
+            file.write(b"".join(data["players"]))
+            file.write(b"".join(data["enemies"]))
+            file.write(data["strings"])
+
+        print("バイナリレベル出力完了 (オブジェクト %d 個)" % len(data["objects"]))
+
     def execute(self, context):
 
         print("シーン情報をExportします")
@@ -179,6 +332,10 @@ class MYADDON_OT_export_scene(bpy.types.Operator, bpy_extras.io_utils.ExportHelp
         #ファイルに出力
         self.export_json()
 
+        #バイナリレベルも出力
+        if self.use_binary:
+            self.export_binary()
+
         self.report({'INFO'}, "シーン情報をExportしました")
         print("シーン情報をExportしました")
 
@@ -1,34 +1,31 @@
 #include "Sprite.h"
 #include "MathMatrix.h"
-#include "WinApp.h"
-#include "DirectXUtility.h"
+#include "MathVector.h"
+#include "SpriteRenderer.h"
 #include "Texture/TextureManager.h"
 
+#include <algorithm>
+#include <cfloat>
 #include <imgui.h>
 
 using namespace Engine;
 using namespace MathMatrix;
+using namespace MathVector;
 
 void Sprite::Initialize(const std::string relativePath) {
 
-	// DirectXUtilityのインスタンスを取得
-	dxUtility = DirectXUtility::GetInstance();
-
 	// TextureManagerのインスタンスを取得
 	textureManager = TextureManager::GetInstance();
 
+	// SpriteRendererのインスタンスを取得
+	spriteRenderer = SpriteRenderer::GetInstance();
+
 	// TextureManagerからベースディレクトリパスを取得してフルパスを作成
 	std::string fullPath = textureManager->GetBaseDirectoryPath() + "/" + relativePath;
 
 	// 画像を設定
 	SetTexture(fullPath);
 
-	InitializeVertexData();
-
-	InitializeTransformationMatrixData();
-
-	InitializeMaterialData();
-
 	AdjustTextureSize();
 }
 
@@ -57,12 +54,15 @@ void Sprite::Update() {
 
 	/// === テクスチャ範囲反映 === ///
 
-	float texLeft = textureLeftTop.x / metadata.width;
-	float texRight = (textureLeftTop.x + textureSize.x) / metadata.width;
-	float texTop = textureLeftTop.y / metadata.height;
-	float texBottom = (textureLeftTop.y + textureSize.y) / metadata.height;
+	// アトラスに入っている画像なら、切り出し範囲をアトラス内の位置にずらす
+	Vector2 leftTop = atlasLeftTop + textureLeftTop;
+
+	float texLeft = leftTop.x / metadata.width;
+	float texRight = (leftTop.x + textureSize.x) / metadata.width;
+	float texTop = leftTop.y / metadata.height;
+	float texBottom = (leftTop.y + textureSize.y) / metadata.height;
 
-	/// === VertexResourceにデータを書き込む(4頂点) === ///
+	/// === 頂点データを書き込む(4頂点) === ///
 	
 	// 左下
 	vertexData[0].position = { left, bottom, 0.0f, 1.0f };
@@ -77,49 +77,48 @@ void Sprite::Update() {
 	vertexData[3].position = { right, top, 0.0f, 1.0f };
 	vertexData[3].texcoord = { texRight, texTop };
 
-	/// === IndexResourceにデータを書き込む(6個分)=== ///
-
-	indexData[0] = 0; // 左下
-	indexData[1] = 1; // 左上
-	indexData[2] = 2; // 右下
-	indexData[3] = 1; // 左上
-	indexData[4] = 3; // 右上
-	indexData[5] = 2; // 右下
-
 	/// === Transform情報を作る === ///
 	Transform transform{ {size.x, size.y, 1.0f}, {0.0f, 0.0f, rotation}, {position.x, position.y, 0.0f} };
 	
 	/// === TransformからWorldMatrixを作る === ///
 	Matrix4x4 worldMatrix = MakeAffineMatrix(transform.scale, transform.rotate, transform.translate);
 
-	/// === ViewMatrixを作って単位行列を代入 === ///
-	Matrix4x4 viewMatrix = MakeIdentity4x4();
+	/// === WorldMatrixに平行投影行列を掛ける (平行投影行列はSpriteRendererで1度だけ作ったもの) === ///
+	Matrix4x4 worldViewProjectionMatrix = Multiply(worldMatrix, spriteRenderer->GetProjectionMatrix());
 
-	/// === ProjectionMatrixを作って平行投影行列を書き込む === ///
-	Matrix4x4 projectionMatrix = MakeOrthographicMatrix(0.0f, 0.0f, float(WinApp::kClientWidth), float(WinApp::kClientHeight), 0.0f, 100.0f);
+	/// === 4頂点をクリップ空間に変換する === ///
 
-	transformationMatrixData->WVP = Multiply(worldMatrix, Multiply(viewMatrix, projectionMatrix));
-}
-
-void Sprite::Draw() {
+	// 変換した範囲 (画面外の判定に使う)
+	float minX = FLT_MAX, maxX = -FLT_MAX, minY = FLT_MAX, maxY = -FLT_MAX;
+	for (SpriteBatch::Vertex& vertex : vertexData) {
+		Vector3 clipPosition = MathVector::Transform({ vertex.position.x, vertex.position.y, vertex.position.z }, worldViewProjectionMatrix);
+		vertex.position = { clipPosition.x, clipPosition.y, clipPosition.z, 1.0f };
+		minX = (std::min)(minX, clipPosition.x);
+		maxX = (std::max)(maxX, clipPosition.x);
+		minY = (std::min)(minY, clipPosition.y);
+		maxY = (std::max)(maxY, clipPosition.y);
+	}
 
-	/// === VertexBufferViewを設定 === ///
-	dxUtility->GetCommandList()->IASetVertexBuffers(0, 1, &vertexBufferView);
+	/// === 画面外か判定する === ///
 
-	/// === IndexBufferViewを設定 === ///
-	dxUtility->GetCommandList()->IASetIndexBuffer(&indexBufferView);
+	// 全ての頂点が画面の同じ辺の外側にあれば画面外
+	isOffscreen = maxX < -1.0f || 1.0f < minX || maxY < -1.0f || 1.0f < minY;
+}
 
-	/// === 座標変換行列CBufferの場所を設定 === ///
-	dxUtility->GetCommandList()->SetGraphicsRootConstantBufferView(0, transformationMatrixResource->GetGPUVirtualAddress());
+void Sprite::Draw() {
 
-	/// === マテリアルCBufferの場所を設定 === ///
-	dxUtility->GetCommandList()->SetGraphicsRootConstantBufferView(1, materialResource->GetGPUVirtualAddress());
+	// 画面外なら描画しない
+	if (isOffscreen) {
+		return;
+	}
 
-	/// === SRVのDescriptorTableの先頭を設定 === ///
-	dxUtility->GetCommandList()->SetGraphicsRootDescriptorTable(2, textureManager->GetSRVGPUHandle(textureSrvIndex));
+	// 色は描画直前の値を使う (更新の後に色だけ変えることがあるので)
+	for (SpriteBatch::Vertex& vertex : vertexData) {
+		vertex.color = color;
+	}
 
-	/// === 描画(DrawCall) === ///
-	dxUtility->GetCommandList()->DrawIndexedInstanced(6, 1, 0, 0, 0);
+	// バッチに追加する (レイヤー順に並べ、同じテクスチャが続く分をまとめて描画する)
+	spriteRenderer->AddQuad(textureSrvIndex, layer, vertexData);
 }
 
 void Sprite::ShowImGui(const char* name) {
@@ -135,12 +134,13 @@ void Sprite::ShowImGui(const char* name) {
 	}
 
 	if (ImGui::TreeNode("Other")) {
-		ImGui::ColorEdit4("Color", &materialData->color.x); // 色
+		ImGui::ColorEdit4("Color", &color.x); // 色
 		ImGui::SliderFloat2("Anchor", &anchorPoint.x, -1.0f, 1.0f); // アンカー
 		ImGui::Checkbox("IsFlipX", &isFlipX); // フリップ
 		ImGui::Checkbox("IsFlipY", &isFlipY); // フリップ
 		ImGui::DragFloat2("TextureLeftTop", &textureLeftTop.x, 1.0f); // テクスチャ左上座標
 		ImGui::DragFloat2("TextureSize", &textureSize.x, 1.0f); // テクスチャ切り出しサイズ
+		ImGui::InputInt("Layer", &layer); // レイヤー
 		ImGui::TreePop();
 	}
 
@@ -150,74 +150,39 @@ void Sprite::ShowImGui(const char* name) {
 
 void Sprite::SetTexture(const std::string fullPath) {
 
-	// TextureManagerからSRVインデックスを取得
-	textureSrvIndex = textureManager->GetTextureIndexByFilePath(fullPath);
+	// アトラスに入っている画像ならアトラスのテクスチャを使う
+	const TextureAtlas& atlas = spriteRenderer->GetAtlas();
+	const TextureAtlas::Region* region = atlas.Find(fullPath);
 
-	// TextureManagerから画像のメタデータ取得
-	metadata = textureManager->GetMetadata(fullPath);
-}
-
-void Sprite::InitializeVertexData() {
-
-	/// === VertexResourceを作る === ///
-	vertexResource = dxUtility->CreateBufferResource(sizeof(VertexData) * 6);
-
-	/// === IndexResourceを作る === ///
-	indexResource = dxUtility->CreateBufferResource(sizeof(uint32_t) * 6);
-
-	/// === VBVを作成する(値を設定するだけ) === ///
-
-	// リソースの先頭アドレスから使う
-	vertexBufferView.BufferLocation = vertexResource->GetGPUVirtualAddress();
-	// 使用するリソースのサイズは頂点6つ分のサイズ
-	vertexBufferView.SizeInBytes = sizeof(VertexData) * 6;
-	// 1頂点あたりのサイズ　
-	vertexBufferView.StrideInBytes = sizeof(VertexData);
-
-	/// === IBVを作成する(値を設定するだけ) === ///
-
-	// リソースの先頭のアドレスから使う
-	indexBufferView.BufferLocation = indexResource->GetGPUVirtualAddress();
-	// 使用するリソースのサイズはインデックス6つ分のサイズ
-	indexBufferView.SizeInBytes = sizeof(uint32_t) * 6;
-	// インデックスはuint32_tとする
-	indexBufferView.Format = DXGI_FORMAT_R32_UINT;
+	if (region) {
 
-	/// === VertexResourceにデータを書き込むためのアドレスを取得してVertexDataに割り当てる === ///
-	vertexResource->Map(0, nullptr, reinterpret_cast<void**>(&vertexData));
+		// TextureManagerからアトラスのテクスチャを参照
+		textureHandle = textureManager->AcquireTexture(atlas.GetTexturePath());
 
-	/// === IndexResourceにデータを書き込むためのアドレスを取得してindexDataに割り当てる === ///
-	indexResource->Map(0, nullptr, reinterpret_cast<void**>(&indexData));
-}
-
-void Sprite::InitializeTransformationMatrixData() {
-
-	/// === TransformationMatrixResourceを作る === ///
-	transformationMatrixResource = dxUtility->CreateBufferResource(sizeof(TransformationMatrix));
-
-	/// === TransformationMatrixResourceにデータを書き込むためのアドレスを取得してtransformationMatrixDataに割り当てる === ///
-	transformationMatrixResource->Map(0, nullptr, reinterpret_cast<void**>(&transformationMatrixData));
-
-	/// === TransformationMatrixDataの初期値を書き込む === ///
-	transformationMatrixData->WVP = MakeIdentity4x4(); // 単位行列を書き込む
-}
+		// アトラス内の位置と元の画像のサイズ
+		atlasLeftTop = region->leftTop;
+		sourceSize = region->size;
+	}
+	else {
 
-void Sprite::InitializeMaterialData() {
+		// TextureManagerからテクスチャを参照
+		textureHandle = textureManager->AcquireTexture(fullPath);
 
-	/// === MaterialResourceを作る === ///
-	materialResource = dxUtility->CreateBufferResource(sizeof(Material));
+		// 元の画像をそのまま使う
+		atlasLeftTop = { 0.0f, 0.0f };
+		sourceSize = { static_cast<float>(textureHandle->metaData.width), static_cast<float>(textureHandle->metaData.height) };
+	}
 
-	/// === MaterialResourceにデータを書き込むためのアドレスを取得してmaterialDataに割り当てる === ///
-	materialResource->Map(0, nullptr, reinterpret_cast<void**>(&materialData));
+	// SRVインデックスを取得
+	textureSrvIndex = textureHandle->srvIndex;
 
-	/// === MaterialDataの初期値を書き込む === ///
-	materialData->color = Vector4(1.0f, 1.0f, 1.0f, 1.0f); // 白を書き込む
+	// 画像のメタデータ取得
+	metadata = textureHandle->metaData;
 }
 
 void Sprite::AdjustTextureSize() {
 
-	textureSize.x = static_cast<float>(metadata.width);
-	textureSize.y = static_cast<float>(metadata.height);
+	textureSize = sourceSize;
 
 	// 画像サイズをテクスチャサイズにあわせる
 	size = textureSize;
@@ -4,6 +4,8 @@
 #include "Vector3.h"
 #include "Vector4.h"
 #include "Matrix4x4.h"
+#include "Texture/TextureManager.h"
+#include "SpriteBatch.h"
 
 #include <string>
 #include <DirectXTex.h>
@@ -13,8 +15,8 @@
 namespace Engine {
 
 	/// === 前方宣言 === ///
-	class DirectXUtility;
 	class TextureManager;
+	class SpriteRenderer;
 
 	// スプライト
 	class Sprite {
@@ -36,7 +38,7 @@ namespace Engine {
 		void Update();
 
 		/// <summary>
-		/// 描画
+		/// 描画 (SpriteRendererのバッチに四角形を追加する。実際の描画はSpriteRenderer::Flushでまとめて行う)
 		/// </summary>
 		void Draw();
 
@@ -47,7 +49,7 @@ namespace Engine {
 		void ShowImGui(const char* name);
 
 		/// <summary>
-		/// テクスチャの設定
+		/// テクスチャの設定 (アトラスに入っている画像ならアトラスのテクスチャを使う)
 		/// </summary>
 		/// <param name="fullPath">フルパス</param>
 		void SetTexture(const std::string fullPath);
@@ -57,21 +59,6 @@ namespace Engine {
 		///-------------------------------------------///
 	private:
 
-		/// <summary>
-		/// 頂点データ初期化
-		/// </summary>
-		void InitializeVertexData();
-
-		/// <summary>
-		/// 座標変換行列データ初期化
-		/// </summary>
-		void InitializeTransformationMatrixData();
-
-		/// <summary>
-		/// マテリアルデータ初期化
-		/// </summary>
-		void InitializeMaterialData();
-
 		/// <summary>
 		/// テクスチャサイズをイメージに合わせる
 		/// </summary>
@@ -104,7 +91,7 @@ namespace Engine {
 		/// 色のゲッター
 		/// </summary>
 		/// <returns>color</returns>
-		const Vector4& GetColor()const { return materialData->color; }
+		const Vector4& GetColor()const { return color; }
 
 		/// <summary>
 		/// アンカーのゲッター
@@ -136,6 +123,12 @@ namespace Engine {
 		/// <returns>textureSize</returns>
 		const Vector2& GetTextureSize()const { return textureSize; }
 
+		/// <summary>
+		/// レイヤーのゲッター
+		/// </summary>
+		/// <returns>layer</returns>
+		int32_t GetLayer()const { return layer; }
+
 		///-------------------------------------------/// 
 		/// セッター
 		///-------------------------------------------///
@@ -163,7 +156,7 @@ namespace Engine {
 		/// 色のセッター
 		/// </summary>
 		/// <param name="color">color</param>
-		void SetColor(const Vector4& color) { materialData->color = color; }
+		void SetColor(const Vector4& color) { this->color = color; }
 
 		/// <summary>
 		/// アンカーのセッター
@@ -195,6 +188,12 @@ namespace Engine {
 		/// <param name="textureSize">textureSize</param>
 		void SetTextureSize(const Vector2& textureSize) { this->textureSize = textureSize; }
 
+		/// <summary>
+		/// レイヤーのセッター (小さい方から描く。同じレイヤーは描画を呼んだ順)
+		/// </summary>
+		/// <param name="layer">layer</param>
+		void SetLayer(int32_t layer) { this->layer = layer; }
+
 		///-------------------------------------------/// 
 		/// 構造体
 		///-------------------------------------------///
@@ -207,21 +206,6 @@ namespace Engine {
 			Vector3 translate;
 		};
 
-		// 頂点データ
-		struct VertexData {
-			Vector4 position;
-			Vector2 texcoord;
-		};
-
-		// 座標変換行列
-		struct TransformationMatrix {
-			Matrix4x4 WVP;
-		};
-
-		// マテリアルデータ
-		struct Material {
-			Vector4 color;
-		};
 
 		///-------------------------------------------/// 
 		/// メンバ変数 
@@ -246,49 +230,47 @@ namespace Engine {
 		// 上下フリップ
 		bool isFlipY = false;
 
+		// 色
+		Vector4 color = { 1.0f,1.0f,1.0f,1.0f };
+
+		// レイヤー
+		int32_t layer = 0;
+
+		// 画面外か (更新時に判定し、画面外なら描画しない)
+		bool isOffscreen = false;
+
 		// テクスチャ左上座標
 		Vector2 textureLeftTop = { 0.0f,0.0f };
 
 		// テクスチャの元のサイズ
 		Vector2 textureSize = { 0.0f,0.0f };
 
-		// メタデータ
+		// 元の画像のアトラス内の左上座標 (アトラスに入っていなければ0)
+		Vector2 atlasLeftTop = { 0.0f,0.0f };
+
+		// 元の画像のサイズ (アトラスに入っていてもアトラスではなく元の画像のサイズ)
+		Vector2 sourceSize = { 0.0f,0.0f };
+
+		// メタデータ (アトラスに入っている画像ならアトラスのもの)
 		DirectX::TexMetadata metadata;
 
 		/// ===== ポインタ・インスタンス ===== ///
 
-		// DirectXUtilityのインスタンス
-		DirectXUtility* dxUtility = nullptr;
-
 		// TextureManagerのインスタンス
 		TextureManager* textureManager = nullptr;
 
+		// SpriteRendererのインスタンス
+		SpriteRenderer* spriteRenderer = nullptr;
+
 		/// ===== GPU用の変数 ===== ///
 
-		// 頂点リソース
-		Microsoft::WRL::ComPtr<ID3D12Resource> vertexResource;
-		// 参照リソース
-		Microsoft::WRL::ComPtr<ID3D12Resource> indexResource;
-		// 座標変換行列リソース
-		Microsoft::WRL::ComPtr<ID3D12Resource> transformationMatrixResource;
-		// マテリアルリソース
-		Microsoft::WRL::ComPtr<ID3D12Resource> materialResource;
-
-		// 頂点データ
-		VertexData* vertexData = nullptr;
-		// 参照データ
-		uint32_t* indexData = nullptr;
-		// 座標変換行列データ
-		TransformationMatrix* transformationMatrixData = nullptr;
-		// マテリアルデータ
-		Material* materialData = nullptr;
-
-		// 頂点バッファビュー
-		D3D12_VERTEX_BUFFER_VIEW vertexBufferView{};
-		// Index用のビュー
-		D3D12_INDEX_BUFFER_VIEW indexBufferView{};
+		// 描画のたびにバッチへ追加する頂点データ (クリップ空間に変換済み)
+		SpriteBatch::Vertex vertexData[4]{};
 
 		// テクスチャのSRVインデックス
 		uint32_t textureSrvIndex = 0;
+
+		// テクスチャのハンドル (持っている間はキャッシュから追い出されない)
+		TextureHandle textureHandle;
 	};
 }
\ No newline at end of file
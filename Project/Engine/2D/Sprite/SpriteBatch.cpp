@@ -0,0 +1,66 @@
+#include "SpriteBatch.h"
+
+#include <algorithm>
+#include <iterator>
+
+using namespace Engine;
+
+void SpriteBatch::Begin() {
+
+	quads_.clear();
+	drawOrder_.clear();
+	vertices_.clear();
+	indices_.clear();
+	batches_.clear();
+}
+
+void SpriteBatch::AddQuad(uint32_t textureSrvIndex, int32_t layer, const Vertex(&vertices)[4]) {
+
+	Quad& quad = quads_.emplace_back();
+	quad.layer = layer;
+	quad.textureSrvIndex = textureSrvIndex;
+	std::copy(std::begin(vertices), std::end(vertices), quad.vertices);
+}
+
+void SpriteBatch::Build() {
+
+	/// === 描く順に並べる === ///
+
+	// レイヤーの小さい順。同じレイヤーは追加した順を保つ
+	drawOrder_.resize(quads_.size());
+	for (uint32_t i = 0; i < drawOrder_.size(); i++) {
+		drawOrder_[i] = i;
+	}
+	std::stable_sort(drawOrder_.begin(), drawOrder_.end(), [this](uint32_t a, uint32_t b) { return quads_[a].layer < quads_[b].layer; });
+
+	/// === 頂点とインデックスの列を作る === ///
+
+	vertices_.clear();
+	indices_.clear();
+	batches_.clear();
+	vertices_.reserve(quads_.size() * 4);
+	indices_.reserve(quads_.size() * 6);
+
+	for (uint32_t quadIndex : drawOrder_) {
+
+		const Quad& quad = quads_[quadIndex];
+
+		// 左下、左上、右下 と 左上、右上、右下 の2枚の三角形
+		uint32_t baseVertex = static_cast<uint32_t>(vertices_.size());
+		vertices_.insert(vertices_.end(), std::begin(quad.vertices), std::end(quad.vertices));
+
+		uint32_t indexStart = static_cast<uint32_t>(indices_.size());
+		const uint32_t quadIndices[] = { 0, 1, 2, 1, 3, 2 };
+		for (uint32_t index : quadIndices) {
+			indices_.push_back(baseVertex + index);
+		}
+
+		// 前の四角形とテクスチャが同じなら同じ描画にまとめる
+		if (!batches_.empty() && batches_.back().textureSrvIndex == quad.textureSrvIndex) {
+			batches_.back().indexCount += 6;
+		}
+		else {
+			batches_.push_back({ quad.textureSrvIndex, indexStart, 6 });
+		}
+	}
+}
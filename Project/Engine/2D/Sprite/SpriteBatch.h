@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Vector2.h"
+#include "Vector4.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Engine {
+
+	/// === スプライトのバッチ === ///
+	/// スプライトの四角形を1フレーム分の頂点の列に追加していき、レイヤー順に並べてから、同じテクスチャが続く範囲を1回の描画にまとめる
+	/// 同じレイヤーの中は追加した順を保つ (半透明のUIの重なり順を変えない)。UIのテクスチャはアトラスにまとめてあるので、続く範囲が長くなる
+	/// GPUのリソースには触れないので、並べ替えとまとめ方はGPUなしで確かめられる
+	class SpriteBatch {
+
+		///-------------------------------------------///
+		/// 構造体
+		///-------------------------------------------///
+	public:
+
+		// 頂点 (位置はクリップ空間に変換済み)
+		struct Vertex {
+			Vector4 position;
+			Vector2 texcoord;
+			Vector4 color;
+		};
+
+		// 描画1回分
+		struct Batch {
+			uint32_t textureSrvIndex;	// テクスチャのSRVインデックス
+			uint32_t indexStart;		// 最初のインデックスの位置
+			uint32_t indexCount;		// インデックスの数
+		};
+
+	private:
+
+		// 追加された四角形
+		struct Quad {
+			int32_t layer;				// レイヤー (小さい方から描く)
+			uint32_t textureSrvIndex;	// テクスチャのSRVインデックス
+			Vertex vertices[4];			// 左下、左上、右下、右上
+		};
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// フレームの開始 (前のフレームの四角形を捨てる。配列の容量は残して使い回す)
+		/// </summary>
+		void Begin();
+
+		/// <summary>
+		/// 四角形の追加
+		/// </summary>
+		/// <param name="textureSrvIndex">テクスチャのSRVインデックス</param>
+		/// <param name="layer">レイヤー (小さい方から描く)</param>
+		/// <param name="vertices">左下、左上、右下、右上の頂点</param>
+		void AddQuad(uint32_t textureSrvIndex, int32_t layer, const Vertex(&vertices)[4]);
+
+		/// <summary>
+		/// 並べ替えて頂点とインデックスの列と描画の単位を作る
+		/// </summary>
+		void Build();
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 頂点の列の取得 (Buildの後)
+		/// </summary>
+		/// <returns></returns>
+		std::span<const Vertex> GetVertices() const { return vertices_; }
+
+		/// <summary>
+		/// インデックスの列の取得 (Buildの後)
+		/// </summary>
+		/// <returns></returns>
+		std::span<const uint32_t> GetIndices() const { return indices_; }
+
+		/// <summary>
+		/// 描画の単位の取得 (Buildの後)
+		/// </summary>
+		/// <returns></returns>
+		std::span<const Batch> GetBatches() const { return batches_; }
+
+		/// <summary>
+		/// 追加された四角形の数の取得
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetQuadCount() const { return static_cast<uint32_t>(quads_.size()); }
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// 追加された四角形 (追加した順)
+		std::vector<Quad> quads_;
+
+		// 描く順に並べた四角形の番号
+		std::vector<uint32_t> drawOrder_;
+
+		// 頂点の列
+		std::vector<Vertex> vertices_;
+
+		// インデックスの列
+		std::vector<uint32_t> indices_;
+
+		// 描画の単位
+		std::vector<Batch> batches_;
+	};
+}
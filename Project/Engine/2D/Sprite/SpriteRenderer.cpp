@@ -1,8 +1,13 @@
 #include "SpriteRenderer.h"
 #include "DirectXUtility.h"
 #include "SrvManager.h"
+#include "Texture/TextureManager.h"
+#include "MathMatrix.h"
+#include "WinApp.h"
+#include "FrameCounters.h"
 
 using namespace Engine;
+using namespace MathMatrix;
 
 void SpriteRenderer::Initialize() {
 
@@ -12,17 +17,20 @@ void SpriteRenderer::Initialize() {
 	// SrvManagerのインスタンス取得
 	srvManager_ = SrvManager::GetInstance();
 
-	// gTransformationMatrix CBV b0 頂点シェーダーで使う
-	pipelineBuilder_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_CBV, 0, D3D12_SHADER_VISIBILITY_VERTEX);
+	// TextureManagerのインスタンス取得
+	textureManager_ = TextureManager::GetInstance();
 
-	// gMaterial CBV b1 ピクセルシェーダーで使う
-	pipelineBuilder_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_CBV, 1, D3D12_SHADER_VISIBILITY_PIXEL);
+	// UIのテクスチャアトラスの読み込み (無いか元の画像の方が新しければクックする)
+	atlas_.Initialize(textureManager_->GetBaseDirectoryPath(), atlasManifestFileName_);
 
-	// gTexture SRV t0 ピクセルシェーダーで使う
+	// 平行投影行列 (スプライトの頂点はCPUでクリップ空間に変換してから送る)
+	projectionMatrix_ = MakeOrthographicMatrix(0.0f, 0.0f, float(WinApp::kClientWidth), float(WinApp::kClientHeight), 0.0f, 100.0f);
+
+	// gTexture SRV t0 ピクセルシェーダーで使う (座標変換と色は頂点に入れるので定数バッファは使わない)
 	pipelineBuilder_.AddRootParameterTable(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 0, D3D12_SHADER_VISIBILITY_PIXEL);
 
-	// gSampler 線形フィルタ、テクスチャ端は繰り返し、s0、ピクセルシェーダーで使う
-	pipelineBuilder_.AddStaticSampler(D3D12_FILTER_MIN_MAG_MIP_LINEAR, D3D12_TEXTURE_ADDRESS_MODE_WRAP, 0, D3D12_SHADER_VISIBILITY_PIXEL);
+	// gSampler 線形フィルタ、テクスチャ端は引き伸ばし (アトラスの隣の画像を繰り返して拾わないように)、s0、ピクセルシェーダーで使う
+	pipelineBuilder_.AddStaticSampler(D3D12_FILTER_MIN_MAG_MIP_LINEAR, D3D12_TEXTURE_ADDRESS_MODE_CLAMP, 0, D3D12_SHADER_VISIBILITY_PIXEL);
 
 	// シェーダーをパイプラインに設定
 	pipelineBuilder_.SetVertexShaderFileName(vertexShaderFileName);
@@ -43,6 +51,9 @@ void SpriteRenderer::Initialize() {
 	// インプットエレメントの追加 TEXCOORD0 float2
 	pipelineBuilder_.AddInputElement("TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT);
 
+	// インプットエレメントの追加 COLOR0 float4
+	pipelineBuilder_.AddInputElement("COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT);
+
 	// トポロジーモードの設定
 	pipelineBuilder_.SetTopologyMode(GraphicsPipelineBuilder::TopologyMode::Triangle);
 
@@ -71,6 +82,74 @@ void SpriteRenderer::SettingDrawing() {
 	dxUtility_->GetCommandList()->SetDescriptorHeaps(1, descriptorHeaps);
 }
 
+void SpriteRenderer::Begin() {
+
+	batch_.Begin();
+}
+
+void SpriteRenderer::AddQuad(uint32_t textureSrvIndex, int32_t layer, const SpriteBatch::Vertex(&vertices)[4]) {
+
+	batch_.AddQuad(textureSrvIndex, layer, vertices);
+}
+
+void SpriteRenderer::Flush() {
+
+	// レイヤー順に並べて、頂点とインデックスの列と描画の単位を作る
+	batch_.Build();
+
+	// 描くものが無ければ何もしない
+	std::span<const SpriteBatch::Batch> batches = batch_.GetBatches();
+	if (batches.empty()) {
+		return;
+	}
+
+	// 描画設定
+	SettingDrawing();
+
+	// コマンドリストを取得
+	ID3D12GraphicsCommandList* commandList = dxUtility_->GetCommandList().Get();
+
+	// 今のフレームの値をアップロードアロケータに書き込む (GPUが処理中の前のフレームの値は上書きしない)
+	UploadAllocator& uploadAllocator = dxUtility_->GetUploadAllocator();
+
+	// 頂点とインデックスを書き込む
+	std::span<const SpriteBatch::Vertex> vertices = batch_.GetVertices();
+	std::span<const uint32_t> indices = batch_.GetIndices();
+	UploadAllocator::Allocation vertexAllocation = uploadAllocator.PushArray(vertices.data(), vertices.size(), alignof(SpriteBatch::Vertex));
+	UploadAllocator::Allocation indexAllocation = uploadAllocator.PushArray(indices.data(), indices.size(), alignof(uint32_t));
+
+	// 書き込めなければこのフレームのスプライトは描画しない
+	if (!vertexAllocation.IsValid() || !indexAllocation.IsValid()) {
+		return;
+	}
+
+	/// === VertexBufferViewを設定 === ///
+	D3D12_VERTEX_BUFFER_VIEW vertexBufferView{};
+	vertexBufferView.BufferLocation = vertexAllocation.gpuAddress;
+	vertexBufferView.SizeInBytes = static_cast<UINT>(vertices.size_bytes());
+	vertexBufferView.StrideInBytes = sizeof(SpriteBatch::Vertex);
+	commandList->IASetVertexBuffers(0, 1, &vertexBufferView);
+
+	/// === IndexBufferViewを設定 === ///
+	D3D12_INDEX_BUFFER_VIEW indexBufferView{};
+	indexBufferView.BufferLocation = indexAllocation.gpuAddress;
+	indexBufferView.SizeInBytes = static_cast<UINT>(indices.size_bytes());
+	indexBufferView.Format = DXGI_FORMAT_R32_UINT;
+	commandList->IASetIndexBuffer(&indexBufferView);
+
+	/// === 同じテクスチャが続く分を1回で描画(DrawCall) === ///
+	for (const SpriteBatch::Batch& batch : batches) {
+
+		// SRVのDescriptorTableの先頭を設定
+		commandList->SetGraphicsRootDescriptorTable(0, textureManager_->GetSRVGPUHandle(batch.textureSrvIndex));
+
+		commandList->DrawIndexedInstanced(batch.indexCount, 1, batch.indexStart, 0, 0);
+
+		// 描画の統計を数える
+		FrameCounters::GetInstance()->CountDraw(1, 1);
+	}
+}
+
 void SpriteRenderer::Finalize() {
 
 	delete instance_;
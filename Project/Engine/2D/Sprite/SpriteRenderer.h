@@ -1,12 +1,16 @@
 #pragma once
 
 #include "GraphicsPipelineBuilder.h"
+#include "SpriteBatch.h"
+#include "Texture/TextureAtlas.h"
+#include "Matrix4x4.h"
 
 namespace Engine {
 
 	/// ===== 前方宣言 ===== ///
 	class DirectXUtility;
 	class SrvManager;
+	class TextureManager;
 
 	/// <summary>
 	/// スプライトのレンダラー
@@ -45,6 +49,24 @@ namespace Engine {
 		/// </summary>
 		void SettingDrawing();
 
+		/// <summary>
+		/// フレームの開始 (前のフレームのスプライトを捨てる)
+		/// </summary>
+		void Begin();
+
+		/// <summary>
+		/// スプライトの四角形をバッチに追加
+		/// </summary>
+		/// <param name="textureSrvIndex">テクスチャのSRVインデックス</param>
+		/// <param name="layer">レイヤー (小さい方から描く)</param>
+		/// <param name="vertices">左下、左上、右下、右上の頂点 (クリップ空間)</param>
+		void AddQuad(uint32_t textureSrvIndex, int32_t layer, const SpriteBatch::Vertex(&vertices)[4]);
+
+		/// <summary>
+		/// バッチの描画 (頂点とインデックスを1度だけ送り、同じテクスチャが続く分を1回の描画にまとめる)
+		/// </summary>
+		void Flush();
+
 		/// <summary>
 		/// 終了
 		/// </summary>
@@ -61,6 +83,18 @@ namespace Engine {
 		/// <returns>インスタンス</returns>
 		static SpriteRenderer* GetInstance();
 
+		/// <summary>
+		/// UIのテクスチャアトラスの取得
+		/// </summary>
+		/// <returns></returns>
+		const TextureAtlas& GetAtlas() const { return atlas_; }
+
+		/// <summary>
+		/// 平行投影行列の取得 (画面の大きさは変わらないので初期化で1度だけ作る)
+		/// </summary>
+		/// <returns></returns>
+		const Matrix4x4& GetProjectionMatrix() const { return projectionMatrix_; }
+
 	///-------------------------------------------/// 
 	/// メンバ変数
 	///-------------------------------------------///
@@ -80,6 +114,21 @@ namespace Engine {
 
 		// SrvManagerのインスタンス
 		SrvManager* srvManager_ = nullptr;
+
+		// TextureManagerのインスタンス
+		TextureManager* textureManager_ = nullptr;
+
+		// 1フレーム分のスプライトのバッチ
+		SpriteBatch batch_;
+
+		// UIのテクスチャアトラス
+		TextureAtlas atlas_;
+
+		// UIのテクスチャアトラスのマニフェストのファイル名
+		std::string atlasManifestFileName_ = "UIAtlas.json";
+
+		// 平行投影行列
+		Matrix4x4 projectionMatrix_{};
 	};
 }
 
@@ -0,0 +1,99 @@
+#include "AtlasPacker.h"
+
+#include <algorithm>
+#include <numeric>
+
+using namespace Engine;
+
+namespace {
+
+	/// <summary>
+	/// 決まった大きさのアトラスに棚詰めで並べる
+	/// </summary>
+	/// <param name="sizes">並べる長方形</param>
+	/// <param name="order">並べる順 (高さの大きい順)</param>
+	/// <param name="padding">周りに空ける幅</param>
+	/// <param name="width">アトラスの幅</param>
+	/// <param name="height">アトラスの高さ</param>
+	/// <param name="placements">並べた位置</param>
+	/// <returns>入りきったか</returns>
+	bool PackShelves(std::span<const AtlasPacker::Rect> sizes, const std::vector<uint32_t>& order, uint32_t padding, uint32_t width, uint32_t height, std::vector<AtlasPacker::Rect>& placements) {
+
+		// 今の棚の左上と高さ
+		uint32_t cursorX = 0;
+		uint32_t shelfY = 0;
+		uint32_t shelfHeight = 0;
+
+		for (uint32_t index : order) {
+
+			// 余白を含めた大きさ
+			uint32_t paddedWidth = sizes[index].width + padding * 2;
+			uint32_t paddedHeight = sizes[index].height + padding * 2;
+
+			// 幅に入らなければどの棚にも入らない
+			if (paddedWidth > width) {
+				return false;
+			}
+
+			// 今の棚の右に入らなければ次の棚へ
+			if (cursorX + paddedWidth > width) {
+				shelfY += shelfHeight;
+				cursorX = 0;
+				shelfHeight = 0;
+			}
+
+			// 下にはみ出したら入りきらない
+			if (shelfY + paddedHeight > height) {
+				return false;
+			}
+
+			placements[index] = { cursorX + padding, shelfY + padding, sizes[index].width, sizes[index].height };
+
+			cursorX += paddedWidth;
+			shelfHeight = (std::max)(shelfHeight, paddedHeight);
+		}
+
+		return true;
+	}
+}
+
+bool AtlasPacker::Pack(std::span<const Rect> sizes, uint32_t padding, uint32_t maxSize, std::vector<Rect>& placements, uint32_t& atlasWidth, uint32_t& atlasHeight) {
+
+	placements.assign(sizes.size(), Rect{});
+	atlasWidth = 0;
+	atlasHeight = 0;
+
+	// 高さの大きい順 (同じ高さなら幅の大きい順) に並べると棚の隙間が少ない
+	std::vector<uint32_t> order(sizes.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&sizes](uint32_t a, uint32_t b) {
+		if (sizes[a].height != sizes[b].height) {
+			return sizes[a].height > sizes[b].height;
+		}
+		return sizes[a].width > sizes[b].width;
+	});
+
+	// 余白を含めた面積の合計 (これより小さいアトラスには入らない)
+	uint64_t totalArea = 0;
+	for (const Rect& size : sizes) {
+		totalArea += static_cast<uint64_t>(size.width + padding * 2) * (size.height + padding * 2);
+	}
+
+	// 小さい2の累乗から順に、横長 (幅:高さ = 2:1) と正方形を試す
+	for (uint32_t width = 1; width <= maxSize; width *= 2) {
+		for (uint32_t height : { width / 2, width }) {
+
+			if (height == 0 || static_cast<uint64_t>(width) * height < totalArea) {
+				continue;
+			}
+
+			if (PackShelves(sizes, order, padding, width, height, placements)) {
+				atlasWidth = width;
+				atlasHeight = height;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Engine {
+
+	/// === アトラスの配置 === ///
+	/// 複数の画像の長方形を1枚のテクスチャに重ならないように並べる
+	/// 高さの大きい順に棚(横一列)へ左から詰め、入りきる一番小さい2の累乗の大きさを探す
+	/// 画像を読み書きしないので、配置だけをGPUやファイルなしで確かめられる
+	namespace AtlasPacker {
+
+		// 長方形
+		struct Rect {
+			uint32_t x;
+			uint32_t y;
+			uint32_t width;
+			uint32_t height;
+		};
+
+		/// <summary>
+		/// 長方形を並べる
+		/// </summary>
+		/// <param name="sizes">並べる長方形 (幅と高さだけ使う)</param>
+		/// <param name="padding">長方形の周りに空ける幅 (隣の画像がにじまないように端の色を引き伸ばす分)</param>
+		/// <param name="maxSize">アトラスの一辺の上限</param>
+		/// <param name="placements">並べた位置 (sizesと同じ順。余白を除いた画像の位置)</param>
+		/// <param name="atlasWidth">アトラスの幅</param>
+		/// <param name="atlasHeight">アトラスの高さ</param>
+		/// <returns>上限の大きさに入りきったか</returns>
+		bool Pack(std::span<const Rect> sizes, uint32_t padding, uint32_t maxSize, std::vector<Rect>& placements, uint32_t& atlasWidth, uint32_t& atlasHeight);
+	};
+}
@@ -0,0 +1,239 @@
+#include "TextureAtlas.h"
+#include "AtlasPacker.h"
+#include "StringUtility.h"
+#include "Logger.h"
+
+#include "json.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <DirectXTex.h>
+
+using namespace Engine;
+using namespace StringUtility;
+
+namespace {
+
+	// 範囲の表の拡張子
+	const char* const kTableExtension = ".atlas";
+
+	// 範囲の表の形式の版 (変えたらクックし直す)
+	const uint32_t kTableVersion = 1;
+}
+
+void TextureAtlas::Initialize(const std::string& directoryPath, const std::string& manifestFileName) {
+
+	directoryPath_ = directoryPath;
+	regions_.clear();
+
+	/// === マニフェストの読み込み === ///
+
+	std::string manifestPath = directoryPath + "/" + manifestFileName;
+
+	// マニフェストが無ければアトラスを使わない
+	if (!std::filesystem::exists(manifestPath)) {
+		LOG_DEBUG("TextureAtlas::Initialize: No manifest {}\n", manifestPath);
+		return;
+	}
+
+	std::ifstream file(manifestPath);
+	nlohmann::json manifest = nlohmann::json::parse(file, nullptr, false);
+	if (manifest.is_discarded() || !manifest.contains("textures")) {
+		LOG_WARNING("TextureAtlas::Initialize: Invalid manifest {}\n", manifestPath);
+		return;
+	}
+
+	sourcePaths_ = manifest["textures"].get<std::vector<std::string>>();
+	padding_ = manifest.value("padding", padding_);
+	maxSize_ = manifest.value("maxSize", maxSize_);
+
+	// 出力先はマニフェストと同じ名前の画像と範囲の表
+	std::string name = manifest.value("atlas", std::filesystem::path(manifestFileName).stem().string());
+	texturePath_ = directoryPath + "/" + name + ".png";
+	tablePath_ = directoryPath + "/" + name + kTableExtension;
+
+	/// === クック済みの範囲の表の読み込み === ///
+
+	// 古いか読めなければクックし直す
+	if (IsStale(manifestPath) || !LoadTable()) {
+
+		regions_.clear();
+		if (Cook()) {
+			LoadTable();
+		}
+	}
+}
+
+const TextureAtlas::Region* TextureAtlas::Find(const std::string& fullPath) const {
+
+	auto it = regions_.find(fullPath);
+	if (it == regions_.end()) {
+		return nullptr;
+	}
+	return &it->second;
+}
+
+bool TextureAtlas::IsStale(const std::string& manifestPath) const {
+
+	// クック済みのファイルが無ければクックが必要
+	if (!std::filesystem::exists(texturePath_) || !std::filesystem::exists(tablePath_)) {
+		return true;
+	}
+
+	// マニフェストか元の画像のどれかの方が新しければクックし直す
+	std::filesystem::file_time_type cookedTime = std::filesystem::last_write_time(tablePath_);
+	if (std::filesystem::last_write_time(manifestPath) > cookedTime) {
+		return true;
+	}
+
+	for (const std::string& sourcePath : sourcePaths_) {
+
+		std::string fullPath = directoryPath_ + "/" + sourcePath;
+		if (std::filesystem::exists(fullPath) && std::filesystem::last_write_time(fullPath) > cookedTime) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool TextureAtlas::Cook() const {
+
+	// 計測開始
+	auto start = std::chrono::steady_clock::now();
+
+	/// === 元の画像の読み込み === ///
+
+	std::vector<DirectX::ScratchImage> images(sourcePaths_.size());
+	std::vector<AtlasPacker::Rect> sizes(sourcePaths_.size());
+
+	for (size_t i = 0; i < sourcePaths_.size(); i++) {
+
+		std::string fullPath = directoryPath_ + "/" + sourcePaths_[i];
+
+		// 色の値はそのまま並べる (読み込むときにsRGBとして扱う)
+		DirectX::ScratchImage image{};
+		HRESULT hr = DirectX::LoadFromWICFile(ConvertString(fullPath).c_str(), DirectX::WIC_FLAGS_FORCE_RGB | DirectX::WIC_FLAGS_IGNORE_SRGB, nullptr, image);
+		if (FAILED(hr)) {
+			LOG_WARNING("TextureAtlas::Cook: Failed to load {}\n", fullPath);
+			return false;
+		}
+
+		// 1画素4バイトにそろえる
+		if (image.GetMetadata().format != DXGI_FORMAT_R8G8B8A8_UNORM) {
+			hr = DirectX::Convert(*image.GetImage(0, 0, 0), DXGI_FORMAT_R8G8B8A8_UNORM, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, images[i]);
+			if (FAILED(hr)) {
+				LOG_WARNING("TextureAtlas::Cook: Failed to convert {}\n", fullPath);
+				return false;
+			}
+		}
+		else {
+			images[i] = std::move(image);
+		}
+
+		sizes[i] = { 0, 0, static_cast<uint32_t>(images[i].GetMetadata().width), static_cast<uint32_t>(images[i].GetMetadata().height) };
+	}
+
+	/// === 並べる === ///
+
+	std::vector<AtlasPacker::Rect> placements;
+	uint32_t atlasWidth = 0;
+	uint32_t atlasHeight = 0;
+	if (!AtlasPacker::Pack(sizes, padding_, maxSize_, placements, atlasWidth, atlasHeight)) {
+		LOG_WARNING("TextureAtlas::Cook: Textures do not fit in {}x{} ({})\n", maxSize_, maxSize_, texturePath_);
+		return false;
+	}
+
+	/// === アトラスの画像に書き込む === ///
+
+	DirectX::ScratchImage atlas{};
+	HRESULT hr = atlas.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM, atlasWidth, atlasHeight, 1, 1);
+	if (FAILED(hr)) {
+		return false;
+	}
+	std::memset(atlas.GetPixels(), 0, atlas.GetPixelsSize());
+
+	const DirectX::Image* destination = atlas.GetImage(0, 0, 0);
+	int32_t padding = static_cast<int32_t>(padding_);
+
+	for (size_t i = 0; i < images.size(); i++) {
+
+		const DirectX::Image* source = images[i].GetImage(0, 0, 0);
+		const AtlasPacker::Rect& placement = placements[i];
+		int32_t left = static_cast<int32_t>(placement.x);
+		int32_t top = static_cast<int32_t>(placement.y);
+		int32_t width = static_cast<int32_t>(placement.width);
+		int32_t height = static_cast<int32_t>(placement.height);
+
+		// 余白には端の画素を引き伸ばす (線形補間で隣の画像や透明な余白が混ざらないように)
+		for (int32_t y = -padding; y < height + padding; y++) {
+
+			int32_t sourceY = std::clamp(y, 0, height - 1);
+			const uint8_t* sourceRow = source->pixels + sourceY * source->rowPitch;
+			uint8_t* destinationRow = destination->pixels + (top + y) * destination->rowPitch;
+
+			for (int32_t x = -padding; x < width + padding; x++) {
+
+				int32_t sourceX = std::clamp(x, 0, width - 1);
+				std::memcpy(destinationRow + (left + x) * 4, sourceRow + sourceX * 4, 4);
+			}
+		}
+	}
+
+	/// === 書き出す === ///
+
+	hr = DirectX::SaveToWICFile(*destination, DirectX::WIC_FLAGS_NONE, DirectX::GetWICCodec(DirectX::WIC_CODEC_PNG), ConvertString(texturePath_).c_str());
+	if (FAILED(hr)) {
+		LOG_WARNING("TextureAtlas::Cook: Failed to write {}\n", texturePath_);
+		return false;
+	}
+
+	// 範囲の表 (画像の後に書くので、表があれば画像もそろっている)
+	nlohmann::json table;
+	table["version"] = kTableVersion;
+	table["width"] = atlasWidth;
+	table["height"] = atlasHeight;
+	table["regions"] = nlohmann::json::array();
+	for (size_t i = 0; i < sourcePaths_.size(); i++) {
+		const AtlasPacker::Rect& placement = placements[i];
+		table["regions"].push_back({ { "path", sourcePaths_[i] }, { "x", placement.x }, { "y", placement.y }, { "width", placement.width }, { "height", placement.height } });
+	}
+
+	std::ofstream tableFile(tablePath_, std::ios::trunc);
+	tableFile << table.dump(1, '\t');
+	if (!tableFile.good()) {
+		LOG_WARNING("TextureAtlas::Cook: Failed to write {}\n", tablePath_);
+		return false;
+	}
+
+	// 計測終了
+	double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	LOG_DEBUG("TextureAtlas::Cook: {} textures -> {} ({}x{}, {:.3f} ms)\n", sourcePaths_.size(), texturePath_, atlasWidth, atlasHeight, milliseconds);
+
+	return true;
+}
+
+bool TextureAtlas::LoadTable() {
+
+	std::ifstream file(tablePath_);
+	nlohmann::json table = nlohmann::json::parse(file, nullptr, false);
+
+	// 読めないか形式が古ければ使わない
+	if (table.is_discarded() || table.value("version", 0u) != kTableVersion || !table.contains("regions")) {
+		return false;
+	}
+
+	// 元の画像のパスで引けるようにする (スプライトはディレクトリから始まるパスで探す)
+	for (const nlohmann::json& region : table["regions"]) {
+
+		Region& entry = regions_[directoryPath_ + "/" + region["path"].get<std::string>()];
+		entry.leftTop = { region["x"].get<float>(), region["y"].get<float>() };
+		entry.size = { region["width"].get<float>(), region["height"].get<float>() };
+	}
+
+	return !regions_.empty();
+}
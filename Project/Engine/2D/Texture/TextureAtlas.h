@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Vector2.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine {
+
+	/// === テクスチャアトラス === ///
+	/// マニフェスト(.json)に並べた画像を1枚のテクスチャにまとめ、元の画像のパスからアトラス内の範囲を引けるようにする
+	/// アトラスの画像(.png)と範囲の表(.atlas)はクックしたものを使い、無いか元の画像の方が新しいときだけ作り直す
+	/// スプライトはアトラスに入っている画像ならアトラスのテクスチャを使うので、UIのテクスチャの切り替えが減って描画をまとめやすくなる
+	class TextureAtlas {
+
+		///-------------------------------------------///
+		/// 構造体
+		///-------------------------------------------///
+	public:
+
+		// アトラス内の範囲(ピクセル)
+		struct Region {
+			Vector2 leftTop;
+			Vector2 size;
+		};
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 初期化 (必要ならクックしてから範囲の表を読み込む。マニフェストが無ければアトラスを使わない)
+		/// </summary>
+		/// <param name="directoryPath">テクスチャのディレクトリ (マニフェストと元の画像のパスの基準)</param>
+		/// <param name="manifestFileName">マニフェストのファイル名</param>
+		void Initialize(const std::string& directoryPath, const std::string& manifestFileName);
+
+		/// <summary>
+		/// アトラス内の範囲を探す
+		/// </summary>
+		/// <param name="fullPath">元の画像のパス (ディレクトリから)</param>
+		/// <returns>範囲 (アトラスに入っていなければnullptr)</returns>
+		const Region* Find(const std::string& fullPath) const;
+
+		///-------------------------------------------///
+		/// クラス内関数
+		///-------------------------------------------///
+	private:
+
+		/// <summary>
+		/// クックし直す必要があるか (クック済みのファイルが無い、またはマニフェストか元の画像の方が新しい)
+		/// </summary>
+		/// <param name="manifestPath">マニフェストのパス</param>
+		/// <returns></returns>
+		bool IsStale(const std::string& manifestPath) const;
+
+		/// <summary>
+		/// 元の画像を並べてアトラスの画像と範囲の表を書き出す
+		/// </summary>
+		/// <returns>成功したか</returns>
+		bool Cook() const;
+
+		/// <summary>
+		/// 範囲の表の読み込み
+		/// </summary>
+		/// <returns>成功したか</returns>
+		bool LoadTable();
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// アトラスの画像のパスの取得
+		/// </summary>
+		/// <returns></returns>
+		const std::string& GetTexturePath() const { return texturePath_; }
+
+		/// <summary>
+		/// 使えるか (範囲の表を読み込めたか)
+		/// </summary>
+		/// <returns></returns>
+		bool IsLoaded() const { return !regions_.empty(); }
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// テクスチャのディレクトリ
+		std::string directoryPath_;
+
+		// 元の画像のディレクトリからの相対パス (マニフェストの順)
+		std::vector<std::string> sourcePaths_;
+
+		// 画像の周りに空ける幅(ピクセル)
+		uint32_t padding_ = 2;
+
+		// アトラスの一辺の上限(ピクセル)
+		uint32_t maxSize_ = 2048;
+
+		// アトラスの画像のパス
+		std::string texturePath_;
+
+		// 範囲の表のパス
+		std::string tablePath_;
+
+		// 元の画像のパスからアトラス内の範囲を引く表
+		std::unordered_map<std::string, Region> regions_;
+	};
+}
@@ -2,10 +2,34 @@
 #include "DirectXUtility.h"
 #include "SrvManager.h"
 #include "StringUtility.h"
+#include "Profiler.h"
+#include "Logger.h"
+
+#include <cassert>
+#include <utility>
+#include <objbase.h>
 
 using namespace Engine;
 using namespace StringUtility;
 
+namespace {
+
+	/// === スレッドごとのCOMの初期化 === ///
+	/// WICのデコードに必要なので、デコードするスレッドで最初に使うときに初期化し、スレッドの終了で解放する
+	struct ComInitializer {
+
+		ComInitializer() { hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED); }
+
+		~ComInitializer() {
+			if (SUCCEEDED(hr)) {
+				CoUninitialize();
+			}
+		}
+
+		HRESULT hr;
+	};
+}
+
 TextureManager* TextureManager::instance = nullptr;
 
 TextureManager* TextureManager::GetInstance() {
@@ -21,11 +45,18 @@ void TextureManager::Initialize() {
 	// DirectXUtilityのインスタンスを取得
 	dxUtility_ = DirectXUtility::GetInstance();
 
-	// SRVの数と同数
-	textureDatas.reserve(SrvManager::kMaxSRVCount);
+	// メモリ予算を設定
+	textureCache_->SetMemoryBudget(kDefaultMemoryBudget);
+
+	// 見つからなかったときの代わりのテクスチャを読み込んでおく
+	fallbackTexture_ = AcquireTexture(baseDirectoryPath + "/" + fallbackTextureFileName);
 }
 
 void TextureManager::Finalize() {
+
+	// 代わりのテクスチャを手放す
+	fallbackTexture_ = {};
+
 	delete instance;
 	instance = nullptr;
 }
@@ -35,14 +66,27 @@ void TextureManager::LoadTexture(const std::string& filePath) {
 	/// === ファイル読み込み === ///
 
 	// 読み込み済みテクスチャを検索
-	if (textureDatas.contains(filePath)) {
+	if (textureCache_->Contains(AssetRegistry::MakeID(filePath))) {
 		
 		// 読み込み済みなら終了
 		return;
 	}
 
-	// テクスチャ枚数上限チェック
-	assert(SrvManager::GetInstance()->CheckAllocate());
+	// テクスチャファイルをデコード
+	DirectX::ScratchImage mipImages{};
+	HRESULT hr = DecodeTexture(filePath, mipImages);
+	assert(SUCCEEDED(hr));
+
+	// GPUに転送
+	UploadTexture(filePath, mipImages);
+}
+
+HRESULT TextureManager::DecodeTexture(const std::string& filePath, DirectX::ScratchImage& mipImages) {
+
+	PROFILE_SCOPE("TextureManager::DecodeTexture");
+
+	// このスレッドでCOMを使えるようにする (メインスレッドはWinAppで初期化済みなので何も変わらない)
+	static thread_local ComInitializer comInitializer;
 
 	DirectX::ScratchImage image{};
 	// テクスチャファイルを読んでプログラムで扱えるようにする
@@ -59,11 +103,10 @@ void TextureManager::LoadTexture(const std::string& filePath) {
 		hr = DirectX::LoadFromWICFile(filePathW.c_str(), DirectX::WIC_FLAGS_FORCE_SRGB, nullptr, image);
 	}
 
-	assert(SUCCEEDED(hr));
+	// 読めなかったら結果を返す
+	if (FAILED(hr)) return hr;
 
 	// ミップマップの作成
-	DirectX::ScratchImage mipImages{};
-
 	if (DirectX::IsCompressed(image.GetMetadata().format)) { // 圧縮フォーマットなら
 
 		mipImages = std::move(image); // 圧縮されていたらそのままimageを使うのでmoveする
@@ -76,15 +119,28 @@ void TextureManager::LoadTexture(const std::string& filePath) {
 		}
 		else {
 			hr = DirectX::GenerateMipMaps(image.GetImages(), image.GetImageCount(), image.GetMetadata(), DirectX::TEX_FILTER_SRGB, 4, mipImages);
-			assert(SUCCEEDED(hr));
 		}
 	}
 
-	assert(SUCCEEDED(hr));
+	return hr;
+}
+
+void TextureManager::UploadTexture(const std::string& filePath, const DirectX::ScratchImage& mipImages) {
+
+	PROFILE_SCOPE("TextureManager::UploadTexture");
+
+	// IDを発行
+	AssetID id = AssetRegistry::Intern(filePath);
+
+	// 別の経路で読み込み済みなら終了
+	if (textureCache_->Contains(id)) return;
+
+	// テクスチャ枚数上限チェック
+	assert(SrvManager::GetInstance()->CheckAllocate());
 
 	/// === テクスチャデータ追加 === ///
 
-	TextureData& textureData = textureDatas[filePath];
+	TextureData& textureData = textureCache_->Insert(id, TextureData{}, mipImages.GetPixelsSize());
 
 	/// === テクスチャデータ書き込み === ///
 
@@ -93,14 +149,15 @@ void TextureManager::LoadTexture(const std::string& filePath) {
 
 	/// === テクスチャデータ送信 === ///
 
-	// テクスチャデータをGPUに送信するための中間リソースを生成
-	textureData.intermediateResource = dxUtility_->UploadTextureData(textureData.resource, mipImages);
+	// テクスチャデータをGPUに送信するための中間リソースを生成 (記録中のフレームの転送が終わったら解放する)
+	pendingIntermediateResources_.emplace_back(dxUtility_->GetCurrentFenceValue(), dxUtility_->UploadTextureData(textureData.resource, mipImages));
 
 	/// === デスクリプタハンドルの計算 === ///
 
-	textureData.srvIndex = SrvManager::GetInstance()->Allocate();
-	textureData.srvHandleCPU = SrvManager::GetInstance()->GetCPUDescriptorHandle(textureData.srvIndex);
-	textureData.srvHandleGPU = SrvManager::GetInstance()->GetGPUDescriptorHandle(textureData.srvIndex);
+	textureData.srvHandle = SrvManager::GetInstance()->AllocateHandle();
+	textureData.srvIndex = textureData.srvHandle.index;
+	textureData.srvHandleCPU = SrvManager::GetInstance()->GetCPUDescriptorHandle(textureData.srvHandle);
+	textureData.srvHandleGPU = SrvManager::GetInstance()->GetGPUDescriptorHandle(textureData.srvHandle);
 
 	/// === SRVの生成 === ///
 
@@ -123,24 +180,67 @@ void TextureManager::LoadTextureRelative(const std::string& relativePath) {
 	LoadTexture(fullPath);
 }
 
-uint32_t TextureManager::GetTextureIndexByFilePath(const std::string& filePath) {
+bool TextureManager::IsLoaded(const std::string& filePath) const {
 
-	// 読み込み済みテクスチャを検索
-	if (textureDatas.contains(filePath)) {
+	return textureCache_->Contains(AssetRegistry::MakeID(filePath));
+}
+
+TextureHandle TextureManager::AcquireTexture(const std::string& filePath) {
+
+	// 読み込まれていなければ読み込む
+	LoadTexture(filePath);
+
+	// 参照を増やしたハンドルを返す
+	return TextureHandle(textureCache_, AssetRegistry::MakeID(filePath));
+}
+
+void TextureManager::Trim() {
+
+	// 追い出したものは記録中のフレームをGPUが使い終わるまで退避しておく
+	textureCache_->Trim([this](TextureData& textureData) {
+		retiredTextures_.emplace_back(dxUtility_->GetCurrentFenceValue(), std::move(textureData));
+	});
+}
+
+void TextureManager::CollectGarbage() {
 
-		// 読み込み済みなら要素番号を返す
-		uint32_t textureIndex = textureDatas[filePath].srvIndex;
-		return textureIndex;
+	// フェンス値までGPUの処理が終わっているか
+	auto isCompleted = [this](const auto& pair) { return dxUtility_->IsFenceCompleted(pair.first); };
+
+	// GPUが使い終わったテクスチャのSRVの番号を返す (リソースは取り除くときに解放される)
+	std::erase_if(retiredTextures_, [&isCompleted](const std::pair<uint64_t, TextureData>& pair) {
+		if (!isCompleted(pair)) return false;
+		SrvManager::GetInstance()->Free(pair.second.srvHandle);
+		return true;
+	});
+
+	// 転送が終わった中間リソースを解放
+	std::erase_if(pendingIntermediateResources_, isCompleted);
+}
+
+std::vector<std::string> TextureManager::TakeMissingTextures() {
+
+	std::lock_guard<std::mutex> lock(missingListsMutex_);
+
+	// 全てのスレッドの入れ物から取り出して空にする (同じパスは1つにまとめる)
+	std::unordered_set<std::string> filePaths;
+	for (std::unique_ptr<MissingTextureList>& list : missingLists_) {
+		std::lock_guard<std::mutex> listLock(list->mutex);
+		filePaths.merge(list->filePaths);
+		list->filePaths.clear();
 	}
 
-	assert(0);
-	return 0;
+	return std::vector<std::string>(filePaths.begin(), filePaths.end());
+}
+
+uint32_t TextureManager::GetTextureIndexByFilePath(const std::string& filePath) {
+
+	return Find(filePath).srvIndex;
 }
 
 D3D12_GPU_DESCRIPTOR_HANDLE TextureManager::GetSRVGPUHandle(const std::string& filePath) {
 
-	TextureData& textureData = textureDatas[filePath];
-	return textureData.srvHandleGPU;
+	return Find(filePath).srvHandleGPU;
 }
 
 D3D12_GPU_DESCRIPTOR_HANDLE TextureManager::GetSRVGPUHandle(const uint32_t srvIndex) {
@@ -151,6 +251,40 @@ D3D12_GPU_DESCRIPTOR_HANDLE TextureManager::GetSRVGPUHandle(const uint32_t srvIn
 
 const DirectX::TexMetadata& TextureManager::GetMetadata(const std::string& filePath) {
 
-	TextureData& textureData = textureDatas[filePath];
-	return textureData.metaData;
-}
\ No newline at end of file
+	return Find(filePath).metaData;
+}
+
+const TextureManager::TextureData& TextureManager::Find(const std::string& filePath) {
+
+	AssetID id = AssetRegistry::MakeID(filePath);
+
+	// 読み込み済みならそれを返す (記録中はメインスレッドがキャッシュを書き換えないので、統計もLRUも触らない取得ならロックはいらない)
+	if (const TextureData* textureData = std::as_const(*textureCache_).Get(id)) return *textureData;
+
+	// 描画中には読み込まない (GPUへの転送はメインスレッドでしかできない)。このスレッドの入れ物に記録し、次のAssetLoader::Updateで読み込み要求にする
+	MissingTextureList& list = GetThreadMissingList();
+	std::lock_guard<std::mutex> lock(list.mutex);
+	if (list.filePaths.insert(filePath).second) {
+		LOG_WARNING("TextureManager::Find: {} is not loaded. Using {} until it is\n", filePath, fallbackTextureFileName);
+	}
+
+	// 代わりのテクスチャを返す
+	assert(fallbackTexture_);
+	return *fallbackTexture_.Get();
+}
+
+TextureManager::MissingTextureList& TextureManager::GetThreadMissingList() {
+
+	// このスレッドの入れ物 (持ち主のマネージャーが変わったら作り直す)
+	static thread_local TextureManager* owner = nullptr;
+	static thread_local MissingTextureList* threadList = nullptr;
+
+	if (owner != this) {
+		std::lock_guard<std::mutex> lock(missingListsMutex_);
+		missingLists_.push_back(std::make_unique<MissingTextureList>());
+		threadList = missingLists_.back().get();
+		owner = this;
+	}
+
+	return *threadList;
+}
@@ -1,10 +1,16 @@
 #pragma once
 
 #include "DirectXTex.h"
+#include "AssetHandle.h"
+#include "DescriptorAllocator.h"
 
 #include <d3d12.h>
-#include <unordered_map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 #include <wrl.h>
 
 namespace Engine {
@@ -13,6 +19,8 @@ namespace Engine {
 	class DirectXUtility;
 
 	/// === テクスチャマネージャ === ///
+	/// 読み込み(Load〜、Acquire〜、Upload〜)はメインスレッドから呼ぶこと
+	/// 描画時の取得(Get〜)は検索だけを行うので並列記録中のスレッドから呼べる。無ければ代わりのテクスチャを返し、読み込みはAssetLoaderに任せる
 	class TextureManager {
 
 		///-------------------------------------------/// 
@@ -32,6 +40,29 @@ namespace Engine {
 		// コピー代入演算子の封印
 		TextureManager& operator=(TextureManager&) = delete;
 
+		///-------------------------------------------/// 
+		/// 構造体
+		///-------------------------------------------///
+	public:
+
+		// テクスチャ1枚分のデータ
+		struct TextureData {
+			DirectX::TexMetadata metaData;
+			Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+			DescriptorHandle srvHandle;
+			uint32_t srvIndex;
+			D3D12_CPU_DESCRIPTOR_HANDLE srvHandleCPU;
+			D3D12_GPU_DESCRIPTOR_HANDLE srvHandleGPU;
+		};
+
+	private:
+
+		// 描画時に見つからなかったテクスチャを記録するスレッドごとの入れ物
+		struct MissingTextureList {
+			std::mutex mutex;							// 持ち主のスレッドとTakeMissingTexturesしか触らないので、ほぼ競合しない
+			std::unordered_set<std::string> filePaths;	// フルパス
+		};
+
 		///-------------------------------------------/// 
 		/// メンバ関数
 		///-------------------------------------------///
@@ -59,6 +90,45 @@ namespace Engine {
 		/// <param name="fullPath">フルパス</param>
 		void LoadTexture(const std::string& fullPath);
 
+		/// <summary>
+		/// テクスチャファイルをデコードしてミップマップまで作る (GPUに触らないのでワーカースレッドから呼べる。COMはスレッドごとにここで初期化する)
+		/// </summary>
+		/// <param name="fullPath">フルパス</param>
+		/// <param name="mipImages">デコード結果</param>
+		/// <returns>結果</returns>
+		static HRESULT DecodeTexture(const std::string& fullPath, DirectX::ScratchImage& mipImages);
+
+		/// <summary>
+		/// デコード済みのテクスチャをGPUに転送して登録する (メインスレッド専用)
+		/// </summary>
+		/// <param name="fullPath">フルパス</param>
+		/// <param name="mipImages">デコード結果</param>
+		void UploadTexture(const std::string& fullPath, const DirectX::ScratchImage& mipImages);
+
+		/// <summary>
+		/// 読み込み済みか
+		/// </summary>
+		/// <param name="fullPath">フルパス</param>
+		/// <returns></returns>
+		bool IsLoaded(const std::string& fullPath) const;
+
+		/// <summary>
+		/// テクスチャを参照する (ハンドルを持っている間はキャッシュから追い出されない)
+		/// </summary>
+		/// <param name="fullPath">フルパス</param>
+		/// <returns>ハンドル</returns>
+		AssetHandle<TextureData> AcquireTexture(const std::string& fullPath);
+
+		/// <summary>
+		/// 使われていないテクスチャを予算に収まるまで追い出す
+		/// </summary>
+		void Trim();
+
+		/// <summary>
+		/// GPUが使い終わった追い出し済みのテクスチャと中間リソースを解放する (フェンスで完了を確認する)
+		/// </summary>
+		void CollectGarbage();
+
 		/// <summary>
 		/// 相対パスでテクスチャを読み込み
 		/// </summary>
@@ -66,14 +136,20 @@ namespace Engine {
 		void LoadTextureRelative(const std::string& relativePath);
 
 		/// <summary>
-		/// SRVインデックスの開始番号
+		/// 読み込まれていなかったテクスチャのパスを取り出す (メインスレッド専用。AssetLoaderが読み込み要求にする)
+		/// </summary>
+		/// <returns>フルパスの配列</returns>
+		std::vector<std::string> TakeMissingTextures();
+
+		/// <summary>
+		/// SRVインデックスの開始番号 (検索のみ。無ければ代わりのテクスチャの番号)
 		/// </summary>
 		/// <param name="filePath">ファイルパス</param>
 		/// <returns></returns>
 		uint32_t GetTextureIndexByFilePath(const std::string& filePath);
 
 		/// <summary>
-		/// テクスチャ番号からGPUハンドルを取得
+		/// テクスチャ番号からGPUハンドルを取得 (検索のみ。無ければ代わりのテクスチャのハンドル)
 		/// </summary>
 		/// <param name="filePath">ファイルパス</param>
 		/// <returns></returns>
@@ -87,12 +163,30 @@ namespace Engine {
 		D3D12_GPU_DESCRIPTOR_HANDLE GetSRVGPUHandle(const uint32_t srvIndex);
 
 		/// <summary>
-		/// メタデータを取得
+		/// メタデータを取得 (検索のみ。無ければ代わりのテクスチャのメタデータ)
 		/// </summary>
 		/// <param name="filePath">ファイルパス</param>
 		/// <returns></returns>
 		const DirectX::TexMetadata& GetMetadata(const std::string& filePath);
 
+		///-------------------------------------------/// 
+		/// クラス内関数
+		///-------------------------------------------///
+	private:
+
+		/// <summary>
+		/// 検索する (キャッシュは書き換えずにロックなしで引く。無ければこのスレッドの入れ物に記録して代わりのテクスチャを返す。読み込みはしない)
+		/// </summary>
+		/// <param name="filePath">ファイルパス</param>
+		/// <returns>テクスチャデータ</returns>
+		const TextureData& Find(const std::string& filePath);
+
+		/// <summary>
+		/// 呼んだスレッドの見つからなかったテクスチャの入れ物を取得する (初めて呼んだスレッドの分はここで作る)
+		/// </summary>
+		/// <returns></returns>
+		MissingTextureList& GetThreadMissingList();
+
 		///-------------------------------------------/// 
 		/// ゲッター
 		///-------------------------------------------///
@@ -104,20 +198,17 @@ namespace Engine {
 		/// <returns></returns>
 		const std::string& GetBaseDirectoryPath() const { return baseDirectoryPath; }
 
-		///-------------------------------------------/// 
-		/// 構造体
-		///-------------------------------------------///
-	public:
+		/// <summary>
+		/// キャッシュの統計のゲッター
+		/// </summary>
+		/// <returns></returns>
+		const AssetCache<TextureData>::Stats& GetCacheStats() const { return textureCache_->GetStats(); }
 
-		// テクスチャ1枚分のデータ
-		struct TextureData {
-			DirectX::TexMetadata metaData;
-			Microsoft::WRL::ComPtr<ID3D12Resource> resource;
-			Microsoft::WRL::ComPtr<ID3D12Resource> intermediateResource; // 中間リソース
-			uint32_t srvIndex;
-			D3D12_CPU_DESCRIPTOR_HANDLE srvHandleCPU;
-			D3D12_GPU_DESCRIPTOR_HANDLE srvHandleGPU;
-		};
+		/// <summary>
+		/// メモリ予算のセッター
+		/// </summary>
+		/// <param name="memoryBudget">バイト数</param>
+		void SetMemoryBudget(uint64_t memoryBudget) { textureCache_->SetMemoryBudget(memoryBudget); }
 
 		///-------------------------------------------/// 
 		/// メンバ変数
@@ -127,10 +218,39 @@ namespace Engine {
 		// DirectXUtilityのインスタンス
 		DirectXUtility* dxUtility_ = nullptr;
 
-		// テクスチャデータ
-		std::unordered_map<std::string, TextureData> textureDatas;
+		// テクスチャデータのキャッシュ キー : フルパスのアセットID
+		std::shared_ptr<AssetCache<TextureData>> textureCache_ = std::make_shared<AssetCache<TextureData>>();
+
+		// 描画時に見つからなかったテクスチャのスレッドごとの入れ物
+		std::vector<std::unique_ptr<MissingTextureList>> missingLists_;
+
+		// スレッドごとの入れ物の追加を守るミューテックス (各スレッドで最初に見つからなかったときだけ使う)
+		std::mutex missingListsMutex_;
+
+		// 見つからなかったときの代わりのテクスチャ (追い出されないように持ち続ける)
+		AssetHandle<TextureData> fallbackTexture_;
+
+		// 追い出したテクスチャ フェンス値 : テクスチャ (GPUが使い終わるまで解放を待つ)
+		std::vector<std::pair<uint64_t, TextureData>> retiredTextures_;
+
+		// 転送に使った中間リソース フェンス値 : リソース (GPUが使い終わるまで解放を待つ)
+		std::vector<std::pair<uint64_t, Microsoft::WRL::ComPtr<ID3D12Resource>>> pendingIntermediateResources_;
 
 		// ベースのディレクトリパス
 		const std::string baseDirectoryPath = "Resources/Textures";
+
+		// 見つからなかったときの代わりのテクスチャのファイル名
+		const std::string fallbackTextureFileName = "White1x1.png";
+
+		///-------------------------------------------/// 
+		/// 定数
+		///-------------------------------------------///
+	private:
+
+		// デフォルトのメモリ予算 (256MB)
+		static const uint64_t kDefaultMemoryBudget = 256ull * 1024 * 1024;
 	};
+
+	// テクスチャのハンドル
+	using TextureHandle = AssetHandle<TextureManager::TextureData>;
 }
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Matrix4x4.h"
+#include "VertexData.h"
+
+#include <cstdint>
+
+namespace Engine {
+
+	/// === クック済みメッシュ(.mesh)のファイルフォーマット === ///
+	/// ファイルの先頭にヘッダーを置き、各ストリームはヘッダーのオフセットから直接参照する
+	/// [ヘッダー][頂点ストリーム][インデックスストリーム][マテリアルテーブル][ノード階層][文字列テーブル]
+	namespace MeshFileFormat {
+
+		// ファイル識別子 "MESH"
+		static const uint32_t kMagic = 0x4853454D;
+
+		// フォーマットのバージョン (構造を変えたら上げる)
+		static const uint32_t kVersion = 1;
+
+		// クック済みファイルの拡張子
+		static const char* const kExtension = ".mesh";
+
+		// ヘッダー
+		struct Header {
+			uint32_t magic;				// ファイル識別子
+			uint32_t version;			// バージョン
+			uint32_t vertexCount;		// 頂点数
+			uint32_t indexCount;		// インデックス数
+			uint32_t materialCount;		// マテリアル数
+			uint32_t nodeCount;			// ノード数
+			uint32_t stringTableSize;	// 文字列テーブルのサイズ(バイト)
+			uint32_t padding;
+			uint64_t vertexOffset;		// 頂点ストリームの位置
+			uint64_t indexOffset;		// インデックスストリームの位置
+			uint64_t materialOffset;	// マテリアルテーブルの位置
+			uint64_t nodeOffset;		// ノード階層の位置
+			uint64_t stringTableOffset; // 文字列テーブルの位置
+		};
+
+		// マテリアル
+		struct Material {
+			uint32_t textureNameOffset; // 文字列テーブル内のテクスチャファイル名の位置
+			uint32_t textureNameLength; // テクスチャファイル名の長さ (0ならテクスチャなし)
+		};
+
+		// ノード (深さ優先の前順で並べる)
+		struct Node {
+			Matrix4x4 localMatrix;		// ローカル行列
+			uint32_t nameOffset;		// 文字列テーブル内のノード名の位置
+			uint32_t nameLength;		// ノード名の長さ
+			uint32_t childCount;		// 子ノードの数
+			uint32_t padding;
+		};
+
+		// 頂点はVertexDataをそのまま並べるのでレイアウトが変わったら気づけるようにする
+		static_assert(sizeof(VertexData) == 36, "VertexDataのレイアウトが変わったらkVersionを上げること");
+		static_assert(sizeof(Header) == 72, "Headerのサイズが変わったらkVersionを上げること");
+	}
+}
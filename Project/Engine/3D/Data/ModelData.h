@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Matrix4x4.h"
+#include "AABB.h"
 #include "MaterialData.h"
 #include "VertexData.h"
 
@@ -18,7 +19,9 @@ namespace Engine {
 	// モデルデータ
 	struct ModelData {
 		std::vector<VertexData> vertices;
+		std::vector<uint32_t> indices;
 		MaterialData material;
 		Node rootNode;
+		AABB bounds;	// 頂点を囲む境界ボックス (読み込み時に計算する。カリングに使う)
 	};
 }
\ No newline at end of file
@@ -0,0 +1,261 @@
+#include "LightClusterer.h"
+#include "MathVector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <execution>
+#include <numeric>
+#include <xmmintrin.h>
+#include <imgui.h>
+
+using namespace Engine;
+using namespace MathVector;
+
+void LightClusterer::Build(const Matrix4x4& viewMatrix, const Matrix4x4& projectionMatrix, float nearClip, float farClip, const std::vector<LightBounds>& lights) {
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	/// === クラスタの境界ボックス === ///
+
+	// 透視投影行列から画角の半分のtanを取り出す
+	float tanHalfFovX = 1.0f / projectionMatrix.m[0][0];
+	float tanHalfFovY = 1.0f / projectionMatrix.m[1][1];
+
+	// 画角と深度の範囲が変わったときだけ作り直す
+	if (clusterBounds_.empty() ||
+		boundsParameters_[0] != tanHalfFovX || boundsParameters_[1] != tanHalfFovY ||
+		boundsParameters_[2] != nearClip || boundsParameters_[3] != farClip) {
+		BuildClusterBounds(tanHalfFovX, tanHalfFovY, nearClip, farClip);
+	}
+
+	/// === ライトをビュー空間に変換 === ///
+
+	viewLights_.resize(lights.size());
+	for (size_t i = 0; i < lights.size(); ++i) {
+		viewLights_[i].position = Transform(lights[i].position, viewMatrix);
+		viewLights_[i].radius = lights[i].radius;
+	}
+
+	/// === スライスごとに並列で割り当てる === ///
+
+	if (slices_.size() != kClusterCountZ) {
+		slices_.resize(kClusterCountZ);
+	}
+
+	std::vector<uint32_t> sliceNumbers(kClusterCountZ);
+	std::iota(sliceNumbers.begin(), sliceNumbers.end(), 0);
+	std::for_each(std::execution::par, sliceNumbers.begin(), sliceNumbers.end(), [this](uint32_t slice) {
+		AssignSlice(slice);
+	});
+
+	/// === スライスの結果を1つの配列に詰める === ///
+
+	clusterRanges_.resize(kClusterCount);
+	lightIndices_.clear();
+	maxClusterLightCount_ = 0;
+
+	const uint32_t clusterCountPerSlice = kClusterCountX * kClusterCountY;
+	for (uint32_t slice = 0; slice < kClusterCountZ; ++slice) {
+
+		const SliceWork& work = slices_[slice];
+		uint32_t base = static_cast<uint32_t>(lightIndices_.size());
+
+		for (uint32_t i = 0; i < clusterCountPerSlice; ++i) {
+			ClusterRange range = work.ranges[i];
+			range.offset += base;
+			clusterRanges_[slice * clusterCountPerSlice + i] = range;
+			maxClusterLightCount_ = (std::max)(maxClusterLightCount_, range.count);
+		}
+
+		lightIndices_.insert(lightIndices_.end(), work.indices.begin(), work.indices.end());
+	}
+
+	// 統計を記録
+	buildMicroseconds_ = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+void LightClusterer::ShowImGui() {
+
+#ifdef USE_IMGUI
+
+	if (ImGui::TreeNode("LightClusterer")) {
+
+		ImGui::Text("Clusters: %u x %u x %u", kClusterCountX, kClusterCountY, kClusterCountZ);
+		ImGui::Text("Assigned: %u  Max/Cluster: %u", GetAssignedCount(), maxClusterLightCount_);
+		ImGui::Text("Build: %.1f us", buildMicroseconds_);
+
+		ImGui::TreePop();
+	}
+
+#endif // USE_IMGUI
+}
+
+uint32_t LightClusterer::CalculateSlice(float viewDepth, float nearClip, float farClip) {
+
+	// 近平面より手前は最初のスライス
+	if (viewDepth <= nearClip) {
+		return 0;
+	}
+
+	// 深度の対数で等分する
+	float slice = std::log(viewDepth / nearClip) / std::log(farClip / nearClip) * static_cast<float>(kClusterCountZ);
+
+	return (std::min)(static_cast<uint32_t>(slice), kClusterCountZ - 1);
+}
+
+float LightClusterer::CalculateSliceDepth(uint32_t slice, float nearClip, float farClip) {
+
+	// near * (far / near) ^ (slice / 分割数)
+	return nearClip * std::pow(farClip / nearClip, static_cast<float>(slice) / static_cast<float>(kClusterCountZ));
+}
+
+void LightClusterer::BuildClusterBounds(float tanHalfFovX, float tanHalfFovY, float nearClip, float farClip) {
+
+	clusterBounds_.resize(kClusterCount);
+
+	for (uint32_t z = 0; z < kClusterCountZ; ++z) {
+
+		// スライスの手前と奥の深度
+		float depthNear = CalculateSliceDepth(z, nearClip, farClip);
+		float depthFar = CalculateSliceDepth(z + 1, nearClip, farClip);
+
+		for (uint32_t y = 0; y < kClusterCountY; ++y) {
+
+			// タイルの上下 (NDC、yは画面の上から)
+			float top = 1.0f - 2.0f * static_cast<float>(y) / static_cast<float>(kClusterCountY);
+			float bottom = 1.0f - 2.0f * static_cast<float>(y + 1) / static_cast<float>(kClusterCountY);
+
+			for (uint32_t x = 0; x < kClusterCountX; ++x) {
+
+				// タイルの左右 (NDC)
+				float left = -1.0f + 2.0f * static_cast<float>(x) / static_cast<float>(kClusterCountX);
+				float right = -1.0f + 2.0f * static_cast<float>(x + 1) / static_cast<float>(kClusterCountX);
+
+				// 手前と奥の4隅を囲む
+				float minX = (std::min)(left * tanHalfFovX * depthNear, left * tanHalfFovX * depthFar);
+				float maxX = (std::max)(right * tanHalfFovX * depthNear, right * tanHalfFovX * depthFar);
+				float minY = (std::min)(bottom * tanHalfFovY * depthNear, bottom * tanHalfFovY * depthFar);
+				float maxY = (std::max)(top * tanHalfFovY * depthNear, top * tanHalfFovY * depthFar);
+
+				clusterBounds_[x + y * kClusterCountX + z * kClusterCountX * kClusterCountY] = AABB{
+					{ minX, minY, depthNear },
+					{ maxX, maxY, depthFar }
+				};
+			}
+		}
+	}
+
+	// 作ったときの値を記録
+	boundsParameters_[0] = tanHalfFovX;
+	boundsParameters_[1] = tanHalfFovY;
+	boundsParameters_[2] = nearClip;
+	boundsParameters_[3] = farClip;
+}
+
+void LightClusterer::AssignSlice(uint32_t slice) {
+
+	SliceWork& work = slices_[slice];
+
+	const uint32_t clusterCountPerSlice = kClusterCountX * kClusterCountY;
+	const uint32_t firstCluster = slice * clusterCountPerSlice;
+
+	work.ranges.assign(clusterCountPerSlice, ClusterRange{ 0, 0 });
+	work.indices.clear();
+
+	/// === スライスの深度に届くライトだけを集める === ///
+
+	// スライス全体を囲む境界ボックス (左上のクラスタと右下のクラスタから作る)
+	const AABB& topLeft = clusterBounds_[firstCluster];
+	const AABB& bottomRight = clusterBounds_[firstCluster + clusterCountPerSlice - 1];
+	AABB sliceBounds = {
+		{ topLeft.min.x, bottomRight.min.y, topLeft.min.z },
+		{ bottomRight.max.x, topLeft.max.y, topLeft.max.z }
+	};
+
+	work.lightX.clear();
+	work.lightY.clear();
+	work.lightZ.clear();
+	work.lightRadius.clear();
+	work.lightIds.clear();
+
+	for (uint32_t i = 0; i < static_cast<uint32_t>(viewLights_.size()); ++i) {
+
+		const LightBounds& light = viewLights_[i];
+
+		if (light.radius <= 0.0f) {
+			continue;
+		}
+
+		// 球の中心から境界ボックスまでの距離が半径より遠ければ届かない
+		float dx = (std::max)({ 0.0f, sliceBounds.min.x - light.position.x, light.position.x - sliceBounds.max.x });
+		float dy = (std::max)({ 0.0f, sliceBounds.min.y - light.position.y, light.position.y - sliceBounds.max.y });
+		float dz = (std::max)({ 0.0f, sliceBounds.min.z - light.position.z, light.position.z - sliceBounds.max.z });
+		if (light.radius * light.radius < dx * dx + dy * dy + dz * dz) {
+			continue;
+		}
+
+		work.lightX.push_back(light.position.x);
+		work.lightY.push_back(light.position.y);
+		work.lightZ.push_back(light.position.z);
+		work.lightRadius.push_back(light.radius);
+		work.lightIds.push_back(i);
+	}
+
+	uint32_t lightCount = static_cast<uint32_t>(work.lightIds.size());
+	if (lightCount == 0) {
+		return;
+	}
+
+	// 4の倍数まで詰め物をする (詰め物は判定されるが結果は参照されない)
+	size_t paddedCount = (static_cast<size_t>(lightCount) + 3) & ~static_cast<size_t>(3);
+	work.lightX.resize(paddedCount, 0.0f);
+	work.lightY.resize(paddedCount, 0.0f);
+	work.lightZ.resize(paddedCount, 0.0f);
+	work.lightRadius.resize(paddedCount, 0.0f);
+
+	/// === クラスタごとに4個ずつ判定する === ///
+
+	const __m128 zero = _mm_setzero_ps();
+
+	for (uint32_t i = 0; i < clusterCountPerSlice; ++i) {
+
+		const AABB& bounds = clusterBounds_[firstCluster + i];
+
+		__m128 minX = _mm_set1_ps(bounds.min.x);
+		__m128 minY = _mm_set1_ps(bounds.min.y);
+		__m128 minZ = _mm_set1_ps(bounds.min.z);
+		__m128 maxX = _mm_set1_ps(bounds.max.x);
+		__m128 maxY = _mm_set1_ps(bounds.max.y);
+		__m128 maxZ = _mm_set1_ps(bounds.max.z);
+
+		work.ranges[i].offset = static_cast<uint32_t>(work.indices.size());
+
+		for (uint32_t light = 0; light < lightCount; light += 4) {
+
+			__m128 x = _mm_loadu_ps(&work.lightX[light]);
+			__m128 y = _mm_loadu_ps(&work.lightY[light]);
+			__m128 z = _mm_loadu_ps(&work.lightZ[light]);
+			__m128 radius = _mm_loadu_ps(&work.lightRadius[light]);
+
+			// 球の中心から境界ボックスまでの各軸の距離 (内側なら0)
+			__m128 dx = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(minX, x), _mm_sub_ps(x, maxX)));
+			__m128 dy = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(minY, y), _mm_sub_ps(y, maxY)));
+			__m128 dz = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(minZ, z), _mm_sub_ps(z, maxZ)));
+
+			// 距離の2乗 <= 半径の2乗 なら届く
+			__m128 distanceSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+			int hitMask = _mm_movemask_ps(_mm_cmple_ps(distanceSq, _mm_mul_ps(radius, radius)));
+
+			// 結果を書き込む
+			uint32_t laneCount = (std::min)(4u, lightCount - light);
+			for (uint32_t lane = 0; lane < laneCount; ++lane) {
+				if ((hitMask >> lane) & 1) {
+					work.indices.push_back(work.lightIds[light + lane]);
+				}
+			}
+		}
+
+		work.ranges[i].count = static_cast<uint32_t>(work.indices.size()) - work.ranges[i].offset;
+	}
+}
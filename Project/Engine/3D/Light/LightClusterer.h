@@ -0,0 +1,196 @@
+#pragma once
+
+#include "AABB.h"
+#include "Vector3.h"
+#include "Matrix4x4.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+
+	/// === ライトのクラスタリング === ///
+	/// 視錐台を画面のタイルと指数分割した深度でフラスタム状のクラスタ(フロクセル)に分け、各クラスタに届くライトの番号を並べる
+	/// 深度スライスごとに並列で、ライトの球とクラスタの境界ボックスを4個ずつSIMDで判定する
+	/// 行列とライトの球だけを扱うのでグラフィックスAPIには依存しない
+	///
+	/// 結果の並び
+	///   クラスタ番号 = x + y * kClusterCountX + z * kClusterCountX * kClusterCountY (yは画面の上から)
+	///   クラスタごとの範囲 (offset, count) でライトの番号の配列を参照する
+	class LightClusterer {
+
+		///-------------------------------------------///
+		/// 構造体
+		///-------------------------------------------///
+	public:
+
+		// ライトの影響範囲 (ワールド空間の球)
+		struct LightBounds {
+			Vector3 position;	// 中心
+			float radius;		// 半径 (0以下ならどのクラスタにも入らない)
+		};
+
+		// クラスタのライトの範囲
+		struct ClusterRange {
+			uint32_t offset;	// ライトの番号の配列の開始位置
+			uint32_t count;		// ライトの数
+		};
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// ライトをクラスタに割り当てる
+		/// </summary>
+		/// <param name="viewMatrix">ビュー行列</param>
+		/// <param name="projectionMatrix">透視投影行列 (画角だけを使う)</param>
+		/// <param name="nearClip">近平面までの距離</param>
+		/// <param name="farClip">遠平面までの距離</param>
+		/// <param name="lights">ライトの影響範囲 (配列の番号がライトの番号になる)</param>
+		void Build(const Matrix4x4& viewMatrix, const Matrix4x4& projectionMatrix, float nearClip, float farClip, const std::vector<LightBounds>& lights);
+
+		/// <summary>
+		/// ImGui表示
+		/// </summary>
+		void ShowImGui();
+
+		/// <summary>
+		/// ビュー空間の深度からスライス番号を求める
+		/// </summary>
+		/// <param name="viewDepth">ビュー空間の深度</param>
+		/// <param name="nearClip">近平面までの距離</param>
+		/// <param name="farClip">遠平面までの距離</param>
+		/// <returns>スライス番号 (範囲外は端に丸める)</returns>
+		static uint32_t CalculateSlice(float viewDepth, float nearClip, float farClip);
+
+		/// <summary>
+		/// スライスの手前側の深度を求める
+		/// </summary>
+		/// <param name="slice">スライス番号 (kClusterCountZなら遠平面)</param>
+		/// <param name="nearClip">近平面までの距離</param>
+		/// <param name="farClip">遠平面までの距離</param>
+		/// <returns>ビュー空間の深度</returns>
+		static float CalculateSliceDepth(uint32_t slice, float nearClip, float farClip);
+
+		///-------------------------------------------///
+		/// クラス内関数
+		///-------------------------------------------///
+	private:
+
+		/// <summary>
+		/// クラスタの境界ボックスを作り直す (画角と深度の範囲が変わったときだけ)
+		/// </summary>
+		/// <param name="tanHalfFovX">横の画角の半分のtan</param>
+		/// <param name="tanHalfFovY">縦の画角の半分のtan</param>
+		/// <param name="nearClip">近平面までの距離</param>
+		/// <param name="farClip">遠平面までの距離</param>
+		void BuildClusterBounds(float tanHalfFovX, float tanHalfFovY, float nearClip, float farClip);
+
+		/// <summary>
+		/// 1つの深度スライスのクラスタにライトを割り当てる (スライスごとに別の領域に書くので並列に呼べる)
+		/// </summary>
+		/// <param name="slice">スライス番号</param>
+		void AssignSlice(uint32_t slice);
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// クラスタごとのライトの範囲の取得
+		/// </summary>
+		/// <returns></returns>
+		const std::vector<ClusterRange>& GetClusterRanges() const { return clusterRanges_; }
+
+		/// <summary>
+		/// ライトの番号の配列の取得
+		/// </summary>
+		/// <returns></returns>
+		const std::vector<uint32_t>& GetLightIndices() const { return lightIndices_; }
+
+		/// <summary>
+		/// クラスタのビュー空間の境界ボックスの取得
+		/// </summary>
+		/// <param name="cluster">クラスタ番号</param>
+		/// <returns></returns>
+		const AABB& GetClusterBounds(uint32_t cluster) const { return clusterBounds_[cluster]; }
+
+		/// <summary>
+		/// 前回のBuildで割り当てたライトの番号の総数の取得
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetAssignedCount() const { return static_cast<uint32_t>(lightIndices_.size()); }
+
+		/// <summary>
+		/// 前回のBuildでの1つのクラスタの最大ライト数の取得
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetMaxClusterLightCount() const { return maxClusterLightCount_; }
+
+		/// <summary>
+		/// 前回のBuildにかかった時間(マイクロ秒)の取得
+		/// </summary>
+		/// <returns></returns>
+		float GetBuildMicroseconds() const { return buildMicroseconds_; }
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// クラスタのビュー空間の境界ボックス
+		std::vector<AABB> clusterBounds_;
+
+		// 境界ボックスを作ったときの画角と深度の範囲
+		float boundsParameters_[4] = {};
+
+		// スライスごとの作業領域
+		struct SliceWork {
+			std::vector<float> lightX;			// スライスに届くライトの球 (SoA、4の倍数まで詰め物をする)
+			std::vector<float> lightY;
+			std::vector<float> lightZ;
+			std::vector<float> lightRadius;
+			std::vector<uint32_t> lightIds;		// スライスに届くライトの番号
+			std::vector<ClusterRange> ranges;	// スライス内のクラスタの範囲 (スライス内の位置)
+			std::vector<uint32_t> indices;		// スライス内のライトの番号
+		};
+
+		// ビュー空間のライトの球
+		std::vector<LightBounds> viewLights_;
+
+		// スライスごとの作業領域
+		std::vector<SliceWork> slices_;
+
+		// クラスタごとのライトの範囲
+		std::vector<ClusterRange> clusterRanges_;
+
+		// ライトの番号の配列
+		std::vector<uint32_t> lightIndices_;
+
+		// 前回の1つのクラスタの最大ライト数
+		uint32_t maxClusterLightCount_ = 0;
+
+		// 前回の割り当てにかかった時間(マイクロ秒)
+		float buildMicroseconds_ = 0.0f;
+
+		///-------------------------------------------///
+		/// 定数
+		///-------------------------------------------///
+	public:
+
+		// 画面の横の分割数
+		static const uint32_t kClusterCountX = 16;
+
+		// 画面の縦の分割数
+		static const uint32_t kClusterCountY = 9;
+
+		// 深度の分割数
+		static const uint32_t kClusterCountZ = 24;
+
+		// クラスタの総数
+		static const uint32_t kClusterCount = kClusterCountX * kClusterCountY * kClusterCountZ;
+	};
+}
@@ -0,0 +1,242 @@
+#include "LightManager.h"
+#include "DirectXUtility.h"
+#include "Camera.h"
+#include "WinApp.h"
+#include "MathVector.h"
+#include "MathRandom.h"
+
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include <imgui.h>
+
+using namespace Engine;
+using namespace MathVector;
+
+void LightManager::Initialize() {
+
+	// DirectXユーティリティのインスタンス取得
+	dxUtility_ = DirectXUtility::GetInstance();
+
+	/// === 平行光源 === ///
+	directionalLight_.color = { 1.0f, 1.0f, 1.0f, 1.0f }; // 白
+	directionalLight_.direction = { 0.0f, -1.0f, 0.0f }; // 向きは下から
+	directionalLight_.intensity = 1.0f; // 輝度は最大
+
+	/// === 点光源 === ///
+	LocalLight pointLight{};
+	pointLight.type = LightType::Point;
+	pointLight.color = { 1.0f, 1.0f, 1.0f, 1.0f }; // 白
+	pointLight.position = { 0.0f, 2.0f, 0.0f }; // 位置は上から
+	pointLight.intensity = 1.0f; // 輝度は最大
+	pointLight.distance = 5.0f; // 最大距離は広く
+	pointLight.decay = 2.0f; // 減衰あり
+	AddLocalLight(pointLight);
+
+	/// === スポットライト === ///
+	LocalLight spotLight{};
+	spotLight.type = LightType::Spot;
+	spotLight.color = { 1.0f, 1.0f, 1.0f, 1.0f }; // 白
+	spotLight.position = { -2.0f, 1.25f, 0.0f }; // 位置は左から
+	spotLight.direction = { -1.0f, 0.0f, 0.0f }; // 右向き
+	spotLight.intensity = 4.0f; // 輝度は強め
+	spotLight.distance = 7.0f; // 最大距離は広く
+	spotLight.decay = 2.0f; // 減衰あり
+	spotLight.cosAngle = std::cos(std::numbers::pi_v<float> / 3.0f); // π/3
+	spotLight.cosFalloffStart = spotLight.cosAngle + 0.01f; // cosAngleよりちょっと大きい
+	AddLocalLight(spotLight);
+
+	// 環境光の輝度は最大
+	environmentIntensity_ = 1.0f;
+}
+
+void LightManager::Upload(const Camera* camera, float alpha) {
+
+	// 3Dオブジェクトの描画と同じ補間したビュー行列 (カメラがなければ使わない)
+	Matrix4x4 viewMatrix = camera ? camera->GetInterpolatedViewMatrix(alpha) : Matrix4x4{};
+
+	// アップロードアロケータ
+	UploadAllocator& uploadAllocator = dxUtility_->GetUploadAllocator();
+
+	/// === シーン共通のライト === ///
+
+	SceneLight sceneLight{};
+	sceneLight.directionalLight = directionalLight_;
+	sceneLight.directionalLight.direction = Normalize(directionalLight_.direction); // 向きはここで1度だけ正規化する
+	sceneLight.cameraPosition = camera ? camera->GetInterpolatedWorldPosition(alpha) : Vector3{ 0.0f, 0.0f, 0.0f };
+	sceneLight.environmentIntensity = environmentIntensity_;
+	sceneLight.localLightCount = GetLocalLightCount();
+
+	// ピクセルシェーダーでクラスタ番号を求めるための値
+	if (camera) {
+		sceneLight.viewDepthVector = { viewMatrix.m[0][2], viewMatrix.m[1][2], viewMatrix.m[2][2], viewMatrix.m[3][2] };
+		sceneLight.clusterNearClip = camera->GetNearClip();
+		sceneLight.clusterSliceScale = static_cast<float>(LightClusterer::kClusterCountZ) / std::log(camera->GetFarClip() / camera->GetNearClip());
+	}
+	sceneLight.clusterTileScale = {
+		static_cast<float>(LightClusterer::kClusterCountX) / static_cast<float>(WinApp::kClientWidth),
+		static_cast<float>(LightClusterer::kClusterCountY) / static_cast<float>(WinApp::kClientHeight)
+	};
+
+	sceneLightAddress_ = uploadAllocator.Push(sceneLight).gpuAddress;
+
+	/// === ローカルライト === ///
+
+	// 空でもSRVに渡すアドレスが必要なので最低1つ分は書き込む
+	std::vector<LocalLight> localLights = localLights_;
+	if (localLights.empty()) {
+		localLights.push_back(LocalLight{});
+	}
+
+	for (LocalLight& light : localLights) {
+
+		// 向きを正規化
+		if (light.type == LightType::Spot) {
+			light.direction = Normalize(light.direction);
+		}
+
+		// cosFalloffStartがcosAngleより小さい場合、cosAngleを更新
+		if (light.cosFalloffStart < light.cosAngle) {
+			light.cosFalloffStart = light.cosAngle + 0.01f;
+		}
+	}
+
+	localLightAddress_ = uploadAllocator.PushArray(localLights.data(), localLights.size(), alignof(LocalLight)).gpuAddress;
+
+	/// === クラスタ === ///
+
+	UploadClusters(camera, viewMatrix);
+}
+
+void LightManager::ShowImGui() {
+
+#ifdef USE_IMGUI
+
+	ImGui::Begin("LightManager");
+
+	if (ImGui::TreeNode("DirectionalLight")) {
+		ImGui::ColorEdit4("Color", &directionalLight_.color.x); // 色
+		ImGui::DragFloat3("Direction", &directionalLight_.direction.x, 0.01f); // 向き
+		ImGui::DragFloat("Intensity", &directionalLight_.intensity, 0.01f); // 輝度
+		ImGui::TreePop();
+	}
+
+	for (uint32_t index = 0; index < GetLocalLightCount(); ++index) {
+
+		LocalLight& light = localLights_[index];
+
+		ImGui::PushID(index);
+
+		if (ImGui::TreeNode(light.type == LightType::Point ? "PointLight" : "SpotLight")) {
+			ImGui::ColorEdit4("Color", &light.color.x); // 色
+			ImGui::DragFloat3("Position", &light.position.x, 0.01f); // 位置
+			ImGui::DragFloat("Intensity", &light.intensity, 0.01f); // 輝度
+			ImGui::DragFloat("Distance", &light.distance, 0.01f); // 最大距離
+			ImGui::DragFloat("Decay", &light.decay, 0.01f); // 減衰率
+			if (light.type == LightType::Spot) {
+				ImGui::DragFloat3("Direction", &light.direction.x, 0.01f); // 向き
+				ImGui::DragFloat("CosAngle", &light.cosAngle, 0.01f); // 余弦
+				ImGui::DragFloat("CosFalloffStart", &light.cosFalloffStart, 0.01f); // Falloff開始角度
+			}
+			ImGui::TreePop();
+		}
+
+		ImGui::PopID();
+	}
+
+	ImGui::SliderFloat("EnvironmentIntensity", &environmentIntensity_, 0.0f, 1.0f); // 環境光の輝度
+
+	ImGui::Text("LocalLights: %u", GetLocalLightCount());
+
+	// 負荷確認用に点光源をまとめて置く
+	if (ImGui::Button("Add 1000 PointLights")) {
+		for (uint32_t i = 0; i < 1000; ++i) {
+			LocalLight light{};
+			light.type = LightType::Point;
+			light.color = { MathRandom::RandomFloat(0.0f, 1.0f), MathRandom::RandomFloat(0.0f, 1.0f), MathRandom::RandomFloat(0.0f, 1.0f), 1.0f };
+			light.position = { MathRandom::RandomFloat(-50.0f, 50.0f), MathRandom::RandomFloat(0.0f, 10.0f), MathRandom::RandomFloat(-50.0f, 50.0f) };
+			light.intensity = 1.0f;
+			light.distance = MathRandom::RandomFloat(1.0f, 6.0f);
+			light.decay = 2.0f;
+			AddLocalLight(light);
+		}
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Clear")) {
+		ClearLocalLights();
+	}
+
+	clusterer_.ShowImGui();
+
+	ImGui::End();
+
+#endif // USE_IMGUI
+}
+
+void LightManager::UploadClusters(const Camera* camera, const Matrix4x4& viewMatrix) {
+
+	// アップロードアロケータ
+	UploadAllocator& uploadAllocator = dxUtility_->GetUploadAllocator();
+
+	// カメラがなければ全てのクラスタを空にする
+	if (!camera) {
+		UploadAllocator::Allocation allocation = uploadAllocator.Allocate(sizeof(LightClusterer::ClusterRange) * LightClusterer::kClusterCount, alignof(LightClusterer::ClusterRange));
+		if (allocation.IsValid()) {
+			std::memset(allocation.cpuAddress, 0, sizeof(LightClusterer::ClusterRange) * LightClusterer::kClusterCount);
+		}
+		clusterRangeAddress_ = allocation.gpuAddress;
+		clusterLightIndexAddress_ = uploadAllocator.Push(uint32_t{ 0 }, alignof(uint32_t)).gpuAddress;
+		return;
+	}
+
+	// ライトの影響範囲を光の届く最大距離の球にする
+	lightBounds_.resize(localLights_.size());
+	for (size_t i = 0; i < localLights_.size(); ++i) {
+		lightBounds_[i].position = localLights_[i].position;
+		lightBounds_[i].radius = localLights_[i].distance;
+	}
+
+	// 描画と同じ補間したカメラでクラスタに割り当てる
+	clusterer_.Build(viewMatrix, camera->GetProjectionMatrix(), camera->GetNearClip(), camera->GetFarClip(), lightBounds_);
+
+	// クラスタごとのライトの範囲
+	const std::vector<LightClusterer::ClusterRange>& ranges = clusterer_.GetClusterRanges();
+	clusterRangeAddress_ = uploadAllocator.PushArray(ranges.data(), ranges.size(), alignof(LightClusterer::ClusterRange)).gpuAddress;
+
+	// ライトの番号 (空でもSRVに渡すアドレスが必要なので最低1つ分は書き込む)
+	const std::vector<uint32_t>& indices = clusterer_.GetLightIndices();
+	if (indices.empty()) {
+		clusterLightIndexAddress_ = uploadAllocator.Push(uint32_t{ 0 }, alignof(uint32_t)).gpuAddress;
+	}
+	else {
+		clusterLightIndexAddress_ = uploadAllocator.PushArray(indices.data(), indices.size(), alignof(uint32_t)).gpuAddress;
+	}
+}
+
+void LightManager::Finalize() {
+
+	delete instance_;
+	instance_ = nullptr;
+}
+
+uint32_t LightManager::AddLocalLight(const LocalLight& light) {
+
+	localLights_.push_back(light);
+
+	return static_cast<uint32_t>(localLights_.size() - 1);
+}
+
+void LightManager::ClearLocalLights() {
+
+	localLights_.clear();
+}
+
+LightManager* LightManager::instance_ = nullptr;
+
+LightManager* LightManager::GetInstance() {
+
+	if (instance_ == nullptr) {
+		instance_ = new LightManager;
+	}
+	return instance_;
+}
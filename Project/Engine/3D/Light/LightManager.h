@@ -0,0 +1,250 @@
+#pragma once
+
+#include "LightClusterer.h"
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Vector4.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+
+	/// ===== 前方宣言 ===== ///
+	class DirectXUtility;
+	class Camera;
+
+	/// === ライトマネージャー === ///
+	/// シーンのライトをまとめて持ち、フレームごとに1度だけアップロードする
+	/// 平行光源、環境、カメラは定数バッファ1つに、点光源とスポットライトはStructuredBufferにまとめて全ての3Dオブジェクトで共有する
+	/// ローカルライトはカメラの視錐台のクラスタに割り当て、ピクセルシェーダーは自分のクラスタのライトだけを計算する (クラスタードフォワード)
+	class LightManager {
+
+		///-------------------------------------------///
+		/// シングルトン
+		///-------------------------------------------///
+	private:
+
+		// インスタンス
+		static LightManager* instance_;
+
+		// コンストラクタ隠蔽
+		LightManager() = default;
+		// デストラクタ隠蔽
+		~LightManager() = default;
+		// コピーコンストラクタ禁止
+		LightManager(LightManager&) = delete;
+		// コピーオペレータ禁止
+		LightManager& operator=(LightManager&) = delete;
+
+		///-------------------------------------------///
+		/// 構造体
+		///-------------------------------------------///
+	public:
+
+		// ローカルライトの種類
+		enum class LightType : uint32_t {
+			Point,	// 点光源
+			Spot,	// スポットライト
+		};
+
+		// 平行光源データ
+		struct DirectionalLight {
+			Vector4 color; // 色
+			Vector3 direction; // 向き
+			float intensity; // 輝度
+		};
+
+		// ローカルライトデータ (点光源とスポットライト)
+		struct LocalLight {
+			Vector4 color; // 色
+			Vector3 position; // 位置
+			float intensity; // 輝度
+			Vector3 direction; // 向き (スポットライトのみ)
+			float distance; // 光の届く最大距離
+			float decay; // 減衰率
+			float cosAngle; // 余弦 (スポットライトのみ)
+			float cosFalloffStart; // Falloffの開始角度 (スポットライトのみ)
+			LightType type; // 種類
+		};
+
+		// シーン全体で共通のライトデータ
+		struct SceneLight {
+			DirectionalLight directionalLight; // 平行光源
+			Vector3 cameraPosition; // カメラのワールド座標
+			float environmentIntensity; // 環境光の輝度
+			Vector4 viewDepthVector; // ワールド座標(w=1)との内積でビュー空間の深度になるベクトル (ビュー行列の3列目)
+			Vector2 clusterTileScale; // ピクセル座標にかけるとクラスタのタイル番号になる値
+			float clusterNearClip; // クラスタの近平面までの距離
+			float clusterSliceScale; // log(深度 / 近平面) にかけるとスライス番号になる値
+			uint32_t localLightCount; // ローカルライトの数
+			float padding[3];
+		};
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 初期化 (今までの3Dオブジェクトの初期値と同じライトを1つずつ置く)
+		/// </summary>
+		void Initialize();
+
+		/// <summary>
+		/// 今のフレームのライトをアップロードする (コマンドの並列記録が始まる前に、メインスレッドから1フレームに1度呼ぶ)
+		/// カメラの位置とクラスタは、3Dオブジェクトの描画と同じく前のステップとの間を補間したカメラで求める
+		/// </summary>
+		/// <param name="camera">カメラ (鏡面反射、環境マップ、クラスタに使う)</param>
+		/// <param name="alpha">補間係数 (描画と同じGameClock::GetAlpha)</param>
+		void Upload(const Camera* camera, float alpha);
+
+		/// <summary>
+		/// ImGui表示
+		/// </summary>
+		void ShowImGui();
+
+		/// <summary>
+		/// 終了
+		/// </summary>
+		void Finalize();
+
+		/// <summary>
+		/// ローカルライトの追加
+		/// </summary>
+		/// <param name="light">ライト</param>
+		/// <returns>番号 (32未満なら3Dオブジェクトのライトマスクのビット番号になる)</returns>
+		uint32_t AddLocalLight(const LocalLight& light);
+
+		/// <summary>
+		/// ローカルライトを全て削除
+		/// </summary>
+		void ClearLocalLights();
+
+		///-------------------------------------------///
+		/// クラス内関数
+		///-------------------------------------------///
+	private:
+
+		/// <summary>
+		/// ローカルライトをクラスタに割り当ててアップロードする
+		/// </summary>
+		/// <param name="camera">カメラ (なければどのクラスタにもライトを入れない)</param>
+		/// <param name="viewMatrix">描画に使う補間したビュー行列</param>
+		void UploadClusters(const Camera* camera, const Matrix4x4& viewMatrix);
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// インスタンスの取得
+		/// </summary>
+		/// <returns>インスタンス</returns>
+		static LightManager* GetInstance();
+
+		/// <summary>
+		/// 平行光源のゲッター
+		/// </summary>
+		/// <returns></returns>
+		DirectionalLight& GetDirectionalLight() { return directionalLight_; }
+
+		/// <summary>
+		/// ローカルライトのゲッター
+		/// </summary>
+		/// <param name="index">番号</param>
+		/// <returns></returns>
+		LocalLight& GetLocalLight(uint32_t index) { return localLights_[index]; }
+
+		/// <summary>
+		/// ローカルライトの数のゲッター
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetLocalLightCount() const { return static_cast<uint32_t>(localLights_.size()); }
+
+		/// <summary>
+		/// シーン共通のライトの定数バッファのGPUアドレスのゲッター (Uploadの後に有効)
+		/// </summary>
+		/// <returns></returns>
+		uint64_t GetSceneLightAddress() const { return sceneLightAddress_; }
+
+		/// <summary>
+		/// ローカルライトのStructuredBufferのGPUアドレスのゲッター (Uploadの後に有効)
+		/// </summary>
+		/// <returns></returns>
+		uint64_t GetLocalLightAddress() const { return localLightAddress_; }
+
+		/// <summary>
+		/// クラスタごとのライトの範囲のStructuredBufferのGPUアドレスのゲッター (Uploadの後に有効)
+		/// </summary>
+		/// <returns></returns>
+		uint64_t GetClusterRangeAddress() const { return clusterRangeAddress_; }
+
+		/// <summary>
+		/// クラスタのライトの番号のStructuredBufferのGPUアドレスのゲッター (Uploadの後に有効)
+		/// </summary>
+		/// <returns></returns>
+		uint64_t GetClusterLightIndexAddress() const { return clusterLightIndexAddress_; }
+
+		/// <summary>
+		/// ライトを全て書き込めたか (アップロードリングが足りなければ偽になり、3Dオブジェクトは描画を飛ばす)
+		/// </summary>
+		/// <returns></returns>
+		bool IsUploaded() const { return sceneLightAddress_ != 0 && localLightAddress_ != 0 && clusterRangeAddress_ != 0 && clusterLightIndexAddress_ != 0; }
+
+		/// <summary>
+		/// クラスタリングのゲッター
+		/// </summary>
+		/// <returns></returns>
+		const LightClusterer& GetClusterer() const { return clusterer_; }
+
+		///-------------------------------------------///
+		/// セッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 環境光の輝度のセッター
+		/// </summary>
+		/// <param name="intensity">輝度</param>
+		void SetEnvironmentIntensity(float intensity) { environmentIntensity_ = intensity; }
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// 平行光源
+		DirectionalLight directionalLight_{};
+
+		// ローカルライト
+		std::vector<LocalLight> localLights_;
+
+		// 環境光の輝度
+		float environmentIntensity_ = 1.0f;
+
+		// シーン共通のライトの定数バッファのGPUアドレス (書き込めなければ0)
+		uint64_t sceneLightAddress_ = 0;
+
+		// ローカルライトのStructuredBufferのGPUアドレス
+		uint64_t localLightAddress_ = 0;
+
+		// クラスタごとのライトの範囲のStructuredBufferのGPUアドレス
+		uint64_t clusterRangeAddress_ = 0;
+
+		// クラスタのライトの番号のStructuredBufferのGPUアドレス
+		uint64_t clusterLightIndexAddress_ = 0;
+
+		// ライトのクラスタリング
+		LightClusterer clusterer_;
+
+		// クラスタリングに渡すライトの影響範囲 (フレームごとに使い回す)
+		std::vector<LightClusterer::LightBounds> lightBounds_;
+
+		/// ===== 借りポインタ・インスタンス ===== ///
+
+		// DirectXユーティリティのインスタンス
+		DirectXUtility* dxUtility_ = nullptr;
+	};
+}
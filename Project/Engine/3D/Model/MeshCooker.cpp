@@ -0,0 +1,168 @@
+#include "MeshCooker.h"
+#include "MeshFile.h"
+#include "Data/MeshFileFormat.h"
+#include "Logger.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <unordered_map>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+	/// <summary>
+	/// ノードを読む
+	/// </summary>
+	/// <param name="node">assimpのノード</param>
+	/// <returns>ノード</returns>
+	Node ReadNode(aiNode* node) {
+
+		Node result;
+
+		aiMatrix4x4 aiLocalMatrix = node->mTransformation; // nodeのlocalMatrixを取得
+		aiLocalMatrix.Transpose(); // 列ベクトル形式を行ベクトル形式に転置
+
+		for (uint32_t i = 0; i < 4; ++i) {
+			for (uint32_t j = 0; j < 4; ++j) {
+				result.localMatrix.m[i][j] = aiLocalMatrix[j][i];
+			}
+		}
+
+		result.name = node->mName.C_Str(); // Node名を格納
+		result.children.resize(node->mNumChildren); // 子ノードの数だけ確保
+
+		for (uint32_t childIndex = 0; childIndex < node->mNumChildren; ++childIndex) {
+
+			// 再帰的に読んで階層構造を作っていく
+			result.children[childIndex] = ReadNode(node->mChildren[childIndex]);
+		}
+
+		return result;
+	}
+}
+
+bool MeshCooker::Cook(const std::string& sourcePath, const std::string& cookedPath) {
+
+	// 計測開始
+	auto start = std::chrono::steady_clock::now();
+
+	// ファイルが存在するか確認
+	if (!std::filesystem::exists(sourcePath)) {
+		LOG_WARNING("MeshCooker::Cook: Source file not found {}\n", sourcePath);
+		return false;
+	}
+
+	// assimpを使ってファイルを読み込む
+	Assimp::Importer importer;
+	const aiScene* scene = importer.ReadFile(sourcePath.c_str(), aiProcess_FlipWindingOrder | aiProcess_FlipUVs);
+	assert(scene && scene->HasMeshes()); // meshがないのは対応しない
+
+	ModelData modelData;
+	std::vector<VertexData>& vertices = modelData.vertices;
+	std::vector<uint32_t>& indices = modelData.indices;
+	std::vector<std::string> textureFileNames;
+
+	// 同じ頂点をまとめるためのマップ キー : 頂点のバイト列
+	std::unordered_map<std::string, uint32_t> vertexLookup;
+
+	// meshを解析する
+	for (uint32_t meshIndex = 0; meshIndex < scene->mNumMeshes; ++meshIndex) {
+
+		aiMesh* mesh = scene->mMeshes[meshIndex];
+		assert(mesh->HasNormals()); // 法線がないmeshは対応しない
+		assert(mesh->HasTextureCoords(0)); // Texcoordがないmeshは対応しない
+
+		// faceを解析する
+		for (uint32_t faceIndex = 0; faceIndex < mesh->mNumFaces; ++faceIndex) {
+
+			aiFace& face = mesh->mFaces[faceIndex];
+			assert(face.mNumIndices == 3); // 三角形以外は対応しない
+
+			//vertexを解析する
+			for (uint32_t element = 0; element < face.mNumIndices; ++element) {
+
+				uint32_t vertexIndex = face.mIndices[element];
+				aiVector3D& position = mesh->mVertices[vertexIndex];
+				aiVector3D& normal = mesh->mNormals[vertexIndex];
+				aiVector3D& texcoord = mesh->mTextureCoords[0][vertexIndex];
+
+				VertexData vertex;
+				vertex.position = { position.x, position.y, position.z, 1.0f };
+				vertex.normal = { normal.x, normal.y, normal.z };
+				vertex.texcoord = { texcoord.x, texcoord.y };
+
+				// 左手座標系に対応させる
+				vertex.position.x *= -1.0f;
+				vertex.normal.x *= -1.0f;
+
+				// 既に同じ頂点があればそのインデックスを使う
+				std::string vertexKey(reinterpret_cast<const char*>(&vertex), sizeof(VertexData));
+				auto [it, inserted] = vertexLookup.try_emplace(vertexKey, static_cast<uint32_t>(vertices.size()));
+				if (inserted) {
+					vertices.push_back(vertex);
+				}
+				indices.push_back(it->second);
+			}
+		}
+	}
+
+	// materialを解析する
+	for (uint32_t materialIndex = 0; materialIndex < scene->mNumMaterials; ++materialIndex) {
+
+		aiMaterial* material = scene->mMaterials[materialIndex];
+
+		std::string filename;
+
+		if (material->GetTextureCount(aiTextureType_DIFFUSE) != 0) {
+
+			// テクスチャファイルパスを取得
+			aiString textureFilePath;
+			material->GetTexture(aiTextureType_DIFFUSE, 0, &textureFilePath);
+
+			// ファイル名だけを抽出して格納 (探索は読み込み時に行う)
+			filename = std::filesystem::path(textureFilePath.C_Str()).filename().string();
+		}
+
+		textureFileNames.push_back(filename);
+	}
+
+	// nodeを解析する
+	modelData.rootNode = ReadNode(scene->mRootNode);
+
+	// クック済みファイルに書き出す
+	if (!MeshFile::Write(cookedPath, modelData, textureFileNames)) {
+		return false;
+	}
+
+	// 計測終了
+	double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	LOG_DEBUG("MeshCooker::Cook: {} -> {} ({} vertices, {} indices, {:.3f} ms)\n", sourcePath, cookedPath, vertices.size(), indices.size(), milliseconds);
+
+	return true;
+}
+
+bool MeshCooker::IsStale(const std::string& sourcePath, const std::string& cookedPath) {
+
+	// クック済みファイルが無ければクックが必要
+	if (!std::filesystem::exists(cookedPath)) return true;
+
+	// 元ファイルが無ければクック済みファイルをそのまま使う
+	if (!std::filesystem::exists(sourcePath)) return false;
+
+	// 元ファイルの方が新しければクックし直す
+	return std::filesystem::last_write_time(sourcePath) > std::filesystem::last_write_time(cookedPath);
+}
+
+std::string MeshCooker::MakeCookedPath(const std::string& sourcePath) {
+
+	// 拡張子を置き換える
+	return std::filesystem::path(sourcePath).replace_extension(MeshFileFormat::kExtension).string();
+}
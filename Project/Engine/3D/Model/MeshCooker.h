@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+
+namespace Engine {
+
+	/// === メッシュクッカー === ///
+	/// Assimpでモデルファイルを解析し、そのままGPUに渡せるバイナリ(.mesh)に変換する
+	/// Assimpを使うのはクック時だけで、実行時はクック済みファイルをマップして読むだけにする
+	namespace MeshCooker {
+
+		/// <summary>
+		/// モデルファイルをクックする
+		/// </summary>
+		/// <param name="sourcePath">元ファイルのパス(.objなど)</param>
+		/// <param name="cookedPath">出力するクック済みファイルのパス</param>
+		/// <returns>成功したか</returns>
+		bool Cook(const std::string& sourcePath, const std::string& cookedPath);
+
+		/// <summary>
+		/// クックし直す必要があるか (クック済みファイルが無い、または元ファイルの方が新しい)
+		/// </summary>
+		/// <param name="sourcePath">元ファイルのパス</param>
+		/// <param name="cookedPath">クック済みファイルのパス</param>
+		/// <returns></returns>
+		bool IsStale(const std::string& sourcePath, const std::string& cookedPath);
+
+		/// <summary>
+		/// 元ファイルのパスからクック済みファイルのパスを作る
+		/// </summary>
+		/// <param name="sourcePath">元ファイルのパス</param>
+		/// <returns>クック済みファイルのパス</returns>
+		std::string MakeCookedPath(const std::string& sourcePath);
+	};
+}
@@ -0,0 +1,183 @@
+#include "MeshFile.h"
+#include "Data/MeshFileFormat.h"
+#include "MappedFile.h"
+#include "Logger.h"
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+	/// <summary>
+	/// 文字列テーブルに文字列を追加する
+	/// </summary>
+	/// <param name="stringTable">文字列テーブル</param>
+	/// <param name="str">追加する文字列</param>
+	/// <param name="offset">テーブル内の位置</param>
+	/// <param name="length">長さ</param>
+	void AddString(std::vector<char>& stringTable, const std::string& str, uint32_t& offset, uint32_t& length) {
+
+		offset = static_cast<uint32_t>(stringTable.size());
+		length = static_cast<uint32_t>(str.size());
+		stringTable.insert(stringTable.end(), str.begin(), str.end());
+	}
+
+	/// <summary>
+	/// ノードを深さ優先の前順で平坦化する
+	/// </summary>
+	/// <param name="node">ノード</param>
+	/// <param name="nodes">出力先</param>
+	/// <param name="stringTable">文字列テーブル</param>
+	void FlattenNode(const Node& node, std::vector<MeshFileFormat::Node>& nodes, std::vector<char>& stringTable) {
+
+		MeshFileFormat::Node result{};
+		result.localMatrix = node.localMatrix;
+		AddString(stringTable, node.name, result.nameOffset, result.nameLength);
+		result.childCount = static_cast<uint32_t>(node.children.size());
+		nodes.push_back(result);
+
+		for (const Node& child : node.children) {
+			FlattenNode(child, nodes, stringTable);
+		}
+	}
+}
+
+bool MeshFile::Write(const std::string& filePath, const ModelData& modelData, std::span<const std::string> textureFileNames) {
+
+	std::vector<MeshFileFormat::Material> materials;
+	std::vector<MeshFileFormat::Node> nodes;
+	std::vector<char> stringTable;
+
+	// マテリアルテーブル
+	for (const std::string& textureFileName : textureFileNames) {
+		MeshFileFormat::Material material{};
+		AddString(stringTable, textureFileName, material.textureNameOffset, material.textureNameLength);
+		materials.push_back(material);
+	}
+
+	// ノード階層
+	FlattenNode(modelData.rootNode, nodes, stringTable);
+
+	/// === ヘッダーを作成 === ///
+	MeshFileFormat::Header header{};
+	header.magic = MeshFileFormat::kMagic;
+	header.version = MeshFileFormat::kVersion;
+	header.vertexCount = static_cast<uint32_t>(modelData.vertices.size());
+	header.indexCount = static_cast<uint32_t>(modelData.indices.size());
+	header.materialCount = static_cast<uint32_t>(materials.size());
+	header.nodeCount = static_cast<uint32_t>(nodes.size());
+	header.stringTableSize = static_cast<uint32_t>(stringTable.size());
+	header.vertexOffset = sizeof(MeshFileFormat::Header);
+	header.indexOffset = header.vertexOffset + sizeof(VertexData) * modelData.vertices.size();
+	header.materialOffset = header.indexOffset + sizeof(uint32_t) * modelData.indices.size();
+	header.nodeOffset = header.materialOffset + sizeof(MeshFileFormat::Material) * materials.size();
+	header.stringTableOffset = header.nodeOffset + sizeof(MeshFileFormat::Node) * nodes.size();
+
+	/// === 一時ファイルに書き出してから置き換える (書き込み途中のファイルを読ませないため) === ///
+	std::string tempPath = filePath + ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			LOG_WARNING("MeshFile::Write: Failed to open {}\n", tempPath);
+			return false;
+		}
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(modelData.vertices.data()), sizeof(VertexData) * modelData.vertices.size());
+		file.write(reinterpret_cast<const char*>(modelData.indices.data()), sizeof(uint32_t) * modelData.indices.size());
+		file.write(reinterpret_cast<const char*>(materials.data()), sizeof(MeshFileFormat::Material) * materials.size());
+		file.write(reinterpret_cast<const char*>(nodes.data()), sizeof(MeshFileFormat::Node) * nodes.size());
+		file.write(stringTable.data(), stringTable.size());
+
+		if (!file.good()) {
+			LOG_WARNING("MeshFile::Write: Failed to write {}\n", tempPath);
+			return false;
+		}
+	}
+
+	std::error_code errorCode;
+	std::filesystem::rename(tempPath, filePath, errorCode);
+	if (errorCode) {
+		LOG_WARNING("MeshFile::Write: Failed to rename {}\n", tempPath);
+		return false;
+	}
+
+	return true;
+}
+
+std::unique_ptr<ModelData> MeshFile::Read(const std::string& filePath) {
+
+	// ファイルをメモリにマップする
+	MappedFile file;
+	if (!file.Open(filePath)) return nullptr;
+
+	// ヘッダーを確認
+	const MeshFileFormat::Header* header = file.GetPointer<MeshFileFormat::Header>(0);
+	if (header == nullptr || header->magic != MeshFileFormat::kMagic || header->version != MeshFileFormat::kVersion) {
+		LOG_WARNING("MeshFile::Read: Invalid mesh file {}\n", filePath);
+		return nullptr;
+	}
+
+	// 各ストリームを参照する (解析はせずにオフセットから直接参照するだけ)
+	const VertexData* vertices = file.GetPointer<VertexData>(header->vertexOffset, header->vertexCount);
+	const uint32_t* indices = file.GetPointer<uint32_t>(header->indexOffset, header->indexCount);
+	const MeshFileFormat::Material* materials = file.GetPointer<MeshFileFormat::Material>(header->materialOffset, header->materialCount);
+	const MeshFileFormat::Node* nodes = file.GetPointer<MeshFileFormat::Node>(header->nodeOffset, header->nodeCount);
+	const char* stringTable = file.GetPointer<char>(header->stringTableOffset, header->stringTableSize);
+
+	// 範囲外を指していたら壊れたファイルとして扱う
+	if ((header->vertexCount && !vertices) || (header->indexCount && !indices) || (header->materialCount && !materials) || !nodes || header->nodeCount == 0 || (header->stringTableSize && !stringTable)) {
+		LOG_WARNING("MeshFile::Read: Broken mesh file {}\n", filePath);
+		return nullptr;
+	}
+
+	// モデルデータを作成
+	std::unique_ptr<ModelData> modelData = std::make_unique<ModelData>();
+
+	// 頂点・インデックスはそのまま一括コピー
+	modelData->vertices.assign(vertices, vertices + header->vertexCount);
+	modelData->indices.assign(indices, indices + header->indexCount);
+
+	// 文字列テーブルから文字列を取り出す
+	auto getString = [&](uint32_t offset, uint32_t length) -> std::string {
+		if (length == 0 || static_cast<uint64_t>(offset) + length > header->stringTableSize) return std::string();
+		return std::string(stringTable + offset, length);
+	};
+
+	// テクスチャファイル名を取得 (テクスチャのあるマテリアルのうち最後のもの。探索は呼び出し側で行う)
+	for (uint32_t materialIndex = 0; materialIndex < header->materialCount; ++materialIndex) {
+
+		std::string filename = getString(materials[materialIndex].textureNameOffset, materials[materialIndex].textureNameLength);
+		if (!filename.empty()) {
+			modelData->material.textureFilePath = filename;
+		}
+	}
+
+	// 前順に並んだノードから階層構造を組み立てる
+	uint32_t nodeCursor = 0;
+	std::function<Node()> readNode = [&]() -> Node {
+
+		const MeshFileFormat::Node& source = nodes[nodeCursor++];
+
+		Node result;
+		result.localMatrix = source.localMatrix; // ローカル行列
+		result.name = getString(source.nameOffset, source.nameLength); // Node名を格納
+		result.children.resize(source.childCount); // 子ノードの数だけ確保
+
+		for (uint32_t childIndex = 0; childIndex < source.childCount && nodeCursor < header->nodeCount; ++childIndex) {
+
+			// 再帰的に読んで階層構造を作っていく
+			result.children[childIndex] = readNode();
+		}
+
+		return result;
+	};
+	modelData->rootNode = readNode();
+
+	return modelData;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Data/ModelData.h"
+
+#include <memory>
+#include <span>
+#include <string>
+
+namespace Engine {
+
+	/// === クック済みメッシュ(.mesh)の読み書き === ///
+	/// MeshFileFormatのレイアウトで書き出し、メモリにマップして解析なしで読み込む
+	/// Assimpにもテクスチャの読み込みにも依存しないので、GPUなしで確かめられる
+	namespace MeshFile {
+
+		/// <summary>
+		/// モデルデータを書き出す (一時ファイルに書いてから置き換える)
+		/// </summary>
+		/// <param name="filePath">出力するファイルのパス</param>
+		/// <param name="modelData">モデルデータ (頂点、インデックス、ノード階層を使う)</param>
+		/// <param name="textureFileNames">マテリアルごとのテクスチャファイル名 (空ならテクスチャなし)</param>
+		/// <returns>成功したか</returns>
+		bool Write(const std::string& filePath, const ModelData& modelData, std::span<const std::string> textureFileNames);
+
+		/// <summary>
+		/// モデルデータを読み込む
+		/// </summary>
+		/// <param name="filePath">クック済みファイルのパス</param>
+		/// <returns>モデルデータ (material.textureFilePathにはテクスチャのファイル名だけが入る。読めなかったらnullptr)</returns>
+		std::unique_ptr<ModelData> Read(const std::string& filePath);
+	}
+}
@@ -3,45 +3,69 @@
 #include "MathMatrix.h"
 #include "Texture/TextureManager.h"
 #include "Model/ModelManager.h"
+#include "Object/InstanceBatcher.h"
+#include "FrameCounters.h"
 #include <imgui.h>
 
 using namespace Engine;
 using namespace MathMatrix;
 
+Model::~Model() {
+
+	// GPUが使い終わるまでリソースを保持する
+	DirectXUtility::SafeRelease(vertexResource);
+	DirectXUtility::SafeRelease(indexResource);
+	DirectXUtility::SafeRelease(materialResource);
+}
+
 void Model::Initialize(const std::string& directoryName, const std::string& fileName) {
 
 	// DXUtilityのインスタンスを取得
 	dxUtility = DirectXUtility::GetInstance();
 
-	// モデルデータを検索
-	modelData = ModelManager::GetInstance()->FindModelData(directoryName, fileName);
+	// モデルデータを参照 (追い出されていたら読み込み直す)
+	modelHandle = ModelManager::GetInstance()->AcquireModelData(directoryName, fileName);
+	modelData = modelHandle.Get();
 
 	// 頂点データ初期化
 	InitializeVertexData();
 
+	// インデックスデータ初期化
+	InitializeIndexData();
+
 	// マテリアルデータ初期化
 	InitializeMaterialData();
 
-	// 読み込んだテクスチャの番号を取得し、メンバ変数に書き込む
-	modelData->material.textureIndex = TextureManager::GetInstance()->GetTextureIndexByFilePath(modelData->material.textureFilePath);
+	// テクスチャを参照して番号をメンバ変数に書き込む
+	textureHandle = TextureManager::GetInstance()->AcquireTexture(modelData->material.textureFilePath);
+	modelData->material.textureIndex = textureHandle->srvIndex;
+
+	// 環境マップを参照
+	environmentMapHandle = TextureManager::GetInstance()->AcquireTexture(environmentMapFilePath);
 }
 
-void Model::Draw() {
+void Model::Draw(uint32_t instanceCount) {
 
 	// 頂点バッファビューを設定
 	dxUtility->GetCommandList()->IASetVertexBuffers(0, 1, &vertexBufferView);
 
+	// インデックスバッファビューを設定
+	dxUtility->GetCommandList()->IASetIndexBuffer(&indexBufferView);
+
 	// マテリアルCBufferの場所を設定
 	dxUtility->GetCommandList()->SetGraphicsRootConstantBufferView(1, materialResource->GetGPUVirtualAddress());
 
 	// SRVのDescriptorTableを設定
-	dxUtility->GetCommandList()->SetGraphicsRootDescriptorTable(7, TextureManager::GetInstance()->GetSRVGPUHandle(modelData->material.textureFilePath));
+	dxUtility->GetCommandList()->SetGraphicsRootDescriptorTable(4, textureHandle->srvHandleGPU);
 
 	// SRVのDescriptorTableを設定
-	dxUtility->GetCommandList()->SetGraphicsRootDescriptorTable(8, TextureManager::GetInstance()->GetSRVGPUHandle(environmentMapFilePath));
+	dxUtility->GetCommandList()->SetGraphicsRootDescriptorTable(5, environmentMapHandle->srvHandleGPU);
 
 	// 描画(DrawCall)
-	dxUtility->GetCommandList()->DrawInstanced(UINT(modelData->vertices.size()), 1, 0, 0);
+	dxUtility->GetCommandList()->DrawIndexedInstanced(UINT(modelData->indices.size()), instanceCount, 0, 0, 0);
+
+	// 描画の統計を数える
+	FrameCounters::GetInstance()->CountDraw(instanceCount, 3);
 }
 
 void Model::ShowImGui() {
@@ -59,6 +83,40 @@ void Model::ShowImGui() {
 #endif // USE_IMGUI
 }
 
+void Model::SetEnvironmentMapFilePath(const std::string& filePath) {
+
+	environmentMapFilePath = filePath;
+
+	// 初期化済みなら参照し直す
+	if (environmentMapHandle) {
+		environmentMapHandle = TextureManager::GetInstance()->AcquireTexture(environmentMapFilePath);
+	}
+}
+
+uint64_t Model::GetBatchKey() const {
+
+	// メッシュはモデルデータ単位で共有されているのでポインタで比べる
+	uint64_t key = InstanceBatcher::HashCombine(InstanceBatcher::kHashSeed, modelData);
+
+	// テクスチャと環境マップ
+	key = InstanceBatcher::HashCombine(key, textureHandle->srvIndex);
+	key = InstanceBatcher::HashCombine(key, environmentMapHandle->srvIndex);
+
+	// マテリアルの値 (詰め物は比べない)
+	key = InstanceBatcher::HashCombine(key, materialData->color);
+	key = InstanceBatcher::HashCombine(key, materialData->lightingMode);
+	key = InstanceBatcher::HashCombine(key, materialData->uvTransform);
+	key = InstanceBatcher::HashCombine(key, materialData->shininess);
+
+	return key;
+}
+
+uint32_t Model::GetMaterialID() const {
+
+	// テクスチャの切り替えが一番重いのでSRVの番号で並べる
+	return textureHandle->srvIndex;
+}
+
 void Model::InitializeVertexData() {
 
 	/// === VertexResourceを作る === ///
@@ -80,6 +138,28 @@ void Model::InitializeVertexData() {
 	std::memcpy(vertexData, modelData->vertices.data(), sizeof(VertexData) * modelData->vertices.size());
 }
 
+void Model::InitializeIndexData() {
+
+	/// === IndexResourceを作る === ///
+	indexResource = dxUtility->CreateBufferResource(sizeof(uint32_t) * modelData->indices.size());
+
+	/// === IBVを作成する(値を設定するだけ) === ///
+
+	// リソースの先頭アドレスから使う
+	indexBufferView.BufferLocation = indexResource->GetGPUVirtualAddress();
+	// 使用するリソースのサイズ インデックスのサイズ
+	indexBufferView.SizeInBytes = UINT(sizeof(uint32_t) * modelData->indices.size());
+	// インデックスはuint32_t
+	indexBufferView.Format = DXGI_FORMAT_R32_UINT;
+
+	/// === IndexResourceにデータを書き込む === ///
+	uint32_t* indexData = nullptr;
+	indexResource->Map(0, nullptr, reinterpret_cast<void**>(&indexData));
+
+	// インデックスデータにリソースをコピー
+	std::memcpy(indexData, modelData->indices.data(), sizeof(uint32_t) * modelData->indices.size());
+}
+
 void Model::InitializeMaterialData() {
 
 	/// === MaterialResourceを作る === ///
@@ -4,6 +4,8 @@
 #include "Data/MaterialData.h"
 #include "Data/ModelData.h"
 #include "Data/VertexData.h"
+#include "Model/ModelManager.h"
+#include "Texture/TextureManager.h"
 
 #include <d3d12.h>
 #include <wrl.h>
@@ -37,6 +39,11 @@ namespace Engine {
 		///-------------------------------------------///
 	public:
 
+		/// <summary>
+		/// デストラクタ (GPUが処理中のフレームで使っているリソースは使い終わるまで解放を待つ)
+		/// </summary>
+		~Model();
+
 		/// <summary>
 		/// 初期化
 		/// </summary>
@@ -47,7 +54,8 @@ namespace Engine {
 		/// <summary>
 		/// 描画
 		/// </summary>
-		void Draw();
+		/// <param name="instanceCount">インスタンスの数 (2以上ならインスタンス描画用のパイプラインで使う)</param>
+		void Draw(uint32_t instanceCount = 1);
 
 		/// <summary>
 		/// ImGui表示
@@ -64,6 +72,11 @@ namespace Engine {
 		/// </summary>
 		void InitializeVertexData();
 
+		/// <summary>
+		/// インデックスデータ初期化
+		/// </summary>
+		void InitializeIndexData();
+
 		/// <summary>
 		/// マテリアルデータ初期化
 		/// </summary>
@@ -100,11 +113,29 @@ namespace Engine {
 
 		const Matrix4x4& GetRootMatrix() const { return modelData->rootNode.localMatrix; }
 
+		/// <summary>
+		/// メッシュの境界ボックスのゲッター
+		/// </summary>
+		/// <returns></returns>
+		const AABB& GetBounds() const { return modelData->bounds; }
+
+		/// <summary>
+		/// インスタンス描画でまとめるためのキーの取得 (メッシュ、テクスチャ、マテリアルの値が同じなら別のModelでも同じキー)
+		/// </summary>
+		/// <returns></returns>
+		uint64_t GetBatchKey() const;
+
+		/// <summary>
+		/// レンダーキューで並べるためのマテリアルの番号の取得 (テクスチャのSRVの番号。同じテクスチャのものが続けて描画される)
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetMaterialID() const;
+
 		/// <summary>
 		/// 環境マップのファイルパスのゲッター
 		/// </summary>
 		/// <param name="filePath"></param>
-		void SetEnvironmentMapFilePath(const std::string& filePath) { environmentMapFilePath = filePath; }
+		void SetEnvironmentMapFilePath(const std::string& filePath);
 
 		const Vector4& GetPosition() const { return vertexData->position; }
 
@@ -122,6 +153,15 @@ namespace Engine {
 		// objファイルのデータ
 		ModelData* modelData = nullptr;
 
+		// モデルデータのハンドル (持っている間はキャッシュから追い出されない)
+		ModelHandle modelHandle;
+
+		// テクスチャのハンドル
+		TextureHandle textureHandle;
+
+		// 環境マップのハンドル
+		TextureHandle environmentMapHandle;
+
 		// 頂点リソース
 		Microsoft::WRL::ComPtr<ID3D12Resource> vertexResource;
 
@@ -131,6 +171,12 @@ namespace Engine {
 		// 頂点データ
 		VertexData* vertexData = nullptr;
 
+		// インデックスリソース
+		Microsoft::WRL::ComPtr<ID3D12Resource> indexResource;
+
+		// インデックスバッファビュー
+		D3D12_INDEX_BUFFER_VIEW indexBufferView{};
+
 		// マテリアルリソース
 		Microsoft::WRL::ComPtr<ID3D12Resource> materialResource;
 
@@ -1,15 +1,17 @@
 #include "ModelManager.h"
+#include "MeshCooker.h"
+#include "MeshFile.h"
 #include "Texture/TextureManager.h"
 #include "Logger.h"
+#include "Profiler.h"
 
-#include <fstream>
-#include <iostream>
-#include <sstream>
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <filesystem>
+#include <format>
 
 using namespace Engine;
-using namespace Logger;
 
 ModelManager* ModelManager::instance = nullptr;
 
@@ -21,7 +23,11 @@ ModelManager* ModelManager::GetInstance() {
 	return instance;
 }
 
-void ModelManager::Initialize() {}
+void ModelManager::Initialize() {
+
+	// メモリ予算を設定
+	modelCache_->SetMemoryBudget(kDefaultMemoryBudget);
+}
 
 void ModelManager::Finalize() {
 
@@ -31,139 +37,131 @@ void ModelManager::Finalize() {
 
 void ModelManager::LoadModelData(const std::string& directoryName, const std::string& fileName) {
 
-	// マップコンテナに登録するためのキーを作成
-	std::string key = directoryName + "/" + fileName; // キー
-
 	// 読み込み済みなら早期return
-	if (modelDatas.contains(key)) return;
+	if (modelCache_->Find(MakeModelID(directoryName, fileName))) return;
+
+	// デコードする
+	std::unique_ptr<ModelData> modelData = DecodeModelData(directoryName, fileName);
+	assert(modelData); // 読めなかったら止める
+
+	// 登録
+	RegisterModelData(directoryName, fileName, std::move(modelData));
+}
+
+std::unique_ptr<ModelData> ModelManager::DecodeModelData(const std::string& directoryName, const std::string& fileName) const {
+
+	PROFILE_SCOPE("ModelManager::DecodeModelData");
+
+	// 計測開始
+	auto start = std::chrono::steady_clock::now();
 
 	// モデルのファイルまでのフルパスを作成
 	std::string fullPath = baseDirectoryPath + "/" + directoryName + "/" + fileName; // フルパス
 
-	// ファイルが存在するか確認
-	std::ifstream file(fullPath);
-	assert(file.is_open()); // ファイルが開けなかったら止める
+	// クック済みファイルのパスを作成
+	std::string cookedPath = MeshCooker::MakeCookedPath(fullPath);
 
-	// assimpを使ってファイルを読み込む
-	Assimp::Importer importer;
-	const aiScene* scene = importer.ReadFile(fullPath.c_str(), aiProcess_FlipWindingOrder | aiProcess_FlipUVs);
-	assert(scene->HasMeshes()); // meshがないのは対応しない
+	// クック済みファイルが無いか古ければクックする (クックできなければ失敗を返す)
+	if (MeshCooker::IsStale(fullPath, cookedPath) && !MeshCooker::Cook(fullPath, cookedPath)) {
+		LOG_WARNING("ModelManager::DecodeModelData: Failed to cook {}\n", fullPath);
+		return nullptr;
+	}
 
-	// モデルデータを作成
-	std::unique_ptr<ModelData> modelData = std::make_unique<ModelData>();
+	// クック済みファイルから読み込む
+	std::unique_ptr<ModelData> modelData = LoadCookedModelData(cookedPath, directoryName);
 
-	// meshを解析する
-	for (uint32_t meshIndex = 0; meshIndex < scene->mNumMeshes; ++meshIndex) {
+	// フォーマットが古いなどで読めなかったらクックし直して読み込む
+	if (!modelData && MeshCooker::Cook(fullPath, cookedPath)) {
+		modelData = LoadCookedModelData(cookedPath, directoryName);
+	}
 
-		aiMesh* mesh = scene->mMeshes[meshIndex];
-		assert(mesh->HasNormals()); // 法線がないmeshは対応しない
-		assert(mesh->HasTextureCoords(0)); // Texcoordがないmeshは対応しない
+	// それでも読めなかったら失敗を返す
+	if (!modelData) {
+		LOG_WARNING("ModelManager::DecodeModelData: Failed to load {}\n", fullPath);
+		return nullptr;
+	}
 
-		// faceを解析する
-		for (uint32_t faceIndex = 0; faceIndex < mesh->mNumFaces; ++faceIndex) {
+	// 境界ボックスを求める (クック済みファイルには入っていないので読み込むたびに求める)
+	modelData->bounds = CalculateBounds(modelData->vertices);
 
-			aiFace& face = mesh->mFaces[faceIndex];
-			assert(face.mNumIndices == 3); // 三角形以外は対応しない
+	// 計測終了
+	double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	LOG_DEBUG("ModelManager::DecodeModelData: {}/{} ({:.3f} ms)\n", directoryName, fileName, milliseconds);
 
-			//vertexを解析する
-			for (uint32_t element = 0; element < face.mNumIndices; ++element) {
+	return modelData;
+}
 
-				uint32_t vertexIndex = face.mIndices[element];
-				aiVector3D& position = mesh->mVertices[vertexIndex];
-				aiVector3D& normal = mesh->mNormals[vertexIndex];
-				aiVector3D& texcoord = mesh->mTextureCoords[0][vertexIndex];
+void ModelManager::RegisterModelData(const std::string& directoryName, const std::string& fileName, std::unique_ptr<ModelData> modelData) {
 
-				VertexData vertex;
-				vertex.position = { position.x, position.y, position.z, 1.0f };
-				vertex.normal = { normal.x, normal.y, normal.z };
-				vertex.texcoord = { texcoord.x, texcoord.y };
+	PROFILE_SCOPE("ModelManager::RegisterModelData");
 
-				// 左手座標系に対応させる
-				vertex.position.x *= -1.0f;
-				vertex.normal.x *= -1.0f;
+	// キャッシュに登録するためのIDを発行
+	AssetID id = AssetRegistry::Intern(baseDirectoryPath + "/" + directoryName + "/" + fileName);
 
-				modelData->vertices.push_back(vertex);
-			}
-		}
-	}
+	// 別の経路で読み込み済みなら破棄
+	if (modelCache_->Contains(id)) return;
 
-	// materialを解析する
-	for (uint32_t materialIndex = 0; materialIndex < scene->mNumMaterials; ++materialIndex) {
-
-		aiMaterial* material = scene->mMaterials[materialIndex];
+	// テクスチャ読み込み (読み込み済みなら何もしない)
+	if (!modelData->material.textureFilePath.empty()) {
+		TextureManager::GetInstance()->LoadTexture(modelData->material.textureFilePath);
+	}
 
-		if (material->GetTextureCount(aiTextureType_DIFFUSE) != 0) {
+	// 使用メモリ量を計算
+	uint64_t bytes = sizeof(VertexData) * modelData->vertices.size() + sizeof(uint32_t) * modelData->indices.size();
 
-			// テクスチャファイルパスを取得
-			aiString textureFilePath;
-			material->GetTexture(aiTextureType_DIFFUSE, 0, &textureFilePath);
+	// モデルデータをキャッシュに格納する
+	modelCache_->Insert(id, std::move(*modelData), bytes);
+}
 
-			// 文字列に変換
-			std::string textureFileName = textureFilePath.C_Str();
+bool ModelManager::IsLoaded(const std::string& directoryName, const std::string& fileName) const {
 
-			// ファイル名だけを抽出
-			std::string filename = std::filesystem::path(textureFileName).filename().string();
+	return modelCache_->Contains(MakeModelID(directoryName, fileName));
+}
 
-			// テクスチャファイルを探索
-			std::string foundTextureFilePath = FindTextureFilePath(directoryName, filename);
+ModelHandle ModelManager::AcquireModelData(const std::string& directoryName, const std::string& fileName) {
 
-			// テクスチャ読み込み
-			TextureManager::GetInstance()->LoadTexture(foundTextureFilePath);
+	// 読み込まれていなければ読み込む
+	LoadModelData(directoryName, fileName);
 
-			// 見つかったテクスチャファイルパスをモデルデータに格納
-			modelData->material.textureFilePath = foundTextureFilePath;
-		}
-	}
+	// 参照を増やしたハンドルを返す
+	return ModelHandle(modelCache_, MakeModelID(directoryName, fileName));
+}
 
-	modelData->rootNode = ReadNode(scene->mRootNode);
+void ModelManager::Trim() {
 
-	// モデルデータをmapコンテナに格納する
-	modelDatas.insert(std::make_pair(key, std::move(modelData)));
+	// CPU側のデータだけなのでそのまま破棄する
+	modelCache_->Trim([](ModelData&) {});
 }
 
 ModelData* ModelManager::FindModelData(const std::string& directoryName, const std::string& fileName) {
 
-	// マップコンテナから検索するためのキーを作成
-	std::string key = directoryName + "/" + fileName; // キー
-	
 	// 読み込み済みモデルを検索
-	if (modelDatas.contains(key)) {
+	if (ModelData* modelData = modelCache_->Find(MakeModelID(directoryName, fileName))) {
 
 		// 一致したらモデルデータを返す
-		return modelDatas.at(key).get();
+		return modelData;
 	}
 
-	// キーと一致するモデルデータが見つからなかったらログ出してnullptrを返す
-	Log("ModelManager::FindModelData: Model data not found for " + key + "\n");
+	// IDと一致するモデルデータが見つからなかったらログ出してnullptrを返す
+	LOG_WARNING("ModelManager::FindModelData: Model data not found for {}/{}\n", directoryName, fileName);
 	return nullptr;
 }
 
-Node ModelManager::ReadNode(aiNode* node) {
-
-	Node result;
+std::unique_ptr<ModelData> ModelManager::LoadCookedModelData(const std::string& cookedPath, const std::string& directoryName) const {
 
-	aiMatrix4x4 aiLocalMatrix = node->mTransformation; // nodeのlocalMatrixを取得
-	aiLocalMatrix.Transpose(); // 列ベクトル形式を行ベクトル形式に転置
+	// クック済みファイルを読み込む (解析はせずにマップしたストリームをコピーするだけ)
+	std::unique_ptr<ModelData> modelData = MeshFile::Read(cookedPath);
+	if (!modelData) return nullptr;
 
-	for (uint32_t i = 0; i < 4; ++i) {
-		for (uint32_t j = 0; j < 4; ++j) {
-			result.localMatrix.m[i][j] = aiLocalMatrix[j][i];
-		}
+	// テクスチャファイルを探索 (読み込みは登録時にメインスレッドで行う)
+	if (!modelData->material.textureFilePath.empty()) {
+		modelData->material.textureFilePath = FindTextureFilePath(directoryName, modelData->material.textureFilePath);
 	}
 
-	result.name = node->mName.C_Str(); // Node名を格納
-	result.children.resize(node->mNumChildren); // 子ノードの数だけ確保
-
-	for (uint32_t childIndex = 0; childIndex < node->mNumChildren; ++childIndex) {
-
-		// 再帰的に読んで階層構造を作っていく
-		result.children[childIndex] = ReadNode(node->mChildren[childIndex]);
-	}
-
-	return result;
+	return modelData;
 }
 
-std::string ModelManager::FindTextureFilePath(const std::string& directoryName, const std::string& filename) {
+std::string ModelManager::FindTextureFilePath(const std::string& directoryName, const std::string& filename) const {
 
 	// TextureManagerのベースディレクトリパスを取得
 	std::string textureBaseDirectoryPath = TextureManager::GetInstance()->GetBaseDirectoryPath();
@@ -188,3 +186,27 @@ std::string ModelManager::FindTextureFilePath(const std::string& directoryName,
 
 	return textureBaseDirectoryPath + "/" + "White.png"; // 見つからなかったら
 }
+
+AssetID ModelManager::MakeModelID(const std::string& directoryName, const std::string& fileName) const {
+
+	// フルパスから作る
+	return AssetRegistry::MakeID(baseDirectoryPath + "/" + directoryName + "/" + fileName);
+}
+
+AABB ModelManager::CalculateBounds(const std::vector<VertexData>& vertices) {
+
+	// 頂点がなければ原点の点
+	if (vertices.empty()) {
+		return AABB{ { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+	}
+
+	// 最初の頂点から広げていく
+	AABB bounds{ { vertices[0].position.x, vertices[0].position.y, vertices[0].position.z }, { vertices[0].position.x, vertices[0].position.y, vertices[0].position.z } };
+
+	for (const VertexData& vertex : vertices) {
+		bounds.min = { (std::min)(bounds.min.x, vertex.position.x), (std::min)(bounds.min.y, vertex.position.y), (std::min)(bounds.min.z, vertex.position.z) };
+		bounds.max = { (std::max)(bounds.max.x, vertex.position.x), (std::max)(bounds.max.y, vertex.position.y), (std::max)(bounds.max.z, vertex.position.z) };
+	}
+
+	return bounds;
+}
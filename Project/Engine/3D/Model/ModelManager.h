@@ -1,13 +1,9 @@
 #pragma once
 
 #include "Data/ModelData.h"
-
-#include <assimp/Importer.hpp>
-#include <assimp/scene.h>
-#include <assimp/postprocess.h>
+#include "AssetHandle.h"
 
 #include <string>
-#include <map>
 #include <memory>
 
 namespace Engine {
@@ -63,6 +59,43 @@ namespace Engine {
 		/// <param name="fileName">ファイル名</param>
 		void LoadModelData(const std::string& directoryName, const std::string& fileName);
 
+		/// <summary>
+		/// モデルデータをデコードする (GPUにもマップコンテナにも触らないのでワーカースレッドから呼べる)
+		/// </summary>
+		/// <param name="directoryName">ディレクトリ名</param>
+		/// <param name="fileName">ファイル名</param>
+		/// <returns>モデルデータ (読めなかったらnullptr)</returns>
+		std::unique_ptr<ModelData> DecodeModelData(const std::string& directoryName, const std::string& fileName) const;
+
+		/// <summary>
+		/// デコード済みのモデルデータを登録する (メインスレッド専用)
+		/// </summary>
+		/// <param name="directoryName">ディレクトリ名</param>
+		/// <param name="fileName">ファイル名</param>
+		/// <param name="modelData">モデルデータ</param>
+		void RegisterModelData(const std::string& directoryName, const std::string& fileName, std::unique_ptr<ModelData> modelData);
+
+		/// <summary>
+		/// 読み込み済みか
+		/// </summary>
+		/// <param name="directoryName">ディレクトリ名</param>
+		/// <param name="fileName">ファイル名</param>
+		/// <returns></returns>
+		bool IsLoaded(const std::string& directoryName, const std::string& fileName) const;
+
+		/// <summary>
+		/// モデルデータを参照する (ハンドルを持っている間はキャッシュから追い出されない)
+		/// </summary>
+		/// <param name="directoryName">ディレクトリ名</param>
+		/// <param name="fileName">ファイル名</param>
+		/// <returns>ハンドル</returns>
+		AssetHandle<ModelData> AcquireModelData(const std::string& directoryName, const std::string& fileName);
+
+		/// <summary>
+		/// 使われていないモデルデータを予算に収まるまで追い出す
+		/// </summary>
+		void Trim();
+
 		/// <summary>
 		/// モデルデータを検索
 		/// </summary>
@@ -71,30 +104,79 @@ namespace Engine {
 		/// <returns>モデルデータ</returns>
 		ModelData* FindModelData(const std::string& directoryName, const std::string& fileName);
 
-		static Node ReadNode(aiNode* node);
-
 		///-------------------------------------------/// 
 		/// クラス内関数
 		///-------------------------------------------///
 	private:
 
+		/// <summary>
+		/// クック済みメッシュファイルからモデルデータを読み込む
+		/// </summary>
+		/// <param name="cookedPath">クック済みファイルのパス</param>
+		/// <param name="directoryName">ディレクトリ名(テクスチャ探索用)</param>
+		/// <returns>モデルデータ (読めなかったらnullptr)</returns>
+		std::unique_ptr<ModelData> LoadCookedModelData(const std::string& cookedPath, const std::string& directoryName) const;
+
 		/// <summary>
 		/// 画像ファイルの探索
 		/// </summary>
 		/// <param name="directoryName">ディレクトリ名</param>
 		/// <param name="filename">ファイル名</param>
 		/// <returns></returns>
-		std::string FindTextureFilePath(const std::string& directoryName, const std::string& filename);
+		std::string FindTextureFilePath(const std::string& directoryName, const std::string& filename) const;
+
+		/// <summary>
+		/// モデルデータのアセットIDを作る
+		/// </summary>
+		/// <param name="directoryName">ディレクトリ名</param>
+		/// <param name="fileName">ファイル名</param>
+		/// <returns></returns>
+		AssetID MakeModelID(const std::string& directoryName, const std::string& fileName) const;
+
+		/// <summary>
+		/// 頂点を囲む境界ボックスを求める
+		/// </summary>
+		/// <param name="vertices">頂点</param>
+		/// <returns>境界ボックス (頂点がなければ原点の点)</returns>
+		static AABB CalculateBounds(const std::vector<VertexData>& vertices);
+
+		///-------------------------------------------/// 
+		/// ゲッター&セッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// キャッシュの統計のゲッター
+		/// </summary>
+		/// <returns></returns>
+		const AssetCache<ModelData>::Stats& GetCacheStats() const { return modelCache_->GetStats(); }
+
+		/// <summary>
+		/// メモリ予算のセッター
+		/// </summary>
+		/// <param name="memoryBudget">バイト数</param>
+		void SetMemoryBudget(uint64_t memoryBudget) { modelCache_->SetMemoryBudget(memoryBudget); }
 
 		///-------------------------------------------/// 
 		/// メンバ変数
 		///-------------------------------------------///
 	private:
 
-		// モデルデータのマップコンテナ キー : ディレクトリ + ファイル名
-		std::map<std::string, std::unique_ptr<ModelData>> modelDatas;
+		// モデルデータのキャッシュ キー : フルパスのアセットID
+		std::shared_ptr<AssetCache<ModelData>> modelCache_ = std::make_shared<AssetCache<ModelData>>();
 
 		// ベースのディレクトリパス
 		const std::string baseDirectoryPath = "Resources/Models";
+
+		///-------------------------------------------/// 
+		/// 定数
+		///-------------------------------------------///
+	private:
+
+		// デフォルトのメモリ予算 (64MB)
+		static const uint64_t kDefaultMemoryBudget = 64ull * 1024 * 1024;
 	};
+
+	// モデルデータのハンドル
+	using ModelHandle = AssetHandle<ModelData>;
 }
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "InstanceBatcher.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace Engine;
+
+void InstanceBatcher::Clear() {
+
+	requests_.clear();
+	instances_.clear();
+	batches_.clear();
+}
+
+void InstanceBatcher::Add(uint64_t key, uint32_t instance) {
+
+	// 追加した順を覚えておく
+	requests_.push_back({ key, instance, static_cast<uint32_t>(requests_.size()) });
+}
+
+void InstanceBatcher::Build(uint32_t maxInstancesPerBatch) {
+
+	assert(maxInstancesPerBatch > 0);
+
+	instances_.clear();
+	batches_.clear();
+
+	// キー順に並べる (同じキーは追加した順)
+	std::sort(requests_.begin(), requests_.end(), [](const Request& a, const Request& b) {
+		return a.key != b.key ? a.key < b.key : a.order < b.order;
+	});
+
+	instances_.reserve(requests_.size());
+
+	for (const Request& request : requests_) {
+
+		// キーが変わったか、上限に達したら新しいバッチにする
+		if (batches_.empty() || batches_.back().key != request.key || batches_.back().count == maxInstancesPerBatch) {
+			batches_.push_back({ request.key, static_cast<uint32_t>(instances_.size()), 0 });
+		}
+
+		// バッチに入れる
+		instances_.push_back(request.instance);
+		batches_.back().count++;
+	}
+}
+
+uint64_t InstanceBatcher::HashCombine(uint64_t seed, const void* data, size_t size) {
+
+	// FNV-1a 64bit
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	uint64_t hash = seed;
+
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
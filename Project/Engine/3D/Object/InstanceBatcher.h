@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+
+	/// === インスタンスバッチャー === ///
+	/// 描画要求をキー(メッシュ、マテリアル、共通の定数)ごとにまとめ、1回のインスタンス描画で描ける単位に分ける
+	/// 番号とキーだけを扱うのでグラフィックスAPIには依存しない
+	class InstanceBatcher {
+
+		///-------------------------------------------///
+		/// 構造体
+		///-------------------------------------------///
+	public:
+
+		// 1回のインスタンス描画で描く範囲
+		struct Batch {
+			uint64_t key = 0;		// まとめたキー
+			uint32_t first = 0;		// GetInstancesの先頭位置
+			uint32_t count = 0;		// インスタンスの数
+		};
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 描画要求を全て破棄する (確保済みの領域は使い回す)
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// 描画要求の追加
+		/// </summary>
+		/// <param name="key">まとめるキー (同じキーは1回の描画にまとめられる)</param>
+		/// <param name="instance">呼び出し側の番号</param>
+		void Add(uint64_t key, uint32_t instance);
+
+		/// <summary>
+		/// キー順に並べてバッチを作る (同じキーの中では追加した順を保つ)
+		/// </summary>
+		/// <param name="maxInstancesPerBatch">1回の描画に入れるインスタンスの上限 (超えたら分ける)</param>
+		void Build(uint32_t maxInstancesPerBatch);
+
+		/// <summary>
+		/// データを連結してハッシュを求める (FNV-1a 64bit)
+		/// </summary>
+		/// <param name="seed">元のハッシュ (最初は kHashSeed)</param>
+		/// <param name="data">データ</param>
+		/// <param name="size">サイズ</param>
+		/// <returns>ハッシュ</returns>
+		static uint64_t HashCombine(uint64_t seed, const void* data, size_t size);
+
+		/// <summary>
+		/// 値を連結してハッシュを求める
+		/// </summary>
+		/// <typeparam name="T">値の型 (詰め物の中身も含めて比べるので0で初期化しておくこと)</typeparam>
+		/// <param name="seed">元のハッシュ</param>
+		/// <param name="value">値</param>
+		/// <returns>ハッシュ</returns>
+		template <typename T>
+		static uint64_t HashCombine(uint64_t seed, const T& value) {
+			return HashCombine(seed, &value, sizeof(T));
+		}
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// バッチの取得 (Buildの後に有効)
+		/// </summary>
+		/// <returns></returns>
+		const std::vector<Batch>& GetBatches() const { return batches_; }
+
+		/// <summary>
+		/// キー順に並べた呼び出し側の番号の取得 (Buildの後に有効)
+		/// </summary>
+		/// <returns></returns>
+		const std::vector<uint32_t>& GetInstances() const { return instances_; }
+
+		/// <summary>
+		/// 追加された描画要求の数の取得
+		/// </summary>
+		/// <returns></returns>
+		size_t GetRequestCount() const { return requests_.size(); }
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// 描画要求
+		struct Request {
+			uint64_t key;		// まとめるキー
+			uint32_t instance;	// 呼び出し側の番号
+			uint32_t order;		// 追加した順
+		};
+
+		// 追加された描画要求
+		std::vector<Request> requests_;
+
+		// キー順に並べた呼び出し側の番号
+		std::vector<uint32_t> instances_;
+
+		// バッチ
+		std::vector<Batch> batches_;
+
+		///-------------------------------------------///
+		/// 定数
+		///-------------------------------------------///
+	public:
+
+		// ハッシュの初期値
+		static const uint64_t kHashSeed = 14695981039346656037ull;
+	};
+}
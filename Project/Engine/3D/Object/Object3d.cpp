@@ -1,5 +1,6 @@
 #include "Object3d.h"
 #include "Object3dRenderer.h"
+#include "Light/LightManager.h"
 #include "MathVector.h"
 #include "MathMatrix.h"
 #include "WinApp.h"
@@ -7,10 +8,11 @@
 #include "Texture/TextureManager.h"
 #include "Model/ModelManager.h"
 #include "Camera.h"
+#include "GameClock.h"
+#include "FrameCounters.h"
 
 #include <cassert>
 #include <sstream>
-#include <numbers>
 #include <imgui.h>
 
 using namespace Engine;
@@ -32,16 +34,6 @@ void Object3d::Initialize() {
 	worldTransform.Initialize();
 
 	InitializeTransformationMatrixData();
-
-	InitializeDirectionalLightData();
-
-	InitializePointLightData();
-
-	InitializeSpotLightData();
-
-	InitializeEnvironmentData();
-
-	InitializeCameraData();
 }
 
 void Object3d::Update() {
@@ -49,62 +41,44 @@ void Object3d::Update() {
 	// ワールド変換の行列の更新
 	worldTransform.Update();
 
-	/// === TransformからWorldMatrixを作る === ///
-	Matrix4x4 worldMatrix = worldTransform.GetWorldMatrix();
-
-	// WVP
-	Matrix4x4 worldViewProjectionMatrix;
-
-	// カメラがあればviewProjectionをもらってWVPの計算を行う
-	if (camera) {
+	// 座標変換行列は描画するときに補間した状態から作る (ここではカリングの境界ボックスだけ)
 
-		const Matrix4x4& viewProjectionMatrix = camera->GetViewProjectionMatrix();
-		worldViewProjectionMatrix = worldMatrix * viewProjectionMatrix;
+	/// === 視錐台カリングに登録 === ///
 
-		// カメラのワールド座標を代入
-		*cameraData = camera->GetWorldPosition();
-
-		// カメラがなければworldMatrixを代入
+	// デフォルトカメラで描画するものだけをまとめて判定する
+	if (camera && camera == object3dRenderer_->GetDefaultCamera()) {
+		FrustumCuller& culler = object3dRenderer_->GetCuller();
+		cullIndex = culler.Add(FrustumCuller::TransformBounds(model->GetBounds(), model->GetRootMatrix() * worldTransform.GetWorldMatrix()));
+		cullGeneration = culler.GetGeneration();
 	}
 	else {
-
-		worldViewProjectionMatrix = worldMatrix;
-	}
-
-	transformationMatrixData->WVP = model->GetRootMatrix() * worldViewProjectionMatrix;
-	transformationMatrixData->world = model->GetRootMatrix() * worldMatrix;
-	transformationMatrixData->worldInverseTranspose = Inverse(model->GetRootMatrix() * worldMatrix);
-
-	directionalLightData->direction = Normalize(directionalLightData->direction);
-	spotLightData->direction = Normalize(spotLightData->direction);
-
-	// cosFalloffStartがcosAngleより小さい場合、cosAngleを更新
-	if (spotLightData->cosFalloffStart < spotLightData->cosAngle) {
-		spotLightData->cosFalloffStart = spotLightData->cosAngle + 0.01f;
+		cullGeneration = 0;
 	}
 }
 
 void Object3d::Draw() {
 
-	if (isDraw) {
+	if (isDraw && IsVisible()) {
 
-		/// === 座標変換行列CBufferの場所を設定 === ///
-		dxUtility->GetCommandList()->SetGraphicsRootConstantBufferView(0, transformationMatrixResource->GetGPUVirtualAddress());
+		// 描画する状態の座標変換行列を作る
+		UpdateTransformationMatrix();
 
-		/// === 平行光源CBufferの場所を設定 === ///
-		dxUtility->GetCommandList()->SetGraphicsRootConstantBufferView(2, directionalLightResource->GetGPUVirtualAddress());
+		// ライトを書き込めていなければ描画しない (アップロードリングが足りないフレーム)
+		if (!LightManager::GetInstance()->IsUploaded()) {
+			return;
+		}
 
-		/// === 点光源CBufferの場所を設定 === ///
-		dxUtility->GetCommandList()->SetGraphicsRootConstantBufferView(3, pointLightResource->GetGPUVirtualAddress());
+		// 今のフレームの値をアップロードアロケータに書き込む (GPUが処理中の前のフレームの値は上書きしない)
+		UploadAllocator::Allocation allocation = dxUtility->GetUploadAllocator().Push(transformationMatrixData);
 
-		/// === スポットライトCBufferの場所を設定 === ///
-		dxUtility->GetCommandList()->SetGraphicsRootConstantBufferView(4, spotLightResource->GetGPUVirtualAddress());
-		
-		/// === 環境CBufferの場所を設定 === ///
-		dxUtility->GetCommandList()->SetGraphicsRootConstantBufferView(5, environmentResource->GetGPUVirtualAddress());
+		// 書き込めなければ描画しない
+		if (!allocation.IsValid()) {
+			return;
+		}
 
-		/// === カメラCBufferの場所を設定 === ///
-		dxUtility->GetCommandList()->SetGraphicsRootConstantBufferView(6, cameraResource->GetGPUVirtualAddress());
+		/// === 座標変換行列CBufferの場所を設定 === ///
+		dxUtility->GetCommandList()->SetGraphicsRootConstantBufferView(0, allocation.gpuAddress);
+		FrameCounters::GetInstance()->Add(FrameCounters::kRootParameterBinds);
 
 		// 3Dモデルが割り当てられていれば描画する
 		if (model) {
@@ -113,6 +87,46 @@ void Object3d::Draw() {
 	}
 }
 
+void Object3d::DrawInstanced() {
+
+	// 描画しない、モデルがない、または視錐台の外なら登録しない
+	if (!isDraw || !model || !IsVisible()) {
+		return;
+	}
+
+	// 描画する状態の座標変換行列を作る
+	UpdateTransformationMatrix();
+
+	// モデルとマテリアルが同じものをまとめる (光源は全オブジェクト共通、ライトマスクはインスタンスごとのデータに入る)
+	object3dRenderer_->AddInstance(this, model->GetBatchKey());
+}
+
+void Object3d::Submit(RenderQueue& renderQueue, RenderQueue::Pass pass, uint32_t pipeline) {
+
+	// 描画しない、モデルがない、または視錐台の外なら積まない
+	if (!isDraw || !model || !IsVisible()) {
+		return;
+	}
+
+	// 同じテクスチャのものが続き、その中では深度の順に並ぶ
+	renderQueue.Submit(pass, pipeline, model->GetMaterialID(), GetViewDepth(), [this]() { Draw(); });
+}
+
+void Object3d::DrawBatch(uint64_t instanceDataAddress, uint32_t instanceCount) {
+
+	// ライトを書き込めていなければ描画しない (アップロードリングが足りないフレーム)
+	if (!LightManager::GetInstance()->IsUploaded()) {
+		return;
+	}
+
+	/// === 座標変換行列StructuredBufferの場所を設定 === ///
+	dxUtility->GetCommandList()->SetGraphicsRootShaderResourceView(0, instanceDataAddress);
+	FrameCounters::GetInstance()->Add(FrameCounters::kRootParameterBinds);
+
+	// まとめて描画
+	model->Draw(instanceCount);
+}
+
 void Object3d::ShowImGui() {
 
 #ifdef USE_IMGUI
@@ -123,38 +137,8 @@ void Object3d::ShowImGui() {
 
 		worldTransform.ShowImGui();
 
-		if (ImGui::TreeNode("DirectionalLight")) {
-			ImGui::ColorEdit4("Color", &directionalLightData->color.x); // 色
-			ImGui::DragFloat3("Direction", &directionalLightData->direction.x, 0.01f); // 向き
-			ImGui::DragFloat("Intensity", &directionalLightData->intensity, 0.01f); // 輝度
-			ImGui::TreePop();
-		}
-
-		if (ImGui::TreeNode("PointLight")) {
-			ImGui::ColorEdit4("Color", &pointLightData->color.x); // 色
-			ImGui::DragFloat3("Position", &pointLightData->position.x, 0.01f); // 位置
-			ImGui::DragFloat("Intensity", &pointLightData->intensity, 0.01f); // 輝度
-			ImGui::DragFloat("Distance", &pointLightData->distance, 0.01f); // 最大距離
-			ImGui::DragFloat("Decay", &pointLightData->decay, 0.01f); // 減衰率
-			ImGui::TreePop();
-		}
-
-		if (ImGui::TreeNode("SpotLight")) {
-			ImGui::ColorEdit4("Color", &spotLightData->color.x); // 色
-			ImGui::DragFloat3("Position", &spotLightData->position.x, 0.01f); // 位置
-			ImGui::DragFloat3("Direction", &spotLightData->direction.x, 0.01f); // 向き
-			ImGui::DragFloat("Intensity", &spotLightData->intensity, 0.01f); // 輝度
-			ImGui::DragFloat("Distance", &spotLightData->distance, 0.01f); // 最大距離
-			ImGui::DragFloat("Decay", &spotLightData->decay, 0.01f); // 減衰率
-			ImGui::DragFloat("CosAngle", &spotLightData->cosAngle, 0.01f); // 余弦
-			ImGui::DragFloat("CosFalloffStart", &spotLightData->cosFalloffStart, 0.01f); // Falloff開始角度
-			ImGui::TreePop();
-		}
-
-		if (ImGui::TreeNode("Environment")) {
-			ImGui::SliderFloat("Intensity", &environmentData->intensity, 0.0f, 1.0f); // 環境光の輝度
-			ImGui::TreePop();
-		}
+		// 受けるローカルライトのマスク
+		ImGui::InputScalar("LightMask", ImGuiDataType_U32, &transformationMatrixData.lightMask, nullptr, nullptr, "%08X", ImGuiInputTextFlags_CharsHexadecimal);
 
 		ImGui::TreePop();
 	}
@@ -164,92 +148,65 @@ void Object3d::ShowImGui() {
 
 void Object3d::InitializeTransformationMatrixData() {
 
-	/// === TransformationMatrixResourceを作る === ///
-	transformationMatrixResource = dxUtility->CreateBufferResource(sizeof(TransformationMatrix));
-
-	/// === TransformationMatrixResourceにデータを書き込むためのアドレスを取得してtransformationMatrixDataに割り当てる === ///
-	transformationMatrixResource->Map(0, nullptr, reinterpret_cast<void**>(&transformationMatrixData));
-
 	/// === TransformationMatrixDataの初期値を書き込む === ///
-	transformationMatrixData->WVP = MakeIdentity4x4(); // 単位行列を書き込む
-	transformationMatrixData->world = MakeIdentity4x4(); // 単位行列を書き込む
-	transformationMatrixData->worldInverseTranspose = MakeIdentity4x4(); // 単位行列を書き込む
+	transformationMatrixData.WVP = MakeIdentity4x4(); // 単位行列を書き込む
+	transformationMatrixData.world = MakeIdentity4x4(); // 単位行列を書き込む
+	transformationMatrixData.worldInverseTranspose = MakeIdentity4x4(); // 単位行列を書き込む
+	transformationMatrixData.lightMask = 0xFFFFFFFF; // 全てのライトを受ける
 }
 
-void Object3d::InitializeDirectionalLightData() {
-
-	/// === DirectionalLightResourceを作る === ///
-	directionalLightResource = dxUtility->CreateBufferResource(sizeof(DirectionalLight));
-
-	/// === DirectionalLightResourceにデータを書き込むためのアドレスを取得してDirectionalLightDataに割り当てる === ///
-	directionalLightResource->Map(0, nullptr, reinterpret_cast<void**>(&directionalLightData));
+void Object3d::UpdateTransformationMatrix() {
 
-	/// === DirectionalLightDataの初期値を書き込む === ///
-	directionalLightData->color = { 1.0f, 1.0f, 1.0f, 1.0f }; // 白を書き込む
-	directionalLightData->direction = Normalize({ 0.0f, -1.0f, 0.0f }); // 向きは下から
-	directionalLightData->intensity = 1.0f; // 輝度は最大
-}
+	// 前のステップと最後のステップの間を補間したワールド行列
+	float alpha = GameClock::GetAlpha();
+	Matrix4x4 worldMatrix = worldTransform.GetInterpolatedWorldMatrix(alpha);
 
-void Object3d::InitializePointLightData() {
+	// モデルがなければルート行列を掛けない
+	if (model) {
+		worldMatrix = model->GetRootMatrix() * worldMatrix;
+	}
 
-	/// === PointLightResourceを作る === ///
-	pointLightResource = dxUtility->CreateBufferResource(sizeof(PointLight));
+	// WVP
+	Matrix4x4 worldViewProjectionMatrix;
 
-	/// === PointLightResourceにデータを書き込むためのアドレスを取得してPointLightDataに割り当てる === ///
-	pointLightResource->Map(0, nullptr, reinterpret_cast<void**>(&pointLightData));
+	// デフォルトカメラならフレームごとに補間済みのviewProjectionを使う
+	if (camera && camera == object3dRenderer_->GetDefaultCamera()) {
 
-	/// === PointLightDataの初期値を書き込む === ///
-	pointLightData->color = { 1.0f, 1.0f, 1.0f, 1.0f }; // 白を書き込む
-	pointLightData->position = { 0.0f, 2.0f, 0.0f }; // 位置は上から
-	pointLightData->intensity = 1.0f; // 輝度は最大
-	pointLightData->distance = 5.0f; // 最大距離は広く
-	pointLightData->decay = 2.0f; // 減衰あり
-}
+		worldViewProjectionMatrix = worldMatrix * object3dRenderer_->GetRenderViewProjectionMatrix();
+	}
+	// それ以外のカメラならその場で補間する
+	else if (camera) {
 
-void Object3d::InitializeSpotLightData() {
+		worldViewProjectionMatrix = worldMatrix * camera->GetInterpolatedViewProjectionMatrix(alpha);
 
-	/// === SpotLightResourceを作る === ///
-	spotLightResource = dxUtility->CreateBufferResource(sizeof(SpotLight));
+		// カメラがなければworldMatrixを代入
+	}
+	else {
 
-	/// === SpotLightResourceにデータを書き込むためのアドレスを取得してSpotLightDataに割り当てる === ///
-	spotLightResource->Map(0, nullptr, reinterpret_cast<void**>(&spotLightData));
+		worldViewProjectionMatrix = worldMatrix;
+	}
 
-	/// === SpotLightDataの初期値を書き込む === ///
-	spotLightData->color = { 1.0f, 1.0f, 1.0f, 1.0f }; // 色は白
-	spotLightData->position = { -2.0f, 1.25f, 0.0f }; // 位置は左から
-	spotLightData->direction = Normalize({ -1.0f, 0.0f, 0.0f }); // 右向き
-	spotLightData->intensity = 4.0f; // 輝度は強め
-	spotLightData->distance = 7.0f; // 最大距離は広く
-	spotLightData->decay = 2.0f; // 減衰あり
-	spotLightData->cosAngle = std::cos(std::numbers::pi_v<float> / 3.0f); // π/3
-	spotLightData->cosFalloffStart = spotLightData->cosAngle + 0.01f; // cosAngleよりちょっと大きい
+	transformationMatrixData.WVP = worldViewProjectionMatrix;
+	transformationMatrixData.world = worldMatrix;
+	transformationMatrixData.worldInverseTranspose = Inverse(worldMatrix);
 }
 
-void Object3d::InitializeEnvironmentData() {
+float Object3d::GetViewDepth() const {
 
-	/// === EnvironmentResourceを作る === ///
-	environmentResource = dxUtility->CreateBufferResource(sizeof(Environment));
+	// 設定されたカメラがなければデフォルトカメラで測る
+	const Camera* viewCamera = camera ? camera : object3dRenderer_->GetDefaultCamera();
+	if (!viewCamera) {
+		return 0.0f;
+	}
 
-	/// === EnvironmentResourceにデータを書き込むためのアドレスを取得してEnvironmentDataに割り当てる === ///
-	environmentResource->Map(0, nullptr, reinterpret_cast<void**>(&environmentData));
+	// ワールド座標をビュー空間に変換したz成分だけを求める
+	const Matrix4x4& worldMatrix = worldTransform.GetWorldMatrix();
+	const Matrix4x4& viewMatrix = viewCamera->GetViewMatrix();
 
-	/// === EnvironmentDataの初期値を書き込む === ///
-	environmentData->intensity = 1.0f; // 環境光の輝度は最大
+	return worldMatrix.m[3][0] * viewMatrix.m[0][2] + worldMatrix.m[3][1] * viewMatrix.m[1][2] + worldMatrix.m[3][2] * viewMatrix.m[2][2] + viewMatrix.m[3][2];
 }
 
-void Object3d::InitializeCameraData() {
+bool Object3d::IsVisible() const {
 
-	/// === CameraResource === ///
-	cameraResource = dxUtility->CreateBufferResource(sizeof(Vector3));
-
-	/// === CameraResourceにデータを書き込むためのアドレスを取得してCameraDataに割り当てる === ///
-	cameraResource->Map(0, nullptr, reinterpret_cast<void**>(&cameraData));
-
-	/// === CameraDataの初期値を書き込む === ///
-
-	// カメラを持っていたら
-	if (camera) {
-		// カメラのワールド座標を代入
-		*cameraData = camera->GetWorldPosition();
-	}
+	return object3dRenderer_->GetCuller().IsVisible(cullIndex, cullGeneration);
 }
\ No newline at end of file
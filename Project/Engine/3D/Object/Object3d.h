@@ -5,6 +5,7 @@
 #include "Vector4.h"
 #include "Matrix4x4.h"
 #include "WorldTransform.h"
+#include "RenderQueue.h"
 
 #include <fstream>
 #include <vector>
@@ -30,41 +31,8 @@ namespace Engine {
 			Matrix4x4 WVP;
 			Matrix4x4 world;
 			Matrix4x4 worldInverseTranspose;
-		};
-
-		// 平行光源データ
-		struct DirectionalLight {
-			Vector4 color; // 色
-			Vector3 direction; // 向き
-			float intensity; // 輝度
-		};
-
-		// 点光源データ
-		struct PointLight {
-			Vector4 color; // 色
-			Vector3 position; // 位置
-			float intensity; // 輝度
-			float distance; // 光の届く最大距離
-			float decay; // 減衰率
-			float padding[2];
-		};
-
-		// スポットライトデータ
-		struct SpotLight {
-			Vector4 color; // 色
-			Vector3 position; // 位置
-			float padding;
-			Vector3 direction; // 向き
-			float intensity; // 輝度
-			float distance; // 光の届く最大距離
-			float decay; // 減衰率
-			float cosAngle; // 余弦
-			float cosFalloffStart; // Falloffの開始角度
-		};
-
-		// 環境データ
-		struct Environment {
-			float intensity; // 環境光の輝度
+			uint32_t lightMask; // 受けるローカルライトのマスク (LightManagerの番号0~31のビット)
+			float padding[3];
 		};
 
 		///-------------------------------------------/// 
@@ -88,44 +56,55 @@ namespace Engine {
 		void Draw();
 
 		/// <summary>
-		/// ImGui表示
+		/// インスタンス描画に登録 (同じモデルと定数のオブジェクトとまとめてObject3dRenderer::FlushInstancedまたはSubmitInstancedで描画される)
 		/// </summary>
-		void ShowImGui();
+		void DrawInstanced();
 
-		///-------------------------------------------/// 
-		/// クラス内関数
-		///-------------------------------------------///
-	private:
+		/// <summary>
+		/// レンダーキューに描画パケットを積む (モデルのマテリアルとカメラからの深度をキーにする。描画しないものや視錐台の外のものは積まない)
+		/// </summary>
+		/// <param name="renderQueue">レンダーキュー</param>
+		/// <param name="pass">描画パス</param>
+		/// <param name="pipeline">パイプラインの番号</param>
+		void Submit(RenderQueue& renderQueue, RenderQueue::Pass pass, uint32_t pipeline);
 
 		/// <summary>
-		/// 座標変換行列データ初期化
+		/// まとめて描画 Object3dRendererから呼ばれる
 		/// </summary>
-		void InitializeTransformationMatrixData();
+		/// <param name="instanceDataAddress">インスタンスごとの座標変換行列の配列のGPUアドレス</param>
+		/// <param name="instanceCount">インスタンスの数</param>
+		void DrawBatch(uint64_t instanceDataAddress, uint32_t instanceCount);
 
 		/// <summary>
-		/// 平行光源データ初期化
+		/// ImGui表示
 		/// </summary>
-		void InitializeDirectionalLightData();
+		void ShowImGui();
 
 		/// <summary>
-		/// 点光源データ初期化
+		/// 補間のリセット (使い回すときに前の位置から補間しないようにする)
 		/// </summary>
-		void InitializePointLightData();
+		void ResetInterpolation() { worldTransform.ResetInterpolation(); }
+
+		///-------------------------------------------/// 
+		/// クラス内関数
+		///-------------------------------------------///
+	private:
 
 		/// <summary>
-		/// スポットライトデータ初期化
+		/// 座標変換行列データ初期化
 		/// </summary>
-		void InitializeSpotLightData();
+		void InitializeTransformationMatrixData();
 
 		/// <summary>
-		/// 環境データ初期化
+		/// 座標変換行列データの更新 (描画の直前に、前のステップとの間を補間した状態から作る)
 		/// </summary>
-		void InitializeEnvironmentData();
+		void UpdateTransformationMatrix();
 
 		/// <summary>
-		/// カメラデータ初期化
+		/// 視錐台カリングで除外されていないか
 		/// </summary>
-		void InitializeCameraData();
+		/// <returns></returns>
+		bool IsVisible() const;
 
 		///-------------------------------------------/// 
 		/// セッター
@@ -150,6 +129,12 @@ namespace Engine {
 		/// <param name="translate">位置</param>
 		void SetTranslate(const Vector3& translate) { this->worldTransform.SetTranslate(translate); }
 
+		/// <summary>
+		/// ワールド原点の移動に追従するかのセッター
+		/// </summary>
+		/// <param name="isOriginRelative">追従するか</param>
+		void SetOriginRelative(bool isOriginRelative) { this->worldTransform.SetOriginRelative(isOriginRelative); }
+
 		/// <summary>
 		/// モデルのセッター
 		/// </summary>
@@ -163,22 +148,10 @@ namespace Engine {
 		void SetCamera(Camera* camera) { this->camera = camera; }
 
 		/// <summary>
-		/// 色のセッター
-		/// </summary>
-		/// <param name="color"></param>
-		void SetColor(const Vector4& color) { this->directionalLightData->color = color; }
-
-		/// <summary>
-		///	向きのセッター
+		/// ライトマスクのセッター
 		/// </summary>
-		/// <param name="direction"></param>
-		void SetDirection(const Vector3& direction) { this->directionalLightData->direction = direction; }
-
-		/// <summary>
-		/// 輝度のセッター
-		/// </summary>
-		/// <param name="intensity"></param>
-		void SetIntensity(float intensity) { this->directionalLightData->intensity = intensity; }
+		/// <param name="lightMask">受けるローカルライトのマスク (LightManagerの番号0~31のビット、32番以降は常に受ける)</param>
+		void SetLightMask(uint32_t lightMask) { this->transformationMatrixData.lightMask = lightMask; }
 
 		///-------------------------------------------/// 
 		/// ゲッター
@@ -204,59 +177,42 @@ namespace Engine {
 		const Vector3& GetTranslate() const { return worldTransform.GetTranslate(); }
 
 		/// <summary>
-		/// 色のゲッター
+		/// ライトマスクのゲッター
 		/// </summary>
 		/// <returns></returns>
-		const Vector4& GetColor() const { return directionalLightData->color; }
+		uint32_t GetLightMask() const { return transformationMatrixData.lightMask; }
 
 		/// <summary>
-		/// 向きのゲッター
+		/// モデルのゲッター
 		/// </summary>
 		/// <returns></returns>
-		const Vector3& GetDirection() const { return directionalLightData->direction; }
+		Model* GetModel() const { return model; }
 
 		/// <summary>
-		/// 輝度のゲッター
+		/// ワールド行列のゲッター
 		/// </summary>
 		/// <returns></returns>
-		float GetIntensity() const { return directionalLightData->intensity; }
+		const Matrix4x4& GetWorldMatrix() const { return worldTransform.GetWorldMatrix(); }
 
 		/// <summary>
-		/// ワールド行列のゲッター
+		/// 座標変換行列データのゲッター
 		/// </summary>
 		/// <returns></returns>
-		const Matrix4x4& GetWorldMatrix() const { return worldTransform.GetWorldMatrix(); }
+		const TransformationMatrix& GetTransformationMatrix() const { return transformationMatrixData; }
+
+		/// <summary>
+		/// カメラのビュー空間での深度の取得 (レンダーキューの並べ替え用。カメラがなければ0)
+		/// </summary>
+		/// <returns></returns>
+		float GetViewDepth() const;
 
 		///-------------------------------------------/// 
 		/// メンバ変数
 		///-------------------------------------------///
 	private:
 
-		// 座標変換行列リソース
-		Microsoft::WRL::ComPtr <ID3D12Resource> transformationMatrixResource;
-		// 平行光源リソース
-		Microsoft::WRL::ComPtr <ID3D12Resource> directionalLightResource;
-		// 点光源リソース
-		Microsoft::WRL::ComPtr <ID3D12Resource> pointLightResource;
-		// スポットライトリソース
-		Microsoft::WRL::ComPtr <ID3D12Resource> spotLightResource;
-		// 環境リソース
-		Microsoft::WRL::ComPtr <ID3D12Resource> environmentResource;
-		// カメラリソース
-		Microsoft::WRL::ComPtr <ID3D12Resource> cameraResource;
-
-		// 座標変換行列データ
-		TransformationMatrix* transformationMatrixData = nullptr;
-		// 平行光源データ
-		DirectionalLight* directionalLightData = nullptr;
-		// 点光源データ
-		PointLight* pointLightData = nullptr;
-		// スポットライトデータ
-		SpotLight* spotLightData = nullptr;
-		// 環境データ
-		Environment* environmentData = nullptr;
-		// カメラデータ
-		Vector3* cameraData;
+		// 座標変換行列データ (描画のたびにアップロードアロケータへ書き込む。光源はLightManagerが全オブジェクト共通で持つ)
+		TransformationMatrix transformationMatrixData{};
 
 		// モデル
 		Model* model = nullptr;
@@ -269,6 +225,10 @@ namespace Engine {
 
 		bool isDraw = true;
 
+		// 視錐台カリングの登録番号と世代 (世代が0なら登録していないので常に描画する)
+		uint32_t cullIndex = 0;
+		uint32_t cullGeneration = 0;
+
 		// DirectXUtilityのインスタンス
 		DirectXUtility* dxUtility = nullptr;
 
@@ -1,6 +1,14 @@
 #include "Object3dRenderer.h"
 #include "DirectXUtility.h"
 #include "SrvManager.h"
+#include "Object3d.h"
+#include "Camera.h"
+#include "GameClock.h"
+#include "Light/LightManager.h"
+#include "Profiler.h"
+#include "FrameCounters.h"
+
+#include <algorithm>
 
 using namespace Engine;
 
@@ -12,11 +20,17 @@ void Object3dRenderer::Initialize() {
 	// SrvManagerのインスタンス取得
 	srvManager_ = SrvManager::GetInstance();
 
+	// ライトマネージャーのインスタンス取得
+	lightManager_ = LightManager::GetInstance();
+
 	// 不透明用のグラフィックスパイプラインの生成
 	CreateGraphicsPipelinOpaque();
 
 	// 透明用のグラフィックスパイプラインの生成
 	CreateGraphicsPipelinAlpha();
+
+	// インスタンス描画用のグラフィックスパイプラインの生成
+	CreateGraphicsPipelineInstanced();
 }
 
 void Object3dRenderer::SettingDrawingOpaque() {
@@ -38,6 +52,9 @@ void Object3dRenderer::SettingDrawingOpaque() {
 
 	// ディスクリプタヒープを設定
 	dxUtility_->GetCommandList()->SetDescriptorHeaps(1, descriptorHeaps);
+
+	// シーンのライトを設定
+	SetLights();
 }
 
 void Object3dRenderer::SettingDrawingAlpha() {
@@ -59,6 +76,112 @@ void Object3dRenderer::SettingDrawingAlpha() {
 
 	// ディスクリプタヒープを設定
 	dxUtility_->GetCommandList()->SetDescriptorHeaps(1, descriptorHeaps);
+
+	// シーンのライトを設定
+	SetLights();
+}
+
+void Object3dRenderer::SettingDrawingInstanced() {
+
+	// コマンドリストを取得
+	ID3D12GraphicsCommandList* commandList = dxUtility_->GetCommandList().Get();
+
+	// ルートシグネチャを設定
+	commandList->SetGraphicsRootSignature(pipelineBuilderInstanced_.GetRootSignature().Get());
+
+	// パイプラインを設定
+	commandList->SetPipelineState(pipelineBuilderInstanced_.GetGraphicsPipeline().Get());
+
+	// プリミティブトポロジーを線で設定
+	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+	// ディスクリプタヒープを取得
+	ID3D12DescriptorHeap* descriptorHeaps[] = { srvManager_->GetDescriptorHeap().Get() };
+
+	// ディスクリプタヒープを設定
+	dxUtility_->GetCommandList()->SetDescriptorHeaps(1, descriptorHeaps);
+
+	// シーンのライトを設定
+	SetLights();
+}
+
+void Object3dRenderer::Cull() {
+
+	PROFILE_SCOPE("Object3dRenderer::Cull");
+
+	// デフォルトカメラがなければ判定しない (全て見えるものとして扱われる)
+	if (defaultCamera_) {
+
+		// 前のステップとの間を補間したカメラで描画する
+		renderViewProjectionMatrix_ = defaultCamera_->GetInterpolatedViewProjectionMatrix(GameClock::GetAlpha());
+
+		// 画面に映る範囲で判定する
+		culler_.Cull(renderViewProjectionMatrix_);
+	}
+
+	// コマンドの並列記録が始まる前に、メインスレッドでこのフレームのライトをアップロードする
+	lightManager_->Upload(defaultCamera_, GameClock::GetAlpha());
+}
+
+void Object3dRenderer::AddInstance(Object3d* object, uint64_t batchKey) {
+
+	// 配列の番号をバッチャーに渡す
+	batcher_.Add(batchKey, static_cast<uint32_t>(instancedObjects_.size()));
+	instancedObjects_.push_back(object);
+}
+
+void Object3dRenderer::FlushInstanced() {
+
+	// まとまりごとにそのまま描画する
+	BuildBatches([this](const InstanceBatcher::Batch& batch, uint64_t instanceDataAddress) {
+
+		// 先頭のオブジェクトのモデルで描画する (キーが同じなので他のオブジェクトも同じモデルとマテリアル)
+		instancedObjects_[batcher_.GetInstances()[batch.first]]->DrawBatch(instanceDataAddress, batch.count);
+	});
+}
+
+void Object3dRenderer::SubmitInstanced(RenderQueue& renderQueue, RenderQueue::Pass pass, uint32_t pipeline) {
+
+	// まとまりごとに描画パケットを積む
+	BuildBatches([&](const InstanceBatcher::Batch& batch, uint64_t instanceDataAddress) {
+
+		const std::vector<uint32_t>& instances = batcher_.GetInstances();
+
+		// まとまりの中で一番手前のインスタンスの深度で並べる
+		float depth = instancedObjects_[instances[batch.first]]->GetViewDepth();
+		for (uint32_t i = 1; i < batch.count; ++i) {
+			depth = (std::min)(depth, instancedObjects_[instances[batch.first + i]]->GetViewDepth());
+		}
+
+		// 先頭のオブジェクトのモデルで描画する (登録は空になるのでポインタを値で持つ)
+		Object3d* object = instancedObjects_[instances[batch.first]];
+		uint32_t instanceCount = batch.count;
+
+		renderQueue.Submit(pass, pipeline, object->GetModel()->GetMaterialID(), depth, [object, instanceDataAddress, instanceCount]() {
+			object->DrawBatch(instanceDataAddress, instanceCount);
+		});
+	});
+}
+
+void Object3dRenderer::SetLights() {
+
+	// コマンドリストを取得 (ライトはCullでアップロード済みなので、ここではアドレスを読むだけ)
+	ID3D12GraphicsCommandList* commandList = dxUtility_->GetCommandList().Get();
+
+	/// === シーン共通のライトCBufferの場所を設定 === ///
+	commandList->SetGraphicsRootConstantBufferView(2, lightManager_->GetSceneLightAddress());
+
+	/// === ローカルライトStructuredBufferの場所を設定 === ///
+	commandList->SetGraphicsRootShaderResourceView(3, lightManager_->GetLocalLightAddress());
+
+	/// === クラスタごとのライトの範囲StructuredBufferの場所を設定 === ///
+	commandList->SetGraphicsRootShaderResourceView(6, lightManager_->GetClusterRangeAddress());
+
+	/// === クラスタのライトの番号StructuredBufferの場所を設定 === ///
+	commandList->SetGraphicsRootShaderResourceView(7, lightManager_->GetClusterLightIndexAddress());
+
+	// 設定したルートパラメータを数える
+	FrameCounters::GetInstance()->Add(FrameCounters::kRootParameterBinds, 4);
 }
 
 void Object3dRenderer::Finalize() {
@@ -77,20 +200,11 @@ void Object3dRenderer::CreateGraphicsPipelinOpaque() {
 	// gMaterial CBV、b1、ピクセルシェーダーで使う
 	pipelineBuilderOpaque_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_CBV, 1, D3D12_SHADER_VISIBILITY_PIXEL);
 
-	// gDirectionalLight CBV、b2、ピクセルシェーダーで使う
+	// gSceneLight CBV、b2、ピクセルシェーダーで使う
 	pipelineBuilderOpaque_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_CBV, 2, D3D12_SHADER_VISIBILITY_PIXEL);
 
-	// gPointLight CBV、b3、ピクセルシェーダーで使う
-	pipelineBuilderOpaque_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_CBV, 3, D3D12_SHADER_VISIBILITY_PIXEL);
-
-	// gSpotLight CBV、b4、ピクセルシェーダーで使う
-	pipelineBuilderOpaque_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_CBV, 4, D3D12_SHADER_VISIBILITY_PIXEL);
-
-	// gEnvironment CBV、b5、ピクセルシェーダーで使う
-	pipelineBuilderOpaque_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_CBV, 5, D3D12_SHADER_VISIBILITY_PIXEL);
-
-	// gCamera CBV、b6、ピクセルシェーダーで使う
-	pipelineBuilderOpaque_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_CBV, 6, D3D12_SHADER_VISIBILITY_PIXEL);
+	// gLocalLights SRV、t2、ピクセルシェーダーで使う
+	pipelineBuilderOpaque_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_SRV, 2, D3D12_SHADER_VISIBILITY_PIXEL);
 
 	// gTexture SRV、t0、ピクセルシェーダーで使う
 	pipelineBuilderOpaque_.AddRootParameterTable(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 0, D3D12_SHADER_VISIBILITY_PIXEL);
@@ -98,6 +212,12 @@ void Object3dRenderer::CreateGraphicsPipelinOpaque() {
 	// gEnvironmentTexture SRV、t1、ピクセルシェーダーで使う
 	pipelineBuilderOpaque_.AddRootParameterTable(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, D3D12_SHADER_VISIBILITY_PIXEL);
 
+	// gClusterRanges SRV、t3、ピクセルシェーダーで使う
+	pipelineBuilderOpaque_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_SRV, 3, D3D12_SHADER_VISIBILITY_PIXEL);
+
+	// gClusterLightIndices SRV、t4、ピクセルシェーダーで使う
+	pipelineBuilderOpaque_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_SRV, 4, D3D12_SHADER_VISIBILITY_PIXEL);
+
 	// gSampler 線形フィルタ、テクスチャ端は繰り返し、s0、ピクセルシェーダーで使う
 	pipelineBuilderOpaque_.AddStaticSampler(D3D12_FILTER_MIN_MAG_MIP_LINEAR, D3D12_TEXTURE_ADDRESS_MODE_WRAP, 0, D3D12_SHADER_VISIBILITY_PIXEL);
 
@@ -138,20 +258,11 @@ void Object3dRenderer::CreateGraphicsPipelinAlpha() {
 	// gMaterial CBV、b1、ピクセルシェーダーで使う
 	pipelineBuilderAlpha_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_CBV, 1, D3D12_SHADER_VISIBILITY_PIXEL);
 
-	// gDirectionalLight CBV、b2、ピクセルシェーダーで使う
+	// gSceneLight CBV、b2、ピクセルシェーダーで使う
 	pipelineBuilderAlpha_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_CBV, 2, D3D12_SHADER_VISIBILITY_PIXEL);
 
-	// gPointLight CBV、b3、ピクセルシェーダーで使う
-	pipelineBuilderAlpha_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_CBV, 3, D3D12_SHADER_VISIBILITY_PIXEL);
-
-	// gSpotLight CBV、b4、ピクセルシェーダーで使う
-	pipelineBuilderAlpha_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_CBV, 4, D3D12_SHADER_VISIBILITY_PIXEL);
-
-	// gEnvironment CBV、b5、ピクセルシェーダーで使う
-	pipelineBuilderAlpha_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_CBV, 5, D3D12_SHADER_VISIBILITY_PIXEL);
-
-	// gCamera CBV、b6、ピクセルシェーダーで使う
-	pipelineBuilderAlpha_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_CBV, 6, D3D12_SHADER_VISIBILITY_PIXEL);
+	// gLocalLights SRV、t2、ピクセルシェーダーで使う
+	pipelineBuilderAlpha_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_SRV, 2, D3D12_SHADER_VISIBILITY_PIXEL);
 
 	// gTexture SRV、t0、ピクセルシェーダーで使う
 	pipelineBuilderAlpha_.AddRootParameterTable(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 0, D3D12_SHADER_VISIBILITY_PIXEL);
@@ -159,6 +270,12 @@ void Object3dRenderer::CreateGraphicsPipelinAlpha() {
 	// gEnvironmentTexture SRV、t1、ピクセルシェーダーで使う
 	pipelineBuilderAlpha_.AddRootParameterTable(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, D3D12_SHADER_VISIBILITY_PIXEL);
 
+	// gClusterRanges SRV、t3、ピクセルシェーダーで使う
+	pipelineBuilderAlpha_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_SRV, 3, D3D12_SHADER_VISIBILITY_PIXEL);
+
+	// gClusterLightIndices SRV、t4、ピクセルシェーダーで使う
+	pipelineBuilderAlpha_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_SRV, 4, D3D12_SHADER_VISIBILITY_PIXEL);
+
 	// gSampler 線形フィルタ、テクスチャ端は繰り返し、s0、ピクセルシェーダーで使う
 	pipelineBuilderAlpha_.AddStaticSampler(D3D12_FILTER_MIN_MAG_MIP_LINEAR, D3D12_TEXTURE_ADDRESS_MODE_WRAP, 0, D3D12_SHADER_VISIBILITY_PIXEL);
 
@@ -191,6 +308,64 @@ void Object3dRenderer::CreateGraphicsPipelinAlpha() {
 	pipelineBuilderAlpha_.Build();
 }
 
+void Object3dRenderer::CreateGraphicsPipelineInstanced() {
+
+	// gInstance SRV、t0、頂点シェーダーで使う (ルートパラメータの番号は通常の描画と揃える)
+	pipelineBuilderInstanced_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_SRV, 0, D3D12_SHADER_VISIBILITY_VERTEX);
+
+	// gMaterial CBV、b1、ピクセルシェーダーで使う
+	pipelineBuilderInstanced_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_CBV, 1, D3D12_SHADER_VISIBILITY_PIXEL);
+
+	// gSceneLight CBV、b2、ピクセルシェーダーで使う
+	pipelineBuilderInstanced_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_CBV, 2, D3D12_SHADER_VISIBILITY_PIXEL);
+
+	// gLocalLights SRV、t2、ピクセルシェーダーで使う
+	pipelineBuilderInstanced_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_SRV, 2, D3D12_SHADER_VISIBILITY_PIXEL);
+
+	// gTexture SRV、t0、ピクセルシェーダーで使う
+	pipelineBuilderInstanced_.AddRootParameterTable(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 0, D3D12_SHADER_VISIBILITY_PIXEL);
+
+	// gEnvironmentTexture SRV、t1、ピクセルシェーダーで使う
+	pipelineBuilderInstanced_.AddRootParameterTable(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, D3D12_SHADER_VISIBILITY_PIXEL);
+
+	// gClusterRanges SRV、t3、ピクセルシェーダーで使う
+	pipelineBuilderInstanced_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_SRV, 3, D3D12_SHADER_VISIBILITY_PIXEL);
+
+	// gClusterLightIndices SRV、t4、ピクセルシェーダーで使う
+	pipelineBuilderInstanced_.AddRootParameter(D3D12_ROOT_PARAMETER_TYPE_SRV, 4, D3D12_SHADER_VISIBILITY_PIXEL);
+
+	// gSampler 線形フィルタ、テクスチャ端は繰り返し、s0、ピクセルシェーダーで使う
+	pipelineBuilderInstanced_.AddStaticSampler(D3D12_FILTER_MIN_MAG_MIP_LINEAR, D3D12_TEXTURE_ADDRESS_MODE_WRAP, 0, D3D12_SHADER_VISIBILITY_PIXEL);
+
+	// シェーダーをパイプラインに設定
+	pipelineBuilderInstanced_.SetVertexShaderFileName(instancedVertexShaderFileName);
+	pipelineBuilderInstanced_.SetPixelShaderFileName(pixelShaderFileName);
+
+	// ブレンドモードの設定 アルファブレンド
+	pipelineBuilderInstanced_.SetBlendMode(GraphicsPipelineBuilder::BlendMode::None);
+
+	// カリングモードの設定 なし
+	pipelineBuilderInstanced_.SetCullMode(GraphicsPipelineBuilder::CullMode::Back);
+
+	// 深度モードの設定 無効化
+	pipelineBuilderInstanced_.SetDepthMode(GraphicsPipelineBuilder::DepthMode::ReadWrite);
+
+	// インプットエレメントの追加 POSITION0 float4
+	pipelineBuilderInstanced_.AddInputElement("POSITION", 0, DXGI_FORMAT_R32G32B32A32_FLOAT);
+
+	// インプットエレメントの追加 TEXCOORD0 float2
+	pipelineBuilderInstanced_.AddInputElement("TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT);
+
+	// インプットエレメントの追加 NORMAL0 float3
+	pipelineBuilderInstanced_.AddInputElement("NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT);
+
+	// トポロジーモードの設定
+	pipelineBuilderInstanced_.SetTopologyMode(GraphicsPipelineBuilder::TopologyMode::Triangle);
+
+	// パイプライン作成
+	pipelineBuilderInstanced_.Build();
+}
+
 Object3dRenderer* Object3dRenderer::GetInstance() {
 
 	if (instance_ == nullptr) {
@@ -198,3 +373,49 @@ Object3dRenderer* Object3dRenderer::GetInstance() {
 	}
 	return instance_;
 }
+
+void Object3dRenderer::BuildBatches(const std::function<void(const InstanceBatcher::Batch&, uint64_t)>& function) {
+
+	// 登録がなければ何もしない
+	if (instancedObjects_.empty()) {
+		instanceCount_ = 0;
+		batchCount_ = 0;
+		return;
+	}
+
+	// キーごとにまとめる
+	batcher_.Build(kMaxInstancesPerBatch);
+
+	// アップロードアロケータ
+	UploadAllocator& uploadAllocator = dxUtility_->GetUploadAllocator();
+
+	// キー順に並べた番号
+	const std::vector<uint32_t>& instances = batcher_.GetInstances();
+
+	for (const InstanceBatcher::Batch& batch : batcher_.GetBatches()) {
+
+		// インスタンスごとの座標変換行列をまとめて書き込む
+		UploadAllocator::Allocation allocation = uploadAllocator.Allocate(sizeof(Object3d::TransformationMatrix) * batch.count, alignof(Object3d::TransformationMatrix));
+
+		// 書き込めなければこのまとまりは描画しない
+		if (!allocation.IsValid()) {
+			continue;
+		}
+
+		Object3d::TransformationMatrix* instanceData = reinterpret_cast<Object3d::TransformationMatrix*>(allocation.cpuAddress);
+
+		for (uint32_t i = 0; i < batch.count; ++i) {
+			instanceData[i] = instancedObjects_[instances[batch.first + i]]->GetTransformationMatrix();
+		}
+
+		function(batch, allocation.gpuAddress);
+	}
+
+	// 統計を記録
+	instanceCount_ = static_cast<uint32_t>(instancedObjects_.size());
+	batchCount_ = static_cast<uint32_t>(batcher_.GetBatches().size());
+
+	// 次のフレームのために空にする
+	batcher_.Clear();
+	instancedObjects_.clear();
+}
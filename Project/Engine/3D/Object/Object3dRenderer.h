@@ -1,6 +1,12 @@
 #pragma once
 
 #include "GraphicsPipelineBuilder.h"
+#include "InstanceBatcher.h"
+#include "FrustumCuller.h"
+#include "RenderQueue.h"
+
+#include <functional>
+#include <vector>
 
 namespace Engine {
 
@@ -8,6 +14,8 @@ namespace Engine {
 	class DirectXUtility;
 	class SrvManager;
 	class Camera;
+	class Object3d;
+	class LightManager;
 
 	/// <summary>
 	/// 3Dオブジェクトのレンダラー
@@ -51,6 +59,38 @@ namespace Engine {
 		/// </summary>
 		void SettingDrawingAlpha();
 
+		/// <summary>
+		/// インスタンス描画用の描画設定
+		/// </summary>
+		void SettingDrawingInstanced();
+
+		/// <summary>
+		/// 更新で登録された3Dオブジェクトをデフォルトカメラの視錐台でまとめてカリングする (描画の前に呼ぶ)
+		/// 描画に使うデフォルトカメラの補間したビュープロジェクション行列もここで作り、このフレームのライトもここでアップロードする
+		/// </summary>
+		void Cull();
+
+		/// <summary>
+		/// インスタンス描画の登録 (Object3d::DrawInstancedから呼ばれる)
+		/// </summary>
+		/// <param name="object">3Dオブジェクト</param>
+		/// <param name="batchKey">まとめるキー</param>
+		void AddInstance(Object3d* object, uint64_t batchKey);
+
+		/// <summary>
+		/// 登録されたインスタンスをキーごとにまとめて描画する (SettingDrawingInstancedの後に呼ぶ)
+		/// </summary>
+		void FlushInstanced();
+
+		/// <summary>
+		/// 登録されたインスタンスをキーごとにまとめ、まとまりごとに描画パケットとしてレンダーキューに積む
+		/// インスタンスデータの書き込みはここで済ませるので、パケットは描画コマンドを積むだけになる
+		/// </summary>
+		/// <param name="renderQueue">レンダーキュー</param>
+		/// <param name="pass">描画パス</param>
+		/// <param name="pipeline">パイプラインの番号 (SettingDrawingInstancedを登録したもの)</param>
+		void SubmitInstanced(RenderQueue& renderQueue, RenderQueue::Pass pass, uint32_t pipeline);
+
 		/// <summary>
 		/// 終了
 		/// </summary>
@@ -71,6 +111,22 @@ namespace Engine {
 		/// </summary>
 		void CreateGraphicsPipelinAlpha();
 
+		/// <summary>
+		/// インスタンス描画用のグラフィックスパイプラインの生成 (不透明のみ)
+		/// </summary>
+		void CreateGraphicsPipelineInstanced();
+
+		/// <summary>
+		/// シーンのライトを設定 (ルートパラメータ2、3、6、7に全オブジェクト共通のライトとクラスタを設定する)
+		/// </summary>
+		void SetLights();
+
+		/// <summary>
+		/// 登録されたインスタンスをキーごとにまとめ、まとまりごとにインスタンスデータを書き込んで処理を呼ぶ (呼んだ後は登録を空にする)
+		/// </summary>
+		/// <param name="function">まとまりごとの処理 (まとまり、インスタンスデータのGPUアドレス)</param>
+		void BuildBatches(const std::function<void(const InstanceBatcher::Batch&, uint64_t)>& function);
+
 	///-------------------------------------------/// 
 	/// ゲッター
 	///-------------------------------------------///
@@ -88,6 +144,30 @@ namespace Engine {
 		/// <returns>カメラのポインタ</returns>
 		Camera* GetDefaultCamera() const { return defaultCamera_; }
 
+		/// <summary>
+		/// 前回のFlushInstancedまたはSubmitInstancedで描画したインスタンスの数のゲッター
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetInstanceCount() const { return instanceCount_; }
+
+		/// <summary>
+		/// 前回のFlushInstancedまたはSubmitInstancedで発行した描画の数のゲッター
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetBatchCount() const { return batchCount_; }
+
+		/// <summary>
+		/// 視錐台カリングのゲッター
+		/// </summary>
+		/// <returns></returns>
+		FrustumCuller& GetCuller() { return culler_; }
+
+		/// <summary>
+		/// 描画に使うデフォルトカメラのビュープロジェクション行列のゲッター (Cullで補間したもの)
+		/// </summary>
+		/// <returns></returns>
+		const Matrix4x4& GetRenderViewProjectionMatrix() const { return renderViewProjectionMatrix_; }
+
 	///-------------------------------------------/// 
 	/// セッター
 	///-------------------------------------------///
@@ -110,12 +190,36 @@ namespace Engine {
 		// 透明用パイプラインビルダー
 		GraphicsPipelineBuilder pipelineBuilderAlpha_;
 
+		// インスタンス描画用パイプラインビルダー
+		GraphicsPipelineBuilder pipelineBuilderInstanced_;
+
 		// 頂点シェーダーのファイル名
 		std::wstring vertexShaderFileName = L"Object3d/Object3d.VS.hlsl";
 
+		// インスタンス描画用の頂点シェーダーのファイル名
+		std::wstring instancedVertexShaderFileName = L"Object3d/Object3dInstanced.VS.hlsl";
+
 		// ピクセルシェーダーのファイル名
 		std::wstring pixelShaderFileName = L"Object3d/Object3d.PS.hlsl";
 
+		// 視錐台カリング
+		FrustumCuller culler_;
+
+		// 描画に使うデフォルトカメラのビュープロジェクション行列 (並列記録中に何度も補間しないようにフレームごとに1回作る)
+		Matrix4x4 renderViewProjectionMatrix_ = {};
+
+		// インスタンス描画のバッチャー
+		InstanceBatcher batcher_;
+
+		// インスタンス描画に登録された3Dオブジェクト (バッチャーにはこの配列の番号を渡す)
+		std::vector<Object3d*> instancedObjects_;
+
+		// 前回描画したインスタンスの数
+		uint32_t instanceCount_ = 0;
+
+		// 前回発行した描画の数
+		uint32_t batchCount_ = 0;
+
 		/// ===== 借りポインタ・インスタンス ===== ///
 
 		// DirectXユーティリティのインスタンス
@@ -124,8 +228,19 @@ namespace Engine {
 		// SrvManagerのインスタンス
 		SrvManager* srvManager_ = nullptr;
 
+		// ライトマネージャーのインスタンス
+		LightManager* lightManager_ = nullptr;
+
 		// デフォルトカメラ
 		Camera* defaultCamera_ = nullptr;
+
+	///-------------------------------------------/// 
+	/// 定数
+	///-------------------------------------------///
+	private:
+
+		// 1回の描画に入れるインスタンスの上限 (アップロードリングを1度に大きく使いすぎないように分ける)
+		static const uint32_t kMaxInstancesPerBatch = 1024;
 	};
 }
 
@@ -12,7 +12,7 @@ void ParticleEmitter::Initialize() {
 	worldTransform.Initialize();
 }
 
-void ParticleEmitter::Update() {
+void ParticleEmitter::Update(float deltaTime) {
 
 	// タイプに応じた発射処理
 	switch (emitterType) {
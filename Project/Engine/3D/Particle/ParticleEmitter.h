@@ -41,7 +41,8 @@ namespace Engine {
 		/// <summary>
 		/// 更新
 		/// </summary>
-		void Update();
+		/// <param name="deltaTime">経過時間(秒)</param>
+		void Update(float deltaTime);
 
 		/// <summary>
 		/// パーティクル発生
@@ -82,9 +83,6 @@ namespace Engine {
 		// 発生用タイマー
 		float timer = 0.0f;
 
-		// デルタタイム
-		const float deltaTime = 1.0f / 60.0f;
-
 		// 1回あたりの発生数
 		uint32_t count = 0;
 
@@ -5,6 +5,8 @@
 #include "Camera.h"
 #include "MathVector.h"
 #include "MathMatrix.h"
+#include "Profiler.h"
+#include "FrameCounters.h"
 
 #include <numbers>
 #include <fstream>
@@ -57,7 +59,9 @@ void ParticleManager::Initialize() {
 	LoadParticleSettingsFromJSON();
 }
 
-void ParticleManager::Update() {
+void ParticleManager::Update(float deltaTime) {
+
+	PROFILE_SCOPE("ParticleManager::Update");
 
 	// カメラからViewProjectionを受け取る
 	viewProjectionMatrix = camera->GetViewProjectionMatrix();
@@ -74,19 +78,28 @@ void ParticleManager::Update() {
 	billboardMatrix.m[3][2] = 0.0f;
 
 	// 板ポリのパーティクルコンテナの更新
-	UpdateGroups(planeGroups);
+	UpdateGroups(planeGroups, deltaTime);
 
 	// リングのパーティクルコンテナの更新
-	UpdateGroups(ringGroups);
+	UpdateGroups(ringGroups, deltaTime);
 
 	// シリンダーのパーティクルコンテナの更新
-	UpdateGroups(cylinderGroups);
+	UpdateGroups(cylinderGroups, deltaTime);
 
 	// キューブのパーティクルコンテナの更新
-	UpdateGroups(cubeGroups);
+	UpdateGroups(cubeGroups, deltaTime);
 
 	// シャードのパーティクルコンテナの更新
-	UpdateGroups(shardGroups);
+	UpdateGroups(shardGroups, deltaTime);
+
+	// 生きているパーティクルの数を数える
+	uint64_t liveParticleCount = 0;
+	for (const auto* groups : { &planeGroups, &ringGroups, &cylinderGroups, &cubeGroups, &shardGroups }) {
+		for (const auto& [name, group] : *groups) {
+			liveParticleCount += group.particles.size();
+		}
+	}
+	FrameCounters::GetInstance()->Set(FrameCounters::kLiveParticles, liveParticleCount);
 }
 
 void ParticleManager::Draw() {
@@ -145,6 +158,41 @@ void ParticleManager::Draw() {
 	}
 }
 
+void ParticleManager::Submit(RenderQueue& renderQueue, RenderQueue::Pass pass, uint32_t pipeline) {
+
+	// カメラがないと描画できないのでアサート
+	assert(camera && "Camera is nullptr");
+
+	// テクスチャマネージャのインスタンス
+	TextureManager* textureManager = TextureManager::GetInstance();
+
+	// 形状ごとのグループを積む (形状の番号を上位、テクスチャの番号を下位にしてマテリアルの番号にする)
+	auto submitGroups = [&](std::unordered_map<std::string, ParticleGroup>& groups, auto* renderer, uint32_t shape) {
+
+		for (auto& entry : groups) {
+
+			ParticleGroup& group = entry.second;
+
+			// リストが空なら描画しない
+			if (group.particles.empty() || group.numInstance <= 0) continue;
+
+			// パケットはこのフレームのうちに実行されるので、グループとファイル名は参照で持つ
+			const std::string& textureFileName = entry.first;
+			uint32_t material = (shape << 16) | (textureManager->GetTextureIndexByFilePath(textureFileName) & 0xFFFF);
+
+			renderQueue.Submit(pass, pipeline, material, 0.0f, [renderer, &group, &textureFileName]() {
+				renderer->Draw(group.numInstance, group.srvIndex, textureFileName);
+			});
+		}
+	};
+
+	submitGroups(planeGroups, planeRenderer.get(), 0);
+	submitGroups(ringGroups, ringRenderer.get(), 1);
+	submitGroups(cylinderGroups, cylinderRenderer.get(), 2);
+	submitGroups(cubeGroups, cubeRenderer.get(), 3);
+	submitGroups(shardGroups, shardRenderer.get(), 4);
+}
+
 void ParticleManager::Finalize() {
 
 	// インスタンスの破棄
@@ -255,7 +303,7 @@ void ParticleManager::AddSetting(ParticleSetting& setting) {
 	setting.textureFullPath = TextureFolderPath + setting.textureFileName;
 
 	// テクスチャを読み込み
-	textureManager->LoadTexture(setting.textureFullPath);
+	textureHandles[setting.textureFullPath] = textureManager->AcquireTexture(setting.textureFullPath);
 
 	// 設定を追加
 	settings[setting.effectName] = setting;
@@ -339,13 +387,13 @@ void ParticleManager::AddInstance(const ParticleInstance& instance) {
 	}
 }
 
-void ParticleManager::UpdateParticles(std::list<ParticleInstance>& particles) {
+void ParticleManager::UpdateParticles(std::list<ParticleInstance>& particles, float deltaTime) {
 
 	// 全パーティクルの更新
 	for (auto ite = particles.begin(); ite != particles.end(); ) {
 
 		// 時間経過
-		ite->currentTime += kDeltaTime;
+		ite->currentTime += deltaTime;
 
 		// 寿命が来ていたら
 		if (ite->currentTime >= ite->lifeTime) {
@@ -361,7 +409,7 @@ void ParticleManager::UpdateParticles(std::list<ParticleInstance>& particles) {
 		// アルファ値を更新
 		ite->color.w = alphaRatio;
 
-		// 加速度による速度変化
+		// 加速度による速度変化 (速度と加速度は固定の刻みの1ステップあたりの量)
 		ite->velocity += ite->acceleration;
 		// 速度による位置変化
 		ite->translate += ite->velocity;
@@ -370,7 +418,7 @@ void ParticleManager::UpdateParticles(std::list<ParticleInstance>& particles) {
 	}
 }
 
-void ParticleManager::UpdateGroups(std::unordered_map<std::string, ParticleGroup>& groups) {
+void ParticleManager::UpdateGroups(std::unordered_map<std::string, ParticleGroup>& groups, float deltaTime) {
 
 	for (auto& [key, group] : groups) {
 
@@ -380,7 +428,7 @@ void ParticleManager::UpdateGroups(std::unordered_map<std::string, ParticleGroup
 		if (group.particles.empty()) continue;
 
 		// 各パーティクルの更新
-		UpdateParticles(group.particles);
+		UpdateParticles(group.particles, deltaTime);
 
 		for (const auto& particle : group.particles) {
 
@@ -541,7 +589,7 @@ void ParticleManager::ShowParameters() {
 
 		// テクスチャのロードもここで行う
 		p.textureFullPath = TextureFolderPath + p.textureFileName;
-		textureManager->LoadTexture(p.textureFullPath);
+		textureHandles[p.textureFullPath] = textureManager->AcquireTexture(p.textureFullPath);
 
 		// マップに書き戻す
 		settings[currentEditName] = p;
@@ -587,7 +635,7 @@ void ParticleManager::ShowParameters() {
 		p.textureFullPath = TextureFolderPath + p.textureFileName;
 
 		// テクスチャを読み込む
-		textureManager->LoadTexture(p.textureFullPath);
+		textureHandles[p.textureFullPath] = textureManager->AcquireTexture(p.textureFullPath);
 
 		// 一時的に設定を登録
 		ParticleSetting tempSettingCopy = p;
@@ -641,7 +689,7 @@ void ParticleManager::ShowParameters() {
 			if (ImGui::IsItemDeactivatedAfterEdit()) {
 
 				// ここで初めて重いロード処理を呼ぶ
-				textureManager->LoadTexture(p.textureFullPath);
+				textureHandles[p.textureFullPath] = textureManager->AcquireTexture(p.textureFullPath);
 			}
 
 			// フラグ系
@@ -771,7 +819,7 @@ void ParticleManager::LoadSettingsFromJSON(const std::string& filePath) {
 	setting.textureFullPath = TextureFolderPath + setting.textureFileName;
 
 	// テクスチャの読み込み
-	textureManager->LoadTexture(setting.textureFullPath);
+	textureHandles[setting.textureFullPath] = textureManager->AcquireTexture(setting.textureFullPath);
 
 	// マップに登録
 	settings[setting.effectName] = setting;
@@ -6,6 +6,8 @@
 #include "ShapeRenderers/CylinderRenderer.h"
 #include "ShapeRenderers/CubeRenderer.h"
 #include "ShapeRenderers/ShardRenderer.h"
+#include "Texture/TextureManager.h"
+#include "RenderQueue.h"
 
 #include <unordered_map>
 #include <string>
@@ -15,7 +17,6 @@
 namespace Engine {
 
 	/// ===== 前方宣言 ===== ///
-	class TextureManager;
 	class DirectXUtility;
 	class SrvManager;
 	class Camera;
@@ -53,13 +54,22 @@ namespace Engine {
 		/// <summary>
 		/// 更新
 		/// </summary>
-		void Update();
+		/// <param name="deltaTime">経過時間(秒)</param>
+		void Update(float deltaTime);
 
 		/// <summary>
 		/// 描画
 		/// </summary>
 		void Draw();
 
+		/// <summary>
+		/// グループごとに描画パケットとしてレンダーキューに積む (形状とテクスチャをマテリアルの番号にする)
+		/// </summary>
+		/// <param name="renderQueue">レンダーキュー</param>
+		/// <param name="pass">描画パス (順番に依存しない合成を前提にするので深度は使わない)</param>
+		/// <param name="pipeline">パイプラインの番号</param>
+		void Submit(RenderQueue& renderQueue, RenderQueue::Pass pass, uint32_t pipeline);
+
 		/// <summary>
 		/// 終了
 		/// </summary>
@@ -91,13 +101,15 @@ namespace Engine {
 		/// Groupごとのパーティクル更新
 		/// </summary>
 		/// <param name="particles"></param>
-		void UpdateParticles(std::list<ParticleInstance>& particles);
+		/// <param name="deltaTime">経過時間(秒)</param>
+		void UpdateParticles(std::list<ParticleInstance>& particles, float deltaTime);
 
 		/// <summary>
 		/// グループコンテナの更新
 		/// </summary>
 		/// <param name="groups"></param>
-		void UpdateGroups(std::unordered_map<std::string, ParticleGroup>& groups);
+		/// <param name="deltaTime">経過時間(秒)</param>
+		void UpdateGroups(std::unordered_map<std::string, ParticleGroup>& groups, float deltaTime);
 
 		/// <summary>
 		/// JSONからパーティクル設定を全て読み込み
@@ -181,6 +193,9 @@ namespace Engine {
 		// 設定のコンテナ エフェクト名、設定
 		std::unordered_map<std::string, ParticleSetting> settings;
 
+		// 使用中のテクスチャのハンドル テクスチャのフルパス、ハンドル
+		std::unordered_map<std::string, TextureHandle> textureHandles;
+
 		// グループコンテナ  エフェクト名、グループ
 		std::unordered_map<std::string, ParticleGroup> planeGroups;
 		std::unordered_map<std::string, ParticleGroup> ringGroups;
@@ -188,9 +203,6 @@ namespace Engine {
 		std::unordered_map<std::string, ParticleGroup> cubeGroups;
 		std::unordered_map<std::string, ParticleGroup> shardGroups;
 
-		// Δt
-		const float kDeltaTime = 1.0f / 60.0f;
-
 		// 板ポリのレンダラー
 		std::unique_ptr<PlaneRenderer> planeRenderer = nullptr;
 
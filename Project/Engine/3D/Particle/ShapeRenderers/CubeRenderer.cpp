@@ -3,6 +3,7 @@
 #include "SrvManager.h"
 #include "Texture/TextureManager.h"
 #include "MathMatrix.h"
+#include "FrameCounters.h"
 
 using namespace Engine;
 using namespace MathMatrix;
@@ -28,7 +29,7 @@ void CubeRenderer::Initialize() {
 	GenerateMaterialData();
 }
 
-void CubeRenderer::Update() {
+void CubeRenderer::Update(float deltaTime) {
 }
 
 void CubeRenderer::Draw(uint16_t instanceCount, uint16_t instanceSrvIndex, const std::string& texturePath) {
@@ -50,6 +51,9 @@ void CubeRenderer::Draw(uint16_t instanceCount, uint16_t instanceSrvIndex, const
 
 	// 描画(DrawCall)
 	dxUtility->GetCommandList()->DrawIndexedInstanced(36, instanceCount, 0, 0, 0);
+
+	// 描画の統計を数える
+	FrameCounters::GetInstance()->CountDraw(instanceCount, 3);
 }
 
 void CubeRenderer::GenerateVertexData() {
@@ -35,7 +35,8 @@ namespace Engine {
 		/// <summary>
 		/// 更新
 		/// </summary>
-		virtual void Update() = 0;
+		/// <param name="deltaTime">経過時間(秒)</param>
+		virtual void Update(float deltaTime) = 0;
 
 		/// <summary>
 		/// 描画
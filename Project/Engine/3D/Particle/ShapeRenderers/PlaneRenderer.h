@@ -13,7 +13,7 @@ namespace Engine {
 
 		void Initialize() override;
 
-		void Update() override;
+		void Update(float deltaTime) override;
 
 		void Draw(uint16_t instanceCount, uint16_t instanceSrvIndex, const std::string& texturePath) override;
 
@@ -3,6 +3,7 @@
 #include "SrvManager.h"
 #include "Texture/TextureManager.h"
 #include "MathMatrix.h"
+#include "FrameCounters.h"
 
 using namespace Engine;
 using namespace MathMatrix;
@@ -28,16 +29,16 @@ void RingRenderer::Initialize() {
 	GenerateMaterialData();
 }
 
-void RingRenderer::Update() {
+void RingRenderer::Update(float deltaTime) {
 
 	for (uint32_t index = 0; index < kRingDivide; ++index) {
 
 		uint32_t vertexIndex = index * 4; // 頂点のインデックス
 
-		vertexData[0 + vertexIndex].texcoord.x += kDeltaTime * kUVSpeed;
-		vertexData[1 + vertexIndex].texcoord.x += kDeltaTime * kUVSpeed;
-		vertexData[2 + vertexIndex].texcoord.x += kDeltaTime * kUVSpeed;
-		vertexData[3 + vertexIndex].texcoord.x += kDeltaTime * kUVSpeed;
+		vertexData[0 + vertexIndex].texcoord.x += deltaTime * kUVSpeed;
+		vertexData[1 + vertexIndex].texcoord.x += deltaTime * kUVSpeed;
+		vertexData[2 + vertexIndex].texcoord.x += deltaTime * kUVSpeed;
+		vertexData[3 + vertexIndex].texcoord.x += deltaTime * kUVSpeed;
 
 		// すべてのtexcoordの値を0.0fから1.0fに収める
 		if (vertexData[0 + vertexIndex].texcoord.x > 1.0f) {
@@ -69,6 +70,9 @@ void RingRenderer::Draw(uint16_t instanceCount, uint16_t instanceSrvIndex, const
 
 	// 描画(DrawCall)
 	dxUtility->GetCommandList()->DrawIndexedInstanced(6 * kRingDivide, instanceCount, 0, 0, 0);
+
+	// 描画の統計を数える
+	FrameCounters::GetInstance()->CountDraw(instanceCount, 3);
 }
 
 void RingRenderer::GenerateVertexData() {
@@ -15,7 +15,7 @@ namespace Engine {
 
 		void Initialize() override;
 
-		void Update() override;
+		void Update(float deltaTime) override;
 
 		void Draw(uint16_t instanceCount, uint16_t instanceSrvIndex, const std::string& texturePath) override;
 
@@ -41,9 +41,6 @@ namespace Engine {
 		const float kInnerRadius = 0.2f; // 内側の半径
 		const float radianPerDivide = 2.0f * std::numbers::pi_v<float> / float(kRingDivide); // 分割あたりのラジアン 2π/分割数
 
-		// Δt
-		const float kDeltaTime = 1.0f / 60.0f;
-
 		// 1秒間のUVの移動量
 		float kUVSpeed = 0.1f; // 10秒で1周
 	};
@@ -3,19 +3,30 @@
 #include "Texture/TextureManager.h"
 #include "MathMatrix.h"
 #include "Camera.h"
+#include "FrameCounters.h"
 
 #include <imgui.h>
 
 using namespace Engine;
 using namespace MathMatrix;
 
+Skybox::~Skybox() {
+
+	// GPUが使い終わるまでリソースを保持する
+	DirectXUtility::SafeRelease(vertexResource);
+	DirectXUtility::SafeRelease(indexResource);
+	DirectXUtility::SafeRelease(transformationResource);
+	DirectXUtility::SafeRelease(materialResource);
+}
+
 void Skybox::Initialize(const std::string relativePath) {
 
 	// TextureManagerからベースディレクトリパスを取得してフルパスを作成
 	std::string fullPath = TextureManager::GetInstance()->GetBaseDirectoryPath() + "/" + relativePath;
 
-	// TextureManagerからSRVインデックスを取得
-	textureSrvIndex = TextureManager::GetInstance()->GetTextureIndexByFilePath(fullPath);
+	// TextureManagerからテクスチャを参照してSRVインデックスを取得
+	textureHandle = TextureManager::GetInstance()->AcquireTexture(fullPath);
+	textureSrvIndex = textureHandle->srvIndex;
 
 	// ワールド変換の初期化
 	worldTransform.Initialize();
@@ -66,6 +77,9 @@ void Skybox::Draw() {
 
 	// 描画(DrawCall)
 	dxUtility_->GetCommandList()->DrawIndexedInstanced(indexCount, 1, 0, 0, 0);
+
+	// 描画の統計を数える
+	FrameCounters::GetInstance()->CountDraw(1, 3);
 }
 
 void Skybox::ShowImGui(const char* name) {
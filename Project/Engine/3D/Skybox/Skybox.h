@@ -5,6 +5,7 @@
 #include "Vector2.h"
 #include "Vector4.h"
 #include "WorldTransform.h"
+#include "Texture/TextureManager.h"
 
 #include <d3d12.h>
 #include <wrl.h>
@@ -24,6 +25,11 @@ namespace Engine {
 		///-------------------------------------------///
 	public:
 
+		/// <summary>
+		/// デストラクタ (GPUが処理中のフレームで使っているリソースは使い終わるまで解放を待つ)
+		/// </summary>
+		~Skybox();
+
 		/// <summary>
 		/// 初期化
 		/// </summary>
@@ -151,6 +157,9 @@ namespace Engine {
 		// テクスチャのSRVインデックス
 		uint32_t textureSrvIndex = 0;
 
+		// テクスチャのハンドル (持っている間はキャッシュから追い出されない)
+		TextureHandle textureHandle;
+
 		// 変換データ
 		WorldTransform worldTransform = {};
 
@@ -0,0 +1,253 @@
+#pragma once
+
+#include "AssetID.h"
+
+#include <algorithm>
+#include <cassert>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine {
+
+	/// === アセットキャッシュ === ///
+	/// アセットIDをキーに参照カウント付きで保持し、予算を超えたら参照されていないものを古い順に追い出す
+	/// メインスレッド専用 (Get、Containsは書き換えないので、メインスレッドが追加や追い出しをしていない間なら他のスレッドから呼べる)
+	template <typename T>
+	class AssetCache {
+
+		///-------------------------------------------/// 
+		/// 構造体
+		///-------------------------------------------///
+	public:
+
+		// 統計
+		struct Stats {
+			uint64_t bytesResident = 0;	// 常駐しているバイト数
+			uint32_t entryCount = 0;	// 常駐しているアセット数
+			uint64_t hitCount = 0;		// 検索がヒットした回数
+			uint64_t missCount = 0;		// 検索が外れた回数
+			uint64_t evictionCount = 0;	// 追い出した回数
+
+			/// <summary>
+			/// ヒット率
+			/// </summary>
+			/// <returns></returns>
+			float GetHitRate() const {
+				uint64_t total = hitCount + missCount;
+				return total ? static_cast<float>(hitCount) / static_cast<float>(total) : 0.0f;
+			}
+		};
+
+	private:
+
+		// 1件分
+		struct Entry {
+			T value;				// アセット本体
+			uint64_t bytes = 0;		// 使用メモリ量
+			uint32_t refCount = 0;	// 参照カウント
+			uint64_t lastUsed = 0;	// 最後に使われた順番
+		};
+
+		///-------------------------------------------/// 
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 検索 (統計とLRUを更新する)
+		/// </summary>
+		/// <param name="id">アセットID</param>
+		/// <returns>見つからなければnullptr</returns>
+		T* Find(AssetID id) {
+
+			auto it = entries_.find(id);
+			if (it == entries_.end()) {
+				++stats_.missCount;
+				return nullptr;
+			}
+
+			++stats_.hitCount;
+			it->second.lastUsed = ++useCounter_;
+			return &it->second.value;
+		}
+
+		/// <summary>
+		/// 取得 (統計もLRUも更新しない)
+		/// </summary>
+		/// <param name="id">アセットID</param>
+		/// <returns>見つからなければnullptr</returns>
+		T* Get(AssetID id) {
+
+			auto it = entries_.find(id);
+			return it != entries_.end() ? &it->second.value : nullptr;
+		}
+
+		/// <summary>
+		/// 取得 (統計もLRUも更新しない)
+		/// </summary>
+		/// <param name="id">アセットID</param>
+		/// <returns>見つからなければnullptr</returns>
+		const T* Get(AssetID id) const {
+
+			auto it = entries_.find(id);
+			return it != entries_.end() ? &it->second.value : nullptr;
+		}
+
+		/// <summary>
+		/// 保持しているか
+		/// </summary>
+		/// <param name="id">アセットID</param>
+		/// <returns></returns>
+		bool Contains(AssetID id) const { return entries_.contains(id); }
+
+		/// <summary>
+		/// 追加
+		/// </summary>
+		/// <param name="id">アセットID</param>
+		/// <param name="value">アセット本体</param>
+		/// <param name="bytes">使用メモリ量</param>
+		/// <returns>追加したアセット</returns>
+		T& Insert(AssetID id, T&& value, uint64_t bytes) {
+
+			assert(!entries_.contains(id));
+
+			Entry& entry = entries_[id];
+			entry.value = std::move(value);
+			entry.bytes = bytes;
+			entry.lastUsed = ++useCounter_;
+
+			stats_.bytesResident += bytes;
+			stats_.entryCount = static_cast<uint32_t>(entries_.size());
+
+			return entry.value;
+		}
+
+		/// <summary>
+		/// 参照カウントを増やす
+		/// </summary>
+		/// <param name="id">アセットID</param>
+		void AddRef(AssetID id) {
+
+			auto it = entries_.find(id);
+			if (it != entries_.end()) {
+				++it->second.refCount;
+				it->second.lastUsed = ++useCounter_;
+			}
+		}
+
+		/// <summary>
+		/// 参照カウントを減らす (0になっても予算を超えるまでは残す)
+		/// </summary>
+		/// <param name="id">アセットID</param>
+		void Release(AssetID id) {
+
+			auto it = entries_.find(id);
+			if (it != entries_.end()) {
+				assert(it->second.refCount > 0);
+				--it->second.refCount;
+			}
+		}
+
+		/// <summary>
+		/// 予算を超えている分を古い順に追い出す
+		/// </summary>
+		/// <param name="onEvict">追い出すアセットを受け取る処理 (T&)</param>
+		template <typename Func>
+		void Trim(Func onEvict) {
+
+			// 予算内なら何もしない
+			if (stats_.bytesResident <= memoryBudget_) return;
+
+			// 参照されていないものを集める
+			std::vector<std::pair<uint64_t, AssetID>> candidates;
+			for (auto& [id, entry] : entries_) {
+				if (entry.refCount == 0) {
+					candidates.emplace_back(entry.lastUsed, id);
+				}
+			}
+
+			// 古い順に並べる
+			std::sort(candidates.begin(), candidates.end());
+
+			// 予算内に収まるまで追い出す
+			for (auto& [lastUsed, id] : candidates) {
+
+				if (stats_.bytesResident <= memoryBudget_) break;
+
+				auto it = entries_.find(id);
+				onEvict(it->second.value);
+				stats_.bytesResident -= it->second.bytes;
+				++stats_.evictionCount;
+				entries_.erase(it);
+			}
+
+			stats_.entryCount = static_cast<uint32_t>(entries_.size());
+		}
+
+		/// <summary>
+		/// 全て破棄する
+		/// </summary>
+		/// <param name="onEvict">破棄するアセットを受け取る処理 (T&)</param>
+		template <typename Func>
+		void Clear(Func onEvict) {
+
+			for (auto& [id, entry] : entries_) {
+				onEvict(entry.value);
+			}
+			entries_.clear();
+
+			stats_.bytesResident = 0;
+			stats_.entryCount = 0;
+		}
+
+		///-------------------------------------------/// 
+		/// ゲッター&セッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 統計のゲッター
+		/// </summary>
+		/// <returns></returns>
+		const Stats& GetStats() const { return stats_; }
+
+		/// <summary>
+		/// 参照カウントのゲッター
+		/// </summary>
+		/// <param name="id">アセットID</param>
+		/// <returns></returns>
+		uint32_t GetRefCount(AssetID id) const {
+			auto it = entries_.find(id);
+			return it != entries_.end() ? it->second.refCount : 0;
+		}
+
+		/// <summary>
+		/// メモリ予算のゲッター
+		/// </summary>
+		/// <returns></returns>
+		uint64_t GetMemoryBudget() const { return memoryBudget_; }
+
+		/// <summary>
+		/// メモリ予算のセッター
+		/// </summary>
+		/// <param name="memoryBudget">バイト数</param>
+		void SetMemoryBudget(uint64_t memoryBudget) { memoryBudget_ = memoryBudget; }
+
+		///-------------------------------------------/// 
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// アセット キー : アセットID
+		std::unordered_map<AssetID, Entry> entries_;
+
+		// 統計
+		Stats stats_;
+
+		// 使われた順番のカウンタ
+		uint64_t useCounter_ = 0;
+
+		// メモリ予算 (バイト)
+		uint64_t memoryBudget_ = UINT64_MAX;
+	};
+}
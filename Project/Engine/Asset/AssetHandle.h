@@ -0,0 +1,116 @@
+#pragma once
+
+#include "AssetCache.h"
+
+#include <memory>
+
+namespace Engine {
+
+	/// === アセットハンドル === ///
+	/// 持っている間は参照カウントが増え、キャッシュから追い出されない
+	/// キャッシュが先に破棄されても安全なようにweak_ptrで持つ
+	template <typename T>
+	class AssetHandle {
+
+		///-------------------------------------------/// 
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		// コンストラクタ
+		AssetHandle() = default;
+
+		// コンストラクタ
+		AssetHandle(const std::shared_ptr<AssetCache<T>>& cache, AssetID id) : cache_(cache), id_(id) {
+			cache->AddRef(id_);
+		}
+
+		// デストラクタ
+		~AssetHandle() { Reset(); }
+
+		// コピーコンストラクタ
+		AssetHandle(const AssetHandle& other) : cache_(other.cache_), id_(other.id_) {
+			if (auto cache = cache_.lock()) cache->AddRef(id_);
+		}
+
+		// コピー代入演算子
+		AssetHandle& operator=(const AssetHandle& other) {
+			if (this != &other) {
+				AssetHandle copy(other);
+				Swap(copy);
+			}
+			return *this;
+		}
+
+		// ムーブコンストラクタ
+		AssetHandle(AssetHandle&& other) noexcept : cache_(std::move(other.cache_)), id_(other.id_) {
+			other.id_ = kInvalidAssetID;
+		}
+
+		// ムーブ代入演算子
+		AssetHandle& operator=(AssetHandle&& other) noexcept {
+			if (this != &other) {
+				Reset();
+				Swap(other);
+			}
+			return *this;
+		}
+
+		/// <summary>
+		/// 参照を手放す
+		/// </summary>
+		void Reset() {
+			if (id_ != kInvalidAssetID) {
+				if (auto cache = cache_.lock()) cache->Release(id_);
+			}
+			cache_.reset();
+			id_ = kInvalidAssetID;
+		}
+
+		/// <summary>
+		/// アセット本体の取得
+		/// </summary>
+		/// <returns>無効ならnullptr</returns>
+		T* Get() const {
+			auto cache = cache_.lock();
+			return cache ? cache->Get(id_) : nullptr;
+		}
+
+		// アロー演算子
+		T* operator->() const { return Get(); }
+
+		// 有効か
+		explicit operator bool() const { return id_ != kInvalidAssetID && !cache_.expired(); }
+
+		/// <summary>
+		/// アセットIDのゲッター
+		/// </summary>
+		/// <returns></returns>
+		AssetID GetID() const { return id_; }
+
+		///-------------------------------------------/// 
+		/// クラス内関数
+		///-------------------------------------------///
+	private:
+
+		/// <summary>
+		/// 中身を入れ替える
+		/// </summary>
+		/// <param name="other"></param>
+		void Swap(AssetHandle& other) noexcept {
+			std::swap(cache_, other.cache_);
+			std::swap(id_, other.id_);
+		}
+
+		///-------------------------------------------/// 
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// 参照しているキャッシュ
+		std::weak_ptr<AssetCache<T>> cache_;
+
+		// アセットID
+		AssetID id_ = kInvalidAssetID;
+	};
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Engine {
+
+	// アセットID (正規化したパスの64bitハッシュ)
+	using AssetID = uint64_t;
+
+	// 無効なアセットID
+	static const AssetID kInvalidAssetID = 0;
+
+	/// === アセットIDの発行と逆引き === ///
+	/// IDはパスから決まるので実行ごとに変わらず、クック済みデータにもそのまま書き込める
+	namespace AssetRegistry {
+
+		/// <summary>
+		/// パスからIDを計算する (登録はしない)
+		/// </summary>
+		/// <param name="path">パス</param>
+		/// <returns>アセットID</returns>
+		AssetID MakeID(std::string_view path);
+
+		/// <summary>
+		/// パスを登録してIDを返す (逆引きできるようになる)
+		/// </summary>
+		/// <param name="path">パス</param>
+		/// <returns>アセットID</returns>
+		AssetID Intern(std::string_view path);
+
+		/// <summary>
+		/// IDからパスを逆引きする
+		/// </summary>
+		/// <param name="id">アセットID</param>
+		/// <returns>パス (未登録なら空文字列)</returns>
+		const std::string& GetPath(AssetID id);
+	};
+}
@@ -0,0 +1,337 @@
+#include "AssetLoader.h"
+#include "Profiler.h"
+#include "Logger.h"
+
+#include <cassert>
+#include <chrono>
+#include <stdexcept>
+#include <imgui.h>
+
+using namespace Engine;
+
+AssetLoader* AssetLoader::instance = nullptr;
+
+AssetLoader* AssetLoader::GetInstance() {
+
+	if (instance == nullptr) {
+		instance = new AssetLoader;
+	}
+	return instance;
+}
+
+void AssetLoader::Initialize(IAssetUploadSink* uploadSink, uint32_t workerCount) {
+
+	// 転送先を設定
+	assert(uploadSink);
+	uploadSink_ = uploadSink;
+
+	// 指定がなければメインスレッドの分を残して論理コア数から決める
+	if (workerCount == 0) {
+		uint32_t hardwareCount = std::thread::hardware_concurrency();
+		workerCount = hardwareCount > 1 ? hardwareCount - 1 : 1;
+
+		// 多すぎてもファイル読み込みで詰まるだけなので上限を設ける
+		if (workerCount > kMaxWorkerCount) workerCount = kMaxWorkerCount;
+	}
+
+	// テクスチャのベースディレクトリパスを取得
+	textureBaseDirectoryPath_ = uploadSink_->GetTextureDirectoryPath();
+
+	// ワーカースレッドを起動
+	for (uint32_t i = 0; i < workerCount; ++i) {
+		workers_.emplace_back(&AssetLoader::WorkerMain, this);
+	}
+}
+
+void AssetLoader::Update() {
+
+	PROFILE_SCOPE("AssetLoader::Update");
+
+	// 描画時に見つからなかったテクスチャ (追い出し済みなど) を読み込み要求にする
+	for (const std::string& filePath : uploadSink_->TakeMissingTextures()) {
+		RequestTexture(filePath);
+	}
+
+	// デコード済みの結果を転送待ちに移す
+	{
+		std::lock_guard<std::mutex> lock(resultMutex_);
+		while (!results_.empty()) {
+			uploads_.push_back(std::move(results_.front()));
+			results_.pop_front();
+		}
+	}
+
+	// 1フレームの上限までまとめて転送する
+	uint32_t uploadCount = 0;
+	size_t count = uploads_.size();
+	for (size_t i = 0; i < count && uploadCount < kMaxUploadsPerFrame; ++i) {
+
+		Result result = std::move(uploads_.front());
+		uploads_.pop_front();
+
+		// デコードに失敗していたら転送せずに失敗を返す (転送しないので上限には数えない)
+		if (!result.error.empty()) {
+			Fail(result.request, result.error);
+			continue;
+		}
+
+		// 転送できたら数える。依存待ちなら後ろに回す
+		if (Upload(result)) {
+			++uploadCount;
+		}
+		else {
+			uploads_.push_back(std::move(result));
+		}
+	}
+}
+
+void AssetLoader::Finalize() {
+
+	// ワーカースレッドに終了を通知
+	{
+		std::lock_guard<std::mutex> lock(requestMutex_);
+		isStopping_ = true;
+	}
+	requestCondition_.notify_all();
+
+	// ワーカースレッドの終了を待つ
+	for (std::thread& worker : workers_) {
+		worker.join();
+	}
+
+	delete instance;
+	instance = nullptr;
+}
+
+void AssetLoader::ShowImGui() {
+
+#ifdef USE_IMGUI
+
+	ImGui::Begin("AssetLoader");
+
+	// ワーカースレッド数
+	ImGui::Text("Workers : %u", static_cast<uint32_t>(workers_.size()));
+
+	// 未完了の要求数
+	ImGui::Text("Pending : %u", pendingCount_.load());
+
+	// 転送待ちの数
+	ImGui::Text("Uploads : %u", static_cast<uint32_t>(uploads_.size()));
+
+	// 転送先の状態 (キャッシュの統計など)
+	uploadSink_->ShowImGui();
+
+	ImGui::End();
+
+#endif // USE_IMGUI
+}
+
+std::shared_future<void> AssetLoader::RequestTexture(const std::string& filePath) {
+
+	// 転送済みなら完了済みのfutureを返す
+	if (uploadSink_->IsTextureLoaded(filePath)) return MakeReadyFuture();
+
+	// 読み込み要求を作成
+	Request request{};
+	request.type = AssetType::Texture;
+	request.key = "Texture:" + filePath;
+	request.filePath = filePath;
+
+	return Enqueue(std::move(request));
+}
+
+std::shared_future<void> AssetLoader::RequestTextureRelative(const std::string& relativePath) {
+
+	// フルパスを生成して要求
+	return RequestTexture(textureBaseDirectoryPath_ + "/" + relativePath);
+}
+
+std::shared_future<void> AssetLoader::RequestModel(const std::string& directoryName, const std::string& fileName) {
+
+	// 転送済みなら完了済みのfutureを返す
+	if (uploadSink_->IsModelLoaded(directoryName, fileName)) return MakeReadyFuture();
+
+	// 読み込み要求を作成
+	Request request{};
+	request.type = AssetType::Model;
+	request.key = "Model:" + directoryName + "/" + fileName;
+	request.directoryName = directoryName;
+	request.fileName = fileName;
+
+	return Enqueue(std::move(request));
+}
+
+void AssetLoader::WaitAll() {
+
+	while (pendingCount_.load() > 0) {
+
+		// 届いている分を転送
+		Update();
+
+		// 全部終わったら抜ける
+		if (pendingCount_.load() == 0) break;
+
+		// 次の結果が届くまで待つ
+		std::unique_lock<std::mutex> lock(resultMutex_);
+		resultCondition_.wait_for(lock, std::chrono::milliseconds(1), [&]() { return !results_.empty(); });
+	}
+}
+
+std::shared_future<void> AssetLoader::Enqueue(Request request) {
+
+	// ワーカースレッドが無いと完了しない
+	assert(!workers_.empty());
+
+	std::shared_future<void> future;
+	{
+		std::lock_guard<std::mutex> lock(requestMutex_);
+
+		// 同じアセットを読み込み中ならそのfutureを返す
+		auto it = inFlight_.find(request.key);
+		if (it != inFlight_.end()) return it->second;
+
+		// 完了通知用のpromiseを作成
+		request.promise = std::make_shared<std::promise<void>>();
+		future = request.promise->get_future().share();
+
+		// 読み込み中として登録してキューに積む
+		inFlight_.emplace(request.key, future);
+		requests_.push_back(std::move(request));
+		++pendingCount_;
+	}
+
+	// ワーカースレッドを起こす
+	requestCondition_.notify_one();
+
+	return future;
+}
+
+void AssetLoader::WorkerMain() {
+
+	// プロファイラにスレッドの名前を登録
+	Profiler::SetThreadName("AssetLoader");
+
+	while (true) {
+
+		Request request;
+		{
+			std::unique_lock<std::mutex> lock(requestMutex_);
+
+			// 要求が来るか終了するまで待つ
+			requestCondition_.wait(lock, [&]() { return isStopping_ || !requests_.empty(); });
+
+			// 終了なら抜ける
+			if (isStopping_) break;
+
+			// 要求を取り出す
+			request = std::move(requests_.front());
+			requests_.pop_front();
+		}
+
+		// デコード
+		Result result = Decode(std::move(request));
+
+		// 結果を積む
+		{
+			std::lock_guard<std::mutex> lock(resultMutex_);
+			results_.push_back(std::move(result));
+		}
+		resultCondition_.notify_one();
+	}
+}
+
+AssetLoader::Result AssetLoader::Decode(Request request) {
+
+	Result result{};
+
+	if (request.type == AssetType::Texture) {
+
+		// テクスチャをデコード
+		result.texture = uploadSink_->DecodeTexture(request.filePath);
+		if (!result.texture) {
+			result.error = "Failed to decode texture " + request.filePath;
+		}
+	}
+	else {
+
+		// モデルデータをデコード
+		result.modelData = uploadSink_->DecodeModel(request.directoryName, request.fileName);
+		if (!result.modelData) {
+			result.error = "Failed to decode model " + request.directoryName + "/" + request.fileName;
+		}
+	}
+
+	result.request = std::move(request);
+
+	return result;
+}
+
+bool AssetLoader::Upload(Result& result) {
+
+	if (result.request.type == AssetType::Texture) {
+
+		// テクスチャを転送
+		uploadSink_->UploadTexture(result.request.filePath, *result.texture);
+	}
+	else {
+
+		// モデルが使うテクスチャがまだなら先に要求して待つ
+		const std::string& textureFilePath = result.modelData->material.textureFilePath;
+		if (!textureFilePath.empty() && !uploadSink_->IsTextureLoaded(textureFilePath)) {
+
+			if (!result.textureFuture.valid()) {
+				result.textureFuture = RequestTexture(textureFilePath);
+			}
+
+			// 読み込みが終わるまで待つ (失敗していたらテクスチャ無しで転送する。描画時は代わりのテクスチャになる)
+			if (result.textureFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+				return false;
+			}
+		}
+
+		// モデルを転送
+		uploadSink_->UploadModel(result.request.directoryName, result.request.fileName, std::move(result.modelData));
+	}
+
+	// 完了
+	Complete(result.request);
+
+	return true;
+}
+
+void AssetLoader::Complete(Request& request) {
+
+	// 待っている側に通知
+	request.promise->set_value();
+
+	// 読み込み中から外す
+	{
+		std::lock_guard<std::mutex> lock(requestMutex_);
+		inFlight_.erase(request.key);
+	}
+
+	--pendingCount_;
+}
+
+void AssetLoader::Fail(Request& request, const std::string& error) {
+
+	LOG_WARNING("AssetLoader::Fail: {}\n", error);
+
+	// 待っている側に例外で通知
+	request.promise->set_exception(std::make_exception_ptr(std::runtime_error(error)));
+
+	// 読み込み中から外す (次に要求されたら読み直す)
+	{
+		std::lock_guard<std::mutex> lock(requestMutex_);
+		inFlight_.erase(request.key);
+	}
+
+	--pendingCount_;
+}
+
+std::shared_future<void> AssetLoader::MakeReadyFuture() {
+
+	std::promise<void> promise;
+	promise.set_value();
+	return promise.get_future().share();
+}
@@ -0,0 +1,254 @@
+#pragma once
+
+#include "AssetUploadSink.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine {
+
+	/// === 非同期アセットローダー === ///
+	/// ファイル読み込みとデコードはワーカースレッドで行い、GPUへの転送はメインスレッドのUpdateでまとめて行う
+	/// 要求(Request〜)と転送(Update / WaitAll)はメインスレッドから呼ぶこと
+	/// デコードと転送は転送先(IAssetUploadSink)に任せるので、ローダー自体はWindowsやGPUに依存しない
+	/// 読み込めなかったときは要求のfutureに例外(std::runtime_error)を入れて返す
+	class AssetLoader {
+
+		///-------------------------------------------/// 
+		/// シングルトン
+		///-------------------------------------------///
+	private:
+
+		// インスタンス
+		static AssetLoader* instance;
+
+		// コンストラクタの隠蔽
+		AssetLoader() = default;
+		// デストラクタの隠蔽
+		~AssetLoader() = default;
+		// コピーコンストラクタの封印
+		AssetLoader(AssetLoader&) = delete;
+		// コピー代入演算子の封印
+		AssetLoader& operator=(AssetLoader&) = delete;
+
+		///-------------------------------------------/// 
+		/// 構造体
+		///-------------------------------------------///
+	private:
+
+		// アセットの種類
+		enum class AssetType {
+			Texture,
+			Model,
+		};
+
+		// 読み込み要求
+		struct Request {
+			AssetType type;
+			std::string key;			// 重複判定用のキー
+			std::string filePath;		// テクスチャのフルパス
+			std::string directoryName;	// モデルのディレクトリ名
+			std::string fileName;		// モデルのファイル名
+			std::shared_ptr<std::promise<void>> promise;
+		};
+
+		// デコード結果
+		struct Result {
+			Request request;
+			std::unique_ptr<DecodedTexture> texture;	// テクスチャのデコード結果
+			std::unique_ptr<ModelData> modelData;		// モデルのデコード結果
+			std::shared_future<void> textureFuture;		// モデルが使うテクスチャの読み込み (転送を待つとき)
+			std::string error;							// 失敗したときの内容 (成功したら空)
+		};
+
+		///-------------------------------------------/// 
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// インスタンスの取得
+		/// </summary>
+		/// <returns></returns>
+		static AssetLoader* GetInstance();
+
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="uploadSink">デコードと転送を行う転送先 (Finalizeまで生きていること)</param>
+		/// <param name="workerCount">ワーカースレッド数 (0なら論理コア数から決める)</param>
+		void Initialize(IAssetUploadSink* uploadSink, uint32_t workerCount = 0);
+
+		/// <summary>
+		/// 更新 (描画時に見つからなかったテクスチャを要求し、デコード済みのアセットをまとめて転送する。メインスレッド専用)
+		/// </summary>
+		void Update();
+
+		/// <summary>
+		/// 終了
+		/// </summary>
+		void Finalize();
+
+		/// <summary>
+		/// ImGui表示
+		/// </summary>
+		void ShowImGui();
+
+		/// <summary>
+		/// テクスチャの読み込み要求
+		/// </summary>
+		/// <param name="filePath">フルパス</param>
+		/// <returns>転送が終わったら完了するfuture (読み込めなかったらget()で例外を投げる)</returns>
+		std::shared_future<void> RequestTexture(const std::string& filePath);
+
+		/// <summary>
+		/// 相対パスでテクスチャの読み込み要求
+		/// </summary>
+		/// <param name="relativePath">相対パス</param>
+		/// <returns>転送が終わったら完了するfuture (読み込めなかったらget()で例外を投げる)</returns>
+		std::shared_future<void> RequestTextureRelative(const std::string& relativePath);
+
+		/// <summary>
+		/// モデルの読み込み要求
+		/// </summary>
+		/// <param name="directoryName">ディレクトリ名</param>
+		/// <param name="fileName">ファイル名</param>
+		/// <returns>転送が終わったら完了するfuture (読み込めなかったらget()で例外を投げる)</returns>
+		std::shared_future<void> RequestModel(const std::string& directoryName, const std::string& fileName);
+
+		/// <summary>
+		/// 要求したアセットが全て転送されるまで待つ (メインスレッド専用)
+		/// </summary>
+		void WaitAll();
+
+		///-------------------------------------------/// 
+		/// クラス内関数
+		///-------------------------------------------///
+	private:
+
+		/// <summary>
+		/// 要求を積む (重複していたら既存のfutureを返す)
+		/// </summary>
+		/// <param name="request">読み込み要求</param>
+		/// <returns></returns>
+		std::shared_future<void> Enqueue(Request request);
+
+		/// <summary>
+		/// ワーカースレッドの処理
+		/// </summary>
+		void WorkerMain();
+
+		/// <summary>
+		/// 1件デコードする (ワーカースレッド)
+		/// </summary>
+		/// <param name="request">読み込み要求</param>
+		/// <returns>デコード結果</returns>
+		Result Decode(Request request);
+
+		/// <summary>
+		/// 1件転送する (メインスレッド)
+		/// </summary>
+		/// <param name="result">デコード結果</param>
+		/// <returns>転送できたか (依存待ちならfalse)</returns>
+		bool Upload(Result& result);
+
+		/// <summary>
+		/// 要求の完了処理
+		/// </summary>
+		/// <param name="request">読み込み要求</param>
+		void Complete(Request& request);
+
+		/// <summary>
+		/// 要求の失敗処理 (futureに例外を入れる)
+		/// </summary>
+		/// <param name="request">読み込み要求</param>
+		/// <param name="error">失敗した内容</param>
+		void Fail(Request& request, const std::string& error);
+
+		/// <summary>
+		/// 完了済みのfutureを作る
+		/// </summary>
+		/// <returns></returns>
+		static std::shared_future<void> MakeReadyFuture();
+
+		///-------------------------------------------/// 
+		/// ゲッター&セッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 未完了の要求数のゲッター
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetPendingCount() const { return pendingCount_.load(); }
+
+		/// <summary>
+		/// 全ての要求が完了しているか
+		/// </summary>
+		/// <returns></returns>
+		bool IsIdle() const { return pendingCount_.load() == 0; }
+
+		///-------------------------------------------/// 
+		/// 定数
+		///-------------------------------------------///
+	public:
+
+		// 1フレームで転送する最大数
+		static const uint32_t kMaxUploadsPerFrame = 8;
+
+		// ワーカースレッドの最大数
+		static const uint32_t kMaxWorkerCount = 4;
+
+		///-------------------------------------------/// 
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// ワーカースレッド
+		std::vector<std::thread> workers_;
+
+		// 読み込み要求のキュー
+		std::deque<Request> requests_;
+
+		// 読み込み中の要求 キー : 重複判定用のキー
+		std::unordered_map<std::string, std::shared_future<void>> inFlight_;
+
+		// 要求側の排他制御
+		std::mutex requestMutex_;
+
+		// 要求が積まれたことの通知
+		std::condition_variable requestCondition_;
+
+		// デコード済みの結果
+		std::deque<Result> results_;
+
+		// 結果側の排他制御
+		std::mutex resultMutex_;
+
+		// 結果が積まれたことの通知
+		std::condition_variable resultCondition_;
+
+		// 転送待ちの結果 (メインスレッド専用)
+		std::deque<Result> uploads_;
+
+		// 未完了の要求数
+		std::atomic<uint32_t> pendingCount_ = 0;
+
+		// 終了フラグ
+		bool isStopping_ = false;
+
+		// 転送先
+		IAssetUploadSink* uploadSink_ = nullptr;
+
+		// テクスチャのベースディレクトリパス
+		std::string textureBaseDirectoryPath_;
+	};
+}
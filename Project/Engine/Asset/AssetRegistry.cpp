@@ -0,0 +1,66 @@
+#include "AssetID.h"
+#include "Logger.h"
+
+#include <cassert>
+#include <mutex>
+#include <unordered_map>
+
+using namespace Engine;
+
+namespace {
+
+	// 登録済みのパス キー : アセットID
+	std::unordered_map<AssetID, std::string> paths;
+
+	// 排他制御 (ワーカースレッドからも登録される)
+	std::mutex pathMutex;
+
+	// 見つからなかったとき用
+	const std::string kEmptyPath;
+}
+
+AssetID AssetRegistry::MakeID(std::string_view path) {
+
+	// FNV-1a 64bit (区切り文字は'/'に揃える)
+	uint64_t hash = 14695981039346656037ull;
+	for (char c : path) {
+		if (c == '\\') c = '/';
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 1099511628211ull;
+	}
+
+	// 無効IDとは被らないようにする
+	return hash == kInvalidAssetID ? 1 : hash;
+}
+
+AssetID AssetRegistry::Intern(std::string_view path) {
+
+	AssetID id = MakeID(path);
+
+	// 区切り文字を揃えたパス
+	std::string normalizedPath(path);
+	for (char& c : normalizedPath) {
+		if (c == '\\') c = '/';
+	}
+
+	std::lock_guard<std::mutex> lock(pathMutex);
+
+	// 未登録なら登録
+	auto [it, inserted] = paths.try_emplace(id, normalizedPath);
+
+	// 同じIDで別のパスが登録されていたらハッシュの衝突
+	if (!inserted && it->second != normalizedPath) {
+		LOG_WARNING("AssetRegistry::Intern: Hash collision {} / {}\n", it->second, normalizedPath);
+		assert(0);
+	}
+
+	return id;
+}
+
+const std::string& AssetRegistry::GetPath(AssetID id) {
+
+	std::lock_guard<std::mutex> lock(pathMutex);
+
+	auto it = paths.find(id);
+	return it != paths.end() ? it->second : kEmptyPath;
+}
@@ -0,0 +1,90 @@
+#include "AssetUploadSink.h"
+#include "Texture/TextureManager.h"
+#include "Model/ModelManager.h"
+#include "SrvManager.h"
+
+#include <imgui.h>
+
+using namespace Engine;
+
+namespace {
+
+	/// === WICでデコードしたテクスチャ === ///
+	class WicDecodedTexture : public DecodedTexture {
+	public:
+
+		// ミップマップまで作ったイメージ
+		DirectX::ScratchImage mipImages;
+	};
+}
+
+std::unique_ptr<DecodedTexture> GpuAssetUploadSink::DecodeTexture(const std::string& filePath) {
+
+	// テクスチャをデコード (COMの初期化もここで行われる)
+	std::unique_ptr<WicDecodedTexture> texture = std::make_unique<WicDecodedTexture>();
+	if (FAILED(TextureManager::DecodeTexture(filePath, texture->mipImages))) {
+		return nullptr;
+	}
+	return texture;
+}
+
+std::unique_ptr<ModelData> GpuAssetUploadSink::DecodeModel(const std::string& directoryName, const std::string& fileName) {
+
+	// モデルデータをデコード
+	return ModelManager::GetInstance()->DecodeModelData(directoryName, fileName);
+}
+
+void GpuAssetUploadSink::UploadTexture(const std::string& filePath, DecodedTexture& texture) {
+
+	// テクスチャマネージャに転送を任せる (デコードしたのはこのクラスなので中身はWicDecodedTexture)
+	TextureManager::GetInstance()->UploadTexture(filePath, static_cast<WicDecodedTexture&>(texture).mipImages);
+}
+
+void GpuAssetUploadSink::UploadModel(const std::string& directoryName, const std::string& fileName, std::unique_ptr<ModelData> modelData) {
+
+	// モデルマネージャに登録する
+	ModelManager::GetInstance()->RegisterModelData(directoryName, fileName, std::move(modelData));
+}
+
+bool GpuAssetUploadSink::IsTextureLoaded(const std::string& filePath) const {
+
+	return TextureManager::GetInstance()->IsLoaded(filePath);
+}
+
+bool GpuAssetUploadSink::IsModelLoaded(const std::string& directoryName, const std::string& fileName) const {
+
+	return ModelManager::GetInstance()->IsLoaded(directoryName, fileName);
+}
+
+std::vector<std::string> GpuAssetUploadSink::TakeMissingTextures() {
+
+	return TextureManager::GetInstance()->TakeMissingTextures();
+}
+
+std::string GpuAssetUploadSink::GetTextureDirectoryPath() const {
+
+	return TextureManager::GetInstance()->GetBaseDirectoryPath();
+}
+
+void GpuAssetUploadSink::ShowImGui() {
+
+#ifdef USE_IMGUI
+
+	// キャッシュの統計
+	auto showCacheStats = [](const char* label, const auto& stats) {
+		if (ImGui::TreeNodeEx(label, ImGuiTreeNodeFlags_DefaultOpen)) {
+			ImGui::Text("Resident : %.2f MB (%u assets)", static_cast<double>(stats.bytesResident) / (1024.0 * 1024.0), stats.entryCount);
+			ImGui::Text("HitRate  : %.1f %%", stats.GetHitRate() * 100.0f);
+			ImGui::Text("Evicted  : %llu", stats.evictionCount);
+			ImGui::TreePop();
+		}
+	};
+	showCacheStats("TextureCache", TextureManager::GetInstance()->GetCacheStats());
+	showCacheStats("ModelCache", ModelManager::GetInstance()->GetCacheStats());
+
+	// SRVの使用数
+	const DescriptorAllocator& srvAllocator = SrvManager::GetInstance()->GetAllocator();
+	ImGui::Text("SRV : %u / %u", srvAllocator.GetUsedCount(), srvAllocator.GetCount());
+
+#endif // USE_IMGUI
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "Data/ModelData.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Engine {
+
+	/// === デコード済みのテクスチャ === ///
+	/// 中身は転送先が決める (AssetLoaderはワーカースレッドでデコードしたものを転送先へ受け渡すだけ)
+	class DecodedTexture {
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 仮想デストラクタ
+		/// </summary>
+		virtual ~DecodedTexture() = default;
+	};
+
+	/// === アセットの転送先インターフェース === ///
+	/// デコード(ワーカースレッド)と転送(メインスレッド)をここに任せるので、差し替えればGPU無しでも読み込み経路を動かせる
+	class IAssetUploadSink {
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 仮想デストラクタ
+		/// </summary>
+		virtual ~IAssetUploadSink() = default;
+
+		/// <summary>
+		/// テクスチャのデコード (ワーカースレッドから呼ぶ)
+		/// </summary>
+		/// <param name="filePath">ファイルパス</param>
+		/// <returns>デコード結果 (失敗したらnullptr)</returns>
+		virtual std::unique_ptr<DecodedTexture> DecodeTexture(const std::string& filePath) = 0;
+
+		/// <summary>
+		/// モデルデータのデコード (ワーカースレッドから呼ぶ)
+		/// </summary>
+		/// <param name="directoryName">ディレクトリ名</param>
+		/// <param name="fileName">ファイル名</param>
+		/// <returns>モデルデータ (失敗したらnullptr)</returns>
+		virtual std::unique_ptr<ModelData> DecodeModel(const std::string& directoryName, const std::string& fileName) = 0;
+
+		/// <summary>
+		/// デコード済みのテクスチャを転送
+		/// </summary>
+		/// <param name="filePath">ファイルパス</param>
+		/// <param name="texture">デコード結果</param>
+		virtual void UploadTexture(const std::string& filePath, DecodedTexture& texture) = 0;
+
+		/// <summary>
+		/// デコード済みのモデルデータを転送
+		/// </summary>
+		/// <param name="directoryName">ディレクトリ名</param>
+		/// <param name="fileName">ファイル名</param>
+		/// <param name="modelData">モデルデータ</param>
+		virtual void UploadModel(const std::string& directoryName, const std::string& fileName, std::unique_ptr<ModelData> modelData) = 0;
+
+		/// <summary>
+		/// テクスチャが転送済みか
+		/// </summary>
+		/// <param name="filePath">ファイルパス</param>
+		/// <returns></returns>
+		virtual bool IsTextureLoaded(const std::string& filePath) const = 0;
+
+		/// <summary>
+		/// モデルが転送済みか
+		/// </summary>
+		/// <param name="directoryName">ディレクトリ名</param>
+		/// <param name="fileName">ファイル名</param>
+		/// <returns></returns>
+		virtual bool IsModelLoaded(const std::string& directoryName, const std::string& fileName) const = 0;
+
+		/// <summary>
+		/// 描画時に見つからなかったテクスチャのパスを取り出す (メインスレッド専用)
+		/// </summary>
+		/// <returns></returns>
+		virtual std::vector<std::string> TakeMissingTextures() = 0;
+
+		/// <summary>
+		/// テクスチャのベースディレクトリパスの取得
+		/// </summary>
+		/// <returns></returns>
+		virtual std::string GetTextureDirectoryPath() const = 0;
+
+		/// <summary>
+		/// ImGui表示 (転送先のキャッシュの状態など。無ければ何もしない)
+		/// </summary>
+		virtual void ShowImGui() {}
+	};
+
+	/// === GPUへの転送先 (WICでデコードし、TextureManager / ModelManagerに登録する) === ///
+	class GpuAssetUploadSink : public IAssetUploadSink {
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		std::unique_ptr<DecodedTexture> DecodeTexture(const std::string& filePath) override;
+
+		std::unique_ptr<ModelData> DecodeModel(const std::string& directoryName, const std::string& fileName) override;
+
+		void UploadTexture(const std::string& filePath, DecodedTexture& texture) override;
+
+		void UploadModel(const std::string& directoryName, const std::string& fileName, std::unique_ptr<ModelData> modelData) override;
+
+		bool IsTextureLoaded(const std::string& filePath) const override;
+
+		bool IsModelLoaded(const std::string& directoryName, const std::string& fileName) const override;
+
+		std::vector<std::string> TakeMissingTextures() override;
+
+		std::string GetTextureDirectoryPath() const override;
+
+		void ShowImGui() override;
+	};
+}
@@ -0,0 +1,193 @@
+#include "CommandRecorder.h"
+#include "Profiler.h"
+
+#include <cassert>
+#include <chrono>
+#include <imgui.h>
+
+using namespace Engine;
+
+void CommandRecorder::Initialize(ICommandBackend* backend, uint32_t workerCount) {
+
+	assert(backend);
+
+	// 引数をメンバ変数に設定
+	backend_ = backend;
+
+	// 指定がなければメインスレッドの分を残して論理コア数から決める
+	if (workerCount == 0) {
+		uint32_t hardwareCount = std::thread::hardware_concurrency();
+		workerCount = hardwareCount > 1 ? hardwareCount - 1 : 1;
+
+		// 記録するコマンドリストはフレームに数本なので上限を設ける
+		if (workerCount > kMaxWorkerCount) workerCount = kMaxWorkerCount;
+	}
+
+	// ワーカースレッドを起動
+	for (uint32_t i = 0; i < workerCount; ++i) {
+		workers_.emplace_back(&CommandRecorder::WorkerMain, this);
+	}
+}
+
+void CommandRecorder::Finalize() {
+
+	// ワーカースレッドに終了を通知
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		isStopping_ = true;
+	}
+	startCondition_.notify_all();
+
+	// ワーカースレッドの終了を待つ
+	for (std::thread& worker : workers_) {
+		worker.join();
+	}
+	workers_.clear();
+}
+
+void CommandRecorder::Add(const char* name, std::function<void()> record) {
+
+	// 記録中に追加すると取り出し中の配列が変わるので禁止
+	assert(!isExecuting_ && "記録処理の中から追加はできない");
+
+	tasks_.push_back({ name, std::move(record), 0.0f });
+}
+
+void CommandRecorder::Execute() {
+
+	// 記録処理がなければ何もしない
+	if (tasks_.empty()) {
+		return;
+	}
+
+	// 逐次のコマンドを確定させて、記録するコマンドリストを用意する
+	backend_->BeginParallel(static_cast<uint32_t>(tasks_.size()));
+
+	// ワーカースレッドに記録の開始を通知
+	nextTask_ = 0;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		finishedCount_ = 0;
+		isExecuting_ = true;
+		++generation_;
+	}
+	startCondition_.notify_all();
+
+	// メインスレッドも記録する
+	RunTasks();
+
+	// 全ての記録処理が終わり、ワーカースレッドが取り出しをやめるまで待つ
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		doneCondition_.wait(lock, [this]() {
+			return finishedCount_ == static_cast<uint32_t>(tasks_.size()) && activeWorkerCount_ == 0;
+		});
+		isExecuting_ = false;
+	}
+
+	// 追加した順で送信の列に並べる
+	backend_->EndParallel();
+
+	// 逐次の記録に戻ったコマンドリストにもプロローグを記録して、区間の後も続けて描けるようにする
+	if (prologue_) {
+		prologue_();
+	}
+
+	// 結果を記録して空にする
+	lastStats_.clear();
+	for (const Task& task : tasks_) {
+		lastStats_.push_back({ task.name, task.microseconds });
+	}
+	tasks_.clear();
+}
+
+void CommandRecorder::ShowImGui() {
+
+#ifdef USE_IMGUI
+
+	ImGui::Begin("CommandRecorder");
+
+	ImGui::Text("Workers: %u", GetWorkerCount());
+
+	// 最後に実行した区間のコマンドリストごとの記録時間
+	for (const TaskStats& stats : lastStats_) {
+		ImGui::Text("%s: %.1f us", stats.name.c_str(), stats.microseconds);
+	}
+
+	ImGui::End();
+
+#endif // USE_IMGUI
+}
+
+void CommandRecorder::WorkerMain() {
+
+	// プロファイラにスレッドの名前を登録
+	Profiler::SetThreadName("CommandRecorder");
+
+	// 最後に参加した区間
+	uint64_t joinedGeneration = 0;
+
+	while (true) {
+
+		// 新しい区間の開始か終了を待つ
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			startCondition_.wait(lock, [this, joinedGeneration]() {
+				return isStopping_ || (isExecuting_ && generation_ != joinedGeneration);
+			});
+
+			if (isStopping_) {
+				return;
+			}
+
+			joinedGeneration = generation_;
+			++activeWorkerCount_;
+		}
+
+		// 残っている記録処理を記録する
+		RunTasks();
+
+		// 取り出しをやめたことを通知
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			--activeWorkerCount_;
+		}
+		doneCondition_.notify_one();
+	}
+}
+
+void CommandRecorder::RunTasks() {
+
+	const uint32_t taskCount = static_cast<uint32_t>(tasks_.size());
+
+	while (true) {
+
+		// 次の記録処理を取り出す
+		uint32_t index = nextTask_.fetch_add(1);
+		if (index >= taskCount) {
+			return;
+		}
+
+		Task& task = tasks_[index];
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		PROFILE_SCOPE(task.name);
+
+		// このスレッドの記録先にして、プロローグと記録処理を記録する
+		backend_->BeginList(index);
+		if (prologue_) {
+			prologue_();
+		}
+		task.record();
+		backend_->EndList(index);
+
+		task.microseconds = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+		// 終わった数を数える
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			++finishedCount_;
+		}
+		doneCondition_.notify_one();
+	}
+}
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Engine {
+
+	/// === コマンド記録のバックエンドのインターフェース === ///
+	/// 並列記録の区間でコマンドリストを用意し、記録後に決まった順で送信の列に並べる
+	/// D3D12の代わりに記録するだけの偽物を差し込めば、GPUなしで順番とスレッドの扱いを確認できる
+	class ICommandBackend {
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 仮想デストラクタ
+		/// </summary>
+		virtual ~ICommandBackend() = default;
+
+		/// <summary>
+		/// 並列記録の区間の開始 (メインスレッドから呼ばれる。ここまでの逐次のコマンドを確定させる)
+		/// </summary>
+		/// <param name="listCount">記録するコマンドリストの数</param>
+		virtual void BeginParallel(uint32_t listCount) = 0;
+
+		/// <summary>
+		/// コマンドリストの記録の開始 (記録するスレッドから呼ばれる。このスレッドの記録先にする)
+		/// </summary>
+		/// <param name="listIndex">区間内の番号</param>
+		virtual void BeginList(uint32_t listIndex) = 0;
+
+		/// <summary>
+		/// コマンドリストの記録の終了 (記録したスレッドから呼ばれる)
+		/// </summary>
+		/// <param name="listIndex">区間内の番号</param>
+		virtual void EndList(uint32_t listIndex) = 0;
+
+		/// <summary>
+		/// 並列記録の区間の終了 (メインスレッドから呼ばれる。番号順に送信の列に並べて逐次の記録に戻る)
+		/// </summary>
+		virtual void EndParallel() = 0;
+	};
+
+	/// === コマンドの並列記録 === ///
+	/// 登録した記録処理をワーカースレッドとメインスレッドで分担して別々のコマンドリストに記録し、登録した順で送信する
+	/// 各コマンドリストは前の状態を引き継がないので、最初にプロローグ(レンダーターゲットの設定など)を記録する (区間の後の逐次のコマンドリストにも記録する)
+	/// スレッドの管理と順番だけを扱い、コマンドリストはバックエンドに任せるのでグラフィックスAPIには依存しない
+	class CommandRecorder {
+
+		///-------------------------------------------///
+		/// 構造体
+		///-------------------------------------------///
+	public:
+
+		// 前回の記録の結果
+		struct TaskStats {
+			std::string name;		// 名前
+			float microseconds;		// 記録にかかった時間(マイクロ秒)
+		};
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="backend">バックエンド</param>
+		/// <param name="workerCount">ワーカースレッド数 (0なら論理コア数から決める)</param>
+		void Initialize(ICommandBackend* backend, uint32_t workerCount = 0);
+
+		/// <summary>
+		/// 終了 (ワーカースレッドを止める)
+		/// </summary>
+		void Finalize();
+
+		/// <summary>
+		/// 記録処理の追加 (1つの記録処理が1つのコマンドリストになる)
+		/// </summary>
+		/// <param name="name">名前</param>
+		/// <param name="record">記録処理 (他の記録処理と同時に呼ばれる)</param>
+		void Add(const char* name, std::function<void()> record);
+
+		/// <summary>
+		/// 追加された記録処理を並列に記録し、追加した順で送信の列に並べる (終わるまで戻らない)
+		/// </summary>
+		void Execute();
+
+		/// <summary>
+		/// ImGui表示
+		/// </summary>
+		void ShowImGui();
+
+		///-------------------------------------------///
+		/// クラス内関数
+		///-------------------------------------------///
+	private:
+
+		/// <summary>
+		/// ワーカースレッドの処理
+		/// </summary>
+		void WorkerMain();
+
+		/// <summary>
+		/// 残っている記録処理を取り出して記録する (ワーカースレッドとメインスレッドから呼ばれる)
+		/// </summary>
+		void RunTasks();
+
+		///-------------------------------------------///
+		/// セッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// プロローグのセッター
+		/// </summary>
+		/// <param name="prologue">各コマンドリストの最初に記録する処理</param>
+		void SetListPrologue(std::function<void()> prologue) { prologue_ = std::move(prologue); }
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// ワーカースレッド数の取得
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workers_.size()); }
+
+		/// <summary>
+		/// 前のフレームで記録したコマンドリストの数の取得
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetListCount() const { return static_cast<uint32_t>(lastStats_.size()); }
+
+		/// <summary>
+		/// 前のフレームの記録の結果の取得
+		/// </summary>
+		/// <returns></returns>
+		const std::vector<TaskStats>& GetLastStats() const { return lastStats_; }
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// 記録処理
+		struct Task {
+			const char* name;				// 名前
+			std::function<void()> record;	// 記録処理
+			float microseconds;				// 記録にかかった時間(マイクロ秒)
+		};
+
+		// バックエンド
+		ICommandBackend* backend_ = nullptr;
+
+		// 各コマンドリストの最初に記録する処理
+		std::function<void()> prologue_;
+
+		// 記録処理 (Executeの間は追加しない)
+		std::vector<Task> tasks_;
+
+		// 次に取り出す記録処理の番号
+		std::atomic<uint32_t> nextTask_ = 0;
+
+		// ワーカースレッド
+		std::vector<std::thread> workers_;
+
+		// 状態を守るミューテックス
+		std::mutex mutex_;
+
+		// 記録の開始を知らせる
+		std::condition_variable startCondition_;
+
+		// 記録の完了を知らせる
+		std::condition_variable doneCondition_;
+
+		// Executeの通し番号 (ワーカースレッドが同じ区間に2回参加しないようにする)
+		uint64_t generation_ = 0;
+
+		// 記録中か (終わった区間に遅れて起きたワーカースレッドを参加させない)
+		bool isExecuting_ = false;
+
+		// 終わった記録処理の数
+		uint32_t finishedCount_ = 0;
+
+		// 記録処理を取り出しているワーカースレッドの数
+		uint32_t activeWorkerCount_ = 0;
+
+		// 終了中か
+		bool isStopping_ = false;
+
+		// 前のフレームの記録の結果
+		std::vector<TaskStats> lastStats_;
+
+		///-------------------------------------------///
+		/// 定数
+		///-------------------------------------------///
+	public:
+
+		// ワーカースレッド数の上限 (記録するコマンドリストの数より多くても使われない)
+		static const uint32_t kMaxWorkerCount = 4;
+	};
+}
@@ -0,0 +1,166 @@
+#include "D3D12CommandBackend.h"
+
+#include <cassert>
+
+using namespace Engine;
+using namespace Microsoft::WRL;
+
+namespace {
+
+	// このスレッドの記録先 (並列記録中だけ設定される)
+	thread_local ID3D12GraphicsCommandList* threadCommandList = nullptr;
+}
+
+void D3D12CommandBackend::Initialize(ID3D12Device* device, uint32_t frameCount) {
+
+	assert(device);
+	assert(frameCount > 0);
+
+	// 引数をメンバ変数に設定
+	device_ = device;
+
+	// フレームコンテキストごとのプールを用意
+	framePools_.resize(frameCount);
+}
+
+void D3D12CommandBackend::Finalize() {
+
+	// 記録先を外す
+	current_ = nullptr;
+	parallelContexts_.clear();
+	submitOrder_.clear();
+
+	// プールを解放
+	framePools_.clear();
+	device_ = nullptr;
+}
+
+void D3D12CommandBackend::BeginFrame(uint32_t frameIndex) {
+
+	assert(frameIndex < framePools_.size());
+
+	// このフレームコンテキストのプールを先頭から使い直す
+	frameIndex_ = frameIndex;
+	usedCount_ = 0;
+	submitOrder_.clear();
+
+	// 逐次の記録先を用意
+	current_ = Acquire();
+}
+
+void D3D12CommandBackend::Submit(ID3D12CommandQueue* commandQueue) {
+
+	assert(current_ && "フレームの記録が始まっていない");
+	assert(parallelContexts_.empty() && "並列記録の区間の途中で送信はできない");
+
+	// ----------今のコマンドリストを確定----------
+	HRESULT hr = current_->commandList->Close();
+	assert(SUCCEEDED(hr));
+	submitOrder_.push_back(current_->commandList.Get());
+	current_ = nullptr;
+
+	// ----------記録した順にまとめて送信----------
+	commandQueue->ExecuteCommandLists(static_cast<UINT>(submitOrder_.size()), submitOrder_.data());
+
+	submittedListCount_ = static_cast<uint32_t>(submitOrder_.size());
+	submitOrder_.clear();
+}
+
+void D3D12CommandBackend::BeginParallel(uint32_t listCount) {
+
+	assert(current_ && "フレームの記録が始まっていない");
+	assert(parallelContexts_.empty() && "並列記録の区間は入れ子にできない");
+
+	// ----------ここまでの逐次のコマンドを確定----------
+	HRESULT hr = current_->commandList->Close();
+	assert(SUCCEEDED(hr));
+	submitOrder_.push_back(current_->commandList.Get());
+	current_ = nullptr;
+
+	// ----------記録先を用意----------
+	// デバイスとプールはメインスレッドだけで触るので、ここで全て取り出しておく
+	for (uint32_t i = 0; i < listCount; ++i) {
+		parallelContexts_.push_back(Acquire());
+	}
+}
+
+void D3D12CommandBackend::BeginList(uint32_t listIndex) {
+
+	assert(listIndex < parallelContexts_.size());
+
+	// このスレッドの記録先にする
+	threadCommandList = parallelContexts_[listIndex]->commandList.Get();
+}
+
+void D3D12CommandBackend::EndList(uint32_t listIndex) {
+
+	assert(listIndex < parallelContexts_.size());
+
+	// 記録したスレッドで確定させる
+	HRESULT hr = parallelContexts_[listIndex]->commandList->Close();
+	assert(SUCCEEDED(hr));
+
+	// 記録先を外す
+	threadCommandList = nullptr;
+}
+
+void D3D12CommandBackend::EndParallel() {
+
+	// ----------区間内の番号順に並べる----------
+	// どのスレッドが先に終わっても送信の順番は変わらない
+	for (CommandContext* context : parallelContexts_) {
+		submitOrder_.push_back(context->commandList.Get());
+	}
+	parallelContexts_.clear();
+
+	// ----------逐次の記録に戻る----------
+	current_ = Acquire();
+}
+
+D3D12CommandBackend::CommandContext* D3D12CommandBackend::Acquire() {
+
+	std::vector<std::unique_ptr<CommandContext>>& pool = framePools_[frameIndex_];
+	HRESULT hr;
+
+	// ----------使い回せる組があればリセットして使う----------
+	// BeginFrameの前にGPUがこのフレームコンテキストを使い終わっているのでリセットできる
+	if (usedCount_ < pool.size()) {
+
+		CommandContext* context = pool[usedCount_++].get();
+
+		hr = context->commandAllocator->Reset();
+		assert(SUCCEEDED(hr));
+
+		hr = context->commandList->Reset(context->commandAllocator.Get(), nullptr);
+		assert(SUCCEEDED(hr));
+
+		return context;
+	}
+
+	// ----------足りなければ作る----------
+	std::unique_ptr<CommandContext> context = std::make_unique<CommandContext>();
+
+	hr = device_->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&context->commandAllocator));
+	// コマンドアロケーターの生成がうまくいかなかった
+	assert(SUCCEEDED(hr));
+
+	// 作ったコマンドリストは記録できる状態になっている
+	hr = device_->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, context->commandAllocator.Get(), nullptr, IID_PPV_ARGS(&context->commandList));
+	// コマンドリストの生成がうまくいかなかった
+	assert(SUCCEEDED(hr));
+
+	pool.push_back(std::move(context));
+	usedCount_++;
+
+	return pool.back().get();
+}
+
+ID3D12GraphicsCommandList* D3D12CommandBackend::GetCommandList() const {
+
+	// 並列記録中のスレッドはそのスレッドの記録先
+	if (threadCommandList) {
+		return threadCommandList;
+	}
+
+	return current_ ? current_->commandList.Get() : nullptr;
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "CommandRecorder.h"
+
+#include <d3d12.h>
+#include <wrl.h>
+#include <memory>
+#include <vector>
+
+namespace Engine {
+
+	/// === D3D12のコマンド記録のバックエンド === ///
+	/// コマンドアロケータとコマンドリストの組をフレームコンテキストごとにプールし、使った順にまとめて送信する
+	/// 逐次の記録は「今のコマンドリスト」に積み、並列記録の区間ではスレッドごとに別のコマンドリストを記録先にする
+	/// アロケータはGPUが使い終わったフレームのものだけをリセットして使い回す
+	class D3D12CommandBackend : public ICommandBackend {
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="device">デバイス</param>
+		/// <param name="frameCount">同時に処理するフレームの数</param>
+		void Initialize(ID3D12Device* device, uint32_t frameCount);
+
+		/// <summary>
+		/// 終了
+		/// </summary>
+		void Finalize();
+
+		/// <summary>
+		/// フレームの記録の開始 (GPUがこのフレームコンテキストを使い終わってから呼ぶ)
+		/// </summary>
+		/// <param name="frameIndex">フレームコンテキストの番号</param>
+		void BeginFrame(uint32_t frameIndex);
+
+		/// <summary>
+		/// 今のコマンドリストを確定させ、このフレームで記録したコマンドリストを記録した順に送信する
+		/// </summary>
+		/// <param name="commandQueue">コマンドキュー</param>
+		void Submit(ID3D12CommandQueue* commandQueue);
+
+		/// <summary>
+		/// 並列記録の区間の開始
+		/// </summary>
+		/// <param name="listCount">記録するコマンドリストの数</param>
+		void BeginParallel(uint32_t listCount) override;
+
+		/// <summary>
+		/// コマンドリストの記録の開始
+		/// </summary>
+		/// <param name="listIndex">区間内の番号</param>
+		void BeginList(uint32_t listIndex) override;
+
+		/// <summary>
+		/// コマンドリストの記録の終了
+		/// </summary>
+		/// <param name="listIndex">区間内の番号</param>
+		void EndList(uint32_t listIndex) override;
+
+		/// <summary>
+		/// 並列記録の区間の終了
+		/// </summary>
+		void EndParallel() override;
+
+		///-------------------------------------------///
+		/// クラス内関数
+		///-------------------------------------------///
+	private:
+
+		// コマンドアロケータとコマンドリストの組
+		struct CommandContext {
+			Microsoft::WRL::ComPtr<ID3D12CommandAllocator> commandAllocator;
+			Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList;
+		};
+
+		/// <summary>
+		/// 記録中のフレームのプールから記録できる状態の組を取り出す (足りなければ作る)
+		/// </summary>
+		/// <returns></returns>
+		CommandContext* Acquire();
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// このスレッドの記録先のコマンドリストの取得 (並列記録中でなければ今のコマンドリスト)
+		/// </summary>
+		/// <returns></returns>
+		ID3D12GraphicsCommandList* GetCommandList() const;
+
+		/// <summary>
+		/// 前のフレームで送信したコマンドリストの数の取得
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetSubmittedListCount() const { return submittedListCount_; }
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// デバイス
+		ID3D12Device* device_ = nullptr;
+
+		// フレームコンテキストごとのプール (アドレスが変わらないように個別に確保する)
+		std::vector<std::vector<std::unique_ptr<CommandContext>>> framePools_;
+
+		// 記録中のフレームコンテキストの番号
+		uint32_t frameIndex_ = 0;
+
+		// 記録中のフレームのプールで使った数
+		uint32_t usedCount_ = 0;
+
+		// 逐次の記録先
+		CommandContext* current_ = nullptr;
+
+		// 並列記録の区間の記録先 (区間内の番号順)
+		std::vector<CommandContext*> parallelContexts_;
+
+		// 送信するコマンドリスト (記録した順)
+		std::vector<ID3D12CommandList*> submitOrder_;
+
+		// 前のフレームで送信したコマンドリストの数
+		uint32_t submittedListCount_ = 0;
+	};
+}
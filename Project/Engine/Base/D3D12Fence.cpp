@@ -0,0 +1,55 @@
+#include "D3D12Fence.h"
+
+#include <cassert>
+
+using namespace Engine;
+
+void D3D12Fence::Initialize(ID3D12Device* device, ID3D12CommandQueue* commandQueue) {
+
+	// 引数をメンバ変数に設定
+	this->commandQueue = commandQueue;
+
+	// ----------フェンス生成----------
+	HRESULT hr = device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence));
+	assert(SUCCEEDED(hr));
+
+	// FenceのSignalを持つためのイベントを作成する
+	fenceEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+	assert(fenceEvent != nullptr);
+}
+
+void D3D12Fence::Finalize() {
+
+	// イベントを閉じる
+	if (fenceEvent) {
+		CloseHandle(fenceEvent);
+		fenceEvent = nullptr;
+	}
+
+	fence = nullptr;
+	commandQueue = nullptr;
+}
+
+void D3D12Fence::Signal(uint64_t value) {
+
+	// コマンドキューにシグナルを送る
+	HRESULT hr = commandQueue->Signal(fence.Get(), value);
+	assert(SUCCEEDED(hr));
+}
+
+uint64_t D3D12Fence::GetCompletedValue() const {
+
+	return fence->GetCompletedValue();
+}
+
+void D3D12Fence::Wait(uint64_t value) {
+
+	// 既にたどり着いていれば待たない
+	if (value <= fence->GetCompletedValue()) return;
+
+	// 指定したSignalにたどり着いていないので、たどり着くまで待つようにイベントを設定する
+	HRESULT hr = fence->SetEventOnCompletion(value, fenceEvent);
+	assert(SUCCEEDED(hr));
+	// イベント待つ
+	WaitForSingleObject(fenceEvent, INFINITE);
+}
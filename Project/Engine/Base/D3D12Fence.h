@@ -0,0 +1,63 @@
+#pragma once
+
+#include "FrameContext.h"
+
+#include <d3d12.h>
+#include <wrl.h>
+
+namespace Engine {
+
+	/// === D3D12のフェンス === ///
+	/// コマンドキューとフェンスをまとめ、フレームコンテキストから使えるようにする
+	class D3D12Fence : public IFence {
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="device">デバイス</param>
+		/// <param name="commandQueue">シグナルを送るコマンドキュー</param>
+		void Initialize(ID3D12Device* device, ID3D12CommandQueue* commandQueue);
+
+		/// <summary>
+		/// 終了
+		/// </summary>
+		void Finalize();
+
+		/// <summary>
+		/// コマンドキューの処理がここまで終わったら値を書き込むよう依頼する
+		/// </summary>
+		/// <param name="value">書き込む値</param>
+		void Signal(uint64_t value) override;
+
+		/// <summary>
+		/// 完了済みの値の取得
+		/// </summary>
+		/// <returns></returns>
+		uint64_t GetCompletedValue() const override;
+
+		/// <summary>
+		/// 値が書き込まれるまで待つ
+		/// </summary>
+		/// <param name="value">待つ値</param>
+		void Wait(uint64_t value) override;
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// フェンス
+		Microsoft::WRL::ComPtr<ID3D12Fence> fence = nullptr;
+
+		// コマンドキュー
+		Microsoft::WRL::ComPtr<ID3D12CommandQueue> commandQueue = nullptr;
+
+		// フェンスイベント
+		HANDLE fenceEvent = nullptr;
+	};
+}
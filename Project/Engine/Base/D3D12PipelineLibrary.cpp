@@ -0,0 +1,106 @@
+#include "D3D12PipelineLibrary.h"
+#include "ShaderCache.h"
+#include "Logger.h"
+
+#include <cassert>
+#include <chrono>
+#include <format>
+
+using namespace Engine;
+using namespace Microsoft::WRL;
+
+void D3D12PipelineLibrary::Initialize(ID3D12Device* device, const std::filesystem::path& filePath) {
+
+	assert(device);
+
+	// 引数をメンバ変数に設定
+	device_ = device;
+	filePath_ = filePath;
+
+	// パイプラインライブラリはID3D12Device1から使える
+	ComPtr<ID3D12Device1> device1 = nullptr;
+	if (FAILED(device_->QueryInterface(IID_PPV_ARGS(&device1)))) {
+		return;
+	}
+
+	// ----------前回書き出したライブラリを読み込む----------
+	if (ShaderCache::ReadFile(filePath_, fileData_) && !fileData_.empty()) {
+
+		HRESULT hr = device1->CreatePipelineLibrary(fileData_.data(), fileData_.size(), IID_PPV_ARGS(&library_));
+
+		// ドライバやGPUが変わった、または壊れていれば使わない (全て作り直して書き出す)
+		if (FAILED(hr)) {
+			LOG_WARNING("PipelineLibrary: discarded {} (hr = {:#010x})\n", filePath_.string(), static_cast<uint32_t>(hr));
+			library_ = nullptr;
+			fileData_.clear();
+		}
+	}
+}
+
+void D3D12PipelineLibrary::Finalize() {
+
+	// ----------ライブラリになかったものがあれば書き出す----------
+	ComPtr<ID3D12Device1> device1 = nullptr;
+	if (isDirty_ && device_ && SUCCEEDED(device_->QueryInterface(IID_PPV_ARGS(&device1)))) {
+
+		// 今回使ったものだけで空から作り直す
+		ComPtr<ID3D12PipelineLibrary> library = nullptr;
+		HRESULT hr = device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&library));
+
+		if (SUCCEEDED(hr)) {
+
+			for (const auto& [name, pipelineState] : usedPipelines_) {
+				// 同じ名前は同じ設定なので2つ目以降は失敗しても問題ない
+				library->StorePipeline(name.c_str(), pipelineState.Get());
+			}
+
+			std::vector<uint8_t> data(library->GetSerializedSize());
+			hr = library->Serialize(data.data(), data.size());
+
+			if (SUCCEEDED(hr)) {
+				ShaderCache::WriteFile(filePath_, data.data(), data.size());
+			}
+		}
+	}
+
+	// ライブラリを解放してから参照していた中身を解放する
+	usedPipelines_.clear();
+	library_ = nullptr;
+	fileData_.clear();
+	device_ = nullptr;
+	isDirty_ = false;
+}
+
+ComPtr<ID3D12PipelineState> D3D12PipelineLibrary::CreateGraphicsPipeline(uint64_t key, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc) {
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	ComPtr<ID3D12PipelineState> pipelineState = nullptr;
+	HRESULT hr;
+
+	// キーを16進数にして名前にする
+	std::wstring name = std::format(L"{:016X}", key);
+
+	// ----------ライブラリから読み込む----------
+	// 同じ名前でも設定が違えば失敗するので作り直す
+	if (library_ && SUCCEEDED(library_->LoadGraphicsPipeline(name.c_str(), &desc, IID_PPV_ARGS(&pipelineState)))) {
+		stats_.hitCount++;
+	}
+	else {
+
+		// ----------なければ作る----------
+		hr = device_->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&pipelineState));
+		assert(SUCCEEDED(hr));
+
+		// 終了時に書き出し直す
+		isDirty_ = true;
+		stats_.missCount++;
+	}
+
+	// 書き出すときのために記録する
+	usedPipelines_.emplace_back(std::move(name), pipelineState);
+
+	stats_.milliseconds += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	return pipelineState;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <d3d12.h>
+#include <wrl.h>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Engine {
+
+	/// === D3D12のパイプラインライブラリ === ///
+	/// 作ったパイプラインステートを名前(キー)で登録し、終了時にファイルへ書き出して次回の起動で読み込む
+	/// ドライバやGPUが変わって読めなければ空から作り直す
+	/// 書き出すときは今回使ったものだけで作り直すので、シェーダーを書き換えた古いものは残らない
+	class D3D12PipelineLibrary {
+
+		///-------------------------------------------///
+		/// 構造体
+		///-------------------------------------------///
+	public:
+
+		// 統計
+		struct Stats {
+			uint32_t hitCount = 0;			// ライブラリから読めた数
+			uint32_t missCount = 0;			// 作り直した数
+			float milliseconds = 0.0f;		// パイプラインステートの用意にかかった時間の合計(ミリ秒)
+		};
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 初期化 (ファイルがあれば読み込む)
+		/// </summary>
+		/// <param name="device">デバイス</param>
+		/// <param name="filePath">ライブラリのファイルパス</param>
+		void Initialize(ID3D12Device* device, const std::filesystem::path& filePath);
+
+		/// <summary>
+		/// 終了 (ライブラリになかったものがあれば、今回使ったものだけでファイルに書き出す)
+		/// </summary>
+		void Finalize();
+
+		/// <summary>
+		/// グラフィックスパイプラインステートの生成 (ライブラリにあれば読み込み、なければ作って登録する)
+		/// </summary>
+		/// <param name="key">設定とシェーダーから作ったキー</param>
+		/// <param name="desc">パイプラインステートの設定</param>
+		/// <returns></returns>
+		Microsoft::WRL::ComPtr<ID3D12PipelineState> CreateGraphicsPipeline(uint64_t key, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc);
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 統計の取得
+		/// </summary>
+		/// <returns></returns>
+		const Stats& GetStats() const { return stats_; }
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// デバイス (ID3D12Device1が取れなければライブラリを使わない)
+		Microsoft::WRL::ComPtr<ID3D12Device> device_ = nullptr;
+
+		// パイプラインライブラリ
+		Microsoft::WRL::ComPtr<ID3D12PipelineLibrary> library_ = nullptr;
+
+		// 読み込んだファイルの中身 (ライブラリが参照するので解放まで保持する)
+		std::vector<uint8_t> fileData_;
+
+		// ライブラリのファイルパス
+		std::filesystem::path filePath_;
+
+		// 今回使ったパイプラインステート 名前 : パイプラインステート
+		std::vector<std::pair<std::wstring, Microsoft::WRL::ComPtr<ID3D12PipelineState>>> usedPipelines_;
+
+		// ライブラリになかったものがあるか
+		bool isDirty_ = false;
+
+		// 統計
+		Stats stats_;
+	};
+}
@@ -0,0 +1,109 @@
+#include "DescriptorAllocator.h"
+#include "FrameCounters.h"
+
+#include <cassert>
+
+using namespace Engine;
+
+void DescriptorAllocator::Initialize(uint32_t count, FrameContext* frameContext, uint32_t transientCountPerFrame) {
+
+	// 一時領域を使うならフレームコンテキストが必要
+	assert(frameContext || transientCountPerFrame == 0);
+
+	// 引数をメンバ変数に設定
+	count_ = count;
+	frameContext_ = frameContext;
+	transientCountPerFrame_ = transientCountPerFrame;
+	transientFenceValue_ = 0;
+	transientUsed_ = 0;
+
+	// 世代は1から始める (0は空のハンドル)
+	generations_.assign(count_, 1);
+	freeIndices_.clear();
+	useIndex_ = 0;
+}
+
+DescriptorHandle DescriptorAllocator::Allocate() {
+
+	uint32_t index = 0;
+
+	// 解放された番号があればそれを再利用
+	if (!freeIndices_.empty()) {
+		index = freeIndices_.back();
+		freeIndices_.pop_back();
+	}
+	// 上限に達していなければ新しい番号を使う
+	else if (useIndex_ < count_) {
+		index = useIndex_;
+		useIndex_++;
+	}
+	// 空きがない
+	else {
+		return DescriptorHandle{};
+	}
+
+	// 確保した数を数える
+	FrameCounters::GetInstance()->Add(FrameCounters::kDescriptorAllocations);
+
+	return { index, generations_[index] };
+}
+
+void DescriptorAllocator::Free(DescriptorHandle handle) {
+
+	// 解放済みや別の確保で再利用された番号を解放しようとしていないか
+	assert(IsValid(handle));
+	if (!IsValid(handle)) return;
+
+	// 世代を進めて古いハンドルを無効にする (0は飛ばす)
+	uint32_t& generation = generations_[handle.index];
+	generation++;
+	if (generation == 0) {
+		generation = 1;
+	}
+
+	// 再利用できるように積む
+	freeIndices_.push_back(handle.index);
+}
+
+bool DescriptorAllocator::IsValid(DescriptorHandle handle) const {
+
+	// 空のハンドルや範囲外は無効
+	if (handle.IsNull() || useIndex_ <= handle.index) return false;
+
+	// 確保したときの世代と一致しているか
+	return generations_[handle.index] == handle.generation;
+}
+
+uint32_t DescriptorAllocator::AllocateTransient(uint32_t count) {
+
+	// 並列記録中の他のスレッドと同時に進めない
+	std::lock_guard<std::mutex> lock(transientMutex_);
+
+	// 一時領域を使わない
+	if (!frameContext_) return UINT32_MAX;
+
+	// フレームが変わっていたら、そのフレーム用の範囲を最初から使う (前回の使用分はBeginFrameでGPUの完了を待っている)
+	if (transientFenceValue_ != frameContext_->GetCurrentFenceValue()) {
+		transientFenceValue_ = frameContext_->GetCurrentFenceValue();
+		transientUsed_ = 0;
+	}
+
+	// 1フレーム分に収まらなければ確保できない
+	if (count == 0 || transientCountPerFrame_ < transientUsed_ + count) return UINT32_MAX;
+
+	// 常駐領域の後ろに並ぶ記録中のフレーム用の範囲から確保
+	uint32_t index = count_ + transientCountPerFrame_ * frameContext_->GetFrameIndex() + transientUsed_;
+	transientUsed_ += count;
+
+	// 確保した数を数える
+	FrameCounters::GetInstance()->Add(FrameCounters::kDescriptorAllocations, count);
+
+	return index;
+}
+
+uint32_t DescriptorAllocator::GetTotalCount() const {
+
+	// 一時領域はフレームの数だけ並ぶ
+	uint32_t frameCount = frameContext_ ? frameContext_->GetFrameCount() : 0;
+	return count_ + transientCountPerFrame_ * frameCount;
+}
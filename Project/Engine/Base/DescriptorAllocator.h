@@ -0,0 +1,136 @@
+#pragma once
+
+#include "FrameContext.h"
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Engine {
+
+	// デスクリプタのハンドル (世代が一致している間だけ有効)
+	struct DescriptorHandle {
+		uint32_t index = UINT32_MAX;	// ヒープ内の番号
+		uint32_t generation = 0;		// 確保したときの世代 (0は無効)
+
+		/// <summary>
+		/// 空のハンドルか
+		/// </summary>
+		/// <returns></returns>
+		bool IsNull() const { return generation == 0; }
+	};
+
+	/// === デスクリプタアロケータ === ///
+	/// ヒープの番号だけを管理する (グラフィックスAPIには依存しない)
+	/// [常駐領域][一時領域 フレーム0][一時領域 フレーム1]... の順に並べる
+	/// 常駐領域は解放された番号を再利用し、解放のたびに世代を進めるので、解放済みのハンドルを使うと検出できる (メインスレッド専用)
+	/// 一時領域はフレームコンテキストのフレームごとに分け、そのフレームをGPUが使い終わってフレームコンテキストが再び使うときに最初から使い直す (並列記録中の複数のスレッドから確保できる)
+	class DescriptorAllocator {
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="count">常駐領域の番号の数</param>
+		/// <param name="frameContext">一時領域を使い直すタイミングを決めるフレームコンテキスト (一時領域を使わないならnullptr)</param>
+		/// <param name="transientCountPerFrame">1フレーム分の一時領域の番号の数</param>
+		void Initialize(uint32_t count, FrameContext* frameContext = nullptr, uint32_t transientCountPerFrame = 0);
+
+		/// <summary>
+		/// 確保
+		/// </summary>
+		/// <returns>ハンドル (空きがなければ空のハンドル)</returns>
+		DescriptorHandle Allocate();
+
+		/// <summary>
+		/// 解放 (番号は次のAllocateで再利用される)
+		/// </summary>
+		/// <param name="handle">ハンドル</param>
+		void Free(DescriptorHandle handle);
+
+		/// <summary>
+		/// ハンドルが有効か (解放済みや再利用された番号ならfalse)
+		/// </summary>
+		/// <param name="handle">ハンドル</param>
+		/// <returns></returns>
+		bool IsValid(DescriptorHandle handle) const;
+
+		/// <summary>
+		/// 一時領域から記録中のフレーム用に連続した番号を確保する (GPUがそのフレームを使い終わると再利用される。どのスレッドからも呼べる)
+		/// </summary>
+		/// <param name="count">数</param>
+		/// <returns>先頭の番号 (1フレーム分に収まらなければUINT32_MAX)</returns>
+		uint32_t AllocateTransient(uint32_t count = 1);
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 確保できるか
+		/// </summary>
+		/// <returns></returns>
+		bool CanAllocate() const { return useIndex_ < count_ || !freeIndices_.empty(); }
+
+		/// <summary>
+		/// 使用中の数の取得
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetUsedCount() const { return useIndex_ - static_cast<uint32_t>(freeIndices_.size()); }
+
+		/// <summary>
+		/// 常駐領域の番号の数の取得
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetCount() const { return count_; }
+
+		/// <summary>
+		/// 1フレーム分の一時領域の番号の数の取得
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetTransientCountPerFrame() const { return transientCountPerFrame_; }
+
+		/// <summary>
+		/// 一時領域を含めた全体の番号の数の取得 (ヒープの大きさ)
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetTotalCount() const;
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// 常駐領域の番号の数
+		uint32_t count_ = 0;
+
+		// 次に使用する番号
+		uint32_t useIndex_ = 0;
+
+		// 解放されて再利用できる番号
+		std::vector<uint32_t> freeIndices_;
+
+		// 番号ごとの世代
+		std::vector<uint32_t> generations_;
+
+		// フレームコンテキスト
+		FrameContext* frameContext_ = nullptr;
+
+		// 1フレーム分の一時領域の番号の数
+		uint32_t transientCountPerFrame_ = 0;
+
+		// 一時領域を集計中のフレームのフェンス値
+		uint64_t transientFenceValue_ = 0;
+
+		// 記録中のフレームで使用中の一時領域の数
+		uint32_t transientUsed_ = 0;
+
+		// 一時領域の確保を守るミューテックス (コマンドの並列記録中は複数のスレッドから確保される)
+		std::mutex transientMutex_;
+	};
+}
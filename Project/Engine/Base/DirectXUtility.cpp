@@ -1,11 +1,11 @@
 #include "DirectXUtility.h"
 #include "Logger.h"
 #include "StringUtility.h"
+#include "Profiler.h"
+#include "FrameCounters.h"
 #include "d3dx12.h"
 
 #include <cassert>
-#include <format>
-#include <thread>
 #include <vector>
 
 #pragma comment(lib,"d3d12.lib")
@@ -20,8 +20,8 @@ using namespace StringUtility;
 
 void DirectXUtility::Initialize() {
 
-	// FPS固定初期化
-	InitializeFixFPS();
+	// フレームの間隔の調整の初期化
+	framePacer.Initialize(framePacer.kDefaultFrameRate);
 
 	// デバイスの初期化
 	DeviceInitialize();
@@ -32,45 +32,93 @@ void DirectXUtility::Initialize() {
 	// フェンスの初期化
 	FenceInitialize();
 
+	// アップロードリングの初期化
+	UploadRingInitialize();
+
 	// DXCコンパイラの生成
 	DXCCompilerGenerate();
-}
 
-void DirectXUtility::PostDraw() {
+	// シェーダーとパイプラインのキャッシュの初期化
+	PipelineCacheInitialize();
+}
 
-	// ----------Fenceの値を更新----------
-	fenceValue++;
+void DirectXUtility::EndFrame() {
 
 	// ----------コマンドキューにシグナルを送る----------
-	commandQueue->Signal(fence.Get(), fenceValue);
+	// 送信したフレームの完了はここでは待たず、同じフレームコンテキストを再び使うときに待つ
+	frameContext.EndFrame();
+}
 
-	// ----------コマンド完了待ち----------
-	// Fenceの値が指定したSignal値にたどり着いているか確認する
-	// GetCompletedValueの初期値はFence作成時に渡した初期値
-	if (fence->GetCompletedValue() < fenceValue) {
+void DirectXUtility::BeginFrame() {
 
-		// 指定したSignalにたどり着いていないので、たどり着くまで待つようにイベントを設定する
-		fence->SetEventOnCompletion(fenceValue, fenceEvent);
-		// イベント待つ
-		WaitForSingleObject(fenceEvent, INFINITE);
+	// ----------次のフレームコンテキストへ----------
+	// kFrameCount前のフレームのGPUの処理が終わっていなければ待つ (終わっていればそのフレームの解放処理を実行する)
+	// 他のスレッドが解放処理を登録していても登録先のフレームが途中で変わらないように、切り替える間はロックする
+	uint32_t frameIndex = 0;
+	{
+		std::lock_guard<std::mutex> lock(deferReleaseMutex);
+		frameIndex = frameContext.BeginFrame();
 	}
 
-	// FPS固定更新
-	UpdateFixFPS();
+	// ----------コマンドアロケータとコマンドリストのリセット----------
+	// このフレームコンテキストのプールを使い回す
+	commandBackend.BeginFrame(frameIndex);
+}
 
-	// ----------コマンドアロケータのリセット----------
-	hr = commandAllocator->Reset();
-	assert(SUCCEEDED(hr));
+void DirectXUtility::ExecuteCommandLists() {
 
-	// ----------コマンドリストのリセット----------
-	hr = commandList->Reset(commandAllocator.Get(), nullptr);
-	assert(SUCCEEDED(hr));
+	// ----------GPUコマンドの実行----------
+	// 並列に記録したものも含めて記録した順にまとめて送信する
+	commandBackend.Submit(commandQueue.Get());
+}
+
+void DirectXUtility::WaitIdle() {
+
+	// 送信済みのフレームが全て終わるまで待つ
+	frameContext.WaitIdle();
+}
+
+void DirectXUtility::DeferRelease(std::function<void()> release) {
+
+	// 並列記録中の他のスレッドと同時に登録しない
+	std::lock_guard<std::mutex> lock(deferReleaseMutex);
+
+	// 記録中のフレームの完了後に実行する
+	frameContext.DeferRelease(std::move(release));
+}
+
+void DirectXUtility::SafeRelease(Microsoft::WRL::ComPtr<ID3D12Resource>& resource) {
+
+	// リソースがなければ何もしない
+	if (!resource) return;
+
+	// 終了済みならGPUは止まっているのでその場で解放する
+	if (instance == nullptr) {
+		resource = nullptr;
+		return;
+	}
+
+	// GPUが使い終わるまで参照を保持する
+	instance->DeferRelease([resource = std::move(resource)]() {});
 }
 
 void DirectXUtility::Finalize() {
 
+	// ワーカースレッドを止める
+	commandRecorder.Finalize();
+
+	// 今回作ったパイプラインステートを次回のために書き出す
+	pipelineLibrary.Finalize();
+
+	// GPUの処理を待ってから保留中の解放処理を全て実行
+	frameContext.Finalize();
+
+	// コマンドアロケータとコマンドリストの解放
+	commandBackend.Finalize();
+
 	// 各オブジェクトの解放
-	CloseHandle(fenceEvent);
+	uploadRingResource = nullptr;
+	fence.Finalize();
 
 	delete instance;
 	instance = nullptr;
@@ -90,9 +138,34 @@ Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> DirectXUtility::CreateDescriptorHea
 
 Microsoft::WRL::ComPtr<IDxcBlob> DirectXUtility::CompileShader(const std::wstring& filePath, const wchar_t* profile) {
 	
+	// コンパイルオプション
+	std::vector<std::wstring> arguments = {
+		filePath, // コンパイル対象のhlslファイル名
+		L"-E",L"main", // エントリーポイントの指定。基本的にmain以外にはしない
+		L"-T",profile, // ShaderProfileの設定
+		L"-Zi",L"-Qembed_debug", // デバッグ用の情報を埋め込む
+		L"-Od",   // 最適化を外しておく
+		L"-Zpr",  // メモリレイアウトは行優先
+	};
+
+	// 0.キャッシュにあればコンパイルしない
+	// ソースとインクルードしたファイルの内容、プロファイル、オプションからキーを作る
+	uint64_t cacheKey = shaderCache.MakeKey(filePath, profile, arguments);
+	std::vector<uint8_t> cachedData;
+	if (shaderCache.Load(cacheKey, cachedData)) {
+		// 読み込んだバイナリをBlobにして返す
+		ComPtr <IDxcBlobEncoding> cachedBlob = nullptr;
+		HRESULT hr = dxcUtils->CreateBlob(cachedData.data(), static_cast<UINT32>(cachedData.size()), DXC_CP_ACP, &cachedBlob);
+		assert(SUCCEEDED(hr));
+		return cachedBlob;
+	}
+
+	// コンパイルにかかった時間を計る
+	std::chrono::steady_clock::time_point compileStart = std::chrono::steady_clock::now();
+
 	// 1.hlslファイルを読み込む
 	// これからシェーダをコンパイルする旨をログに出す
-	Logger::Log(StringUtility::ConvertString(std::format(L"Begin CompileShader, path:{}, profile:{}\n", filePath, profile)));
+	LOG_DEBUG("Begin CompileShader, path:{}, profile:{}\n", StringUtility::ConvertString(filePath), StringUtility::ConvertString(profile));
 	// hlslファイルを読む
 	ComPtr <IDxcBlobEncoding> shaderSource = nullptr;
 	HRESULT hr = dxcUtils->LoadFile(filePath.c_str(), nullptr, &shaderSource);
@@ -105,20 +178,16 @@ Microsoft::WRL::ComPtr<IDxcBlob> DirectXUtility::CompileShader(const std::wstrin
 	shaderSourceBuffer.Encoding = DXC_CP_UTF8; // UTF8の文字コードであることを通知
 
 	// 2.Compileする
-	LPCWSTR arguments[] = {
-		filePath.c_str(), // コンパイル対象のhlslファイル名
-		L"-E",L"main", // エントリーポイントの指定。基本的にmain以外にはしない
-		L"-T",profile, // ShaderProfileの設定
-		L"-Zi",L"-Qembed_debug", // デバッグ用の情報を埋め込む
-		L"-Od",   // 最適化を外しておく
-		L"-Zpr",  // メモリレイアウトは行優先
-	};
+	std::vector<LPCWSTR> argumentPointers;
+	for (const std::wstring& argument : arguments) {
+		argumentPointers.push_back(argument.c_str());
+	}
 	// 実際にShaderをコンパイルする
 	ComPtr <IDxcResult> shaderResult = nullptr;
 	hr = dxcCompiler->Compile(
 		&shaderSourceBuffer, // 読み込んだファイル
-		arguments,           // コンパイルオプション
-		_countof(arguments), // コンパイルオプションの数
+		argumentPointers.data(), // コンパイルオプション
+		static_cast<UINT32>(argumentPointers.size()), // コンパイルオプションの数
 		includeHandler.Get(),      // includeが含まれた諸々
 		IID_PPV_ARGS(&shaderResult) // コンパイル結果
 	);
@@ -129,7 +198,7 @@ Microsoft::WRL::ComPtr<IDxcBlob> DirectXUtility::CompileShader(const std::wstrin
 	ComPtr <IDxcBlobUtf8> shaderError = nullptr;
 	shaderResult->GetOutput(DXC_OUT_ERRORS, IID_PPV_ARGS(&shaderError), nullptr);
 	if (shaderError != nullptr && shaderError->GetStringLength() != 0) {
-		Logger::Log(shaderError->GetStringPointer());
+		Logger::Write(Logger::Severity::Error, shaderError->GetStringPointer());
 		// 警告・エラーダメゼッタイ
 		assert(false);
 	}
@@ -140,7 +209,14 @@ Microsoft::WRL::ComPtr<IDxcBlob> DirectXUtility::CompileShader(const std::wstrin
 	hr = shaderResult->GetOutput(DXC_OUT_OBJECT, IID_PPV_ARGS(&shaderBlob), nullptr);
 	assert(SUCCEEDED(hr));
 	// 成功したログを出す
-	Logger::Log(StringUtility::ConvertString(std::format(L"Compile Succeeded, path:{}, profile:{}\n", filePath, profile)));
+	LOG_DEBUG("Compile Succeeded, path:{}, profile:{}\n", StringUtility::ConvertString(filePath), StringUtility::ConvertString(profile));
+	shaderCache.AddCompileMilliseconds(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - compileStart).count());
+
+	// 5.次回のためにキャッシュに保存する (ソースが読めずキーがなければ保存しない)
+	if (cacheKey != 0) {
+		shaderCache.Store(cacheKey, shaderBlob->GetBufferPointer(), shaderBlob->GetBufferSize());
+	}
+
 	// 実行用のバイナリを返却
 	return shaderBlob;
 }
@@ -179,7 +255,7 @@ void DirectXUtility::DeviceInitialize() {
 		// ソフトウェアアダプタでなければ採用!
 		if (!(adapterDesc.Flags & DXGI_ADAPTER_FLAG3_SOFTWARE)) {
 			// 採用したアダプタの情報をログに出力。wstringの方なので注意
-			Logger::Log(StringUtility::ConvertString(std::format(L"Use Adapter:{}\n", adapterDesc.Description)));
+			LOG_INFO("Use Adapter:{}\n", StringUtility::ConvertString(std::wstring(adapterDesc.Description)));
 			break;
 		}
 		useAdapter = nullptr; // ソフトウェアアダプタの場合は見なかったことにする
@@ -200,13 +276,13 @@ void DirectXUtility::DeviceInitialize() {
 		// 指定した機能レベルでデバイスが生成できたかを確認
 		if (SUCCEEDED(hr)) {
 			// 生成できたのでログ出力を行ってループを抜ける
-			Logger::Log(std::format("FeatureLevel : {}\n", featureLevelStrings[i]));
+			LOG_INFO("FeatureLevel : {}\n", featureLevelStrings[i]);
 			break;
 		}
 	}
 	// デバイスの生成がうまくいかなかったので起動できない
 	assert(device != nullptr);
-	Logger::Log("Complete create D3D12Device!!!\n"); //初期化完了のログをだす
+	LOG_INFO("Complete create D3D12Device!!!\n"); //初期化完了のログをだす
 
 	// ----------エラー時にブレークを発生させる設定----------
 #ifdef _DEBUG
@@ -240,15 +316,15 @@ void DirectXUtility::DeviceInitialize() {
 
 void DirectXUtility::CommandRelatedInitialize() {
 
-	// ----------コマンドアロケータ生成----------
-	hr = device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&commandAllocator));
-	// コマンドアロケーターの生成がうまくいかなかったので起動できない
-	assert(SUCCEEDED(hr));
+	// ----------コマンドアロケータとコマンドリスト生成----------
+	// GPUが処理中のフレームのコマンドを上書きしないようにフレームごとにプールする
+	commandBackend.Initialize(device.Get(), kFrameCount);
 
-	// ----------コマンドリスト生成----------
-	hr = device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, commandAllocator.Get(), nullptr, IID_PPV_ARGS(&commandList));
-	// コマンドリストの生成がうまくいかなかったので起動できない
-	assert(SUCCEEDED(hr));
+	// 最初のフレームは0番のプールで記録する
+	commandBackend.BeginFrame(0);
+
+	// ----------コマンドの並列記録の初期化----------
+	commandRecorder.Initialize(&commandBackend);
 
 	// ----------コマンドキュー生成----------
 	D3D12_COMMAND_QUEUE_DESC commandQueueDesc{};
@@ -261,12 +337,24 @@ void DirectXUtility::CommandRelatedInitialize() {
 void DirectXUtility::FenceInitialize() {
 
 	// ----------フェンス生成----------
-	hr = device->CreateFence(fenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence));
+	fence.Initialize(device.Get(), commandQueue.Get());
+
+	// ----------フレームコンテキストの初期化----------
+	frameContext.Initialize(&fence, kFrameCount, kUploadRingSize);
+}
+
+void DirectXUtility::UploadRingInitialize() {
+
+	// ----------アップロードリングのリソース生成----------
+	uploadRingResource = CreateBufferResource(kUploadRingSize);
+
+	// ----------書き込むためのアドレスを取得(開きっぱなしにする)----------
+	uint8_t* mappedData = nullptr;
+	hr = uploadRingResource->Map(0, nullptr, reinterpret_cast<void**>(&mappedData));
 	assert(SUCCEEDED(hr));
 
-	// FenceのSignalを持つためのイベントを作成する
-	fenceEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
-	assert(fenceEvent != nullptr);
+	// ----------アップロードアロケータの初期化----------
+	uploadAllocator.Initialize(&frameContext, mappedData, uploadRingResource->GetGPUVirtualAddress());
 }
 
 void DirectXUtility::DXCCompilerGenerate() {
@@ -285,34 +373,26 @@ void DirectXUtility::DXCCompilerGenerate() {
 	assert(SUCCEEDED(hr));
 }
 
-void DirectXUtility::InitializeFixFPS() {
+void DirectXUtility::PipelineCacheInitialize() {
 
-	// 現在時間を記録する
-	reference = std::chrono::steady_clock::now();
-}
+	// ----------シェーダーキャッシュの初期化----------
+	shaderCache.Initialize(kShaderCacheDirectoryPath);
 
-void DirectXUtility::UpdateFixFPS() {
+	// ----------パイプラインライブラリの初期化----------
+	// ドライバやGPUが変わって読めなければ空から作り直す
+	pipelineLibrary.Initialize(device.Get(), shaderCache.GetDirectory() / kPipelineLibraryFileName);
+}
 
-	// 1/60秒ピッタリの時間
-	const std::chrono::microseconds kMinTime(uint64_t(1000000.0f / 60.0f));
-	// 1/60秒よりわずかに短い時間
-	const std::chrono::microseconds kMinCheckTime(uint64_t(1000000.0f / 65.0f));
+void DirectXUtility::LogPipelineCacheStats() const {
 
-	// 現在時間を取得する
-	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
-	// 前回記録からの経過時間を取得する
-	std::chrono::microseconds elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - reference);
+	const ShaderCache::Stats& shaderStats = shaderCache.GetStats();
+	const D3D12PipelineLibrary::Stats& pipelineStats = pipelineLibrary.GetStats();
 
-	// 1/60秒(よりわずかに短い時間)経っていない場合
-	if (elapsed < kMinCheckTime) {
-		// 1/60秒経過するまで微小なスリープを繰り返す
-		while (std::chrono::steady_clock::now() - reference < kMinTime) {
-			// 1マイクロ秒スリープ
-			std::this_thread::sleep_for(std::chrono::microseconds(1));
-		}
-	}
-	// 現在の時間を記録する
-	reference = std::chrono::steady_clock::now();
+	// 初回起動(キャッシュなし)と2回目以降で比べられるように、数と時間をまとめて出す
+	LOG_INFO("ShaderCache: hit {}, miss {}, load {:.2f}ms, compile {:.2f}ms\n",
+		shaderStats.hitCount, shaderStats.missCount, shaderStats.loadMilliseconds, shaderStats.compileMilliseconds);
+	LOG_INFO("PipelineLibrary: hit {}, miss {}, {:.2f}ms\n",
+		pipelineStats.hitCount, pipelineStats.missCount, pipelineStats.milliseconds);
 }
 
 DirectXUtility* DirectXUtility::instance = nullptr;
@@ -413,8 +493,12 @@ Microsoft::WRL::ComPtr<ID3D12Resource> DirectXUtility::UploadTextureData(Microso
 	uint64_t intermediateSize = GetRequiredIntermediateSize(texture.Get(), 0, UINT(subresources.size()));
 	// 計算したサイズで中間リソースを作成する
 	ComPtr<ID3D12Resource> intermediateResource = CreateBufferResource(intermediateSize);
+	// 書き込むバイト数を数える
+	FrameCounters::GetInstance()->Add(FrameCounters::kUploadBytes, intermediateSize);
+	// このスレッドの記録先のコマンドリスト
+	ID3D12GraphicsCommandList* commandList = commandBackend.GetCommandList();
 	// 中間リソースにサブリソースのデータを書き込み、テクスチャに転送するコマンドを積む
-	UpdateSubresources(commandList.Get(), texture.Get(), intermediateResource.Get(), 0, 0, UINT(subresources.size()), subresources.data());
+	UpdateSubresources(commandList, texture.Get(), intermediateResource.Get(), 0, 0, UINT(subresources.size()), subresources.data());
 
 	// テクスチャへの転送後は利用できるよう、D3D12_RESOURCE_STATE_COPY_DESTからD3D12_RESOURCE_STATE_GENERIC_READへ状態を変更する
 	D3D12_RESOURCE_BARRIER barrier{};
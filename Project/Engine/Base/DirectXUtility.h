@@ -1,6 +1,14 @@
 #pragma once
 
 #include "Vector4.h"
+#include "FrameContext.h"
+#include "D3D12Fence.h"
+#include "UploadAllocator.h"
+#include "D3D12CommandBackend.h"
+#include "CommandRecorder.h"
+#include "ShaderCache.h"
+#include "D3D12PipelineLibrary.h"
+#include "FramePacer.h"
 
 #include <d3d12.h>
 #include <dxgi1_6.h>
@@ -8,6 +16,8 @@
 #include <wrl.h>
 #include <string>
 #include <chrono>
+#include <functional>
+#include <mutex>
 
 #include "DirectXTex.h"
 
@@ -44,9 +54,36 @@ namespace Engine {
 		void Initialize();
 
 		/// <summary>
-		/// 描画後処理
+		/// フレームの終了 (送信したフレームの完了をフェンスに書き込ませる。GPUの完了は待たない)
 		/// </summary>
-		void PostDraw();
+		void EndFrame();
+
+		/// <summary>
+		/// 次のフレームの開始 (フレームコンテキストを進めてコマンドリストの記録を始める)
+		/// </summary>
+		void BeginFrame();
+
+		/// <summary>
+		/// このフレームで記録したコマンドリストを記録した順に送信する (画面の交換の直前に呼ぶ)
+		/// </summary>
+		void ExecuteCommandLists();
+
+		/// <summary>
+		/// GPUに送った処理が全て終わるまで待つ
+		/// </summary>
+		void WaitIdle();
+
+		/// <summary>
+		/// 記録中のフレームをGPUが使い終わったら実行する解放処理を登録する
+		/// </summary>
+		/// <param name="release">解放処理</param>
+		void DeferRelease(std::function<void()> release);
+
+		/// <summary>
+		/// リソースをGPUが使い終わるまで保持してから解放する (終了後はその場で解放する)
+		/// </summary>
+		/// <param name="resource">リソース</param>
+		static void SafeRelease(Microsoft::WRL::ComPtr<ID3D12Resource>& resource);
 
 		/// <summary>
 		/// 終了
@@ -70,6 +107,11 @@ namespace Engine {
 		/// <returns></returns>
 		Microsoft::WRL::ComPtr<IDxcBlob> CompileShader(const std::wstring& filePath, const wchar_t* profile);
 
+		/// <summary>
+		/// シェーダーとパイプラインのキャッシュの統計をログに出す (全てのパイプラインを作った後に呼ぶ)
+		/// </summary>
+		void LogPipelineCacheStats() const;
+
 		///-------------------------------------------/// 
 		/// クラス内関数
 		///-------------------------------------------///
@@ -86,24 +128,24 @@ namespace Engine {
 		void CommandRelatedInitialize();
 
 		/// <summary>
-		/// フェンスの初期化
+		/// フェンスとフレームコンテキストの初期化
 		/// </summary>
 		void FenceInitialize();
 
 		/// <summary>
-		/// DXCコンパイラの生成
+		/// アップロードリングの初期化
 		/// </summary>
-		void DXCCompilerGenerate();
+		void UploadRingInitialize();
 
 		/// <summary>
-		/// FPS固定初期化
+		/// DXCコンパイラの生成
 		/// </summary>
-		void InitializeFixFPS();
+		void DXCCompilerGenerate();
 
 		/// <summary>
-		/// FPS固定更新
+		/// シェーダーとパイプラインのキャッシュの初期化
 		/// </summary>
-		void UpdateFixFPS();
+		void PipelineCacheInitialize();
 
 		///-------------------------------------------/// 
 		/// ゲッター
@@ -123,10 +165,28 @@ namespace Engine {
 		Microsoft::WRL::ComPtr<ID3D12Device> GetDevice() { return device; }
 
 		/// <summary>
-		/// コマンドリストを取得
+		/// コマンドリストを取得 (並列記録中はそのスレッドの記録先)
+		/// </summary>
+		/// <returns></returns>
+		Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> GetCommandList() const { return commandBackend.GetCommandList(); }
+
+		/// <summary>
+		/// コマンドの並列記録の取得
+		/// </summary>
+		/// <returns></returns>
+		CommandRecorder& GetCommandRecorder() { return commandRecorder; }
+
+		/// <summary>
+		/// フレームの間隔の調整の取得
+		/// </summary>
+		/// <returns></returns>
+		FramePacer& GetFramePacer() { return framePacer; }
+
+		/// <summary>
+		/// パイプラインライブラリの取得
 		/// </summary>
 		/// <returns></returns>
-		Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> GetCommandList() const { return commandList; }
+		D3D12PipelineLibrary& GetPipelineLibrary() { return pipelineLibrary; }
 
 		/// <summary>
 		/// コマンドキューを取得
@@ -140,6 +200,31 @@ namespace Engine {
 		/// <returns></returns>
 		Microsoft::WRL::ComPtr<IDXGIFactory7> GetDXGIFactory() { return dxgiFactory; }
 
+		/// <summary>
+		/// フレームコンテキストの取得
+		/// </summary>
+		/// <returns></returns>
+		FrameContext& GetFrameContext() { return frameContext; }
+
+		/// <summary>
+		/// 毎フレームの定数やインスタンスのデータを書き込むアップロードアロケータの取得
+		/// </summary>
+		/// <returns></returns>
+		UploadAllocator& GetUploadAllocator() { return uploadAllocator; }
+
+		/// <summary>
+		/// 記録中のフレームが完了したときのフェンス値の取得
+		/// </summary>
+		/// <returns></returns>
+		uint64_t GetCurrentFenceValue() const { return frameContext.GetCurrentFenceValue(); }
+
+		/// <summary>
+		/// フェンス値までGPUの処理が終わっているか
+		/// </summary>
+		/// <param name="fenceValue">フェンス値</param>
+		/// <returns></returns>
+		bool IsFenceCompleted(uint64_t fenceValue) const { return frameContext.IsCompleted(fenceValue); }
+
 		/// <summary>
 		/// CPUのデスクリプタハンドルを取得する
 		/// </summary>
@@ -199,6 +284,23 @@ namespace Engine {
 		/// <returns></returns>
 		Microsoft::WRL::ComPtr <ID3D12Resource> CreateDepthStencilResource(uint32_t width, uint32_t height, DXGI_FORMAT format, const float clearDepth);
 
+		///-------------------------------------------/// 
+		/// 定数
+		///-------------------------------------------///
+	public:
+
+		// 同時に処理するフレームの数 (スワップチェーンのバッファ数に合わせる)
+		static const uint32_t kFrameCount = 2;
+
+		// アップロードリングのサイズ (GPUが処理中のフレームの分も含めて収まる大きさにする)
+		static const uint64_t kUploadRingSize = 16ull * 1024 * 1024;
+
+		// シェーダーとパイプラインのキャッシュの保存先
+		const std::wstring kShaderCacheDirectoryPath = L"ShaderCache";
+
+		// パイプラインライブラリのファイル名
+		const std::wstring kPipelineLibraryFileName = L"PipelineLibrary.bin";
+
 		///-------------------------------------------/// 
 		/// メンバ変数
 		///-------------------------------------------///
@@ -210,23 +312,29 @@ namespace Engine {
 		// デバイス
 		Microsoft::WRL::ComPtr<ID3D12Device> device = nullptr;
 
-		// コマンドアロケータ
-		Microsoft::WRL::ComPtr<ID3D12CommandAllocator> commandAllocator = nullptr;
+		// コマンドアロケータとコマンドリスト (フレームごとにプールする)
+		D3D12CommandBackend commandBackend;
 
-		// コマンドリスト
-		Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList = nullptr;
+		// コマンドの並列記録
+		CommandRecorder commandRecorder;
 
 		// コマンドキュー
 		Microsoft::WRL::ComPtr<ID3D12CommandQueue> commandQueue = nullptr;
 
 		// フェンス
-		Microsoft::WRL::ComPtr <ID3D12Fence> fence = nullptr;
+		D3D12Fence fence;
+
+		// フレームコンテキスト
+		FrameContext frameContext;
 
-		// フェンスの値
-		uint64_t fenceValue = 0;
+		// 解放処理の登録を守るミューテックス (並列記録中の描画からも登録される)
+		std::mutex deferReleaseMutex;
 
-		// フェンスイベント
-		HANDLE fenceEvent;
+		// アップロードリングのリソース
+		Microsoft::WRL::ComPtr<ID3D12Resource> uploadRingResource = nullptr;
+
+		// アップロードアロケータ
+		UploadAllocator uploadAllocator;
 
 		// DXGIファクトリー
 		Microsoft::WRL::ComPtr<IDXGIFactory7> dxgiFactory = nullptr;
@@ -240,7 +348,13 @@ namespace Engine {
 		// デフォルトインクルードハンドラ
 		Microsoft::WRL::ComPtr<IDxcIncludeHandler> includeHandler = nullptr;
 
-		// 記録時間(FPS固定用)
-		std::chrono::steady_clock::time_point reference;
+		// コンパイル済みシェーダーのキャッシュ
+		ShaderCache shaderCache;
+
+		// パイプラインライブラリ
+		D3D12PipelineLibrary pipelineLibrary;
+
+		// フレームの間隔の調整
+		FramePacer framePacer;
 	};
 }
@@ -0,0 +1,141 @@
+#include "FrameContext.h"
+
+#include <cassert>
+
+using namespace Engine;
+
+void FrameContext::Initialize(IFence* fence, uint32_t frameCount, uint64_t uploadRingSize) {
+
+	assert(fence);
+	assert(frameCount > 0);
+
+	// 引数をメンバ変数に設定
+	fence_ = fence;
+	uploadRingSize_ = uploadRingSize;
+
+	// フレームを用意して0番を記録中にする
+	frames_.assign(frameCount, Frame{});
+	frameIndex_ = 0;
+
+	// フェンスの現在の値の次から使う
+	nextFenceValue_ = fence_->GetCompletedValue() + 1;
+
+	// アップロードリングは空
+	uploadHead_ = 0;
+	uploadUsed_ = 0;
+}
+
+void FrameContext::EndFrame() {
+
+	// 記録中のフレーム
+	Frame& frame = frames_[frameIndex_];
+
+	// ここまでのコマンドが終わったらフェンス値が書き込まれるようにする
+	fence_->Signal(nextFenceValue_);
+	frame.fenceValue = nextFenceValue_;
+	nextFenceValue_++;
+}
+
+uint32_t FrameContext::BeginFrame() {
+
+	// 次のフレームへ
+	frameIndex_ = (frameIndex_ + 1) % GetFrameCount();
+	Frame& frame = frames_[frameIndex_];
+
+	// 前回このフレームを使ったときのGPUの処理が終わっていなければ待つ (他のフレームとは重ねて処理できる)
+	if (frame.fenceValue != 0 && !IsCompleted(frame.fenceValue)) {
+		fence_->Wait(frame.fenceValue);
+	}
+
+	// 使い終わったので後始末
+	Retire(frame);
+
+	return frameIndex_;
+}
+
+void FrameContext::WaitIdle() {
+
+	// 最後に送ったシグナルまで待つ
+	uint64_t lastFenceValue = nextFenceValue_ - 1;
+	if (lastFenceValue != 0 && !IsCompleted(lastFenceValue)) {
+		fence_->Wait(lastFenceValue);
+	}
+
+	// 古い順に送信済みのフレームを後始末 (EndFrame後なら現在のフレームも送信済み。記録中のフレームはまだコマンドを積んでいる途中なので残す)
+	for (uint32_t i = 1; i <= GetFrameCount(); ++i) {
+		Frame& frame = frames_[(frameIndex_ + i) % GetFrameCount()];
+		if (frame.fenceValue != 0) {
+			Retire(frame);
+		}
+	}
+}
+
+void FrameContext::Finalize() {
+
+	// GPUに送った処理を待つ
+	WaitIdle();
+
+	// これ以上コマンドは送らないので記録中のフレームも後始末
+	Retire(frames_[frameIndex_]);
+
+	frames_.clear();
+	fence_ = nullptr;
+}
+
+void FrameContext::DeferRelease(std::function<void()> release) {
+
+	// 記録中のフレームが終わるまで保留
+	frames_[frameIndex_].releases.push_back(std::move(release));
+}
+
+uint64_t FrameContext::AllocateUpload(uint64_t size, uint64_t alignment) {
+
+	// アライメントは2のべき乗
+	assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+	// リングを使わない、またはリングより大きければ確保できない
+	if (size == 0 || uploadRingSize_ < size) return kInvalidOffset;
+
+	// 先頭をアライメントに合わせる
+	uint64_t offset = (uploadHead_ + alignment - 1) & ~(alignment - 1);
+	uint64_t padding = offset - uploadHead_;
+
+	// 末尾に収まらなければ末尾を捨てて先頭から確保する
+	if (uploadRingSize_ < offset + size) {
+		padding = uploadRingSize_ - uploadHead_;
+		offset = 0;
+	}
+
+	// GPUが処理中のフレームの領域に追いついたら確保できない
+	if (uploadRingSize_ < uploadUsed_ + padding + size) return kInvalidOffset;
+
+	// 確保した分を記録中のフレームに付ける
+	uploadHead_ = offset + size;
+	uploadUsed_ += padding + size;
+	frames_[frameIndex_].uploadUsed += padding + size;
+
+	return offset;
+}
+
+bool FrameContext::IsCompleted(uint64_t fenceValue) const {
+
+	return fenceValue <= fence_->GetCompletedValue();
+}
+
+void FrameContext::Retire(Frame& frame) {
+
+	// 解放処理の中で新たに保留されることがあるので取り出してから実行する
+	std::vector<std::function<void()>> releases = std::move(frame.releases);
+	frame.releases.clear();
+
+	for (std::function<void()>& release : releases) {
+		release();
+	}
+
+	// アップロードリングの領域を返す (フレームは確保した順に終わるので使用量を減らすだけでよい)
+	uploadUsed_ -= frame.uploadUsed;
+	frame.uploadUsed = 0;
+
+	// 未使用に戻す
+	frame.fenceValue = 0;
+}
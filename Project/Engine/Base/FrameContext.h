@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Engine {
+
+	/// === フェンスのインターフェース === ///
+	/// GPUの進み具合を値で表す。D3D12のフェンスの代わりに偽物を差し込めば、GPUなしでフレームの管理を確認できる
+	class IFence {
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 仮想デストラクタ
+		/// </summary>
+		virtual ~IFence() = default;
+
+		/// <summary>
+		/// ここまでの処理が終わったら値を書き込むよう依頼する
+		/// </summary>
+		/// <param name="value">書き込む値</param>
+		virtual void Signal(uint64_t value) = 0;
+
+		/// <summary>
+		/// 完了済みの値の取得
+		/// </summary>
+		/// <returns></returns>
+		virtual uint64_t GetCompletedValue() const = 0;
+
+		/// <summary>
+		/// 値が書き込まれるまで待つ
+		/// </summary>
+		/// <param name="value">待つ値</param>
+		virtual void Wait(uint64_t value) = 0;
+	};
+
+	/// === フレームコンテキスト === ///
+	/// N個のフレームを順番に使い回し、CPUがフレームN+1を記録している間にGPUがフレームNを処理できるようにする
+	/// フレームごとにフェンス値、アップロードリングの使用量、完了後に解放するものを持つ (グラフィックスAPIには依存しない)
+	class FrameContext {
+
+		///-------------------------------------------///
+		/// 構造体
+		///-------------------------------------------///
+	public:
+
+		// 1フレーム分の状態
+		struct Frame {
+			uint64_t fenceValue = 0;						// このフレームの完了を示すフェンス値 (0ならGPUに送っていない)
+			uint64_t uploadUsed = 0;						// アップロードリングから確保したバイト数 (詰め物を含む)
+			std::vector<std::function<void()>> releases;	// GPUが使い終わったら実行する解放処理
+		};
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 初期化 (0番のフレームを記録中にする)
+		/// </summary>
+		/// <param name="fence">フェンス</param>
+		/// <param name="frameCount">同時に処理するフレームの数</param>
+		/// <param name="uploadRingSize">アップロードリングのサイズ (0ならリングを使わない)</param>
+		void Initialize(IFence* fence, uint32_t frameCount, uint64_t uploadRingSize);
+
+		/// <summary>
+		/// 記録中のフレームを確定させてフェンスにシグナルを送る
+		/// </summary>
+		void EndFrame();
+
+		/// <summary>
+		/// 次のフレームの記録を開始する (そのフレームを前回使ったときのGPUの処理が終わるまで待つ)
+		/// </summary>
+		/// <returns>フレーム番号</returns>
+		uint32_t BeginFrame();
+
+		/// <summary>
+		/// GPUに送った処理が全て終わるまで待ち、送信済みのフレームの解放処理を実行する
+		/// </summary>
+		void WaitIdle();
+
+		/// <summary>
+		/// 終了 (GPUを待ってから記録中のフレームを含む全ての解放処理を実行する)
+		/// </summary>
+		void Finalize();
+
+		/// <summary>
+		/// 記録中のフレームをGPUが使い終わったら実行する解放処理を登録する
+		/// </summary>
+		/// <param name="release">解放処理</param>
+		void DeferRelease(std::function<void()> release);
+
+		/// <summary>
+		/// アップロードリングから記録中のフレーム用の領域を確保する
+		/// </summary>
+		/// <param name="size">サイズ</param>
+		/// <param name="alignment">アライメント (2のべき乗)</param>
+		/// <returns>リング内の位置 (空きがなければkInvalidOffset)</returns>
+		uint64_t AllocateUpload(uint64_t size, uint64_t alignment);
+
+		/// <summary>
+		/// フェンス値の処理が終わっているか
+		/// </summary>
+		/// <param name="fenceValue">フェンス値</param>
+		/// <returns></returns>
+		bool IsCompleted(uint64_t fenceValue) const;
+
+		///-------------------------------------------///
+		/// クラス内関数
+		///-------------------------------------------///
+	private:
+
+		/// <summary>
+		/// GPUが使い終わったフレームの後始末
+		/// </summary>
+		/// <param name="frame">フレーム</param>
+		void Retire(Frame& frame);
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 記録中のフレーム番号の取得
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetFrameIndex() const { return frameIndex_; }
+
+		/// <summary>
+		/// 同時に処理するフレームの数の取得
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetFrameCount() const { return static_cast<uint32_t>(frames_.size()); }
+
+		/// <summary>
+		/// 記録中のフレームが完了したときに書き込まれるフェンス値の取得
+		/// </summary>
+		/// <returns></returns>
+		uint64_t GetCurrentFenceValue() const { return nextFenceValue_; }
+
+		/// <summary>
+		/// アップロードリングの使用量の取得 (GPUが処理中のフレームの分を含む)
+		/// </summary>
+		/// <returns></returns>
+		uint64_t GetUploadUsed() const { return uploadUsed_; }
+
+		/// <summary>
+		/// アップロードリングのサイズの取得
+		/// </summary>
+		/// <returns></returns>
+		uint64_t GetUploadRingSize() const { return uploadRingSize_; }
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// フェンス
+		IFence* fence_ = nullptr;
+
+		// フレーム
+		std::vector<Frame> frames_;
+
+		// 記録中のフレーム番号
+		uint32_t frameIndex_ = 0;
+
+		// 次にシグナルを送るフェンス値
+		uint64_t nextFenceValue_ = 1;
+
+		// アップロードリングのサイズ
+		uint64_t uploadRingSize_ = 0;
+
+		// アップロードリングの次に確保する位置
+		uint64_t uploadHead_ = 0;
+
+		// アップロードリングの使用量
+		uint64_t uploadUsed_ = 0;
+
+		///-------------------------------------------///
+		/// 定数
+		///-------------------------------------------///
+	public:
+
+		// 確保に失敗したときの位置
+		static const uint64_t kInvalidOffset = UINT64_MAX;
+	};
+}
@@ -0,0 +1,208 @@
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <thread>
+#include <imgui.h>
+
+using namespace Engine;
+
+void FramePacer::Initialize(float targetFrameRate) {
+
+	// 目標のフレームレートを設定
+	SetTargetFrameRate(targetFrameRate);
+
+	// 最初のWaitで計り始める
+	lastFrame_ = {};
+
+	ResetStats();
+}
+
+void FramePacer::Wait() {
+
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+	// 最初のフレームは読み込みの時間を含むので記録せずに計り始める
+	if (lastFrame_ == std::chrono::steady_clock::time_point{}) {
+		deadline_ = now;
+		lastFrame_ = now;
+		return;
+	}
+
+	// 有効で目標があれば待つ
+	if (isEnabled_ && period_.count() > 0) {
+
+		// 前の締め切りから1フレーム後 (前のフレームを始めた時刻からにすると、待ちすぎた分だけ少しずつ遅れる)
+		deadline_ += period_;
+
+		// 1フレーム以上遅れていたら取り戻そうとせずに今から数え直す
+		if (deadline_ + period_ < now) {
+			deadline_ = now;
+		}
+
+		WaitUntilDeadline();
+	}
+
+	// フレーム時間を記録して次のフレームを始める
+	now = std::chrono::steady_clock::now();
+	RecordFrame(std::chrono::duration<float, std::milli>(now - lastFrame_).count());
+	lastFrame_ = now;
+
+	// 待たなかったときは今を締め切りにする (有効に戻したときに溜まった分を取り戻そうとしない)
+	if (!isEnabled_ || period_.count() <= 0) {
+		deadline_ = now;
+	}
+}
+
+void FramePacer::ResetStats() {
+
+	histogram_.fill(0);
+	frameCount_ = 0;
+	totalMilliseconds_ = 0.0;
+	maxMilliseconds_ = 0.0f;
+	lastFrameMilliseconds_ = 0.0f;
+}
+
+void FramePacer::ShowImGui() {
+
+#ifdef USE_IMGUI
+
+	ImGui::Begin("FramePacer");
+
+	// 有効か
+	bool isEnabled = isEnabled_;
+	if (ImGui::Checkbox("Enabled", &isEnabled)) {
+		SetEnabled(isEnabled);
+	}
+
+	// 目標のフレームレート
+	float targetFrameRate = targetFrameRate_;
+	if (ImGui::DragFloat("TargetFPS", &targetFrameRate, 1.0f, 0.0f, 500.0f, "%.0f")) {
+		SetTargetFrameRate(targetFrameRate);
+	}
+
+	ImGui::Text("SpinThreshold: %.3f ms", GetSpinThreshold());
+
+	// フレーム時間の統計
+	Stats stats = GetStats();
+	ImGui::Text("Frames: %u", stats.frameCount);
+	ImGui::Text("Average: %.3f ms", stats.average);
+	ImGui::Text("p50: %.3f ms", stats.p50);
+	ImGui::Text("p99: %.3f ms", stats.p99);
+	ImGui::Text("Max: %.3f ms", stats.max);
+
+	if (ImGui::Button("ResetStats")) {
+		ResetStats();
+	}
+
+	ImGui::End();
+
+#endif // USE_IMGUI
+}
+
+void FramePacer::WaitUntilDeadline() {
+
+	// ----------残りが長い間は1ミリ秒ずつ眠る----------
+	// 眠りは指定より長くなることがあるので、見積もりより残りが短くなったら眠らない
+	while (true) {
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		double remaining = std::chrono::duration<double, std::milli>(deadline_ - start).count();
+		if (remaining <= sleepEstimate_) {
+			break;
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		// 実際に眠った時間で見積もりを更新する
+		RecordSleep(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	// ----------最後の端数は空回りで待つ----------
+	while (std::chrono::steady_clock::now() < deadline_) {
+		std::this_thread::yield();
+	}
+}
+
+void FramePacer::RecordSleep(double milliseconds) {
+
+	// 上限までは全ての平均、超えたら新しいものほど重くする
+	if (sleepSampleCount_ < kMaxSleepSampleCount) {
+		sleepSampleCount_++;
+	}
+	double weight = 1.0 / sleepSampleCount_;
+
+	// 平均と分散を少しずつ更新する
+	double delta = milliseconds - sleepMean_;
+	sleepMean_ += delta * weight;
+	sleepVariance_ = (1.0 - weight) * (sleepVariance_ + weight * delta * delta);
+
+	// 大抵の眠りが収まる時間を見積もりにする
+	sleepEstimate_ = sleepMean_ + std::sqrt(sleepVariance_);
+}
+
+void FramePacer::RecordFrame(float milliseconds) {
+
+	// 区間に振り分ける (長すぎるものは最後の区間にまとめる)
+	uint32_t bucket = static_cast<uint32_t>(milliseconds / kHistogramBucketWidth);
+	bucket = (std::min)(bucket, kHistogramBucketCount - 1);
+	histogram_[bucket]++;
+
+	frameCount_++;
+	totalMilliseconds_ += milliseconds;
+	maxMilliseconds_ = (std::max)(maxMilliseconds_, milliseconds);
+	lastFrameMilliseconds_ = milliseconds;
+}
+
+float FramePacer::CalculatePercentile(float ratio) const {
+
+	if (frameCount_ == 0) {
+		return 0.0f;
+	}
+
+	// 小さい方から数えて割合に届いた区間の上端
+	uint32_t target = static_cast<uint32_t>(std::ceil(frameCount_ * ratio));
+	target = std::clamp(target, 1u, frameCount_);
+
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < kHistogramBucketCount; ++i) {
+		count += histogram_[i];
+		if (count >= target) {
+			// 最大値を超えないようにする (最後の区間は上端がない)
+			return (std::min)((i + 1) * kHistogramBucketWidth, maxMilliseconds_);
+		}
+	}
+
+	return maxMilliseconds_;
+}
+
+void FramePacer::SetTargetFrameRate(float targetFrameRate) {
+
+	assert(targetFrameRate >= 0.0f);
+
+	targetFrameRate_ = targetFrameRate;
+
+	// 0なら待たない
+	if (targetFrameRate_ <= 0.0f) {
+		period_ = std::chrono::steady_clock::duration::zero();
+		return;
+	}
+
+	period_ = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / targetFrameRate_));
+}
+
+FramePacer::Stats FramePacer::GetStats() const {
+
+	Stats stats;
+	stats.frameCount = frameCount_;
+
+	if (frameCount_ > 0) {
+		stats.average = static_cast<float>(totalMilliseconds_ / frameCount_);
+		stats.p50 = CalculatePercentile(0.5f);
+		stats.p99 = CalculatePercentile(0.99f);
+		stats.max = maxMilliseconds_;
+	}
+
+	return stats;
+}
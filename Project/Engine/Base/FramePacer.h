@@ -0,0 +1,201 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace Engine {
+
+	/// === フレームの間隔の調整 === ///
+	/// 目標のフレームレートになるまで待つ。残りが長い間は1ミリ秒ずつ眠り、眠ると寝過ごしそうな最後の端数だけ空回りで待つ
+	/// 1ミリ秒の眠りに実際かかった時間を計り続けて、空回りに切り替える残り時間を決める (OSのタイマーの精度に合わせる)
+	/// フレーム時間をヒストグラムに記録して中央値、99パーセンタイル、最大値でばらつきを確認できる
+	/// グラフィックスAPIには依存しない
+	class FramePacer {
+
+		///-------------------------------------------///
+		/// 構造体
+		///-------------------------------------------///
+	public:
+
+		// フレーム時間の統計 (ミリ秒)
+		struct Stats {
+			uint32_t frameCount = 0;	// 記録したフレーム数
+			float average = 0.0f;		// 平均
+			float p50 = 0.0f;			// 中央値
+			float p99 = 0.0f;			// 99パーセンタイル
+			float max = 0.0f;			// 最大値
+		};
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="targetFrameRate">目標のフレームレート (0なら待たない)</param>
+		void Initialize(float targetFrameRate);
+
+		/// <summary>
+		/// 前のフレームから目標の時間が経つまで待ち、フレーム時間を記録する (フレームの最後に1回呼ぶ)
+		/// </summary>
+		void Wait();
+
+		/// <summary>
+		/// 統計のリセット
+		/// </summary>
+		void ResetStats();
+
+		/// <summary>
+		/// ImGui表示
+		/// </summary>
+		void ShowImGui();
+
+		///-------------------------------------------///
+		/// クラス内関数
+		///-------------------------------------------///
+	private:
+
+		/// <summary>
+		/// 締め切りまで待つ
+		/// </summary>
+		void WaitUntilDeadline();
+
+		/// <summary>
+		/// 1ミリ秒の眠りにかかった時間を記録して見積もりを更新する
+		/// </summary>
+		/// <param name="milliseconds">実際に眠った時間(ミリ秒)</param>
+		void RecordSleep(double milliseconds);
+
+		/// <summary>
+		/// フレーム時間を記録する
+		/// </summary>
+		/// <param name="milliseconds">フレーム時間(ミリ秒)</param>
+		void RecordFrame(float milliseconds);
+
+		/// <summary>
+		/// ヒストグラムからパーセンタイルを求める
+		/// </summary>
+		/// <param name="ratio">割合 (0 ~ 1)</param>
+		/// <returns>その割合のフレームが収まる時間(ミリ秒)</returns>
+		float CalculatePercentile(float ratio) const;
+
+		///-------------------------------------------///
+		/// セッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 目標のフレームレートのセッター
+		/// </summary>
+		/// <param name="targetFrameRate">目標のフレームレート (0なら待たない)</param>
+		void SetTargetFrameRate(float targetFrameRate);
+
+		/// <summary>
+		/// 有効かのセッター (計測のときは無効にして待たずに回す。統計は記録し続ける)
+		/// </summary>
+		/// <param name="isEnabled">有効か</param>
+		void SetEnabled(bool isEnabled) { isEnabled_ = isEnabled; }
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 目標のフレームレートの取得
+		/// </summary>
+		/// <returns></returns>
+		float GetTargetFrameRate() const { return targetFrameRate_; }
+
+		/// <summary>
+		/// 有効かの取得
+		/// </summary>
+		/// <returns></returns>
+		bool IsEnabled() const { return isEnabled_; }
+
+		/// <summary>
+		/// 前のフレームのフレーム時間の取得
+		/// </summary>
+		/// <returns>ミリ秒</returns>
+		float GetLastFrameTime() const { return lastFrameMilliseconds_; }
+
+		/// <summary>
+		/// 空回りに切り替える残り時間の取得 (1ミリ秒の眠りにかかる時間の見積もり)
+		/// </summary>
+		/// <returns>ミリ秒</returns>
+		float GetSpinThreshold() const { return static_cast<float>(sleepEstimate_); }
+
+		/// <summary>
+		/// フレーム時間の統計の取得
+		/// </summary>
+		/// <returns></returns>
+		Stats GetStats() const;
+
+		///-------------------------------------------///
+		/// 定数
+		///-------------------------------------------///
+	public:
+
+		// 目標のフレームレートの既定値
+		const float kDefaultFrameRate = 60.0f;
+
+		// ヒストグラムの1区間の幅(ミリ秒)
+		const float kHistogramBucketWidth = 0.1f;
+
+		// ヒストグラムの区間の数 (最後の区間はそれより長いフレームをまとめる)
+		static const uint32_t kHistogramBucketCount = 1000;
+
+		// 眠りの見積もりに使う回数の上限 (超えたら古いものほど軽くして、タイマーの精度の変化に追いつく)
+		static const uint32_t kMaxSleepSampleCount = 1000;
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// 目標のフレームレート
+		float targetFrameRate_ = kDefaultFrameRate;
+
+		// 1フレームの時間
+		std::chrono::steady_clock::duration period_{};
+
+		// 有効か
+		bool isEnabled_ = true;
+
+		// 次のフレームを始める時刻
+		std::chrono::steady_clock::time_point deadline_{};
+
+		// 前のフレームを始めた時刻 (初期値なら最初のフレーム)
+		std::chrono::steady_clock::time_point lastFrame_{};
+
+		// 1ミリ秒の眠りにかかる時間の見積もり(ミリ秒) (平均 + 標準偏差)
+		double sleepEstimate_ = 2.0;
+
+		// 1ミリ秒の眠りにかかった時間の平均(ミリ秒)
+		double sleepMean_ = 1.0;
+
+		// 1ミリ秒の眠りにかかった時間の分散
+		double sleepVariance_ = 0.0;
+
+		// 1ミリ秒の眠りを計った回数
+		uint32_t sleepSampleCount_ = 0;
+
+		// フレーム時間のヒストグラム
+		std::array<uint32_t, kHistogramBucketCount> histogram_{};
+
+		// 記録したフレーム数
+		uint32_t frameCount_ = 0;
+
+		// フレーム時間の合計(ミリ秒)
+		double totalMilliseconds_ = 0.0;
+
+		// フレーム時間の最大値(ミリ秒)
+		float maxMilliseconds_ = 0.0f;
+
+		// 前のフレームのフレーム時間(ミリ秒)
+		float lastFrameMilliseconds_ = 0.0f;
+	};
+}
@@ -1,13 +1,24 @@
 #include "GraphicsPipelineBuilder.h"
 #include "DirectXUtility.h"
 #include "Logger.h"
+#include "ShaderCache.h"
 
 #include <cassert>
+#include <cstring>
 
 using namespace Engine;
 using namespace Logger;
 using namespace Microsoft::WRL;
 
+namespace {
+
+	// 値を1つハッシュに足す (構造体はパディングを含めないようにメンバごとに足す)
+	template <typename T>
+	uint64_t HashValue(const T& value, uint64_t hash) {
+		return ShaderCache::HashBytes(&value, sizeof(T), hash);
+	}
+}
+
 GraphicsPipelineBuilder::GraphicsPipelineBuilder() {
 }
 
@@ -141,8 +152,9 @@ void GraphicsPipelineBuilder::Build() {
 	graphicsPipelineStateDesc.DSVFormat = DXGI_FORMAT_D24_UNORM_S8_UINT;
 
 	// GraphicsPipelineStateの生成
-	HRESULT hr = dxUtility_->GetDevice()->CreateGraphicsPipelineState(&graphicsPipelineStateDesc, IID_PPV_ARGS(&graphicsPipelineState_));
-	assert(SUCCEEDED(hr));
+	// 前回の起動で作ったものがパイプラインライブラリにあれば読み込む
+	graphicsPipelineState_ = dxUtility_->GetPipelineLibrary().CreateGraphicsPipeline(MakePipelineKey(graphicsPipelineStateDesc), graphicsPipelineStateDesc);
+	assert(graphicsPipelineState_ != nullptr);
 }
 
 void GraphicsPipelineBuilder::Reset() {
@@ -150,6 +162,7 @@ void GraphicsPipelineBuilder::Reset() {
 	/// ===== RootSignature ===== ///
 
 	rootSignature_.Reset();
+	rootSignatureHash_ = 0;
 	descriptorRanges_.clear();
 	rootParameters_.clear();
 	staticSamplerDescs_.clear();
@@ -217,10 +230,13 @@ void GraphicsPipelineBuilder::ConfigureRootSignature() {
 	HRESULT hr = D3D12SerializeRootSignature(&rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signatureBlob, &errorBlob);
 
 	if (FAILED(hr)) {
-		Log(reinterpret_cast<char*>(errorBlob->GetBufferPointer()));
+		Logger::Write(Logger::Severity::Error, reinterpret_cast<char*>(errorBlob->GetBufferPointer()));
 		assert(false);
 	}
 
+	// パイプラインライブラリのキーに使うためにバイナリのハッシュを取っておく
+	rootSignatureHash_ = ShaderCache::HashBytes(signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize());
+
 	// バイナリを元にルートシグネチャを生成
 	hr = DirectXUtility::GetInstance()->GetDevice()->CreateRootSignature(0, signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize(), IID_PPV_ARGS(&rootSignature_));
 
@@ -433,3 +449,69 @@ void GraphicsPipelineBuilder::ConfigureTopologyType() {
 		break;
 	}
 }
+
+uint64_t GraphicsPipelineBuilder::MakePipelineKey(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc) const {
+
+	// ----------ルートシグネチャとシェーダー----------
+	uint64_t hash = HashValue(rootSignatureHash_, ShaderCache::kHashOffset);
+	hash = HashValue(desc.VS.BytecodeLength, hash);
+	hash = ShaderCache::HashBytes(desc.VS.pShaderBytecode, desc.VS.BytecodeLength, hash);
+	hash = HashValue(desc.PS.BytecodeLength, hash);
+	hash = ShaderCache::HashBytes(desc.PS.pShaderBytecode, desc.PS.BytecodeLength, hash);
+
+	// ----------BlendState----------
+	hash = HashValue(desc.BlendState.AlphaToCoverageEnable, hash);
+	hash = HashValue(desc.BlendState.IndependentBlendEnable, hash);
+	for (UINT i = 0; i < desc.NumRenderTargets; ++i) {
+		const D3D12_RENDER_TARGET_BLEND_DESC& renderTarget = desc.BlendState.RenderTarget[i];
+		hash = HashValue(renderTarget.BlendEnable, hash);
+		hash = HashValue(renderTarget.LogicOpEnable, hash);
+		hash = HashValue(renderTarget.SrcBlend, hash);
+		hash = HashValue(renderTarget.DestBlend, hash);
+		hash = HashValue(renderTarget.BlendOp, hash);
+		hash = HashValue(renderTarget.SrcBlendAlpha, hash);
+		hash = HashValue(renderTarget.DestBlendAlpha, hash);
+		hash = HashValue(renderTarget.BlendOpAlpha, hash);
+		hash = HashValue(renderTarget.LogicOp, hash);
+		hash = HashValue(renderTarget.RenderTargetWriteMask, hash);
+	}
+	hash = HashValue(desc.SampleMask, hash);
+
+	// ----------RasterizerState (4バイトのメンバだけなのでまとめて足す)----------
+	hash = HashValue(desc.RasterizerState, hash);
+
+	// ----------DepthStencilState----------
+	hash = HashValue(desc.DepthStencilState.DepthEnable, hash);
+	hash = HashValue(desc.DepthStencilState.DepthWriteMask, hash);
+	hash = HashValue(desc.DepthStencilState.DepthFunc, hash);
+	hash = HashValue(desc.DepthStencilState.StencilEnable, hash);
+	hash = HashValue(desc.DepthStencilState.StencilReadMask, hash);
+	hash = HashValue(desc.DepthStencilState.StencilWriteMask, hash);
+	hash = HashValue(desc.DepthStencilState.FrontFace, hash);
+	hash = HashValue(desc.DepthStencilState.BackFace, hash);
+
+	// ----------InputLayout (セマンティクス名は文字列の中身を足す)----------
+	hash = HashValue(desc.InputLayout.NumElements, hash);
+	for (UINT i = 0; i < desc.InputLayout.NumElements; ++i) {
+		const D3D12_INPUT_ELEMENT_DESC& element = desc.InputLayout.pInputElementDescs[i];
+		hash = ShaderCache::HashBytes(element.SemanticName, std::strlen(element.SemanticName) + 1, hash);
+		hash = HashValue(element.SemanticIndex, hash);
+		hash = HashValue(element.Format, hash);
+		hash = HashValue(element.InputSlot, hash);
+		hash = HashValue(element.AlignedByteOffset, hash);
+		hash = HashValue(element.InputSlotClass, hash);
+		hash = HashValue(element.InstanceDataStepRate, hash);
+	}
+
+	// ----------トポロジーと出力先----------
+	hash = HashValue(desc.PrimitiveTopologyType, hash);
+	hash = HashValue(desc.NumRenderTargets, hash);
+	for (UINT i = 0; i < desc.NumRenderTargets; ++i) {
+		hash = HashValue(desc.RTVFormats[i], hash);
+	}
+	hash = HashValue(desc.DSVFormat, hash);
+	hash = HashValue(desc.SampleDesc.Count, hash);
+	hash = HashValue(desc.SampleDesc.Quality, hash);
+
+	return hash;
+}
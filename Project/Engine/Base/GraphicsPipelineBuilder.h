@@ -162,6 +162,13 @@ namespace Engine {
 		/// </summary>
 		void ConfigureTopologyType();
 
+		/// <summary>
+		/// パイプラインライブラリのキーの作成 (シェーダーのバイナリ、ルートシグネチャ、各ステートの設定から作る)
+		/// </summary>
+		/// <param name="desc">パイプラインステートの設定</param>
+		/// <returns>キー</returns>
+		uint64_t MakePipelineKey(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc) const;
+
 	///-------------------------------------------/// 
 	/// ゲッター
 	///-------------------------------------------///
@@ -239,6 +246,9 @@ namespace Engine {
 		// 静的サンプラーの動的配列
 		std::vector<D3D12_STATIC_SAMPLER_DESC> staticSamplerDescs_;
 
+		// シリアライズしたルートシグネチャのハッシュ (パイプラインライブラリのキーに使う)
+		uint64_t rootSignatureHash_ = 0;
+
 		/// ===== Shader ===== ///
 
 		// シェーダーファイルのディレクトリパス
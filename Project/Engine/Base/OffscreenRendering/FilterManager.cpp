@@ -2,6 +2,7 @@
 #include "Filters/BaseFilter.h"
 #include "SceneBuffer.h"
 #include "PostProcessBuffer.h"
+#include "Profiler.h"
 
 #include <imgui.h>
 
@@ -105,6 +106,8 @@ void FilterManager::Initialize() {
 
 void FilterManager::Draw(SceneBuffer* scene, PostProcessBuffer* postProcess) {
 
+	PROFILE_SCOPE("FilterManager::Draw");
+
 	/// ===== 1つもフィルターが有効じゃなかったら ===== ///
 
 	// 有効なフィルターがあるかどうかのフラグ
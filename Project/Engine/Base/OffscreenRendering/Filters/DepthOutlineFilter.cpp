@@ -3,6 +3,7 @@
 #include "SrvManager.h"
 #include "Camera.h"
 #include "MathMatrix.h"
+#include "FrameCounters.h"
 
 #include <imgui.h>
 
@@ -56,6 +57,9 @@ void DepthOutlineFilter::Draw() {
 
 	// 3頂点を1回描画する
 	dxUtility_->GetCommandList()->DrawInstanced(3, 1, 0, 0);
+
+	// 描画の統計を数える
+	FrameCounters::GetInstance()->CountDraw(1, 3);
 }
 
 void DepthOutlineFilter::ShowImGui() {
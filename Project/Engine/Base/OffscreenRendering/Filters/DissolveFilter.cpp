@@ -2,6 +2,7 @@
 #include "DirectXUtility.h"
 #include "SrvManager.h"
 #include "Texture/TextureManager.h"
+#include "FrameCounters.h"
 
 #include <imgui.h>
 
@@ -54,6 +55,9 @@ void DissolveFilter::Draw() {
 
 	// 3頂点を1回描画する
 	dxUtility_->GetCommandList()->DrawInstanced(3, 1, 0, 0);
+
+	// 描画の統計を数える
+	FrameCounters::GetInstance()->CountDraw(1, 3);
 }
 
 void DissolveFilter::ShowImGui() {
@@ -134,10 +138,10 @@ void DissolveFilter::SetMaskTextureFilePath(const std::string relativePath) {
 
 	maskTextureFullPath = TextureManager::GetInstance()->GetBaseDirectoryPath() + "/" + relativePath;
 
-	// テクスチャを読み込む
-	TextureManager::GetInstance()->LoadTexture(maskTextureFullPath);
+	// テクスチャを読み込んで参照する
+	maskTextureHandle = TextureManager::GetInstance()->AcquireTexture(maskTextureFullPath);
 
 	// SRVインデックスを取得
-	maskTextureSrvIndex = TextureManager::GetInstance()->GetTextureIndexByFilePath(maskTextureFullPath);
+	maskTextureSrvIndex = maskTextureHandle->srvIndex;
 }
 
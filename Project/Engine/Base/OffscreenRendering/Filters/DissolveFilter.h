@@ -2,6 +2,7 @@
 
 #include "BaseFilter.h"
 #include "Vector3.h"
+#include "Texture/TextureManager.h"
 
 #include <string>
 
@@ -85,6 +86,9 @@ namespace Engine {
 		// マスクテクスチャのSRVインデックス
 		uint32_t maskTextureSrvIndex = 0;
 
+		// マスクテクスチャのハンドル (持っている間はキャッシュから追い出されない)
+		TextureHandle maskTextureHandle;
+
 		// コンフィグ用のバッファリソース
 		Microsoft::WRL::ComPtr<ID3D12Resource> configBuffer_ = nullptr;
 
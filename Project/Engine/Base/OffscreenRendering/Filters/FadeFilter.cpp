@@ -1,6 +1,7 @@
 #include "FadeFilter.h"
 #include "DirectXUtility.h"
 #include "SrvManager.h"
+#include "FrameCounters.h"
 
 #include <imgui.h>
 
@@ -49,6 +50,9 @@ void FadeFilter::Draw() {
 
 	// 3頂点を1回描画する
 	dxUtility_->GetCommandList()->DrawInstanced(3, 1, 0, 0);
+
+	// 描画の統計を数える
+	FrameCounters::GetInstance()->CountDraw(1, 2);
 }
 
 void FadeFilter::ShowImGui() {
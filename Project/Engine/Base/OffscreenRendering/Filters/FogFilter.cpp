@@ -2,6 +2,7 @@
 #include "DirectXUtility.h"
 #include "SrvManager.h"
 #include "Camera.h"
+#include "FrameCounters.h"
 
 #include <algorithm>
 #include <ImGui.h>
@@ -61,6 +62,9 @@ void FogFilter::Draw() {
 
 	// 3頂点を1回描画する
 	dxUtility_->GetCommandList()->DrawInstanced(3, 1, 0, 0);
+
+	// 描画の統計を数える
+	FrameCounters::GetInstance()->CountDraw(1, 3);
 }
 
 void FogFilter::ShowImGui() {
@@ -2,6 +2,7 @@
 #include "DirectXUtility.h"
 #include "SrvManager.h"
 #include "Logger.h"
+#include "FrameCounters.h"
 
 #include <imgui.h>
 
@@ -46,6 +47,9 @@ void GaussianBlurFilter::Draw() {
 
 	// 3頂点を1回描画する
 	dxUtility_->GetCommandList()->DrawInstanced(3, 1, 0, 0);
+
+	// 描画の統計を数える
+	FrameCounters::GetInstance()->CountDraw(1, 1);
 }
 
 void GaussianBlurFilter::ShowImGui() {
@@ -1,6 +1,7 @@
 #include "GrayscaleFilter.h"
 #include "DirectXUtility.h"
 #include "SrvManager.h"
+#include "FrameCounters.h"
 
 #include <imgui.h>
 
@@ -43,6 +44,9 @@ void GrayscaleFilter::Draw() {
 
 	// 3頂点を1回描画する
 	dxUtility_->GetCommandList()->DrawInstanced(3, 1, 0, 0);
+
+	// 描画の統計を数える
+	FrameCounters::GetInstance()->CountDraw(1, 1);
 }
 
 void GrayscaleFilter::ShowImGui() {
@@ -0,0 +1,99 @@
+#include "RecordingCommandBackend.h"
+
+#include <cassert>
+
+using namespace Engine;
+
+namespace {
+
+	// このスレッドの記録先 (記録中だけ設定される)
+	thread_local std::vector<uint32_t>* threadList = nullptr;
+}
+
+void RecordingCommandBackend::BeginParallel(uint32_t listCount) {
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	assert(parallelLists_.empty() && "並列記録の区間は入れ子にできない");
+
+	// ここまでの逐次のリストを確定
+	submittedLists_.push_back(std::move(sequentialList_));
+	sequentialList_.clear();
+
+	// 記録先を用意 (区間の途中で配列が伸びないように先に全て作る)
+	parallelLists_.resize(listCount);
+
+	events_.push_back({ EventType::BeginParallel, listCount, std::this_thread::get_id() });
+}
+
+void RecordingCommandBackend::BeginList(uint32_t listIndex) {
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	assert(listIndex < parallelLists_.size());
+	assert(threadList == nullptr && "このスレッドは別のリストを記録中");
+
+	// このスレッドの記録先にする
+	threadList = &parallelLists_[listIndex];
+
+	events_.push_back({ EventType::BeginList, listIndex, std::this_thread::get_id() });
+}
+
+void RecordingCommandBackend::EndList(uint32_t listIndex) {
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	assert(listIndex < parallelLists_.size());
+	assert(threadList == &parallelLists_[listIndex] && "記録を始めたスレッドと違う");
+
+	// 記録先を外す
+	threadList = nullptr;
+
+	events_.push_back({ EventType::EndList, listIndex, std::this_thread::get_id() });
+}
+
+void RecordingCommandBackend::EndParallel() {
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	// 区間内の番号順に並べる
+	for (std::vector<uint32_t>& list : parallelLists_) {
+		submittedLists_.push_back(std::move(list));
+	}
+	parallelLists_.clear();
+
+	events_.push_back({ EventType::EndParallel, 0, std::this_thread::get_id() });
+}
+
+void RecordingCommandBackend::Record(uint32_t value) {
+
+	// 記録処理の外なら逐次のリストに書く (区間の外はメインスレッドしか記録しない)
+	if (!threadList) {
+		sequentialList_.push_back(value);
+		return;
+	}
+
+	// 記録先はこのスレッドだけが書き込むのでロックはいらない
+	threadList->push_back(value);
+}
+
+void RecordingCommandBackend::Submit() {
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	assert(parallelLists_.empty() && "並列記録の区間の途中で送信はできない");
+
+	// 逐次のリストを確定
+	submittedLists_.push_back(std::move(sequentialList_));
+	sequentialList_.clear();
+}
+
+void RecordingCommandBackend::Clear() {
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	events_.clear();
+	sequentialList_.clear();
+	parallelLists_.clear();
+	submittedLists_.clear();
+}
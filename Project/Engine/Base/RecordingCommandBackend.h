@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CommandRecorder.h"
+
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Engine {
+
+	/// === 記録するだけのコマンド記録のバックエンド === ///
+	/// コマンドリストの代わりに呼ばれた順番と記録したスレッドを残す
+	/// D3D12のバックエンドと同じく、区間の外の記録は逐次のリストに積み、区間の開始と送信で確定させる
+	/// GPUなしでCommandRecorderの送信の順番と、記録処理が別々のスレッドで正しく区切られているかを確かめるために使う
+	class RecordingCommandBackend : public ICommandBackend {
+
+		///-------------------------------------------///
+		/// 構造体
+		///-------------------------------------------///
+	public:
+
+		// 呼ばれた処理の種類
+		enum class EventType {
+			BeginParallel,	// 並列記録の区間の開始
+			BeginList,		// コマンドリストの記録の開始
+			EndList,		// コマンドリストの記録の終了
+			EndParallel,	// 並列記録の区間の終了
+		};
+
+		// 呼ばれた処理
+		struct Event {
+			EventType type;				// 種類
+			uint32_t value;				// 区間の開始ならリストの数、それ以外は区間内の番号
+			std::thread::id threadId;	// 呼んだスレッド
+		};
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 並列記録の区間の開始
+		/// </summary>
+		/// <param name="listCount">記録するコマンドリストの数</param>
+		void BeginParallel(uint32_t listCount) override;
+
+		/// <summary>
+		/// コマンドリストの記録の開始
+		/// </summary>
+		/// <param name="listIndex">区間内の番号</param>
+		void BeginList(uint32_t listIndex) override;
+
+		/// <summary>
+		/// コマンドリストの記録の終了
+		/// </summary>
+		/// <param name="listIndex">区間内の番号</param>
+		void EndList(uint32_t listIndex) override;
+
+		/// <summary>
+		/// 並列記録の区間の終了
+		/// </summary>
+		void EndParallel() override;
+
+		/// <summary>
+		/// このスレッドの記録先のリストに値を書き込む (コマンドの代わりに呼ぶ。記録処理の外では逐次のリストに書く)
+		/// </summary>
+		/// <param name="value">値</param>
+		void Record(uint32_t value);
+
+		/// <summary>
+		/// 逐次のリストを確定させる (フレームの送信の代わり)
+		/// </summary>
+		void Submit();
+
+		/// <summary>
+		/// 記録を消す
+		/// </summary>
+		void Clear();
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 呼ばれた処理の取得
+		/// </summary>
+		/// <returns></returns>
+		const std::vector<Event>& GetEvents() const { return events_; }
+
+		/// <summary>
+		/// 送信の順に並べたリストの中身の取得 (逐次のリストと、区間ごとに区間内の番号順のリストが並ぶ)
+		/// </summary>
+		/// <returns></returns>
+		const std::vector<std::vector<uint32_t>>& GetSubmittedLists() const { return submittedLists_; }
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// 記録を守るミューテックス
+		std::mutex mutex_;
+
+		// 呼ばれた処理
+		std::vector<Event> events_;
+
+		// 区間の外の記録先
+		std::vector<uint32_t> sequentialList_;
+
+		// 記録中の区間のリストの中身 (区間内の番号順)
+		std::vector<std::vector<uint32_t>> parallelLists_;
+
+		// 送信の順に並べたリストの中身
+		std::vector<std::vector<uint32_t>> submittedLists_;
+	};
+}
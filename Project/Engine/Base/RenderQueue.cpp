@@ -0,0 +1,204 @@
+#include "RenderQueue.h"
+#include "CommandRecorder.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <imgui.h>
+
+using namespace Engine;
+
+uint32_t RenderQueue::RegisterPipeline(std::function<void()> setting) {
+
+	// キーに入る数まで
+	assert(pipelines_.size() < kMaxPipelineCount);
+
+	pipelines_.push_back(std::move(setting));
+
+	return static_cast<uint32_t>(pipelines_.size() - 1);
+}
+
+void RenderQueue::Submit(Pass pass, uint32_t pipeline, uint32_t material, float depth, std::function<void()> draw) {
+
+	// 登録されたパイプラインか
+	assert(pipeline < pipelines_.size());
+
+	// キーとパケットの番号を記録
+	items_.push_back({ MakeKey(pass, pipeline, material, depth), static_cast<uint32_t>(packets_.size()) });
+
+	// パケットを追加
+	packets_.push_back({ std::move(draw) });
+}
+
+void RenderQueue::Execute(CommandRecorder* recorder) {
+
+	/// ===== 並べ替え ===== ///
+
+	std::chrono::steady_clock::time_point sortStart = std::chrono::steady_clock::now();
+
+	RadixSort(items_, scratch_);
+
+	sortMicroseconds_ = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - sortStart).count();
+
+	/// ===== 描画 ===== ///
+
+	if (!recorder) {
+
+		// 今のコマンドリストに順に記録する
+		pipelineChangeCount_ = DrawRange(0, items_.size());
+	}
+	else {
+
+		// パスの名前 (記録時間の表示用)
+		static const char* const kPassNames[kPassCount] = { "Opaque", "Transparent", "Effect" };
+
+		// 並べ替え済みなので同じパスは連続している。パスごとに1つのコマンドリストに記録する
+		std::fill(std::begin(passChangeCounts_), std::end(passChangeCounts_), 0u);
+		size_t begin = 0;
+		while (begin < items_.size()) {
+
+			Pass pass = GetPass(items_[begin].key);
+
+			size_t end = begin;
+			while (end < items_.size() && GetPass(items_[end].key) == pass) {
+				end++;
+			}
+
+			uint32_t& changeCount = passChangeCounts_[static_cast<uint32_t>(pass)];
+			recorder->Add(kPassNames[static_cast<uint32_t>(pass)], [this, begin, end, &changeCount]() {
+				changeCount = DrawRange(begin, end);
+			});
+
+			begin = end;
+		}
+
+		// 記録が終わるまで待つ (送信はパスの順)
+		recorder->Execute();
+
+		// パスごとの切り替え回数を合計する
+		pipelineChangeCount_ = 0;
+		for (uint32_t changeCount : passChangeCounts_) {
+			pipelineChangeCount_ += changeCount;
+		}
+	}
+
+	// 統計を記録
+	packetCount_ = static_cast<uint32_t>(items_.size());
+
+	// 次のフレームのために空にする (確保済みの領域は使い回す)
+	packets_.clear();
+	items_.clear();
+}
+
+uint32_t RenderQueue::DrawRange(size_t begin, size_t end) {
+
+	// 設定済みのパイプライン (コマンドリストの最初は何も設定されていない)
+	uint32_t currentPipeline = kMaxPipelineCount;
+
+	uint32_t changeCount = 0;
+
+	for (size_t i = begin; i < end; ++i) {
+
+		const SortItem& item = items_[i];
+
+		// パイプラインが変わったときだけ設定する
+		uint32_t pipeline = GetPipeline(item.key);
+		if (pipeline != currentPipeline) {
+			pipelines_[pipeline]();
+			currentPipeline = pipeline;
+			changeCount++;
+		}
+
+		// 描画
+		packets_[item.index].draw();
+	}
+
+	return changeCount;
+}
+
+void RenderQueue::ShowImGui() {
+
+#ifdef USE_IMGUI
+
+	ImGui::Begin("RenderQueue");
+
+	ImGui::Text("Packets: %u", packetCount_);
+	ImGui::Text("Pipeline Changes: %u", pipelineChangeCount_);
+	ImGui::Text("Sort: %.1f us", sortMicroseconds_);
+
+	ImGui::End();
+
+#endif // USE_IMGUI
+}
+
+uint64_t RenderQueue::MakeKey(Pass pass, uint32_t pipeline, uint32_t material, float depth) {
+
+	assert(pipeline < kMaxPipelineCount);
+
+	// 0以上の浮動小数点数はビット列のまま比べても大小が変わらない (手前ほど小さい)
+	uint32_t depthBits = std::bit_cast<uint32_t>((std::max)(depth, 0.0f));
+
+	uint64_t passBits = static_cast<uint64_t>(pass) << 62;
+	uint64_t pipelineBits = static_cast<uint64_t>(pipeline);
+	uint64_t materialBits = static_cast<uint64_t>(material & kMaterialMask);
+
+	// 半透明は奥から手前に描くので深度を反転して上位に置く
+	if (pass == Pass::Transparent) {
+		return passBits | (static_cast<uint64_t>(~depthBits) << 30) | (pipelineBits << 22) | materialBits;
+	}
+
+	// それ以外は設定の切り替えが少なくなるようにパイプライン、マテリアルの順に並べ、同じ中では手前から描く
+	return passBits | (pipelineBits << 54) | (materialBits << 32) | depthBits;
+}
+
+RenderQueue::Pass RenderQueue::GetPass(uint64_t key) {
+
+	return static_cast<Pass>(key >> 62);
+}
+
+uint32_t RenderQueue::GetPipeline(uint64_t key) {
+
+	// 半透明はパイプラインが下位にある
+	if (GetPass(key) == Pass::Transparent) {
+		return static_cast<uint32_t>((key >> 22) & (kMaxPipelineCount - 1));
+	}
+
+	return static_cast<uint32_t>((key >> 54) & (kMaxPipelineCount - 1));
+}
+
+void RenderQueue::RadixSort(std::vector<SortItem>& items, std::vector<SortItem>& scratch) {
+
+	scratch.resize(items.size());
+
+	// 下位の8bitから順に安定な計数ソートを行う
+	for (uint32_t shift = 0; shift < 64; shift += 8) {
+
+		// 各値の数を数える
+		std::array<uint32_t, 256> counts{};
+		for (const SortItem& item : items) {
+			counts[(item.key >> shift) & 0xFF]++;
+		}
+
+		// 全て同じ値なら並びは変わらないので飛ばす
+		if (counts[(items.empty() ? 0 : (items.front().key >> shift) & 0xFF)] == items.size()) {
+			continue;
+		}
+
+		// 各値の書き込み開始位置
+		uint32_t offset = 0;
+		for (uint32_t& count : counts) {
+			uint32_t current = count;
+			count = offset;
+			offset += current;
+		}
+
+		// 元の順を保って振り分ける
+		for (const SortItem& item : items) {
+			scratch[counts[(item.key >> shift) & 0xFF]++] = item;
+		}
+
+		items.swap(scratch);
+	}
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Engine {
+
+	/// === 前方宣言 === ///
+	class CommandRecorder;
+
+	/// === レンダーキュー === ///
+	/// 描画をパケットとして集め、64bitのソートキーで並べ替えてから実行する
+	/// パイプラインが変わったときだけ設定関数を呼ぶので、登録順に関係なく設定の切り替えが最小になる
+	/// キーの作成と並べ替えは番号と値だけを扱うのでグラフィックスAPIには依存しない
+	/// CommandRecorderを渡すと、並べ替えた後のパスごとに別のコマンドリストへ並列に記録する (送信はパスの順)
+	///
+	/// キーの並び (上位から)
+	///   不透明、エフェクト : [パス 2bit][パイプライン 8bit][マテリアル 22bit][深度 32bit 手前から奥]
+	///   半透明             : [パス 2bit][深度 32bit 奥から手前][パイプライン 8bit][マテリアル 22bit]
+	class RenderQueue {
+
+		///-------------------------------------------///
+		/// 構造体
+		///-------------------------------------------///
+	public:
+
+		// 描画パス (この順に描画される)
+		enum class Pass : uint8_t {
+			Opaque,			// 不透明
+			Transparent,	// 半透明 (奥から手前に並べる)
+			Effect,			// エフェクト (加算合成など順番に依存しないもの)
+		};
+
+		// 描画パスの数
+		static const uint32_t kPassCount = 3;
+
+		// 並べ替え用の要素
+		struct SortItem {
+			uint64_t key;	// ソートキー
+			uint32_t index;	// パケットの番号
+		};
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// パイプラインの登録
+		/// </summary>
+		/// <param name="setting">描画設定の関数 (ルートシグネチャ、パイプラインなどを設定する)</param>
+		/// <returns>パイプラインの番号</returns>
+		uint32_t RegisterPipeline(std::function<void()> setting);
+
+		/// <summary>
+		/// 描画パケットの追加
+		/// </summary>
+		/// <param name="pass">描画パス</param>
+		/// <param name="pipeline">RegisterPipelineで受け取った番号</param>
+		/// <param name="material">マテリアルの番号 (同じ値が並ぶようにする。下位22bitを使う)</param>
+		/// <param name="depth">カメラからの距離</param>
+		/// <param name="draw">描画関数</param>
+		void Submit(Pass pass, uint32_t pipeline, uint32_t material, float depth, std::function<void()> draw);
+
+		/// <summary>
+		/// 並べ替えて描画し、パケットを空にする
+		/// </summary>
+		/// <param name="recorder">コマンドの並列記録 (nullptrなら今のコマンドリストに順に記録する)</param>
+		void Execute(CommandRecorder* recorder = nullptr);
+
+		/// <summary>
+		/// ImGui表示
+		/// </summary>
+		void ShowImGui();
+
+		/// <summary>
+		/// ソートキーの作成
+		/// </summary>
+		/// <param name="pass">描画パス</param>
+		/// <param name="pipeline">パイプラインの番号</param>
+		/// <param name="material">マテリアルの番号</param>
+		/// <param name="depth">カメラからの距離</param>
+		/// <returns>ソートキー</returns>
+		static uint64_t MakeKey(Pass pass, uint32_t pipeline, uint32_t material, float depth);
+
+		/// <summary>
+		/// キーから描画パスを取り出す
+		/// </summary>
+		/// <param name="key">ソートキー</param>
+		/// <returns>描画パス</returns>
+		static Pass GetPass(uint64_t key);
+
+		/// <summary>
+		/// キーからパイプラインの番号を取り出す
+		/// </summary>
+		/// <param name="key">ソートキー</param>
+		/// <returns>パイプラインの番号</returns>
+		static uint32_t GetPipeline(uint64_t key);
+
+		/// <summary>
+		/// キーの昇順に並べ替える (8bitずつのLSD基数ソート、同じキーは元の順を保つ)
+		/// </summary>
+		/// <param name="items">並べ替える要素</param>
+		/// <param name="scratch">作業用の領域 (呼び出し側で使い回す)</param>
+		static void RadixSort(std::vector<SortItem>& items, std::vector<SortItem>& scratch);
+
+		///-------------------------------------------///
+		/// クラス内関数
+		///-------------------------------------------///
+	private:
+
+		/// <summary>
+		/// 並べ替え済みの範囲を描画する (別の範囲と並列に呼べる)
+		/// </summary>
+		/// <param name="begin">開始位置</param>
+		/// <param name="end">終了位置 (含まない)</param>
+		/// <returns>パイプラインの切り替え回数</returns>
+		uint32_t DrawRange(size_t begin, size_t end);
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 前回のExecuteで実行したパケットの数の取得
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetPacketCount() const { return packetCount_; }
+
+		/// <summary>
+		/// 前回のExecuteでのパイプラインの切り替え回数の取得
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetPipelineChangeCount() const { return pipelineChangeCount_; }
+
+		/// <summary>
+		/// 前回のExecuteでの並べ替えにかかった時間(マイクロ秒)の取得
+		/// </summary>
+		/// <returns></returns>
+		float GetSortMicroseconds() const { return sortMicroseconds_; }
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// 描画パケット
+		struct Packet {
+			std::function<void()> draw;	// 描画関数
+		};
+
+		// パイプラインごとの描画設定の関数
+		std::vector<std::function<void()>> pipelines_;
+
+		// 描画パケット
+		std::vector<Packet> packets_;
+
+		// 並べ替え用の要素
+		std::vector<SortItem> items_;
+
+		// 並べ替えの作業用の領域
+		std::vector<SortItem> scratch_;
+
+		// パスごとのパイプラインの切り替え回数 (並列記録用)
+		uint32_t passChangeCounts_[kPassCount] = {};
+
+		// 前回実行したパケットの数
+		uint32_t packetCount_ = 0;
+
+		// 前回のパイプラインの切り替え回数
+		uint32_t pipelineChangeCount_ = 0;
+
+		// 前回の並べ替えにかかった時間(マイクロ秒)
+		float sortMicroseconds_ = 0.0f;
+
+		///-------------------------------------------///
+		/// 定数
+		///-------------------------------------------///
+	public:
+
+		// パイプラインの番号の上限
+		static const uint32_t kMaxPipelineCount = 1 << 8;
+
+		// マテリアルの番号のマスク
+		static const uint32_t kMaterialMask = (1 << 22) - 1;
+	};
+}
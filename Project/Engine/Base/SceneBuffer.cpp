@@ -3,6 +3,7 @@
 #include "SrvManager.h"
 #include "WinApp.h"
 
+#include <cassert>
 #include <imgui.h>
 
 using namespace Engine;
@@ -289,6 +290,30 @@ void SceneBuffer::PreDrawResolve() {
 	commandList->RSSetScissorRects(1, &scissorRect);
 }
 
+void SceneBuffer::BindRenderTargets() {
+
+	// コマンドリストをDirectXUtilityから取得 (並列記録中はこのスレッドの記録先)
+	ID3D12GraphicsCommandList* commandList = dxUtility->GetCommandList().Get(); // コマンドリスト
+
+	// 描き込み状態でなければ描画中ではない
+	assert(currentRtvState == D3D12_RESOURCE_STATE_RENDER_TARGET && "PreDrawの後に呼ぶ");
+
+	/// ===== RTVとDSVの設定 ===== ///
+
+	// 深度が書き込み状態なら深度ステンシルビューも設定する (書き戻し中は使わない)
+	const D3D12_CPU_DESCRIPTOR_HANDLE* depthStencil = currentDsvState == D3D12_RESOURCE_STATE_DEPTH_WRITE ? &dsvHandle : nullptr;
+
+	// レンダーターゲットと深度ステンシルビューを設定
+	commandList->OMSetRenderTargets(1, &rtvHandle, false, depthStencil);
+
+	/// ===== ビューポートとシザーの設定 ===== ///
+
+	// ビューポート矩形の設定
+	commandList->RSSetViewports(1, &viewportRect);
+	// シザリング矩形の設定
+	commandList->RSSetScissorRects(1, &scissorRect);
+}
+
 void SceneBuffer::PostDraw() {
 
 	// コマンドリストをDirectXUtilityから取得
@@ -45,6 +45,11 @@ namespace Engine {
 		/// </summary>
 		void PreDrawResolve();
 
+		/// <summary>
+		/// 描画中のレンダーターゲットを設定し直す (バリアとクリアはしない。並列記録の各コマンドリストの最初に呼ぶ)
+		/// </summary>
+		void BindRenderTargets();
+
 		/// <summary>
 		/// 描画後処理
 		/// </summary>
@@ -0,0 +1,290 @@
+#include "ShaderCache.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <set>
+
+using namespace Engine;
+
+namespace {
+
+	// キャッシュのファイルの先頭
+	struct FileHeader {
+		uint32_t magic;		// 識別子
+		uint32_t version;	// 形式の版
+		uint64_t key;		// キー (ファイル名と一致するか確かめる)
+		uint64_t size;		// バイナリのサイズ
+		uint64_t checksum;	// バイナリのハッシュ (書きかけや壊れたファイルを使わないようにする)
+	};
+
+	// 長さを付けて文字列を足す (区切りがずれて別の組み合わせと同じにならないように)
+	template <typename Char>
+	uint64_t HashString(const std::basic_string<Char>& text, uint64_t hash) {
+		uint64_t length = text.size();
+		hash = ShaderCache::HashBytes(&length, sizeof(length), hash);
+		return ShaderCache::HashBytes(text.data(), text.size() * sizeof(Char), hash);
+	}
+
+	// インクルードしたファイルを書かれた順に深さ優先でたどって足す
+	uint64_t HashIncludes(const std::filesystem::path& directory, const std::vector<uint8_t>& source, uint32_t depth, std::set<std::string>& visited, uint64_t hash) {
+
+		// 深すぎたら打ち切る (循環はvisitedで防ぐが念のため)
+		if (depth >= ShaderCache::kMaxIncludeDepth) {
+			return hash;
+		}
+
+		for (const std::string& include : ShaderCache::FindIncludes(source)) {
+
+			std::filesystem::path includePath = (directory / include).lexically_normal();
+
+			// 大文字と小文字を区別しないファイルシステムに合わせて小文字で重複を調べる
+			std::string visitedKey = includePath.generic_string();
+			std::transform(visitedKey.begin(), visitedKey.end(), visitedKey.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			if (!visited.insert(visitedKey).second) {
+				continue;
+			}
+
+			// 名前を足す
+			hash = HashString(include, hash);
+
+			// 読めなければ名前だけ (コンパイルでエラーになる)
+			std::vector<uint8_t> includeSource;
+			if (!ShaderCache::ReadFile(includePath, includeSource)) {
+				continue;
+			}
+
+			// 内容を足して、その中のインクルードもたどる
+			hash = ShaderCache::HashBytes(includeSource.data(), includeSource.size(), hash);
+			hash = HashIncludes(includePath.parent_path(), includeSource, depth + 1, visited, hash);
+		}
+
+		return hash;
+	}
+}
+
+void ShaderCache::Initialize(const std::filesystem::path& directory) {
+
+	// 引数をメンバ変数に設定
+	directory_ = directory;
+
+	// 保存先のディレクトリを作る (作れなくても読み書きが失敗するだけで動作は変わらない)
+	std::error_code errorCode;
+	std::filesystem::create_directories(directory_, errorCode);
+}
+
+uint64_t ShaderCache::MakeKey(const std::filesystem::path& sourcePath, const std::wstring& profile, const std::vector<std::wstring>& arguments) {
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	// ソースを読む
+	std::vector<uint8_t> source;
+	if (!ReadFile(sourcePath, source)) {
+		return 0;
+	}
+
+	// 形式の版
+	uint32_t version = kFileVersion;
+	uint64_t hash = HashBytes(&version, sizeof(version));
+
+	// ソースの内容
+	hash = HashBytes(source.data(), source.size(), hash);
+
+	// インクルードしたファイルの名前と内容
+	std::set<std::string> visited;
+	hash = HashIncludes(sourcePath.parent_path(), source, 0, visited, hash);
+
+	// プロファイルとコンパイルオプション
+	hash = HashString(profile, hash);
+	for (const std::wstring& argument : arguments) {
+		hash = HashString(argument, hash);
+	}
+
+	stats_.loadMilliseconds += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	// 0はキーなしに使うので避ける
+	return hash == 0 ? 1 : hash;
+}
+
+bool ShaderCache::Load(uint64_t key, std::vector<uint8_t>& data) {
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	bool isHit = false;
+
+	// ファイルを読んで先頭を確かめる
+	std::vector<uint8_t> file;
+	if (key != 0 && ReadFile(MakeFilePath(key), file) && file.size() >= sizeof(FileHeader)) {
+
+		FileHeader header{};
+		std::memcpy(&header, file.data(), sizeof(FileHeader));
+
+		const uint8_t* body = file.data() + sizeof(FileHeader);
+		size_t bodySize = file.size() - sizeof(FileHeader);
+
+		// 識別子、版、キー、サイズ、中身のハッシュが全て一致すれば使う
+		if (header.magic == kFileMagic && header.version == kFileVersion && header.key == key &&
+			header.size == bodySize && header.checksum == HashBytes(body, bodySize)) {
+			data.assign(body, body + bodySize);
+			isHit = true;
+		}
+	}
+
+	// 統計を記録
+	if (isHit) {
+		stats_.hitCount++;
+	}
+	else {
+		stats_.missCount++;
+	}
+	stats_.loadMilliseconds += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	return isHit;
+}
+
+bool ShaderCache::Store(uint64_t key, const void* data, size_t size) {
+
+	assert(key != 0);
+
+	// 先頭と中身を1つにまとめて書く
+	FileHeader header{ kFileMagic, kFileVersion, key, size, HashBytes(data, size) };
+
+	std::vector<uint8_t> file(sizeof(FileHeader) + size);
+	std::memcpy(file.data(), &header, sizeof(FileHeader));
+	std::memcpy(file.data() + sizeof(FileHeader), data, size);
+
+	return WriteFile(MakeFilePath(key), file.data(), file.size());
+}
+
+uint64_t ShaderCache::HashBytes(const void* data, size_t size, uint64_t hash) {
+
+	// FNV-1a 64bit
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= bytes[i];
+		hash *= kHashPrime;
+	}
+
+	return hash;
+}
+
+bool ShaderCache::ReadFile(const std::filesystem::path& path, std::vector<uint8_t>& data) {
+
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file) {
+		return false;
+	}
+
+	// サイズを調べてまとめて読む
+	std::streamsize size = file.tellg();
+	if (size < 0) {
+		return false;
+	}
+	file.seekg(0, std::ios::beg);
+
+	data.resize(static_cast<size_t>(size));
+	return size == 0 || static_cast<bool>(file.read(reinterpret_cast<char*>(data.data()), size));
+}
+
+bool ShaderCache::WriteFile(const std::filesystem::path& path, const void* data, size_t size) {
+
+	// 一時ファイルに書く
+	std::filesystem::path temporaryPath = path;
+	temporaryPath += ".tmp";
+
+	{
+		std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			return false;
+		}
+
+		file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+		if (!file) {
+			return false;
+		}
+	}
+
+	// 書き終わってから置き換える (途中で落ちても前のファイルか一時ファイルが残るだけ)
+	std::error_code errorCode;
+	std::filesystem::rename(temporaryPath, path, errorCode);
+	if (errorCode) {
+		std::filesystem::remove(temporaryPath, errorCode);
+		return false;
+	}
+
+	return true;
+}
+
+std::vector<std::string> ShaderCache::FindIncludes(const std::vector<uint8_t>& source) {
+
+	std::vector<std::string> includes;
+
+	const char* text = reinterpret_cast<const char*>(source.data());
+	const size_t size = source.size();
+
+	size_t lineStart = 0;
+	while (lineStart < size) {
+
+		// 行の終わり
+		size_t lineEnd = lineStart;
+		while (lineEnd < size && text[lineEnd] != '\n') {
+			lineEnd++;
+		}
+
+		// 行頭の空白を飛ばす
+		size_t position = lineStart;
+		while (position < lineEnd && (text[position] == ' ' || text[position] == '\t')) {
+			position++;
+		}
+
+		// #include で始まる行だけを見る (#と単語の間の空白も許す)
+		if (position < lineEnd && text[position] == '#') {
+			position++;
+			while (position < lineEnd && (text[position] == ' ' || text[position] == '\t')) {
+				position++;
+			}
+
+			static const char kDirective[] = "include";
+			const size_t directiveLength = sizeof(kDirective) - 1;
+			if (lineEnd - position > directiveLength && std::equal(kDirective, kDirective + directiveLength, text + position)) {
+
+				position += directiveLength;
+
+				// 最初の " か < から対応する閉じ記号まで
+				while (position < lineEnd && text[position] != '"' && text[position] != '<') {
+					position++;
+				}
+
+				if (position < lineEnd) {
+					char close = text[position] == '"' ? '"' : '>';
+					size_t nameStart = position + 1;
+					size_t nameEnd = nameStart;
+					while (nameEnd < lineEnd && text[nameEnd] != close) {
+						nameEnd++;
+					}
+
+					if (nameEnd < lineEnd && nameEnd > nameStart) {
+						includes.emplace_back(text + nameStart, nameEnd - nameStart);
+					}
+				}
+			}
+		}
+
+		lineStart = lineEnd + 1;
+	}
+
+	return includes;
+}
+
+std::filesystem::path ShaderCache::MakeFilePath(uint64_t key) const {
+
+	// 16桁の16進数をファイル名にする
+	char fileName[32];
+	std::snprintf(fileName, sizeof(fileName), "%016llX.dxil", static_cast<unsigned long long>(key));
+
+	return directory_ / fileName;
+}
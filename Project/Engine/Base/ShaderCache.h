@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Engine {
+
+	/// === シェーダーキャッシュ === ///
+	/// コンパイル済みのシェーダーのバイナリを、ソースの内容から作ったキーでディスクに保存する
+	/// キーにはソース、インクルードしたファイル(入れ子も含む)の内容、プロファイル、コンパイルオプションを含めるので、
+	/// .hlsliを1つ書き換えただけでも、それをインクルードするシェーダーは作り直される
+	/// ファイルとバイト列だけを扱うのでグラフィックスAPIには依存しない
+	class ShaderCache {
+
+		///-------------------------------------------///
+		/// 構造体
+		///-------------------------------------------///
+	public:
+
+		// 統計
+		struct Stats {
+			uint32_t hitCount = 0;				// キャッシュから読めた数
+			uint32_t missCount = 0;				// キャッシュになかった数
+			float loadMilliseconds = 0.0f;		// キーの作成と読み込みにかかった時間の合計(ミリ秒)
+			float compileMilliseconds = 0.0f;	// キャッシュになかった分のコンパイルにかかった時間の合計(ミリ秒)
+		};
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 初期化 (保存先のディレクトリがなければ作る)
+		/// </summary>
+		/// <param name="directory">保存先のディレクトリ</param>
+		void Initialize(const std::filesystem::path& directory);
+
+		/// <summary>
+		/// キーの作成
+		/// </summary>
+		/// <param name="sourcePath">シェーダーのファイルパス</param>
+		/// <param name="profile">プロファイル</param>
+		/// <param name="arguments">コンパイルオプション (マクロの定義もここに含める)</param>
+		/// <returns>キー (ソースが読めなければ0)</returns>
+		uint64_t MakeKey(const std::filesystem::path& sourcePath, const std::wstring& profile, const std::vector<std::wstring>& arguments);
+
+		/// <summary>
+		/// キャッシュからの読み込み
+		/// </summary>
+		/// <param name="key">キー</param>
+		/// <param name="data">読み込んだバイナリ</param>
+		/// <returns>読めたか (なければ、または壊れていればfalse)</returns>
+		bool Load(uint64_t key, std::vector<uint8_t>& data);
+
+		/// <summary>
+		/// キャッシュへの保存 (書きかけのファイルが残らないように一時ファイルに書いてから置き換える)
+		/// </summary>
+		/// <param name="key">キー</param>
+		/// <param name="data">バイナリの先頭</param>
+		/// <param name="size">サイズ</param>
+		/// <returns>保存できたか</returns>
+		bool Store(uint64_t key, const void* data, size_t size);
+
+		/// <summary>
+		/// コンパイルにかかった時間を統計に足す
+		/// </summary>
+		/// <param name="milliseconds">時間(ミリ秒)</param>
+		void AddCompileMilliseconds(float milliseconds) { stats_.compileMilliseconds += milliseconds; }
+
+		/// <summary>
+		/// バイト列のハッシュ (FNV-1a 64bit。続けて足すときは前の値を渡す)
+		/// </summary>
+		/// <param name="data">先頭</param>
+		/// <param name="size">サイズ</param>
+		/// <param name="hash">前の値</param>
+		/// <returns>ハッシュ</returns>
+		static uint64_t HashBytes(const void* data, size_t size, uint64_t hash = kHashOffset);
+
+		/// <summary>
+		/// ファイルを全て読み込む
+		/// </summary>
+		/// <param name="path">ファイルパス</param>
+		/// <param name="data">読み込んだバイト列</param>
+		/// <returns>読めたか</returns>
+		static bool ReadFile(const std::filesystem::path& path, std::vector<uint8_t>& data);
+
+		/// <summary>
+		/// ファイルへの書き込み (一時ファイルに書いてから置き換える)
+		/// </summary>
+		/// <param name="path">ファイルパス</param>
+		/// <param name="data">先頭</param>
+		/// <param name="size">サイズ</param>
+		/// <returns>書けたか</returns>
+		static bool WriteFile(const std::filesystem::path& path, const void* data, size_t size);
+
+		/// <summary>
+		/// ソースからインクルードしているファイル名を取り出す (#include "..." と <...> のみ)
+		/// </summary>
+		/// <param name="source">ソース</param>
+		/// <returns>書かれた順のファイル名</returns>
+		static std::vector<std::string> FindIncludes(const std::vector<uint8_t>& source);
+
+		///-------------------------------------------///
+		/// クラス内関数
+		///-------------------------------------------///
+	private:
+
+		/// <summary>
+		/// キーからファイルパスを作る
+		/// </summary>
+		/// <param name="key">キー</param>
+		/// <returns></returns>
+		std::filesystem::path MakeFilePath(uint64_t key) const;
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 統計の取得
+		/// </summary>
+		/// <returns></returns>
+		const Stats& GetStats() const { return stats_; }
+
+		/// <summary>
+		/// 保存先のディレクトリの取得
+		/// </summary>
+		/// <returns></returns>
+		const std::filesystem::path& GetDirectory() const { return directory_; }
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// 保存先のディレクトリ
+		std::filesystem::path directory_;
+
+		// 統計
+		Stats stats_;
+
+		///-------------------------------------------///
+		/// 定数
+		///-------------------------------------------///
+	public:
+
+		// FNV-1aの初期値
+		static const uint64_t kHashOffset = 14695981039346656037ull;
+
+		// FNV-1aの乗数
+		static const uint64_t kHashPrime = 1099511628211ull;
+
+		// ファイルの識別子 ('DXIL')
+		static const uint32_t kFileMagic = 0x4C495844;
+
+		// 形式の版 (ファイルの形式かキーの作り方を変えたら上げて古いキャッシュを使わないようにする)
+		static const uint32_t kFileVersion = 1;
+
+		// インクルードをたどる深さの上限 (循環していても止まるように)
+		static const uint32_t kMaxIncludeDepth = 16;
+	};
+}
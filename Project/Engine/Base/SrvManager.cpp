@@ -17,14 +17,18 @@ SrvManager* SrvManager::GetInstance() {
 }
 
 const uint32_t SrvManager::kMaxSRVCount = 512;
+const uint32_t SrvManager::kTransientSRVCountPerFrame = 64;
 
 void SrvManager::Initialize() {
 
 	// DirectXUtilityのインスタンスを取得
 	this->dxUtility_ = DirectXUtility::GetInstance();
 
+	// 番号の割り当ての初期化 (常駐領域の後ろにフレームごとの一時領域を置く)
+	allocator.Initialize(kMaxSRVCount, &dxUtility_->GetFrameContext(), kTransientSRVCountPerFrame);
+
 	// デスクリプタヒープの作成
-	descriptorHeap = dxUtility_->CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, kMaxSRVCount, true);
+	descriptorHeap = dxUtility_->CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, allocator.GetTotalCount(), true);
 
 	// デスクリプタ1個分のサイズを取得して記録
 	descriptorSize = dxUtility_->GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
@@ -44,30 +48,42 @@ void SrvManager::Finalize() {
 
 uint32_t SrvManager::Allocate() {
 
+	// 番号だけを返す (解放しないので世代は使わない)
+	return AllocateHandle().index;
+}
+
+DescriptorHandle SrvManager::AllocateHandle() {
+
+	// 解放された番号があればそれを再利用
+	DescriptorHandle handle = allocator.Allocate();
+
 	// 上限に達していないかチェックしてassert
-	assert(descriptorSize < kMaxSRVCount);
+	assert(!handle.IsNull());
 
-	/// returnする番号を一旦記録する
-	int index = useIndex;
+	return handle;
+}
 
-	// 次回のために番号を1進める
-	useIndex++;
+void SrvManager::Free(DescriptorHandle handle) {
 
-	// 上で記録した番号をreturn
-	return index;
+	// 解放済みのハンドルを解放しようとしていないかはアロケータで確認する
+	allocator.Free(handle);
 }
 
-bool SrvManager::CheckAllocate() {
+uint32_t SrvManager::AllocateTransient(uint32_t count) {
 
-	// 上限に達していなければtrue
-	if (useIndex < kMaxSRVCount) {
+	// 記録中のフレーム用の範囲から確保
+	uint32_t index = allocator.AllocateTransient(count);
 
-		return true;
-	}
-	else {
+	// 1フレーム分の上限に達していないかチェックしてassert
+	assert(index != UINT32_MAX);
 
-		return false;
-	}
+	return index;
+}
+
+bool SrvManager::CheckAllocate() {
+
+	// 上限に達していないか、解放された番号があればtrue
+	return allocator.CanAllocate();
 }
 
 D3D12_CPU_DESCRIPTOR_HANDLE SrvManager::GetCPUDescriptorHandle(uint32_t index) {
@@ -88,6 +104,22 @@ D3D12_GPU_DESCRIPTOR_HANDLE SrvManager::GetGPUDescriptorHandle(uint32_t index) {
 	return handleGPU;
 }
 
+D3D12_CPU_DESCRIPTOR_HANDLE SrvManager::GetCPUDescriptorHandle(DescriptorHandle handle) {
+
+	// 解放済みのハンドルを使っていないか
+	assert(allocator.IsValid(handle));
+
+	return GetCPUDescriptorHandle(handle.index);
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE SrvManager::GetGPUDescriptorHandle(DescriptorHandle handle) {
+
+	// 解放済みのハンドルを使っていないか
+	assert(allocator.IsValid(handle));
+
+	return GetGPUDescriptorHandle(handle.index);
+}
+
 void SrvManager::CreateSRVforTexture2D(uint32_t srvIndex, ID3D12Resource* pResource, DXGI_FORMAT format, UINT mipLevels) {
 
 	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
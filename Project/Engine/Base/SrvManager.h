@@ -1,5 +1,7 @@
 #pragma once
 
+#include "DescriptorAllocator.h"
+
 #include <stdint.h>
 #include <d3d12.h>
 #include <wrl.h>
@@ -55,11 +57,37 @@ namespace Engine {
 		void Finalize();
 
 		/// <summary>
-		/// 確保
+		/// 確保 (終了まで使い続けるもの用。解放しない)
 		/// </summary>
 		/// <returns></returns>
 		uint32_t Allocate();
 
+		/// <summary>
+		/// 解放できるハンドルとして確保
+		/// </summary>
+		/// <returns></returns>
+		DescriptorHandle AllocateHandle();
+
+		/// <summary>
+		/// 解放 (番号は次の確保で再利用される。GPUが使い終わってから呼ぶこと)
+		/// </summary>
+		/// <param name="handle">ハンドル</param>
+		void Free(DescriptorHandle handle);
+
+		/// <summary>
+		/// ハンドルが有効か
+		/// </summary>
+		/// <param name="handle">ハンドル</param>
+		/// <returns></returns>
+		bool IsValid(DescriptorHandle handle) const { return allocator.IsValid(handle); }
+
+		/// <summary>
+		/// 記録中のフレームだけ使う連続したSRVを確保 (GPUがそのフレームを使い終わると再利用される。並列記録中のスレッドからも呼べる)
+		/// </summary>
+		/// <param name="count">数</param>
+		/// <returns>先頭のSRVインデックス</returns>
+		uint32_t AllocateTransient(uint32_t count = 1);
+
 		/// <summary>
 		/// 確保可能チェック
 		/// </summary>
@@ -70,6 +98,20 @@ namespace Engine {
 
 		D3D12_GPU_DESCRIPTOR_HANDLE GetGPUDescriptorHandle(uint32_t index);
 
+		/// <summary>
+		/// CPUのデスクリプタハンドルを取得 (解放済みのハンドルなら止める)
+		/// </summary>
+		/// <param name="handle">ハンドル</param>
+		/// <returns></returns>
+		D3D12_CPU_DESCRIPTOR_HANDLE GetCPUDescriptorHandle(DescriptorHandle handle);
+
+		/// <summary>
+		/// GPUのデスクリプタハンドルを取得 (解放済みのハンドルなら止める)
+		/// </summary>
+		/// <param name="handle">ハンドル</param>
+		/// <returns></returns>
+		D3D12_GPU_DESCRIPTOR_HANDLE GetGPUDescriptorHandle(DescriptorHandle handle);
+
 		/// <summary>
 		/// SRV生成(テクスチャ用)
 		/// </summary>
@@ -117,6 +159,12 @@ namespace Engine {
 
 		Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> GetDescriptorHeap() { return descriptorHeap; }
 
+		/// <summary>
+		/// デスクリプタアロケータの取得 (統計用)
+		/// </summary>
+		/// <returns></returns>
+		const DescriptorAllocator& GetAllocator() const { return allocator; }
+
 		///-------------------------------------------/// 
 		/// メンバ変数
 		///-------------------------------------------///
@@ -131,8 +179,8 @@ namespace Engine {
 		// SRV用デスクリプタヒープ
 		Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> descriptorHeap;
 
-		// 次に使用するSRVインデックス
-		uint32_t useIndex = 0;
+		// SRVインデックスの割り当て
+		DescriptorAllocator allocator;
 
 		///-------------------------------------------/// 
 		/// 定数
@@ -140,5 +188,8 @@ namespace Engine {
 	public:
 		// 最大SRV数(最大テクスチャ枚数)
 		static const uint32_t kMaxSRVCount;
+
+		// 1フレームで使い捨てるSRVの数 (フレームコンテキストの数だけ並ぶ)
+		static const uint32_t kTransientSRVCountPerFrame;
 	};
 }
\ No newline at end of file
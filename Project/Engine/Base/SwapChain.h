@@ -30,10 +30,15 @@ namespace Engine {
 		void PreDraw();
 
 		/// <summary>
-		/// 描画後
+		/// 描画後 (バックバッファを表示状態にする)
 		/// </summary>
 		void PostDraw();
 
+		/// <summary>
+		/// 画面の交換 (コマンドリストを送信した後にメインスレッドから呼ぶ)
+		/// </summary>
+		void Present();
+
 		///-------------------------------------------/// 
 		/// クラス内関数
 		///-------------------------------------------///
@@ -0,0 +1,53 @@
+#include "UploadAllocator.h"
+#include "FrameCounters.h"
+#include "Logger.h"
+
+#include <cassert>
+
+using namespace Engine;
+
+void UploadAllocator::Initialize(FrameContext* frameContext, uint8_t* cpuBase, uint64_t gpuBase) {
+
+	assert(frameContext);
+	assert(cpuBase);
+
+	// 引数をメンバ変数に設定
+	frameContext_ = frameContext;
+	cpuBase_ = cpuBase;
+	gpuBase_ = gpuBase;
+}
+
+UploadAllocator::Allocation UploadAllocator::Allocate(uint64_t size, uint64_t alignment) {
+
+	// 並列記録中の他のスレッドと同時にリングを進めない
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	// フレームが変わっていたら集計し直す
+	if (frameFenceValue_ != frameContext_->GetCurrentFenceValue()) {
+		frameFenceValue_ = frameContext_->GetCurrentFenceValue();
+		frameBytes_ = 0;
+		isFrameFailed_ = false;
+	}
+
+	// リングから確保
+	uint64_t offset = frameContext_->AllocateUpload(size, alignment);
+
+	// 足りなければ無効な領域を返す (呼び出し側はその描画を飛ばす。続くならリングのサイズを見直す)
+	if (offset == FrameContext::kInvalidOffset) {
+		failedCount_++;
+		if (!isFrameFailed_) {
+			isFrameFailed_ = true;
+			LOG_ERROR("UploadAllocator::Allocate: upload ring exhausted ({} bytes requested, {} bytes used this frame)\n", size, frameBytes_);
+		}
+		return {};
+	}
+
+	// 集計
+	frameBytes_ += size;
+	FrameCounters::GetInstance()->Add(FrameCounters::kUploadBytes, size);
+	if (peakFrameBytes_ < frameBytes_) {
+		peakFrameBytes_ = frameBytes_;
+	}
+
+	return { cpuBase_ + offset, gpuBase_ + offset, size };
+}
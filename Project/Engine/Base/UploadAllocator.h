@@ -0,0 +1,146 @@
+#pragma once
+
+#include "FrameContext.h"
+
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+
+namespace Engine {
+
+	/// === アップロードアロケータ === ///
+	/// 大きなアップロードバッファをフレームコンテキストのリングとして使い、定数やインスタンスのデータを毎フレーム詰めて書き込む
+	/// 確保した領域はそのフレームをGPUが使い終わると自動的に再利用される (個別の解放はない)
+	/// リングが足りなければエラーを出して無効な領域を返すので、呼び出し側はIsValidを見てそのデータを使う描画を飛ばす
+	/// 書き込み先はCPUのアドレスとGPUのアドレスの組で受け取るので、CPUのメモリを渡せばGPUなしでも動く
+	class UploadAllocator {
+
+		///-------------------------------------------///
+		/// 構造体
+		///-------------------------------------------///
+	public:
+
+		// 確保した領域
+		struct Allocation {
+			uint8_t* cpuAddress = nullptr;	// 書き込み先のCPUのアドレス
+			uint64_t gpuAddress = 0;		// シェーダーから参照するGPUのアドレス
+			uint64_t size = 0;				// サイズ
+
+			// 確保できたか (リングが足りなければ無効)
+			bool IsValid() const { return cpuAddress != nullptr; }
+		};
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="frameContext">リングを管理するフレームコンテキスト</param>
+		/// <param name="cpuBase">バッファの先頭のCPUのアドレス (リングのサイズ分書き込めること)</param>
+		/// <param name="gpuBase">バッファの先頭のGPUのアドレス</param>
+		void Initialize(FrameContext* frameContext, uint8_t* cpuBase, uint64_t gpuBase);
+
+		/// <summary>
+		/// 記録中のフレーム用の領域を確保する
+		/// </summary>
+		/// <param name="size">サイズ</param>
+		/// <param name="alignment">アライメント (2のべき乗)</param>
+		/// <returns>確保した領域 (リングが足りなければ無効な領域)</returns>
+		Allocation Allocate(uint64_t size, uint64_t alignment = kConstantBufferAlignment);
+
+		/// <summary>
+		/// データを書き込んだ領域を確保する
+		/// </summary>
+		/// <typeparam name="T">データの型</typeparam>
+		/// <param name="data">データ</param>
+		/// <param name="alignment">アライメント</param>
+		/// <returns>確保した領域</returns>
+		template <typename T>
+		Allocation Push(const T& data, uint64_t alignment = kConstantBufferAlignment) {
+			return PushArray(&data, 1, alignment);
+		}
+
+		/// <summary>
+		/// 配列を書き込んだ領域を確保する
+		/// </summary>
+		/// <typeparam name="T">要素の型</typeparam>
+		/// <param name="data">先頭の要素</param>
+		/// <param name="count">要素数</param>
+		/// <param name="alignment">アライメント</param>
+		/// <returns>確保した領域 (リングが足りなければ無効な領域で、書き込まない)</returns>
+		template <typename T>
+		Allocation PushArray(const T* data, size_t count, uint64_t alignment = kConstantBufferAlignment) {
+			Allocation allocation = Allocate(sizeof(T) * count, alignment);
+			if (allocation.IsValid()) {
+				std::memcpy(allocation.cpuAddress, data, sizeof(T) * count);
+			}
+			return allocation;
+		}
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 今のフレームで確保したバイト数の取得
+		/// </summary>
+		/// <returns></returns>
+		uint64_t GetFrameBytes() const { return frameBytes_; }
+
+		/// <summary>
+		/// 1フレームで確保したバイト数の最大値の取得
+		/// </summary>
+		/// <returns></returns>
+		uint64_t GetPeakFrameBytes() const { return peakFrameBytes_; }
+
+		/// <summary>
+		/// リングが足りずに確保できなかった回数の取得 (起動してからの合計)
+		/// </summary>
+		/// <returns></returns>
+		uint64_t GetFailedCount() const { return failedCount_; }
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// フレームコンテキスト
+		FrameContext* frameContext_ = nullptr;
+
+		// バッファの先頭のCPUのアドレス
+		uint8_t* cpuBase_ = nullptr;
+
+		// バッファの先頭のGPUのアドレス
+		uint64_t gpuBase_ = 0;
+
+		// 集計中のフレームのフェンス値
+		uint64_t frameFenceValue_ = 0;
+
+		// 今のフレームで確保したバイト数
+		uint64_t frameBytes_ = 0;
+
+		// 1フレームで確保したバイト数の最大値
+		uint64_t peakFrameBytes_ = 0;
+
+		// 確保できなかった回数
+		uint64_t failedCount_ = 0;
+
+		// 今のフレームで確保できなかったか (エラーはフレームごとに1度だけ出す)
+		bool isFrameFailed_ = false;
+
+		// 確保を守るミューテックス (コマンドの並列記録中は複数のスレッドから確保される)
+		std::mutex mutex_;
+
+		///-------------------------------------------///
+		/// 定数
+		///-------------------------------------------///
+	public:
+
+		// 定数バッファのアライメント (D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT)
+		static const uint64_t kConstantBufferAlignment = 256;
+	};
+}
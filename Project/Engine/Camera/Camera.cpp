@@ -1,11 +1,14 @@
 #include "Camera.h"
 #include "MathMatrix.h"
+#include "Easing.h"
+#include "GameClock.h"
 #include "WinApp.h"
 
 #include <imgui.h>
 
 using namespace Engine;
 using namespace MathMatrix;
+using namespace Easing;
 
 void Camera::Initialize() {
 
@@ -63,6 +66,25 @@ void Camera::UpdateViewProjectionMatrix() {
 
 void Camera::Update() {
 
+	// ----------補間のために前のステップの状態を残す----------
+	uint64_t step = GameClock::GetStepCount();
+	if (updateStep != step) {
+
+		// 初めての更新では補間しない
+		if (updateStep == UINT64_MAX) {
+			updatedRotate = rotate;
+			updatedTranslate = translate;
+		}
+
+		previousRotate = updatedRotate;
+		previousTranslate = updatedTranslate;
+		updateStep = step;
+	}
+
+	// 同じステップで何度更新しても最後の状態を使う
+	updatedRotate = rotate;
+	updatedTranslate = translate;
+
 	// ビュー行列を更新
 	UpdateViewMatrix();
 
@@ -165,4 +187,38 @@ const Vector3& Camera::GetWorldPosition() const {
 	worldPosition.z = worldMatrix.m[3][2];
 
 	return worldPosition;
-}
\ No newline at end of file
+}
+
+Matrix4x4 Camera::GetInterpolatedViewProjectionMatrix(float alpha) const {
+
+	// 最後のステップでUpdateしていなければ補間しない
+	if (updateStep != GameClock::GetStepCount()) {
+		return viewProjectionMatrix;
+	}
+
+	return GetInterpolatedViewMatrix(alpha) * projectionMatrix;
+}
+
+Matrix4x4 Camera::GetInterpolatedViewMatrix(float alpha) const {
+
+	// 最後のステップでUpdateしていなければ補間しない
+	if (updateStep != GameClock::GetStepCount()) {
+		return viewMatrix;
+	}
+
+	// 回転と平行移動を補間してビュー行列を作り直す
+	Matrix4x4 interpolatedWorldMatrix = MakeAffineMatrix(scale, LerpAngle(previousRotate, updatedRotate, alpha), Lerp(previousTranslate, updatedTranslate, alpha));
+
+	return Inverse(interpolatedWorldMatrix);
+}
+
+Vector3 Camera::GetInterpolatedWorldPosition(float alpha) const {
+
+	// 最後のステップでUpdateしていなければ補間しない
+	if (updateStep != GameClock::GetStepCount()) {
+		return GetWorldPosition();
+	}
+
+	// ワールド行列の平行移動成分は補間した平行移動そのもの
+	return Lerp(previousTranslate, updatedTranslate, alpha);
+}
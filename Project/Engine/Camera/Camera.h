@@ -3,6 +3,8 @@
 #include "Vector3.h"
 #include "Matrix4x4.h"
 
+#include <cstdint>
+
 namespace Engine {
 
 	/// === カメラ === ///
@@ -34,7 +36,7 @@ namespace Engine {
 		void UpdateViewProjectionMatrix();
 
 		/// <summary>
-		/// 更新
+		/// 更新 (補間のために前のステップの回転と平行移動を残す)
 		/// </summary>
 		void Update();
 
@@ -149,6 +151,28 @@ namespace Engine {
 		/// <returns></returns>
 		const Vector3& GetWorldPosition() const;
 
+		/// <summary>
+		/// 描画用に前のステップと最後のステップの間を補間したビュープロジェクション行列の取得
+		/// (最後のステップでUpdateを呼んでいなければ補間しない。ビュー行列を直接設定した場合も同じ)
+		/// </summary>
+		/// <param name="alpha">補間係数 (GameClock::GetAlpha)</param>
+		/// <returns></returns>
+		Matrix4x4 GetInterpolatedViewProjectionMatrix(float alpha) const;
+
+		/// <summary>
+		/// 描画用に前のステップと最後のステップの間を補間したビュー行列の取得 (補間しない条件はビュープロジェクション行列と同じ)
+		/// </summary>
+		/// <param name="alpha">補間係数 (GameClock::GetAlpha)</param>
+		/// <returns></returns>
+		Matrix4x4 GetInterpolatedViewMatrix(float alpha) const;
+
+		/// <summary>
+		/// 描画用に前のステップと最後のステップの間を補間したワールド座標の取得 (補間しない条件はビュープロジェクション行列と同じ)
+		/// </summary>
+		/// <param name="alpha">補間係数 (GameClock::GetAlpha)</param>
+		/// <returns></returns>
+		Vector3 GetInterpolatedWorldPosition(float alpha) const;
+
 		/// <summary>
 		/// ニアクリップ距離のゲッター
 		/// </summary>
@@ -207,5 +231,18 @@ namespace Engine {
 
 		// ファークリップ距離
 		float farClip;
+
+		/// ===== 補間 ===== ///
+
+		// 前のステップの回転と平行移動
+		Vector3 previousRotate = { 0.0f, 0.0f, 0.0f };
+		Vector3 previousTranslate = { 0.0f, 0.0f, 0.0f };
+
+		// 最後にUpdateしたときの回転と平行移動
+		Vector3 updatedRotate = { 0.0f, 0.0f, 0.0f };
+		Vector3 updatedTranslate = { 0.0f, 0.0f, 0.0f };
+
+		// 最後にUpdateしたステップ
+		uint64_t updateStep = UINT64_MAX;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include "FrustumCuller.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <xmmintrin.h>
+
+#ifdef USE_IMGUI
+#include <imgui.h>
+#endif // USE_IMGUI
+
+using namespace Engine;
+
+uint32_t FrustumCuller::Add(const AABB& worldBounds) {
+
+	// 判定済みなら新しい世代を始める
+	if (isCulled_) {
+		count_ = 0;
+		generation_++;
+		isCulled_ = false;
+	}
+
+	// 4の倍数まで確保する (詰め物は判定されるが結果は参照されない)
+	if (centerX_.size() <= count_) {
+		size_t capacity = (static_cast<size_t>(count_) + 4) & ~static_cast<size_t>(3);
+		centerX_.resize(capacity);
+		centerY_.resize(capacity);
+		centerZ_.resize(capacity);
+		extentX_.resize(capacity);
+		extentY_.resize(capacity);
+		extentZ_.resize(capacity);
+		visible_.resize(capacity);
+	}
+
+	// 中心と半分の大きさに分けて格納
+	centerX_[count_] = (worldBounds.min.x + worldBounds.max.x) * 0.5f;
+	centerY_[count_] = (worldBounds.min.y + worldBounds.max.y) * 0.5f;
+	centerZ_[count_] = (worldBounds.min.z + worldBounds.max.z) * 0.5f;
+	extentX_[count_] = (worldBounds.max.x - worldBounds.min.x) * 0.5f;
+	extentY_[count_] = (worldBounds.max.y - worldBounds.min.y) * 0.5f;
+	extentZ_[count_] = (worldBounds.max.z - worldBounds.min.z) * 0.5f;
+
+	return count_++;
+}
+
+void FrustumCuller::Cull(const Matrix4x4& viewProjectionMatrix) {
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	// 視錐台の平面を取り出す
+	ExtractPlanes(viewProjectionMatrix);
+
+	visibleCount_ = 0;
+
+	// 4個ずつ判定する
+	for (uint32_t i = 0; i < count_; i += 4) {
+
+		__m128 centerX = _mm_loadu_ps(&centerX_[i]);
+		__m128 centerY = _mm_loadu_ps(&centerY_[i]);
+		__m128 centerZ = _mm_loadu_ps(&centerZ_[i]);
+		__m128 extentX = _mm_loadu_ps(&extentX_[i]);
+		__m128 extentY = _mm_loadu_ps(&extentY_[i]);
+		__m128 extentZ = _mm_loadu_ps(&extentZ_[i]);
+
+		// どれかの平面の完全に外側にあれば見えない
+		__m128 outside = _mm_setzero_ps();
+
+		for (const float (&plane)[4] : planes_) {
+
+			// 中心から平面までの距離
+			__m128 distance = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(centerX, _mm_set1_ps(plane[0])), _mm_mul_ps(centerY, _mm_set1_ps(plane[1]))),
+				_mm_add_ps(_mm_mul_ps(centerZ, _mm_set1_ps(plane[2])), _mm_set1_ps(plane[3])));
+
+			// 境界ボックスの法線方向の半径
+			__m128 radius = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(extentX, _mm_set1_ps(std::fabs(plane[0]))), _mm_mul_ps(extentY, _mm_set1_ps(std::fabs(plane[1])))),
+				_mm_mul_ps(extentZ, _mm_set1_ps(std::fabs(plane[2]))));
+
+			// 距離 + 半径 < 0 なら外側
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+		}
+
+		// 結果を書き込む
+		int outsideMask = _mm_movemask_ps(outside);
+		uint32_t laneCount = (std::min)(4u, count_ - i);
+		for (uint32_t lane = 0; lane < laneCount; ++lane) {
+			visible_[i + lane] = ((outsideMask >> lane) & 1) ? 0 : 1;
+			visibleCount_ += visible_[i + lane];
+		}
+	}
+
+	// 統計を記録
+	testedCount_ = count_;
+	cullMicroseconds_ = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+	// 判定済みにする
+	isCulled_ = true;
+}
+
+bool FrustumCuller::IsVisible(uint32_t index, uint32_t generation) const {
+
+	// 現在の世代を判定済みでなければ見えるものとして扱う
+	if (generation != generation_ || !isCulled_ || count_ <= index) {
+		return true;
+	}
+
+	return visible_[index] != 0;
+}
+
+void FrustumCuller::ShowImGui() {
+
+#ifdef USE_IMGUI
+
+	ImGui::Begin("FrustumCuller");
+
+	ImGui::Text("Tested: %u", testedCount_);
+	ImGui::Text("Visible: %u  Culled: %u", visibleCount_, GetCulledCount());
+	ImGui::Text("Cull: %.1f us", cullMicroseconds_);
+
+	ImGui::End();
+
+#endif // USE_IMGUI
+}
+
+AABB FrustumCuller::TransformBounds(const AABB& localBounds, const Matrix4x4& worldMatrix) {
+
+	// ローカルの中心と半分の大きさ
+	float center[3] = { (localBounds.min.x + localBounds.max.x) * 0.5f, (localBounds.min.y + localBounds.max.y) * 0.5f, (localBounds.min.z + localBounds.max.z) * 0.5f };
+	float extent[3] = { (localBounds.max.x - localBounds.min.x) * 0.5f, (localBounds.max.y - localBounds.min.y) * 0.5f, (localBounds.max.z - localBounds.min.z) * 0.5f };
+
+	// 中心は行列で変換し、半分の大きさは行列の絶対値で変換する (行ベクトル * 行列)
+	float worldCenter[3];
+	float worldExtent[3];
+	for (int column = 0; column < 3; ++column) {
+		worldCenter[column] = worldMatrix.m[3][column];
+		worldExtent[column] = 0.0f;
+		for (int row = 0; row < 3; ++row) {
+			worldCenter[column] += center[row] * worldMatrix.m[row][column];
+			worldExtent[column] += extent[row] * std::fabs(worldMatrix.m[row][column]);
+		}
+	}
+
+	return AABB{
+		{ worldCenter[0] - worldExtent[0], worldCenter[1] - worldExtent[1], worldCenter[2] - worldExtent[2] },
+		{ worldCenter[0] + worldExtent[0], worldCenter[1] + worldExtent[1], worldCenter[2] + worldExtent[2] }
+	};
+}
+
+void FrustumCuller::ExtractPlanes(const Matrix4x4& viewProjectionMatrix) {
+
+	// 行ベクトル * 行列なので、クリップ座標の各成分は行列の列との内積になる
+	auto column = [&viewProjectionMatrix](int index, float (&out)[4]) {
+		for (int row = 0; row < 4; ++row) {
+			out[row] = viewProjectionMatrix.m[row][index];
+		}
+	};
+
+	float x[4], y[4], z[4], w[4];
+	column(0, x);
+	column(1, y);
+	column(2, z);
+	column(3, w);
+
+	for (int i = 0; i < 4; ++i) {
+		planes_[0][i] = w[i] + x[i];	// 左   -w <= x
+		planes_[1][i] = w[i] - x[i];	// 右    x <= w
+		planes_[2][i] = w[i] + y[i];	// 下   -w <= y
+		planes_[3][i] = w[i] - y[i];	// 上    y <= w
+		planes_[4][i] = z[i];			// 近    0 <= z
+		planes_[5][i] = w[i] - z[i];	// 遠    z <= w
+	}
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "AABB.h"
+#include "Matrix4x4.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+
+	/// === 視錐台カリング === ///
+	/// ワールド空間の境界ボックスを中心と半分の大きさに分けてSoAで持ち、4個ずつSIMDで視錐台の6平面と判定する
+	/// 1フレームの流れ : Addで登録 -> Cullでまとめて判定 -> IsVisibleで結果を参照 (次のAddで新しい世代になる)
+	/// 行列と境界ボックスだけを扱うのでグラフィックスAPIには依存しない
+	class FrustumCuller {
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 境界ボックスの登録 (判定済みの世代なら登録を空にして新しい世代を始める)
+		/// </summary>
+		/// <param name="worldBounds">ワールド空間の境界ボックス</param>
+		/// <returns>登録番号</returns>
+		uint32_t Add(const AABB& worldBounds);
+
+		/// <summary>
+		/// 登録された境界ボックスをまとめて判定する
+		/// </summary>
+		/// <param name="viewProjectionMatrix">ビュープロジェクション行列</param>
+		void Cull(const Matrix4x4& viewProjectionMatrix);
+
+		/// <summary>
+		/// 見えるか (別の世代の番号や、まだ判定していなければ見えるものとして扱う)
+		/// </summary>
+		/// <param name="index">登録番号</param>
+		/// <param name="generation">登録したときの世代</param>
+		/// <returns></returns>
+		bool IsVisible(uint32_t index, uint32_t generation) const;
+
+		/// <summary>
+		/// ImGui表示
+		/// </summary>
+		void ShowImGui();
+
+		/// <summary>
+		/// ローカル空間の境界ボックスをワールド空間に変換する (変換後の8頂点を囲む境界ボックス)
+		/// </summary>
+		/// <param name="localBounds">ローカル空間の境界ボックス</param>
+		/// <param name="worldMatrix">ワールド行列</param>
+		/// <returns>ワールド空間の境界ボックス</returns>
+		static AABB TransformBounds(const AABB& localBounds, const Matrix4x4& worldMatrix);
+
+		///-------------------------------------------///
+		/// クラス内関数
+		///-------------------------------------------///
+	private:
+
+		/// <summary>
+		/// ビュープロジェクション行列から視錐台の6平面を取り出す (内側が正)
+		/// </summary>
+		/// <param name="viewProjectionMatrix">ビュープロジェクション行列</param>
+		void ExtractPlanes(const Matrix4x4& viewProjectionMatrix);
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 現在の世代の取得
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetGeneration() const { return generation_; }
+
+		/// <summary>
+		/// 前回のCullで判定した数の取得
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetTestedCount() const { return testedCount_; }
+
+		/// <summary>
+		/// 前回のCullで見えた数の取得
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetVisibleCount() const { return visibleCount_; }
+
+		/// <summary>
+		/// 前回のCullで除外した数の取得
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetCulledCount() const { return testedCount_ - visibleCount_; }
+
+		/// <summary>
+		/// 前回のCullにかかった時間(マイクロ秒)の取得
+		/// </summary>
+		/// <returns></returns>
+		float GetCullMicroseconds() const { return cullMicroseconds_; }
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// 境界ボックスの中心 (SoA、4の倍数まで詰め物をする)
+		std::vector<float> centerX_;
+		std::vector<float> centerY_;
+		std::vector<float> centerZ_;
+
+		// 境界ボックスの半分の大きさ (SoA、4の倍数まで詰め物をする)
+		std::vector<float> extentX_;
+		std::vector<float> extentY_;
+		std::vector<float> extentZ_;
+
+		// 判定結果 (1なら見える)
+		std::vector<uint8_t> visible_;
+
+		// 視錐台の平面 (法線xyzと距離) 左、右、下、上、近、遠
+		float planes_[6][4] = {};
+
+		// 登録された数
+		uint32_t count_ = 0;
+
+		// 世代
+		uint32_t generation_ = 1;
+
+		// 現在の世代を判定済みか
+		bool isCulled_ = false;
+
+		// 前回判定した数
+		uint32_t testedCount_ = 0;
+
+		// 前回見えた数
+		uint32_t visibleCount_ = 0;
+
+		// 前回の判定にかかった時間(マイクロ秒)
+		float cullMicroseconds_ = 0.0f;
+	};
+}
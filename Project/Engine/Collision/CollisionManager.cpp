@@ -1,6 +1,8 @@
 #include "CollisionManager.h"
 #include "Collider.h"
 #include "MathVector.h"
+#include "Profiler.h"
+#include "FrameCounters.h"
 
 #include <algorithm>
 
@@ -54,6 +56,12 @@ void CollisionManager::AddCollider(Collider* collider) {
 
 void CollisionManager::CheckAllCollisions() {
 
+	PROFILE_SCOPE("CollisionManager::CheckAllCollisions");
+
+	// 判定するペアの数を数える
+	uint64_t colliderCount = colliders_.size();
+	FrameCounters::GetInstance()->Add(FrameCounters::kColliderPairTests, colliderCount * (colliderCount - 1) / 2);
+
 	// リスト内のペアを総当りする
 
 	// イテレータAはリストの先頭から回す
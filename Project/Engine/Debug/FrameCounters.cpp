@@ -0,0 +1,262 @@
+#include "FrameCounters.h"
+
+#include <cfloat>
+#include <cstdlib>
+#include <new>
+#include <imgui.h>
+
+using namespace Engine;
+
+FrameCounters* FrameCounters::instance = nullptr;
+
+FrameCounters* FrameCounters::GetInstance() {
+
+	if (instance == nullptr) {
+		instance = new FrameCounters;
+	}
+	return instance;
+}
+
+void FrameCounters::Finalize() {
+
+	// 書き出し中のCSVを閉じる
+	StopCsv();
+
+	delete instance;
+	instance = nullptr;
+}
+
+FrameCounters::CounterID FrameCounters::Register(const std::string& name, Kind kind) {
+
+	std::lock_guard<std::mutex> lock(registerMutex_);
+
+	uint32_t count = counterCount_.load(std::memory_order_relaxed);
+
+	// 登録済みならその番号
+	for (uint32_t i = 0; i < count; ++i) {
+		if (names_[i] == name) {
+			return i;
+		}
+	}
+
+	// 上限を超えたら数えない
+	if (count >= kMaxCounterCount) {
+		return kInvalidCounterID;
+	}
+
+	names_[count] = name;
+	kinds_[count] = kind;
+	counterCount_.store(count + 1, std::memory_order_release);
+
+	return count;
+}
+
+void FrameCounters::Add(CounterID id, uint64_t value) {
+
+	if (id >= kMaxCounterCount) {
+		return;
+	}
+
+	values_[id].fetch_add(value, std::memory_order_relaxed);
+}
+
+void FrameCounters::Set(CounterID id, uint64_t value) {
+
+	if (id >= kMaxCounterCount) {
+		return;
+	}
+
+	values_[id].store(value, std::memory_order_relaxed);
+}
+
+void FrameCounters::CountDraw(uint32_t instanceCount, uint32_t rootParameterBindCount) {
+
+	Add(kDrawCalls);
+	Add(kInstances, instanceCount);
+	Add(kRootParameterBinds, rootParameterBindCount);
+}
+
+void FrameCounters::CountHeapAllocation() {
+
+	// 作る途中や破棄した後はoperator newから呼ばれても数えない
+	if (instance == nullptr) {
+		return;
+	}
+
+	instance->Add(kHeapAllocations);
+}
+
+void FrameCounters::BeginFrame() {
+
+	uint32_t count = counterCount_.load(std::memory_order_acquire);
+
+	// ----------前のフレームの値を取り出す----------
+	for (uint32_t i = 0; i < count; ++i) {
+
+		// カウンターは0に戻し、ゲージはそのまま残す
+		if (kinds_[i] == Kind::Counter) {
+			lastValues_[i] = values_[i].exchange(0, std::memory_order_relaxed);
+		}
+		else {
+			lastValues_[i] = values_[i].load(std::memory_order_relaxed);
+		}
+
+		history_[i][historyIndex_] = static_cast<float>(lastValues_[i]);
+	}
+
+	historyIndex_ = (historyIndex_ + 1) % kHistoryFrameCount;
+
+	// ----------CSVに1行書く----------
+	if (csvFile_.is_open()) {
+
+		csvFile_ << frameIndex_;
+		for (uint32_t i = 0; i < csvColumnCount_; ++i) {
+			csvFile_ << ',' << lastValues_[i];
+		}
+		csvFile_ << '\n';
+	}
+
+	frameIndex_++;
+}
+
+uint64_t FrameCounters::GetValue(CounterID id) const {
+
+	if (id >= kMaxCounterCount) {
+		return 0;
+	}
+
+	return lastValues_[id];
+}
+
+const std::string& FrameCounters::GetName(CounterID id) const {
+
+	static const std::string kEmptyName;
+
+	if (id >= GetCounterCount()) {
+		return kEmptyName;
+	}
+
+	return names_[id];
+}
+
+bool FrameCounters::StartCsv(const std::filesystem::path& filePath) {
+
+	StopCsv();
+
+	csvFile_.open(filePath, std::ios::trunc);
+	if (!csvFile_) {
+		return false;
+	}
+
+	// 見出しの行
+	csvColumnCount_ = GetCounterCount();
+	csvFile_ << "Frame";
+	for (uint32_t i = 0; i < csvColumnCount_; ++i) {
+		csvFile_ << ',' << names_[i];
+	}
+	csvFile_ << '\n';
+
+	return true;
+}
+
+void FrameCounters::StopCsv() {
+
+	if (csvFile_.is_open()) {
+		csvFile_.close();
+	}
+	csvFile_.clear();
+	csvColumnCount_ = 0;
+}
+
+void FrameCounters::ShowImGui() {
+
+#ifdef USE_IMGUI
+
+	ImGui::Begin("FrameCounters");
+
+	// CSVの書き出し
+	if (!IsWritingCsv()) {
+		if (ImGui::Button("StartCsv")) {
+			StartCsv("FrameCounters.csv");
+		}
+	}
+	else {
+		if (ImGui::Button("StopCsv")) {
+			StopCsv();
+		}
+	}
+
+	// ----------前のフレームの値と履歴----------
+	if (ImGui::BeginTable("FrameCounters", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+
+		ImGui::TableSetupColumn("Name");
+		ImGui::TableSetupColumn("Value");
+		ImGui::TableSetupColumn("History");
+		ImGui::TableHeadersRow();
+
+		uint32_t count = GetCounterCount();
+		for (uint32_t i = 0; i < count; ++i) {
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(names_[i].c_str());
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", static_cast<unsigned long long>(lastValues_[i]));
+			ImGui::TableNextColumn();
+
+			// 古い順に並ぶように次に書き込む場所から描く
+			ImGui::PushID(static_cast<int>(i));
+			ImGui::PlotLines("##History", history_[i].data(), static_cast<int>(kHistoryFrameCount), static_cast<int>(historyIndex_), nullptr, FLT_MAX, FLT_MAX, ImVec2(-1.0f, 0.0f));
+			ImGui::PopID();
+		}
+
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+
+#endif // USE_IMGUI
+}
+
+/// ===== ヒープの確保を数える ===== ///
+/// 配列版とnothrow版の標準の実装はこれらを呼ぶので、通常版だけを置き換える
+/// アライメント指定版は標準の実装のまま (専用の確保と解放で対になっている)
+/// 確保のたびに数えるのは計測のためなので、デバッグ用の機能と同じくUSE_IMGUIのビルドでだけ置き換える
+
+#ifdef USE_IMGUI
+
+void* operator new(std::size_t size) {
+
+	FrameCounters::CountHeapAllocation();
+
+	// 0バイトでも別々のアドレスを返す
+	if (size == 0) {
+		size = 1;
+	}
+
+	// 確保できなければnew_handlerに空けてもらって繰り返す
+	while (true) {
+
+		if (void* pointer = std::malloc(size)) {
+			return pointer;
+		}
+
+		std::new_handler handler = std::get_new_handler();
+		if (handler == nullptr) {
+			throw std::bad_alloc();
+		}
+		handler();
+	}
+}
+
+void operator delete(void* pointer) noexcept {
+
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+
+	std::free(pointer);
+}
+
+#endif // USE_IMGUI
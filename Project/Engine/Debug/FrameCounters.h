@@ -0,0 +1,236 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace Engine {
+
+	/// === フレームの統計のカウンター === ///
+	/// エンジンの各所で描画や確保の数を足し、フレームの始めにまとめて前のフレームの値として取り出す
+	/// 足すのはアトミック変数への加算だけなので、ロックを使わずにどのスレッドからでも呼べる
+	/// 取り出した値はImGuiで確認でき、CSVに1フレーム1行で書き出して性能の比較に使える
+	class FrameCounters {
+
+		///-------------------------------------------///
+		/// シングルトン
+		///-------------------------------------------///
+	private:
+
+		// インスタンス
+		static FrameCounters* instance;
+
+		// コンストラクタの隠蔽
+		FrameCounters() = default;
+		// デストラクタの隠蔽
+		~FrameCounters() = default;
+		// コピーコンストラクタの封印
+		FrameCounters(FrameCounters&) = delete;
+		// コピー代入演算子の封印
+		FrameCounters& operator=(FrameCounters&) = delete;
+
+		///-------------------------------------------///
+		/// 構造体
+		///-------------------------------------------///
+	public:
+
+		// カウンターの番号
+		using CounterID = uint32_t;
+
+		// カウンターの種類
+		enum class Kind {
+			Counter,	// フレームごとに0に戻して足す (描画数など)
+			Gauge,		// 最後に設定した値を保つ (生きているパーティクルの数など)
+		};
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// シングルトンインスタンスの取得
+		/// </summary>
+		/// <returns></returns>
+		static FrameCounters* GetInstance();
+
+		/// <summary>
+		/// 終了 (CSVを閉じてインスタンスを破棄する。ワーカースレッドを止めた後に呼ぶ)
+		/// </summary>
+		void Finalize();
+
+		/// <summary>
+		/// カウンターの登録 (組み込みのカウンター以外を追加する)
+		/// </summary>
+		/// <param name="name">名前 (同じ名前なら同じ番号を返す)</param>
+		/// <param name="kind">種類</param>
+		/// <returns>番号 (上限を超えたらkInvalidCounterID)</returns>
+		CounterID Register(const std::string& name, Kind kind = Kind::Counter);
+
+		/// <summary>
+		/// カウンターに足す
+		/// </summary>
+		/// <param name="id">番号</param>
+		/// <param name="value">足す値</param>
+		void Add(CounterID id, uint64_t value = 1);
+
+		/// <summary>
+		/// カウンターに設定する (ゲージ用)
+		/// </summary>
+		/// <param name="id">番号</param>
+		/// <param name="value">値</param>
+		void Set(CounterID id, uint64_t value);
+
+		/// <summary>
+		/// 描画1回分を数える
+		/// </summary>
+		/// <param name="instanceCount">インスタンス数</param>
+		/// <param name="rootParameterBindCount">描画の前に設定したルートパラメータの数</param>
+		void CountDraw(uint32_t instanceCount, uint32_t rootParameterBindCount);
+
+		/// <summary>
+		/// ヒープの確保を1回数える (operator newから呼ぶ。確保が起きるのでインスタンスは作らず、作られていなければ何もしない)
+		/// </summary>
+		static void CountHeapAllocation();
+
+		/// <summary>
+		/// フレームの開始 (前のフレームの値を取り出してカウンターを0に戻す。メインスレッドから毎フレーム呼ぶ)
+		/// </summary>
+		void BeginFrame();
+
+		/// <summary>
+		/// CSVの書き出しの開始 (その時点で登録されているカウンターを列にして、以降のフレームを1行ずつ書く)
+		/// </summary>
+		/// <param name="filePath">書き出すファイルパス</param>
+		/// <returns>開けたか</returns>
+		bool StartCsv(const std::filesystem::path& filePath);
+
+		/// <summary>
+		/// CSVの書き出しの終了
+		/// </summary>
+		void StopCsv();
+
+		/// <summary>
+		/// ImGui表示
+		/// </summary>
+		void ShowImGui();
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 前のフレームの値の取得
+		/// </summary>
+		/// <param name="id">番号</param>
+		/// <returns></returns>
+		uint64_t GetValue(CounterID id) const;
+
+		/// <summary>
+		/// 名前の取得
+		/// </summary>
+		/// <param name="id">番号</param>
+		/// <returns></returns>
+		const std::string& GetName(CounterID id) const;
+
+		/// <summary>
+		/// 登録されたカウンターの数の取得
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetCounterCount() const { return counterCount_.load(std::memory_order_acquire); }
+
+		/// <summary>
+		/// CSVを書き出し中かの取得
+		/// </summary>
+		/// <returns></returns>
+		bool IsWritingCsv() const { return csvFile_.is_open(); }
+
+		///-------------------------------------------///
+		/// 定数
+		///-------------------------------------------///
+	public:
+
+		// 組み込みのカウンター
+		static const CounterID kDrawCalls = 0;				// 描画の回数
+		static const CounterID kInstances = 1;				// 描画したインスタンスの数
+		static const CounterID kRootParameterBinds = 2;		// ルートパラメータの設定の回数
+		static const CounterID kUploadBytes = 3;			// アップロードバッファに書き込んだバイト数
+		static const CounterID kDescriptorAllocations = 4;	// デスクリプタの確保の数
+		static const CounterID kLiveParticles = 5;			// 生きているパーティクルの数
+		static const CounterID kColliderPairTests = 6;		// コライダーのペアの判定の回数
+		static const CounterID kHeapAllocations = 7;		// ヒープの確保の回数 (USE_IMGUIのビルドでoperator newを置き換えたときだけ数える)
+
+		// 組み込みのカウンターの数
+		static const uint32_t kBuiltInCounterCount = 8;
+
+		// カウンターの数の上限
+		static const uint32_t kMaxCounterCount = 64;
+
+		// 登録できなかったときの番号 (足しても何もしない)
+		static const CounterID kInvalidCounterID = UINT32_MAX;
+
+		// ImGuiのグラフに残すフレーム数
+		static const uint32_t kHistoryFrameCount = 120;
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// 値 (上限の数だけ先に用意しておくので、登録と加算が重なっても場所は変わらない)
+		std::array<std::atomic<uint64_t>, kMaxCounterCount> values_{};
+
+		// 名前 (登録した後は書き換えない)
+		std::array<std::string, kMaxCounterCount> names_ = {
+			"DrawCalls",
+			"Instances",
+			"RootParameterBinds",
+			"UploadBytes",
+			"DescriptorAllocations",
+			"LiveParticles",
+			"ColliderPairTests",
+			"HeapAllocations",
+		};
+
+		// 種類
+		std::array<Kind, kMaxCounterCount> kinds_ = {
+			Kind::Counter,
+			Kind::Counter,
+			Kind::Counter,
+			Kind::Counter,
+			Kind::Counter,
+			Kind::Gauge,
+			Kind::Counter,
+			Kind::Counter,
+		};
+
+		// 登録されたカウンターの数 (名前と種類を書いてから増やす)
+		std::atomic<uint32_t> counterCount_ = kBuiltInCounterCount;
+
+		// 登録同士が重ならないようにする
+		std::mutex registerMutex_;
+
+		// 前のフレームの値
+		std::array<uint64_t, kMaxCounterCount> lastValues_{};
+
+		// ImGuiのグラフ用の値の履歴
+		std::array<std::array<float, kHistoryFrameCount>, kMaxCounterCount> history_{};
+
+		// 次に書き込む履歴の場所
+		uint32_t historyIndex_ = 0;
+
+		// フレーム番号
+		uint64_t frameIndex_ = 0;
+
+		// CSVのファイル
+		std::ofstream csvFile_;
+
+		// CSVの列の数 (書き出しを始めたときのカウンターの数)
+		uint32_t csvColumnCount_ = 0;
+	};
+}
@@ -1,9 +1,463 @@
 #include "Logger.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
 #include <Windows.h>
+#endif // _WIN32
 
 using namespace Engine;
 
+namespace {
+
+	struct RecordPool;
+}
+
+// キューに積むログ
+struct Logger::Record {
+	std::atomic<Record*> next = nullptr;	// 次のログ (プールに返したものは返したものどうしで繋ぐ)
+	Logger::Severity severity;				// 重要度
+	uint64_t timestamp;						// 時刻(ナノ秒)
+	uint32_t threadIndex;					// 書いたスレッドの番号
+	RecordPool* pool = nullptr;				// 取り出したプール
+	std::string message;					// ログ
+};
+
+namespace {
+
+	using Record = Logger::Record;
+
+	// 1つのプールに取っておくログの数の上限 (書き込みが追いつかずに増えた分は捨てる)
+	const size_t kMaxPooledRecordCount = 256;
+
+	// プールに返すときに本文の領域を残しておく大きさの上限 (長いログの領域は返すときに手放す)
+	const size_t kMaxPooledMessageCapacity = 1024;
+
+	// ----------スレッドごとのログのプール----------
+	// 取り出すのは持ち主のスレッドだけで、書き込み用のスレッドは書き込み終わったものを返却リストに繋ぐだけ
+	// 返却リストは持ち主がまとめて引き取るので、ロックを使わずに受け渡せる
+	struct RecordPool {
+
+		// 取り出せるログ (持ち主のスレッドだけが使う)
+		std::vector<Record*> freeRecords;
+
+		// 書き込み終わって返されたログ (nextで繋ぐ)
+		std::atomic<Record*> returnedRecords = nullptr;
+
+		// 持ち主のスレッドがいるか (スレッドが終わったプールは次に来たスレッドが引き継ぐ)
+		std::atomic<bool> isOwned = false;
+
+		~RecordPool() {
+			for (Record* record : freeRecords) {
+				delete record;
+			}
+			Record* record = returnedRecords.load(std::memory_order_acquire);
+			while (record) {
+				Record* next = record->next.load(std::memory_order_relaxed);
+				delete record;
+				record = next;
+			}
+		}
+	};
+
+	// 全てのプール (スレッドが終わっても書き込み中のログが返ってくるので、プールは手放さない)
+	std::mutex poolsMutex;
+	std::vector<std::unique_ptr<RecordPool>> pools;
+
+	// スレッドが持っているプール (スレッドが終わったら手放す)
+	struct PoolOwner {
+		RecordPool* pool = nullptr;
+		~PoolOwner() {
+			if (pool) {
+				pool->isOwned.store(false, std::memory_order_release);
+			}
+		}
+	};
+	thread_local PoolOwner poolOwner;
+
+	// ----------複数のスレッドから積んで1つのスレッドが取り出すキュー----------
+	// 積む側はheadを差し替えて前のログに繋ぐだけなのでロックを使わない
+	// 空のときも番兵を1つ残しておく
+
+	// 番兵
+	Record stub;
+
+	// 最後に積んだログ (積む側が使う)
+	std::atomic<Record*> head = &stub;
+
+	// 次に取り出すログ (取り出す側だけが使う)
+	Record* tail = &stub;
+
+	// 積んだ数と書き込んだ数 (Flushで待つのに使う)
+	std::atomic<uint64_t> pushedCount = 0;
+	std::atomic<uint64_t> writtenCount = 0;
+
+	// 書き込み用のスレッドを起こす合図
+	std::atomic<uint32_t> signal = 0;
+
+	// 書き込み用のスレッドが合図を待って寝ているか (積む側は寝ているときだけ起こす)
+	std::atomic<bool> isWriterSleeping = false;
+
+	// 書き込み用のスレッド
+	std::thread writerThread;
+
+	// 書き込み用のスレッドが動いているか
+	std::atomic<bool> isRunning = false;
+
+	// 止めるか
+	std::atomic<bool> isStopping = false;
+
+	// 出力先
+	uint32_t sinkFlags = Logger::kSinkDebugger;
+
+	// 出力するファイル
+	std::ofstream file;
+
+	// 実行時に出力する重要度の下限
+	std::atomic<Logger::Severity> minSeverity = Logger::kCompiledMinSeverity;
+
+	// 時刻の基準
+	const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+	// スレッドの番号
+	std::atomic<uint32_t> nextThreadIndex = 0;
+	thread_local uint32_t threadIndex = nextThreadIndex.fetch_add(1);
+
+	// このスレッドのプールの取得 (初めて呼んだときに持ち主のいないプールを引き継ぐか作る)
+	RecordPool& GetThreadPool() {
+
+		if (poolOwner.pool) {
+			return *poolOwner.pool;
+		}
+
+		std::lock_guard<std::mutex> lock(poolsMutex);
+		for (std::unique_ptr<RecordPool>& pool : pools) {
+			bool isOwned = false;
+			if (pool->isOwned.compare_exchange_strong(isOwned, true, std::memory_order_acquire)) {
+				poolOwner.pool = pool.get();
+				return *pool;
+			}
+		}
+
+		std::unique_ptr<RecordPool> pool = std::make_unique<RecordPool>();
+		pool->freeRecords.reserve(kMaxPooledRecordCount);
+		pool->isOwned.store(true, std::memory_order_relaxed);
+		poolOwner.pool = pool.get();
+		pools.push_back(std::move(pool));
+		return *poolOwner.pool;
+	}
+
+	// 書き込み終わったログを取り出したプールへ返す (どのスレッドからでも呼べる)
+	void ReleaseRecord(Record* record) {
+
+		// 長いログの領域は残さない
+		if (record->message.capacity() > kMaxPooledMessageCapacity) {
+			std::string().swap(record->message);
+		}
+
+		// 返却リストの先頭に繋ぐ (持ち主はまとめて引き取るだけなので、途中のものが入れ替わることはない)
+		RecordPool* pool = record->pool;
+		Record* first = pool->returnedRecords.load(std::memory_order_relaxed);
+		do {
+			record->next.store(first, std::memory_order_relaxed);
+		} while (!pool->returnedRecords.compare_exchange_weak(first, record, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	// キューに積む
+	void Push(Record* record) {
+
+		record->next.store(nullptr, std::memory_order_relaxed);
+
+		// 最後に積んだものを差し替えてから前のものに繋ぐ
+		Record* previous = head.exchange(record, std::memory_order_acq_rel);
+		previous->next.store(record, std::memory_order_release);
+	}
+
+	// キューから取り出す (空か、積んでいる途中のものしかなければnullptr)
+	Record* Pop() {
+
+		Record* record = tail;
+		Record* next = record->next.load(std::memory_order_acquire);
+
+		// 番兵は飛ばす
+		if (record == &stub) {
+			if (next == nullptr) {
+				return nullptr;
+			}
+			tail = next;
+			record = next;
+			next = next->next.load(std::memory_order_acquire);
+		}
+
+		// 次があればこれを返せる
+		if (next) {
+			tail = next;
+			return record;
+		}
+
+		// 最後の1つでなければ、後ろのものを積んでいる途中
+		if (record != head.load(std::memory_order_acquire)) {
+			return nullptr;
+		}
+
+		// 最後の1つを返すために番兵を後ろに積み直す
+		Push(&stub);
+
+		next = record->next.load(std::memory_order_acquire);
+		if (next) {
+			tail = next;
+			return record;
+		}
+
+		return nullptr;
+	}
+
+	// 出力先に書き込む
+	void WriteRecord(const Record& record) {
+
+		// 末尾の改行は付け直すので取り除く
+		std::string_view message = record.message;
+		if (!message.empty() && message.back() == '\n') {
+			message.remove_suffix(1);
+		}
+
+		std::string line = std::format("[{:.3f}][{}][T{}] {}\n",
+			static_cast<double>(record.timestamp) / 1000000000.0, Logger::GetSeverityName(record.severity), record.threadIndex, message);
+
+		if (sinkFlags & Logger::kSinkDebugger) {
+#ifdef _WIN32
+			OutputDebugStringA(line.c_str());
+#else
+			std::fputs(line.c_str(), stderr);
+#endif // _WIN32
+		}
+
+		if (sinkFlags & Logger::kSinkStdout) {
+			std::fputs(line.c_str(), stdout);
+		}
+
+		if ((sinkFlags & Logger::kSinkFile) && file.is_open()) {
+			file << line;
+		}
+	}
+
+	// 積まれているログを全て書き込む
+	void Drain() {
+
+		uint64_t count = 0;
+		while (Record* record = Pop()) {
+			WriteRecord(*record);
+			ReleaseRecord(record);
+			count++;
+		}
+
+		if (count == 0) {
+			return;
+		}
+
+		// ファイルはまとめて書き出す
+		if (file.is_open()) {
+			file.flush();
+		}
+
+		writtenCount.fetch_add(count, std::memory_order_release);
+		writtenCount.notify_all();
+	}
+
+	// 書き込み用のスレッドの処理
+	void WriterMain() {
+
+		while (true) {
+
+			// 合図を見てから取り出す (取り出した後に積まれたら合図が変わっているので待たずに戻る)
+			uint32_t observed = signal.load(std::memory_order_acquire);
+
+			Drain();
+
+			// 全て書き込んだら次の合図を待つ
+			if (writtenCount.load(std::memory_order_acquire) >= pushedCount.load(std::memory_order_acquire)) {
+
+				if (isStopping.load(std::memory_order_acquire)) {
+					return;
+				}
+
+				// 寝ることを知らせてから積まれていないかを見直す (見直した後に積まれたら、積む側が合図を変えて起こす)
+				isWriterSleeping.store(true, std::memory_order_seq_cst);
+				if (writtenCount.load(std::memory_order_seq_cst) >= pushedCount.load(std::memory_order_seq_cst)) {
+					signal.wait(observed, std::memory_order_acquire);
+				}
+				isWriterSleeping.store(false, std::memory_order_relaxed);
+			}
+			// 積んでいる途中のものがあれば少し待つ
+			else {
+				std::this_thread::yield();
+			}
+		}
+	}
+}
+
+void Logger::Initialize(uint32_t sinks, const std::filesystem::path& filePath) {
+
+	// 既に動いていれば止めてから設定し直す
+	Finalize();
+
+	sinkFlags = sinks;
+
+	// ファイルを開く
+	if ((sinkFlags & kSinkFile) && !filePath.empty()) {
+
+		std::error_code errorCode;
+		if (filePath.has_parent_path()) {
+			std::filesystem::create_directories(filePath.parent_path(), errorCode);
+		}
+		file.open(filePath, std::ios::trunc);
+	}
+
+	// 書き込み用のスレッドを起動
+	isStopping.store(false, std::memory_order_release);
+	writerThread = std::thread(WriterMain);
+	isRunning.store(true, std::memory_order_release);
+}
+
+void Logger::Finalize() {
+
+	if (!isRunning.exchange(false, std::memory_order_acq_rel)) {
+		return;
+	}
+
+	// 書き込み用のスレッドを止める (積まれているものは書き込んでから止まる)
+	isStopping.store(true, std::memory_order_release);
+	signal.fetch_add(1, std::memory_order_release);
+	signal.notify_one();
+	writerThread.join();
+
+	// 止めている間に積まれたものを書き込む
+	Drain();
+
+	if (file.is_open()) {
+		file.close();
+	}
+}
+
+void Logger::Flush() {
+
+	if (!isRunning.load(std::memory_order_acquire)) {
+		return;
+	}
+
+	// 今までに積んだ数が書き込まれるまで待つ
+	uint64_t target = pushedCount.load(std::memory_order_acquire);
+	uint64_t written = writtenCount.load(std::memory_order_acquire);
+	while (written < target) {
+		writtenCount.wait(written, std::memory_order_acquire);
+		written = writtenCount.load(std::memory_order_acquire);
+	}
+}
+
 void Logger::Log(const std::string& message) {
-	OutputDebugStringA(message.c_str());
-}
\ No newline at end of file
+
+	Write(Severity::Info, message);
+}
+
+void Logger::Write(Severity severity, std::string_view message) {
+
+	if (!IsEnabled(severity)) {
+		return;
+	}
+
+	Record* record = AcquireRecord();
+	record->message.assign(message);
+	Submit(record, severity);
+}
+
+Logger::Record* Logger::AcquireRecord() {
+
+	RecordPool& pool = GetThreadPool();
+
+	// 取り出せるものが無くなったら、書き込み終わって返されたものをまとめて引き取る
+	if (pool.freeRecords.empty()) {
+		Record* record = pool.returnedRecords.exchange(nullptr, std::memory_order_acquire);
+		while (record) {
+			Record* next = record->next.load(std::memory_order_relaxed);
+			if (pool.freeRecords.size() < kMaxPooledRecordCount) {
+				pool.freeRecords.push_back(record);
+			} else {
+				delete record;
+			}
+			record = next;
+		}
+	}
+
+	// それでも無ければ新しく作る (書き込みが追いつくまでの間だけ)
+	if (pool.freeRecords.empty()) {
+		Record* record = new Record;
+		record->pool = &pool;
+		return record;
+	}
+
+	Record* record = pool.freeRecords.back();
+	pool.freeRecords.pop_back();
+	record->message.clear();
+	return record;
+}
+
+std::string& Logger::GetMessageBuffer(Record* record) {
+
+	return record->message;
+}
+
+void Logger::Submit(Record* record, Severity severity) {
+
+	record->severity = severity;
+	record->timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+	record->threadIndex = threadIndex;
+
+	// 書き込み用のスレッドがなければこのスレッドで書き込む
+	if (!isRunning.load(std::memory_order_acquire)) {
+		WriteRecord(*record);
+		ReleaseRecord(record);
+		return;
+	}
+
+	// キューに積んで、書き込み用のスレッドが寝ていれば起こす (起きている間は積んだ数を見て書き込み続ける)
+	Push(record);
+	pushedCount.fetch_add(1, std::memory_order_seq_cst);
+	if (isWriterSleeping.load(std::memory_order_seq_cst) && isWriterSleeping.exchange(false, std::memory_order_seq_cst)) {
+		signal.fetch_add(1, std::memory_order_release);
+		signal.notify_one();
+	}
+
+	// エラーは直後にassertで止まることが多いので、書き込まれるまで待つ
+	if (severity >= Severity::Error) {
+		Flush();
+	}
+}
+
+void Logger::SetMinSeverity(Severity severity) {
+
+	minSeverity.store(severity, std::memory_order_relaxed);
+}
+
+bool Logger::IsEnabled(Severity severity) {
+
+	return IsCompiled(severity) && severity >= minSeverity.load(std::memory_order_relaxed);
+}
+
+const char* Logger::GetSeverityName(Severity severity) {
+
+	switch (severity) {
+	case Severity::Debug:   return "Debug";
+	case Severity::Info:    return "Info";
+	case Severity::Warning: return "Warning";
+	case Severity::Error:   return "Error";
+	}
+
+	return "Unknown";
+}
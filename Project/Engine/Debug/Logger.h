@@ -1,15 +1,143 @@
 #pragma once
 
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <iterator>
 #include <string>
+#include <string_view>
+
+/// <summary>
+/// 重要度を指定してログ出力 (重要度が出力の対象のときだけ引数を評価して整形する)
+/// 整形はプールから取り出したログの本文に直接書き込むので、使い回している間は割り当てが起きない
+/// </summary>
+#define LOG_WRITE(severity, ...) \
+	do { \
+		if constexpr (Engine::Logger::IsCompiled(severity)) { \
+			if (Engine::Logger::IsEnabled(severity)) { \
+				Engine::Logger::Record* logRecord = Engine::Logger::AcquireRecord(); \
+				std::format_to(std::back_inserter(Engine::Logger::GetMessageBuffer(logRecord)), __VA_ARGS__); \
+				Engine::Logger::Submit(logRecord, severity); \
+			} \
+		} \
+	} while (false)
+
+#define LOG_DEBUG(...) LOG_WRITE(Engine::Logger::Severity::Debug, __VA_ARGS__)
+#define LOG_INFO(...) LOG_WRITE(Engine::Logger::Severity::Info, __VA_ARGS__)
+#define LOG_WARNING(...) LOG_WRITE(Engine::Logger::Severity::Warning, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_WRITE(Engine::Logger::Severity::Error, __VA_ARGS__)
 
 namespace Engine {
 
+	/// === ロガー === ///
+	/// 呼んだスレッドではロックを使わないキューに積むだけにして、出力先への書き込みはバックグラウンドのスレッドで行う
+	/// ログはスレッドごとのプールから取り出し、書き込み終わったら元のプールへ返して使い回す
+	/// 重要度がコンパイル時の下限より低いログは、マクロごと消えて引数も評価されない
+	/// Initializeの前とFinalizeの後は呼んだスレッドでそのまま書き込む
 	namespace Logger {
 
+		// 重要度
+		enum class Severity : uint8_t {
+			Debug,		// 開発中だけ見たい詳細
+			Info,		// 情報
+			Warning,	// 警告
+			Error,		// エラー (書き込み終わるまで待ってから戻る)
+		};
+
+		// 出力先 (組み合わせて指定する)
+		enum SinkFlags : uint32_t {
+			kSinkDebugger = 1 << 0,	// デバッガ (OutputDebugStringA)
+			kSinkStdout = 1 << 1,	// 標準出力
+			kSinkFile = 1 << 2,		// ファイル
+		};
+
+		// キューに積むログ (中身はLogger.cppだけが知る)
+		struct Record;
+
+		// コンパイル時に残す重要度の下限 (LOGGER_MIN_SEVERITYを0 ~ 3で定義すれば変えられる)
+#if defined(LOGGER_MIN_SEVERITY)
+		constexpr Severity kCompiledMinSeverity = static_cast<Severity>(LOGGER_MIN_SEVERITY);
+#elif defined(_DEBUG)
+		constexpr Severity kCompiledMinSeverity = Severity::Debug;
+#else
+		constexpr Severity kCompiledMinSeverity = Severity::Info;
+#endif
+
+		/// <summary>
+		/// 初期化 (書き込み用のスレッドを起動する)
+		/// </summary>
+		/// <param name="sinks">出力先 (SinkFlagsの組み合わせ)</param>
+		/// <param name="filePath">ファイルに出力するときのファイルパス</param>
+		void Initialize(uint32_t sinks, const std::filesystem::path& filePath = {});
+
+		/// <summary>
+		/// 終了 (積まれているログを全て書き込んでからスレッドを止める)
+		/// </summary>
+		void Finalize();
+
+		/// <summary>
+		/// 積まれているログが全て書き込まれるまで待つ
+		/// </summary>
+		void Flush();
+
 		/// <summary>
-		/// ログ出力
+		/// ログ出力 (Infoとして出力する)
 		/// </summary>
 		/// <param name="message">ログ</param>
 		void Log(const std::string& message);
+
+		/// <summary>
+		/// 重要度を指定してログ出力
+		/// </summary>
+		/// <param name="severity">重要度</param>
+		/// <param name="message">ログ</param>
+		void Write(Severity severity, std::string_view message);
+
+		/// <summary>
+		/// このスレッドのプールからログを取り出す (本文は空。GetMessageBufferに書き込んでからSubmitで積む)
+		/// </summary>
+		/// <returns></returns>
+		Record* AcquireRecord();
+
+		/// <summary>
+		/// ログの本文の取得 (Submitまでは取り出したスレッドだけが書き込める)
+		/// </summary>
+		/// <param name="record">AcquireRecordで取り出したログ</param>
+		/// <returns></returns>
+		std::string& GetMessageBuffer(Record* record);
+
+		/// <summary>
+		/// 本文を書き込んだログを積む (書き込み終わったらプールへ返る)
+		/// </summary>
+		/// <param name="record">AcquireRecordで取り出したログ</param>
+		/// <param name="severity">重要度</param>
+		void Submit(Record* record, Severity severity);
+
+		/// <summary>
+		/// 実行時に出力する重要度の下限の設定
+		/// </summary>
+		/// <param name="severity">重要度</param>
+		void SetMinSeverity(Severity severity);
+
+		/// <summary>
+		/// 実行時に出力する対象かの取得
+		/// </summary>
+		/// <param name="severity">重要度</param>
+		/// <returns></returns>
+		bool IsEnabled(Severity severity);
+
+		/// <summary>
+		/// コンパイル時に残す対象かの取得
+		/// </summary>
+		/// <param name="severity">重要度</param>
+		/// <returns></returns>
+		constexpr bool IsCompiled(Severity severity) { return severity >= kCompiledMinSeverity; }
+
+		/// <summary>
+		/// 重要度の名前の取得
+		/// </summary>
+		/// <param name="severity">重要度</param>
+		/// <returns></returns>
+		const char* GetSeverityName(Severity severity);
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,461 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+#ifdef USE_IMGUI
+#include <imgui.h>
+#endif // USE_IMGUI
+
+using namespace Engine;
+
+namespace {
+
+	// スレッドごとのリングバッファ
+	struct ThreadBuffer {
+		std::array<Profiler::Zone, Profiler::kRingBufferSize> zones;	// 区間
+		std::atomic<uint64_t> writeIndex = 0;	// 次に書き込む番号 (書き込むのはこのスレッドだけ)
+		std::atomic<uint64_t> readIndex = 0;	// 次に取り出す番号 (書き込むのはメインスレッドだけ)
+		std::atomic<uint64_t> droppedCount = 0;	// いっぱいで捨てた数
+		uint32_t threadIndex = 0;				// スレッドの番号
+		std::string threadName;					// スレッドの名前 (registryMutexで守る)
+	};
+
+	// キャプチャした区間
+	struct CapturedZone {
+		Profiler::Zone zone;	// 区間
+		uint32_t threadIndex;	// スレッドの番号
+	};
+
+	// 計測するか
+	std::atomic<bool> isEnabled = true;
+
+	// 時刻の基準
+	const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+	// 登録されたスレッドのバッファ (スレッドが終わっても取り出せるように最後まで残す)
+	std::mutex registryMutex;
+	std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers;
+
+	// このスレッドのバッファ
+	thread_local ThreadBuffer* threadBuffer = nullptr;
+
+	// このスレッドの入れ子の深さ
+	thread_local uint32_t threadDepth = 0;
+
+	// 前のフレームの開始時刻と終了時刻(ナノ秒)
+	uint64_t lastFrameStart = 0;
+	uint64_t lastFrameEnd = 0;
+
+	// 前のフレームの区間
+	std::vector<Profiler::ThreadZones> lastFrame;
+
+	// 前のフレームの名前ごとの集計
+	std::vector<Profiler::ZoneStats> lastFrameStats;
+
+	// リングバッファがいっぱいで捨てた数
+	uint64_t droppedCount = 0;
+
+	// キャプチャ中か
+	bool isCapturing = false;
+
+	// キャプチャした区間とフレームの開始時刻
+	std::vector<CapturedZone> capturedZones;
+	std::vector<uint64_t> capturedFrames;
+
+	// このスレッドのバッファを取得 (初めてならバッファを作って登録する)
+	ThreadBuffer* GetThreadBuffer() {
+
+		if (threadBuffer == nullptr) {
+
+			std::lock_guard<std::mutex> lock(registryMutex);
+
+			std::unique_ptr<ThreadBuffer> buffer = std::make_unique<ThreadBuffer>();
+			buffer->threadIndex = static_cast<uint32_t>(threadBuffers.size());
+			buffer->threadName = std::format("Thread {}", buffer->threadIndex);
+
+			threadBuffer = buffer.get();
+			threadBuffers.push_back(std::move(buffer));
+		}
+
+		return threadBuffer;
+	}
+
+	// JSONの文字列に使えない文字を置き換える
+	std::string EscapeJson(std::string_view text) {
+
+		std::string escaped;
+		escaped.reserve(text.size());
+
+		for (char c : text) {
+			switch (c) {
+			case '"':  escaped += "\\\""; break;
+			case '\\': escaped += "\\\\"; break;
+			case '\n': escaped += "\\n"; break;
+			case '\t': escaped += "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20) {
+					escaped += std::format("\\u{:04x}", static_cast<unsigned char>(c));
+				}
+				else {
+					escaped += c;
+				}
+				break;
+			}
+		}
+
+		return escaped;
+	}
+
+#ifdef USE_IMGUI
+
+	// 名前から区間の色を決める (同じ名前は毎フレーム同じ色)
+	uint32_t MakeZoneColor(std::string_view name) {
+
+		size_t hash = std::hash<std::string_view>()(name);
+
+		// 明るめの色にして文字を読めるようにする
+		uint32_t r = 96 + static_cast<uint32_t>(hash & 0x7F);
+		uint32_t g = 96 + static_cast<uint32_t>((hash >> 8) & 0x7F);
+		uint32_t b = 96 + static_cast<uint32_t>((hash >> 16) & 0x7F);
+
+		return (0xFFu << 24) | (b << 16) | (g << 8) | r;
+	}
+
+#endif // USE_IMGUI
+}
+
+Profiler::ScopedZone::ScopedZone(const char* name) {
+
+	// 無効なら何もしない
+	if (!isEnabled.load(std::memory_order_relaxed)) {
+		return;
+	}
+
+	name_ = name;
+	threadDepth++;
+	start_ = GetTimestamp();
+}
+
+Profiler::ScopedZone::~ScopedZone() {
+
+	if (name_ == nullptr) {
+		return;
+	}
+
+	uint64_t end = GetTimestamp();
+	threadDepth--;
+
+	// このスレッドのリングバッファに書き込む (取り出す側は書き込み終わった番号までしか読まない)
+	ThreadBuffer* buffer = GetThreadBuffer();
+	uint64_t index = buffer->writeIndex.load(std::memory_order_relaxed);
+
+	// まだ取り出されていない区間は上書きせずに新しい方を捨てる
+	if (index - buffer->readIndex.load(std::memory_order_acquire) >= kRingBufferSize) {
+		buffer->droppedCount.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	buffer->zones[index % kRingBufferSize] = Zone{ name_, start_, end, threadDepth };
+	buffer->writeIndex.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::BeginFrame() {
+
+	uint64_t now = GetTimestamp();
+
+	lastFrameStart = lastFrameEnd;
+	lastFrameEnd = now;
+
+	// キャプチャ中ならフレームの区切りを記録
+	if (isCapturing) {
+		capturedFrames.push_back(now);
+	}
+
+	// ----------全スレッドのリングバッファから取り出す----------
+	std::lock_guard<std::mutex> lock(registryMutex);
+
+	lastFrame.resize(threadBuffers.size());
+
+	for (size_t i = 0; i < threadBuffers.size(); ++i) {
+
+		ThreadBuffer& buffer = *threadBuffers[i];
+		ThreadZones& threadZones = lastFrame[i];
+
+		threadZones.threadIndex = buffer.threadIndex;
+		threadZones.threadName = buffer.threadName;
+		threadZones.zones.clear();
+
+		// 書き込み終わった番号まで取り出す (取り出し終わるまで書き込む側はその場所を使わない)
+		uint64_t writeIndex = buffer.writeIndex.load(std::memory_order_acquire);
+		for (uint64_t index = buffer.readIndex.load(std::memory_order_relaxed); index < writeIndex; ++index) {
+			threadZones.zones.push_back(buffer.zones[index % kRingBufferSize]);
+		}
+		buffer.readIndex.store(writeIndex, std::memory_order_release);
+
+		droppedCount += buffer.droppedCount.exchange(0, std::memory_order_relaxed);
+
+		// キャプチャ中なら溜める
+		if (isCapturing) {
+			for (const Zone& zone : threadZones.zones) {
+				if (capturedZones.size() >= kMaxCaptureZoneCount) {
+					break;
+				}
+				capturedZones.push_back({ zone, buffer.threadIndex });
+			}
+		}
+	}
+
+	// ----------名前ごとに集計する----------
+	std::unordered_map<std::string_view, size_t> statsIndices;
+	lastFrameStats.clear();
+
+	for (const ThreadZones& threadZones : lastFrame) {
+		for (const Zone& zone : threadZones.zones) {
+
+			auto [it, isInserted] = statsIndices.try_emplace(zone.name, lastFrameStats.size());
+			if (isInserted) {
+				lastFrameStats.push_back({ zone.name, 0.0f, 0 });
+			}
+
+			ZoneStats& stats = lastFrameStats[it->second];
+			stats.milliseconds += static_cast<float>(zone.end - zone.start) / 1000000.0f;
+			stats.callCount++;
+		}
+	}
+
+	// 合計時間の長い順
+	std::sort(lastFrameStats.begin(), lastFrameStats.end(), [](const ZoneStats& a, const ZoneStats& b) {
+		return a.milliseconds > b.milliseconds;
+	});
+}
+
+uint64_t Profiler::GetTimestamp() {
+
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+void Profiler::SetThreadName(const std::string& name) {
+
+	ThreadBuffer* buffer = GetThreadBuffer();
+
+	std::lock_guard<std::mutex> lock(registryMutex);
+	buffer->threadName = name;
+}
+
+void Profiler::SetEnabled(bool enabled) {
+
+	isEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Profiler::IsEnabled() {
+
+	return isEnabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::StartCapture() {
+
+	capturedZones.clear();
+	capturedFrames.clear();
+	isCapturing = true;
+}
+
+bool Profiler::StopCapture(const std::filesystem::path& filePath) {
+
+	isCapturing = false;
+
+	std::ofstream file(filePath, std::ios::trunc);
+	if (!file) {
+		return false;
+	}
+
+	// ----------Chromeのトレース形式で書き出す----------
+	// 時刻はマイクロ秒
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+	bool isFirst = true;
+	auto writeEvent = [&](const std::string& event) {
+		file << (isFirst ? "" : ",\n") << event;
+		isFirst = false;
+	};
+
+	// スレッドの名前
+	{
+		std::lock_guard<std::mutex> lock(registryMutex);
+		for (const std::unique_ptr<ThreadBuffer>& buffer : threadBuffers) {
+			writeEvent(std::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}",
+				buffer->threadIndex, EscapeJson(buffer->threadName)));
+		}
+	}
+
+	// フレームの区切り
+	for (uint64_t frame : capturedFrames) {
+		writeEvent(std::format("{{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":{:.3f}}}",
+			static_cast<double>(frame) / 1000.0));
+	}
+
+	// 区間
+	for (const CapturedZone& captured : capturedZones) {
+		writeEvent(std::format("{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+			EscapeJson(captured.zone.name), captured.threadIndex,
+			static_cast<double>(captured.zone.start) / 1000.0, static_cast<double>(captured.zone.end - captured.zone.start) / 1000.0));
+	}
+
+	file << "\n]}\n";
+
+	capturedZones.clear();
+	capturedFrames.clear();
+
+	return static_cast<bool>(file);
+}
+
+bool Profiler::IsCapturing() {
+
+	return isCapturing;
+}
+
+const std::vector<Profiler::ThreadZones>& Profiler::GetLastFrame() {
+
+	return lastFrame;
+}
+
+const std::vector<Profiler::ZoneStats>& Profiler::GetLastFrameStats() {
+
+	return lastFrameStats;
+}
+
+void Profiler::ShowImGui() {
+
+#ifdef USE_IMGUI
+
+	ImGui::Begin("Profiler");
+
+	// 計測するか
+	bool enabled = IsEnabled();
+	if (ImGui::Checkbox("Enabled", &enabled)) {
+		SetEnabled(enabled);
+	}
+
+	// キャプチャ
+	ImGui::SameLine();
+	if (!isCapturing) {
+		if (ImGui::Button("StartCapture")) {
+			StartCapture();
+		}
+	}
+	else {
+		if (ImGui::Button("StopCapture")) {
+			StopCapture("ProfilerCapture.json");
+		}
+		ImGui::SameLine();
+		ImGui::Text("%u zones", static_cast<uint32_t>(capturedZones.size()));
+	}
+
+	// 前のフレームの時間
+	const float frameMilliseconds = static_cast<float>(lastFrameEnd - lastFrameStart) / 1000000.0f;
+	ImGui::Text("Frame: %.3f ms  Dropped: %llu", frameMilliseconds, static_cast<unsigned long long>(droppedCount));
+
+	// ----------フレームグラフ----------
+	// 横がフレームの時間、縦が入れ子の深さ
+	if (ImGui::TreeNodeEx("Timeline", ImGuiTreeNodeFlags_DefaultOpen)) {
+
+		// 0で割らないようにする
+		const uint64_t frameDuration = (std::max)(lastFrameEnd - lastFrameStart, static_cast<uint64_t>(1));
+
+		const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+		const float width = (std::max)(ImGui::GetContentRegionAvail().x, 1.0f);
+		const double scale = width / static_cast<double>(frameDuration);
+
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+		for (const ThreadZones& threadZones : lastFrame) {
+
+			if (threadZones.zones.empty()) {
+				continue;
+			}
+
+			ImGui::TextUnformatted(threadZones.threadName.c_str());
+
+			// 一番深い区間まで入る高さを確保する
+			uint32_t maxDepth = 0;
+			for (const Zone& zone : threadZones.zones) {
+				maxDepth = (std::max)(maxDepth, zone.depth);
+			}
+
+			const ImVec2 origin = ImGui::GetCursorScreenPos();
+			const ImVec2 size(width, rowHeight * (maxDepth + 1));
+			ImGui::Dummy(size);
+
+			drawList->PushClipRect(origin, ImVec2(origin.x + size.x, origin.y + size.y), true);
+
+			for (const Zone& zone : threadZones.zones) {
+
+				// 前のフレームから続いていた区間はフレームの始めから描く
+				uint64_t start = (std::max)(zone.start, lastFrameStart);
+				float x0 = origin.x + static_cast<float>((start - lastFrameStart) * scale);
+				float x1 = origin.x + static_cast<float>((zone.end - lastFrameStart) * scale);
+				float y0 = origin.y + rowHeight * zone.depth;
+				float y1 = y0 + rowHeight - 1.0f;
+
+				// 1ピクセルより細くても見えるようにする
+				x1 = (std::max)(x1, x0 + 1.0f);
+
+				ImVec2 min(x0, y0);
+				ImVec2 max(x1, y1);
+				drawList->AddRectFilled(min, max, MakeZoneColor(zone.name));
+
+				// 名前が入るなら描く
+				if (ImGui::CalcTextSize(zone.name).x < x1 - x0 - 4.0f) {
+					drawList->AddText(ImVec2(x0 + 2.0f, y0 + 2.0f), IM_COL32(0, 0, 0, 255), zone.name);
+				}
+
+				// マウスを乗せたら名前と時間を出す
+				if (ImGui::IsMouseHoveringRect(min, max)) {
+					ImGui::SetTooltip("%s\n%.3f ms", zone.name, static_cast<float>(zone.end - zone.start) / 1000000.0f);
+				}
+			}
+
+			drawList->PopClipRect();
+		}
+
+		ImGui::TreePop();
+	}
+
+	// ----------名前ごとの集計----------
+	if (ImGui::TreeNodeEx("Stats", ImGuiTreeNodeFlags_DefaultOpen)) {
+
+		if (ImGui::BeginTable("ProfilerStats", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+
+			ImGui::TableSetupColumn("Name");
+			ImGui::TableSetupColumn("ms");
+			ImGui::TableSetupColumn("Calls");
+			ImGui::TableHeadersRow();
+
+			for (const ZoneStats& stats : lastFrameStats) {
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(stats.name);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.3f", stats.milliseconds);
+				ImGui::TableNextColumn();
+				ImGui::Text("%u", stats.callCount);
+			}
+
+			ImGui::EndTable();
+		}
+
+		ImGui::TreePop();
+	}
+
+	ImGui::End();
+
+#endif // USE_IMGUI
+}
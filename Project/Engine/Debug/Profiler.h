@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// スコープの終わりまでを区間として計測する (名前は文字列リテラルなど、計測中に消えないものを渡す)
+/// </summary>
+#define PROFILE_SCOPE(name) Engine::Profiler::ScopedZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_CONCAT_INNER(a, b) a##b
+
+namespace Engine {
+
+	/// === CPUプロファイラ === ///
+	/// 計測した区間はスレッドごとのリングバッファに書き込むだけにして、フレームの始めにメインスレッドでまとめて取り出す
+	/// 書き込みにロックを使わないので、ワーカースレッドの処理にも置ける
+	/// 取り出した区間はImGuiのフレームグラフで表示し、キャプチャ中はChromeのトレース形式(chrome://tracing, Perfetto)で書き出せる
+	namespace Profiler {
+
+		// 計測した区間
+		struct Zone {
+			const char* name;	// 名前
+			uint64_t start;		// 開始時刻(ナノ秒)
+			uint64_t end;		// 終了時刻(ナノ秒)
+			uint32_t depth;		// 入れ子の深さ
+		};
+
+		// スレッドごとの区間
+		struct ThreadZones {
+			uint32_t threadIndex;		// スレッドの番号 (初めて計測した順)
+			std::string threadName;		// スレッドの名前
+			std::vector<Zone> zones;	// 前のフレームの間に終わった区間 (終わった順)
+		};
+
+		// 名前ごとの集計
+		struct ZoneStats {
+			const char* name;		// 名前
+			float milliseconds;		// 合計時間(ミリ秒)
+			uint32_t callCount;		// 回数
+		};
+
+		/// === 区間の計測 === ///
+		/// コンストラクタからデストラクタまでを計測する (PROFILE_SCOPEから使う)
+		class ScopedZone {
+
+			///-------------------------------------------///
+			/// メンバ関数
+			///-------------------------------------------///
+		public:
+
+			/// <summary>
+			/// コンストラクタ (計測の開始)
+			/// </summary>
+			/// <param name="name">名前</param>
+			explicit ScopedZone(const char* name);
+
+			/// <summary>
+			/// デストラクタ (計測の終了)
+			/// </summary>
+			~ScopedZone();
+
+			// コピーの封印
+			ScopedZone(const ScopedZone&) = delete;
+			ScopedZone& operator=(const ScopedZone&) = delete;
+
+			///-------------------------------------------///
+			/// メンバ変数
+			///-------------------------------------------///
+		private:
+
+			// 名前 (無効なときはnullptr)
+			const char* name_ = nullptr;
+
+			// 開始時刻(ナノ秒)
+			uint64_t start_ = 0;
+		};
+
+		/// <summary>
+		/// フレームの開始 (前のフレームの区間を取り出して集計する。メインスレッドから毎フレーム呼ぶ)
+		/// </summary>
+		void BeginFrame();
+
+		/// <summary>
+		/// 今の時刻の取得
+		/// </summary>
+		/// <returns>プロファイラが始まってからのナノ秒</returns>
+		uint64_t GetTimestamp();
+
+		/// <summary>
+		/// このスレッドの名前を設定 (トレースとImGuiに表示する)
+		/// </summary>
+		/// <param name="name">名前</param>
+		void SetThreadName(const std::string& name);
+
+		/// <summary>
+		/// 計測するかの設定 (無効の間は区間の開始と終了で何もしない)
+		/// </summary>
+		/// <param name="isEnabled">計測するか</param>
+		void SetEnabled(bool isEnabled);
+
+		/// <summary>
+		/// 計測するかの取得
+		/// </summary>
+		/// <returns></returns>
+		bool IsEnabled();
+
+		/// <summary>
+		/// キャプチャの開始 (次のフレームから区間を溜める)
+		/// </summary>
+		void StartCapture();
+
+		/// <summary>
+		/// キャプチャの終了 (溜めた区間をChromeのトレース形式で書き出す)
+		/// </summary>
+		/// <param name="filePath">書き出すファイルパス</param>
+		/// <returns>書き出せたか</returns>
+		bool StopCapture(const std::filesystem::path& filePath);
+
+		/// <summary>
+		/// キャプチャ中かの取得
+		/// </summary>
+		/// <returns></returns>
+		bool IsCapturing();
+
+		/// <summary>
+		/// 前のフレームの区間の取得
+		/// </summary>
+		/// <returns></returns>
+		const std::vector<ThreadZones>& GetLastFrame();
+
+		/// <summary>
+		/// 前のフレームの名前ごとの集計の取得 (合計時間の長い順)
+		/// </summary>
+		/// <returns></returns>
+		const std::vector<ZoneStats>& GetLastFrameStats();
+
+		/// <summary>
+		/// ImGui表示
+		/// </summary>
+		void ShowImGui();
+
+		/// ===== 定数 ===== ///
+
+		// スレッドごとのリングバッファに入る区間の数 (1フレームでこれを超えた分は捨てる)
+		const uint32_t kRingBufferSize = 1 << 13;
+
+		// キャプチャで溜める区間の数の上限
+		const uint32_t kMaxCaptureZoneCount = 1 << 20;
+	};
+}
@@ -0,0 +1,100 @@
+#include "EntityRegistry.h"
+
+using namespace Engine;
+
+uint32_t EntityRegistry::nextComponentTypeID = 0;
+
+Entity EntityRegistry::Create() {
+
+	aliveCount_++;
+
+	// 破棄された番号があれば再利用する (世代は破棄したときに進めてある)
+	if (!freeIndices_.empty()) {
+		uint32_t index = freeIndices_.back();
+		freeIndices_.pop_back();
+		return { index, generations_[index] };
+	}
+
+	// なければ新しい番号 (世代は1から)
+	uint32_t index = static_cast<uint32_t>(generations_.size());
+	generations_.push_back(1);
+	return { index, 1 };
+}
+
+void EntityRegistry::Destroy(Entity entity) {
+
+	assert(IsAlive(entity));
+	assert(iterationDepth_ == 0);
+
+	// 全ての種類からコンポーネントを取り除く
+	for (std::unique_ptr<IComponentPool>& pool : pools_) {
+		if (pool) {
+			pool->Remove(entity.index);
+		}
+	}
+
+	// 世代を進めて、破棄したエンティティを無効にする (0は空のエンティティなので飛ばす)
+	uint32_t& generation = generations_[entity.index];
+	generation++;
+	if (generation == 0) {
+		generation = 1;
+	}
+
+	// 再利用できるように積む
+	freeIndices_.push_back(entity.index);
+	aliveCount_--;
+}
+
+void EntityRegistry::DestroyDeferred(Entity entity) {
+
+	pendingDestroys_.push_back(entity);
+}
+
+void EntityRegistry::Flush() {
+
+	assert(iterationDepth_ == 0);
+
+	// ----------予約した追加----------
+	for (std::unique_ptr<IComponentPool>& pool : pools_) {
+		if (pool) {
+			pool->FlushPending();
+		}
+	}
+
+	// ----------予約した破棄----------
+	// 同じエンティティが何度予約されていても、2回目からは破棄済みなので飛ばす
+	for (Entity entity : pendingDestroys_) {
+		if (IsAlive(entity)) {
+			Destroy(entity);
+		}
+	}
+	pendingDestroys_.clear();
+}
+
+void EntityRegistry::Clear() {
+
+	assert(iterationDepth_ == 0);
+
+	// コンポーネントを全て取り除く
+	for (std::unique_ptr<IComponentPool>& pool : pools_) {
+		if (pool) {
+			pool->Clear();
+		}
+	}
+
+	// 全ての番号の世代を進めて再利用できるようにする (今までのエンティティは全て無効になる)
+	freeIndices_.clear();
+	for (uint32_t index = static_cast<uint32_t>(generations_.size()); index-- > 0;) {
+
+		uint32_t& generation = generations_[index];
+		generation++;
+		if (generation == 0) {
+			generation = 1;
+		}
+
+		freeIndices_.push_back(index);
+	}
+
+	pendingDestroys_.clear();
+	aliveCount_ = 0;
+}
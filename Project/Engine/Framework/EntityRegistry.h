@@ -0,0 +1,554 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Engine {
+
+	// エンティティ
+	struct Entity {
+		uint32_t index = UINT32_MAX;	// 番号
+		uint32_t generation = 0;		// 作ったときの世代 (0は無効)
+
+		/// <summary>
+		/// 空のエンティティか
+		/// </summary>
+		/// <returns></returns>
+		bool IsNull() const { return generation == 0; }
+
+		bool operator==(const Entity&) const = default;
+	};
+
+	/// === エンティティとコンポーネントの管理 === ///
+	/// コンポーネントは種類ごとに、詰めて並べた配列と、エンティティの番号から配列の位置を引く疎な配列(スパースセット)で持つ
+	/// システムは詰めた配列を先頭から順に処理するので、オブジェクトのポインタをたどらずに連続したメモリを回せる
+	/// 破棄した番号は世代を進めて再利用するので、破棄済みのエンティティを使うと検出できる
+	/// 反復中に配列の並びを変えないように、反復中の追加と破棄は予約(EmplaceDeferred / DestroyDeferred)してFlushでまとめて反映する
+	class EntityRegistry {
+
+		///-------------------------------------------///
+		/// 構造体
+		///-------------------------------------------///
+	private:
+
+		/// === コンポーネントの配列の共通部分 === ///
+		/// エンティティの破棄や予約の反映で、種類を知らずに全ての配列を扱うのに使う
+		class IComponentPool {
+
+			///-------------------------------------------///
+			/// メンバ関数
+			///-------------------------------------------///
+		public:
+
+			/// <summary>
+			/// デストラクタ
+			/// </summary>
+			virtual ~IComponentPool() = default;
+
+			/// <summary>
+			/// エンティティのコンポーネントを取り除く (なければ何もしない)
+			/// </summary>
+			/// <param name="index">エンティティの番号</param>
+			virtual void Remove(uint32_t index) = 0;
+
+			/// <summary>
+			/// 予約した追加を反映する
+			/// </summary>
+			virtual void FlushPending() = 0;
+
+			/// <summary>
+			/// 全て取り除く
+			/// </summary>
+			virtual void Clear() = 0;
+		};
+
+		/// === 種類ごとのコンポーネントの配列 === ///
+		template <typename T>
+		class ComponentPool : public IComponentPool {
+
+			///-------------------------------------------///
+			/// メンバ関数
+			///-------------------------------------------///
+		public:
+
+			/// <summary>
+			/// 追加 (既にあれば置き換える)
+			/// </summary>
+			/// <param name="entity">エンティティ</param>
+			/// <param name="...args">コンポーネントのコンストラクタの引数</param>
+			/// <returns>追加したコンポーネント</returns>
+			template <typename... Args>
+			T& Emplace(Entity entity, Args&&... args);
+
+			/// <summary>
+			/// 追加の予約 (FlushPendingで追加する)
+			/// </summary>
+			/// <param name="entity">エンティティ</param>
+			/// <param name="component">コンポーネント</param>
+			void EmplaceDeferred(Entity entity, T component) { pending_.emplace_back(entity, std::move(component)); }
+
+			/// <summary>
+			/// エンティティのコンポーネントを取り除く (末尾の要素で穴を埋める)
+			/// </summary>
+			/// <param name="index">エンティティの番号</param>
+			void Remove(uint32_t index) override;
+
+			/// <summary>
+			/// 予約した追加を反映する
+			/// </summary>
+			void FlushPending() override;
+
+			/// <summary>
+			/// 全て取り除く (配列の容量は残して次に使い回す)
+			/// </summary>
+			void Clear() override;
+
+			/// <summary>
+			/// 容量の確保
+			/// </summary>
+			/// <param name="capacity">コンポーネントの数</param>
+			void Reserve(uint32_t capacity);
+
+			/// <summary>
+			/// エンティティのコンポーネントがあるか
+			/// </summary>
+			/// <param name="index">エンティティの番号</param>
+			/// <returns></returns>
+			bool Contains(uint32_t index) const { return index < sparse_.size() && sparse_[index] != kNone; }
+
+			/// <summary>
+			/// エンティティのコンポーネントの取得 (あること)
+			/// </summary>
+			/// <param name="index">エンティティの番号</param>
+			/// <returns></returns>
+			T& Get(uint32_t index) { return components_[sparse_[index]]; }
+
+			///-------------------------------------------///
+			/// 定数
+			///-------------------------------------------///
+		public:
+
+			// コンポーネントがないことを表す配列の位置
+			static const uint32_t kNone = UINT32_MAX;
+
+			///-------------------------------------------///
+			/// メンバ変数
+			///-------------------------------------------///
+		public:
+
+			// コンポーネント (詰めて並べる)
+			std::vector<T> components_;
+
+			// コンポーネントと同じ位置の持ち主のエンティティ
+			std::vector<Entity> entities_;
+
+			// エンティティの番号からコンポーネントの位置を引く配列
+			std::vector<uint32_t> sparse_;
+
+			// 追加の予約
+			std::vector<std::pair<Entity, T>> pending_;
+		};
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// エンティティの生成 (番号を割り当てるだけなので反復中でも呼べる)
+		/// </summary>
+		/// <returns>エンティティ</returns>
+		Entity Create();
+
+		/// <summary>
+		/// エンティティの破棄 (全てのコンポーネントを取り除く。反復中はDestroyDeferredを使う)
+		/// </summary>
+		/// <param name="entity">エンティティ</param>
+		void Destroy(Entity entity);
+
+		/// <summary>
+		/// エンティティの破棄の予約 (Flushで破棄する。同じエンティティを何度予約してもよい)
+		/// </summary>
+		/// <param name="entity">エンティティ</param>
+		void DestroyDeferred(Entity entity);
+
+		/// <summary>
+		/// 予約した追加と破棄を反映する (追加してから破棄するので、同じフレームに作って壊したエンティティも残らない)
+		/// </summary>
+		void Flush();
+
+		/// <summary>
+		/// 全てのエンティティの破棄 (予約も捨てる)
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// エンティティとコンポーネントの配列の容量の確保 (確保した数までは、生成や追加でメモリを確保し直さない)
+		/// </summary>
+		/// <param name="capacity">エンティティの数</param>
+		template <typename... Ts>
+		void Reserve(uint32_t capacity);
+
+		/// <summary>
+		/// エンティティが生きているか (破棄済みや空のエンティティならfalse)
+		/// </summary>
+		/// <param name="entity">エンティティ</param>
+		/// <returns></returns>
+		bool IsAlive(Entity entity) const { return entity.index < generations_.size() && generations_[entity.index] == entity.generation; }
+
+		/// <summary>
+		/// コンポーネントの追加 (既にあれば置き換える。反復中はEmplaceDeferredを使う)
+		/// </summary>
+		/// <param name="entity">エンティティ</param>
+		/// <param name="...args">コンポーネントのコンストラクタの引数</param>
+		/// <returns>追加したコンポーネント</returns>
+		template <typename T, typename... Args>
+		T& Emplace(Entity entity, Args&&... args);
+
+		/// <summary>
+		/// コンポーネントの追加の予約 (Flushで追加する)
+		/// </summary>
+		/// <param name="entity">エンティティ</param>
+		/// <param name="component">コンポーネント</param>
+		template <typename T>
+		void EmplaceDeferred(Entity entity, T component);
+
+		/// <summary>
+		/// コンポーネントを取り除く (反復中は呼ばない)
+		/// </summary>
+		/// <param name="entity">エンティティ</param>
+		template <typename T>
+		void Remove(Entity entity);
+
+		/// <summary>
+		/// コンポーネントを持っているか
+		/// </summary>
+		/// <param name="entity">エンティティ</param>
+		/// <returns></returns>
+		template <typename T>
+		bool Has(Entity entity) const;
+
+		/// <summary>
+		/// コンポーネントの取得 (持っていること)
+		/// </summary>
+		/// <param name="entity">エンティティ</param>
+		/// <returns></returns>
+		template <typename T>
+		T& Get(Entity entity);
+
+		/// <summary>
+		/// コンポーネントの取得
+		/// </summary>
+		/// <param name="entity">エンティティ</param>
+		/// <returns>コンポーネント (持っていなければnullptr)</returns>
+		template <typename T>
+		T* TryGet(Entity entity);
+
+		/// <summary>
+		/// Tと他の全ての種類を持つエンティティごとに処理する (Tの配列の順に回す。要素の少ない種類をTにすると速い)
+		/// </summary>
+		/// <param name="function">処理 (エンティティとTと他の種類のコンポーネントの参照を受け取る)</param>
+		template <typename T, typename... Others, typename Function>
+		void ForEach(Function function);
+
+		///-------------------------------------------///
+		/// クラス内関数
+		///-------------------------------------------///
+	private:
+
+		/// <summary>
+		/// コンポーネントの種類の番号の取得 (初めて使ったときに割り当てる)
+		/// </summary>
+		/// <returns></returns>
+		template <typename T>
+		static uint32_t GetComponentTypeID();
+
+		/// <summary>
+		/// コンポーネントの配列の取得 (なければ作る)
+		/// </summary>
+		/// <returns></returns>
+		template <typename T>
+		ComponentPool<T>& GetPool();
+
+		/// <summary>
+		/// コンポーネントの配列を探す
+		/// </summary>
+		/// <returns>コンポーネントの配列 (まだなければnullptr)</returns>
+		template <typename T>
+		ComponentPool<T>* FindPool() const;
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// コンポーネントを詰めて並べた配列の取得 (システムはこれを先頭から回す)
+		/// </summary>
+		/// <returns></returns>
+		template <typename T>
+		std::span<T> GetComponents();
+
+		/// <summary>
+		/// GetComponentsと同じ位置の持ち主のエンティティの配列の取得
+		/// </summary>
+		/// <returns></returns>
+		template <typename T>
+		std::span<const Entity> GetEntities();
+
+		/// <summary>
+		/// 生きているエンティティの数の取得
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetAliveCount() const { return aliveCount_; }
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// 番号ごとの世代 (破棄するたびに進める。次にその番号で作るエンティティの世代)
+		std::vector<uint32_t> generations_;
+
+		// 破棄されて再利用できる番号
+		std::vector<uint32_t> freeIndices_;
+
+		// 生きているエンティティの数
+		uint32_t aliveCount_ = 0;
+
+		// コンポーネントの配列 (種類の番号の位置に置く)
+		std::vector<std::unique_ptr<IComponentPool>> pools_;
+
+		// 破棄の予約
+		std::vector<Entity> pendingDestroys_;
+
+		// 反復中の深さ (反復中に配列の並びを変えていないか確かめる)
+		uint32_t iterationDepth_ = 0;
+
+		// 次に割り当てるコンポーネントの種類の番号
+		static uint32_t nextComponentTypeID;
+	};
+
+	///-------------------------------------------///
+	/// ComponentPool
+	///-------------------------------------------///
+
+	template <typename T>
+	template <typename... Args>
+	inline T& EntityRegistry::ComponentPool<T>::Emplace(Entity entity, Args&&... args) {
+
+		// 既にあれば置き換える
+		if (Contains(entity.index)) {
+			T& component = components_[sparse_[entity.index]];
+			component = T(std::forward<Args>(args)...);
+			return component;
+		}
+
+		// 番号の位置まで疎な配列を広げる
+		if (sparse_.size() <= entity.index) {
+			sparse_.resize(entity.index + 1, static_cast<uint32_t>(kNone));
+		}
+
+		// 末尾に追加
+		sparse_[entity.index] = static_cast<uint32_t>(components_.size());
+		entities_.push_back(entity);
+		return components_.emplace_back(std::forward<Args>(args)...);
+	}
+
+	template <typename T>
+	inline void EntityRegistry::ComponentPool<T>::Remove(uint32_t index) {
+
+		// まだ反映していない予約も取り除く (番号が再利用されても前のエンティティの分を付けない)
+		std::erase_if(pending_, [index](const std::pair<Entity, T>& pending) { return pending.first.index == index; });
+
+		if (!Contains(index)) {
+			return;
+		}
+
+		// 末尾の要素を取り除く位置に移して詰める
+		uint32_t position = sparse_[index];
+		uint32_t last = static_cast<uint32_t>(components_.size()) - 1;
+		if (position != last) {
+			components_[position] = std::move(components_[last]);
+			entities_[position] = entities_[last];
+			sparse_[entities_[position].index] = position;
+		}
+
+		components_.pop_back();
+		entities_.pop_back();
+		sparse_[index] = kNone;
+	}
+
+	template <typename T>
+	inline void EntityRegistry::ComponentPool<T>::FlushPending() {
+
+		for (std::pair<Entity, T>& pending : pending_) {
+			Emplace(pending.first, std::move(pending.second));
+		}
+		pending_.clear();
+	}
+
+	template <typename T>
+	inline void EntityRegistry::ComponentPool<T>::Clear() {
+
+		components_.clear();
+		entities_.clear();
+		sparse_.clear();
+		pending_.clear();
+	}
+
+	template <typename T>
+	inline void EntityRegistry::ComponentPool<T>::Reserve(uint32_t capacity) {
+
+		components_.reserve(capacity);
+		entities_.reserve(capacity);
+		sparse_.reserve(capacity);
+		pending_.reserve(capacity);
+	}
+
+	///-------------------------------------------///
+	/// EntityRegistry
+	///-------------------------------------------///
+
+	template <typename... Ts>
+	inline void EntityRegistry::Reserve(uint32_t capacity) {
+
+		// エンティティの番号
+		generations_.reserve(capacity);
+		freeIndices_.reserve(capacity);
+		pendingDestroys_.reserve(capacity);
+
+		// 種類ごとのコンポーネント
+		(GetPool<Ts>().Reserve(capacity), ...);
+	}
+
+	template <typename T, typename... Args>
+	inline T& EntityRegistry::Emplace(Entity entity, Args&&... args) {
+
+		assert(IsAlive(entity));
+		assert(iterationDepth_ == 0);
+
+		return GetPool<T>().Emplace(entity, std::forward<Args>(args)...);
+	}
+
+	template <typename T>
+	inline void EntityRegistry::EmplaceDeferred(Entity entity, T component) {
+
+		assert(IsAlive(entity));
+
+		GetPool<T>().EmplaceDeferred(entity, std::move(component));
+	}
+
+	template <typename T>
+	inline void EntityRegistry::Remove(Entity entity) {
+
+		assert(iterationDepth_ == 0);
+
+		if (ComponentPool<T>* pool = FindPool<T>(); pool && IsAlive(entity)) {
+			pool->Remove(entity.index);
+		}
+	}
+
+	template <typename T>
+	inline bool EntityRegistry::Has(Entity entity) const {
+
+		ComponentPool<T>* pool = FindPool<T>();
+		return pool && IsAlive(entity) && pool->Contains(entity.index);
+	}
+
+	template <typename T>
+	inline T& EntityRegistry::Get(Entity entity) {
+
+		assert(Has<T>(entity));
+
+		return FindPool<T>()->Get(entity.index);
+	}
+
+	template <typename T>
+	inline T* EntityRegistry::TryGet(Entity entity) {
+
+		return Has<T>(entity) ? &FindPool<T>()->Get(entity.index) : nullptr;
+	}
+
+	template <typename T, typename... Others, typename Function>
+	inline void EntityRegistry::ForEach(Function function) {
+
+		ComponentPool<T>* pool = FindPool<T>();
+		if (!pool) {
+			return;
+		}
+
+		iterationDepth_++;
+
+		for (size_t i = 0; i < pool->components_.size(); ++i) {
+
+			Entity entity = pool->entities_[i];
+
+			// 他の種類は全て持っているものだけ
+			if constexpr (sizeof...(Others) > 0) {
+				if (!(Has<Others>(entity) && ...)) {
+					continue;
+				}
+				function(entity, pool->components_[i], FindPool<Others>()->Get(entity.index)...);
+			}
+			else {
+				function(entity, pool->components_[i]);
+			}
+		}
+
+		iterationDepth_--;
+	}
+
+	template <typename T>
+	inline uint32_t EntityRegistry::GetComponentTypeID() {
+
+		static const uint32_t typeID = nextComponentTypeID++;
+		return typeID;
+	}
+
+	template <typename T>
+	inline EntityRegistry::ComponentPool<T>& EntityRegistry::GetPool() {
+
+		uint32_t typeID = GetComponentTypeID<T>();
+
+		if (pools_.size() <= typeID) {
+			pools_.resize(typeID + 1);
+		}
+
+		if (!pools_[typeID]) {
+			pools_[typeID] = std::make_unique<ComponentPool<T>>();
+		}
+
+		return static_cast<ComponentPool<T>&>(*pools_[typeID]);
+	}
+
+	template <typename T>
+	inline EntityRegistry::ComponentPool<T>* EntityRegistry::FindPool() const {
+
+		uint32_t typeID = GetComponentTypeID<T>();
+
+		if (pools_.size() <= typeID) {
+			return nullptr;
+		}
+
+		return static_cast<ComponentPool<T>*>(pools_[typeID].get());
+	}
+
+	template <typename T>
+	inline std::span<T> EntityRegistry::GetComponents() {
+
+		ComponentPool<T>* pool = FindPool<T>();
+		return pool ? std::span<T>(pool->components_) : std::span<T>();
+	}
+
+	template <typename T>
+	inline std::span<const Entity> EntityRegistry::GetEntities() {
+
+		ComponentPool<T>* pool = FindPool<T>();
+		return pool ? std::span<const Entity>(pool->entities_) : std::span<const Entity>();
+	}
+}
@@ -4,6 +4,8 @@
 #include "Texture/TextureManager.h"
 #include "Sprite/SpriteRenderer.h"
 #include "Model/ModelManager.h"
+#include "AssetLoader.h"
+#include "Light/LightManager.h"
 #include "Object/Object3dRenderer.h"
 #include "Skybox/SkyBoxRenderer.h"
 #include "Particle/ParticleRenderer.h"
@@ -14,11 +16,29 @@
 #include "Input.h"
 #include "SceneManager.h"
 #include "LineManager.h"
+#include "GameClock.h"
+#include "Profiler.h"
+#include "FrameCounters.h"
+#include "Logger.h"
+#include "JobSystem.h"
 
 using namespace Engine;
 
 void Framework::Initialize() {
 
+	// フレームの統計の生成 (スレッドを作る前に生成する。以降はヒープの確保も数える)
+	frameCounters_ = FrameCounters::GetInstance();
+
+	// ロガーの初期化 (デバッガとファイルに書き出す)
+	Logger::Initialize(Logger::kSinkDebugger | Logger::kSinkFile, "Logs/Engine.log");
+
+	// プロファイラにメインスレッドの名前を登録
+	Profiler::SetThreadName("Main");
+
+	// ジョブシステムの初期化 (このスレッドをメインスレッドにする)
+	jobSystem_ = JobSystem::GetInstance();
+	jobSystem_->Initialize();
+
 	// WindowsAPIの初期化
 	winApp = std::make_unique <WinApp>();
 	winApp->Initialize();
@@ -46,6 +66,15 @@ void Framework::Initialize() {
 	modelManager_ = ModelManager::GetInstance();
 	modelManager_->Initialize();
 
+	// アセットローダー初期化
+	assetUploadSink_ = std::make_unique<GpuAssetUploadSink>();
+	assetLoader_ = AssetLoader::GetInstance();
+	assetLoader_->Initialize(assetUploadSink_.get());
+
+	// ライトマネージャ初期化
+	lightManager_ = LightManager::GetInstance();
+	lightManager_->Initialize();
+
 	// 3Dオブジェクトレンダラー初期化
 	object3dRenderer_ = Object3dRenderer::GetInstance();
 	object3dRenderer_->Initialize();
@@ -70,6 +99,9 @@ void Framework::Initialize() {
 	sceneBuffer = std::make_unique<SceneBuffer>();
 	sceneBuffer->Initialize();
 
+	// 並列に記録する各コマンドリストの最初にシーンバッファのレンダーターゲットを設定する
+	dxUtility_->GetCommandRecorder().SetListPrologue([this]() { sceneBuffer->BindRenderTargets(); });
+
 	// ポストプロセスバッファ初期化
 	postProcessBuffer = std::make_unique<PostProcessBuffer>();
 	postProcessBuffer->Initialize();
@@ -96,10 +128,15 @@ void Framework::Initialize() {
 	// 線マネージャの初期化
 	lineManager_ = LineManager::GetInstance();
 	lineManager_->Initialize();
+
+	// シェーダーとパイプラインのキャッシュがどれだけ効いたかをログに出す
+	dxUtility_->LogPipelineCacheStats();
 }
 
 void Framework::Update() {
 
+	PROFILE_SCOPE("Framework::Update");
+
 	// Windowにメッセージが来てたら最優先で処理させる
 	if (winApp->ProcessMessage()) {
 
@@ -108,17 +145,26 @@ void Framework::Update() {
 	}
 	else {
 
-		// 入力の更新
-		Input::GetInstance()->Update();
+		// GPUが使い終わった追い出し済みのテクスチャを解放
+		textureManager_->CollectGarbage();
 
-		// 線マネージャのリセット
-		lineManager_->Clear();
+		// ワーカースレッドから頼まれたメインスレッドのジョブを実行
+		jobSystem_->RunMainThreadJobs();
+
+		// デコード済みのアセットを転送
+		assetLoader_->Update();
 
 		/// === ImGui開始 === ///
 		imguiManager_->Begin();
 
-		// シーンマネージャの更新
-		sceneManager_->Update();
+		// 溜まった実時間の分だけ固定の刻みでシミュレーションを進める (描画の方が速ければ0回のこともある)
+		uint32_t stepCount = GameClock::Tick();
+		for (uint32_t i = 0; i < stepCount; ++i) {
+
+			GameClock::BeginStep();
+
+			FixedUpdate();
+		}
 
 		ShowImGui();
 
@@ -127,8 +173,28 @@ void Framework::Update() {
 	}
 }
 
+void Framework::FixedUpdate() {
+
+	PROFILE_SCOPE("Framework::FixedUpdate");
+
+	// 入力の更新
+	Input::GetInstance()->Update();
+
+	// 線マネージャのリセット (ステップが進まないフレームは前のステップの線をそのまま描く)
+	lineManager_->Clear();
+
+	// シーンマネージャの更新
+	sceneManager_->Update();
+}
+
 void Framework::Finalize() {
 
+	// GPUが処理中のフレームを待ってから解放を始める
+	dxUtility_->WaitIdle();
+
+	// ジョブシステムの終了 (残っているジョブを実行してから止める。以降に積んだジョブはその場で実行する)
+	jobSystem_->Finalize();
+
 	// 線マネージャの終了
 	lineManager_->Finalize();
 
@@ -153,6 +219,12 @@ void Framework::Finalize() {
 	// 3Dオブジェクトレンダラーの終了
 	object3dRenderer_->Finalize();
 
+	// ライトマネージャの終了
+	lightManager_->Finalize();
+
+	// アセットローダーの終了
+	assetLoader_->Finalize();
+
 	// モデルマネージャの終了
 	modelManager_->Finalize();
 
@@ -176,6 +248,12 @@ void Framework::Finalize() {
 
 	// WindowsAPIの終了処理
 	winApp->Finalize();
+
+	// ロガーの終了 (残っているログを書き出す)
+	Logger::Finalize();
+
+	// フレームの統計の終了 (ロガーの書き出しスレッドも止めた後に破棄する)
+	frameCounters_->Finalize();
 }
 
 void Framework::ShowImGui() {
@@ -188,6 +266,39 @@ void Framework::ShowImGui() {
 
 	// シーンのImGui表示
 	sceneManager_->ShowImGui();
+
+	// アセットローダーのImGui表示
+	assetLoader_->ShowImGui();
+
+	// コマンドの並列記録のImGui表示
+	dxUtility_->GetCommandRecorder().ShowImGui();
+
+	// フレームの間隔の調整のImGui表示
+	dxUtility_->GetFramePacer().ShowImGui();
+
+	// プロファイラのImGui表示
+	Profiler::ShowImGui();
+
+	// フレームの統計のImGui表示
+	frameCounters_->ShowImGui();
+}
+
+void Framework::SubmitFrame() {
+
+	PROFILE_SCOPE("Framework::SubmitFrame");
+
+	// バックバッファを表示状態にする
+	swapChain->PostDraw();
+
+	// 並列に記録したものも含めて記録した順に送信する
+	dxUtility_->ExecuteCommandLists();
+
+	// 画面の交換
+	swapChain->Present();
+
+	// フレームの終了と次のフレームの開始 (GPUの完了を待つのはkFrameCount前のフレームだけなので、送信したフレームのGPUの処理と次のフレームの更新は重なる)
+	dxUtility_->EndFrame();
+	dxUtility_->BeginFrame();
 }
 
 void Framework::Run() {
@@ -195,9 +306,18 @@ void Framework::Run() {
 	// 初期化
 	Initialize();
 
+	// 時計を初期化 (読み込みにかかった時間はステップに数えない)
+	GameClock::Initialize(GameClock::kDefaultFixedDeltaTime);
+
 	// ゲームループ
 	while (true) {
 
+		// 前のフレームで計測した区間を集計
+		Profiler::BeginFrame();
+
+		// 前のフレームの統計を取り出す
+		frameCounters_->BeginFrame();
+
 		// 更新
 		Update();
 
@@ -208,6 +328,12 @@ void Framework::Run() {
 
 		// 描画
 		Draw();
+
+		// 目標のフレームレートになるまで待つ
+		{
+			PROFILE_SCOPE("FramePacer::Wait");
+			dxUtility_->GetFramePacer().Wait();
+		}
 	}
 
 	// 終了
@@ -5,6 +5,7 @@
 #include "SceneBuffer.h"
 #include "OffscreenRendering/PostProcessBuffer.h"
 #include "AbstractSceneFactory.h"
+#include "AssetUploadSink.h"
 
 #include <memory>
 
@@ -12,6 +13,8 @@ namespace Engine {
 
 	/// === 前方宣言 === ///
 	
+	class FrameCounters;
+	class JobSystem;
 	class DirectXUtility;
 	class SrvManager;
 	class FilterManager;
@@ -19,6 +22,8 @@ namespace Engine {
 	class TextureManager;
 	class SpriteRenderer;
 	class ModelManager;
+	class AssetLoader;
+	class LightManager;
 	class Object3dRenderer;
 	class SkyBoxRenderer;
 	class ParticleRenderer;
@@ -42,10 +47,15 @@ namespace Engine {
 		virtual void Initialize();
 
 		/// <summary>
-		/// 更新
+		/// 更新 (毎フレーム。溜まった時間の分だけFixedUpdateを呼ぶ)
 		/// </summary>
 		virtual void Update();
 
+		/// <summary>
+		/// 固定の刻み(GameClock::GetDeltaTime)でのシミュレーションの更新
+		/// </summary>
+		virtual void FixedUpdate();
+
 		/// <summary>
 		/// 描画
 		/// </summary>
@@ -72,6 +82,16 @@ namespace Engine {
 		/// </summary>
 		void Run();
 
+		///-------------------------------------------/// 
+		/// クラス内関数
+		///-------------------------------------------///
+	protected:
+
+		/// <summary>
+		/// フレームの送信 (Drawの最後にメインスレッドで呼ぶ。送信したフレームのGPUの完了は待たずに次のフレームへ進む)
+		/// </summary>
+		void SubmitFrame();
+
 		///-------------------------------------------/// 
 		/// メンバ変数
 		///-------------------------------------------///
@@ -85,6 +105,12 @@ namespace Engine {
 		// WindowsAPIのポインタ
 		std::unique_ptr<WinApp> winApp = nullptr;
 
+		// フレームの統計のインスタンス
+		FrameCounters* frameCounters_ = nullptr;
+
+		// ジョブシステムのインスタンス
+		JobSystem* jobSystem_ = nullptr;
+
 		// DirectXユーティリティのインスタンス
 		DirectXUtility* dxUtility_ = nullptr;
 
@@ -97,6 +123,15 @@ namespace Engine {
 		// モデルマネージャのインスタンス
 		ModelManager* modelManager_ = nullptr;
 
+		// アセットローダーのインスタンス
+		AssetLoader* assetLoader_ = nullptr;
+
+		// アセットローダーのGPUへの転送先のポインタ
+		std::unique_ptr<GpuAssetUploadSink> assetUploadSink_ = nullptr;
+
+		// ライトマネージャのインスタンス
+		LightManager* lightManager_ = nullptr;
+
 		// 3Dオブジェクトレンダラーのインスタンス
 		Object3dRenderer* object3dRenderer_ = nullptr;
 
@@ -0,0 +1,113 @@
+#include "GameClock.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+using namespace Engine;
+
+namespace {
+
+	// 1ステップの時間(秒)
+	double fixedDeltaTime = GameClock::kDefaultFixedDeltaTime;
+
+	// まだステップに使っていない時間(秒) (端数が積もってずれないようにdoubleで持つ)
+	double accumulator = 0.0;
+
+	// 前のフレームからの経過時間(秒)
+	float frameTime = 0.0f;
+
+	// 補間係数
+	float alpha = 0.0f;
+
+	// 進めたステップ数
+	uint64_t stepCount = 0;
+
+	// フレーム数
+	uint64_t frameCount = 0;
+
+	// 前回計った時刻
+	std::chrono::steady_clock::time_point lastTime = std::chrono::steady_clock::now();
+}
+
+void GameClock::Initialize(float deltaTime) {
+
+	assert(deltaTime > 0.0f);
+
+	fixedDeltaTime = deltaTime;
+
+	// 最初のフレームで1回は更新してから描画する
+	accumulator = fixedDeltaTime;
+
+	frameTime = 0.0f;
+	alpha = 0.0f;
+	stepCount = 0;
+	frameCount = 0;
+
+	// ここから計り始める
+	lastTime = std::chrono::steady_clock::now();
+}
+
+uint32_t GameClock::Tick() {
+
+	// 前回からの実時間
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	float elapsed = std::chrono::duration<float>(now - lastTime).count();
+	lastTime = now;
+
+	return Advance(elapsed);
+}
+
+uint32_t GameClock::Advance(float elapsed) {
+
+	// 止まっていた分を取り戻そうとしないように切り詰める
+	frameTime = std::clamp(elapsed, 0.0f, kMaxFrameTime);
+	accumulator += frameTime;
+	frameCount++;
+
+	// 溜まった時間で進められるだけステップを進める
+	uint32_t steps = static_cast<uint32_t>(accumulator / fixedDeltaTime);
+
+	// 上限を超えた分は捨てる (処理落ちしている間はゲームがゆっくり進む)
+	if (steps > kMaxStepsPerFrame) {
+		steps = kMaxStepsPerFrame;
+		accumulator = fixedDeltaTime * steps;
+	}
+
+	accumulator -= fixedDeltaTime * steps;
+
+	// 端数の割合で補間する
+	alpha = static_cast<float>(std::clamp(accumulator / fixedDeltaTime, 0.0, 1.0));
+
+	return steps;
+}
+
+void GameClock::BeginStep() {
+
+	stepCount++;
+}
+
+float GameClock::GetDeltaTime() {
+
+	return static_cast<float>(fixedDeltaTime);
+}
+
+float GameClock::GetFrameTime() {
+
+	return frameTime;
+}
+
+float GameClock::GetAlpha() {
+
+	return alpha;
+}
+
+uint64_t GameClock::GetStepCount() {
+
+	return stepCount;
+}
+
+uint64_t GameClock::GetFrameCount() {
+
+	return frameCount;
+}
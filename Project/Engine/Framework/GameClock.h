@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Engine {
+
+	/// === ゲームの時計 === ///
+	/// 実時間を溜めて固定の刻み(ステップ)ごとにシミュレーションを進める
+	/// 描画は何回ステップを進めたかに関係なく毎フレーム行い、溜まりきらなかった端数の割合(補間係数)で前のステップとの間を補間する
+	/// フレームレートが変わってもシミュレーションは同じ刻みで進むので結果は変わらない
+	namespace GameClock {
+
+		/// <summary>
+		/// 初期化 (最初のフレームで必ず1回ステップが進むようにする)
+		/// </summary>
+		/// <param name="fixedDeltaTime">1ステップの時間(秒)</param>
+		void Initialize(float fixedDeltaTime);
+
+		/// <summary>
+		/// 前回からの実時間を計ってフレームを進める
+		/// </summary>
+		/// <returns>このフレームで進めるステップ数</returns>
+		uint32_t Tick();
+
+		/// <summary>
+		/// 経過時間を指定してフレームを進める (実時間に依存しないのでヘッドレスで確かめられる)
+		/// </summary>
+		/// <param name="frameTime">前のフレームからの経過時間(秒)</param>
+		/// <returns>このフレームで進めるステップ数</returns>
+		uint32_t Advance(float frameTime);
+
+		/// <summary>
+		/// ステップの開始 (シミュレーションの更新の直前に呼ぶ)
+		/// </summary>
+		void BeginStep();
+
+		/// <summary>
+		/// 1ステップの時間の取得 (シミュレーションはこの値で進める)
+		/// </summary>
+		/// <returns>秒</returns>
+		float GetDeltaTime();
+
+		/// <summary>
+		/// 前のフレームからの実時間の取得 (上限で切り詰めた値)
+		/// </summary>
+		/// <returns>秒</returns>
+		float GetFrameTime();
+
+		/// <summary>
+		/// 補間係数の取得 (0なら最後のステップの1つ前、1に近いほど最後のステップの状態で描画する)
+		/// </summary>
+		/// <returns>0 ~ 1</returns>
+		float GetAlpha();
+
+		/// <summary>
+		/// これまでに進めたステップ数の取得
+		/// </summary>
+		/// <returns></returns>
+		uint64_t GetStepCount();
+
+		/// <summary>
+		/// これまでのフレーム数の取得
+		/// </summary>
+		/// <returns></returns>
+		uint64_t GetFrameCount();
+
+		/// ===== 定数 ===== ///
+
+		// 1ステップの時間の既定値(秒)
+		const float kDefaultFixedDeltaTime = 1.0f / 60.0f;
+
+		// 1フレームで進めるステップ数の上限 (処理落ちで更に遅れ続けないように、超えた分は捨てる)
+		const uint32_t kMaxStepsPerFrame = 5;
+
+		// 1フレームの経過時間の上限(秒) (ブレークポイントやウィンドウのドラッグで止まった分を取り戻そうとしない)
+		const float kMaxFrameTime = 0.25f;
+	};
+}
@@ -0,0 +1,488 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+
+using namespace Engine;
+
+JobSystem* JobSystem::instance = nullptr;
+thread_local JobSystem::JobCache JobSystem::jobCache;
+std::atomic<uint32_t> JobSystem::generationCount = 0;
+
+namespace {
+
+	// このスレッドのキューの番号 (ジョブシステムのスレッドでなければUINT32_MAX)
+	thread_local uint32_t localQueueIndex = UINT32_MAX;
+}
+
+bool JobSystem::WorkQueue::Push(Job* job) {
+
+	int64_t bottom = bottom_.load(std::memory_order_relaxed);
+	int64_t top = top_.load(std::memory_order_acquire);
+
+	// いっぱいなら積まない
+	if (bottom - top >= static_cast<int64_t>(kCapacity)) {
+		return false;
+	}
+
+	// 書き込んでから位置を進める (盗む側は位置を見てから読むので書きかけを読まない)
+	jobs_[bottom & kMask].store(job, std::memory_order_relaxed);
+	bottom_.store(bottom + 1, std::memory_order_release);
+
+	return true;
+}
+
+JobSystem::Job* JobSystem::WorkQueue::Pop() {
+
+	// 先に位置を戻して、盗む側にこの場所を取らせないようにする
+	int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+	bottom_.store(bottom, std::memory_order_seq_cst);
+	int64_t top = top_.load(std::memory_order_seq_cst);
+
+	// 空なら位置を元に戻す
+	if (top > bottom) {
+		bottom_.store(bottom + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Job* job = jobs_[bottom & kMask].load(std::memory_order_relaxed);
+
+	// 最後の1つは盗む側と取り合う
+	if (top == bottom) {
+		if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			job = nullptr;
+		}
+		bottom_.store(bottom + 1, std::memory_order_relaxed);
+	}
+
+	return job;
+}
+
+JobSystem::Job* JobSystem::WorkQueue::Steal() {
+
+	int64_t top = top_.load(std::memory_order_seq_cst);
+	int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+
+	// 空
+	if (top >= bottom) {
+		return nullptr;
+	}
+
+	// 読んでから位置を進める (進められなければ他のスレッドに取られている)
+	Job* job = jobs_[top & kMask].load(std::memory_order_relaxed);
+	if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+		return nullptr;
+	}
+
+	return job;
+}
+
+JobSystem* JobSystem::GetInstance() {
+
+	if (instance == nullptr) {
+		instance = new JobSystem;
+	}
+	return instance;
+}
+
+void JobSystem::Initialize(uint32_t workerCount) {
+
+	// 呼んだスレッドをメインスレッドにする
+	mainThreadID_ = std::this_thread::get_id();
+
+	// 指定がなければメインスレッドの分を残して論理コア数から決める
+	if (workerCount == 0) {
+		uint32_t hardwareCount = std::thread::hardware_concurrency();
+		workerCount = hardwareCount > 1 ? hardwareCount - 1 : 1;
+	}
+
+	// キューはワーカースレッドを起動する前に全て作っておく (起動した後は増減しない)
+	for (uint32_t i = 0; i < workerCount + 1; ++i) {
+		queues_.push_back(std::make_unique<WorkQueue>());
+	}
+	localQueueIndex = 0;
+
+	// 実行したジョブと盗んだジョブの数をフレームの統計に出す
+	jobCounterID_ = FrameCounters::GetInstance()->Register("Jobs");
+	stealCounterID_ = FrameCounters::GetInstance()->Register("JobSteals");
+
+	// ワーカースレッドを起動
+	isStopping_ = false;
+	for (uint32_t i = 1; i <= workerCount; ++i) {
+		workers_.emplace_back(&JobSystem::WorkerMain, this, i);
+	}
+}
+
+void JobSystem::Finalize() {
+
+	assert(IsMainThread());
+
+	// ワーカースレッドに終了を通知して終了を待つ (自分のキューが空になってから止まる)
+	isStopping_ = true;
+	Wake(true);
+	for (std::thread& worker : workers_) {
+		worker.join();
+	}
+	workers_.clear();
+
+	// 残っているジョブを実行する
+	while (Job* job = FindJob()) {
+		Execute(job);
+	}
+
+	queues_.clear();
+	localQueueIndex = UINT32_MAX;
+
+	delete instance;
+	instance = nullptr;
+}
+
+void JobSystem::SpawnJob(Job* job) {
+
+	// 完了するまで数える
+	if (job->counter) {
+		job->counter->value_.fetch_add(1);
+	}
+
+	Submit(job);
+	Wake(false);
+}
+
+void JobSystem::SpawnJobAfter(Counter& dependency, Job* job) {
+
+	// 依存先が完了する前から数える (待つ側が依存待ちの間に戻らないようにする)
+	if (job->counter) {
+		job->counter->value_.fetch_add(1);
+	}
+
+	// 依存先が完了していなければ、0になったときに積んでもらう
+	{
+		std::lock_guard<std::mutex> lock(dependency.mutex_);
+		if (dependency.value_.load() != 0) {
+			dependency.continuations_.push_back(job);
+			return;
+		}
+	}
+
+	Submit(job);
+	Wake(false);
+}
+
+void JobSystem::Wait(Counter& counter) {
+
+	// 待つ間もジョブを実行する (待っているジョブが自分のキューにあることが多い)
+	while (!counter.IsDone()) {
+
+		if (Job* job = FindJob()) {
+			Execute(job);
+		}
+		else {
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::ParallelFor(const char* name, uint32_t count, uint32_t grainSize, const std::function<void(uint32_t begin, uint32_t end)>& function) {
+
+	if (count == 0) {
+		return;
+	}
+
+	if (grainSize == 0) {
+		grainSize = 1;
+	}
+
+	// 1つのジョブに収まるか、ワーカースレッドがなければその場で処理する
+	if (count <= grainSize || workers_.empty()) {
+		PROFILE_SCOPE(name);
+		function(0, count);
+		return;
+	}
+
+	// 最初の範囲以外をジョブにして積む (起こすのは積み終わってからまとめて)
+	Counter counter;
+	for (uint32_t begin = grainSize; begin < count; begin += grainSize) {
+
+		uint32_t end = (std::min)(begin + grainSize, count);
+
+		counter.value_.fetch_add(1);
+		Submit(CreateJob(name, [&function, begin, end]() { function(begin, end); }, &counter, Affinity::Any));
+	}
+	Wake(true);
+
+	// 最初の範囲はこのスレッドで処理する
+	{
+		PROFILE_SCOPE(name);
+		function(0, grainSize);
+	}
+
+	// 残りを手伝いながら待つ
+	Wait(counter);
+}
+
+void JobSystem::RunMainThreadJobs() {
+
+	assert(IsMainThread());
+
+	// 実行中に積まれた分は次のフレームに回す
+	std::deque<Job*> jobs;
+	{
+		std::lock_guard<std::mutex> lock(mainThreadMutex_);
+		jobs.swap(mainThreadJobs_);
+	}
+
+	for (Job* job : jobs) {
+		Execute(job);
+	}
+}
+
+void JobSystem::WorkerMain(uint32_t workerIndex) {
+
+	// このスレッドのキューを設定
+	localQueueIndex = workerIndex;
+
+	// プロファイラにスレッドの名前を登録
+	Profiler::SetThreadName("Job" + std::to_string(workerIndex));
+
+	// ジョブが見つからなかった回数
+	uint32_t idleCount = 0;
+
+	while (true) {
+
+		// 合図を見てから探す (探した後に積まれたら合図が変わっているので寝ずに戻る)
+		uint32_t observed = signal_.load();
+
+		if (Job* job = FindJob()) {
+			Execute(job);
+			idleCount = 0;
+			continue;
+		}
+
+		if (isStopping_) {
+			return;
+		}
+
+		// すぐに次のジョブが来ることが多いので、しばらくは寝ずに探し直す
+		if (++idleCount < kSpinCount) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		// 次の合図まで寝る
+		sleepingCount_.fetch_add(1);
+		signal_.wait(observed);
+		sleepingCount_.fetch_sub(1);
+		idleCount = 0;
+	}
+}
+
+JobSystem::Job* JobSystem::AllocateJob() {
+
+	JobCache& cache = GetJobCache();
+
+	// 空なら共有の置き場からまとめて受け取り、それも無ければまとめて確保する
+	if (cache.head == nullptr) {
+
+		std::lock_guard<std::mutex> lock(jobPoolMutex_);
+
+		if (!freeJobBatches_.empty()) {
+			cache.head = freeJobBatches_.back();
+			freeJobBatches_.pop_back();
+		}
+		else {
+			std::unique_ptr<Job[]>& block = jobBlocks_.emplace_back(std::make_unique<Job[]>(kJobBatchSize));
+			for (uint32_t i = 0; i < kJobBatchSize; ++i) {
+				block[i].next = i + 1 < kJobBatchSize ? &block[i + 1] : nullptr;
+			}
+			cache.head = &block[0];
+			allocatedJobCount_.fetch_add(kJobBatchSize, std::memory_order_relaxed);
+		}
+		cache.count = kJobBatchSize;
+	}
+
+	// 先頭から取り出す
+	Job* job = cache.head;
+	cache.head = job->next;
+	cache.count--;
+
+	return job;
+}
+
+void JobSystem::FreeJob(Job* job) {
+
+	JobCache& cache = GetJobCache();
+
+	// 先頭に戻す
+	job->next = cache.head;
+	cache.head = job;
+	cache.count++;
+
+	// 盗まれたジョブは積んだスレッドに戻らないので、溜まりすぎたら半分を積む側に渡せるようにする
+	if (cache.count >= kJobBatchSize * 2) {
+
+		Job* batch = cache.head;
+		Job* last = batch;
+		for (uint32_t i = 1; i < kJobBatchSize; ++i) {
+			last = last->next;
+		}
+		cache.head = last->next;
+		cache.count -= kJobBatchSize;
+		last->next = nullptr;
+
+		std::lock_guard<std::mutex> lock(jobPoolMutex_);
+		freeJobBatches_.push_back(batch);
+	}
+}
+
+JobSystem::JobCache& JobSystem::GetJobCache() {
+
+	// 前のジョブシステムのジョブは確保したものごと解放されているので使わない
+	if (jobCache.generation != generation_) {
+		jobCache = { nullptr, 0, generation_ };
+	}
+
+	return jobCache;
+}
+
+void JobSystem::Submit(Job* job) {
+
+	// 初期化の前はその場で実行する
+	if (queues_.empty()) {
+		Execute(job);
+		return;
+	}
+
+	// メインスレッド指定ならメインスレッドが取り出すまで置いておく
+	if (job->affinity == Affinity::MainThread) {
+		std::lock_guard<std::mutex> lock(mainThreadMutex_);
+		mainThreadJobs_.push_back(job);
+		return;
+	}
+
+	// ジョブシステムのスレッドなら自分のキューに積む (いっぱいならその場で実行する)
+	uint32_t index = localQueueIndex;
+	if (index < queues_.size()) {
+		if (!queues_[index]->Push(job)) {
+			Execute(job);
+		}
+		return;
+	}
+
+	// それ以外のスレッドからは共有の列に積む
+	std::lock_guard<std::mutex> lock(externalMutex_);
+	externalJobs_.push_back(job);
+	hasExternalJobs_ = true;
+}
+
+JobSystem::Job* JobSystem::FindJob() {
+
+	uint32_t queueCount = static_cast<uint32_t>(queues_.size());
+	uint32_t index = localQueueIndex;
+
+	// ----------自分のキュー----------
+	if (index < queueCount) {
+		if (Job* job = queues_[index]->Pop()) {
+			return job;
+		}
+	}
+
+	// ----------メインスレッド指定のジョブ----------
+	if (IsMainThread()) {
+		std::lock_guard<std::mutex> lock(mainThreadMutex_);
+		if (!mainThreadJobs_.empty()) {
+			Job* job = mainThreadJobs_.front();
+			mainThreadJobs_.pop_front();
+			return job;
+		}
+	}
+
+	// ----------外から積まれたジョブ----------
+	if (hasExternalJobs_) {
+		std::lock_guard<std::mutex> lock(externalMutex_);
+		if (!externalJobs_.empty()) {
+			Job* job = externalJobs_.front();
+			externalJobs_.pop_front();
+			hasExternalJobs_ = !externalJobs_.empty();
+			return job;
+		}
+	}
+
+	// ----------他のキューから盗む (隣から順に見て、盗む先が偏らないようにする)----------
+	uint32_t start = index < queueCount ? index : 0;
+	for (uint32_t i = 1; i <= queueCount; ++i) {
+
+		uint32_t victim = (start + i) % queueCount;
+		if (victim == index) {
+			continue;
+		}
+
+		if (Job* job = queues_[victim]->Steal()) {
+			FrameCounters::GetInstance()->Add(stealCounterID_);
+			return job;
+		}
+	}
+
+	return nullptr;
+}
+
+void JobSystem::Execute(Job* job) {
+
+	{
+		PROFILE_SCOPE(job->name);
+		job->invoke(job->storage);
+	}
+
+	FrameCounters::GetInstance()->Add(jobCounterID_);
+
+	// キャプチャした変数を破棄してから完了を知らせる (待っている側が戻った後に触らない)
+	Counter* counter = job->counter;
+	job->destroy(job->storage);
+	FreeJob(job);
+
+	if (counter) {
+		Decrement(*counter);
+	}
+}
+
+void JobSystem::Decrement(Counter& counter) {
+
+	// 減らしている間は待つ側に戻らせない
+	counter.busy_.fetch_add(1);
+
+	// 0になったら続きのジョブを取り出す
+	std::vector<Job*> continuations;
+	if (counter.value_.fetch_sub(1) == 1) {
+		std::lock_guard<std::mutex> lock(counter.mutex_);
+		continuations.swap(counter.continuations_);
+	}
+
+	// 続きのジョブを積む前にカウンターから手を離す (続きのジョブを待った側は依存先のカウンターを破棄してよい)
+	counter.busy_.fetch_sub(1);
+
+	for (Job* job : continuations) {
+		Submit(job);
+	}
+
+	if (!continuations.empty()) {
+		Wake(true);
+	}
+}
+
+void JobSystem::Wake(bool isAll) {
+
+	// 合図を変えてから、寝ているワーカースレッドがいるときだけ起こす
+	signal_.fetch_add(1);
+
+	if (sleepingCount_.load() == 0) {
+		return;
+	}
+
+	if (isAll) {
+		signal_.notify_all();
+	}
+	else {
+		signal_.notify_one();
+	}
+}
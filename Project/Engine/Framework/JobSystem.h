@@ -0,0 +1,484 @@
+#pragma once
+
+#include "FrameCounters.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Engine {
+
+	/// === ジョブシステム === ///
+	/// ワーカースレッドごとの両端キューにジョブを積み、自分のキューが空になったら他のキューから盗んで実行する
+	/// 完了はカウンターで数え、カウンターを待つ間は待っているスレッドもジョブを実行する
+	/// D3D12の呼び出しなどメインスレッドでしか行えない処理は、メインスレッド指定のジョブにしてメインスレッドで実行する
+	/// Initializeを呼んだスレッドをメインスレッドとして扱う
+	/// ジョブはスレッドごとの置き場から使い回し、処理もジョブの中に直接入れるので、積むたびにヒープに確保しない
+	class JobSystem {
+
+		///-------------------------------------------///
+		/// シングルトン
+		///-------------------------------------------///
+	private:
+
+		// インスタンス
+		static JobSystem* instance;
+
+		// コンストラクタの隠蔽
+		JobSystem() = default;
+		// デストラクタの隠蔽
+		~JobSystem() = default;
+		// コピーコンストラクタの封印
+		JobSystem(JobSystem&) = delete;
+		// コピー代入演算子の封印
+		JobSystem& operator=(JobSystem&) = delete;
+
+		///-------------------------------------------///
+		/// 構造体
+		///-------------------------------------------///
+	public:
+
+		// 実行するスレッドの指定
+		enum class Affinity {
+			Any,			// どのスレッドでもよい
+			MainThread,		// メインスレッドだけ (D3D12の呼び出しなど)
+		};
+
+	private:
+
+		// ジョブ
+		struct Job;
+
+	public:
+
+		/// === ジョブの完了を数えるカウンター === ///
+		/// Spawnで渡すと1増え、そのジョブが完了すると1減る。0になったら全て完了
+		/// 待っているジョブが全て完了する(Waitから戻る)まで破棄しないこと
+		class Counter {
+
+			friend class JobSystem;
+
+			///-------------------------------------------///
+			/// メンバ関数
+			///-------------------------------------------///
+		public:
+
+			/// <summary>
+			/// コンストラクタ
+			/// </summary>
+			Counter() = default;
+
+			// コピーの封印
+			Counter(const Counter&) = delete;
+			Counter& operator=(const Counter&) = delete;
+
+			/// <summary>
+			/// 全て完了したか
+			/// </summary>
+			/// <returns></returns>
+			bool IsDone() const { return value_.load() == 0 && busy_.load() == 0; }
+
+			///-------------------------------------------///
+			/// メンバ変数
+			///-------------------------------------------///
+		private:
+
+			// 完了していないジョブの数
+			std::atomic<uint32_t> value_ = 0;
+
+			// 減らしている途中のスレッドの数 (0になった直後に破棄されないように待つ)
+			std::atomic<uint32_t> busy_ = 0;
+
+			// 0になったら実行するジョブを守るミューテックス
+			std::mutex mutex_;
+
+			// 0になったら実行するジョブ
+			std::vector<Job*> continuations_;
+		};
+
+	private:
+
+		// ジョブに直接入れる処理の大きさの上限 (超えたら処理だけをヒープに確保する)
+		static const size_t kJobStorageSize = 64;
+
+		// ジョブ
+		struct Job {
+			const char* name;					// 名前 (プロファイラに表示する)
+			Counter* counter;					// 完了したら減らすカウンター
+			Affinity affinity;					// 実行するスレッドの指定
+			void (*invoke)(void* storage);		// 処理を呼ぶ
+			void (*destroy)(void* storage);		// 処理を破棄する
+			Job* next;							// 置き場で次に繋ぐジョブ
+			alignas(std::max_align_t) std::byte storage[kJobStorageSize];	// 処理 (キャプチャした変数ごと入れる)
+		};
+
+		// スレッドごとの使い終わったジョブの置き場 (ロックを使わずに取り出して戻せる)
+		struct JobCache {
+			Job* head = nullptr;		// 先頭
+			uint32_t count = 0;			// 数
+			uint32_t generation = 0;	// どのジョブシステムのジョブか (破棄した後に残ったものを使わない)
+		};
+
+		/// === ワーカースレッドごとのジョブのキュー === ///
+		/// 持ち主のスレッドは後ろから積んで後ろから取り出し、他のスレッドは前から盗む
+		/// 取り合いになるのは最後の1つのときだけなので、持ち主はほとんどの場合ロックも比較交換もしない
+		class WorkQueue {
+
+			///-------------------------------------------///
+			/// メンバ関数
+			///-------------------------------------------///
+		public:
+
+			/// <summary>
+			/// 後ろに積む (持ち主のスレッド専用)
+			/// </summary>
+			/// <param name="job">ジョブ</param>
+			/// <returns>積めたか (いっぱいならfalse)</returns>
+			bool Push(Job* job);
+
+			/// <summary>
+			/// 後ろから取り出す (持ち主のスレッド専用)
+			/// </summary>
+			/// <returns>ジョブ (空ならnullptr)</returns>
+			Job* Pop();
+
+			/// <summary>
+			/// 前から盗む (どのスレッドからでも呼べる)
+			/// </summary>
+			/// <returns>ジョブ (空か取り合いに負けたらnullptr)</returns>
+			Job* Steal();
+
+			///-------------------------------------------///
+			/// 定数
+			///-------------------------------------------///
+		public:
+
+			// 入るジョブの数 (2の累乗。いっぱいのときは積まずにその場で実行する)
+			static const uint32_t kCapacity = 4096;
+
+			// 位置を容量で割った余りにするマスク
+			static const int64_t kMask = kCapacity - 1;
+
+			///-------------------------------------------///
+			/// メンバ変数
+			///-------------------------------------------///
+		private:
+
+			// 次に盗む位置 (盗む側が進める)
+			alignas(64) std::atomic<int64_t> top_ = 0;
+
+			// 次に積む位置 (持ち主が進める)
+			alignas(64) std::atomic<int64_t> bottom_ = 0;
+
+			// ジョブ (位置を容量で割った余りの場所に入れる)
+			alignas(64) std::atomic<Job*> jobs_[kCapacity] = {};
+		};
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// インスタンスの取得
+		/// </summary>
+		/// <returns></returns>
+		static JobSystem* GetInstance();
+
+		/// <summary>
+		/// 初期化 (呼んだスレッドをメインスレッドにする)
+		/// </summary>
+		/// <param name="workerCount">ワーカースレッド数 (0なら論理コア数から決める)</param>
+		void Initialize(uint32_t workerCount = 0);
+
+		/// <summary>
+		/// 終了 (残っているジョブを実行してからワーカースレッドを止める)
+		/// </summary>
+		void Finalize();
+
+		/// <summary>
+		/// ジョブの追加
+		/// </summary>
+		/// <param name="name">名前 (文字列リテラルなど、実行が終わるまで消えないもの)</param>
+		/// <param name="function">処理 (引数なしで呼べるもの)</param>
+		/// <param name="counter">完了したら減らすカウンター (nullptrなら数えない)</param>
+		/// <param name="affinity">実行するスレッドの指定</param>
+		template <typename Function>
+		void Spawn(const char* name, Function&& function, Counter* counter = nullptr, Affinity affinity = Affinity::Any);
+
+		/// <summary>
+		/// 依存するジョブが完了してから実行するジョブの追加
+		/// </summary>
+		/// <param name="dependency">依存するジョブのカウンター (0になったら実行する)</param>
+		/// <param name="name">名前 (文字列リテラルなど、実行が終わるまで消えないもの)</param>
+		/// <param name="function">処理 (引数なしで呼べるもの)</param>
+		/// <param name="counter">完了したら減らすカウンター (nullptrなら数えない)</param>
+		/// <param name="affinity">実行するスレッドの指定</param>
+		template <typename Function>
+		void SpawnAfter(Counter& dependency, const char* name, Function&& function, Counter* counter = nullptr, Affinity affinity = Affinity::Any);
+
+		/// <summary>
+		/// カウンターが0になるまで待つ (待つ間はこのスレッドもジョブを実行する)
+		/// </summary>
+		/// <param name="counter">カウンター</param>
+		void Wait(Counter& counter);
+
+		/// <summary>
+		/// 範囲を分割して並列に処理する (全て終わるまで戻らない)
+		/// </summary>
+		/// <param name="name">名前 (プロファイラに表示する)</param>
+		/// <param name="count">要素数</param>
+		/// <param name="grainSize">1つのジョブで処理する要素数</param>
+		/// <param name="function">処理 ([begin, end)の範囲を受け取る。他の範囲と同時に呼ばれる)</param>
+		void ParallelFor(const char* name, uint32_t count, uint32_t grainSize, const std::function<void(uint32_t begin, uint32_t end)>& function);
+
+		/// <summary>
+		/// 要素ごとに並列に処理する (全て終わるまで戻らない)
+		/// </summary>
+		/// <param name="name">名前 (プロファイラに表示する)</param>
+		/// <param name="items">要素</param>
+		/// <param name="grainSize">1つのジョブで処理する要素数</param>
+		/// <param name="function">処理 (要素を受け取る。他の要素と同時に呼ばれる)</param>
+		template <typename T, typename Function>
+		void ParallelFor(const char* name, std::span<T> items, uint32_t grainSize, Function function);
+
+		/// <summary>
+		/// メインスレッド指定のジョブを全て実行する (メインスレッドから毎フレーム呼ぶ)
+		/// </summary>
+		void RunMainThreadJobs();
+
+		///-------------------------------------------///
+		/// クラス内関数
+		///-------------------------------------------///
+	private:
+
+		/// <summary>
+		/// ワーカースレッドの処理
+		/// </summary>
+		/// <param name="workerIndex">ワーカーの番号 (1から。0はメインスレッド)</param>
+		void WorkerMain(uint32_t workerIndex);
+
+		/// <summary>
+		/// ジョブを作る (置き場から取り出して処理を入れる)
+		/// </summary>
+		/// <param name="name">名前</param>
+		/// <param name="function">処理</param>
+		/// <param name="counter">完了したら減らすカウンター</param>
+		/// <param name="affinity">実行するスレッドの指定</param>
+		/// <returns>ジョブ</returns>
+		template <typename Function>
+		Job* CreateJob(const char* name, Function&& function, Counter* counter, Affinity affinity);
+
+		/// <summary>
+		/// 作ったジョブを数えて積む
+		/// </summary>
+		/// <param name="job">ジョブ</param>
+		void SpawnJob(Job* job);
+
+		/// <summary>
+		/// 作ったジョブを数えて、依存するジョブが完了してから積む
+		/// </summary>
+		/// <param name="dependency">依存するジョブのカウンター</param>
+		/// <param name="job">ジョブ</param>
+		void SpawnJobAfter(Counter& dependency, Job* job);
+
+		/// <summary>
+		/// このスレッドの置き場からジョブを取り出す (空なら共有の置き場からまとめて受け取るか、新しく確保する)
+		/// </summary>
+		/// <returns>ジョブ</returns>
+		Job* AllocateJob();
+
+		/// <summary>
+		/// このスレッドの置き場にジョブを戻す (溜まりすぎたらまとめて共有の置き場に移す)
+		/// </summary>
+		/// <param name="job">ジョブ</param>
+		void FreeJob(Job* job);
+
+		/// <summary>
+		/// このスレッドの置き場の取得 (別のジョブシステムのものなら空にする)
+		/// </summary>
+		/// <returns></returns>
+		JobCache& GetJobCache();
+
+		/// <summary>
+		/// 実行できる状態になったジョブを積む
+		/// </summary>
+		/// <param name="job">ジョブ</param>
+		void Submit(Job* job);
+
+		/// <summary>
+		/// 実行するジョブを探す (自分のキュー → メインスレッドのジョブ → 外から積まれたジョブ → 他のキューの順)
+		/// </summary>
+		/// <returns>ジョブ (なければnullptr)</returns>
+		Job* FindJob();
+
+		/// <summary>
+		/// ジョブを実行して破棄する
+		/// </summary>
+		/// <param name="job">ジョブ</param>
+		void Execute(Job* job);
+
+		/// <summary>
+		/// カウンターを1減らし、0になったら続きのジョブを積む
+		/// </summary>
+		/// <param name="counter">カウンター</param>
+		void Decrement(Counter& counter);
+
+		/// <summary>
+		/// 寝ているワーカースレッドを起こす
+		/// </summary>
+		/// <param name="isAll">全て起こすか (falseなら1つ)</param>
+		void Wake(bool isAll);
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// ワーカースレッド数の取得 (メインスレッドは含まない)
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workers_.size()); }
+
+		/// <summary>
+		/// メインスレッドかの取得
+		/// </summary>
+		/// <returns></returns>
+		bool IsMainThread() const { return std::this_thread::get_id() == mainThreadID_; }
+
+		/// <summary>
+		/// 確保したジョブの数の取得 (使い回せていれば積む数が同じ間は増えない)
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetAllocatedJobCount() const { return allocatedJobCount_.load(std::memory_order_relaxed); }
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// キュー (0はメインスレッド、1からはワーカースレッド)
+		std::vector<std::unique_ptr<WorkQueue>> queues_;
+
+		// ワーカースレッド
+		std::vector<std::thread> workers_;
+
+		// メインスレッドのID
+		std::thread::id mainThreadID_;
+
+		// メインスレッド指定のジョブ
+		std::deque<Job*> mainThreadJobs_;
+		std::mutex mainThreadMutex_;
+
+		// ジョブシステムのスレッド以外から積まれたジョブ
+		std::deque<Job*> externalJobs_;
+		std::mutex externalMutex_;
+
+		// 外から積まれたジョブがあるか (空のときにロックしないで済ませる)
+		std::atomic<bool> hasExternalJobs_ = false;
+
+		// ジョブが積まれた合図 (寝ているワーカースレッドはこれが変わるまで待つ)
+		std::atomic<uint32_t> signal_ = 0;
+
+		// 寝ているワーカースレッドの数 (誰も寝ていなければ起こさない)
+		std::atomic<uint32_t> sleepingCount_ = 0;
+
+		// 終了中か
+		std::atomic<bool> isStopping_ = false;
+
+		// このジョブシステムの番号 (スレッドごとの置き場がどのジョブシステムのものかを見分ける)
+		uint32_t generation_ = ++generationCount;
+
+		// 確保したジョブ (まとめて確保し、終了するまで解放しない)
+		std::vector<std::unique_ptr<Job[]>> jobBlocks_;
+
+		// スレッドの間で受け渡す使い終わったジョブ (kJobBatchSize個ずつ繋いだものの先頭)
+		std::vector<Job*> freeJobBatches_;
+		std::mutex jobPoolMutex_;
+
+		// 確保したジョブの数
+		std::atomic<uint32_t> allocatedJobCount_ = 0;
+
+		// スレッドごとの使い終わったジョブの置き場
+		static thread_local JobCache jobCache;
+
+		// 作ったジョブシステムの数
+		static std::atomic<uint32_t> generationCount;
+
+		// フレームの統計のカウンター
+		FrameCounters::CounterID jobCounterID_ = FrameCounters::kInvalidCounterID;
+		FrameCounters::CounterID stealCounterID_ = FrameCounters::kInvalidCounterID;
+
+		///-------------------------------------------///
+		/// 定数
+		///-------------------------------------------///
+	private:
+
+		// 寝る前にジョブを探し直す回数
+		static const uint32_t kSpinCount = 64;
+
+		// スレッドの間で受け渡すジョブの数 (置き場にこの2倍溜まったら半分を共有の置き場に移す)
+		static const uint32_t kJobBatchSize = 64;
+	};
+
+	template <typename Function>
+	inline void JobSystem::Spawn(const char* name, Function&& function, Counter* counter, Affinity affinity) {
+
+		SpawnJob(CreateJob(name, std::forward<Function>(function), counter, affinity));
+	}
+
+	template <typename Function>
+	inline void JobSystem::SpawnAfter(Counter& dependency, const char* name, Function&& function, Counter* counter, Affinity affinity) {
+
+		SpawnJobAfter(dependency, CreateJob(name, std::forward<Function>(function), counter, affinity));
+	}
+
+	template <typename Function>
+	inline JobSystem::Job* JobSystem::CreateJob(const char* name, Function&& function, Counter* counter, Affinity affinity) {
+
+		using Stored = std::decay_t<Function>;
+
+		Job* job = AllocateJob();
+		job->name = name;
+		job->counter = counter;
+		job->affinity = affinity;
+
+		// 入るならジョブの中に直接作る
+		if constexpr (sizeof(Stored) <= kJobStorageSize && alignof(Stored) <= alignof(std::max_align_t)) {
+
+			new (job->storage) Stored(std::forward<Function>(function));
+			job->invoke = [](void* storage) { (*static_cast<Stored*>(storage))(); };
+			job->destroy = [](void* storage) { static_cast<Stored*>(storage)->~Stored(); };
+		}
+		// 入らなければヒープに作ってポインタを入れる
+		else {
+
+			new (job->storage) Stored*(new Stored(std::forward<Function>(function)));
+			job->invoke = [](void* storage) { (**static_cast<Stored**>(storage))(); };
+			job->destroy = [](void* storage) { delete *static_cast<Stored**>(storage); };
+		}
+
+		return job;
+	}
+
+	template <typename T, typename Function>
+	inline void JobSystem::ParallelFor(const char* name, std::span<T> items, uint32_t grainSize, Function function) {
+
+		ParallelFor(name, static_cast<uint32_t>(items.size()), grainSize, [&items, &function](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				function(items[i]);
+			}
+		});
+	}
+}
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Engine {
+
+	/// === オブジェクトプール === ///
+	/// 初期化で容量の数だけオブジェクトを作っておき、取り出しと返却は空きの番号を積み下ろすだけにする
+	/// 重い初期化(モデルやコライダーの生成)は作ったときに1回だけ行い、取り出すたびの初期化はリセットのフックで行う
+	/// 容量を超えて取り出そうとしたときは増やさずnullptrを返すので、最大数と足りなかった回数を見て容量を調整する
+	template <typename T>
+	class ObjectPool {
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 初期化 (容量の数だけ作る)
+		/// </summary>
+		/// <param name="capacity">容量</param>
+		/// <param name="onCreate">作ったときの処理 (重い初期化はここで行う)</param>
+		void Initialize(uint32_t capacity, const std::function<void(T&)>& onCreate = nullptr);
+
+		/// <summary>
+		/// 取り出す (取り出したときの処理を呼ぶ)
+		/// </summary>
+		/// <returns>オブジェクト (空きがなければnullptr)</returns>
+		T* Acquire();
+
+		/// <summary>
+		/// 返却 (返却したときの処理を呼ぶ)
+		/// </summary>
+		/// <param name="object">このプールから取り出したオブジェクト</param>
+		void Release(T* object);
+
+		/// <summary>
+		/// 取り出し中のオブジェクトを全て返却
+		/// </summary>
+		void ReleaseAll();
+
+		///-------------------------------------------///
+		/// セッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 取り出したときの処理のセッター (前に使ったときの状態をリセットする)
+		/// </summary>
+		/// <param name="onAcquire"></param>
+		void SetOnAcquire(const std::function<void(T&)>& onAcquire) { onAcquire_ = onAcquire; }
+
+		/// <summary>
+		/// 返却したときの処理のセッター
+		/// </summary>
+		/// <param name="onRelease"></param>
+		void SetOnRelease(const std::function<void(T&)>& onRelease) { onRelease_ = onRelease; }
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 容量のゲッター
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetCapacity() const { return capacity_; }
+
+		/// <summary>
+		/// 取り出し中の数のゲッター
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetActiveCount() const { return capacity_ - static_cast<uint32_t>(freeIndices_.size()); }
+
+		/// <summary>
+		/// 同時に取り出した最大数のゲッター (容量の調整に使う)
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetPeakActiveCount() const { return peakActiveCount_; }
+
+		/// <summary>
+		/// 空きがなくて取り出せなかった回数のゲッター
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetExhaustedCount() const { return exhaustedCount_; }
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// オブジェクト (初期化で作ったら並びもアドレスも変わらない)
+		std::unique_ptr<T[]> objects_ = nullptr;
+
+		// 容量
+		uint32_t capacity_ = 0;
+
+		// 空いているオブジェクトの番号 (末尾から取り出す)
+		std::vector<uint32_t> freeIndices_;
+
+		// 取り出し中か (番号ごと)
+		std::vector<uint8_t> isActive_;
+
+		// 同時に取り出した最大数
+		uint32_t peakActiveCount_ = 0;
+
+		// 空きがなくて取り出せなかった回数
+		uint32_t exhaustedCount_ = 0;
+
+		// 取り出したときの処理
+		std::function<void(T&)> onAcquire_ = nullptr;
+
+		// 返却したときの処理
+		std::function<void(T&)> onRelease_ = nullptr;
+	};
+
+	///-------------------------------------------///
+	/// ObjectPool
+	///-------------------------------------------///
+
+	template <typename T>
+	void ObjectPool<T>::Initialize(uint32_t capacity, const std::function<void(T&)>& onCreate) {
+
+		assert(capacity > 0);
+
+		// 容量の数だけ作る
+		capacity_ = capacity;
+		objects_ = std::make_unique<T[]>(capacity);
+
+		if (onCreate) {
+			for (uint32_t index = 0; index < capacity; index++) {
+				onCreate(objects_[index]);
+			}
+		}
+
+		// 先頭の番号から取り出されるように逆順に積む
+		freeIndices_.clear();
+		freeIndices_.reserve(capacity);
+		for (uint32_t index = capacity; index-- > 0;) {
+			freeIndices_.push_back(index);
+		}
+
+		isActive_.assign(capacity, 0);
+		peakActiveCount_ = 0;
+		exhaustedCount_ = 0;
+	}
+
+	template <typename T>
+	T* ObjectPool<T>::Acquire() {
+
+		// 空きがなければ増やさずに数える
+		if (freeIndices_.empty()) {
+			exhaustedCount_++;
+			return nullptr;
+		}
+
+		uint32_t index = freeIndices_.back();
+		freeIndices_.pop_back();
+		isActive_[index] = 1;
+
+		// 最大数を更新
+		peakActiveCount_ = (std::max)(peakActiveCount_, GetActiveCount());
+
+		// 前に使ったときの状態をリセット
+		T& object = objects_[index];
+		if (onAcquire_) {
+			onAcquire_(object);
+		}
+
+		return &object;
+	}
+
+	template <typename T>
+	void ObjectPool<T>::Release(T* object) {
+
+		// このプールのオブジェクトで、取り出し中であること
+		assert(object >= objects_.get() && object < objects_.get() + capacity_);
+		uint32_t index = static_cast<uint32_t>(object - objects_.get());
+		assert(isActive_[index]);
+
+		if (onRelease_) {
+			onRelease_(*object);
+		}
+
+		isActive_[index] = 0;
+		freeIndices_.push_back(index);
+	}
+
+	template <typename T>
+	void ObjectPool<T>::ReleaseAll() {
+
+		for (uint32_t index = 0; index < capacity_; index++) {
+			if (isActive_[index]) {
+				Release(&objects_[index]);
+			}
+		}
+	}
+}
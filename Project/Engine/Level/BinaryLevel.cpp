@@ -0,0 +1,145 @@
+#include "BinaryLevel.h"
+#include "Logger.h"
+
+#include <cassert>
+
+using namespace Engine;
+
+bool BinaryLevel::Open(const std::string& filePath) {
+
+	// 開いていたら閉じる
+	Close();
+
+	// ファイルをメモリにマップする
+	if (!file_.Open(filePath)) return false;
+
+	// ヘッダーを確認
+	const LevelFileFormat::Header* header = file_.GetPointer<LevelFileFormat::Header>(0);
+	if (header == nullptr || header->magic != LevelFileFormat::kMagic || header->version != LevelFileFormat::kVersion) {
+		LOG_WARNING("BinaryLevel::Open: Invalid level file {}\n", filePath);
+		Close();
+		return false;
+	}
+
+	// 各配列を参照する (解析はせずにオフセットから直接参照するだけ)
+	const LevelFileFormat::Model* models = file_.GetPointer<LevelFileFormat::Model>(header->modelOffset, header->modelCount);
+	const LevelFileFormat::Object* objects = file_.GetPointer<LevelFileFormat::Object>(header->objectOffset, header->objectCount);
+	const LevelFileFormat::Spawn* players = file_.GetPointer<LevelFileFormat::Spawn>(header->playerOffset, header->playerCount);
+	const LevelFileFormat::Spawn* enemies = file_.GetPointer<LevelFileFormat::Spawn>(header->enemyOffset, header->enemyCount);
+	const char* stringTable = file_.GetPointer<char>(header->stringTableOffset, header->stringTableSize);
+
+	// 範囲外を指していたら壊れたファイルとして扱う
+	if ((header->modelCount && !models) || (header->objectCount && !objects) || (header->playerCount && !players) || (header->enemyCount && !enemies) || (header->stringTableSize && !stringTable)) {
+		LOG_WARNING("BinaryLevel::Open: Broken level file {}\n", filePath);
+		Close();
+		return false;
+	}
+
+	// モデルテーブルの範囲外を参照しているオブジェクトがあれば壊れたファイルとして扱う
+	for (uint32_t objectIndex = 0; objectIndex < header->objectCount; ++objectIndex) {
+		if (objects[objectIndex].modelIndex >= header->modelCount) {
+			LOG_WARNING("BinaryLevel::Open: Broken level file {}\n", filePath);
+			Close();
+			return false;
+		}
+	}
+
+	// 配列として保持
+	models_ = { models, header->modelCount };
+	objects_ = { objects, header->objectCount };
+	players_ = { players, header->playerCount };
+	enemies_ = { enemies, header->enemyCount };
+	stringTable_ = { stringTable, header->stringTableSize };
+
+	return true;
+}
+
+void BinaryLevel::Close() {
+
+	// ハンドルを手放す
+	modelHandles_.clear();
+
+	// 参照をクリア
+	models_ = {};
+	objects_ = {};
+	players_ = {};
+	enemies_ = {};
+	stringTable_ = {};
+
+	// マップを解除
+	file_.Close();
+}
+
+void BinaryLevel::ResolveModels() {
+
+	// モデルマネージャのインスタンス
+	ModelManager* modelManager = ModelManager::GetInstance();
+
+	modelHandles_.clear();
+	modelHandles_.reserve(models_.size());
+
+	for (const LevelFileFormat::Model& model : models_) {
+
+		// ディレクトリ名とモデル名からハンドルを取得 (読み込まれていなければ読み込む)
+		ModelHandle handle = modelManager->AcquireModelData(std::string(GetString(model.directoryOffset, model.directoryLength)), std::string(GetString(model.nameOffset, model.nameLength)) + ".obj");
+
+		// エクスポーターとエンジンでIDの求め方がずれていたら止める
+		assert(handle.GetID() == model.id);
+
+		modelHandles_.push_back(std::move(handle));
+	}
+}
+
+std::unique_ptr<LevelData> BinaryLevel::ToLevelData() const {
+
+	std::unique_ptr<LevelData> levelData = std::make_unique<LevelData>();
+
+	/// === オブジェクト === ///
+
+	levelData->GetObjects().reserve(objects_.size());
+
+	for (const LevelFileFormat::Object& object : objects_) {
+
+		// 参照しているモデル
+		const LevelFileFormat::Model& model = models_[object.modelIndex];
+
+		LevelData::ObjectData& objectData = levelData->GetObjects().emplace_back();
+		objectData.fileName = GetString(model.nameOffset, model.nameLength);
+		objectData.directoryName = GetString(model.directoryOffset, model.directoryLength);
+		objectData.modelID = model.id;
+		objectData.translation = object.translation;
+		objectData.rotation = object.rotation;
+		objectData.scale = object.scale;
+
+		// コライダー
+		if (object.colliderType == LevelFileFormat::ColliderType::Box) {
+			objectData.collider.type = "BOX";
+			objectData.collider.center = object.colliderCenter;
+			objectData.collider.size = object.colliderSize;
+		}
+	}
+
+	/// === 自キャラ、敵キャラ === ///
+
+	levelData->GetPlayers().reserve(players_.size());
+
+	for (const LevelFileFormat::Spawn& spawn : players_) {
+		levelData->GetPlayers().push_back({ spawn.translation, spawn.rotation, 0 });
+	}
+
+	levelData->GetEnemies().reserve(enemies_.size());
+
+	for (const LevelFileFormat::Spawn& spawn : enemies_) {
+		levelData->GetEnemies().push_back({ spawn.translation, spawn.rotation, 0 });
+	}
+
+	return levelData;
+}
+
+std::string_view BinaryLevel::GetString(uint32_t offset, uint32_t length) const {
+
+	// 範囲外なら空
+	if (length == 0 || static_cast<uint64_t>(offset) + length > stringTable_.size()) return std::string_view();
+
+	return stringTable_.substr(offset, length);
+}
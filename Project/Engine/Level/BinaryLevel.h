@@ -0,0 +1,125 @@
+#pragma once
+
+#include "LevelData.h"
+#include "LevelFileFormat.h"
+#include "MappedFile.h"
+#include "Model/ModelManager.h"
+
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Engine {
+
+	/// === バイナリレベル === ///
+	/// ファイルをメモリにマップし、各レコードの配列をコピーせずにそのまま参照する
+	/// Open / ToLevelDataはGPUに触れないのでワーカースレッドからも呼べる (ResolveModelsはメインスレッドのみ)
+	class BinaryLevel {
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// ファイルを開いて中身を検証する
+		/// </summary>
+		/// <param name="filePath">ファイルパス</param>
+		/// <returns>成功したか</returns>
+		bool Open(const std::string& filePath);
+
+		/// <summary>
+		/// ファイルを閉じる (解決済みのモデルのハンドルも手放す)
+		/// </summary>
+		void Close();
+
+		/// <summary>
+		/// モデルテーブルのIDをハンドルに解決する (レベルを閉じるまでモデルがキャッシュから追い出されなくなる)
+		/// </summary>
+		void ResolveModels();
+
+		/// <summary>
+		/// レベルデータへの変換
+		/// </summary>
+		/// <returns>レベルデータ</returns>
+		std::unique_ptr<LevelData> ToLevelData() const;
+
+		/// <summary>
+		/// 文字列テーブルから文字列を取り出す
+		/// </summary>
+		/// <param name="offset">位置</param>
+		/// <param name="length">長さ</param>
+		/// <returns>文字列 (範囲外なら空)</returns>
+		std::string_view GetString(uint32_t offset, uint32_t length) const;
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// モデルテーブルの取得
+		/// </summary>
+		/// <returns></returns>
+		std::span<const LevelFileFormat::Model> GetModels() const { return models_; }
+
+		/// <summary>
+		/// オブジェクトの配列の取得
+		/// </summary>
+		/// <returns></returns>
+		std::span<const LevelFileFormat::Object> GetObjects() const { return objects_; }
+
+		/// <summary>
+		/// 自キャラの生成データの配列の取得
+		/// </summary>
+		/// <returns></returns>
+		std::span<const LevelFileFormat::Spawn> GetPlayers() const { return players_; }
+
+		/// <summary>
+		/// 敵キャラの生成データの配列の取得
+		/// </summary>
+		/// <returns></returns>
+		std::span<const LevelFileFormat::Spawn> GetEnemies() const { return enemies_; }
+
+		/// <summary>
+		/// 解決済みのモデルのハンドルの取得
+		/// </summary>
+		/// <param name="modelIndex">モデルテーブルのインデックス</param>
+		/// <returns></returns>
+		const ModelHandle& GetModelHandle(uint32_t modelIndex) const { return modelHandles_[modelIndex]; }
+
+		/// <summary>
+		/// 開いているか
+		/// </summary>
+		/// <returns></returns>
+		bool IsOpen() const { return file_.IsOpen(); }
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// マップしたファイル
+		MappedFile file_;
+
+		// モデルテーブル
+		std::span<const LevelFileFormat::Model> models_;
+
+		// オブジェクト
+		std::span<const LevelFileFormat::Object> objects_;
+
+		// 自キャラの生成データ
+		std::span<const LevelFileFormat::Spawn> players_;
+
+		// 敵キャラの生成データ
+		std::span<const LevelFileFormat::Spawn> enemies_;
+
+		// 文字列テーブル
+		std::string_view stringTable_;
+
+		// 解決済みのモデルのハンドル (モデルテーブルと同じ並び)
+		std::vector<ModelHandle> modelHandles_;
+	};
+}
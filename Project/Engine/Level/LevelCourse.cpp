@@ -0,0 +1,207 @@
+#include "LevelCourse.h"
+#include "LevelParser.h"
+#include "Logger.h"
+
+#include "json.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+using namespace Engine;
+
+LevelCourse::~LevelCourse() {
+
+	// 解析中の区間を待ってから手放す
+	Close();
+}
+
+bool LevelCourse::Open(const std::string& fullPath) {
+
+	// 開き直すなら前のコースを閉じる
+	Close();
+
+	/// === 読み込み === ///
+
+	// ファイルを開く
+	std::ifstream file(fullPath);
+
+	// マニフェストがなければ何も配置しない
+	if (file.fail()) {
+		LOG_WARNING("LevelCourse::Open: {} not found\n", fullPath);
+		return false;
+	}
+
+	// JSON文字列から読み込んだデータ
+	nlohmann::json deserialized;
+	file >> deserialized;
+
+	// 正しいマニフェストの形式かチェック
+	assert(deserialized.is_object());
+	assert(deserialized.contains("name"));
+	assert(deserialized["name"].get<std::string>().compare("course") == 0);
+	assert(deserialized.contains("segmentLength"));
+	assert(deserialized.contains("segments"));
+
+	/// === 区間の一覧 === ///
+
+	// 区間のファイルはマニフェストからの相対パス
+	directory_ = std::filesystem::path(fullPath).parent_path().string();
+
+	// 区間の長さ
+	segmentLength_ = deserialized["segmentLength"].get<float>();
+	assert(segmentLength_ > 0.0f);
+
+	// 区間のファイル名
+	for (const nlohmann::json& segment : deserialized["segments"]) {
+		segmentFiles_.push_back(segment.get<std::string>());
+	}
+
+	LOG_DEBUG("LevelCourse::Open: {} ({} segments, length {})\n", fullPath, segmentFiles_.size(), segmentLength_);
+
+	return IsOpen();
+}
+
+void LevelCourse::Update(float viewerCourseZ) {
+
+	// コースがなければ何もしない
+	if (!IsOpen()) {
+		return;
+	}
+
+	/// ===== 解析結果の受け取り ===== ///
+
+	for (auto& [index, segment] : segments_) {
+
+		// 解析が終わっていれば待たずに受け取る
+		if (segment.future.valid() && segment.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+			segment.content = segment.future.get();
+			loadedCount_++;
+		}
+	}
+
+	/// ===== 範囲外の区間を手放す ===== ///
+
+	// 視点のいる区間
+	int32_t current = static_cast<int32_t>(std::floor(viewerCourseZ / segmentLength_));
+
+	// 残す範囲
+	firstIndex_ = current - keepBehind_;
+	lastIndex_ = current + loadAhead_;
+
+	// 範囲外の区間の中身を手放す (解析中のものは待たずに、終わってから手放す)
+	releasedCount_ += static_cast<uint32_t>(std::erase_if(segments_, [this](const auto& pair) {
+		bool isOutside = pair.first < firstIndex_ || lastIndex_ < pair.first;
+		return isOutside && !pair.second.future.valid();
+	}));
+
+	/// ===== 範囲内の区間の解析 ===== ///
+
+	for (int32_t index = firstIndex_; index <= lastIndex_; ++index) {
+
+		// まだ要求していなければ要求
+		if (!segments_.contains(index)) {
+			RequestSegment(index);
+		}
+	}
+}
+
+void LevelCourse::WaitLoading() {
+
+	for (auto& [index, segment] : segments_) {
+
+		// 解析中なら終わるまで待つ
+		if (segment.future.valid()) {
+			segment.future.wait();
+		}
+	}
+}
+
+void LevelCourse::Close() {
+
+	// 解析中の区間を待つ
+	WaitLoading();
+
+	// 全ての区間を手放す
+	segments_.clear();
+	segmentFiles_.clear();
+	firstIndex_ = 0;
+	lastIndex_ = -1;
+}
+
+const LevelCourse::SegmentContent* LevelCourse::FindContent(int32_t index) const {
+
+	// 要求していない区間
+	auto it = segments_.find(index);
+	if (it == segments_.end()) {
+		return nullptr;
+	}
+
+	// 範囲外の区間 (解析が終わったら手放す)
+	if (index < firstIndex_ || lastIndex_ < index) {
+		return nullptr;
+	}
+
+	// 解析中ならnullptr
+	return it->second.content.get();
+}
+
+float LevelCourse::GetLoopOffset(int32_t index) const {
+
+	// ループしないならずれはない
+	if (!isLoop_ || !IsOpen()) {
+		return 0.0f;
+	}
+
+	// ファイルの数
+	int32_t count = static_cast<int32_t>(segmentFiles_.size());
+
+	// 何周目か (負の区間番号も切り捨てる)
+	int32_t loop = static_cast<int32_t>(std::floor(static_cast<float>(index) / static_cast<float>(count)));
+
+	return static_cast<float>(loop * count) * segmentLength_;
+}
+
+size_t LevelCourse::GetLoadingCount() const {
+
+	return std::count_if(segments_.begin(), segments_.end(), [](const auto& pair) {
+		return pair.second.future.valid();
+	});
+}
+
+void LevelCourse::RequestSegment(int32_t index) {
+
+	// 区間を追加
+	Segment& segment = segments_[index];
+
+	// ファイルの数
+	int32_t count = static_cast<int32_t>(segmentFiles_.size());
+
+	// ループしないなら範囲外は空の区間にする
+	if (!isLoop_ && (index < 0 || count <= index)) {
+		segment.content = std::make_unique<SegmentContent>();
+		return;
+	}
+
+	// ループするなら周回させる
+	int32_t fileIndex = ((index % count) + count) % count;
+
+	// 解析をワーカースレッドで行う
+	std::string fullPath = directory_ + "/" + segmentFiles_[fileIndex];
+	segment.future = std::async(std::launch::async, LoadSegment, fullPath);
+}
+
+std::unique_ptr<LevelCourse::SegmentContent> LevelCourse::LoadSegment(const std::string& fullPath) {
+
+	// レベルデータの解析
+	std::unique_ptr<LevelData> levelData = LevelParser::ParseFile(fullPath);
+
+	// 区間の中身に移す (解析の途中のデータは残さない)
+	std::unique_ptr<SegmentContent> content = std::make_unique<SegmentContent>();
+	content->objects = std::move(levelData->GetObjects());
+	content->enemies = std::move(levelData->GetEnemies());
+	return content;
+}
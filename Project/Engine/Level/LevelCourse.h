@@ -0,0 +1,238 @@
+#pragma once
+
+#include "LevelData.h"
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine {
+
+	/// === レベルのコース === ///
+	/// コースをZ方向の区間に分けたレベルデータファイルの一覧(マニフェスト)を読み、視点の前後の区間のファイルだけを解析して持っておく
+	/// 範囲外に出た区間の中身は手放すので、コースをどれだけ進んでもメモリに残る区間の数は変わらない
+	/// ファイルの解析はワーカースレッドで行い、GPUには触れない (モデルやオブジェクトの生成はLevelStreamerが行う)
+	///
+	/// マニフェストの形式
+	///   { "name": "course", "segmentLength": 200.0, "segments": [ "Course/segment00.json", ... ] }
+	///   区間のファイルはマニフェストのディレクトリからの相対パスで、中身は通常のレベルデータ(座標はコース座標)
+	class LevelCourse {
+
+		///-------------------------------------------///
+		/// 構造体
+		///-------------------------------------------///
+	public:
+
+		// 区間の中身
+		struct SegmentContent {
+			std::vector<LevelData::ObjectData> objects;		// オブジェクト
+			std::vector<LevelData::EnemySpawnData> enemies;	// 敵の生成データ
+		};
+
+	private:
+
+		// 解析中、または解析済みの区間
+		struct Segment {
+			std::future<std::unique_ptr<SegmentContent>> future;	// 解析中の結果 (受け取ったら無効になる)
+			std::unique_ptr<SegmentContent> content;				// 解析済みの中身
+		};
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// デストラクタ (解析中の区間を待つ)
+		/// </summary>
+		~LevelCourse();
+
+		/// <summary>
+		/// マニフェストを読む
+		/// </summary>
+		/// <param name="fullPath">マニフェストのファイルパス</param>
+		/// <returns>読めたか</returns>
+		bool Open(const std::string& fullPath);
+
+		/// <summary>
+		/// 更新 (範囲外の区間の中身を手放し、範囲内の区間の解析を開始する)
+		/// </summary>
+		/// <param name="viewerCourseZ">視点のコース上のZ座標</param>
+		void Update(float viewerCourseZ);
+
+		/// <summary>
+		/// 解析中の区間が全て終わるまで待つ (次のUpdateで受け取る)
+		/// </summary>
+		void WaitLoading();
+
+		/// <summary>
+		/// 閉じる (解析中の区間を待ってから全ての区間を手放す)
+		/// </summary>
+		void Close();
+
+		/// <summary>
+		/// 解析済みの区間の中身の取得
+		/// </summary>
+		/// <param name="index">区間番号</param>
+		/// <returns>区間の中身 (範囲外や解析中ならnullptr)</returns>
+		const SegmentContent* FindContent(int32_t index) const;
+
+		/// <summary>
+		/// 区間番号に対応するコース上のずれの取得 (ループするときの周回分)
+		/// </summary>
+		/// <param name="index">区間番号</param>
+		/// <returns>コース上のずれ</returns>
+		float GetLoopOffset(int32_t index) const;
+
+		///-------------------------------------------///
+		/// クラス内関数
+		///-------------------------------------------///
+	private:
+
+		/// <summary>
+		/// 区間の解析を開始する
+		/// </summary>
+		/// <param name="index">区間番号</param>
+		void RequestSegment(int32_t index);
+
+		/// <summary>
+		/// 区間のファイルを解析する (ワーカースレッドで呼ばれる)
+		/// </summary>
+		/// <param name="fullPath">ファイルパス</param>
+		/// <returns>区間の中身</returns>
+		static std::unique_ptr<SegmentContent> LoadSegment(const std::string& fullPath);
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// マニフェストを読めているか
+		/// </summary>
+		/// <returns></returns>
+		bool IsOpen() const { return !segmentFiles_.empty(); }
+
+		/// <summary>
+		/// 区間の長さの取得
+		/// </summary>
+		/// <returns></returns>
+		float GetSegmentLength() const { return segmentLength_; }
+
+		/// <summary>
+		/// 区間のファイルの数の取得
+		/// </summary>
+		/// <returns></returns>
+		size_t GetSegmentFileCount() const { return segmentFiles_.size(); }
+
+		/// <summary>
+		/// 範囲内の先頭の区間番号の取得
+		/// </summary>
+		/// <returns></returns>
+		int32_t GetFirstIndex() const { return firstIndex_; }
+
+		/// <summary>
+		/// 範囲内の末尾の区間番号の取得
+		/// </summary>
+		/// <returns></returns>
+		int32_t GetLastIndex() const { return lastIndex_; }
+
+		/// <summary>
+		/// 解析中、または解析済みの区間の数の取得
+		/// </summary>
+		/// <returns></returns>
+		size_t GetSegmentCount() const { return segments_.size(); }
+
+		/// <summary>
+		/// 解析中の区間の数の取得
+		/// </summary>
+		/// <returns></returns>
+		size_t GetLoadingCount() const;
+
+		/// <summary>
+		/// 解析した区間の数の取得 (統計用)
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetLoadedCount() const { return loadedCount_; }
+
+		/// <summary>
+		/// 手放した区間の数の取得 (統計用)
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetReleasedCount() const { return releasedCount_; }
+
+		/// <summary>
+		/// 視点より先に読み込む区間の数の取得
+		/// </summary>
+		/// <returns></returns>
+		int32_t GetLoadAhead() const { return loadAhead_; }
+
+		/// <summary>
+		/// 視点より後ろに残す区間の数の取得
+		/// </summary>
+		/// <returns></returns>
+		int32_t GetKeepBehind() const { return keepBehind_; }
+
+		///-------------------------------------------///
+		/// セッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 視点より先に読み込む区間の数のセッター
+		/// </summary>
+		/// <param name="loadAhead">区間の数</param>
+		void SetLoadAhead(int32_t loadAhead) { loadAhead_ = loadAhead; }
+
+		/// <summary>
+		/// 視点より後ろに残す区間の数のセッター
+		/// </summary>
+		/// <param name="keepBehind">区間の数</param>
+		void SetKeepBehind(int32_t keepBehind) { keepBehind_ = keepBehind; }
+
+		/// <summary>
+		/// コースの終端まで来たら先頭から繰り返すかのセッター
+		/// </summary>
+		/// <param name="isLoop">繰り返すか</param>
+		void SetLoop(bool isLoop) { isLoop_ = isLoop; }
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// 区間のファイルのディレクトリ (マニフェストのあるディレクトリ)
+		std::string directory_;
+
+		// 区間のファイル名 (コースの先頭から順)
+		std::vector<std::string> segmentFiles_;
+
+		// 解析中、または解析済みの区間 区間番号 : 区間
+		std::unordered_map<int32_t, Segment> segments_;
+
+		// 区間の長さ
+		float segmentLength_ = 100.0f;
+
+		// 範囲内の区間番号
+		int32_t firstIndex_ = 0;
+		int32_t lastIndex_ = -1;
+
+		// 視点より先に読み込む区間の数
+		int32_t loadAhead_ = 4;
+
+		// 視点より後ろに残す区間の数
+		int32_t keepBehind_ = 1;
+
+		// 終端まで来たら先頭から繰り返すか
+		bool isLoop_ = true;
+
+		// 解析した区間の数 (統計用)
+		uint32_t loadedCount_ = 0;
+
+		// 手放した区間の数 (統計用)
+		uint32_t releasedCount_ = 0;
+	};
+}
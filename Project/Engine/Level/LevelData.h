@@ -1,10 +1,10 @@
 #pragma once
 
 #include "Vector3.h"
+#include "AssetID.h"
 
-#include "json.hpp"
-
-#include <list>
+#include <string>
+#include <vector>
 
 namespace Engine {
 
@@ -16,13 +16,22 @@ namespace Engine {
 		///-------------------------------------------///
 	public:
 
+		// コライダーデータ
+		struct ColliderData {
+			std::string type; // 形状の種類 (空ならコライダーなし)
+			Vector3 center; // 中心 (オブジェクトからの相対位置)
+			Vector3 size; // 大きさ
+		};
+
 		// オブジェクトデータ
 		struct ObjectData {
 			std::string fileName; // ファイル名
-			nlohmann::json objects; // オブジェクトのデータ
+			std::string directoryName; // モデルのディレクトリ名 (空なら読み込む側の既定)
+			AssetID modelID = kInvalidAssetID; // モデルのアセットID (バイナリレベルのみ)
 			Vector3 translation; // 位置
 			Vector3 rotation; // 回転
 			Vector3 scale; // スケール
+			ColliderData collider; // コライダー
 		};
 
 		// 自キャラの生成データ
@@ -48,19 +57,19 @@ namespace Engine {
 		/// オブジェクトデータのリストの取得
 		/// </summary>
 		/// <returns></returns>
-		std::list<ObjectData>& GetObjects() { return objects; }
+		std::vector<ObjectData>& GetObjects() { return objects; }
 
 		/// <summary>
 		/// 自キャラのリストの取得
 		/// </summary>
 		/// <returns></returns>
-		std::list<PlayerSpawnData>& GetPlayers() { return players; }
+		std::vector<PlayerSpawnData>& GetPlayers() { return players; }
 
 		/// <summary>
 		/// 敵キャラのリストの取得
 		/// </summary>
 		/// <returns></returns>
-		std::list<EnemySpawnData>& GetEnemies() { return enemies; }
+		std::vector<EnemySpawnData>& GetEnemies() { return enemies; }
 
 		///-------------------------------------------/// 
 		/// メンバ変数
@@ -68,12 +77,12 @@ namespace Engine {
 	private:
 
 		// オブジェクトデータのリスト
-		std::list<ObjectData> objects;
+		std::vector<ObjectData> objects;
 
 		// 自キャラのリスト
-		std::list<PlayerSpawnData> players;
+		std::vector<PlayerSpawnData> players;
 
 		// 敵キャラのリスト
-		std::list<EnemySpawnData> enemies;
+		std::vector<EnemySpawnData> enemies;
 	};
 }
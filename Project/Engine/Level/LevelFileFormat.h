@@ -0,0 +1,79 @@
+#pragma once
+
+#include "AssetID.h"
+#include "Vector3.h"
+
+#include <cstdint>
+
+namespace Engine {
+
+	/// === バイナリレベル(.level)のファイルフォーマット === ///
+	/// Blenderのエクスポーターが書き出す。座標系の変換と度数法からの変換は書き出し時に済ませてあるので、読み込み側はそのまま使える
+	/// [ヘッダー][モデルテーブル][オブジェクト][自キャラの生成データ][敵キャラの生成データ][文字列テーブル]
+	namespace LevelFileFormat {
+
+		// ファイル識別子 "LEVL"
+		static const uint32_t kMagic = 0x4C56454C;
+
+		// フォーマットのバージョン (構造を変えたら上げる)
+		static const uint32_t kVersion = 1;
+
+		// バイナリレベルの拡張子
+		static const char* const kExtension = ".level";
+
+		// コライダーの種類
+		enum class ColliderType : uint32_t {
+			None,	// なし
+			Box,	// 箱
+		};
+
+		// ヘッダー
+		struct Header {
+			uint32_t magic;				// ファイル識別子
+			uint32_t version;			// バージョン
+			uint32_t modelCount;		// モデル数
+			uint32_t objectCount;		// オブジェクト数
+			uint32_t playerCount;		// 自キャラの生成データ数
+			uint32_t enemyCount;		// 敵キャラの生成データ数
+			uint32_t stringTableSize;	// 文字列テーブルのサイズ(バイト)
+			uint32_t padding;
+			uint64_t modelOffset;		// モデルテーブルの位置
+			uint64_t objectOffset;		// オブジェクトの位置
+			uint64_t playerOffset;		// 自キャラの生成データの位置
+			uint64_t enemyOffset;		// 敵キャラの生成データの位置
+			uint64_t stringTableOffset; // 文字列テーブルの位置
+		};
+
+		// モデル (オブジェクトからはインデックスで参照する)
+		struct Model {
+			AssetID id;					// ModelManagerと同じ規則で求めたアセットID
+			uint32_t directoryOffset;	// 文字列テーブル内のディレクトリ名の位置
+			uint32_t directoryLength;	// ディレクトリ名の長さ
+			uint32_t nameOffset;		// 文字列テーブル内のモデル名(拡張子なし)の位置
+			uint32_t nameLength;		// モデル名の長さ
+		};
+
+		// オブジェクト
+		struct Object {
+			Vector3 translation;		// 位置
+			Vector3 rotation;			// 回転 (ラジアン)
+			Vector3 scale;				// スケール
+			uint32_t modelIndex;		// モデルテーブルのインデックス
+			ColliderType colliderType;	// コライダーの種類
+			Vector3 colliderCenter;		// コライダーの中心
+			Vector3 colliderSize;		// コライダーの大きさ
+		};
+
+		// 自キャラ、敵キャラの生成データ
+		struct Spawn {
+			Vector3 translation;		// 位置
+			Vector3 rotation;			// 回転 (ラジアン)
+		};
+
+		// エクスポーター(export_scene.py)とレイアウトを揃えているので変わったら気づけるようにする
+		static_assert(sizeof(Header) == 72, "Headerのサイズが変わったらkVersionを上げること");
+		static_assert(sizeof(Model) == 24, "Modelのサイズが変わったらkVersionを上げること");
+		static_assert(sizeof(Object) == 68, "Objectのサイズが変わったらkVersionを上げること");
+		static_assert(sizeof(Spawn) == 24, "Spawnのサイズが変わったらkVersionを上げること");
+	}
+}
@@ -0,0 +1,233 @@
+#include "LevelParser.h"
+#include "Logger.h"
+
+#include "json.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <numbers>
+
+using namespace Engine;
+
+namespace {
+
+	/// <summary>
+	/// オブジェクトの解析
+	/// </summary>
+	/// <param name="object">オブジェクトのJSON</param>
+	/// <param name="levelData">格納先のレベルデータ</param>
+	void ParseObject(nlohmann::json& object, LevelData& levelData) {
+
+		// オブジェクトが正しい形式かチェック
+		assert(object.contains("type"));
+
+		if(object.contains("disabled")){
+
+			// 有効無効フラグ
+			bool disabled = object["disabled"].get<bool>();
+
+			// 無効な場合は何もしない
+			if (disabled) {
+				
+				// 配置しない(スキップする)
+				return;
+			}
+		}
+
+		// 種別を取得
+		std::string type = object["type"].get<std::string>();
+
+		/// === メッシュの読み込み === ///
+
+		// MESH
+		if (type.compare("MESH") == 0) {
+
+			// 要素追加
+			levelData.GetObjects().emplace_back(LevelData::ObjectData{});
+			// 今追加した要素の参照を得る
+			LevelData::ObjectData& objectData = levelData.GetObjects().back();
+
+			if (object.contains("name")) {
+				// ファイル名を取得
+				objectData.fileName = object["name"];
+			}
+
+			if (object.contains("directory")) {
+				// モデルのディレクトリ名を取得 (無ければ読み込む側の既定)
+				objectData.directoryName = object["directory"];
+			}
+
+			// トランスフォームのパラメータ読み込み
+			nlohmann::json& transform = object["transform"];
+
+			// 平行移動
+			objectData.translation.x = transform["translation"][0];
+			objectData.translation.y = transform["translation"][2];
+			objectData.translation.z = transform["translation"][1];
+
+			// 回転角
+			objectData.rotation.x = transform["rotation"][0].get<float>() * (std::numbers::pi_v<float> / 180.0f);
+			objectData.rotation.y = transform["rotation"][2].get<float>() * (std::numbers::pi_v<float> / 180.0f);
+			objectData.rotation.z = transform["rotation"][1].get<float>() * (std::numbers::pi_v<float> / 180.0f);
+
+			// スケーリング
+			objectData.scale.x = transform["scaling"][0];
+			objectData.scale.y = transform["scaling"][2];
+			objectData.scale.z = transform["scaling"][1];
+
+			/// === コライダーの読み込み === ///
+
+			if (object.contains("collider")) {
+
+				// コライダーのパラメータ読み込み
+				nlohmann::json& collider = object["collider"];
+
+				// 種別
+				objectData.collider.type = collider["type"].get<std::string>();
+
+				// 中心
+				objectData.collider.center.x = collider["center"][0];
+				objectData.collider.center.y = collider["center"][2];
+				objectData.collider.center.z = collider["center"][1];
+
+				// 大きさ
+				objectData.collider.size.x = collider["size"][0];
+				objectData.collider.size.y = collider["size"][2];
+				objectData.collider.size.z = collider["size"][1];
+			}
+		}
+		else if (type.compare("PlayerSpawn") == 0) {
+
+			// 要素追加
+			levelData.GetPlayers().emplace_back(LevelData::PlayerSpawnData{});
+			// 今追加した要素の参照を得る
+			LevelData::PlayerSpawnData& playerData = levelData.GetPlayers().back();
+
+			// トランスフォームのパラメータ読み込み
+			nlohmann::json& transform = object["transform"];
+
+			// 平行移動
+			playerData.translation.x = transform["translation"][0];
+			playerData.translation.y = transform["translation"][2];
+			playerData.translation.z = transform["translation"][1];
+
+			// 回転角
+			playerData.rotation.x = transform["rotation"][0].get<float>() * (std::numbers::pi_v<float> / 180.0f);
+			playerData.rotation.y = transform["rotation"][2].get<float>() * (std::numbers::pi_v<float> / 180.0f);
+			playerData.rotation.z = transform["rotation"][1].get<float>() * (std::numbers::pi_v<float> / 180.0f);
+		}
+		else if (type.compare("EnemySpawn") == 0) {
+
+			// 要素追加
+			levelData.GetEnemies().emplace_back(LevelData::EnemySpawnData{});
+			// 今追加した要素の参照を得る
+			LevelData::EnemySpawnData& enemyData = levelData.GetEnemies().back();
+
+			// トランスフォームのパラメータ読み込み
+			nlohmann::json& transform = object["transform"];
+
+			// 平行移動
+			enemyData.translation.x = transform["translation"][0];
+			enemyData.translation.y = transform["translation"][2];
+			enemyData.translation.z = transform["translation"][1];
+
+			// 回転角
+			enemyData.rotation.x = transform["rotation"][0].get<float>() * (std::numbers::pi_v<float> / 180.0f);
+			enemyData.rotation.y = transform["rotation"][2].get<float>() * (std::numbers::pi_v<float> / 180.0f);
+			enemyData.rotation.z = transform["rotation"][1].get<float>() * (std::numbers::pi_v<float> / 180.0f);
+		}
+
+		/// === ツリー構造の走査 === ///
+
+		// 子ノードがある場合
+		if (object.contains("children")) {
+
+			// 再帰的に呼び出して解析する
+			for (nlohmann::json& child : object["children"]) {
+				// 子ノードの解析
+				ParseObject(child, levelData);
+			}
+		}
+	}
+}
+
+std::unique_ptr<LevelData> LevelParser::ParseFile(const std::string& fullPath, BinaryLevel* binaryLevel) {
+
+	// 計測開始
+	auto start = std::chrono::steady_clock::now();
+
+	// 同じ名前のバイナリレベルのパス
+	std::string binaryPath = std::filesystem::path(fullPath).replace_extension(LevelFileFormat::kExtension).string();
+
+	// 格納先が指定されていなければこの関数内だけで開く
+	BinaryLevel localBinaryLevel;
+	BinaryLevel& binary = binaryLevel ? *binaryLevel : localBinaryLevel;
+
+	std::unique_ptr<LevelData> result = nullptr;
+
+	// バイナリが開ければそちらを使い、なければJSONを解析する
+	if (std::filesystem::exists(binaryPath) && binary.Open(binaryPath)) {
+		result = binary.ToLevelData();
+	}
+	else {
+		result = ParseJsonFile(fullPath);
+	}
+
+	// 計測終了
+	double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	LOG_DEBUG("LevelParser::ParseFile: {} ({} objects, {:.3f} ms)\n", binary.IsOpen() ? binaryPath : fullPath, result->GetObjects().size(), milliseconds);
+
+	return result;
+}
+
+std::unique_ptr<LevelData> LevelParser::ParseJsonFile(const std::string& fullPath) {
+
+	/// === 読み込み === ///
+
+	// ファイルストリーム
+	std::ifstream file;
+
+	// ファイルを開く
+	file.open(fullPath);
+
+	// ファイルが開けなかった場合
+	if (file.fail()) {
+
+		// 実行を止める
+		assert(0);
+	}
+
+	/// === ファイルチェック === ///
+
+	// JSON文字列から読み込んだデータ
+	nlohmann::json deserialized;
+
+	// ファイル読み込み
+	file >> deserialized;
+
+	// 正しいレベルデータファイルの形式かチェック
+	assert(deserialized.is_object());
+	assert(deserialized.contains("name"));
+	assert(deserialized["name"].is_string());
+
+	// "name"を文字列として取得
+	std::string name = deserialized["name"].get<std::string>();
+	// 正しいレベルデータファイルの形式かチェック
+	assert(name.compare("scene") == 0);
+
+	/// === オブジェクトの走査 === ///
+
+	// レベルデータ格納用インスタンスを生成
+	std::unique_ptr<LevelData> levelData = std::make_unique<LevelData>();
+
+	// "objects"の全オブジェクトを走査
+	for (nlohmann::json& object : deserialized["objects"]) {
+
+		// オブジェクトの解析
+		ParseObject(object, *levelData);
+	}
+
+	return levelData;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "LevelData.h"
+#include "BinaryLevel.h"
+
+#include <memory>
+#include <string>
+
+namespace Engine {
+
+	/// === レベルデータの解析 === ///
+	/// ファイルを読んでLevelDataにするだけで、モデルやオブジェクトは作らない
+	/// GPUに触れないのでワーカースレッドからも呼べる (配置はLoader / LevelStreamerが行う)
+	namespace LevelParser {
+
+		/// <summary>
+		/// レベルデータファイルの解析
+		/// 同じ名前のバイナリレベル(.level)があればそちらを読み込む
+		/// </summary>
+		/// <param name="fullPath">ファイルパス</param>
+		/// <param name="binaryLevel">バイナリレベルを開いたまま受け取る場合の格納先</param>
+		/// <returns>レベルデータ</returns>
+		std::unique_ptr<LevelData> ParseFile(const std::string& fullPath, BinaryLevel* binaryLevel = nullptr);
+
+		/// <summary>
+		/// JSON形式のレベルデータファイルの解析
+		/// </summary>
+		/// <param name="fullPath">ファイルパス</param>
+		/// <returns>レベルデータ</returns>
+		std::unique_ptr<LevelData> ParseJsonFile(const std::string& fullPath);
+	};
+}
@@ -0,0 +1,246 @@
+#include "LevelStreamer.h"
+#include "AssetLoader.h"
+#include "CollisionManager.h"
+#include "WorldOrigin.h"
+#include "MathVector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <imgui.h>
+
+using namespace Engine;
+using namespace MathVector;
+
+void LevelStreamer::Initialize(const std::string& fileName) {
+
+	// コースのマニフェストを読む (なければ何も配置しない)
+	course_.Open(kDefaultDirectory + "/" + fileName);
+}
+
+void LevelStreamer::Update(float viewerCourseZ) {
+
+	/// ===== 区間のファイルの解析 ===== ///
+
+	// 範囲外の区間の中身を手放し、範囲内の区間の解析を開始する
+	course_.Update(viewerCourseZ);
+
+	/// ===== 範囲外の区間の破棄 ===== ///
+
+	// 中身を手放した区間を破棄 (モデルのハンドルも手放すのでキャッシュから追い出せるようになる)
+	releasedCount_ += static_cast<uint32_t>(std::erase_if(segments_, [this](const auto& pair) {
+		return course_.FindContent(pair.first) == nullptr;
+	}));
+
+	/// ===== 範囲内の区間の読み込み ===== ///
+
+	for (int32_t index = course_.GetFirstIndex(); index <= course_.GetLastIndex(); ++index) {
+
+		// 解析が終わっていてまだ要求していなければ要求
+		if (!segments_.contains(index) && course_.FindContent(index)) {
+			RequestSegment(index);
+		}
+	}
+
+	/// ===== 区間の更新 ===== ///
+
+	for (auto& [index, segment] : segments_) {
+
+		// 読み込み中なら
+		if (segment.state == SegmentState::Loading) {
+
+			// モデルが全て揃っているか
+			bool isAllReady = std::all_of(segment.modelRequests.begin(), segment.modelRequests.end(), [](const std::shared_future<void>& request) {
+				return request.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+			});
+
+			// 揃っていなければ次の区間へ
+			if (!isAllReady) {
+				continue;
+			}
+
+			// オブジェクトとコライダーの生成
+			BuildSegment(index, segment, *course_.FindContent(index));
+		}
+
+		// オブジェクトの更新
+		for (std::unique_ptr<Object3d>& object : segment.objects) {
+			object->Update();
+		}
+
+		// コライダーの更新
+		for (std::unique_ptr<Collider>& collider : segment.colliders) {
+			collider->Update();
+		}
+	}
+}
+
+void LevelStreamer::Draw() {
+
+	for (auto& [index, segment] : segments_) {
+
+		// オブジェクトの描画
+		for (std::unique_ptr<Object3d>& object : segment.objects) {
+			object->Draw();
+		}
+	}
+}
+
+void LevelStreamer::Submit(RenderQueue& renderQueue, RenderQueue::Pass pass, uint32_t pipeline) {
+
+	for (auto& [index, segment] : segments_) {
+
+		// オブジェクトごとにパケットを積む
+		for (std::unique_ptr<Object3d>& object : segment.objects) {
+			object->Submit(renderQueue, pass, pipeline);
+		}
+	}
+}
+
+void LevelStreamer::Finalize() {
+
+	// 全ての区間を破棄
+	segments_.clear();
+
+	// コースを閉じる (解析中の区間は終わるまで待つ)
+	course_.Close();
+}
+
+void LevelStreamer::ShowImGui() {
+
+#ifdef USE_IMGUI
+
+	ImGui::Begin("LevelStreamer");
+
+	// 状態ごとの区間の数を数える
+	size_t residentCount = std::count_if(segments_.begin(), segments_.end(), [](const auto& pair) {
+		return pair.second.state == SegmentState::Resident;
+	});
+
+	ImGui::Text("Ready: %s", IsReady() ? "true" : "false");
+	ImGui::Text("Segments: %zu (Resident %zu / Loading %zu)", segments_.size(), residentCount, segments_.size() - residentCount);
+	ImGui::Text("Built: %u  Released: %u", builtCount_, releasedCount_);
+	ImGui::Text("Course: %zu files (Parsing %zu)  Loaded: %u  Released: %u", course_.GetSegmentFileCount(), course_.GetLoadingCount(), course_.GetLoadedCount(), course_.GetReleasedCount());
+	ImGui::Text("Origin Offset Z: %.1f", WorldOrigin::GetOffset().z);
+
+	// 読み込む範囲
+	int32_t loadAhead = course_.GetLoadAhead();
+	int32_t keepBehind = course_.GetKeepBehind();
+	if (ImGui::DragInt("LoadAhead", &loadAhead, 1.0f, 0, 16)) {
+		course_.SetLoadAhead(loadAhead);
+	}
+	if (ImGui::DragInt("KeepBehind", &keepBehind, 1.0f, 0, 16)) {
+		course_.SetKeepBehind(keepBehind);
+	}
+
+	ImGui::End();
+
+#endif // USE_IMGUI
+}
+
+void LevelStreamer::Reset() {
+
+	// 全ての区間を破棄
+	releasedCount_ += static_cast<uint32_t>(segments_.size());
+	segments_.clear();
+}
+
+void LevelStreamer::CollectColliders(CollisionManager* collisionManager) {
+
+	for (auto& [index, segment] : segments_) {
+
+		// コライダーを登録
+		for (std::unique_ptr<Collider>& collider : segment.colliders) {
+			collisionManager->AddCollider(collider.get());
+		}
+	}
+}
+
+void LevelStreamer::RequestSegment(int32_t index) {
+
+	// 区間を追加
+	Segment& segment = segments_[index];
+
+	// 区間で使うモデルの読み込みを要求 (デコードはワーカースレッドで行われる)
+	for (const LevelData::ObjectData& objectData : course_.FindContent(index)->objects) {
+		segment.modelRequests.push_back(AssetLoader::GetInstance()->RequestModel(GetModelDirectory(objectData), objectData.fileName + ".obj"));
+	}
+}
+
+void LevelStreamer::BuildSegment(int32_t index, Segment& segment, const LevelCourse::SegmentContent& content) {
+
+	// 周回分のずれ
+	Vector3 loopOffset = { 0.0f, 0.0f, course_.GetLoopOffset(index) };
+
+	/// ===== オブジェクトの生成 ===== ///
+
+	for (const LevelData::ObjectData& objectData : content.objects) {
+
+		// 区間内で同じモデルは使い回す
+		std::unique_ptr<Model>& model = segment.models[objectData.fileName];
+		if (!model) {
+			model = std::make_unique<Model>();
+			model->Initialize(GetModelDirectory(objectData), objectData.fileName + ".obj");
+		}
+
+		// コース座標からローカル座標に変換
+		Vector3 translation = WorldOrigin::ToLocal(objectData.translation + loopOffset);
+
+		// 3Dオブジェクトの生成
+		std::unique_ptr<Object3d> object = std::make_unique<Object3d>();
+		object->Initialize();
+		object->SetModel(model.get());
+		object->SetOriginRelative(true);
+		object->SetScale(objectData.scale);
+		object->SetRotate(objectData.rotation);
+		object->SetTranslate(translation);
+		segment.objects.push_back(std::move(object));
+
+		// コライダーがなければ次へ (今はBOXのみ対応)
+		if (objectData.collider.type.compare("BOX") != 0) {
+			continue;
+		}
+
+		// オブジェクトの拡縮を反映した中心と大きさ
+		const Vector3& scale = objectData.scale;
+		Vector3 center = { objectData.collider.center.x * scale.x, objectData.collider.center.y * scale.y, objectData.collider.center.z * scale.z };
+		Vector3 size = { objectData.collider.size.x * scale.x, objectData.collider.size.y * scale.y, objectData.collider.size.z * scale.z };
+
+		// コライダーのワールド変換 (AABBは座標±拡縮で作られるので拡縮には大きさの半分を入れる)
+		WorldTransform colliderTransform;
+		colliderTransform.Initialize();
+		colliderTransform.SetOriginRelative(true);
+		colliderTransform.SetScale(size * 0.5f);
+		colliderTransform.SetTranslate(translation + center);
+
+		// コライダーの生成
+		std::unique_ptr<Collider> collider = std::make_unique<Collider>(AABB{}, colliderTypeID_);
+		collider->Initialize();
+		collider->SetWorldTransform(colliderTransform);
+		segment.colliders.push_back(std::move(collider));
+	}
+
+	/// ===== 敵の生成 ===== ///
+
+	if (spawnCallback_) {
+
+		for (LevelData::EnemySpawnData enemyData : content.enemies) {
+
+			// コース座標からローカル座標に変換して渡す
+			enemyData.translation = WorldOrigin::ToLocal(enemyData.translation + loopOffset);
+			spawnCallback_(enemyData);
+		}
+	}
+
+	// 読み込み要求はもう不要
+	segment.modelRequests.clear();
+
+	// 生成済みにする
+	segment.state = SegmentState::Resident;
+	builtCount_++;
+}
+
+const std::string& LevelStreamer::GetModelDirectory(const LevelData::ObjectData& objectData) const {
+
+	// バイナリレベルや、ディレクトリを指定したオブジェクトならそのディレクトリ名を使う
+	return objectData.directoryName.empty() ? modelDirectory_ : objectData.directoryName;
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+#include "LevelCourse.h"
+#include "Model/Model.h"
+#include "Object/Object3d.h"
+#include "Collider.h"
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine {
+
+	/// ===== 前方宣言 ===== ///
+	class CollisionManager;
+
+	/// === レベルストリーマー === ///
+	/// 区間ごとのレベルデータファイルに分けたコースを読み、視点の前後の区間だけを生成して範囲外の区間は破棄する
+	/// 区間のファイルの解析(LevelCourse)とモデルのデコードはワーカースレッドで行い、GPUリソースの生成だけをメインスレッドで行う
+	/// 座標はコース座標(ワールド原点のずれを含む)で扱い、生成したオブジェクトはワールド原点の移動に追従させる
+	class LevelStreamer {
+
+		///-------------------------------------------///
+		/// 構造体
+		///-------------------------------------------///
+	public:
+
+		// 区間の状態
+		enum class SegmentState {
+			Loading,	// モデルの読み込み待ち
+			Resident,	// 生成済み
+		};
+
+		// 読み込み中、または生成済みの区間
+		struct Segment {
+			SegmentState state = SegmentState::Loading;					// 状態
+			std::vector<std::shared_future<void>> modelRequests;			// モデルの読み込み要求
+			std::unordered_map<std::string, std::unique_ptr<Model>> models;	// ファイル名 : モデル
+			std::vector<std::unique_ptr<Object3d>> objects;					// 3Dオブジェクト
+			std::vector<std::unique_ptr<Collider>> colliders;				// コライダー
+		};
+
+		///-------------------------------------------///
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 初期化 (コースのマニフェストを読む。区間のファイルは更新で視点の周りから解析する)
+		/// </summary>
+		/// <param name="fileName">コースのマニフェストのファイル名</param>
+		void Initialize(const std::string& fileName);
+
+		/// <summary>
+		/// 更新
+		/// </summary>
+		/// <param name="viewerCourseZ">視点のコース上のZ座標</param>
+		void Update(float viewerCourseZ);
+
+		/// <summary>
+		/// 描画
+		/// </summary>
+		void Draw();
+
+		/// <summary>
+		/// レンダーキューに描画パケットを積む (読み込まれている区間のオブジェクトごと)
+		/// </summary>
+		/// <param name="renderQueue">レンダーキュー</param>
+		/// <param name="pass">描画パス</param>
+		/// <param name="pipeline">パイプラインの番号</param>
+		void Submit(RenderQueue& renderQueue, RenderQueue::Pass pass, uint32_t pipeline);
+
+		/// <summary>
+		/// 終了
+		/// </summary>
+		void Finalize();
+
+		/// <summary>
+		/// ImGui表示
+		/// </summary>
+		void ShowImGui();
+
+		/// <summary>
+		/// 全ての区間を破棄する (次の更新で視点の周りから作り直す)
+		/// </summary>
+		void Reset();
+
+		/// <summary>
+		/// 生成済みの区間のコライダーを衝突マネージャに登録
+		/// </summary>
+		/// <param name="collisionManager">衝突マネージャ</param>
+		void CollectColliders(CollisionManager* collisionManager);
+
+		///-------------------------------------------///
+		/// クラス内関数
+		///-------------------------------------------///
+	private:
+
+		/// <summary>
+		/// 区間の読み込み要求
+		/// </summary>
+		/// <param name="index">区間番号</param>
+		void RequestSegment(int32_t index);
+
+		/// <summary>
+		/// 区間のオブジェクトとコライダーの生成
+		/// </summary>
+		/// <param name="index">区間番号</param>
+		/// <param name="segment">区間</param>
+		/// <param name="content">区間の中身</param>
+		void BuildSegment(int32_t index, Segment& segment, const LevelCourse::SegmentContent& content);
+
+		/// <summary>
+		/// オブジェクトのモデルのディレクトリ名の取得
+		/// </summary>
+		/// <param name="objectData">オブジェクトデータ</param>
+		/// <returns>ディレクトリ名</returns>
+		const std::string& GetModelDirectory(const LevelData::ObjectData& objectData) const;
+
+		///-------------------------------------------///
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// コースのマニフェストを読めているか
+		/// </summary>
+		/// <returns></returns>
+		bool IsReady() const { return course_.IsOpen(); }
+
+		/// <summary>
+		/// 読み込み中、または生成済みの区間の数の取得
+		/// </summary>
+		/// <returns></returns>
+		size_t GetSegmentCount() const { return segments_.size(); }
+
+		/// <summary>
+		/// コースの取得
+		/// </summary>
+		/// <returns></returns>
+		const LevelCourse& GetCourse() const { return course_; }
+
+		///-------------------------------------------///
+		/// セッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 視点より先に読み込む区間の数のセッター
+		/// </summary>
+		/// <param name="loadAhead">区間の数</param>
+		void SetLoadAhead(int32_t loadAhead) { course_.SetLoadAhead(loadAhead); }
+
+		/// <summary>
+		/// 視点より後ろに残す区間の数のセッター
+		/// </summary>
+		/// <param name="keepBehind">区間の数</param>
+		void SetKeepBehind(int32_t keepBehind) { course_.SetKeepBehind(keepBehind); }
+
+		/// <summary>
+		/// コースの終端まで来たら先頭から繰り返すかのセッター
+		/// </summary>
+		/// <param name="isLoop">繰り返すか</param>
+		void SetLoop(bool isLoop) { course_.SetLoop(isLoop); }
+
+		/// <summary>
+		/// モデルのディレクトリ名のセッター
+		/// </summary>
+		/// <param name="modelDirectory">ディレクトリ名</param>
+		void SetModelDirectory(const std::string& modelDirectory) { modelDirectory_ = modelDirectory; }
+
+		/// <summary>
+		/// コライダーの種別IDのセッター
+		/// </summary>
+		/// <param name="colliderTypeID">種別ID</param>
+		void SetColliderTypeID(uint32_t colliderTypeID) { colliderTypeID_ = colliderTypeID; }
+
+		/// <summary>
+		/// 敵の生成コールバックのセッター (座標はローカル座標に変換して渡す)
+		/// </summary>
+		/// <param name="spawnCallback">コールバック関数</param>
+		void SetSpawnCallback(const std::function<void(const LevelData::EnemySpawnData&)>& spawnCallback) { spawnCallback_ = spawnCallback; }
+
+		///-------------------------------------------///
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// デフォルトのディレクトリ
+		const std::string kDefaultDirectory = "Resources/Levels";
+
+		// コース (区間のファイルの解析と中身の保持)
+		LevelCourse course_;
+
+		// 読み込み中、または生成済みの区間 区間番号 : 区間
+		std::unordered_map<int32_t, Segment> segments_;
+
+		// モデルのディレクトリ名
+		std::string modelDirectory_ = "Levels";
+
+		// コライダーの種別ID
+		uint32_t colliderTypeID_ = 0;
+
+		// 敵の生成コールバック
+		std::function<void(const LevelData::EnemySpawnData&)> spawnCallback_ = nullptr;
+
+		// 生成した区間の数 (統計用)
+		uint32_t builtCount_ = 0;
+
+		// 破棄した区間の数 (統計用)
+		uint32_t releasedCount_ = 0;
+	};
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "LevelData.h"
+#include "BinaryLevel.h"
 #include "Object/Object3d.h"
 
 #include <string>
@@ -53,16 +54,6 @@ namespace Engine {
 		/// </summary>
 		void ShowImGui();
 
-		///-------------------------------------------/// 
-		/// クラス内関数
-		///-------------------------------------------///
-	private:
-
-		/// <summary>
-		/// オブジェクトの解析
-		/// </summary>
-		void ParseObject(nlohmann::json& object);
-
 		///-------------------------------------------/// 
 		/// メンバ変数
 		///-------------------------------------------///
@@ -74,8 +65,8 @@ namespace Engine {
 		// レベルデータ格納用インスタンス
 		std::unique_ptr<LevelData> levelData = nullptr;
 
-		// JSON文字列から読み込んだデータ
-		nlohmann::json deserialized;
+		// バイナリレベル (読み込んだ場合のみ開いたままにしてモデルのハンドルを保持する)
+		BinaryLevel binaryLevel;
 
 		// モデルのリスト
 		std::map<std::string, std::unique_ptr<Model>> models;
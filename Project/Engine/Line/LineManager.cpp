@@ -2,6 +2,7 @@
 #include "DirectXUtility.h"
 #include "Camera.h"
 #include "MathMatrix.h"
+#include "FrameCounters.h"
 
 #include <cassert>
 #include <numbers>
@@ -177,6 +178,9 @@ void LineManager::Render() {
 
 	// 描画
 	commandList->DrawInstanced(static_cast<UINT>(vertexDatas_.size()), 1, 0, 0);
+
+	// 描画の統計を数える
+	FrameCounters::GetInstance()->CountDraw(1, 1);
 }
 
 void LineManager::Finalize() {
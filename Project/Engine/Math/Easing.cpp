@@ -27,6 +27,19 @@ Vector4 Easing::Lerp(const Vector4& start, const Vector4& end, float t) {
 	return start + (end - start) * t;
 }
 
+float Easing::LerpAngle(float start, float end, float t) {
+
+	// 差を -π ~ π に収めてから補間する
+	float difference = std::remainder(end - start, 2.0f * std::numbers::pi_v<float>);
+
+	return start + difference * t;
+}
+
+Vector3 Easing::LerpAngle(const Vector3& start, const Vector3& end, float t) {
+
+	return { LerpAngle(start.x, end.x, t), LerpAngle(start.y, end.y, t), LerpAngle(start.z, end.z, t) };
+}
+
 float Engine::Easing::EaseInSine(float t) {
 	
 	return 1.0f - std::cosf((t * std::numbers::pi_v<float>) / 2.0f);
@@ -22,6 +22,12 @@ namespace Engine {
 
 		Vector4 Lerp(const Vector4& start, const Vector4& end, float t);
 
+		/// ===== 角度の線形補間 (近い方の向きに回る) ===== ///
+
+		float LerpAngle(float start, float end, float t);
+
+		Vector3 LerpAngle(const Vector3& start, const Vector3& end, float t);
+
 		/// ===== In ゆっくり始まって速く終わる ===== ///
 
 		float EaseInSine(float t);
@@ -1,6 +1,10 @@
 #include "SceneManager.h"
 #include "TransitionManager.h"
 #include "BaseTransition.h"
+#include "AssetLoader.h"
+#include "Texture/TextureManager.h"
+#include "Model/ModelManager.h"
+#include "Profiler.h"
 
 #include <cassert>
 #include <imgui.h>
@@ -19,9 +23,14 @@ SceneManager* SceneManager::GetInstance() {
 
 void SceneManager::Update() {
 
+	PROFILE_SCOPE("SceneManager::Update");
+
 	// 次のシーン予約が入っていたら
 	if (nextScene_) {
 
+		// 先読みが終わっていなければ待つ (遷移の演出中にほとんど終わっている)
+		AssetLoader::GetInstance()->WaitAll();
+
 		// 現在のシーンを終了
 		if (scene_) {
 			scene_->Finalize();
@@ -34,6 +43,11 @@ void SceneManager::Update() {
 
 		// 次のシーンを初期化
 		scene_->Initialize();
+
+		// 使われなくなったアセットを予算に収まるまで追い出す
+		// (新しいシーンがハンドルを取った後に行う。先に行うと先読みしたアセットまで追い出してしまう)
+		TextureManager::GetInstance()->Trim();
+		ModelManager::GetInstance()->Trim();
 	}
 
 	// 実行中のシーンを更新
@@ -59,6 +73,10 @@ void SceneManager::Finalize() {
 	scene_->Finalize();
 	delete scene_;
 
+	// 切り替え前のシーンが残っていたら解放
+	delete nextScene_;
+	delete pendingScene_;
+
 	delete instance;
 	instance = nullptr;
 }
@@ -75,19 +93,27 @@ void SceneManager::ChangeScene(const std::string& sceneName, std::unique_ptr<Bas
 	assert(sceneFactory_);
 	assert(nextScene_ == nullptr);
 
+	// 遷移中に切り替え先が変わったら先読み中のシーンは捨てる (遷移の完了処理は上書きされる)
+	delete pendingScene_;
+
+	// 次のシーンを生成して、使うアセットの先読みを始める
+	pendingScene_ = sceneFactory_->CreateScene(sceneName);
+	pendingScene_->RequestAssets();
+
 	// 遷移の指定がなければ
 	if (!transition) {
 
-		// 次のシーンを生成してすぐ切り替える
-		nextScene_ = sceneFactory_->CreateScene(sceneName);
+		// すぐ切り替える
+		nextScene_ = pendingScene_;
+		pendingScene_ = nullptr;
 	}
 	// 遷移の指定があれば
 	else {
 
 		TransitionManager::GetInstance()->StartInTransition(
-			std::move(transition),										   // 遷移の仕方
-			[&]() { nextScene_ = sceneFactory_->CreateScene(sceneName); }, // 遷移完了時の処理
-			duration													   // 遷移にかける時間
+			std::move(transition),											  // 遷移の仕方
+			[this]() { nextScene_ = pendingScene_; pendingScene_ = nullptr; }, // 遷移完了時の処理
+			duration														  // 遷移にかける時間
 		);
 	}
 }
\ No newline at end of file
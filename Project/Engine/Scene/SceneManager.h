@@ -93,6 +93,9 @@ namespace Engine {
 		// 次のシーン
 		BaseScene* nextScene_ = nullptr;
 
+		// 遷移完了待ちのシーン (アセットを先読み中)
+		BaseScene* pendingScene_ = nullptr;
+
 		// シーンファクトリー
 		AbstractSceneFactory* sceneFactory_ = nullptr;
 	};
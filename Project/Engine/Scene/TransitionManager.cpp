@@ -5,13 +5,13 @@
 
 using namespace Engine;
 
-void TransitionManager::Update() {
+void TransitionManager::Update(float deltaTime) {
 
 	// 遷移がない場合は何もしない
 	if (!outTransition_ && !inTransition_) return;
 
 	// 進行度を計算
-	float addProgress = deltaTime_ / duration_;
+	float addProgress = deltaTime / duration_;
 
 	// 入りの遷移がある場合
 	if (outTransition_) {
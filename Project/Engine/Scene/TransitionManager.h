@@ -39,7 +39,8 @@ namespace Engine {
 		/// <summary>
 		/// 更新
 		/// </summary>
-		void Update();
+		/// <param name="deltaTime">経過時間(秒)</param>
+		void Update(float deltaTime);
 
 		/// <summary>
 		/// 描画
@@ -109,9 +110,6 @@ namespace Engine {
 
 		// 遷移の総時間 (秒)
 		float duration_ = 0.0f;
-
-		// Δt 約0.016秒
-		const float deltaTime_ = 1.0f / 60.0f;
 	};
 }
 
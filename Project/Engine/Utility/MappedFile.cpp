@@ -0,0 +1,136 @@
+#include "MappedFile.h"
+
+#include <utility>
+#ifdef _WIN32
+#include "StringUtility.h"
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // _WIN32
+
+using namespace Engine;
+
+MappedFile::~MappedFile() {
+
+	// 開いていたら閉じる
+	Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+
+	// 中身を入れ替える
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+
+	if (this != &other) {
+
+		// 自分が持っているものは閉じる
+		Close();
+
+		// 所有権を移す
+		fileHandle_ = std::exchange(other.fileHandle_, nullptr);
+		mappingHandle_ = std::exchange(other.mappingHandle_, nullptr);
+		data_ = std::exchange(other.data_, nullptr);
+		size_ = std::exchange(other.size_, 0);
+	}
+	return *this;
+}
+
+bool MappedFile::Open(const std::string& filePath) {
+
+	// 開き直す場合は先に閉じる
+	Close();
+
+#ifdef _WIN32
+
+	// 読み取り専用で開く (先読みが効くようにシーケンシャル指定)
+	HANDLE file = CreateFileW(StringUtility::ConvertString(filePath).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	// ファイルサイズを取得
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+
+	// マッピングオブジェクトを作成
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+		CloseHandle(file);
+		return false;
+	}
+
+	// ファイル全体をマップ
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == nullptr) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	fileHandle_ = file;
+	mappingHandle_ = mapping;
+	data_ = static_cast<const uint8_t*>(view);
+	size_ = static_cast<uint64_t>(fileSize.QuadPart);
+
+#else
+
+	// 読み取り専用で開く (テストをLinuxで動かすため)
+	int file = open(filePath.c_str(), O_RDONLY);
+	if (file < 0) return false;
+
+	// ファイルサイズを取得
+	struct stat fileStat {};
+	if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0) {
+		close(file);
+		return false;
+	}
+
+	// ファイル全体をマップ (マップはファイルを閉じても残る)
+	void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (view == MAP_FAILED) return false;
+
+	data_ = static_cast<const uint8_t*>(view);
+	size_ = static_cast<uint64_t>(fileStat.st_size);
+
+#endif // _WIN32
+
+	return true;
+}
+
+void MappedFile::Close() {
+
+	// マップを解除
+	if (data_) {
+#ifdef _WIN32
+		UnmapViewOfFile(data_);
+#else
+		munmap(const_cast<uint8_t*>(data_), static_cast<size_t>(size_));
+#endif // _WIN32
+		data_ = nullptr;
+	}
+
+#ifdef _WIN32
+
+	// マッピングオブジェクトを閉じる
+	if (mappingHandle_) {
+		CloseHandle(mappingHandle_);
+		mappingHandle_ = nullptr;
+	}
+
+	// ファイルを閉じる
+	if (fileHandle_) {
+		CloseHandle(fileHandle_);
+		fileHandle_ = nullptr;
+	}
+#endif // _WIN32
+
+	size_ = 0;
+}
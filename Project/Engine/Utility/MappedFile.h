@@ -0,0 +1,99 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+namespace Engine {
+
+	/// === メモリマップドファイル(読み取り専用) === ///
+	class MappedFile {
+
+		///-------------------------------------------/// 
+		/// メンバ関数
+		///-------------------------------------------///
+	public:
+
+		// コンストラクタ
+		MappedFile() = default;
+
+		// デストラクタ
+		~MappedFile();
+
+		// コピーコンストラクタ(封印)
+		MappedFile(const MappedFile&) = delete;
+
+		// コピー代入演算子(封印)
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// ムーブコンストラクタ
+		MappedFile(MappedFile&& other) noexcept;
+
+		// ムーブ代入演算子
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		/// <summary>
+		/// ファイルを開いてメモリにマップする
+		/// </summary>
+		/// <param name="filePath">ファイルパス</param>
+		/// <returns>成功したか</returns>
+		bool Open(const std::string& filePath);
+
+		/// <summary>
+		/// マップを解除してファイルを閉じる
+		/// </summary>
+		void Close();
+
+		///-------------------------------------------/// 
+		/// ゲッター
+		///-------------------------------------------///
+	public:
+
+		/// <summary>
+		/// 先頭アドレスのゲッター
+		/// </summary>
+		/// <returns></returns>
+		const uint8_t* GetData() const { return data_; }
+
+		/// <summary>
+		/// ファイルサイズのゲッター
+		/// </summary>
+		/// <returns></returns>
+		uint64_t GetSize() const { return size_; }
+
+		/// <summary>
+		/// 開いているかのゲッター
+		/// </summary>
+		/// <returns></returns>
+		bool IsOpen() const { return data_ != nullptr; }
+
+		/// <summary>
+		/// 指定位置を型付きで参照する (範囲外ならnullptr)
+		/// </summary>
+		/// <typeparam name="T">型</typeparam>
+		/// <param name="offset">先頭からの位置</param>
+		/// <param name="count">要素数</param>
+		/// <returns></returns>
+		template <typename T>
+		const T* GetPointer(uint64_t offset, uint64_t count = 1) const {
+			if (data_ == nullptr || offset > size_ || count > (size_ - offset) / sizeof(T)) return nullptr;
+			return reinterpret_cast<const T*>(data_ + offset);
+		}
+
+		///-------------------------------------------/// 
+		/// メンバ変数
+		///-------------------------------------------///
+	private:
+
+		// ファイルハンドル
+		void* fileHandle_ = nullptr;
+
+		// マッピングハンドル
+		void* mappingHandle_ = nullptr;
+
+		// マップした先頭アドレス
+		const uint8_t* data_ = nullptr;
+
+		// ファイルサイズ
+		uint64_t size_ = 0;
+	};
+}
@@ -0,0 +1,49 @@
+#include "WorldOrigin.h"
+#include "MathVector.h"
+
+using namespace Engine;
+using namespace MathVector;
+
+namespace {
+
+	// 原点をずらした量の合計
+	Vector3 offset = { 0.0f, 0.0f, 0.0f };
+
+	// 世代
+	uint32_t epoch = 0;
+}
+
+void WorldOrigin::Shift(const Vector3& shift) {
+
+	// 移動量を加算
+	offset += shift;
+
+	// 世代を進める
+	epoch++;
+}
+
+void WorldOrigin::Reset() {
+
+	// これまでのずれを打ち消す
+	Shift(-offset);
+}
+
+Vector3 WorldOrigin::ToLocal(const Vector3& coursePosition) {
+
+	return coursePosition - offset;
+}
+
+Vector3 WorldOrigin::ToCourse(const Vector3& localPosition) {
+
+	return localPosition + offset;
+}
+
+const Vector3& WorldOrigin::GetOffset() {
+
+	return offset;
+}
+
+uint32_t WorldOrigin::GetEpoch() {
+
+	return epoch;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Vector3.h"
+
+#include <cstdint>
+
+namespace Engine {
+
+	/// === ワールド原点 === ///
+	/// 原点をずらしたときは移動量と世代だけを記録し、追従するワールド変換は次に触れたときに自分で追いつく
+	/// そのためオブジェクトの数に関係なくオリジンシフトはO(1)で済む
+	namespace WorldOrigin {
+
+		/// <summary>
+		/// 原点をずらす
+		/// </summary>
+		/// <param name="shift">原点の移動量 (追従するオブジェクトはこの分だけ手前に来る)</param>
+		void Shift(const Vector3& shift);
+
+		/// <summary>
+		/// 原点をコースの始点に戻す (追従するオブジェクトはその分だけ奥に戻る)
+		/// </summary>
+		void Reset();
+
+		/// <summary>
+		/// コース座標からローカル座標への変換
+		/// </summary>
+		/// <param name="coursePosition">コース座標</param>
+		/// <returns>ローカル座標</returns>
+		Vector3 ToLocal(const Vector3& coursePosition);
+
+		/// <summary>
+		/// ローカル座標からコース座標への変換
+		/// </summary>
+		/// <param name="localPosition">ローカル座標</param>
+		/// <returns>コース座標</returns>
+		Vector3 ToCourse(const Vector3& localPosition);
+
+		/// <summary>
+		/// これまでに原点をずらした量の合計の取得
+		/// </summary>
+		/// <returns></returns>
+		const Vector3& GetOffset();
+
+		/// <summary>
+		/// 世代の取得 (ずらすたびに増える)
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetEpoch();
+	};
+}
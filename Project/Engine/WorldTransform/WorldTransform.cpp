@@ -1,12 +1,15 @@
 #include "WorldTransform.h"
 #include "MathVector.h"
 #include "MathMatrix.h"
+#include "Easing.h"
+#include "GameClock.h"
 
 #include <imgui.h>
 
 using namespace Engine;
 using namespace MathVector;
 using namespace MathMatrix;
+using namespace Easing;
 
 void WorldTransform::Initialize() {
 
@@ -17,10 +20,43 @@ void WorldTransform::Initialize() {
 	translate_ = { 0.0f, 0.0f, 0.0f };
 
 	worldMatrix_ = MakeIdentity4x4();
+
+	// 次の更新では補間しない
+	ResetInterpolation();
+
+	// 現在の原点を基準にする
+	CaptureOrigin();
 }
 
 void WorldTransform::Update() {
 
+	// 原点の移動に追いつく
+	SyncOrigin();
+
+	// ----------補間のために前のステップの状態を残す----------
+	uint64_t step = GameClock::GetStepCount();
+	if (updateStep_ != step) {
+
+		// 初めての更新やリセットの後は補間しない
+		if (updateStep_ == kNotUpdated) {
+			updatedScale_ = scale_;
+			updatedRotate_ = rotate_;
+			updatedTranslate_ = translate_;
+		}
+
+		// 前のステップの最後の更新時の状態
+		previousScale_ = updatedScale_;
+		previousRotate_ = updatedRotate_;
+		previousTranslate_ = updatedTranslate_;
+
+		updateStep_ = step;
+	}
+
+	// 同じステップで何度更新しても最後の状態を使う
+	updatedScale_ = scale_;
+	updatedRotate_ = rotate_;
+	updatedTranslate_ = translate_;
+
 	// ワールド行列を作成
 	worldMatrix_ = MakeAffineMatrix(scale_, rotate_, translate_);
 
@@ -28,7 +64,7 @@ void WorldTransform::Update() {
 	if (parent_) {
 
 		// 親のワールド行列を掛け合わせる
-		worldMatrix_ *= parent_->worldMatrix_;
+		worldMatrix_ *= parent_->GetWorldMatrix();
 	}
 }
 
@@ -36,6 +72,9 @@ void WorldTransform::ShowImGui() {
 
 #ifdef USE_IMGUI
 
+	// 原点の移動に追いついてから表示する
+	SyncOrigin();
+
 	// ツリーで表示
 	if (ImGui::TreeNodeEx("ワールド座標変換", ImGuiTreeNodeFlags_Framed)) {
 
@@ -80,11 +119,56 @@ void WorldTransform::AddRotate(const Vector3& value) {
 
 void WorldTransform::AddTranslate(const Vector3& value) {
 
+	SyncOrigin();
+
 	translate_ += value;
 }
 
+void WorldTransform::SetOriginRelative(bool isOriginRelative) {
+
+	isOriginRelative_ = isOriginRelative;
+
+	// 現在の座標は今の原点基準のものとして扱う
+	CaptureOrigin();
+}
+
+void WorldTransform::SyncOrigin() const {
+
+	// 追従しない、または追いついていれば何もしない
+	if (!isOriginRelative_ || originEpoch_ == WorldOrigin::GetEpoch()) {
+		return;
+	}
+
+	// 前回追いついてからの原点の移動量
+	Vector3 delta = WorldOrigin::GetOffset() - originOffset_;
+
+	// 親がなければ平行移動がそのままワールド座標なのでずらす (子は親がずれるので不要)
+	if (!parent_) {
+		translate_ -= delta;
+		previousTranslate_ -= delta;
+		updatedTranslate_ -= delta;
+	}
+
+	// 次の更新までワールド座標が古いままにならないように行列の平行移動成分もずらす
+	worldMatrix_.m[3][0] -= delta.x;
+	worldMatrix_.m[3][1] -= delta.y;
+	worldMatrix_.m[3][2] -= delta.z;
+
+	// 現在の原点を基準にする
+	CaptureOrigin();
+}
+
+void WorldTransform::CaptureOrigin() const {
+
+	originEpoch_ = WorldOrigin::GetEpoch();
+	originOffset_ = WorldOrigin::GetOffset();
+}
+
 Vector3 WorldTransform::GetWorldPosition() const {
 
+	// 原点の移動に追いつく
+	SyncOrigin();
+
 	Vector3 worldPosition = {
 		worldMatrix_.m[3][0],
 		worldMatrix_.m[3][1],
@@ -93,3 +177,33 @@ Vector3 WorldTransform::GetWorldPosition() const {
 
 	return worldPosition;
 }
+
+Matrix4x4 WorldTransform::GetInterpolatedWorldMatrix(float alpha) const {
+
+	// ----------最後に更新した状態----------
+	Vector3 scale = updatedScale_;
+	Vector3 rotate = updatedRotate_;
+	Vector3 translate = updatedTranslate_;
+
+	// 最後のステップで更新していれば前のステップとの間を補間する (更新していなければ止まっている)
+	if (updateStep_ == GameClock::GetStepCount()) {
+		scale = Lerp(previousScale_, updatedScale_, alpha);
+		rotate = LerpAngle(previousRotate_, updatedRotate_, alpha);
+		translate = Lerp(previousTranslate_, updatedTranslate_, alpha);
+	}
+
+	// 原点の移動に追いついていなければ、その分をずらす (描画の並列記録中に呼ばれるので書き換えない)
+	if (isOriginRelative_ && !parent_ && originEpoch_ != WorldOrigin::GetEpoch()) {
+		translate -= WorldOrigin::GetOffset() - originOffset_;
+	}
+
+	// ワールド行列を作成
+	Matrix4x4 worldMatrix = MakeAffineMatrix(scale, rotate, translate);
+
+	// 親も補間したものを掛け合わせる
+	if (parent_) {
+		worldMatrix *= parent_->GetInterpolatedWorldMatrix(alpha);
+	}
+
+	return worldMatrix;
+}
@@ -2,6 +2,9 @@
 
 #include "Vector3.h"
 #include "Matrix4x4.h"
+#include "WorldOrigin.h"
+
+#include <cstdint>
 
 namespace Engine {
 
@@ -41,6 +44,26 @@ namespace Engine {
 		/// <param name="value"></param>
 		void AddTranslate(const Vector3& value);
 
+		/// <summary>
+		/// 補間のリセット (次の更新では前のステップからの補間をしない。ワープや使い回しのときに呼ぶ)
+		/// </summary>
+		void ResetInterpolation() { updateStep_ = kNotUpdated; }
+
+	/// ================================================== ///
+	/// クラス内関数
+	/// ================================================== ///
+	private:
+
+		/// <summary>
+		/// ワールド原点の移動に追いつく
+		/// </summary>
+		void SyncOrigin() const;
+
+		/// <summary>
+		/// 現在のワールド原点を基準として記録
+		/// </summary>
+		void CaptureOrigin() const;
+
 	/// ================================================== ///
 	/// ゲッター
 	/// ================================================== ///
@@ -62,13 +85,13 @@ namespace Engine {
 		/// 平行移動のゲッター
 		/// </summary>
 		/// <returns></returns>
-		const Vector3& GetTranslate() const { return translate_; }
+		const Vector3& GetTranslate() const { SyncOrigin(); return translate_; }
 
 		/// <summary>
 		/// ワールド行列のゲッター
 		/// </summary>
 		/// <returns></returns>
-		const Matrix4x4& GetWorldMatrix() const { return worldMatrix_; }
+		const Matrix4x4& GetWorldMatrix() const { SyncOrigin(); return worldMatrix_; }
 
 		/// <summary>
 		/// ワールド座標の取得
@@ -76,6 +99,13 @@ namespace Engine {
 		/// <returns></returns>
 		Vector3 GetWorldPosition() const;
 
+		/// <summary>
+		/// 描画用に前のステップと最後のステップの間を補間したワールド行列の取得 (状態を書き換えないので並列に呼べる)
+		/// </summary>
+		/// <param name="alpha">補間係数 (GameClock::GetAlpha)</param>
+		/// <returns></returns>
+		Matrix4x4 GetInterpolatedWorldMatrix(float alpha) const;
+
 	/// ================================================== ///
 	/// セッター
 	/// ================================================== ///
@@ -97,7 +127,7 @@ namespace Engine {
 		/// 平行移動のセッター
 		/// </summary>
 		/// <param name="translate">平行移動</param>
-		void SetTranslate(const Vector3& translate) { translate_ = translate; }
+		void SetTranslate(const Vector3& translate) { SyncOrigin(); translate_ = translate; }
 
 		/// <summary>
 		/// 親のワールド変換クラスのセッター
@@ -105,6 +135,12 @@ namespace Engine {
 		/// <param name="parent">親のワールド変換クラス</param>
 		void SetParent(const WorldTransform* parent) { parent_ = parent; }
 
+		/// <summary>
+		/// ワールド原点の移動に追従するかのセッター
+		/// </summary>
+		/// <param name="isOriginRelative">追従するか</param>
+		void SetOriginRelative(bool isOriginRelative);
+
 	/// ================================================== ///
 	/// メンバ変数
 	/// ================================================== ///
@@ -116,13 +152,45 @@ namespace Engine {
 		// 回転
 		Vector3 rotate_ = { 0.0f, 0.0f, 0.0f };
 
-		// 平行移動
-		Vector3 translate_ = { 0.0f, 0.0f, 0.0f };
+		// 平行移動 (原点の移動に遅れて追いつくのでconstからも書き換える)
+		mutable Vector3 translate_ = { 0.0f, 0.0f, 0.0f };
 
 		// ワールド行列
-		Matrix4x4 worldMatrix_ = {};
+		mutable Matrix4x4 worldMatrix_ = {};
 
 		// 親のワールド変換クラス
 		const WorldTransform* parent_ = nullptr;
+
+		// ワールド原点の移動に追従するか
+		bool isOriginRelative_ = false;
+
+		// 最後に追いついたワールド原点の世代
+		mutable uint32_t originEpoch_ = 0;
+
+		// 最後に追いついたワールド原点のずれ
+		mutable Vector3 originOffset_ = { 0.0f, 0.0f, 0.0f };
+
+		/// ===== 補間 ===== ///
+
+		// 前のステップの最後の更新時の拡縮、回転、平行移動
+		Vector3 previousScale_ = { 1.0f, 1.0f, 1.0f };
+		Vector3 previousRotate_ = { 0.0f, 0.0f, 0.0f };
+		mutable Vector3 previousTranslate_ = { 0.0f, 0.0f, 0.0f };
+
+		// 最後の更新時の拡縮、回転、平行移動 (ワールド行列はこれから作られている)
+		Vector3 updatedScale_ = { 1.0f, 1.0f, 1.0f };
+		Vector3 updatedRotate_ = { 0.0f, 0.0f, 0.0f };
+		mutable Vector3 updatedTranslate_ = { 0.0f, 0.0f, 0.0f };
+
+		// 最後に更新したステップ
+		uint64_t updateStep_ = kNotUpdated;
+
+	/// ================================================== ///
+	/// 定数
+	/// ================================================== ///
+	private:
+
+		// まだ更新していないステップ
+		static const uint64_t kNotUpdated = UINT64_MAX;
 	};
 }
\ No newline at end of file
@@ -7,10 +7,14 @@
 #include "SceneFactory.h"
 #include "Input.h"
 #include "Texture/TextureManager.h"
-#include "Model/ModelManager.h"
+#include "AssetLoader.h"
 #include "LineRenderer.h"
 #include "LineManager.h"
 #include "TransitionManager.h"
+#include "Object/Object3dRenderer.h"
+#include "Sprite/SpriteRenderer.h"
+#include "GameClock.h"
+#include "Profiler.h"
 
 using namespace Engine;
 
@@ -40,13 +44,13 @@ void MyGame::Initialize() {
 	transitionManager_ = TransitionManager::GetInstance();
 }
 
-void MyGame::Update() {
+void MyGame::FixedUpdate() {
 
 	// エンジン層の更新
-	Framework::Update();
+	Framework::FixedUpdate();
 
 	// 遷移マネージャの更新
-	transitionManager_->Update();
+	transitionManager_->Update(GameClock::GetDeltaTime());
 
 #ifdef _DEBUG
 
@@ -62,12 +66,17 @@ void MyGame::Update() {
 
 void MyGame::Draw() {
 
+	PROFILE_SCOPE("MyGame::Draw");
+
 	/// ========== ゲームシーンの描画開始 ========== ///
 
 	/// ===== フィルター適応のある描画 ===== ///
 
 	sceneBuffer->PreDrawFiltered();
 
+	// 更新で登録された3Dオブジェクトを視錐台でまとめてカリング
+	object3dRenderer_->Cull();
+
 	sceneManager_->DrawFiltered();
 
 	sceneBuffer->PostDraw();
@@ -78,17 +87,33 @@ void MyGame::Draw() {
 
 	sceneBuffer->PreDrawUnfiltered();
 
-	sceneManager_->DrawUnfiltered();
+	// スプライトと線は別々のコマンドリストに並列で記録する (送信は追加した順)
+	CommandRecorder& commandRecorder = dxUtility_->GetCommandRecorder();
+
+	// シーンのスプライト描画 (各スプライトはバッチに追加するだけで、最後にまとめて描画する)
+	commandRecorder.Add("Sprites", [this]() {
+
+		spriteRenderer_->Begin();
+
+		sceneManager_->DrawUnfiltered();
+
+		spriteRenderer_->Flush();
+	});
 
-	// 線描画の設定
-	lineRenderer_->SettingDrawing();
+	commandRecorder.Add("Lines", [this]() {
+
+		// 線描画の設定
+		lineRenderer_->SettingDrawing();
 
 #ifdef _DEBUG
 
-	// 線描画
-	lineManager_->Render();
+		// 線描画
+		lineManager_->Render();
 
 #endif // _DEBUG
+	});
+
+	commandRecorder.Execute();
 
 	sceneBuffer->PostDraw();
 
@@ -111,10 +136,8 @@ void MyGame::Draw() {
 
 	/// ========== 画面への描画終了 ========== ///
 
-	swapChain->PostDraw();
-
-	// DirectXユーティリティの描画後処理
-	dxUtility_->PostDraw();
+	// フレームの送信
+	SubmitFrame();
 }
 
 void MyGame::Finalize() {
@@ -139,48 +162,53 @@ void MyGame::LoadAllResource() {
 
 	/// ===== テクスチャの読み込み ===== ///
 
-	textureManager_->LoadTextureRelative("BlackScreen.png");
-	textureManager_->LoadTextureRelative("start.png");
-	textureManager_->LoadTextureRelative("title.png");
-	textureManager_->LoadTextureRelative("White1280x720.png");
-	textureManager_->LoadTextureRelative("Black1280x720.png");
-	textureManager_->LoadTextureRelative("LockOn.png");
-	textureManager_->LoadTextureRelative("2DReticle.png");
-	textureManager_->LoadTextureRelative("Rule/Rule.png");
-	textureManager_->LoadTextureRelative("Rule/Operation.png");
-	textureManager_->LoadTextureRelative("Norma/NormaText.png");
-	textureManager_->LoadTextureRelative("Norma/Slash.png");
-	textureManager_->LoadTextureRelative("Numbers.png");
-	textureManager_->LoadTextureRelative("Result/Clear.png");
-	textureManager_->LoadTextureRelative("Result/GameOver.png");
-	textureManager_->LoadTextureRelative("GameClear.png");
-	textureManager_->LoadTextureRelative("GameOver.png");
-	textureManager_->LoadTextureRelative("Guide/Mouse.png");
-	textureManager_->LoadTextureRelative("Guide/MouseClick.png");
-	textureManager_->LoadTextureRelative("Guide/ButtonA.png");
-	textureManager_->LoadTextureRelative("Guide/ButtonD.png");
-	textureManager_->LoadTextureRelative("Guide/PushA.png");
-	textureManager_->LoadTextureRelative("Guide/PushD.png");
-	textureManager_->LoadTextureRelative("Guide/Pause.png");
-	textureManager_->LoadTextureRelative("Guide/Back.png");
-	textureManager_->LoadTextureRelative("White1x1.png");
-	textureManager_->LoadTextureRelative("PauseUI/ResumeButton.png");
-	textureManager_->LoadTextureRelative("PauseUI/RestartButton.png");
-	textureManager_->LoadTextureRelative("PauseUI/QuitButton.png");
-	textureManager_->LoadTextureRelative("PauseUI/Frame.png");
-
-	textureManager_->LoadTextureRelative("rostock_laage_airport_4k.dds");
-
-	/// ===== モデルの読み込み ===== ///
-
-	modelManager_->LoadModelData("Player", "player.obj");
-	modelManager_->LoadModelData("Cylinder", "cylinder.obj");
-	modelManager_->LoadModelData("Floor", "floor.obj");
-	modelManager_->LoadModelData("PlayerBullet", "PlayerBullet.obj");
-	modelManager_->LoadModelData("Enemy", "enemy.obj");
-	modelManager_->LoadModelData("Enemy", "Kamikaze.obj");
-	modelManager_->LoadModelData("EnemyBullet", "EnemyBullet.obj");
-	modelManager_->LoadModelData("Goal", "Goal.obj");
-	modelManager_->LoadModelData("Gate", "Gate.obj");
-	modelManager_->LoadModelData("Reticle", "Reticle.obj");
+	// UIのテクスチャアトラス (アトラスに入っている画像は個別に読み込まない)
+	const TextureAtlas& atlas = spriteRenderer_->GetAtlas();
+	if (atlas.IsLoaded()) {
+		assetLoader_->RequestTexture(atlas.GetTexturePath());
+	}
+
+	// アトラスに入っていない画像だけ個別に読み込む
+	auto requestTexture = [&](const std::string& relativePath) {
+		if (!atlas.Find(textureManager_->GetBaseDirectoryPath() + "/" + relativePath)) {
+			assetLoader_->RequestTextureRelative(relativePath);
+		}
+	};
+
+	requestTexture("BlackScreen.png");
+	requestTexture("start.png");
+	requestTexture("title.png");
+	requestTexture("White1280x720.png");
+	requestTexture("Black1280x720.png");
+	requestTexture("LockOn.png");
+	requestTexture("2DReticle.png");
+	requestTexture("Rule/Rule.png");
+	requestTexture("Rule/Operation.png");
+	requestTexture("Norma/NormaText.png");
+	requestTexture("Norma/Slash.png");
+	requestTexture("Numbers.png");
+	requestTexture("Result/Clear.png");
+	requestTexture("Result/GameOver.png");
+	requestTexture("GameClear.png");
+	requestTexture("GameOver.png");
+	requestTexture("Guide/Mouse.png");
+	requestTexture("Guide/MouseClick.png");
+	requestTexture("Guide/ButtonA.png");
+	requestTexture("Guide/ButtonD.png");
+	requestTexture("Guide/PushA.png");
+	requestTexture("Guide/PushD.png");
+	requestTexture("Guide/Pause.png");
+	requestTexture("Guide/Back.png");
+	requestTexture("White1x1.png");
+	requestTexture("PauseUI/ResumeButton.png");
+	requestTexture("PauseUI/RestartButton.png");
+	requestTexture("PauseUI/QuitButton.png");
+	requestTexture("PauseUI/Frame.png");
+
+	assetLoader_->RequestTextureRelative("rostock_laage_airport_4k.dds");
+
+	/// ===== 転送待ち ===== ///
+
+	// 全て転送されるまで待つ (デコードはワーカースレッドで並列に進む。モデルは使うシーンが先読みする)
+	assetLoader_->WaitAll();
 }
@@ -24,9 +24,9 @@ public:
 	void Initialize() override;
 
 	/// <summary>
-	/// 更新
+	/// 固定の刻みでの更新
 	/// </summary>
-	void Update() override;
+	void FixedUpdate() override;
 
 	/// <summary>
 	/// 描画
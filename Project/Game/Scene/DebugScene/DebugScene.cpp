@@ -59,16 +59,17 @@ void DebugScene::Update() {
 
 	// カメラの更新
 	camera->Update();
+
+	// 線の登録 (DrawUnfilteredは線の記録と並列に呼ばれるので更新で登録する)
+	lineManager->DrawSphere({ 0.0f, 0.0f, 0.0f }, 2.0f, { 1.0f, 1.0f, 1.0f, 1.0f }, 8);
+
+	lineManager->DrawAABB({ -2.0f, -2.0f, -2.0f }, { 2.0f, 2.0f, 2.0f }, { 1.0f, 1.0f, 1.0f, 1.0f });
 }
 
 void DebugScene::DrawFiltered() {
 }
 
 void DebugScene::DrawUnfiltered() {
-
-	lineManager->DrawSphere({ 0.0f, 0.0f, 0.0f }, 2.0f, { 1.0f, 1.0f, 1.0f, 1.0f }, 8);
-
-	lineManager->DrawAABB({ -2.0f, -2.0f, -2.0f }, { 2.0f, 2.0f, 2.0f }, { 1.0f, 1.0f, 1.0f, 1.0f });
 }
 
 void DebugScene::Finalize() {
@@ -1,13 +1,9 @@
 #include "GameClearScene.h"
-#include "Sprite/SpriteRenderer.h"
 
 using namespace Engine;
 
 void GameClearScene::Initialize() {
 
-	// インスタンスの取得
-	spriteRenderer_ = SpriteRenderer::GetInstance();
-
 	// スプライトの生成&初期化
 	sprite_ = std::make_unique<Sprite>();
 	sprite_->Initialize("GameClear.png");
@@ -29,9 +25,6 @@ void GameClearScene::DrawFiltered() {
 
 void GameClearScene::DrawUnfiltered() {
 
-	// スプライトレンダラーの描画設定
-	spriteRenderer_->SettingDrawing();
-
 	// スプライトの描画
 	sprite_->Draw();
 }
@@ -8,13 +8,6 @@
 
 #include <memory>
 
-/// ===== 前方宣言 ===== ///
-
-namespace Engine {
-
-	class SpriteRenderer;
-}
-
 /// ===== ゲームクリアシーン ===== ///
 class GameClearScene : public BaseScene {
 
@@ -67,9 +60,6 @@ private:
 	// テクスチャマネージャのインスタンス
 	Engine::TextureManager* textureManager_ = Engine::TextureManager::GetInstance();
 
-	// スプライトレンダラーのインスタンス
-	Engine::SpriteRenderer* spriteRenderer_ = nullptr;
-
 	// スプライト
 	std::unique_ptr<Engine::Sprite> sprite_ = nullptr;
 };
\ No newline at end of file
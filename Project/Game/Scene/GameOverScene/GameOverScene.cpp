@@ -9,7 +9,6 @@
 #include "OffscreenRendering/Filters/RadialBlurFilter.h"
 #include "Transition/FadeTransition.h"
 #include "CameraControll/FollowCamera/FollowCameraController.h"
-#include "Sprite/SpriteRenderer.h"
 
 using namespace Engine;
 
@@ -21,7 +20,6 @@ void GameOverScene::Initialize() {
 	input_ = Input::GetInstance();
 	sceneManager_ = SceneManager::GetInstance();
 	transitionManager = TransitionManager::GetInstance();
-	spriteRenderer_ = SpriteRenderer::GetInstance();
 
 	// フォグをフィルターマネージャから受け取っとく
 	fogFilter_ = filterManager_->GetFogFilter();
@@ -181,9 +179,6 @@ void GameOverScene::DrawFiltered() {
 
 void GameOverScene::DrawUnfiltered() {
 
-	// スプライトの描画設定
-	spriteRenderer_->SettingDrawing();
-
 	// スプライトの描画
 	text_->Draw();
 }
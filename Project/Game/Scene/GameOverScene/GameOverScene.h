@@ -23,8 +23,6 @@ namespace Engine {
 	class TransitionManager;
 	class FogFilter;
 	class RadialBlurFilter;
-
-	class SpriteRenderer;
 }
 
 /// ===== ゲームオーバーシーン ===== ///
@@ -161,7 +159,4 @@ private:
 
 	// ラジアルブラーの借りポインタ
 	Engine::RadialBlurFilter* radialBlurFilter_ = nullptr;
-
-	// スプライトレンダラーのインスタンス
-	Engine::SpriteRenderer* spriteRenderer_ = nullptr;
 };
\ No newline at end of file
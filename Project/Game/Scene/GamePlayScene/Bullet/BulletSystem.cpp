@@ -0,0 +1,232 @@
+#include "BulletSystem.h"
+#include "Collision/CollisionManager.h"
+#include "Collider.h"
+#include "Collision/CollisionTypeIDDef.h"
+#include "Object/Object3d.h"
+#include "WorldTransform.h"
+#include "MathVector.h"
+#include "GameClock.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <imgui.h>
+
+using namespace Engine;
+using namespace MathVector;
+
+void BulletSystem::Initialize(EntityRegistry* registry) {
+
+	assert(registry);
+	registry_ = registry;
+
+	// ----------モデルは種類ごとに1つを全ての弾で共有する----------
+	playerBulletModel_ = std::make_unique<Model>();
+	playerBulletModel_->Initialize("PlayerBullet", "PlayerBullet.obj");
+
+	enemyBulletModel_ = std::make_unique<Model>();
+	enemyBulletModel_->Initialize("EnemyBullet", "EnemyBullet.obj");
+
+	// ----------当たったときのエミッターも種類ごとに共有する (発生させる直前に位置を合わせる)----------
+	playerBulletEmitter_ = std::make_unique<ParticleEmitter>("BulletBlue", EmitterType::OneShot, 20);
+	playerBulletEmitter_->Initialize();
+
+	enemyBulletEmitter_ = std::make_unique<ParticleEmitter>("BulletRed", EmitterType::OneShot, 20);
+	enemyBulletEmitter_->Initialize();
+
+	// ----------弾の配列を容量の分だけ確保しておく----------
+	registry_->Reserve<BulletTag, BulletMotion, WorldTransform, Object3d, Collider>(kBulletCapacity);
+}
+
+void BulletSystem::Update() {
+
+	PROFILE_SCOPE("BulletSystem::Update");
+
+	// 前のステップで予約した生成と破棄を反映 (寿命が尽きた弾と当たった弾はここで消える)
+	registry_->Flush();
+	spawnedCount_ = 0;
+
+	float deltaTime = GameClock::GetDeltaTime();
+
+	// ----------移動と寿命----------
+	// 寿命が尽きたステップも動かして衝突判定に参加させ、次のステップで消す
+	registry_->ForEach<BulletMotion, WorldTransform>([this, deltaTime](Entity entity, BulletMotion& motion, WorldTransform& worldTransform) {
+
+		motion.lifeTime -= deltaTime;
+		if (motion.lifeTime <= 0.0f) {
+			registry_->DestroyDeferred(entity);
+		}
+
+		worldTransform.AddTranslate(motion.velocity);
+		worldTransform.Update();
+	});
+
+	// ----------3Dオブジェクトとコライダーを弾の位置に合わせる----------
+	registry_->ForEach<WorldTransform, Object3d, Collider>([](Entity, WorldTransform& worldTransform, Object3d& object, Collider& collider) {
+
+		object.SetRotate(worldTransform.GetRotate());
+		object.SetTranslate(worldTransform.GetTranslate());
+		object.Update();
+
+		collider.SetWorldTransform(worldTransform);
+		collider.Update();
+	});
+}
+
+void BulletSystem::Draw() {
+
+	// コライダーの描画
+	registry_->ForEach<Collider>([](Entity, Collider& collider) { collider.Draw(); });
+
+	// インスタンス描画に登録 (描画するまで配列の並びは変わらない)
+	registry_->ForEach<Object3d>([](Entity, Object3d& object) { object.DrawInstanced(); });
+}
+
+void BulletSystem::ShowImGui() {
+
+#ifdef USE_IMGUI
+
+	// 種類ごとの数
+	uint32_t playerBulletCount = 0;
+	uint32_t enemyBulletCount = 0;
+	for (const BulletTag& tag : registry_->GetComponents<BulletTag>()) {
+		if (tag.kind == BulletKind::Player) {
+			playerBulletCount++;
+		}
+		else {
+			enemyBulletCount++;
+		}
+	}
+
+	ImGui::Begin("Bullets");
+
+	ImGui::Text("PlayerBullets: %u", playerBulletCount);
+	ImGui::Text("EnemyBullets: %u", enemyBulletCount);
+	ImGui::Text("Entities: %u", registry_->GetAliveCount());
+	ImGui::Text("Peak: %u / %u", peakBulletCount_, kBulletCapacity);
+	ImGui::Text("Exhausted: %u", exhaustedCount_);
+
+	ImGui::End();
+
+#endif // USE_IMGUI
+}
+
+void BulletSystem::Clear() {
+
+	// 予約中の弾も含めて全て破棄する
+	registry_->Flush();
+	for (Entity entity : registry_->GetEntities<BulletTag>()) {
+		registry_->DestroyDeferred(entity);
+	}
+	registry_->Flush();
+	spawnedCount_ = 0;
+}
+
+void BulletSystem::CollectColliders(CollisionManager* collisionManager) {
+
+	// 次のUpdateまで配列の並びは変わらないので、要素のアドレスをそのまま渡せる
+	for (Collider& collider : registry_->GetComponents<Collider>()) {
+		collisionManager->AddCollider(&collider);
+	}
+}
+
+Entity BulletSystem::SpawnPlayerBullet(const Vector3& position, const Vector3& direction, bool isLockedOn) {
+
+	// 向きからヨーとピッチを求める
+	float yaw = std::atan2(direction.x, direction.z);
+	float pitch = std::atan2(-direction.y, Length(direction.x, direction.z));
+
+	return Spawn({ BulletKind::Player, isLockedOn }, position, { pitch, yaw, 0.0f }, { direction * kPlayerBulletSpeed, kPlayerBulletLifeTime });
+}
+
+Entity BulletSystem::SpawnEnemyBullet(const Vector3& position, const Vector3& direction) {
+
+	return Spawn({ BulletKind::Enemy, false }, position, { 0.0f, 0.0f, 0.0f }, { direction * kEnemyBulletSpeed, kEnemyBulletLifeTime });
+}
+
+Entity BulletSystem::Spawn(const BulletTag& tag, const Vector3& position, const Vector3& rotate, const BulletMotion& motion) {
+
+	// 容量に達していたら撃たない (破棄を予約した弾は次のUpdateまで数に含める)
+	uint32_t bulletCount = static_cast<uint32_t>(registry_->GetComponents<BulletTag>().size()) + spawnedCount_;
+	if (bulletCount >= kBulletCapacity) {
+		exhaustedCount_++;
+		return {};
+	}
+
+	// 最大数を更新
+	spawnedCount_++;
+	peakBulletCount_ = (std::max)(peakBulletCount_, bulletCount + 1);
+
+	bool isPlayerBullet = tag.kind == BulletKind::Player;
+
+	// 番号だけ先に割り当て、コンポーネントは次のUpdateで追加する
+	Entity entity = registry_->Create();
+
+	// ワールド変換 (キャラクターと同じくワールド原点の移動に追従する)
+	WorldTransform worldTransform;
+	worldTransform.Initialize();
+	worldTransform.SetOriginRelative(true);
+	worldTransform.SetTranslate(position);
+	worldTransform.SetRotate(rotate);
+
+	// 3Dオブジェクト
+	Object3d object;
+	object.Initialize();
+	object.SetModel(isPlayerBullet ? playerBulletModel_.get() : enemyBulletModel_.get());
+	object.SetScale(isPlayerBullet ? kPlayerBulletScale : kEnemyBulletScale);
+
+	// コライダー (当たったらエンティティを渡して処理する)
+	uint32_t typeID = static_cast<uint32_t>(isPlayerBullet ? CollisionTypeIDDef::kPlayerBullet : CollisionTypeIDDef::kEnemyBullet);
+	Collider collider(Sphere{}, typeID);
+	collider.Initialize();
+	collider.SetOnCollision([this, entity](Collider* other) { OnCollision(entity, other); });
+
+	registry_->EmplaceDeferred(entity, tag);
+	registry_->EmplaceDeferred(entity, motion);
+	registry_->EmplaceDeferred(entity, std::move(worldTransform));
+	registry_->EmplaceDeferred(entity, std::move(object));
+	registry_->EmplaceDeferred(entity, std::move(collider));
+
+	return entity;
+}
+
+void BulletSystem::OnCollision(Entity entity, Collider* other) {
+
+	// 衝突相手の種別IDを取得
+	uint32_t typeID = other->GetTypeID();
+
+	const BulletTag& tag = registry_->Get<BulletTag>(entity);
+
+	// ----------自機の弾----------
+	if (tag.kind == BulletKind::Player) {
+
+		// 敵か敵の弾に当たったら消える (ロックオンでの射撃は敵の弾をすり抜ける)
+		bool isHit = typeID == static_cast<uint32_t>(CollisionTypeIDDef::kEnemy) ||
+			(typeID == static_cast<uint32_t>(CollisionTypeIDDef::kEnemyBullet) && !tag.isLockedOn);
+		if (!isHit) {
+			return;
+		}
+
+		// パーティクル発生
+		playerBulletEmitter_->SetTranslate(registry_->Get<WorldTransform>(entity).GetWorldPosition());
+		playerBulletEmitter_->Emit();
+	}
+	// ----------敵の弾----------
+	else {
+
+		// 自機か自機の弾に当たったら消える
+		bool isHit = typeID == static_cast<uint32_t>(CollisionTypeIDDef::kPlayer) ||
+			typeID == static_cast<uint32_t>(CollisionTypeIDDef::kPlayerBullet);
+		if (!isHit) {
+			return;
+		}
+
+		// パーティクル発生
+		enemyBulletEmitter_->SetTranslate(registry_->Get<WorldTransform>(entity).GetWorldPosition());
+		enemyBulletEmitter_->Emit();
+	}
+
+	// 衝突判定が終わるまではコライダーを残しておき、次のUpdateで消す
+	registry_->DestroyDeferred(entity);
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "EntityRegistry.h"
+#include "Model/Model.h"
+#include "Particle/ParticleEmitter.h"
+#include "Vector3.h"
+
+#include <memory>
+
+/// ===== 前方宣言 ===== ///
+
+namespace Engine {
+
+	class Collider;
+	class CollisionManager;
+}
+
+// 弾の種類
+enum class BulletKind : uint8_t {
+	Player,		// 自機の弾
+	Enemy,		// 敵の弾
+};
+
+// 弾の動き
+struct BulletMotion {
+	Engine::Vector3 velocity;	// 1ステップの移動量
+	float lifeTime;				// 残りの寿命(秒)
+};
+
+// 弾の種類と状態
+struct BulletTag {
+	BulletKind kind;			// 種類
+	bool isLockedOn;			// ロックオンでの射撃か (敵の弾と相殺しない)
+};
+
+/// ===== 弾のシステム ===== ///
+/// 数の多い自機の弾と敵の弾を、1つずつのオブジェクトではなくエンティティのコンポーネントとして持つ
+/// 弾ごとにモデルやエミッターを作らず種類ごとに共有し、更新は種類ごとに詰めた配列を順に回す
+/// 生成と破棄は予約しておき、次のUpdateの最初にまとめて反映する (衝突判定中にコライダーの並びが変わらない)
+/// 配列は初期化で容量の分だけ確保し、容量に達したら撃たない (撃つたびにメモリを確保しない)
+class BulletSystem {
+
+///-------------------------------------------///
+/// メンバ関数
+///-------------------------------------------///
+public:
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="registry">弾のエンティティを作るレジストリ</param>
+	void Initialize(Engine::EntityRegistry* registry);
+
+	/// <summary>
+	/// 更新 (予約した生成と破棄を反映してから、全ての弾を動かす)
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// 描画 (3Dオブジェクトはインスタンス描画に登録する)
+	/// </summary>
+	void Draw();
+
+	/// <summary>
+	/// ImGui表示
+	/// </summary>
+	void ShowImGui();
+
+	/// <summary>
+	/// 全ての弾を消す
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// 弾のコライダーを衝突マネージャに登録
+	/// </summary>
+	/// <param name="collisionManager">衝突マネージャ</param>
+	void CollectColliders(Engine::CollisionManager* collisionManager);
+
+	/// <summary>
+	/// 自機の弾の生成 (次のUpdateから動く)
+	/// </summary>
+	/// <param name="position">発射位置</param>
+	/// <param name="direction">向き (正規化済み)</param>
+	/// <param name="isLockedOn">ロックオンでの射撃か</param>
+	/// <returns>弾のエンティティ (容量に達していたら空のエンティティ)</returns>
+	Engine::Entity SpawnPlayerBullet(const Engine::Vector3& position, const Engine::Vector3& direction, bool isLockedOn);
+
+	/// <summary>
+	/// 敵の弾の生成 (次のUpdateから動く)
+	/// </summary>
+	/// <param name="position">発射位置</param>
+	/// <param name="direction">向き (正規化済み)</param>
+	/// <returns>弾のエンティティ (容量に達していたら空のエンティティ)</returns>
+	Engine::Entity SpawnEnemyBullet(const Engine::Vector3& position, const Engine::Vector3& direction);
+
+///-------------------------------------------///
+/// クラス内関数
+///-------------------------------------------///
+private:
+
+	/// <summary>
+	/// 弾の生成
+	/// </summary>
+	/// <param name="tag">種類と状態</param>
+	/// <param name="position">発射位置</param>
+	/// <param name="rotate">向き</param>
+	/// <param name="motion">動き</param>
+	/// <returns>弾のエンティティ (容量に達していたら空のエンティティ)</returns>
+	Engine::Entity Spawn(const BulletTag& tag, const Engine::Vector3& position, const Engine::Vector3& rotate, const BulletMotion& motion);
+
+	/// <summary>
+	/// 衝突時の処理
+	/// </summary>
+	/// <param name="entity">衝突した弾</param>
+	/// <param name="other">衝突相手</param>
+	void OnCollision(Engine::Entity entity, Engine::Collider* other);
+
+///-------------------------------------------///
+/// メンバ変数
+///-------------------------------------------///
+private:
+
+	// 弾のエンティティを作るレジストリ
+	Engine::EntityRegistry* registry_ = nullptr;
+
+	// 自機の弾のモデル
+	std::unique_ptr<Engine::Model> playerBulletModel_ = nullptr;
+
+	// 敵の弾のモデル
+	std::unique_ptr<Engine::Model> enemyBulletModel_ = nullptr;
+
+	// 自機の弾が当たったときのエミッター
+	std::unique_ptr<Engine::ParticleEmitter> playerBulletEmitter_ = nullptr;
+
+	// 敵の弾が当たったときのエミッター
+	std::unique_ptr<Engine::ParticleEmitter> enemyBulletEmitter_ = nullptr;
+
+	// 前のUpdateから生成した弾の数 (まだ配列に入っていない弾)
+	uint32_t spawnedCount_ = 0;
+
+	// 同時に存在した弾の最大数 (容量の調整に使う)
+	uint32_t peakBulletCount_ = 0;
+
+	// 容量に達していて撃てなかった回数
+	uint32_t exhaustedCount_ = 0;
+
+///-------------------------------------------///
+/// 定数
+///-------------------------------------------///
+private:
+
+	// 弾の容量 (自機の弾と敵の弾の合計)
+	const uint32_t kBulletCapacity = 512;
+
+	// 自機の弾の速さ (1ステップの移動量)
+	const float kPlayerBulletSpeed = 4.0f;
+
+	// 自機の弾の寿命(秒)
+	const float kPlayerBulletLifeTime = 0.5f;
+
+	// 自機の弾の大きさ
+	const Engine::Vector3 kPlayerBulletScale = { 0.5f, 0.5f, 5.0f };
+
+	// 敵の弾の速さ (1ステップの移動量)
+	const float kEnemyBulletSpeed = 0.5f;
+
+	// 敵の弾の寿命(秒)
+	const float kEnemyBulletLifeTime = 4.0f;
+
+	// 敵の弾の大きさ
+	const Engine::Vector3 kEnemyBulletScale = { 0.5f, 0.5f, 0.5f };
+};
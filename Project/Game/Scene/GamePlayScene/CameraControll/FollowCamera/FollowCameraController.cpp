@@ -4,6 +4,7 @@
 #include "MathRandom.h"
 #include "Easing.h"
 #include "Player/Player.h"
+#include "GameClock.h"
 
 #include <imgui.h>
 
@@ -81,7 +82,7 @@ void FollowCameraController::Shake() {
 
 	// カメラシェイクの更新
 	if (isShaking_) {
-		shakeTimer_ += 1.0f / 60.0f; // 60FPS想定
+		shakeTimer_ += GameClock::GetDeltaTime();
 
 		if (shakeTimer_ >= shakeDuration_) {
 			// シェイク終了
@@ -16,6 +16,11 @@ class ICameraController {
 	///-------------------------------------------///
 public:
 
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	ICameraController() { worldTransform.SetOriginRelative(true); } // カメラはワールド原点の移動に追従する
+
 	/// <summary>
 	/// 仮想デストラクタ
 	/// </summary>
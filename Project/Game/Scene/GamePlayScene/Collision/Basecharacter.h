@@ -15,6 +15,11 @@ class BaseCharacter {
 /// ================================================== ///
 public:
 
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	BaseCharacter() { worldTransform_.SetOriginRelative(true); } // キャラクターはワールド原点の移動に追従する
+
 	/// <summary>
 	/// 初期化
 	/// </summary>
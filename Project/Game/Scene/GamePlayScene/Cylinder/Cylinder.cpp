@@ -64,6 +64,15 @@ void Cylinder::Draw() {
 	}
 }
 
+void Cylinder::Submit(RenderQueue& renderQueue, uint32_t pipeline) {
+
+	// オブジェクトごとに不透明のパケットを積む
+	for (const auto& object : objects_) {
+
+		object->Submit(renderQueue, RenderQueue::Pass::Opaque, pipeline);
+	}
+}
+
 void Cylinder::Finalize() {
 }
 
@@ -2,9 +2,9 @@
 #include "Collision/CollisionTypeIDDef.h"
 #include "Player/Player.h"
 #include "GamePlayScene.h"
-#include "EnemyBullet.h"
 #include "MathVector.h"
 #include "Easing.h"
+#include "GameClock.h"
 
 #include <numbers>
 #include <imgui.h>
@@ -99,7 +99,7 @@ void Enemy::Update() {
 			else {
 
 				// タイマーをデクリメント
-				fireTimer_ -= 1.0f / 60.0f;
+				fireTimer_ -= GameClock::GetDeltaTime();
 			}
 
 			if (isFiring_) {
@@ -147,13 +147,34 @@ void Enemy::Draw() {
 	// コライダーの描画
 	collider_->Draw();
 
-	// 3Dオブジェクトの描画
-	object->Draw();
+	// 3Dオブジェクトをインスタンス描画に登録
+	object->DrawInstanced();
 }
 
 void Enemy::Finalize() {
 }
 
+void Enemy::Reset() {
+
+	// 出現ごとの状態を初期値に戻す
+	isDead = false;
+	player = nullptr;
+	fireTimer_ = 0.0f;
+	fireAnimationTimer_ = 0.0f;
+	isFiring_ = false;
+	drillRotation_ = 0.0f;
+	velocity_ = { 0.0f, 0.0f, 0.0f };
+
+	// 位置と向きは出現させる側が設定する
+	worldTransform_.SetTranslate({ 0.0f, 0.0f, 0.0f });
+	worldTransform_.SetRotate({ 0.0f, 0.0f, 0.0f });
+	object->SetScale(defaultScale_);
+
+	// 前に使ったときの位置から補間しない
+	worldTransform_.ResetInterpolation();
+	object->ResetInterpolation();
+}
+
 void Enemy::ShowImGui() {
 
 #ifdef USE_IMGUI
@@ -228,24 +249,15 @@ void Enemy::AimToPlayer() {
 
 void Enemy::Fire() {
 
-	// 弾の生成&初期化
-	std::unique_ptr<EnemyBullet> bullet = std::make_unique<EnemyBullet>();
-	bullet->Initialize();
-
-	// 弾の初期位置をプレイヤーの位置に設定
-	bullet->GetWorldTransform().SetTranslate(worldTransform_.GetWorldPosition());
-
 	// プレイヤーの座標を取得
 	Vector3 playerPos = player->GetWorldTransform().GetWorldPosition();
 
-	// 弾の初期速度を設定
 	// プレイヤーとの方向を計算
 	Vector3 direction = playerPos - worldTransform_.GetTranslate();
 	direction = Normalize(direction);
-	bullet->SetVelocity(direction);
 
-	// ゲームプレイシーンの弾をリストに登録
-	gamePlayScene_->AddEnemyBullet(std::move(bullet));
+	// 自分の位置からプレイヤーに向けて弾を撃つ
+	gamePlayScene_->AddEnemyBullet(worldTransform_.GetWorldPosition(), direction);
 
 	// 射撃間隔タイマーをリセット
 	fireTimer_ = kFireDuration_;
@@ -260,7 +272,7 @@ void Enemy::Fire() {
 void Enemy::FireAnimationUpdate() {
 
 	// デルタタイム分デクリメント
-	fireAnimationTimer_ -= 1.0f / 60.0f;
+	fireAnimationTimer_ -= GameClock::GetDeltaTime();
 
 	float t = 1.0f - (fireAnimationTimer_ / kFireAnimationDuration_); // 経過割合を計算
 	float easedT = EaseOutCubic(t); // イージング適用
@@ -36,7 +36,7 @@ public:
 	void Update() override;
 
 	/// <summary>
-	/// 描画
+	/// 描画 (3Dオブジェクトはインスタンス描画に登録する)
 	/// </summary>
 	void Draw() override;
 
@@ -45,6 +45,11 @@ public:
 	/// </summary>
 	void Finalize();
 
+	/// <summary>
+	/// 使い回すときのリセット (モデルやコライダーは作り直さず、出現ごとの状態だけ初期値に戻す)
+	/// </summary>
+	void Reset();
+
 	/// <summary>
 	/// ImGui表示
 	/// </summary>
@@ -110,6 +115,12 @@ public:
 	/// <returns></returns>
 	bool IsDead() { return isDead; }
 
+	/// <summary>
+	/// 敵の種類のゲッター
+	/// </summary>
+	/// <returns></returns>
+	EnemyType GetEnemyType() const { return enemyType_; }
+
 ///-------------------------------------------/// 
 /// メンバ変数
 ///-------------------------------------------///
@@ -1,94 +0,0 @@
-#pragma once
-
-#include "Model/Model.h"
-#include "Object/Object3d.h"
-#include "Collision/Basecharacter.h"
-#include "Collision/CollisionManager.h"
-#include "Particle/ParticleEmitter.h"
-#include "Data/Transform.h"
-
-#include <memory>
-
-/// ===== 弾 ===== ///
-class EnemyBullet : public BaseCharacter {
-
-///-------------------------------------------/// 
-/// メンバ関数
-///-------------------------------------------///
-public:
-
-	/// <summary>
-	/// 初期化
-	/// </summary>
-	void Initialize() override;
-
-	/// <summary>
-	/// 更新
-	/// </summary>
-	void Update() override;
-
-	/// <summary>
-	/// 描画
-	/// </summary>
-	void Draw() override;
-
-	/// <summary>
-	/// 終了
-	/// </summary>
-	void Finalize();
-
-	/// <summary>
-	/// ImGui表示
-	/// </summary>
-	void ShowImGui();
-
-	/// <summary>
-	/// 死んだかどうかのフラグ
-	/// </summary>
-	/// <returns></returns>
-	bool IsDead() const { return isDead; }
-
-	/// <summary>
-	/// 衝突時の処理
-	/// </summary>
-	void OnCollision(Engine::Collider* other) override;
-
-///-------------------------------------------/// 
-/// セッター
-///-------------------------------------------///
-public:
-
-	/// <summary>
-	/// 速度のセッター
-	/// </summary>
-	/// <param name="velocity"></param>
-	void SetVelocity(Engine::Vector3 velocity) { this->velocity_ = velocity; }
-
-///-------------------------------------------/// 
-/// メンバ変数
-///-------------------------------------------///
-private:
-
-	// モデルのポインタ
-	std::unique_ptr<Engine::Model> model = nullptr;
-
-	// 3Dオブジェクトのポインタ
-	std::unique_ptr<Engine::Object3d> object = nullptr;
-
-	// 速度
-	Engine::Vector3 velocity_ = { 0.0f, 0.0f, 0.0f };
-
-	// 移動の速さ
-	float moveSpeed = 0.5f;
-
-	// 寿命<frm>
-	static const int32_t kLifeTime = 60 * 4;
-
-	// デスタイマー
-	int32_t deathTimer_ = kLifeTime;
-
-	bool isDead = false;
-
-	// エミッターのポインタ
-	std::unique_ptr<Engine::ParticleEmitter> particleEmitter = nullptr;
-};
\ No newline at end of file
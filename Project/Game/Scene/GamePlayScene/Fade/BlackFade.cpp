@@ -1,6 +1,7 @@
 #define NOMINMAX
 
 #include "BlackFade.h"
+#include "GameClock.h"
 
 #include <imgui.h>
 #include <algorithm>
@@ -31,7 +32,7 @@ void BlackFade::Update() {
 	if (isFading_) {
 
 		// タイマーを進める
-		fadeTimer_ += kDeltaTime;
+		fadeTimer_ += GameClock::GetDeltaTime();
 
 		// アルファ値を計算
 		alpha_ = std::min(fadeTimer_ / fadeDuration_, 1.0f);
@@ -1,6 +1,7 @@
 #define NOMINMAX
 
 #include "WhiteFade.h"
+#include "GameClock.h"
 
 #include <imgui.h>
 #include <algorithm>
@@ -31,7 +32,7 @@ void WhiteFade::Update() {
 	if (isFading_) {
 
 		// タイマーを進める
-		fadeTimer_ += kDeltaTime;
+		fadeTimer_ += GameClock::GetDeltaTime();
 
 		// 進行度を計算（0.0f ～ 1.0f）
 		float t = std::clamp(fadeTimer_ / fadeDuration_, 0.0f, 1.0f);
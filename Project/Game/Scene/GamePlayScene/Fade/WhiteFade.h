@@ -121,9 +121,6 @@ private:
 	// フェード完了フラグ
 	bool isFadeFinished_ = false;
 
-	// デルタタイム
-	const float kDeltaTime = 1.0f / 60.0f;
-
 	// フェードタイプ
 	FadeType fadeType_ = FadeType::In;
 };
@@ -26,6 +26,13 @@ public:
 	/// </summary>
 	void Draw();
 
+	/// <summary>
+	/// レンダーキューに描画パケットを積む (オブジェクトごと)
+	/// </summary>
+	/// <param name="renderQueue">レンダーキュー</param>
+	/// <param name="pipeline">パイプラインの番号</param>
+	void Submit(Engine::RenderQueue& renderQueue, uint32_t pipeline);
+
 	/// <summary>
 	/// 終了
 	/// </summary>
@@ -1,4 +1,5 @@
 #include "GamePlayScene.h"
+#include "DirectXUtility.h"
 #include "Input.h"
 #include "Texture/TextureManager.h"
 #include "Vector3.h"
@@ -9,20 +10,45 @@
 #include "Easing.h"
 #include "WinApp.h"
 
-#include "Sprite/SpriteRenderer.h"
 #include "Object/Object3dRenderer.h"
+#include "Light/LightManager.h"
 #include "Particle/ParticleRenderer.h"
 #include "LineManager.h"
+#include "AssetLoader.h"
+#include "WorldOrigin.h"
+#include "MathVector.h"
 
 #include <imgui.h>
 
 using namespace Engine;
+using namespace MathVector;
 using namespace Easing;
 
+void GamePlayScene::RequestAssets() {
+
+	// アセットローダーのインスタンス取得
+	AssetLoader* assetLoader = AssetLoader::GetInstance();
+
+	/// ===== モデルの読み込み要求 ===== ///
+
+	assetLoader->RequestModel("Player", "player.obj");
+	assetLoader->RequestModel("Cylinder", "cylinder.obj");
+	assetLoader->RequestModel("Floor", "floor.obj");
+	assetLoader->RequestModel("PlayerBullet", "PlayerBullet.obj");
+	assetLoader->RequestModel("Enemy", "enemy.obj");
+	assetLoader->RequestModel("Enemy", "Kamikaze.obj");
+	assetLoader->RequestModel("EnemyBullet", "EnemyBullet.obj");
+	assetLoader->RequestModel("Goal", "Goal.obj");
+	assetLoader->RequestModel("Gate", "Gate.obj");
+	assetLoader->RequestModel("Reticle", "Reticle.obj");
+}
+
 void GamePlayScene::Initialize() {
 
+	// ワールド原点をコースの始点に戻す (以降に生成するオブジェクトはここを基準にする)
+	WorldOrigin::Reset();
+
 	// インスタンス取得
-	spriteRenderer_ = SpriteRenderer::GetInstance();
 	object3dRenderer_ = Object3dRenderer::GetInstance();
 	particleRenderer_ = ParticleRenderer::GetInstance();
 	lineManager_ = LineManager::GetInstance();
@@ -43,9 +69,27 @@ void GamePlayScene::Initialize() {
 	particleManager_->SetCamera(camera_.get());
 	lineManager_->SetDefaultCamera(camera_.get());
 
+	// レンダーキューに描画設定を登録 (切り替えが必要なときだけ呼ばれる)
+	opaquePipeline_ = renderQueue_.RegisterPipeline([this]() { object3dRenderer_->SettingDrawingOpaque(); });
+	alphaPipeline_ = renderQueue_.RegisterPipeline([this]() { object3dRenderer_->SettingDrawingAlpha(); });
+	instancedPipeline_ = renderQueue_.RegisterPipeline([this]() { object3dRenderer_->SettingDrawingInstanced(); });
+	particlePipeline_ = renderQueue_.RegisterPipeline([this]() { particleRenderer_->SettingDrawing(); });
+
 	// 衝突マネージャの初期化
 	collisionManager_ = std::make_unique<Engine::CollisionManager>();
 
+	// 弾のシステムの生成&初期化
+	bulletSystem_ = std::make_unique<BulletSystem>();
+	bulletSystem_->Initialize(&registry_);
+
+	// 敵のプールの初期化 (レベルの読み込みで敵が出現するより前)
+	InitializeEnemyPools();
+
+	// レベルストリーマーの生成&初期化
+	levelStreamer_ = std::make_unique<LevelStreamer>();
+	levelStreamer_->SetLoadAhead(5); // ファークリップより先まで読み込む
+	levelStreamer_->Initialize("gamePlay.json"); // 床とシリンダーのコース (区間ごとのファイルに分けてある)
+
 	// プレイヤーの生成&初期化
 	player_ = std::make_unique<Player>();
 	player_->SetCamera(camera_.get());
@@ -56,14 +100,6 @@ void GamePlayScene::Initialize() {
 	// キャストし追従カメラの方を呼び出す
 	dynamic_cast<FollowCameraController*>(cameraController_.get())->SetPlayer(player_.get());
 
-	// フロアを生成
-	floor_ = std::make_unique<Floor>();
-	floor_->Initialize();
-
-	// シリンダーの生成
-	cylinder_ = std::make_unique<Cylinder>();
-	cylinder_->Initialize();
-
 	// ゴールの生成&初期化
 	goal_ = std::make_unique<Goal>();
 	goal_->Initialize();
@@ -112,21 +148,12 @@ void GamePlayScene::Update() {
 	// カメラコントローラの更新
 	cameraController_->Update();
 
-	// カメラの座標をフロアに設定
-	floor_->SetCameraTranslate(camera_->GetWorldPosition());
-
-	// フロアの更新
-	floor_->Update();
-
-	// カメラの座標をシリンダーに設定
-	cylinder_->SetCameraTranslate(camera_->GetWorldPosition());
-
-	// シリンダーの更新
-	cylinder_->Update();
-
 	// オリジンシフトの確認と実行
 	CheckOriginShift();
 
+	// プレイヤーのコース上の位置を中心にレベルの区間を読み込む
+	levelStreamer_->Update(WorldOrigin::ToCourse(player_->GetWorldTransform().GetWorldPosition()).z);
+
 	// 状態の更新
 	state_->Update();
 
@@ -149,56 +176,43 @@ void GamePlayScene::Update() {
 
 void GamePlayScene::DrawFiltered() {
 
-	/// === 3Dオブジェクトの描画準備 === ///
-	object3dRenderer_->SettingDrawingOpaque();
+	// 描画はオブジェクトごとにレンダーキューに積み、パス、描画設定、マテリアル、深度の順に並べてから実行する
 
-	//TODO: 全ての3Dオブジェクト個々の描画
+	/// === 不透明 === ///
 
-	// シリンダーの描画
-	cylinder_->Draw();
+	// レベル(床とシリンダー)のオブジェクトを積む
+	levelStreamer_->Submit(renderQueue_, RenderQueue::Pass::Opaque, opaquePipeline_);
 
-	// フロアの描画
-	floor_->Draw();
+	// プレイヤーのオブジェクトを積む
+	player_->Submit(renderQueue_, opaquePipeline_);
 
-	// 敵描画
-	for (std::unique_ptr<Enemy>& enemy : enemies_) {
+	// 敵、敵の弾、弾はインスタンス描画に登録
+	for (Enemy* enemy : enemies_) {
 
 		enemy->Draw();
 	}
 
-	// 敵の弾の描画
-	for (std::unique_ptr<EnemyBullet>& bullet : enemyBullets_) {
+	bulletSystem_->Draw();
 
-		bullet->Draw();
-	}
-
-	// 弾の描画
-	for (std::unique_ptr<Bullet>& bullet : playerBullets_) {
-
-		bullet->Draw();
-	}
+	// 敵と弾をモデルごとのまとまりとして積む
+	object3dRenderer_->SubmitInstanced(renderQueue_, RenderQueue::Pass::Opaque, instancedPipeline_);
 
-	// プレイヤー描画
-	player_->Draw();
+	/// === 半透明 === ///
 
-	/// === 半透明オブジェクトの描画準備 === ///
-	object3dRenderer_->SettingDrawingAlpha();
+	// ゴールのオブジェクトを積む (奥から手前に並ぶ)
+	goal_->Submit(renderQueue_, alphaPipeline_);
 
-	// ゴールの描画
-	goal_->Draw();
+	/// === エフェクト === ///
 
-	/// === パーティクルの描画準備 === ///
-	particleRenderer_->SettingDrawing();
+	// パーティクルをグループごとに積む
+	particleManager_->Submit(renderQueue_, RenderQueue::Pass::Effect, particlePipeline_);
 
-	// パーティクルシステムの描画
-	particleManager_->Draw();
+	// 並べ替えて、不透明、半透明、エフェクトを別々のコマンドリストに並列で記録する
+	renderQueue_.Execute(&DirectXUtility::GetInstance()->GetCommandRecorder());
 }
 
 void GamePlayScene::DrawUnfiltered() {
 
-	/// === UIの描画準備 === ///
-	spriteRenderer_->SettingDrawing();
-
 	// TODO: 全てのスプライト個々の描画
 
 	// ルールUIの描画
@@ -229,13 +243,16 @@ void GamePlayScene::DrawUnfiltered() {
 void GamePlayScene::Finalize() {
 
 	// 敵の解放
-	for (std::unique_ptr<Enemy>& enemy : enemies_) {
+	for (Enemy* enemy : enemies_) {
 
 		enemy->Finalize();
 	}
 
 	// プレイヤーの解放
 	player_->Finalize();
+
+	// レベルの解放
+	levelStreamer_->Finalize();
 }
 
 void GamePlayScene::ShowImGui() {
@@ -248,15 +265,11 @@ void GamePlayScene::ShowImGui() {
 
 	player_->ShowImGui();
 
-	for (std::unique_ptr<Enemy>& enemy : enemies_) { enemy->ShowImGui(); }
-
-	for (std::unique_ptr<Bullet>& bullet : playerBullets_) { bullet->ShowImGui(); }
-
-	for (std::unique_ptr<EnemyBullet>& bullet : enemyBullets_) { bullet->ShowImGui(); }
+	for (Enemy* enemy : enemies_) { enemy->ShowImGui(); }
 
-	floor_->ShowImGui();
+	ShowEnemyPoolsImGui();
 
-	cylinder_->ShowImGui();
+	bulletSystem_->ShowImGui();
 
 	ruleUI_->ShowImGui();
 
@@ -269,6 +282,15 @@ void GamePlayScene::ShowImGui() {
 	whiteFade_->ShowImGui();
 
 	goal_->ShowImGui();
+
+	levelStreamer_->ShowImGui();
+
+	renderQueue_.ShowImGui();
+
+	object3dRenderer_->GetCuller().ShowImGui();
+
+	// ライト
+	LightManager::GetInstance()->ShowImGui();
 }
 
 void GamePlayScene::CheckAllCollisions() {
@@ -279,17 +301,15 @@ void GamePlayScene::CheckAllCollisions() {
 	// コライダーをリストに追加
 	collisionManager_->AddCollider(player_->GetCollider());
 
-	for (std::unique_ptr<Enemy>& enemy : enemies_) {
+	for (Enemy* enemy : enemies_) {
 		collisionManager_->AddCollider(enemy->GetCollider());
 	}
 
-	for (std::unique_ptr<Bullet>& bullet : playerBullets_) {
-		collisionManager_->AddCollider(bullet->GetCollider());
-	}
+	// 自機の弾と敵の弾
+	bulletSystem_->CollectColliders(collisionManager_.get());
 
-	for (std::unique_ptr<EnemyBullet>& bullet : enemyBullets_) {
-		collisionManager_->AddCollider(bullet->GetCollider());
-	}
+	// レベルに配置されたコライダー
+	levelStreamer_->CollectColliders(collisionManager_.get());
 
 	// 衝突判定と応答
 	collisionManager_->CheckAllCollisions();
@@ -304,16 +324,16 @@ void GamePlayScene::ChangeState(std::unique_ptr<IPlayState> newState) {
 	state_->Initialize(this);
 }
 
-void GamePlayScene::AddPlayerBullet(std::unique_ptr<Bullet> bullet) {
+void GamePlayScene::AddPlayerBullet(const Vector3& position, const Vector3& direction, bool isLockedOn) {
 
-	// 弾をリストに登録
-	playerBullets_.push_back(std::move(bullet));
+	// 弾のシステムに生成を予約 (次の弾の更新から動く)
+	bulletSystem_->SpawnPlayerBullet(position, direction, isLockedOn);
 }
 
-void GamePlayScene::AddEnemyBullet(std::unique_ptr<EnemyBullet> bullet) {
+void GamePlayScene::AddEnemyBullet(const Vector3& position, const Vector3& direction) {
 
-	// 弾をリストに登録
-	enemyBullets_.push_back(std::move(bullet));
+	// 弾のシステムに生成を予約 (次の弾の更新から動く)
+	bulletSystem_->SpawnEnemyBullet(position, direction);
 }
 
 void GamePlayScene::LoadEnemyPopData() {
@@ -384,15 +404,10 @@ void GamePlayScene::UpdateEnemyPopCommands() {
 			getline(line_stream, word, ',');
 			type = std::atoi(word.c_str()); // 数字に変換
 
-			// 敵の生成&初期化
-			std::unique_ptr<Enemy> enemy = std::make_unique<Enemy>();
-			enemy->SetEnemyType(static_cast<EnemyType>(type));
-			enemy->Initialize();
-			enemy->GetWorldTransform().SetTranslate({ x, y, z });
-			enemy->SetGamePlayScene(this);
-
-			// 敵をリストに追加
-			enemies_.push_back(std::move(enemy));
+			// 敵の出現 (プールに空きがなければ出さない)
+			if (Enemy* enemy = SpawnEnemy(static_cast<EnemyType>(type))) {
+				enemy->GetWorldTransform().SetTranslate({ x, y, z });
+			}
 
 		} // WAITコマンド
 		else if (word.find("WAIT") == 0) {
@@ -414,43 +429,37 @@ void GamePlayScene::UpdateEnemyPopCommands() {
 
 void GamePlayScene::UpdateListObjects() {
 
-	// デスフラグの立った敵を削除
-	for (auto ite = enemies_.begin(); ite != enemies_.end(); ) {
+	// これより後ろに取り残された敵は削除する
+	float despawnZ = player_->GetWorldTransform().GetTranslate().z - kDespawnDistance;
 
-		if ((*ite)->IsDead()) {
+	// デスフラグの立った敵と取り残された敵をプールに戻す
+	for (size_t i = 0; i < enemies_.size(); ) {
 
-			// 敵を削除
-			ite = enemies_.erase(ite);
+		Enemy* enemy = enemies_[i];
+
+		if (enemy->IsDead() || enemy->GetWorldTransform().GetTranslate().z < despawnZ) {
+
+			// 種類ごとのプールに戻し、末尾の敵で穴を埋める
+			ObjectPool<Enemy>& pool = enemy->GetEnemyType() == EnemyType::Kamikaze ? kamikazeEnemyPool_ : normalEnemyPool_;
+			pool.Release(enemy);
+			enemies_[i] = enemies_.back();
+			enemies_.pop_back();
 		}
 		else {
 
 			// プレイヤーを敵にセット
-			(*ite)->SetPlayer(player_.get());
+			enemy->SetPlayer(player_.get());
 
 			// 敵更新
-			(*ite)->Update();
+			enemy->Update();
 
 			// 次の敵へ
-			++ite;
+			++i;
 		}
 	}
 
-	// デスフラグが立った弾を削除
-	playerBullets_.remove_if([](std::unique_ptr<Bullet>& bullet) {return bullet->IsDead(); });
-
-	// 弾の更新
-	for (std::unique_ptr<Bullet>& bullet : playerBullets_) {
-
-		bullet->Update();
-	}
-
-	// デスフラグが立った敵の弾を削除
-	enemyBullets_.remove_if([](std::unique_ptr<EnemyBullet>& bullet) {return bullet->IsDead(); });
-
-	// 敵の弾の更新
-	for (std::unique_ptr<EnemyBullet>& bullet : enemyBullets_) {
-		bullet->Update();
-	}
+	// 自機の弾と敵の弾の更新 (消えた弾の削除と、このステップで撃った弾の追加もここで行う)
+	bulletSystem_->Update();
 }
 
 void GamePlayScene::OnPlayerDamaged(uint16_t currentHP) {
@@ -493,9 +502,16 @@ void GamePlayScene::Restart() {
 
 	/// ===== オブジェクトのクリア ===== ///
 
+	normalEnemyPool_.ReleaseAll();
+	kamikazeEnemyPool_.ReleaseAll();
 	enemies_.clear();
-	playerBullets_.clear();
-	enemyBullets_.clear();
+	bulletSystem_->Clear();
+
+	/// ===== コースのリセット ===== ///
+
+	// ワールド原点を始点に戻してレベルを作り直す
+	WorldOrigin::Reset();
+	levelStreamer_->Reset();
 
 	/// ===== 進行度のリセット ===== ///
 
@@ -538,33 +554,63 @@ void GamePlayScene::CheckOriginShift() {
 	// プレイヤーのZ座標がループ距離を超えたら
 	if (playerZ >= kLoopDistance) {
 
-		// ワールドを手前にずらす
-		ShiftWorld(kLoopDistance);
+		// ワールド原点を奥にずらす (追従するオブジェクトは次に触れたときに手前に来る)
+		WorldOrigin::Shift({ 0.0f, 0.0f, kLoopDistance });
 	}
 }
 
-void GamePlayScene::ShiftWorld(float shiftZ) {
+void GamePlayScene::InitializeEnemyPools() {
 
-	// カメラを手前にずらす
-	cameraController_->GetWorldTransform().AddTranslate({ 0.0f, 0.0f, -shiftZ });
+	// 作ったときに種類ごとのモデル、コライダー、エミッターを作る
+	normalEnemyPool_.Initialize(kNormalEnemyPoolCapacity, [this](Enemy& enemy) {
+		enemy.SetEnemyType(EnemyType::Normal);
+		enemy.Initialize();
+		enemy.SetGamePlayScene(this);
+	});
 
-	// プレイヤーを手前にずらす
-	player_->GetWorldTransform().AddTranslate({ 0.0f, 0.0f, -shiftZ });
+	kamikazeEnemyPool_.Initialize(kKamikazeEnemyPoolCapacity, [this](Enemy& enemy) {
+		enemy.SetEnemyType(EnemyType::Kamikaze);
+		enemy.Initialize();
+		enemy.SetGamePlayScene(this);
+	});
 
-	// 敵を手前にずらす
-	for (std::unique_ptr<Enemy>& enemy : enemies_) {
-		enemy->GetWorldTransform().AddTranslate({ 0.0f, 0.0f, -shiftZ });
-	}
+	// 取り出したときは前に出現したときの状態をリセットする
+	normalEnemyPool_.SetOnAcquire([](Enemy& enemy) { enemy.Reset(); });
+	kamikazeEnemyPool_.SetOnAcquire([](Enemy& enemy) { enemy.Reset(); });
 
-	// 弾を手前にずらす
-	for (std::unique_ptr<Bullet>& bullet : playerBullets_) {
-		bullet->GetWorldTransform().AddTranslate({ 0.0f, 0.0f, -shiftZ });
-	}
-	for (std::unique_ptr<EnemyBullet>& bullet : enemyBullets_) {
-		bullet->GetWorldTransform().AddTranslate({ 0.0f, 0.0f, -shiftZ });
+	// 出現中のリストも全て入る分を確保しておく
+	enemies_.reserve(kNormalEnemyPoolCapacity + kKamikazeEnemyPoolCapacity);
+}
+
+Enemy* GamePlayScene::SpawnEnemy(EnemyType type) {
+
+	// 種類ごとのプールから取り出す
+	ObjectPool<Enemy>& pool = type == EnemyType::Kamikaze ? kamikazeEnemyPool_ : normalEnemyPool_;
+	Enemy* enemy = pool.Acquire();
+	if (!enemy) {
+		return nullptr;
 	}
 
-	// ゴールを手前にずらす
-	goal_->GetWorldTransform().AddTranslate({ 0.0f, 0.0f, -shiftZ });
-	goal_->GetGateWorldTransform().AddTranslate({ 0.0f, 0.0f, -shiftZ });
+	// 出現中のリストに追加
+	enemies_.push_back(enemy);
+
+	return enemy;
 }
+
+void GamePlayScene::ShowEnemyPoolsImGui() {
+
+#ifdef USE_IMGUI
+
+	ImGui::Begin("EnemyPools");
+
+	// 出現中の数、最大数、空きがなくて出せなかった回数 (容量の調整に使う)
+	const char* names[] = { "Normal", "Kamikaze" };
+	const ObjectPool<Enemy>* pools[] = { &normalEnemyPool_, &kamikazeEnemyPool_ };
+	for (size_t i = 0; i < std::size(pools); i++) {
+		ImGui::Text("%s: %u / %u (Peak %u, Exhausted %u)", names[i], pools[i]->GetActiveCount(), pools[i]->GetCapacity(), pools[i]->GetPeakActiveCount(), pools[i]->GetExhaustedCount());
+	}
+
+	ImGui::End();
+
+#endif // USE_IMGUI
+}
\ No newline at end of file
@@ -4,13 +4,10 @@
 #include "Collision/CollisionManager.h"
 #include "Particle/ParticleManager.h"
 #include "Player/Player.h"
-#include "Player/Bullet.h"
+#include "Bullet/BulletSystem.h"
 #include "Enemy/Enemy.h"
-#include "Enemy/EnemyBullet.h"
 #include "Camera.h"
 #include "CameraControll/ICameraController.h"
-#include "Floor/Floor.h"
-#include "Cylinder/Cylinder.h"
 #include "UI/RuleUI.h"
 #include "UI/NormaUI.h"
 #include "UI/ResultUI.h"
@@ -18,17 +15,20 @@
 #include "Fade/whiteFade.h"
 #include "Fade/BlackFade.h"
 #include "Goal/Goal.h"
+#include "LevelStreamer.h"
+#include "RenderQueue.h"
+#include "EntityRegistry.h"
+#include "ObjectPool.h"
 
-#include <list>
 #include <sstream>
 #include <memory>
 #include <optional>
+#include <vector>
 
 /// ===== 前方宣言 ===== ///
 
 namespace Engine {
 
-	class SpriteRenderer;
 	class Object3dRenderer;
 	class ParticleRenderer;
 	class LineManager;
@@ -47,6 +47,11 @@ public:
 	/// </summary>
 	void Initialize() override;
 
+	/// <summary>
+	/// 使用するアセットの読み込み要求
+	/// </summary>
+	void RequestAssets() override;
+
 	/// <summary>
 	/// 更新
 	/// </summary>
@@ -86,14 +91,17 @@ public:
 	/// <summary>
 	/// 自機の弾の追加
 	/// </summary>
-	/// <param name="bullet"></param>
-	void AddPlayerBullet(std::unique_ptr<Bullet> bullet);
+	/// <param name="position">発射位置</param>
+	/// <param name="direction">向き (正規化済み)</param>
+	/// <param name="isLockedOn">ロックオンでの射撃か</param>
+	void AddPlayerBullet(const Engine::Vector3& position, const Engine::Vector3& direction, bool isLockedOn = false);
 
 	/// <summary>
 	/// 敵の弾の追加
 	/// </summary>
-	/// <param name="bullet"></param>
-	void AddEnemyBullet(std::unique_ptr<EnemyBullet> bullet);
+	/// <param name="position">発射位置</param>
+	/// <param name="direction">向き (正規化済み)</param>
+	void AddEnemyBullet(const Engine::Vector3& position, const Engine::Vector3& direction);
 
 	/// <summary>
 	/// 敵発生データの読み込み
@@ -147,10 +155,21 @@ private:
 	void CheckOriginShift();
 
 	/// <summary>
-	/// オブジェクトを手前にずらす
+	/// 敵のプールの初期化 (全ての敵のモデルとコライダーをここで作っておく)
+	/// </summary>
+	void InitializeEnemyPools();
+
+	/// <summary>
+	/// 敵の出現 (種類ごとのプールから取り出して出現中のリストに加える)
+	/// </summary>
+	/// <param name="type">敵の種類</param>
+	/// <returns>敵 (プールに空きがなければnullptr)</returns>
+	Enemy* SpawnEnemy(EnemyType type);
+
+	/// <summary>
+	/// 敵のプールのImGui表示
 	/// </summary>
-	/// <param name="shiftZ">手前にずらす量</param>
-	void ShiftWorld(float shiftZ);
+	void ShowEnemyPoolsImGui();
 
 ///-------------------------------------------/// 
 /// ゲッター
@@ -177,7 +196,7 @@ public:
 
 	BlackFade* GetBlackFade() { return blackFade_.get(); }
 
-	const std::list<std::unique_ptr<Enemy>>& GetEnemies() const { return enemies_; }
+	const std::vector<Enemy*>& GetEnemies() const { return enemies_; }
 
 ///-------------------------------------------/// 
 /// メンバ変数
@@ -201,6 +220,15 @@ private:
 	// ループする距離
 	const float kLoopDistance = 1000.0f;
 
+	// プレイヤーより後ろに取り残された敵を消す距離
+	const float kDespawnDistance = 100.0f;
+
+	// 通常の敵のプールの容量 (同時に出現する数の上限)
+	const uint32_t kNormalEnemyPoolCapacity = 48;
+
+	// 特攻する敵のプールの容量
+	const uint32_t kKamikazeEnemyPoolCapacity = 16;
+
 	/// ===== オブジェクト ===== ///
 
 	// カメラコントローラのポインタ
@@ -209,20 +237,20 @@ private:
 	// プレイヤーのポインタ
 	std::unique_ptr<Player> player_ = nullptr;
 
-	// 敵のリスト
-	std::list<std::unique_ptr<Enemy>> enemies_;
+	// 出現中の敵のリスト (プールから借りている)
+	std::vector<Enemy*> enemies_;
 
-	// 自機の弾のリスト
-	std::list<std::unique_ptr<Bullet>> playerBullets_;
+	// 通常の敵のプール
+	Engine::ObjectPool<Enemy> normalEnemyPool_;
 
-	// 敵の弾のリスト
-	std::list<std::unique_ptr<EnemyBullet>> enemyBullets_;
+	// 特攻する敵のプール
+	Engine::ObjectPool<Enemy> kamikazeEnemyPool_;
 
-	// フロアのポインタ
-	std::unique_ptr<Floor> floor_ = nullptr;
+	// 数の多いオブジェクトのエンティティとコンポーネント
+	Engine::EntityRegistry registry_;
 
-	// シリンダーのポインタ
-	std::unique_ptr<Cylinder> cylinder_ = nullptr;
+	// 弾のシステム (自機の弾と敵の弾)
+	std::unique_ptr<BulletSystem> bulletSystem_ = nullptr;
 
 	// ゴールのポインタ
 	std::unique_ptr<Goal> goal_ = nullptr;
@@ -255,12 +283,21 @@ private:
 	// 衝突マネージャのポインタ
 	std::unique_ptr<Engine::CollisionManager> collisionManager_ = nullptr;
 
+	// レベルストリーマーのポインタ
+	std::unique_ptr<Engine::LevelStreamer> levelStreamer_ = nullptr;
+
+	// レンダーキュー
+	Engine::RenderQueue renderQueue_;
+
+	// レンダーキューに登録したパイプラインの番号
+	uint32_t opaquePipeline_ = 0;
+	uint32_t alphaPipeline_ = 0;
+	uint32_t instancedPipeline_ = 0;
+	uint32_t particlePipeline_ = 0;
+
 	// パーティクルマネージャのインスタンス
 	Engine::ParticleManager* particleManager_ = Engine::ParticleManager::GetInstance();
 
-	// スプライトレンダラーのインスタンス
-	Engine::SpriteRenderer* spriteRenderer_ = nullptr;
-
 	// 3Dオブジェクトレンダラーのインスタンス
 	Engine::Object3dRenderer* object3dRenderer_ = nullptr;
 
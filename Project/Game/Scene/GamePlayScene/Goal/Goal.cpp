@@ -13,6 +13,7 @@ void Goal::Initialize() {
 
 	// ワールド変換の初期化
 	worldTransform_.Initialize();
+	worldTransform_.SetOriginRelative(true);
 	worldTransform_.SetTranslate({ 0.0f, 0.0f, 1700.0f });
 
 	// モデルの生成・初期化
@@ -30,6 +31,7 @@ void Goal::Initialize() {
 
 	// ゲート用のワールド変換の初期化
 	gateWorldTransform_.Initialize();
+	gateWorldTransform_.SetOriginRelative(true);
 	gateWorldTransform_.SetTranslate({ 0.0f, 0.0f, 1650.0f });
 
 	// ゲート用のモデルの生成・初期化
@@ -116,6 +118,19 @@ void Goal::Draw() {
 	}
 }
 
+void Goal::Submit(RenderQueue& renderQueue, uint32_t pipeline) {
+
+	// 3Dオブジェクトを積む
+	object_->Submit(renderQueue, RenderQueue::Pass::Transparent, pipeline);
+
+	// アルファ値が0.0fより大きい場合
+	if (alpha_ > 0.0f) {
+
+		// ゲート用の3Dオブジェクトを積む
+		gateObject_->Submit(renderQueue, RenderQueue::Pass::Transparent, pipeline);
+	}
+}
+
 void Goal::Finalize() {
 }
 
@@ -21,6 +21,13 @@ public:
 
 	void Draw();
 
+	/// <summary>
+	/// レンダーキューに半透明の描画パケットを積む (オブジェクトごとに奥から手前に並ぶ)
+	/// </summary>
+	/// <param name="renderQueue">レンダーキュー</param>
+	/// <param name="pipeline">パイプラインの番号</param>
+	void Submit(Engine::RenderQueue& renderQueue, uint32_t pipeline);
+
 	void Finalize();
 
 	void ShowImGui();
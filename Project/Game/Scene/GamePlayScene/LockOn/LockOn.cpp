@@ -5,6 +5,7 @@
 #include "Reticle/Reticle.h"
 #include "MathVector.h"
 
+#include <algorithm>
 #include <imgui.h>
 
 using namespace Engine;
@@ -55,7 +56,7 @@ void LockOn::Draw() {
 	}
 }
 
-void LockOn::SearchTarget(const std::list<std::unique_ptr<Enemy>>& enemies) {
+void LockOn::SearchTarget(const std::vector<Enemy*>& enemies) {
 
 	// 自機からワールド座標を取得
 	Vector3 playerPos = player_->GetWorldTransform().GetWorldPosition();
@@ -70,8 +71,9 @@ void LockOn::SearchTarget(const std::list<std::unique_ptr<Enemy>>& enemies) {
 
 	if (target_) {
 
-		// ターゲットが生きていたら
-		if (!target_->IsDead()) {
+		// ターゲットがまだ出現中で生きていたら (消えた敵はプールに戻って使い回される)
+		bool isSpawned = std::find(enemies.begin(), enemies.end(), target_) != enemies.end();
+		if (isSpawned && !target_->IsDead()) {
 
 			// ターゲットのワールド座標を取得
 			Vector3 targetPos = target_->GetWorldTransform().GetWorldPosition();
@@ -107,7 +109,7 @@ void LockOn::SearchTarget(const std::list<std::unique_ptr<Enemy>>& enemies) {
 	float closestDistance = FLT_MAX;
 
 	// ロックオン対象を探索する
-	for (const auto& enemy : enemies) {
+	for (Enemy* enemy : enemies) {
 
 		/// ===== 死んでいる敵 ===== ///
 
@@ -143,7 +145,7 @@ void LockOn::SearchTarget(const std::list<std::unique_ptr<Enemy>>& enemies) {
 
 			// 最も近い敵を更新
 			closestDistance = distanceToEnemy;
-			newTarget = enemy.get();
+			newTarget = enemy;
 		}
 	}
 
@@ -3,6 +3,7 @@
 #include "Sprite/Sprite.h"
 
 #include <memory>
+#include <vector>
 
 /// === 前方宣言 === ///
 class Enemy;
@@ -38,8 +39,8 @@ public:
 	/// <summary>
 	/// ターゲットの探索
 	/// </summary>
-	/// <param name="enemies">敵のリスト</param>
-	void SearchTarget(const std::list<std::unique_ptr<Enemy>>& enemies);
+	/// <param name="enemies">出現中の敵のリスト</param>
+	void SearchTarget(const std::vector<Enemy*>& enemies);
 
 	/// <summary>
 	/// ターゲットのクリア
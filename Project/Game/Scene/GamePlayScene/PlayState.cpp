@@ -6,6 +6,7 @@
 #include "Easing.h"
 #include "WinApp.h"
 #include "Input.h"
+#include "GameClock.h"
 
 #include <algorithm>
 
@@ -62,7 +63,7 @@ void IntroState::Update() {
 	// タイマーの更新
 	if (decelerationTimer_ < kDecelerationDuration) {
 
-		decelerationTimer_ += 1.0f / 60.0f;
+		decelerationTimer_ += GameClock::GetDeltaTime();
 	}
 	else {
 
@@ -200,7 +201,7 @@ void PlayState::Update() {
 	guideUI_->Update();
 
 	// パーティクルマネージャの更新
-	ParticleManager::GetInstance()->Update();
+	ParticleManager::GetInstance()->Update(GameClock::GetDeltaTime());
 
 	/// ===== 衝突判定の処理 ===== ///
 
@@ -307,7 +308,7 @@ void PlayState::UpdateVignetteEffect() {
 	if (isDamageVignetteActive_) {
 
 		// タイマー更新
-		damageVignetteTimer_ += 1.0f / 60.0f; // 60FPS換算
+		damageVignetteTimer_ += GameClock::GetDeltaTime();
 
 		// 線形補間で徐々にフェードアウト
 		float t = damageVignetteTimer_ / kDamageVignetteDuration_;
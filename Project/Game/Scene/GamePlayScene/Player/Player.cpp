@@ -6,6 +6,7 @@
 #include "Collision/CollisionTypeIDDef.h"
 #include "MathVector.h"
 #include "Easing.h"
+#include "GameClock.h"
 
 #include <algorithm>
 #include <imgui.h>
@@ -161,6 +162,18 @@ void Player::Draw() {
 	// reticle_->Draw3D();
 }
 
+void Player::Submit(RenderQueue& renderQueue, uint32_t pipeline) {
+
+	// コライダーの描画 (線描画マネージャに積むだけ)
+	collider_->Draw();
+
+	if (!isGroundHit_) {
+
+		// 3Dオブジェクトを不透明のパケットとして積む
+		object->Submit(renderQueue, RenderQueue::Pass::Opaque, pipeline);
+	}
+}
+
 void Player::DrawUI() {
 
 	reticle_->Draw2D();
@@ -292,7 +305,7 @@ void Player::Fire(PlayerContext context) {
 void Player::FireAnimationUpdate() {
 
 	// デルタタイム分デクリメント
-	fireAnimationTimer_ -= 1.0f / 60.0f;
+	fireAnimationTimer_ -= GameClock::GetDeltaTime();
 
 	float t = 1.0f - (fireAnimationTimer_ / kFireAnimationDuration_); // 経過割合を計算
 	float easedT = EaseOutCubic(t); // イージング適用
@@ -317,7 +330,7 @@ void Player::Rolling() {
 	/// ===== タイマー処理 ===== ///
 
 	// タイマーを進める
-	rollTimer_ += 1.0f / 60.0f; // デルタタイム加算
+	rollTimer_ += GameClock::GetDeltaTime(); // デルタタイム加算
 
 	// 進行度を計算
 	float t = rollTimer_ / rollDuration_;
@@ -508,7 +521,7 @@ void Player::ManualUpdate() {
 
 	// タイマー更新
 	if (fireTimer_ > 0.0f) {
-		fireTimer_ -= 1.0f / 60.0f;
+		fireTimer_ -= GameClock::GetDeltaTime();
 	}
 
 	// 速度をリセット
@@ -533,7 +546,7 @@ void Player::ManualUpdate() {
 	if (isMouseLeftPush) {
 
 		// 押されている時間を加算
-		pressTimer_ += 1.0f / 60.0f;
+		pressTimer_ += GameClock::GetDeltaTime();
 
 		// 一定時間以上押し続けたら
 		if (pressTimer_ > kLockOnDuration_) {
@@ -604,7 +617,7 @@ void Player::ManualUpdate() {
 	else {
 
 		// タイマーをデクリメント
-		rollCooldownTimer_ -= 1.0f / 60.0f;
+		rollCooldownTimer_ -= GameClock::GetDeltaTime();
 	}
 
 	// バレルロール処理
@@ -652,7 +665,7 @@ void Player::DeadInitialize() {
 void Player::DeadUpdate() {
 
 	// タイマーを進める
-	deathTimer_ += 1.0f / 60.0f; // デルタタイム加算
+	deathTimer_ += GameClock::GetDeltaTime(); // デルタタイム加算
 
 	// 回転速度の加算
 	deathRotateVelocity_.x += kRollAcceleration;
@@ -51,6 +51,13 @@ public:
 	/// </summary>
 	void Draw() override;
 
+	/// <summary>
+	/// レンダーキューに描画パケットを積む (オブジェクトごと)
+	/// </summary>
+	/// <param name="renderQueue">レンダーキュー</param>
+	/// <param name="pipeline">パイプラインの番号</param>
+	void Submit(Engine::RenderQueue& renderQueue, uint32_t pipeline);
+
 	/// <summary>
 	/// Ui描画
 	/// </summary>
@@ -3,7 +3,6 @@
 #include "Reticle/Reticle.h"
 #include "LockOn/LockOn.h"
 #include "GamePlayScene.h"
-#include "Bullet.h"
 #include "MathVector.h"
 
 using namespace Engine;
@@ -17,24 +16,14 @@ void NormalShotCommand::Execute(const PlayerContext& context) {
 	// レティクルの位置を取得
 	Vector3 reticlePos = context.reticle->GetWorldTransform().GetWorldPosition();
 
-	// 弾の生成&初期化
-	std::unique_ptr<Bullet> bullet = std::make_unique<Bullet>();
-	bullet->Initialize();
-
-	// 弾の位初期置をプレイヤーの位置に設定
-	bullet->GetWorldTransform().SetTranslate(playerPos);
-
 	// 方向ベクトルを計算
 	Vector3 direction = reticlePos - playerPos;
 
 	// 正規化
 	direction = Normalize(direction);
 
-	// 弾の方向を設定
-	bullet->SetDirection(direction);
-
-	// ゲームプレイシーンの弾をリストに登録
-	context.scene->AddPlayerBullet(std::move(bullet));
+	// プレイヤーの位置から弾を撃つ
+	context.scene->AddPlayerBullet(playerPos, direction);
 }
 
 void LockOnAimCommand::Execute(const PlayerContext& context) {
@@ -64,27 +53,14 @@ void LockOnShotCommand::Execute(const PlayerContext& context) {
 		targetPos = context.reticle->GetWorldTransform().GetWorldPosition();
 	}
 
-	// 弾の生成&初期化
-	std::unique_ptr<Bullet> bullet = std::make_unique<Bullet>();
-	bullet->Initialize();
-
-	// 弾の位初期置をプレイヤーの位置に設定
-	bullet->GetWorldTransform().SetTranslate(playerPos);
-
 	// 方向ベクトルを計算
 	Vector3 direction = targetPos - playerPos;
 
 	// 正規化
 	direction = Normalize(direction);
 
-	// 弾の方向を設定
-	bullet->SetDirection(direction);
-
-	// ロックオンショットのフラグを設定
-	bullet->SetIsLockOn(true);
-
-	// ゲームプレイシーンの弾をリストに登録
-	context.scene->AddPlayerBullet(std::move(bullet));
+	// プレイヤーの位置からロックオンショットの弾を撃つ
+	context.scene->AddPlayerBullet(playerPos, direction, true);
 }
 
 void BarrelRollCommand::Execute(const PlayerContext& context) {
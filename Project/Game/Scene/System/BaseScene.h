@@ -18,6 +18,11 @@ public:
 	/// </summary>
 	virtual void Initialize() = 0;
 
+	/// <summary>
+	/// 使用するアセットの読み込み要求 (遷移の演出中に先読みされる)
+	/// </summary>
+	virtual void RequestAssets() {}
+
 	/// <summary>
 	/// 更新
 	/// </summary>
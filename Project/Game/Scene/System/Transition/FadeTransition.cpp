@@ -1,5 +1,4 @@
 #include "FadeTransition.h"
-#include "Sprite/SpriteRenderer.h"
 #include "Easing.h"
 
 using namespace Engine;
@@ -12,9 +11,6 @@ FadeTransition::FadeTransition(Vector3 color, float startAlpha, float endAlpha)
 	startAlpha_ = startAlpha;
 	endAlpha_ = endAlpha;
 
-	// スプライトレンダラーのインスタンス取得
-	spriteRenderer_ = SpriteRenderer::GetInstance();
-
 	// スプライトの初期化
 	sprite_ = std::make_unique<Sprite>();
 	sprite_->Initialize("White1x1.png");
@@ -38,9 +34,6 @@ void FadeTransition::Update(float progress) {
 
 void FadeTransition::Draw() {
 
-	// スプライトの描画設定
-	spriteRenderer_->SettingDrawing();
-
 	// スプライトの描画
 	sprite_->Draw();
 }
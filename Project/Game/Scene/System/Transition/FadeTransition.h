@@ -7,13 +7,6 @@
 
 #include <memory>
 
-namespace Engine {
-
-	/// ========== 前方宣言 ========== ///
-
-	class SpriteRenderer;
-}
-
 /// <summary>
 /// フェード遷移クラス
 /// </summary>
@@ -64,8 +57,5 @@ private:
 
 	// スプライト
 	std::unique_ptr<Engine::Sprite> sprite_ = nullptr;
-
-	// スプライトレンダラーのポインタ
-	Engine::SpriteRenderer* spriteRenderer_ = nullptr;
 };
 
@@ -1,5 +1,4 @@
 #include "SlideTransition.h"
-#include "Sprite/SpriteRenderer.h"
 #include "Easing.h"
 
 using namespace Engine;
@@ -9,9 +8,6 @@ SlideTransition::SlideTransition( Vector2 endPosition ) {
 
 	endPosition_ = endPosition;
 
-	// スプライトレンダラーのインスタンス取得
-	spriteRenderer_ = SpriteRenderer::GetInstance();
-
 	// スプライトの初期化
 	sprite_ = std::make_unique<Sprite>();
 	sprite_->Initialize( "White1x1.png" );
@@ -33,9 +29,6 @@ void SlideTransition::Update( float progress ) {
 
 void SlideTransition::Draw() {
 
-	// スプライトの描画設定
-	spriteRenderer_->SettingDrawing();
-
 	// スプライトの描画
 	sprite_->Draw();
 }
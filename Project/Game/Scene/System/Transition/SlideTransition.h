@@ -6,13 +6,6 @@
 
 #include <memory>
 
-namespace Engine {
-	
-	/// ========== 前方宣言 ========== ///
-
-	class SpriteRenderer;
-}
-
 /// <summary>
 /// スライド遷移クラス
 /// </summary>
@@ -63,8 +56,5 @@ private:
 
 	// スプライト
 	std::unique_ptr<Engine::Sprite> sprite_ = nullptr;
-
-	// スプライトレンダラーのポインタ
-	Engine::SpriteRenderer* spriteRenderer_ = nullptr;
 };
 
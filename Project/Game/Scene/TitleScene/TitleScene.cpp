@@ -2,7 +2,6 @@
 #include "CameraControll/FollowCamera/FollowCameraController.h"
 #include "WinApp.h"
 
-#include "Sprite/SpriteRenderer.h"
 #include "Object/Object3dRenderer.h"
 
 #include <imgui.h>
@@ -12,7 +11,6 @@ using namespace Engine;
 void TitleScene::Initialize() {
 
 	// インスタンス取得
-	spriteRenderer_ = SpriteRenderer::GetInstance();
 	object3dRenderer_ = Object3dRenderer::GetInstance();
 
 	// カメラの生成&初期化
@@ -218,9 +216,6 @@ void TitleScene::DrawFiltered() {
 
 void TitleScene::DrawUnfiltered() {
 
-	/// === 2Dオブジェクトの描画準備(最前面) === ///
-	spriteRenderer_->SettingDrawing();
-
 	// スタートUIの描画
 	startUI_->Draw();
 
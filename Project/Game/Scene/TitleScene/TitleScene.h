@@ -20,7 +20,6 @@
 
 namespace Engine {
 
-    class SpriteRenderer;
 	class Object3dRenderer;
     class RadialBlurFilter;
 }
@@ -188,9 +187,6 @@ private:
     // ループさせる距離
 	const float kLoopDistance = 1000.0f;
 
-    // スプライトレンダラーのインスタンス
-    Engine::SpriteRenderer* spriteRenderer_ = nullptr;
-
 	// 3Dオブジェクトレンダラーのインスタンス
 	Engine::Object3dRenderer* object3dRenderer_ = nullptr;
 };
\ No newline at end of file
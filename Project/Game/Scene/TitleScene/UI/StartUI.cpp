@@ -1,4 +1,5 @@
 #include "StartUI.h"
+#include "GameClock.h"
 
 #include <numbers>
 
@@ -23,7 +24,7 @@ void StartUI::Initialize() {
 void StartUI::Update() {
 
 	// タイマーを進める
-	blinkTimer_ += 1.0f / 60.0f; // 60FPS想定
+	blinkTimer_ += GameClock::GetDeltaTime();
 
 	// θを計算
 	const float theta = (blinkTimer_ / blinkCycle_) * 2.0f * std::numbers::pi_v<float>;
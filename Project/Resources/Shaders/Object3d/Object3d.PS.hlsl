@@ -13,44 +13,48 @@ struct DirectionalLight {
     float intensity; // 輝度
 };
 
-struct PointLight {
+// ローカルライト (点光源とスポットライト) LightManager::LocalLightと同じ並び
+struct LocalLight {
     float4 color; // 色
     float3 position; // 位置
     float intensity; // 輝度
+    float3 direction; // 向き (スポットライトのみ)
     float distance; // 光の届く最大距離
     float decay; // 減衰率
+    float cosAngle; // 余弦 (スポットライトのみ)
+    float cosFalloffStart; // Falloffの開始角度 (スポットライトのみ)
+    uint type; // 種類 0 : 点光源、1 : スポットライト
 };
 
-struct SpotLight {
-    float4 color; // 色
-    float3 position; // 位置
-    float3 direction; // 向き
-    float intensity; // 輝度
-    float distance; // 光の届く最大距離
-    float decay; // 減衰率
-    float cosAngle; // 余弦
-    float cosFalloffStart; // Falloffの開始角度
+// シーン全体で共通のライト LightManager::SceneLightと同じ並び
+struct SceneLight {
+    DirectionalLight directionalLight; // 平行光源
+    float3 cameraPosition; // カメラのワールド座標
+    float environmentIntensity; // 環境光の輝度
+    float4 viewDepthVector; // ワールド座標(w=1)との内積でビュー空間の深度になるベクトル
+    float2 clusterTileScale; // ピクセル座標にかけるとクラスタのタイル番号になる値
+    float clusterNearClip; // クラスタの近平面までの距離
+    float clusterSliceScale; // log(深度 / 近平面) にかけるとスライス番号になる値
+    uint localLightCount; // ローカルライトの数
 };
 
-struct Environment {
-    float intensity; // 環境光の強度
-};
+static const uint kLightTypePoint = 0;
+static const uint kLightTypeSpot = 1;
 
-struct Camera {
-    float3 worldPosition;
-};
+// クラスタの分割数 LightClustererと同じ値
+static const uint kClusterCountX = 16;
+static const uint kClusterCountY = 9;
+static const uint kClusterCountZ = 24;
 
 ConstantBuffer<Material> gMaterial : register(b1);
 
-ConstantBuffer<DirectionalLight> gDirectionalLight : register(b2);
-
-ConstantBuffer<PointLight> gPointLight : register(b3);
+ConstantBuffer<SceneLight> gSceneLight : register(b2);
 
-ConstantBuffer<SpotLight> gSpotLight : register(b4);
+StructuredBuffer<LocalLight> gLocalLights : register(t2);
 
-ConstantBuffer<Environment> gEnvironment : register(b5);
+StructuredBuffer<uint2> gClusterRanges : register(t3); // クラスタごとの (開始位置, ライトの数)
 
-ConstantBuffer<Camera> gCamera : register(b6);
+StructuredBuffer<uint> gClusterLightIndices : register(t4); // クラスタのライトの番号
 
 Texture2D<float4> gTexture : register(t0);
 
@@ -62,6 +66,27 @@ struct PixelShaderOutput {
     float4 color : SV_TARGET0;
 };
 
+// ライトマスクでそのライトを受けるか (32番以降はマスクがないので常に受ける)
+bool IsLightEnabled(uint index, uint lightMask) {
+    return index >= 32 || ((lightMask >> index) & 1) != 0;
+}
+
+// ピクセルのクラスタのライトの範囲
+uint2 GetClusterRange(float2 pixelPosition, float3 worldPosition) {
+    
+    // 画面のタイル
+    uint2 tile = min(uint2(pixelPosition * gSceneLight.clusterTileScale), uint2(kClusterCountX - 1, kClusterCountY - 1));
+    
+    // 深度のスライス
+    float viewDepth = dot(float4(worldPosition, 1.0f), gSceneLight.viewDepthVector);
+    uint slice = 0;
+    if (viewDepth > gSceneLight.clusterNearClip) {
+        slice = min(uint(log(viewDepth / gSceneLight.clusterNearClip) * gSceneLight.clusterSliceScale), kClusterCountZ - 1);
+    }
+    
+    return gClusterRanges[tile.x + tile.y * kClusterCountX + slice * kClusterCountX * kClusterCountY];
+}
+
 PixelShaderOutput main(VertexShaderOutput input) {
     
     float4 transformedUV = mul(float4(input.texcoord, 0.0f, 1.0f), gMaterial.uvTransform);
@@ -70,34 +95,37 @@ PixelShaderOutput main(VertexShaderOutput input) {
     // 初期化
     PixelShaderOutput output = { float4(0.0f, 0.0f, 0.0f, 1.0f) };
     
+    // シーン共通のライト
+    DirectionalLight directionalLight = gSceneLight.directionalLight;
+    
     if (gMaterial.lightingMode == 1) { // Lambertian Reflection
         
-        float cos = saturate(dot(normalize(input.normal), -gDirectionalLight.direction));
-        output.color = gMaterial.color * textureColor * gDirectionalLight.color * cos * gDirectionalLight.intensity;
+        float cos = saturate(dot(normalize(input.normal), -directionalLight.direction));
+        output.color = gMaterial.color * textureColor * directionalLight.color * cos * directionalLight.intensity;
         
     }
     else if (gMaterial.lightingMode == 2) { // Harf Lambert
         
-        float NdotL = dot(normalize(input.normal), -gDirectionalLight.direction);
+        float NdotL = dot(normalize(input.normal), -directionalLight.direction);
         float cos = pow(NdotL * 0.5f + 0.5f, 2.0f);
-        output.color = gMaterial.color * textureColor * gDirectionalLight.color * cos * gDirectionalLight.intensity;
+        output.color = gMaterial.color * textureColor * directionalLight.color * cos * directionalLight.intensity;
     }
     else if (gMaterial.lightingMode == 3) { // Phong Reflection Model
         
         // 拡散反射の計算
-        float NdotL = dot(normalize(input.normal), -gDirectionalLight.direction);
+        float NdotL = dot(normalize(input.normal), -directionalLight.direction);
         float cos = pow(NdotL * 0.5f + 0.5f, 2.0f);
         
         // 鏡面反射の計算
-        float3 toEye = normalize(gCamera.worldPosition - input.worldPosition);
-        float3 reflectLight = reflect(normalize(gDirectionalLight.direction), normalize(input.normal));
+        float3 toEye = normalize(gSceneLight.cameraPosition - input.worldPosition);
+        float3 reflectLight = reflect(normalize(directionalLight.direction), normalize(input.normal));
         float RdotE = dot(toEye, reflectLight);
         float specularPow = pow(saturate(RdotE), gMaterial.shininess); // 反射強度
         
         // 拡散反射
-        float3 diffuse = gMaterial.color.rgb * textureColor.rgb * gDirectionalLight.color.rgb * cos * gDirectionalLight.intensity;
+        float3 diffuse = gMaterial.color.rgb * textureColor.rgb * directionalLight.color.rgb * cos * directionalLight.intensity;
         // 鏡面反射
-        float3 specular = float3(1.0f, 1.0f, 1.0f) * gDirectionalLight.color.rgb * gDirectionalLight.intensity * specularPow;
+        float3 specular = float3(1.0f, 1.0f, 1.0f) * directionalLight.color.rgb * directionalLight.intensity * specularPow;
         
         // 拡散反射と鏡面反射の合成
         output.color.rgb = diffuse + specular;
@@ -108,19 +136,19 @@ PixelShaderOutput main(VertexShaderOutput input) {
     else if (gMaterial.lightingMode == 4) { // Blinn-Phong Reflection Model
         
         // 拡散反射の計算
-        float NdotL = dot(normalize(input.normal), -gDirectionalLight.direction);
+        float NdotL = dot(normalize(input.normal), -directionalLight.direction);
         float cos = pow(NdotL * 0.5f + 0.5f, 2.0f);
         
         // 鏡面反射の計算
-        float3 toEye = normalize(gCamera.worldPosition - input.worldPosition);
-        float3 halfVector = normalize(-gDirectionalLight.direction + toEye);
+        float3 toEye = normalize(gSceneLight.cameraPosition - input.worldPosition);
+        float3 halfVector = normalize(-directionalLight.direction + toEye);
         float NdotH = dot(normalize(input.normal), halfVector);
         float specularPow = pow(saturate(NdotH), gMaterial.shininess); // 反射強度
         
         // 拡散反射
-        float3 diffuse = gMaterial.color.rgb * textureColor.rgb * gDirectionalLight.color.rgb * cos * gDirectionalLight.intensity;
+        float3 diffuse = gMaterial.color.rgb * textureColor.rgb * directionalLight.color.rgb * cos * directionalLight.intensity;
         // 鏡面反射
-        float3 specular = float3(1.0f, 1.0f, 1.0f) * gDirectionalLight.color.rgb * gDirectionalLight.intensity * specularPow;
+        float3 specular = float3(1.0f, 1.0f, 1.0f) * directionalLight.color.rgb * directionalLight.intensity * specularPow;
         
         // 拡散反射と鏡面反射の合成
         output.color.rgb = diffuse + specular;
@@ -132,41 +160,58 @@ PixelShaderOutput main(VertexShaderOutput input) {
         // ----- DirectionalLight ----- ///
         
         // 拡散反射の計算
-        float NdotLDirectional = dot(normalize(input.normal), -gDirectionalLight.direction);
+        float NdotLDirectional = dot(normalize(input.normal), -directionalLight.direction);
         float cosDirectional = pow(NdotLDirectional * 0.5f + 0.5f, 2.0f);
         
         // 鏡面反射の計算
-        float3 toEyeDirectional = normalize(gCamera.worldPosition - input.worldPosition);
-        float3 halfVectorDirectional = normalize(-gDirectionalLight.direction + toEyeDirectional);
+        float3 toEyeDirectional = normalize(gSceneLight.cameraPosition - input.worldPosition);
+        float3 halfVectorDirectional = normalize(-directionalLight.direction + toEyeDirectional);
         float NdotHDirectional = dot(normalize(input.normal), halfVectorDirectional);
         float specularPowDirectional = pow(saturate(NdotHDirectional), gMaterial.shininess); // 反射強度
         
         // 拡散反射
-        float3 diffuseDirectional = gMaterial.color.rgb * textureColor.rgb * gDirectionalLight.color.rgb * cosDirectional * gDirectionalLight.intensity;
+        float3 diffuseDirectional = gMaterial.color.rgb * textureColor.rgb * directionalLight.color.rgb * cosDirectional * directionalLight.intensity;
         // 鏡面反射
-        float3 specularDirectional = float3(1.0f, 1.0f, 1.0f) * gDirectionalLight.color.rgb * gDirectionalLight.intensity * specularPowDirectional;
+        float3 specularDirectional = float3(1.0f, 1.0f, 1.0f) * directionalLight.color.rgb * directionalLight.intensity * specularPowDirectional;
         
         /// ----- PointLight ----- ///
         
-        float3 pointLightDirection = normalize(input.worldPosition - gPointLight.position);
-        
-        float distance = length(gPointLight.position - input.worldPosition); // ポイントライトへの距離
-        float factor = pow(saturate(-distance / gPointLight.distance + 1.0f), gPointLight.decay); // 指数によるコントロール
-        
-        // 拡散反射の計算
-        float NdotLPoint = dot(normalize(input.normal), -pointLightDirection);
-        float cosPoint = pow(NdotLPoint * 0.5f + 0.5f, 2.0f);
-        
-        // 鏡面反射の計算
-        float3 toEyePoint = normalize(gCamera.worldPosition - pointLightDirection);
-        float3 halfVectorPoint = normalize(-pointLightDirection + toEyePoint);
-        float NdotHPoint = dot(normalize(input.normal), halfVectorPoint);
-        float specularPowPoint = pow(saturate(NdotHPoint), gMaterial.shininess); // 反射強度
-        
-        // 拡散反射
-        float3 diffusePoint = gMaterial.color.rgb * textureColor.rgb * gPointLight.color.rgb * cosPoint * gPointLight.intensity * factor;
-        // 鏡面反射
-        float3 specularPoint = float3(1.0f, 1.0f, 1.0f) * gPointLight.color.rgb * gPointLight.intensity * specularPowPoint * factor;
+        float3 diffusePoint = float3(0.0f, 0.0f, 0.0f);
+        float3 specularPoint = float3(0.0f, 0.0f, 0.0f);
+        
+        // このピクセルのクラスタに届くライトだけを計算する
+        uint2 clusterRange = GetClusterRange(input.position.xy, input.worldPosition);
+        
+        for (uint i = 0; i < clusterRange.y; ++i) {
+            
+            uint index = gClusterLightIndices[clusterRange.x + i];
+            LocalLight pointLight = gLocalLights[index];
+            
+            // 点光源以外とマスクで外したライトは受けない
+            if (pointLight.type != kLightTypePoint || !IsLightEnabled(index, input.lightMask)) {
+                continue;
+            }
+            
+            float3 pointLightDirection = normalize(input.worldPosition - pointLight.position);
+            
+            float distance = length(pointLight.position - input.worldPosition); // ポイントライトへの距離
+            float factor = pow(saturate(-distance / pointLight.distance + 1.0f), pointLight.decay); // 指数によるコントロール
+            
+            // 拡散反射の計算
+            float NdotLPoint = dot(normalize(input.normal), -pointLightDirection);
+            float cosPoint = pow(NdotLPoint * 0.5f + 0.5f, 2.0f);
+            
+            // 鏡面反射の計算
+            float3 toEyePoint = normalize(gSceneLight.cameraPosition - pointLightDirection);
+            float3 halfVectorPoint = normalize(-pointLightDirection + toEyePoint);
+            float NdotHPoint = dot(normalize(input.normal), halfVectorPoint);
+            float specularPowPoint = pow(saturate(NdotHPoint), gMaterial.shininess); // 反射強度
+            
+            // 拡散反射
+            diffusePoint += gMaterial.color.rgb * textureColor.rgb * pointLight.color.rgb * cosPoint * pointLight.intensity * factor;
+            // 鏡面反射
+            specularPoint += float3(1.0f, 1.0f, 1.0f) * pointLight.color.rgb * pointLight.intensity * specularPowPoint * factor;
+        }
         
         /// ----- 合成 ----- ///
         
@@ -180,44 +225,61 @@ PixelShaderOutput main(VertexShaderOutput input) {
         /// ----- DirectionalLight ----- ///
         
         // 拡散反射の計算
-        float NdotLDirectional = dot(normalize(input.normal), -gDirectionalLight.direction);
+        float NdotLDirectional = dot(normalize(input.normal), -directionalLight.direction);
         float cosDirectional = pow(NdotLDirectional * 0.5f + 0.5f, 2.0f);
         
         // 鏡面反射の計算
-        float3 toEyeDirectional = normalize(gCamera.worldPosition - input.worldPosition);
-        float3 halfVectorDirectional = normalize(-gDirectionalLight.direction + toEyeDirectional);
+        float3 toEyeDirectional = normalize(gSceneLight.cameraPosition - input.worldPosition);
+        float3 halfVectorDirectional = normalize(-directionalLight.direction + toEyeDirectional);
         float NdotHDirectional = dot(normalize(input.normal), halfVectorDirectional);
         float specularPowDirectional = pow(saturate(NdotHDirectional), gMaterial.shininess); // 反射強度
         
         // 拡散反射
-        float3 diffuseDirectional = gMaterial.color.rgb * textureColor.rgb * gDirectionalLight.color.rgb * cosDirectional * gDirectionalLight.intensity;
+        float3 diffuseDirectional = gMaterial.color.rgb * textureColor.rgb * directionalLight.color.rgb * cosDirectional * directionalLight.intensity;
         // 鏡面反射
-        float3 specularDirectional = float3(1.0f, 1.0f, 1.0f) * gDirectionalLight.color.rgb * gDirectionalLight.intensity * specularPowDirectional;
+        float3 specularDirectional = float3(1.0f, 1.0f, 1.0f) * directionalLight.color.rgb * directionalLight.intensity * specularPowDirectional;
         
         /// ----- SpotLight ----- ///
         
-        float3 spotLightDirection = normalize(input.worldPosition - gSpotLight.position);
-        
-        float distance = length(gSpotLight.position - input.worldPosition); // スポットライトへの距離
-        float attenuationFactor = pow(saturate(-distance / gSpotLight.distance + 1.0f), gSpotLight.decay); // 指数によるコントロール
-    
-        float spotCosAngle = dot(normalize(gSpotLight.direction), -spotLightDirection);
-        float falloffFactor = saturate((spotCosAngle - gSpotLight.cosAngle) / (gSpotLight.cosFalloffStart - gSpotLight.cosAngle));
-    
-        // 拡散反射の計算
-        float NdotLSpot = dot(normalize(input.normal), -spotLightDirection);
-        float cosSpot = pow(NdotLSpot * 0.5f + 0.5f, 2.0f);
-    
-        // 鏡面反射の計算
-        float3 toEyeSpot = normalize(gCamera.worldPosition - spotLightDirection);
-        float3 halfVectorSpot = normalize(-spotLightDirection + toEyeSpot);
-        float NdotHSpot = dot(normalize(input.normal), halfVectorSpot);
-        float specularPowSpot = pow(saturate(NdotHSpot), gMaterial.shininess); // 反射強度
-    
-        // 拡散反射
-        float3 diffuseSpot = gMaterial.color.rgb * textureColor.rgb * gSpotLight.color.rgb * cosSpot * gSpotLight.intensity * attenuationFactor * falloffFactor;
-        // 鏡面反射
-        float3 specularSpot = float3(1.0f, 1.0f, 1.0f) * gSpotLight.color.rgb * gSpotLight.intensity * specularPowSpot * attenuationFactor * falloffFactor;
+        float3 diffuseSpot = float3(0.0f, 0.0f, 0.0f);
+        float3 specularSpot = float3(0.0f, 0.0f, 0.0f);
+        
+        // このピクセルのクラスタに届くライトだけを計算する
+        uint2 clusterRange = GetClusterRange(input.position.xy, input.worldPosition);
+        
+        for (uint i = 0; i < clusterRange.y; ++i) {
+            
+            uint index = gClusterLightIndices[clusterRange.x + i];
+            LocalLight spotLight = gLocalLights[index];
+            
+            // スポットライト以外とマスクで外したライトは受けない
+            if (spotLight.type != kLightTypeSpot || !IsLightEnabled(index, input.lightMask)) {
+                continue;
+            }
+            
+            float3 spotLightDirection = normalize(input.worldPosition - spotLight.position);
+            
+            float distance = length(spotLight.position - input.worldPosition); // スポットライトへの距離
+            float attenuationFactor = pow(saturate(-distance / spotLight.distance + 1.0f), spotLight.decay); // 指数によるコントロール
+            
+            float spotCosAngle = dot(spotLight.direction, -spotLightDirection); // 向きはLightManagerで正規化済み
+            float falloffFactor = saturate((spotCosAngle - spotLight.cosAngle) / (spotLight.cosFalloffStart - spotLight.cosAngle));
+            
+            // 拡散反射の計算
+            float NdotLSpot = dot(normalize(input.normal), -spotLightDirection);
+            float cosSpot = pow(NdotLSpot * 0.5f + 0.5f, 2.0f);
+            
+            // 鏡面反射の計算
+            float3 toEyeSpot = normalize(gSceneLight.cameraPosition - spotLightDirection);
+            float3 halfVectorSpot = normalize(-spotLightDirection + toEyeSpot);
+            float NdotHSpot = dot(normalize(input.normal), halfVectorSpot);
+            float specularPowSpot = pow(saturate(NdotHSpot), gMaterial.shininess); // 反射強度
+            
+            // 拡散反射
+            diffuseSpot += gMaterial.color.rgb * textureColor.rgb * spotLight.color.rgb * cosSpot * spotLight.intensity * attenuationFactor * falloffFactor;
+            // 鏡面反射
+            specularSpot += float3(1.0f, 1.0f, 1.0f) * spotLight.color.rgb * spotLight.intensity * specularPowSpot * attenuationFactor * falloffFactor;
+        }
         
         /// ----- 合成 ----- ///
         
@@ -229,12 +291,12 @@ PixelShaderOutput main(VertexShaderOutput input) {
     }
     else if (gMaterial.lightingMode == 7) { // 環境マップ
         
-        float3 cameraToPosition = normalize(input.worldPosition - gCamera.worldPosition);
+        float3 cameraToPosition = normalize(input.worldPosition - gSceneLight.cameraPosition);
         float3 reflectedVector = reflect(cameraToPosition, normalize(input.normal));
         float4 environmentColor = gEnvironmentTexture.Sample(gSampler, reflectedVector);
         
         // 環境マップに輝度を乗算
-        environmentColor.rgb *= gEnvironment.intensity;
+        environmentColor.rgb *= gSceneLight.environmentIntensity;
         
         // 出力色の計算
         output.color.rgb = textureColor.rgb * gMaterial.color.rgb * environmentColor.rgb;
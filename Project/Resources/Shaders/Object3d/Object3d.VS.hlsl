@@ -5,6 +5,8 @@ struct TransformationMatrix
     float4x4 WVP;
     float4x4 world;
     float4x4 worldInverseTranspose;
+    uint lightMask;
+    float3 padding;
 };
 
 ConstantBuffer<TransformationMatrix> gTransformationMatrix : register(b0);
@@ -23,5 +25,6 @@ VertexShaderOutput main(VertexShaderInput input)
     output.texcoord = input.texcoord;
     output.normal = normalize(mul(input.normal, (float3x3) gTransformationMatrix.worldInverseTranspose));
     output.worldPosition = mul(input.position, gTransformationMatrix.world).xyz;
+    output.lightMask = gTransformationMatrix.lightMask;
     return output;
 }
\ No newline at end of file
@@ -4,4 +4,5 @@ struct VertexShaderOutput
     float2 texcoord : TEXCOORD0;
     float3 normal : NORMAL0;
     float3 worldPosition : POSITION0;
+    nointerpolation uint lightMask : LIGHTMASK0;
 };
\ No newline at end of file
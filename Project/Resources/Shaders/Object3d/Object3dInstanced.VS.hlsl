@@ -0,0 +1,30 @@
+#include "object3d.hlsli"
+
+struct TransformationMatrix
+{
+    float4x4 WVP;
+    float4x4 world;
+    float4x4 worldInverseTranspose;
+    uint lightMask;
+    float3 padding;
+};
+
+StructuredBuffer<TransformationMatrix> gInstance : register(t0);
+	
+struct VertexShaderInput
+{
+    float4 position : POSITION0;
+    float2 texcoord : TEXCOORD0;
+    float3 normal : NORMAL0;
+};
+
+VertexShaderOutput main(VertexShaderInput input, uint instanceId : SV_InstanceID)
+{
+    VertexShaderOutput output;
+    output.position = mul(input.position, gInstance[instanceId].WVP);
+    output.texcoord = input.texcoord;
+    output.normal = normalize(mul(input.normal, (float3x3) gInstance[instanceId].worldInverseTranspose));
+    output.worldPosition = mul(input.position, gInstance[instanceId].world).xyz;
+    output.lightMask = gInstance[instanceId].lightMask;
+    return output;
+}
\ No newline at end of file
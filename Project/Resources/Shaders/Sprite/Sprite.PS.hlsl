@@ -5,13 +5,6 @@ struct PixelShaderOutput
     float4 color : SV_TARGET0;
 };
 
-struct Material
-{
-    float4 color;
-};
-
-ConstantBuffer<Material> gMaterial : register(b1);
-
 Texture2D<float4> gTexture : register(t0);
 
 SamplerState gSampler : register(s0);
@@ -22,7 +15,7 @@ PixelShaderOutput main(VertexShaderOutput input)
     
     PixelShaderOutput output;
     
-    output.color = gMaterial.color * textureColor;
+    output.color = input.color * textureColor;
     
     return output;
 }
\ No newline at end of file
@@ -4,19 +4,15 @@ struct VertexShaderInput
 {
     float4 position : POSITION0;
     float2 texcoord : TEXCOORD0;
+    float4 color : COLOR0;
 };
 
-struct TransformationMatrix
-{
-    float4x4 WVP;
-};
-
-ConstantBuffer<TransformationMatrix> gTransformationMatrix : register(b0);
-	
+// 位置はCPUでクリップ空間に変換済み (スプライトごとの定数バッファを使わずにまとめて描画する)
 VertexShaderOutput main(VertexShaderInput input)
 {
     VertexShaderOutput output;
-    output.position = mul(input.position, gTransformationMatrix.WVP);
+    output.position = input.position;
     output.texcoord = input.texcoord;
+    output.color = input.color;
     return output;
 }
\ No newline at end of file
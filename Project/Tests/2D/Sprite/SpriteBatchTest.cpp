@@ -0,0 +1,124 @@
+#include "TestFramework.h"
+#include "Sprite/SpriteBatch.h"
+
+#include <cstdint>
+
+using namespace Engine;
+
+namespace {
+
+	/// <summary>
+	/// 頂点の色だけを決めた四角形を作る (他の値は使わない)
+	/// </summary>
+	void MakeQuad(SpriteBatch::Vertex(&vertices)[4], float red) {
+		for (SpriteBatch::Vertex& vertex : vertices) {
+			vertex = {};
+			vertex.color = { red, 0.0f, 0.0f, 1.0f };
+		}
+	}
+}
+
+TEST_CASE("SpriteBatch: レイヤー順に並べ、同じレイヤーの中は追加した順を保つ") {
+
+	SpriteBatch batch;
+	SpriteBatch::Vertex vertices[4];
+
+	// レイヤー1を先に追加し、レイヤー0は A A B A の順で追加する
+	batch.Begin();
+	MakeQuad(vertices, 1.0f);
+	batch.AddQuad(7, 1, vertices);
+	MakeQuad(vertices, 0.0f);
+	batch.AddQuad(3, 0, vertices);
+	batch.AddQuad(3, 0, vertices);
+	batch.AddQuad(4, 0, vertices);
+	batch.AddQuad(3, 0, vertices);
+	batch.Build();
+
+	CHECK(batch.GetQuadCount() == 5);
+	CHECK(batch.GetVertices().size() == 20);
+	CHECK(batch.GetIndices().size() == 30);
+
+	// 続く同じテクスチャだけをまとめる (テクスチャで並べ替えると重なり順が変わるので、離れたAはまとめない)
+	std::span<const SpriteBatch::Batch> batches = batch.GetBatches();
+	REQUIRE(batches.size() == 4);
+	CHECK(batches[0].textureSrvIndex == 3);
+	CHECK(batches[0].indexStart == 0);
+	CHECK(batches[0].indexCount == 12);
+	CHECK(batches[1].textureSrvIndex == 4);
+	CHECK(batches[1].indexStart == 12);
+	CHECK(batches[1].indexCount == 6);
+	CHECK(batches[2].textureSrvIndex == 3);
+	CHECK(batches[2].indexStart == 18);
+	CHECK(batches[2].indexCount == 6);
+	CHECK(batches[3].textureSrvIndex == 7);
+	CHECK(batches[3].indexStart == 24);
+	CHECK(batches[3].indexCount == 6);
+
+	// 最初に追加したレイヤー1の四角形は最後に描く
+	CHECK(batch.GetVertices()[16].color.x == 1.0f);
+	CHECK(batch.GetVertices()[0].color.x == 0.0f);
+}
+
+TEST_CASE("SpriteBatch: インデックスは四角形ごとに2枚の三角形で自分の頂点だけを指す") {
+
+	SpriteBatch batch;
+	SpriteBatch::Vertex vertices[4];
+	MakeQuad(vertices, 0.5f);
+
+	batch.Begin();
+	for (uint32_t i = 0; i < 3; ++i) {
+		batch.AddQuad(1, 0, vertices);
+	}
+	batch.Build();
+
+	std::span<const uint32_t> indices = batch.GetIndices();
+	REQUIRE(indices.size() == 18);
+	for (uint32_t quad = 0; quad < 3; ++quad) {
+
+		// 左下、左上、右下、右上の4頂点を全て使う
+		bool used[4] = {};
+		for (uint32_t i = 0; i < 6; ++i) {
+			uint32_t index = indices[quad * 6 + i];
+			REQUIRE(index >= quad * 4);
+			REQUIRE(index < quad * 4 + 4);
+			used[index - quad * 4] = true;
+		}
+		CHECK(used[0] && used[1] && used[2] && used[3]);
+	}
+
+	// 全て同じテクスチャなので1回の描画になる
+	REQUIRE(batch.GetBatches().size() == 1);
+	CHECK(batch.GetBatches()[0].indexCount == 18);
+}
+
+TEST_CASE("SpriteBatch: Beginで前のフレームを捨て、同じ結果を作り直せる") {
+
+	SpriteBatch batch;
+	SpriteBatch::Vertex vertices[4];
+	MakeQuad(vertices, 0.0f);
+
+	for (uint32_t frame = 0; frame < 3; ++frame) {
+
+		batch.Begin();
+		batch.AddQuad(2, 0, vertices);
+		batch.AddQuad(5, -1, vertices);
+		batch.Build();
+
+		// 前のフレームの分は残らず、負のレイヤーは先に描く
+		CHECK(batch.GetQuadCount() == 2);
+		CHECK(batch.GetVertices().size() == 8);
+		CHECK(batch.GetIndices().size() == 12);
+		REQUIRE(batch.GetBatches().size() == 2);
+		CHECK(batch.GetBatches()[0].textureSrvIndex == 5);
+		CHECK(batch.GetBatches()[1].textureSrvIndex == 2);
+		CHECK(batch.GetIndices().back() < 8);
+	}
+
+	// 何も追加しなければ描画しない
+	batch.Begin();
+	batch.Build();
+	CHECK(batch.GetQuadCount() == 0);
+	CHECK(batch.GetVertices().empty());
+	CHECK(batch.GetIndices().empty());
+	CHECK(batch.GetBatches().empty());
+}
@@ -0,0 +1,134 @@
+#include "TestFramework.h"
+#include "Texture/AtlasPacker.h"
+#include "json.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+	/// <summary>
+	/// 並べた長方形が余白を含めてアトラスに収まり、互いに重ならないかを確かめる
+	/// </summary>
+	void CheckPlacements(std::span<const AtlasPacker::Rect> sizes, uint32_t padding, const std::vector<AtlasPacker::Rect>& placements, uint32_t atlasWidth, uint32_t atlasHeight) {
+
+		REQUIRE(placements.size() == sizes.size());
+		for (size_t i = 0; i < placements.size(); ++i) {
+
+			const AtlasPacker::Rect& a = placements[i];
+			REQUIRE(a.width == sizes[i].width);
+			REQUIRE(a.height == sizes[i].height);
+			REQUIRE(a.x >= padding);
+			REQUIRE(a.y >= padding);
+			REQUIRE(a.x + a.width + padding <= atlasWidth);
+			REQUIRE(a.y + a.height + padding <= atlasHeight);
+
+			// 余白同士も重ならない
+			for (size_t j = 0; j < i; ++j) {
+				const AtlasPacker::Rect& b = placements[j];
+				bool separated =
+					a.x + a.width + padding <= b.x - padding || b.x + b.width + padding <= a.x - padding ||
+					a.y + a.height + padding <= b.y - padding || b.y + b.height + padding <= a.y - padding;
+				REQUIRE(separated);
+			}
+		}
+	}
+
+	/// <summary>
+	/// PNGの幅と高さを読む (IHDRチャンクだけを見る)
+	/// </summary>
+	bool ReadPngSize(const std::filesystem::path& path, uint32_t& width, uint32_t& height) {
+
+		std::ifstream file(path, std::ios::binary);
+		unsigned char header[24] = {};
+		if (!file.read(reinterpret_cast<char*>(header), sizeof(header))) {
+			return false;
+		}
+
+		width = (header[16] << 24) | (header[17] << 16) | (header[18] << 8) | header[19];
+		height = (header[20] << 24) | (header[21] << 16) | (header[22] << 8) | header[23];
+		return true;
+	}
+}
+
+TEST_CASE("AtlasPacker: ランダムな長方形を余白を空けて重ならないように並べる") {
+
+	std::mt19937 random(1);
+
+	uint32_t packedCount = 0;
+	for (uint32_t iteration = 0; iteration < 500; ++iteration) {
+
+		std::vector<AtlasPacker::Rect> sizes(1 + random() % 40);
+		for (AtlasPacker::Rect& size : sizes) {
+			size = { 0, 0, 1 + static_cast<uint32_t>(random() % 300), 1 + static_cast<uint32_t>(random() % 200) };
+		}
+		uint32_t padding = random() % 4;
+
+		std::vector<AtlasPacker::Rect> placements;
+		uint32_t atlasWidth = 0;
+		uint32_t atlasHeight = 0;
+		if (!AtlasPacker::Pack(sizes, padding, 4096, placements, atlasWidth, atlasHeight)) {
+			continue;
+		}
+		packedCount++;
+
+		// 大きさは2の累乗
+		CHECK((atlasWidth & (atlasWidth - 1)) == 0);
+		CHECK((atlasHeight & (atlasHeight - 1)) == 0);
+		CheckPlacements(sizes, padding, placements, atlasWidth, atlasHeight);
+	}
+
+	CHECK(packedCount == 500);
+}
+
+TEST_CASE("AtlasPacker: 上限の大きさに入らなければ失敗する") {
+
+	std::vector<AtlasPacker::Rect> placements;
+	uint32_t atlasWidth = 0;
+	uint32_t atlasHeight = 0;
+
+	// 1枚でも上限より大きい
+	std::vector<AtlasPacker::Rect> wide = { { 0, 0, 3000, 10 } };
+	CHECK(!AtlasPacker::Pack(wide, 2, 2048, placements, atlasWidth, atlasHeight));
+
+	// 余白を足すと上限を超える
+	std::vector<AtlasPacker::Rect> exact = { { 0, 0, 64, 64 } };
+	CHECK(AtlasPacker::Pack(exact, 0, 64, placements, atlasWidth, atlasHeight));
+	CHECK(atlasWidth == 64);
+	CHECK(atlasHeight == 64);
+	CHECK(!AtlasPacker::Pack(exact, 1, 64, placements, atlasWidth, atlasHeight));
+}
+
+TEST_CASE("AtlasPacker: UIAtlas.jsonの画像は上限の大きさに入る") {
+
+	std::filesystem::path textureDirectory = std::filesystem::path(ENGINE_RESOURCES_DIR) / "Textures";
+	std::ifstream manifestFile(textureDirectory / "UIAtlas.json");
+	REQUIRE(manifestFile.is_open());
+	nlohmann::json manifest = nlohmann::json::parse(manifestFile);
+
+	// 画像の大きさを集める
+	std::vector<AtlasPacker::Rect> sizes;
+	for (const nlohmann::json& texture : manifest["textures"]) {
+		AtlasPacker::Rect size = {};
+		REQUIRE(ReadPngSize(textureDirectory / texture.get<std::string>(), size.width, size.height));
+		sizes.push_back(size);
+	}
+
+	uint32_t padding = manifest["padding"];
+	uint32_t maxSize = manifest["maxSize"];
+
+	std::vector<AtlasPacker::Rect> placements;
+	uint32_t atlasWidth = 0;
+	uint32_t atlasHeight = 0;
+	REQUIRE(AtlasPacker::Pack(sizes, padding, maxSize, placements, atlasWidth, atlasHeight));
+	CheckPlacements(sizes, padding, placements, atlasWidth, atlasHeight);
+
+	TestFramework::ReportMeasurement("UI textures", static_cast<double>(sizes.size()), "");
+	TestFramework::ReportMeasurement("atlas width", static_cast<double>(atlasWidth), "px");
+	TestFramework::ReportMeasurement("atlas height", static_cast<double>(atlasHeight), "px");
+}
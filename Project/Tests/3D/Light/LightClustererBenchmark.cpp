@@ -0,0 +1,78 @@
+#include "TestFramework.h"
+#include "Light/LightClusterer.h"
+#include "MathMatrix.h"
+#include "MathVector.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace Engine;
+
+/// 1000個のライトのクラスタへの割り当てを、総当たり(全ライト x 全クラスタのスカラー判定)と比べる
+
+namespace {
+
+	// ライトの数
+	const uint32_t kLightCount = 1000;
+
+	// 深度の範囲
+	const float kNearClip = 0.1f;
+	const float kFarClip = 300.0f;
+}
+
+TEST_CASE("LightClusterer: 1000ライトの割り当て") {
+
+	Matrix4x4 projectionMatrix = MathMatrix::MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, kNearClip, kFarClip);
+	Matrix4x4 viewMatrix = MathMatrix::Inverse(MathMatrix::MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, { 0.1f, 0.0f, 0.0f }, { 0.0f, 4.0f, -20.0f }));
+
+	// コースの上に並ぶライト (半分ほどが視錐台に入る)
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> xDistribution(-40.0f, 40.0f);
+	std::uniform_real_distribution<float> zDistribution(-60.0f, 300.0f);
+	std::uniform_real_distribution<float> radiusDistribution(2.0f, 10.0f);
+
+	std::vector<LightClusterer::LightBounds> lights(kLightCount);
+	for (LightClusterer::LightBounds& light : lights) {
+		light.position = { xDistribution(random), 1.0f, zDistribution(random) };
+		light.radius = radiusDistribution(random);
+	}
+
+	LightClusterer clusterer;
+	clusterer.Build(viewMatrix, projectionMatrix, kNearClip, kFarClip, lights);
+
+	double buildTime = TestFramework::MeasureMilliseconds(20, [&]() {
+		clusterer.Build(viewMatrix, projectionMatrix, kNearClip, kFarClip, lights);
+	});
+
+	// 総当たり (スライスでの絞り込みもSIMDもなし)
+	double bruteForceTime = TestFramework::MeasureMilliseconds(3, [&]() {
+
+		uint32_t assignedCount = 0;
+		for (const LightClusterer::LightBounds& light : lights) {
+
+			Vector3 position = MathVector::Transform(light.position, viewMatrix);
+			for (uint32_t cluster = 0; cluster < LightClusterer::kClusterCount; ++cluster) {
+
+				const AABB& bounds = clusterer.GetClusterBounds(cluster);
+				float dx = (std::max)({ 0.0f, bounds.min.x - position.x, position.x - bounds.max.x });
+				float dy = (std::max)({ 0.0f, bounds.min.y - position.y, position.y - bounds.max.y });
+				float dz = (std::max)({ 0.0f, bounds.min.z - position.z, position.z - bounds.max.z });
+				if (dx * dx + dy * dy + dz * dz <= light.radius * light.radius) {
+					assignedCount++;
+				}
+			}
+		}
+
+		REQUIRE(assignedCount == clusterer.GetAssignedCount());
+	});
+
+	TestFramework::ReportMeasurement("clusters", static_cast<double>(LightClusterer::kClusterCount), "");
+	TestFramework::ReportMeasurement("assigned light indices", static_cast<double>(clusterer.GetAssignedCount()), "");
+	TestFramework::ReportMeasurement("max lights per cluster", static_cast<double>(clusterer.GetMaxClusterLightCount()), "");
+	TestFramework::ReportMeasurement("LightClusterer::Build", buildTime, "ms");
+	TestFramework::ReportMeasurement("brute force", bruteForceTime, "ms");
+	TestFramework::ReportMeasurement("speedup", bruteForceTime / buildTime, "x");
+
+	CHECK(buildTime < bruteForceTime);
+}
@@ -0,0 +1,177 @@
+#include "TestFramework.h"
+#include "Light/LightClusterer.h"
+#include "MathMatrix.h"
+#include "MathVector.h"
+
+#include <algorithm>
+#include <numbers>
+#include <random>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+	// 深度の範囲
+	const float kNearClip = 0.1f;
+	const float kFarClip = 300.0f;
+
+	/// <summary>
+	/// カメラの周りにライトを散らす (半径0、カメラの後ろ、遠平面の外も混ぜる)
+	/// </summary>
+	std::vector<LightClusterer::LightBounds> MakeLights(uint32_t count, const Vector3& center, uint32_t seed) {
+
+		std::mt19937 random(seed);
+		std::uniform_real_distribution<float> positionDistribution(-150.0f, 150.0f);
+		std::uniform_real_distribution<float> radiusDistribution(0.5f, 20.0f);
+
+		std::vector<LightClusterer::LightBounds> lights(count);
+		for (uint32_t i = 0; i < count; ++i) {
+			lights[i].position = { center.x + positionDistribution(random), center.y + positionDistribution(random) * 0.2f, center.z + positionDistribution(random) * 2.0f };
+			lights[i].radius = (i % 17 == 0) ? 0.0f : radiusDistribution(random);
+		}
+
+		return lights;
+	}
+
+	/// <summary>
+	/// 全てのライトと全てのクラスタを総当たりで判定する
+	/// </summary>
+	std::vector<std::vector<uint32_t>> BruteForce(const LightClusterer& clusterer, const Matrix4x4& viewMatrix, const std::vector<LightClusterer::LightBounds>& lights) {
+
+		std::vector<std::vector<uint32_t>> result(LightClusterer::kClusterCount);
+
+		for (uint32_t light = 0; light < lights.size(); ++light) {
+
+			if (lights[light].radius <= 0.0f) {
+				continue;
+			}
+
+			Vector3 position = MathVector::Transform(lights[light].position, viewMatrix);
+			float radius = lights[light].radius;
+
+			for (uint32_t cluster = 0; cluster < LightClusterer::kClusterCount; ++cluster) {
+
+				const AABB& bounds = clusterer.GetClusterBounds(cluster);
+				float dx = (std::max)({ 0.0f, bounds.min.x - position.x, position.x - bounds.max.x });
+				float dy = (std::max)({ 0.0f, bounds.min.y - position.y, position.y - bounds.max.y });
+				float dz = (std::max)({ 0.0f, bounds.min.z - position.z, position.z - bounds.max.z });
+				if (dx * dx + dy * dy + dz * dz <= radius * radius) {
+					result[cluster].push_back(light);
+				}
+			}
+		}
+
+		return result;
+	}
+}
+
+TEST_CASE("LightClusterer: 総当たりと同じライトがクラスタに入る") {
+
+	Matrix4x4 projectionMatrix = MathMatrix::MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, kNearClip, kFarClip);
+
+	// いくつかのカメラの向きで確かめる
+	const Vector3 cameraRotations[] = { { 0.0f, 0.0f, 0.0f }, { 0.3f, 0.8f, 0.0f }, { -0.2f, std::numbers::pi_v<float>, 0.1f } };
+	uint32_t seed = 1;
+
+	for (const Vector3& rotation : cameraRotations) {
+
+		Vector3 cameraPosition = { 10.0f, 5.0f, -40.0f };
+		Matrix4x4 viewMatrix = MathMatrix::Inverse(MathMatrix::MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, rotation, cameraPosition));
+		std::vector<LightClusterer::LightBounds> lights = MakeLights(500, cameraPosition, seed++);
+
+		LightClusterer clusterer;
+		clusterer.Build(viewMatrix, projectionMatrix, kNearClip, kFarClip, lights);
+
+		std::vector<std::vector<uint32_t>> expected = BruteForce(clusterer, viewMatrix, lights);
+
+		const std::vector<LightClusterer::ClusterRange>& ranges = clusterer.GetClusterRanges();
+		const std::vector<uint32_t>& indices = clusterer.GetLightIndices();
+		REQUIRE(ranges.size() == LightClusterer::kClusterCount);
+
+		uint32_t mismatchCount = 0;
+		uint32_t expectedTotal = 0;
+		uint32_t expectedMax = 0;
+		for (uint32_t cluster = 0; cluster < LightClusterer::kClusterCount; ++cluster) {
+
+			std::vector<uint32_t> actual(indices.begin() + ranges[cluster].offset, indices.begin() + ranges[cluster].offset + ranges[cluster].count);
+			std::sort(actual.begin(), actual.end());
+			if (actual != expected[cluster]) {
+				mismatchCount++;
+			}
+
+			expectedTotal += static_cast<uint32_t>(expected[cluster].size());
+			expectedMax = (std::max)(expectedMax, static_cast<uint32_t>(expected[cluster].size()));
+		}
+
+		CHECK(mismatchCount == 0);
+		CHECK(clusterer.GetAssignedCount() == expectedTotal);
+		CHECK(clusterer.GetMaxClusterLightCount() == expectedMax);
+
+		// 何も入らないような配置になっていない
+		CHECK(expectedTotal > 0);
+	}
+}
+
+TEST_CASE("LightClusterer: クラスタの範囲は配列を隙間なく順に覆う") {
+
+	Matrix4x4 projectionMatrix = MathMatrix::MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, kNearClip, kFarClip);
+	Matrix4x4 viewMatrix = MathMatrix::MakeIdentity4x4();
+	std::vector<LightClusterer::LightBounds> lights = MakeLights(200, { 0.0f, 0.0f, 0.0f }, 9);
+
+	LightClusterer clusterer;
+	clusterer.Build(viewMatrix, projectionMatrix, kNearClip, kFarClip, lights);
+
+	uint32_t offset = 0;
+	for (const LightClusterer::ClusterRange& range : clusterer.GetClusterRanges()) {
+		CHECK(range.offset == offset);
+		offset += range.count;
+	}
+	CHECK(offset == clusterer.GetAssignedCount());
+
+	// ライトがなくなれば空になる (作業領域は使い回す)
+	clusterer.Build(viewMatrix, projectionMatrix, kNearClip, kFarClip, {});
+	CHECK(clusterer.GetAssignedCount() == 0);
+	CHECK(clusterer.GetMaxClusterLightCount() == 0);
+}
+
+TEST_CASE("LightClusterer: 画面の中央にある小さなライトはその位置のクラスタだけに入る") {
+
+	Matrix4x4 projectionMatrix = MathMatrix::MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, kNearClip, kFarClip);
+	Matrix4x4 viewMatrix = MathMatrix::MakeIdentity4x4();
+
+	// 中央のタイルの中心付近、深度10
+	float depth = 10.0f;
+	uint32_t slice = LightClusterer::CalculateSlice(depth, kNearClip, kFarClip);
+	uint32_t centerX = LightClusterer::kClusterCountX / 2;
+	uint32_t centerY = LightClusterer::kClusterCountY / 2;
+	uint32_t cluster = centerX + centerY * LightClusterer::kClusterCountX + slice * LightClusterer::kClusterCountX * LightClusterer::kClusterCountY;
+
+	LightClusterer clusterer;
+	clusterer.Build(viewMatrix, projectionMatrix, kNearClip, kFarClip, {});
+	const AABB& bounds = clusterer.GetClusterBounds(cluster);
+	Vector3 center = { (bounds.min.x + bounds.max.x) * 0.5f, (bounds.min.y + bounds.max.y) * 0.5f, depth };
+
+	clusterer.Build(viewMatrix, projectionMatrix, kNearClip, kFarClip, { { center, 0.001f } });
+
+	CHECK(clusterer.GetAssignedCount() == 1);
+	CHECK(clusterer.GetClusterRanges()[cluster].count == 1);
+}
+
+TEST_CASE("LightClusterer: スライスの深度とスライス番号が対応する") {
+
+	CHECK(LightClusterer::CalculateSliceDepth(0, kNearClip, kFarClip) == kNearClip);
+	CHECK(std::abs(LightClusterer::CalculateSliceDepth(LightClusterer::kClusterCountZ, kNearClip, kFarClip) - kFarClip) < 0.01f);
+
+	for (uint32_t slice = 0; slice < LightClusterer::kClusterCountZ; ++slice) {
+
+		// スライスの手前と奥の真ん中はそのスライスに入る
+		float depthNear = LightClusterer::CalculateSliceDepth(slice, kNearClip, kFarClip);
+		float depthFar = LightClusterer::CalculateSliceDepth(slice + 1, kNearClip, kFarClip);
+		CHECK(LightClusterer::CalculateSlice((depthNear + depthFar) * 0.5f, kNearClip, kFarClip) == slice);
+	}
+
+	// 範囲外は端に丸める
+	CHECK(LightClusterer::CalculateSlice(0.0f, kNearClip, kFarClip) == 0);
+	CHECK(LightClusterer::CalculateSlice(kFarClip * 10.0f, kNearClip, kFarClip) == LightClusterer::kClusterCountZ - 1);
+}
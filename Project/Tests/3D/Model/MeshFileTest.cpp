@@ -0,0 +1,187 @@
+#include "TestFramework.h"
+#include "Model/MeshFile.h"
+#include "Data/MeshFileFormat.h"
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+	/// <summary>
+	/// テスト用の一時ファイルのパスを作る
+	/// </summary>
+	std::string MakeTempPath(const char* name) {
+		return (std::filesystem::temp_directory_path() / (std::string("MeshFileTest_") + name + MeshFileFormat::kExtension)).string();
+	}
+
+	/// <summary>
+	/// 単位行列の平行移動だけを変えた行列を作る
+	/// </summary>
+	Matrix4x4 MakeTranslate(float x, float y, float z) {
+		Matrix4x4 result{};
+		for (int i = 0; i < 4; ++i) result.m[i][i] = 1.0f;
+		result.m[3][0] = x;
+		result.m[3][1] = y;
+		result.m[3][2] = z;
+		return result;
+	}
+
+	/// <summary>
+	/// 三角形2枚と3階層のノードを持つモデルを作る
+	/// </summary>
+	ModelData MakeModel() {
+
+		ModelData modelData;
+
+		for (int i = 0; i < 4; ++i) {
+			VertexData vertex{};
+			vertex.position = { float(i), float(i * 2), float(-i), 1.0f };
+			vertex.texcoord = { float(i & 1), float(i >> 1) };
+			vertex.normal = { 0.0f, 0.0f, -1.0f };
+			modelData.vertices.push_back(vertex);
+		}
+		modelData.indices = { 0, 1, 2, 2, 1, 3 };
+
+		modelData.rootNode.name = "Root";
+		modelData.rootNode.localMatrix = MakeTranslate(0.0f, 0.0f, 0.0f);
+
+		Node body;
+		body.name = "Body";
+		body.localMatrix = MakeTranslate(1.0f, 2.0f, 3.0f);
+
+		Node arm;
+		arm.name = "Arm";
+		arm.localMatrix = MakeTranslate(-4.0f, 0.5f, 0.0f);
+		body.children.push_back(arm);
+
+		Node head;
+		head.name = "Head";
+		head.localMatrix = MakeTranslate(0.0f, 5.0f, 0.0f);
+
+		modelData.rootNode.children.push_back(body);
+		modelData.rootNode.children.push_back(head);
+
+		return modelData;
+	}
+
+	/// <summary>
+	/// ノード階層が一致するか
+	/// </summary>
+	bool IsSameNode(const Node& a, const Node& b) {
+
+		if (a.name != b.name) return false;
+		if (std::memcmp(&a.localMatrix, &b.localMatrix, sizeof(Matrix4x4)) != 0) return false;
+		if (a.children.size() != b.children.size()) return false;
+
+		for (size_t i = 0; i < a.children.size(); ++i) {
+			if (!IsSameNode(a.children[i], b.children[i])) return false;
+		}
+
+		return true;
+	}
+
+	/// <summary>
+	/// ファイルの中身を読み込む
+	/// </summary>
+	std::vector<char> ReadBytes(const std::string& filePath) {
+		std::ifstream file(filePath, std::ios::binary);
+		return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	/// <summary>
+	/// ファイルに書き込む
+	/// </summary>
+	void WriteBytes(const std::string& filePath, const std::vector<char>& bytes) {
+		std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+		file.write(bytes.data(), bytes.size());
+	}
+}
+
+TEST_CASE("MeshFile: 書き出したものをそのまま読み戻せる") {
+
+	std::string filePath = MakeTempPath("RoundTrip");
+	ModelData source = MakeModel();
+	std::vector<std::string> textureFileNames = { "", "checker.png", "" };
+
+	REQUIRE(MeshFile::Write(filePath, source, textureFileNames));
+
+	// 一時ファイルは置き換えで消えている
+	CHECK(!std::filesystem::exists(filePath + ".tmp"));
+
+	std::unique_ptr<ModelData> loaded = MeshFile::Read(filePath);
+	REQUIRE(loaded != nullptr);
+
+	REQUIRE(loaded->vertices.size() == source.vertices.size());
+	CHECK(std::memcmp(loaded->vertices.data(), source.vertices.data(), sizeof(VertexData) * source.vertices.size()) == 0);
+	CHECK(loaded->indices == source.indices);
+	CHECK(IsSameNode(loaded->rootNode, source.rootNode));
+
+	// テクスチャはファイル名だけ (探索は呼び出し側)
+	CHECK(loaded->material.textureFilePath == "checker.png");
+
+	std::filesystem::remove(filePath);
+}
+
+TEST_CASE("MeshFile: テクスチャの無いモデルはファイル名が空になる") {
+
+	std::string filePath = MakeTempPath("NoTexture");
+	ModelData source = MakeModel();
+
+	REQUIRE(MeshFile::Write(filePath, source, {}));
+
+	std::unique_ptr<ModelData> loaded = MeshFile::Read(filePath);
+	REQUIRE(loaded != nullptr);
+	CHECK(loaded->material.textureFilePath.empty());
+	CHECK(loaded->indices.size() == 6);
+
+	std::filesystem::remove(filePath);
+}
+
+TEST_CASE("MeshFile: 識別子やバージョンが違うファイルは読まない") {
+
+	std::string filePath = MakeTempPath("BadHeader");
+	REQUIRE(MeshFile::Write(filePath, MakeModel(), {}));
+	std::vector<char> bytes = ReadBytes(filePath);
+
+	// 識別子を壊す
+	std::vector<char> badMagic = bytes;
+	badMagic[0] ^= 0x7F;
+	WriteBytes(filePath, badMagic);
+	CHECK(MeshFile::Read(filePath) == nullptr);
+
+	// バージョンを上げる
+	std::vector<char> badVersion = bytes;
+	uint32_t version = MeshFileFormat::kVersion + 1;
+	std::memcpy(badVersion.data() + offsetof(MeshFileFormat::Header, version), &version, sizeof(version));
+	WriteBytes(filePath, badVersion);
+	CHECK(MeshFile::Read(filePath) == nullptr);
+
+	std::filesystem::remove(filePath);
+}
+
+TEST_CASE("MeshFile: 途中で切れたファイルは範囲外を読まずに失敗する") {
+
+	std::string filePath = MakeTempPath("Truncated");
+	REQUIRE(MeshFile::Write(filePath, MakeModel(), std::vector<std::string>{ "checker.png" }));
+	std::vector<char> bytes = ReadBytes(filePath);
+
+	// ヘッダーの途中、頂点の途中、文字列テーブルの途中で切る
+	for (size_t size : { sizeof(MeshFileFormat::Header) / 2, sizeof(MeshFileFormat::Header) + sizeof(VertexData) * 2, bytes.size() - 1 }) {
+		WriteBytes(filePath, std::vector<char>(bytes.begin(), bytes.begin() + size));
+		CHECK(MeshFile::Read(filePath) == nullptr);
+	}
+
+	std::filesystem::remove(filePath);
+}
+
+TEST_CASE("MeshFile: 存在しないファイルはnullptrを返す") {
+
+	CHECK(MeshFile::Read(MakeTempPath("DoesNotExist")) == nullptr);
+}
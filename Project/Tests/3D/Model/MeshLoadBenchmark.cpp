@@ -0,0 +1,180 @@
+#include "TestFramework.h"
+#include "Model/MeshFile.h"
+#include "Data/MeshFileFormat.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+/// クック済みメッシュの読み込みと.objのテキスト解析を比べる
+/// 比べる相手はAssimpではなく最小限のOBJパーサー (Assimpはこれより遅いので、差は下限になる)
+
+namespace {
+
+	/// <summary>
+	/// 最小限のOBJパーサー (v / vt / vn / 三角形のf だけを扱う)
+	/// </summary>
+	ModelData ParseObj(const std::string& filePath) {
+
+		ModelData modelData;
+		std::vector<Vector4> positions;
+		std::vector<Vector3> normals;
+		std::vector<Vector2> texcoords;
+
+		std::ifstream file(filePath);
+		std::string line;
+
+		while (std::getline(file, line)) {
+
+			std::istringstream stream(line);
+			std::string identifier;
+			stream >> identifier;
+
+			if (identifier == "v") {
+				Vector4 position{};
+				stream >> position.x >> position.y >> position.z;
+				position.x *= -1.0f;
+				position.w = 1.0f;
+				positions.push_back(position);
+			}
+			else if (identifier == "vt") {
+				Vector2 texcoord{};
+				stream >> texcoord.x >> texcoord.y;
+				texcoord.y = 1.0f - texcoord.y;
+				texcoords.push_back(texcoord);
+			}
+			else if (identifier == "vn") {
+				Vector3 normal{};
+				stream >> normal.x >> normal.y >> normal.z;
+				normal.x *= -1.0f;
+				normals.push_back(normal);
+			}
+			else if (identifier == "f") {
+
+				for (int32_t faceVertex = 0; faceVertex < 3; ++faceVertex) {
+
+					std::string vertexDefinition;
+					stream >> vertexDefinition;
+
+					// "位置/UV/法線" を分解する (省略されていたら0)
+					uint32_t elementIndices[3] = {};
+					std::istringstream vertexStream(vertexDefinition);
+					for (int32_t element = 0; element < 3; ++element) {
+						std::string index;
+						std::getline(vertexStream, index, '/');
+						elementIndices[element] = index.empty() ? 0 : static_cast<uint32_t>(std::stoul(index));
+					}
+
+					VertexData vertex{};
+					if (elementIndices[0]) vertex.position = positions[elementIndices[0] - 1];
+					if (elementIndices[1]) vertex.texcoord = texcoords[elementIndices[1] - 1];
+					if (elementIndices[2]) vertex.normal = normals[elementIndices[2] - 1];
+
+					modelData.indices.push_back(static_cast<uint32_t>(modelData.vertices.size()));
+					modelData.vertices.push_back(vertex);
+				}
+			}
+		}
+
+		modelData.rootNode.name = std::filesystem::path(filePath).stem().string();
+		return modelData;
+	}
+
+	/// <summary>
+	/// 格子状の地形をOBJとして書き出す (大きいメッシュでの差を見るため)
+	/// </summary>
+	void WriteGridObj(const std::string& filePath, uint32_t division) {
+
+		std::ofstream file(filePath, std::ios::trunc);
+
+		for (uint32_t z = 0; z <= division; ++z) {
+			for (uint32_t x = 0; x <= division; ++x) {
+				file << "v " << float(x) << " " << float((x * 7 + z * 13) % 5) * 0.1f << " " << float(z) << "\n";
+				file << "vt " << float(x) / division << " " << float(z) / division << "\n";
+				file << "vn 0 1 0\n";
+			}
+		}
+
+		for (uint32_t z = 0; z < division; ++z) {
+			for (uint32_t x = 0; x < division; ++x) {
+				uint32_t i0 = z * (division + 1) + x + 1;
+				uint32_t i1 = i0 + 1;
+				uint32_t i2 = i0 + division + 1;
+				uint32_t i3 = i2 + 1;
+				file << "f " << i0 << "/" << i0 << "/" << i0 << " " << i2 << "/" << i2 << "/" << i2 << " " << i1 << "/" << i1 << "/" << i1 << "\n";
+				file << "f " << i1 << "/" << i1 << "/" << i1 << " " << i2 << "/" << i2 << "/" << i2 << " " << i3 << "/" << i3 << "/" << i3 << "\n";
+			}
+		}
+	}
+
+	/// <summary>
+	/// OBJの解析とクック済みの読み込みを計測して出力する
+	/// </summary>
+	void Compare(const std::string& label, const std::string& objPath, uint32_t iterations, double& totalObj, double& totalCooked) {
+
+		std::string cookedPath = (std::filesystem::temp_directory_path() / ("MeshLoadBenchmark_" + label + MeshFileFormat::kExtension)).string();
+		ModelData source = ParseObj(objPath);
+		REQUIRE(MeshFile::Write(cookedPath, source, {}));
+
+		double objTime = TestFramework::MeasureMilliseconds(iterations, [&]() {
+			ModelData modelData = ParseObj(objPath);
+			TestFramework::DoNotOptimize(modelData);
+		});
+
+		double cookedTime = TestFramework::MeasureMilliseconds(iterations, [&]() {
+			std::unique_ptr<ModelData> modelData = MeshFile::Read(cookedPath);
+			REQUIRE(modelData != nullptr);
+			REQUIRE(modelData->vertices.size() == source.vertices.size());
+		});
+
+		TestFramework::ReportMeasurement(label + " (" + std::to_string(source.vertices.size()) + " verts) obj", objTime, "ms");
+		TestFramework::ReportMeasurement(label + " cooked", cookedTime, "ms");
+
+		totalObj += objTime;
+		totalCooked += cookedTime;
+
+		std::filesystem::remove(cookedPath);
+	}
+}
+
+TEST_CASE("MeshLoad: Resources/Modelsの.obj と クック済み") {
+
+	double totalObj = 0.0;
+	double totalCooked = 0.0;
+	uint32_t modelCount = 0;
+
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(ENGINE_RESOURCES_DIR "/Models")) {
+
+		if (entry.path().extension() != ".obj") continue;
+
+		Compare(entry.path().stem().string(), entry.path().string(), 20, totalObj, totalCooked);
+		modelCount++;
+	}
+
+	REQUIRE(modelCount > 0);
+	TestFramework::ReportMeasurement("total obj", totalObj, "ms");
+	TestFramework::ReportMeasurement("total cooked", totalCooked, "ms");
+	TestFramework::ReportMeasurement("speedup", totalObj / totalCooked, "x");
+
+	// クック済みの方が速いこと (テキスト解析が無いので桁で違うはず)
+	CHECK(totalCooked < totalObj);
+}
+
+TEST_CASE("MeshLoad: 256x256の格子 (約39万頂点)") {
+
+	std::string objPath = (std::filesystem::temp_directory_path() / "MeshLoadBenchmark_Grid.obj").string();
+	WriteGridObj(objPath, 256);
+
+	double totalObj = 0.0;
+	double totalCooked = 0.0;
+	Compare("Grid256", objPath, 3, totalObj, totalCooked);
+	TestFramework::ReportMeasurement("speedup", totalObj / totalCooked, "x");
+
+	CHECK(totalCooked < totalObj);
+
+	std::filesystem::remove(objPath);
+}
@@ -0,0 +1,174 @@
+#include "TestFramework.h"
+#include "Object/InstanceBatcher.h"
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+	/// <summary>
+	/// バッチが並べた番号を取り出す
+	/// </summary>
+	std::vector<uint32_t> GetBatchInstances(const InstanceBatcher& batcher, const InstanceBatcher::Batch& batch) {
+		const std::vector<uint32_t>& instances = batcher.GetInstances();
+		return std::vector<uint32_t>(instances.begin() + batch.first, instances.begin() + batch.first + batch.count);
+	}
+}
+
+TEST_CASE("InstanceBatcher: 同じキーの描画要求は1つのバッチにまとまり、バッチはキー順に並ぶ") {
+
+	InstanceBatcher batcher;
+	batcher.Add(30, 0);
+	batcher.Add(10, 1);
+	batcher.Add(20, 2);
+	batcher.Add(10, 3);
+	batcher.Add(30, 4);
+	batcher.Add(10, 5);
+	CHECK(batcher.GetRequestCount() == 6);
+
+	batcher.Build(64);
+
+	const std::vector<InstanceBatcher::Batch>& batches = batcher.GetBatches();
+	REQUIRE(batches.size() == 3);
+	CHECK(batches[0].key == 10);
+	CHECK(batches[1].key == 20);
+	CHECK(batches[2].key == 30);
+
+	// バッチはGetInstancesを隙間なく分け合う
+	CHECK(batches[0].first == 0);
+	CHECK(batches[0].count == 3);
+	CHECK(batches[1].first == 3);
+	CHECK(batches[1].count == 1);
+	CHECK(batches[2].first == 4);
+	CHECK(batches[2].count == 2);
+	CHECK(batcher.GetInstances().size() == 6);
+
+	// 同じキーの中は追加した順
+	CHECK(GetBatchInstances(batcher, batches[0]) == std::vector<uint32_t>({ 1, 3, 5 }));
+	CHECK(GetBatchInstances(batcher, batches[1]) == std::vector<uint32_t>({ 2 }));
+	CHECK(GetBatchInstances(batcher, batches[2]) == std::vector<uint32_t>({ 0, 4 }));
+}
+
+TEST_CASE("InstanceBatcher: キーが混ざった大量の描画要求でも同じキーの中は追加した順を保つ") {
+
+	const uint32_t kRequestCount = 10000;
+	const uint32_t kKeyCount = 37;
+
+	InstanceBatcher batcher;
+	std::mt19937 random(2024);
+
+	// キーごとに追加した順を覚えておく
+	std::map<uint64_t, std::vector<uint32_t>> expected;
+	for (uint32_t i = 0; i < kRequestCount; ++i) {
+		uint64_t key = InstanceBatcher::HashCombine(InstanceBatcher::kHashSeed, random() % kKeyCount);
+		batcher.Add(key, i);
+		expected[key].push_back(i);
+	}
+
+	batcher.Build(kRequestCount);
+
+	// キーごとに1つのバッチ、中身は追加した順
+	const std::vector<InstanceBatcher::Batch>& batches = batcher.GetBatches();
+	REQUIRE(batches.size() == expected.size());
+
+	size_t batchIndex = 0;
+	for (const auto& [key, instances] : expected) {
+		CHECK(batches[batchIndex].key == key);
+		CHECK(GetBatchInstances(batcher, batches[batchIndex]) == instances);
+		batchIndex++;
+	}
+}
+
+TEST_CASE("InstanceBatcher: 1回の描画の上限を超えたら同じキーでもバッチを分ける") {
+
+	const uint32_t kMaxInstances = 4;
+
+	InstanceBatcher batcher;
+	for (uint32_t i = 0; i < 10; ++i) {
+		batcher.Add(7, i);
+	}
+	batcher.Add(3, 100);
+
+	batcher.Build(kMaxInstances);
+
+	// キー3が1つ、キー7が4 + 4 + 2
+	const std::vector<InstanceBatcher::Batch>& batches = batcher.GetBatches();
+	REQUIRE(batches.size() == 4);
+	CHECK(batches[0].key == 3);
+	CHECK(batches[0].count == 1);
+
+	uint32_t expectedInstance = 0;
+	for (size_t i = 1; i < batches.size(); ++i) {
+
+		CHECK(batches[i].key == 7);
+		CHECK(batches[i].count <= kMaxInstances);
+		CHECK(batches[i].first == batches[i - 1].first + batches[i - 1].count);
+
+		// 分けた後も追加した順に続く
+		for (uint32_t instance : GetBatchInstances(batcher, batches[i])) {
+			CHECK(instance == expectedInstance);
+			expectedInstance++;
+		}
+	}
+	CHECK(batches[1].count == 4);
+	CHECK(batches[2].count == 4);
+	CHECK(batches[3].count == 2);
+	CHECK(expectedInstance == 10);
+
+	// 上限ちょうどなら分けない
+	batcher.Clear();
+	for (uint32_t i = 0; i < kMaxInstances; ++i) {
+		batcher.Add(7, i);
+	}
+	batcher.Build(kMaxInstances);
+	REQUIRE(batcher.GetBatches().size() == 1);
+	CHECK(batcher.GetBatches()[0].count == kMaxInstances);
+}
+
+TEST_CASE("InstanceBatcher: Clearは描画要求を捨てるが確保済みの領域は使い回す") {
+
+	const uint32_t kRequestCount = 1000;
+
+	InstanceBatcher batcher;
+
+	// 1フレーム目で領域を確保させる
+	for (uint32_t i = 0; i < kRequestCount; ++i) {
+		batcher.Add(i % 10, i);
+	}
+	batcher.Build(16);
+
+	const uint32_t* instancesData = batcher.GetInstances().data();
+	const InstanceBatcher::Batch* batchesData = batcher.GetBatches().data();
+	size_t instancesCapacity = batcher.GetInstances().capacity();
+	size_t batchesCapacity = batcher.GetBatches().capacity();
+
+	// 同じ数の描画要求を何フレーム繰り返しても作り直さない
+	for (uint32_t frame = 0; frame < 8; ++frame) {
+
+		batcher.Clear();
+		CHECK(batcher.GetRequestCount() == 0);
+		CHECK(batcher.GetBatches().empty());
+		CHECK(batcher.GetInstances().empty());
+
+		for (uint32_t i = 0; i < kRequestCount; ++i) {
+			batcher.Add((i + frame) % 10, i);
+		}
+		batcher.Build(16);
+
+		CHECK(batcher.GetInstances().size() == kRequestCount);
+		CHECK(batcher.GetInstances().data() == instancesData);
+		CHECK(batcher.GetBatches().data() == batchesData);
+		CHECK(batcher.GetInstances().capacity() == instancesCapacity);
+		CHECK(batcher.GetBatches().capacity() == batchesCapacity);
+	}
+
+	// 何も追加しなければバッチは無い
+	batcher.Clear();
+	batcher.Build(16);
+	CHECK(batcher.GetBatches().empty());
+	CHECK(batcher.GetInstances().capacity() == instancesCapacity);
+}
@@ -0,0 +1,160 @@
+#include "TestFramework.h"
+#include "AssetHandle.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+	// テスト用のアセット
+	struct FakeAsset {
+		std::string name;
+	};
+
+	/// <summary>
+	/// 1件100バイトとしてアセットを追加する
+	/// </summary>
+	void Insert(AssetCache<FakeAsset>& cache, AssetID id, const char* name) {
+		cache.Insert(id, FakeAsset{ name }, 100);
+	}
+}
+
+TEST_CASE("AssetCache: 予算を超えたら参照されていないものを古い順に追い出す") {
+
+	AssetCache<FakeAsset> cache;
+	Insert(cache, 1, "A");
+	Insert(cache, 2, "B");
+	Insert(cache, 3, "C");
+
+	// Aを使ったのでBが一番古い
+	CHECK(cache.Find(1) != nullptr);
+
+	std::vector<std::string> evicted;
+	cache.SetMemoryBudget(200);
+	cache.Trim([&](FakeAsset& asset) { evicted.push_back(asset.name); });
+
+	REQUIRE(evicted.size() == 1);
+	CHECK(evicted[0] == "B");
+	CHECK(cache.GetStats().bytesResident == 200);
+	CHECK(cache.GetStats().evictionCount == 1);
+}
+
+TEST_CASE("AssetCache: Getは統計もLRUも変えないので、書き換えていない間は複数のスレッドから引ける") {
+
+	AssetCache<FakeAsset> cache;
+	Insert(cache, 1, "A");
+	Insert(cache, 2, "B");
+	Insert(cache, 3, "C");
+
+	// 描画中のように複数のスレッドから同時に引く (見つからない番号も混ぜる)
+	const AssetCache<FakeAsset>& constCache = cache;
+	std::atomic<uint32_t> foundCount = 0;
+	std::vector<std::thread> threads;
+	for (uint32_t thread = 0; thread < 4; ++thread) {
+		threads.emplace_back([&constCache, &foundCount]() {
+			for (AssetID id = 0; id < 1000; ++id) {
+				if (constCache.Get(id % 4 + 1)) {
+					foundCount++;
+				}
+			}
+		});
+	}
+	for (std::thread& thread : threads) thread.join();
+
+	// 1〜3は見つかり、4は見つからない
+	CHECK(foundCount == 4 * 750);
+
+	// 統計は変わらない
+	CHECK(cache.GetStats().hitCount == 0);
+	CHECK(cache.GetStats().missCount == 0);
+
+	// LRUも変わらないので、Aが一番古いまま
+	std::vector<std::string> evicted;
+	cache.SetMemoryBudget(200);
+	cache.Trim([&](FakeAsset& asset) { evicted.push_back(asset.name); });
+
+	REQUIRE(evicted.size() == 1);
+	CHECK(evicted[0] == "A");
+}
+
+TEST_CASE("AssetCache: ハンドルを持っている間は予算を超えても追い出さない") {
+
+	auto cache = std::make_shared<AssetCache<FakeAsset>>();
+	Insert(*cache, 1, "A");
+	Insert(*cache, 2, "B");
+
+	{
+		AssetHandle<FakeAsset> handle(cache, 1);
+		AssetHandle<FakeAsset> copy = handle;
+		CHECK(cache->GetRefCount(1) == 2);
+
+		cache->SetMemoryBudget(0);
+		cache->Trim([](FakeAsset&) {});
+
+		CHECK(cache->Contains(1));
+		CHECK(!cache->Contains(2));
+		CHECK(copy->name == "A");
+	}
+
+	// 手放したので追い出せる
+	CHECK(cache->GetRefCount(1) == 0);
+	cache->Trim([](FakeAsset&) {});
+	CHECK(!cache->Contains(1));
+}
+
+TEST_CASE("AssetCache: キャッシュが先に破棄されてもハンドルは安全") {
+
+	AssetHandle<FakeAsset> handle;
+	{
+		auto cache = std::make_shared<AssetCache<FakeAsset>>();
+		Insert(*cache, 1, "A");
+		handle = AssetHandle<FakeAsset>(cache, 1);
+		CHECK(handle.Get() != nullptr);
+	}
+
+	CHECK(handle.Get() == nullptr);
+	handle.Reset();
+}
+
+TEST_CASE("AssetCache: シーン切り替え (新しいシーンがハンドルを取ってから追い出す)") {
+
+	// SceneManager::Updateと同じ順番で進める
+	auto cache = std::make_shared<AssetCache<FakeAsset>>();
+	cache->SetMemoryBudget(200);
+
+	// 前のシーンが使っていたアセット
+	Insert(*cache, 1, "OldA");
+	Insert(*cache, 2, "OldB");
+	auto oldScene = std::make_unique<std::vector<AssetHandle<FakeAsset>>>();
+	oldScene->emplace_back(cache, 1);
+	oldScene->emplace_back(cache, 2);
+
+	// 遷移中に次のシーンのアセットを先読みする (まだ誰も参照していない)
+	Insert(*cache, 3, "NewC");
+	Insert(*cache, 4, "NewD");
+
+	// 前のシーンを終了
+	oldScene.reset();
+
+	// 次のシーンを初期化 (先読みしたアセットのハンドルを取る)
+	std::vector<AssetHandle<FakeAsset>> newScene;
+	newScene.emplace_back(cache, 3);
+	newScene.emplace_back(cache, 4);
+
+	// 追い出す
+	std::vector<std::string> evicted;
+	cache->Trim([&](FakeAsset& asset) { evicted.push_back(asset.name); });
+
+	// 前のシーンの分だけが追い出され、先読みしたものは残る
+	CHECK(evicted.size() == 2);
+	CHECK(!cache->Contains(1));
+	CHECK(!cache->Contains(2));
+	CHECK(cache->Contains(3));
+	CHECK(cache->Contains(4));
+	CHECK(cache->GetStats().bytesResident <= cache->GetMemoryBudget());
+}
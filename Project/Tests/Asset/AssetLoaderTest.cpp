@@ -0,0 +1,216 @@
+#include "TestFramework.h"
+#include "AssetLoader.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+	/// === テスト用の転送先 === ///
+	/// デコードした名前と呼ばれたスレッドを記録するだけで、GPUやファイルには触らない
+	/// 名前に"broken"を含むものはデコードに失敗する
+	class FakeUploadSink : public IAssetUploadSink {
+	public:
+
+		// デコードしたテクスチャ
+		struct FakeTexture : DecodedTexture {
+			std::string filePath;
+		};
+
+		std::unique_ptr<DecodedTexture> DecodeTexture(const std::string& filePath) override {
+
+			RecordDecode();
+			if (filePath.find("broken") != std::string::npos) return nullptr;
+
+			std::unique_ptr<FakeTexture> texture = std::make_unique<FakeTexture>();
+			texture->filePath = filePath;
+			return texture;
+		}
+
+		std::unique_ptr<ModelData> DecodeModel(const std::string& directoryName, const std::string& fileName) override {
+
+			RecordDecode();
+			if (fileName.find("broken") != std::string::npos) return nullptr;
+
+			// ディレクトリ名をそのままモデルが使うテクスチャにする
+			std::unique_ptr<ModelData> modelData = std::make_unique<ModelData>();
+			modelData->material.textureFilePath = directoryName;
+			return modelData;
+		}
+
+		void UploadTexture(const std::string& filePath, DecodedTexture& texture) override {
+
+			CHECK(std::this_thread::get_id() == mainThreadId);
+			CHECK(static_cast<FakeTexture&>(texture).filePath == filePath);
+			textures.insert(filePath);
+			uploadCount++;
+		}
+
+		void UploadModel(const std::string& directoryName, const std::string& fileName, std::unique_ptr<ModelData>) override {
+
+			CHECK(std::this_thread::get_id() == mainThreadId);
+			models.insert(directoryName + "/" + fileName);
+			uploadCount++;
+		}
+
+		bool IsTextureLoaded(const std::string& filePath) const override { return textures.contains(filePath); }
+
+		bool IsModelLoaded(const std::string& directoryName, const std::string& fileName) const override { return models.contains(directoryName + "/" + fileName); }
+
+		std::vector<std::string> TakeMissingTextures() override { return std::exchange(missingTextures, {}); }
+
+		std::string GetTextureDirectoryPath() const override { return "Textures"; }
+
+		/// <summary>
+		/// デコードを呼んだスレッドを記録する (ワーカースレッドから呼ばれる)
+		/// </summary>
+		void RecordDecode() {
+			std::lock_guard<std::mutex> lock(decodeMutex);
+			decodeThreadIds.push_back(std::this_thread::get_id());
+			decodeCount++;
+		}
+
+		std::thread::id mainThreadId = std::this_thread::get_id();
+		std::mutex decodeMutex;
+		std::vector<std::thread::id> decodeThreadIds;
+		std::atomic<uint32_t> decodeCount = 0;
+		uint32_t uploadCount = 0;
+		std::unordered_set<std::string> textures;
+		std::unordered_set<std::string> models;
+		std::vector<std::string> missingTextures;
+	};
+
+	/// <summary>
+	/// futureが例外で終わったか
+	/// </summary>
+	bool IsFailed(const std::shared_future<void>& future) {
+		try {
+			future.get();
+		}
+		catch (const std::runtime_error&) {
+			return true;
+		}
+		return false;
+	}
+}
+
+TEST_CASE("AssetLoader: デコードはワーカースレッドで行い、転送はメインスレッドで行う") {
+
+	FakeUploadSink sink;
+	AssetLoader* loader = AssetLoader::GetInstance();
+	loader->Initialize(&sink, 2);
+
+	std::shared_future<void> a = loader->RequestTexture("Textures/a.png");
+	std::shared_future<void> b = loader->RequestTextureRelative("b.png");
+	std::shared_future<void> model = loader->RequestModel("Textures/c.png", "model.obj");
+
+	// 読み込み中の同じ要求は積まない (デコードの回数で確かめる)
+	loader->RequestTexture("Textures/a.png");
+
+	loader->WaitAll();
+	CHECK(loader->IsIdle());
+	CHECK(!IsFailed(a));
+	CHECK(!IsFailed(b));
+	CHECK(!IsFailed(model));
+
+	// モデルが使うテクスチャも先に読み込まれている
+	CHECK(sink.textures.contains("Textures/a.png"));
+	CHECK(sink.textures.contains("Textures/b.png"));
+	CHECK(sink.textures.contains("Textures/c.png"));
+	CHECK(sink.models.contains("Textures/c.png/model.obj"));
+
+	// デコードは全てワーカースレッド
+	CHECK(sink.decodeCount == 4);
+	for (std::thread::id threadId : sink.decodeThreadIds) {
+		CHECK(threadId != sink.mainThreadId);
+	}
+
+	// 転送済みならデコードせずに完了済みのfutureを返す
+	std::shared_future<void> again = loader->RequestTexture("Textures/a.png");
+	CHECK(again.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+	CHECK(sink.decodeCount == 4);
+
+	loader->Finalize();
+}
+
+TEST_CASE("AssetLoader: 1フレームに転送するのは上限の数まで") {
+
+	const uint32_t kRequestCount = 20;
+
+	FakeUploadSink sink;
+	AssetLoader* loader = AssetLoader::GetInstance();
+	loader->Initialize(&sink, 2);
+
+	std::vector<std::shared_future<void>> futures;
+	for (uint32_t i = 0; i < kRequestCount; ++i) {
+		futures.push_back(loader->RequestTexture("Textures/" + std::to_string(i) + ".png"));
+	}
+
+	// 全てデコードされるまで待つ
+	while (sink.decodeCount < kRequestCount) {
+		std::this_thread::yield();
+	}
+
+	// 1フレームごとに上限を超えない
+	uint32_t frameCount = 0;
+	while (!loader->IsIdle()) {
+
+		uint32_t uploadCount = sink.uploadCount;
+		loader->Update();
+		CHECK(sink.uploadCount - uploadCount <= AssetLoader::kMaxUploadsPerFrame);
+
+		frameCount++;
+		REQUIRE(frameCount < 10000);
+	}
+
+	CHECK(sink.uploadCount == kRequestCount);
+	CHECK(frameCount >= (kRequestCount + AssetLoader::kMaxUploadsPerFrame - 1) / AssetLoader::kMaxUploadsPerFrame);
+
+	loader->Finalize();
+}
+
+TEST_CASE("AssetLoader: 読み込めなかったらfutureに例外を入れ、次の要求で読み直す") {
+
+	FakeUploadSink sink;
+	AssetLoader* loader = AssetLoader::GetInstance();
+	loader->Initialize(&sink, 1);
+
+	std::shared_future<void> texture = loader->RequestTexture("Textures/broken.png");
+	std::shared_future<void> model = loader->RequestModel("Models", "broken.obj");
+
+	// テクスチャが読めなくてもモデルはテクスチャ無しで転送する
+	std::shared_future<void> modelWithBrokenTexture = loader->RequestModel("Textures/broken2.png", "model.obj");
+
+	loader->WaitAll();
+	CHECK(loader->IsIdle());
+	CHECK(IsFailed(texture));
+	CHECK(IsFailed(model));
+	CHECK(!IsFailed(modelWithBrokenTexture));
+	CHECK(!sink.textures.contains("Textures/broken.png"));
+	CHECK(!sink.models.contains("Models/broken.obj"));
+	CHECK(sink.models.contains("Textures/broken2.png/model.obj"));
+
+	// 失敗したものは読み込み中から外れているので、もう一度要求すると読み直す
+	uint32_t decodeCount = sink.decodeCount;
+	std::shared_future<void> retry = loader->RequestTexture("Textures/broken.png");
+	loader->WaitAll();
+	CHECK(IsFailed(retry));
+	CHECK(sink.decodeCount == decodeCount + 1);
+
+	// 描画時に見つからなかったテクスチャはUpdateで要求される
+	sink.missingTextures.push_back("Textures/missing.png");
+	loader->Update();
+	loader->WaitAll();
+	CHECK(sink.textures.contains("Textures/missing.png"));
+
+	loader->Finalize();
+}
@@ -0,0 +1,196 @@
+#include "TestFramework.h"
+#include "CommandRecorder.h"
+#include "RecordingCommandBackend.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace Engine;
+
+/// RecordingCommandBackendで、ワーカースレッドが記録したコマンドリストが追加した順で送信され、各リストが1つのスレッドだけで記録されることを確かめる
+
+namespace {
+
+	// プロローグが記録する値
+	const uint32_t kPrologueValue = 1000;
+
+	// 1つの記録処理が記録する値の数
+	const uint32_t kValuesPerTask = 5;
+
+	/// <summary>
+	/// 記録処理が書き込む値
+	/// </summary>
+	uint32_t MakeValue(uint32_t task, uint32_t value) {
+		return task * 10 + value;
+	}
+
+	/// <summary>
+	/// 区間内のリストごとに、開始と終了を同じスレッドが呼び、記録処理もそのスレッドで動いたかを確かめる
+	/// </summary>
+	void CheckListOwnership(const RecordingCommandBackend& backend, const std::vector<std::thread::id>& taskThreadIds) {
+
+		std::map<uint32_t, std::thread::id> beginThreads;
+		std::map<uint32_t, std::thread::id> endThreads;
+		std::thread::id mainThreadId = std::this_thread::get_id();
+
+		for (const RecordingCommandBackend::Event& event : backend.GetEvents()) {
+			switch (event.type) {
+			case RecordingCommandBackend::EventType::BeginParallel:
+			case RecordingCommandBackend::EventType::EndParallel:
+				// 区間の開始と終了はメインスレッド
+				CHECK(event.threadId == mainThreadId);
+				break;
+			case RecordingCommandBackend::EventType::BeginList:
+				// 同じリストを2回記録しない
+				CHECK(!beginThreads.contains(event.value));
+				CHECK(!endThreads.contains(event.value));
+				beginThreads[event.value] = event.threadId;
+				break;
+			case RecordingCommandBackend::EventType::EndList:
+				REQUIRE(beginThreads.contains(event.value));
+				CHECK(!endThreads.contains(event.value));
+				endThreads[event.value] = event.threadId;
+				break;
+			}
+		}
+
+		REQUIRE(beginThreads.size() == taskThreadIds.size());
+		REQUIRE(endThreads.size() == taskThreadIds.size());
+		for (uint32_t task = 0; task < taskThreadIds.size(); ++task) {
+			CHECK(beginThreads[task] == taskThreadIds[task]);
+			CHECK(endThreads[task] == taskThreadIds[task]);
+		}
+	}
+}
+
+TEST_CASE("CommandRecorder: 複数のスレッドで記録したリストは追加した順に送信され、区間の前後の逐次のリストに挟まれる") {
+
+	const uint32_t kTaskCount = 8;
+
+	RecordingCommandBackend backend;
+	CommandRecorder recorder;
+	recorder.Initialize(&backend, 4);
+	recorder.SetListPrologue([&backend]() { backend.Record(kPrologueValue); });
+
+	// 区間の前の逐次の記録
+	backend.Record(100);
+
+	// 最初の2つの記録処理は互いが始まるまで待つので、必ず別々のスレッドで記録される
+	std::atomic<uint32_t> startedCount = 0;
+	std::vector<std::thread::id> taskThreadIds(kTaskCount);
+
+	for (uint32_t task = 0; task < kTaskCount; ++task) {
+		recorder.Add("Task", [&, task]() {
+
+			taskThreadIds[task] = std::this_thread::get_id();
+
+			if (task < 2) {
+				startedCount++;
+				std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+				while (startedCount < 2 && std::chrono::steady_clock::now() < deadline) {
+					std::this_thread::yield();
+				}
+			}
+
+			for (uint32_t value = 0; value < kValuesPerTask; ++value) {
+				backend.Record(MakeValue(task, value));
+			}
+		});
+	}
+
+	recorder.Execute();
+
+	// 区間の後の逐次の記録
+	backend.Record(200);
+	backend.Submit();
+
+	// 逐次のリスト、区間のリストが追加した順、区間の後の逐次のリスト (プロローグから始まる)
+	const std::vector<std::vector<uint32_t>>& lists = backend.GetSubmittedLists();
+	REQUIRE(lists.size() == kTaskCount + 2);
+	CHECK(lists.front() == std::vector<uint32_t>({ 100 }));
+	for (uint32_t task = 0; task < kTaskCount; ++task) {
+
+		std::vector<uint32_t> expected = { kPrologueValue };
+		for (uint32_t value = 0; value < kValuesPerTask; ++value) {
+			expected.push_back(MakeValue(task, value));
+		}
+		CHECK(lists[task + 1] == expected);
+	}
+	CHECK(lists.back() == std::vector<uint32_t>({ kPrologueValue, 200 }));
+
+	// 各リストは1つのスレッドが開始から終了まで記録し、複数のスレッドで分担している
+	CheckListOwnership(backend, taskThreadIds);
+	CHECK(taskThreadIds[0] != taskThreadIds[1]);
+	CHECK(std::set<std::thread::id>(taskThreadIds.begin(), taskThreadIds.end()).size() >= 2);
+
+	CHECK(recorder.GetListCount() == kTaskCount);
+
+	recorder.Finalize();
+}
+
+TEST_CASE("CommandRecorder: 毎フレーム記録処理の数が変わっても送信の順とスレッドの区切りが崩れない") {
+
+	const uint32_t kFrameCount = 200;
+
+	RecordingCommandBackend backend;
+	CommandRecorder recorder;
+	recorder.Initialize(&backend, 3);
+	recorder.SetListPrologue([&backend]() { backend.Record(kPrologueValue); });
+
+	for (uint32_t frame = 0; frame < kFrameCount; ++frame) {
+
+		backend.Clear();
+
+		// 1から7個の記録処理
+		const uint32_t taskCount = frame % 7 + 1;
+		std::vector<std::thread::id> taskThreadIds(taskCount);
+
+		for (uint32_t task = 0; task < taskCount; ++task) {
+			recorder.Add("Task", [&, task]() {
+				taskThreadIds[task] = std::this_thread::get_id();
+				for (uint32_t value = 0; value < kValuesPerTask; ++value) {
+					backend.Record(MakeValue(task, value));
+				}
+			});
+		}
+
+		recorder.Execute();
+		backend.Submit();
+
+		// 空の逐次のリスト、区間のリスト、プロローグだけの逐次のリスト
+		const std::vector<std::vector<uint32_t>>& lists = backend.GetSubmittedLists();
+		REQUIRE(lists.size() == taskCount + 2);
+		CHECK(lists.front().empty());
+		for (uint32_t task = 0; task < taskCount; ++task) {
+			REQUIRE(lists[task + 1].size() == kValuesPerTask + 1);
+			CHECK(lists[task + 1].front() == kPrologueValue);
+			CHECK(lists[task + 1].back() == MakeValue(task, kValuesPerTask - 1));
+		}
+		CHECK(lists.back() == std::vector<uint32_t>({ kPrologueValue }));
+
+		CheckListOwnership(backend, taskThreadIds);
+	}
+
+	recorder.Finalize();
+}
+
+TEST_CASE("CommandRecorder: 記録処理がなければ区間を作らない") {
+
+	RecordingCommandBackend backend;
+	CommandRecorder recorder;
+	recorder.Initialize(&backend, 2);
+
+	backend.Record(1);
+	recorder.Execute();
+	backend.Submit();
+
+	CHECK(backend.GetEvents().empty());
+	REQUIRE(backend.GetSubmittedLists().size() == 1);
+	CHECK(backend.GetSubmittedLists()[0] == std::vector<uint32_t>({ 1 }));
+
+	recorder.Finalize();
+}
@@ -0,0 +1,262 @@
+#include "TestFramework.h"
+#include "DescriptorAllocator.h"
+
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+	/// === テスト用のフェンス === ///
+	/// GPUの代わりにテストから完了値を進める。Waitは待つ代わりにその値まで完了させて回数を数える
+	class FakeFence : public IFence {
+
+	public:
+
+		void Signal(uint64_t value) override { signaled = value; }
+
+		uint64_t GetCompletedValue() const override { return completed; }
+
+		void Wait(uint64_t value) override {
+			waitCount++;
+			completed = (std::max)(completed, value);
+		}
+
+		uint64_t signaled = 0;
+		uint64_t completed = 0;
+		uint32_t waitCount = 0;
+	};
+}
+
+TEST_CASE("DescriptorAllocator: 番号を順に確保し、上限で空のハンドルを返す") {
+
+	DescriptorAllocator allocator;
+	allocator.Initialize(3);
+
+	DescriptorHandle a = allocator.Allocate();
+	DescriptorHandle b = allocator.Allocate();
+	DescriptorHandle c = allocator.Allocate();
+
+	CHECK(a.index == 0);
+	CHECK(b.index == 1);
+	CHECK(c.index == 2);
+	CHECK(allocator.GetUsedCount() == 3);
+	CHECK(!allocator.CanAllocate());
+
+	DescriptorHandle full = allocator.Allocate();
+	CHECK(full.IsNull());
+	CHECK(!allocator.IsValid(full));
+}
+
+TEST_CASE("DescriptorAllocator: 解放した番号は再利用され、古いハンドルは無効になる") {
+
+	DescriptorAllocator allocator;
+	allocator.Initialize(2);
+
+	DescriptorHandle first = allocator.Allocate();
+	allocator.Allocate();
+	CHECK(allocator.IsValid(first));
+
+	allocator.Free(first);
+	CHECK(!allocator.IsValid(first));
+	CHECK(allocator.GetUsedCount() == 1);
+	CHECK(allocator.CanAllocate());
+
+	// 同じ番号が別の世代で返る
+	DescriptorHandle reused = allocator.Allocate();
+	CHECK(reused.index == first.index);
+	CHECK(reused.generation != first.generation);
+	CHECK(allocator.IsValid(reused));
+	CHECK(!allocator.IsValid(first));
+}
+
+TEST_CASE("DescriptorAllocator: 空のハンドルや範囲外の番号は無効") {
+
+	DescriptorAllocator allocator;
+	allocator.Initialize(4);
+
+	CHECK(!allocator.IsValid(DescriptorHandle{}));
+	CHECK(!allocator.IsValid(DescriptorHandle{ 0, 1 }));
+
+	allocator.Allocate();
+	CHECK(allocator.IsValid(DescriptorHandle{ 0, 1 }));
+	CHECK(!allocator.IsValid(DescriptorHandle{ 1, 1 }));
+	CHECK(!allocator.IsValid(DescriptorHandle{ 100, 1 }));
+}
+
+TEST_CASE("DescriptorAllocator: 1万回の確保と解放を繰り返しても番号が重複せず、古いハンドルを検出できる") {
+
+	const uint32_t kCount = 512;
+	const uint32_t kIterations = 10000;
+
+	DescriptorAllocator allocator;
+	allocator.Initialize(kCount);
+
+	std::mt19937 random(12345);
+	std::vector<DescriptorHandle> live;
+	std::vector<DescriptorHandle> freed;
+
+	for (uint32_t i = 0; i < kIterations; ++i) {
+
+		// 半分より少なければ確保寄り、多ければ解放寄りにして満杯と空の両方を通る
+		bool allocate = live.empty() || (allocator.CanAllocate() && random() % kCount >= live.size() / 2);
+
+		if (allocate) {
+			DescriptorHandle handle = allocator.Allocate();
+			REQUIRE(!handle.IsNull());
+			REQUIRE(handle.index < kCount);
+			live.push_back(handle);
+		}
+		else {
+			size_t slot = random() % live.size();
+			allocator.Free(live[slot]);
+			freed.push_back(live[slot]);
+			live[slot] = live.back();
+			live.pop_back();
+		}
+
+		REQUIRE(allocator.GetUsedCount() == live.size());
+	}
+
+	// 生きているハンドルは全て有効で、番号が重複していない
+	std::unordered_set<uint32_t> indices;
+	for (const DescriptorHandle& handle : live) {
+		CHECK(allocator.IsValid(handle));
+		CHECK(indices.insert(handle.index).second);
+	}
+
+	// 解放したハンドルは番号が再利用されていても全て無効
+	for (const DescriptorHandle& handle : freed) {
+		CHECK(!allocator.IsValid(handle));
+	}
+
+	// 全て解放すれば上限まで確保できる
+	for (const DescriptorHandle& handle : live) allocator.Free(handle);
+	CHECK(allocator.GetUsedCount() == 0);
+
+	for (uint32_t i = 0; i < kCount; ++i) {
+		REQUIRE(!allocator.Allocate().IsNull());
+	}
+	CHECK(!allocator.CanAllocate());
+}
+
+TEST_CASE("DescriptorAllocator: 一時領域は常駐領域の後ろにフレームごとに並び、1フレーム分を超えると確保できない") {
+
+	const uint32_t kCount = 8;
+	const uint32_t kTransientCount = 4;
+
+	FakeFence fence;
+	FrameContext frameContext;
+	frameContext.Initialize(&fence, 2, 0);
+
+	DescriptorAllocator allocator;
+	allocator.Initialize(kCount, &frameContext, kTransientCount);
+	CHECK(allocator.GetTotalCount() == kCount + kTransientCount * 2);
+
+	// フレーム0の範囲は常駐領域の直後から
+	CHECK(allocator.AllocateTransient(3) == kCount);
+	CHECK(allocator.AllocateTransient(2) == UINT32_MAX);
+	CHECK(allocator.AllocateTransient(1) == kCount + 3);
+	CHECK(allocator.AllocateTransient(1) == UINT32_MAX);
+	CHECK(allocator.AllocateTransient(0) == UINT32_MAX);
+
+	// 一時領域は常駐領域の番号を減らさない
+	CHECK(allocator.GetUsedCount() == 0);
+	CHECK(allocator.Allocate().index == 0);
+
+	// フレーム1は隣の範囲を最初から使う
+	frameContext.EndFrame();
+	CHECK(frameContext.BeginFrame() == 1);
+	CHECK(allocator.AllocateTransient(kTransientCount) == kCount + kTransientCount);
+	CHECK(allocator.AllocateTransient(1) == UINT32_MAX);
+
+	// フレームコンテキストを持たなければ一時領域は無い
+	DescriptorAllocator staticOnly;
+	staticOnly.Initialize(kCount);
+	CHECK(staticOnly.GetTotalCount() == kCount);
+	CHECK(staticOnly.AllocateTransient(1) == UINT32_MAX);
+}
+
+TEST_CASE("DescriptorAllocator: 一時領域はGPUがそのフレームを使い終わってから同じ範囲を使い直す") {
+
+	const uint32_t kCount = 8;
+	const uint32_t kTransientCount = 4;
+
+	FakeFence fence;
+	FrameContext frameContext;
+	frameContext.Initialize(&fence, 2, 0);
+
+	DescriptorAllocator allocator;
+	allocator.Initialize(kCount, &frameContext, kTransientCount);
+
+	// フレーム0とフレーム1を使い切って送る
+	CHECK(allocator.AllocateTransient(kTransientCount) == kCount);
+	frameContext.EndFrame();
+	frameContext.BeginFrame();
+	CHECK(allocator.AllocateTransient(kTransientCount) == kCount + kTransientCount);
+	frameContext.EndFrame();
+
+	// フレーム0に戻るときは、GPUがフレーム0を使い終わるのを待ってから範囲を使い直す
+	CHECK(frameContext.BeginFrame() == 0);
+	CHECK(fence.waitCount == 1);
+	CHECK(fence.completed >= 1);
+	CHECK(allocator.AllocateTransient(1) == kCount);
+	CHECK(allocator.AllocateTransient(kTransientCount - 1) == kCount + 1);
+	CHECK(allocator.AllocateTransient(1) == UINT32_MAX);
+}
+
+TEST_CASE("DescriptorAllocator: 並列記録中の複数のスレッドから一時領域を確保しても番号が重複しない") {
+
+	const uint32_t kCount = 16;
+	const uint32_t kThreadCount = 4;
+	const uint32_t kAllocationsPerThread = 16;
+	const uint32_t kTransientCount = kThreadCount * kAllocationsPerThread;
+
+	FakeFence fence;
+	FrameContext frameContext;
+	frameContext.Initialize(&fence, 2, 0);
+
+	DescriptorAllocator allocator;
+	allocator.Initialize(kCount, &frameContext, kTransientCount);
+
+	// 2フレーム分繰り返して、フレームが変わったときの使い直しも並列で通る
+	for (uint32_t frame = 0; frame < 2; ++frame) {
+
+		std::mutex indicesMutex;
+		std::vector<uint32_t> indices;
+
+		std::vector<std::thread> threads;
+		for (uint32_t thread = 0; thread < kThreadCount; ++thread) {
+			threads.emplace_back([&]() {
+				std::vector<uint32_t> local;
+				for (uint32_t i = 0; i < kAllocationsPerThread; ++i) {
+					local.push_back(allocator.AllocateTransient());
+				}
+				std::lock_guard<std::mutex> lock(indicesMutex);
+				indices.insert(indices.end(), local.begin(), local.end());
+			});
+		}
+		for (std::thread& thread : threads) thread.join();
+
+		// 全て記録中のフレームの範囲に収まり、重複しない
+		uint32_t begin = kCount + kTransientCount * frameContext.GetFrameIndex();
+		std::unordered_set<uint32_t> unique;
+		for (uint32_t index : indices) {
+			CHECK(begin <= index);
+			CHECK(index < begin + kTransientCount);
+			CHECK(unique.insert(index).second);
+		}
+		CHECK(unique.size() == kTransientCount);
+
+		// 使い切ったら確保できない
+		CHECK(allocator.AllocateTransient() == UINT32_MAX);
+
+		frameContext.EndFrame();
+		frameContext.BeginFrame();
+	}
+}
@@ -0,0 +1,209 @@
+#include "TestFramework.h"
+#include "FrameContext.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+	/// === テスト用のフェンス === ///
+	/// GPUの代わりにテストから完了値を進める。Waitは待つ代わりにその値まで完了させて回数を数える
+	class FakeFence : public IFence {
+
+	public:
+
+		void Signal(uint64_t value) override { signaled = value; }
+
+		uint64_t GetCompletedValue() const override { return completed; }
+
+		void Wait(uint64_t value) override {
+			waitCount++;
+			completed = (std::max)(completed, value);
+		}
+
+		// GPUがvalueまで処理した
+		void Complete(uint64_t value) { completed = (std::max)(completed, (std::min)(value, signaled)); }
+
+		uint64_t signaled = 0;
+		uint64_t completed = 0;
+		uint32_t waitCount = 0;
+	};
+}
+
+TEST_CASE("FrameContext: GPUが追いついていればBeginFrameは待たない") {
+
+	FakeFence fence;
+	FrameContext frameContext;
+	frameContext.Initialize(&fence, 2, 0);
+
+	// フレーム0を送る (GPUはまだ処理していない)
+	frameContext.EndFrame();
+	CHECK(fence.signaled == 1);
+
+	// フレーム1は前回使われていないので待たない
+	CHECK(frameContext.BeginFrame() == 1);
+	CHECK(fence.waitCount == 0);
+	frameContext.EndFrame();
+
+	// フレーム0を再び使う前にGPUが終わっていれば待たない
+	fence.Complete(1);
+	CHECK(frameContext.BeginFrame() == 0);
+	CHECK(fence.waitCount == 0);
+	frameContext.EndFrame();
+
+	// フレーム1のGPU処理が終わっていなければ待つ
+	CHECK(frameContext.BeginFrame() == 1);
+	CHECK(fence.waitCount == 1);
+	CHECK(fence.completed == 2);
+
+	frameContext.Finalize();
+}
+
+TEST_CASE("FrameContext: GPUが1フレーム遅れで進む限り、一度も待たずに回り続ける") {
+
+	FakeFence fence;
+	FrameContext frameContext;
+	frameContext.Initialize(&fence, 3, 0);
+
+	for (uint32_t frame = 0; frame < 1000; ++frame) {
+
+		frameContext.EndFrame();
+
+		// GPUは2つ前のフレームまで終わっている (3フレームなら待たなくてよい)
+		if (fence.signaled > 2) fence.Complete(fence.signaled - 2);
+
+		frameContext.BeginFrame();
+	}
+
+	CHECK(fence.waitCount == 0);
+	frameContext.Finalize();
+}
+
+TEST_CASE("FrameContext: 保留した解放はそのフレームのGPU処理が終わってから実行される") {
+
+	FakeFence fence;
+	FrameContext frameContext;
+	frameContext.Initialize(&fence, 2, 0);
+
+	std::vector<int> released;
+
+	frameContext.DeferRelease([&]() { released.push_back(0); });
+	frameContext.EndFrame();
+
+	frameContext.BeginFrame();
+	frameContext.DeferRelease([&]() { released.push_back(1); });
+	frameContext.EndFrame();
+
+	// フレーム0のGPU処理が終わるまでは実行されない
+	CHECK(released.empty());
+
+	fence.Complete(1);
+	frameContext.BeginFrame();
+	REQUIRE(released.size() == 1);
+	CHECK(released[0] == 0);
+
+	// WaitIdleは送信済みのフレーム1を後始末する
+	frameContext.EndFrame();
+	frameContext.WaitIdle();
+	CHECK(released.size() == 2);
+
+	frameContext.Finalize();
+}
+
+TEST_CASE("FrameContext: 記録中のフレームの解放はFinalizeで実行される") {
+
+	FakeFence fence;
+	FrameContext frameContext;
+	frameContext.Initialize(&fence, 2, 0);
+
+	bool released = false;
+	frameContext.DeferRelease([&]() { released = true; });
+
+	// WaitIdleでは記録中のフレームは残る
+	frameContext.WaitIdle();
+	CHECK(!released);
+
+	frameContext.Finalize();
+	CHECK(released);
+}
+
+TEST_CASE("FrameContext: 解放処理の中で保留した解放は次の機会に実行される") {
+
+	FakeFence fence;
+	FrameContext frameContext;
+	frameContext.Initialize(&fence, 2, 0);
+
+	int releaseCount = 0;
+	frameContext.DeferRelease([&]() {
+		releaseCount++;
+		frameContext.DeferRelease([&]() { releaseCount++; });
+	});
+	frameContext.EndFrame();
+	frameContext.BeginFrame();
+	frameContext.EndFrame();
+
+	fence.Complete(2);
+	frameContext.BeginFrame();
+	CHECK(releaseCount == 1);
+
+	frameContext.Finalize();
+	CHECK(releaseCount == 2);
+}
+
+TEST_CASE("FrameContext: アップロードリングはアライメントを守り、GPUが使い終わった分だけ再利用する") {
+
+	FakeFence fence;
+	FrameContext frameContext;
+	frameContext.Initialize(&fence, 2, 1024);
+
+	// フレーム0で確保
+	CHECK(frameContext.AllocateUpload(100, 1) == 0);
+	CHECK(frameContext.AllocateUpload(100, 256) == 256);
+	CHECK(frameContext.GetUploadUsed() == 356);
+	frameContext.EndFrame();
+
+	// フレーム1で末尾に収まらない分は先頭に回るが、フレーム0が処理中なので確保できない
+	frameContext.BeginFrame();
+	CHECK(frameContext.AllocateUpload(600, 1) == 356);
+	CHECK(frameContext.AllocateUpload(200, 1) == FrameContext::kInvalidOffset);
+	frameContext.EndFrame();
+
+	// フレーム0が終われば先頭から確保できる (末尾の余りは詰め物になる)
+	fence.Complete(1);
+	frameContext.BeginFrame();
+	CHECK(frameContext.GetUploadUsed() == 600);
+	CHECK(frameContext.AllocateUpload(200, 1) == 0);
+	CHECK(frameContext.GetUploadUsed() == 600 + 68 + 200);
+	frameContext.EndFrame();
+
+	// 全て終われば空に戻る
+	frameContext.WaitIdle();
+	frameContext.BeginFrame();
+	CHECK(frameContext.GetUploadUsed() == 0);
+
+	// リングより大きいもの、サイズ0は確保できない
+	CHECK(frameContext.AllocateUpload(2048, 1) == FrameContext::kInvalidOffset);
+	CHECK(frameContext.AllocateUpload(0, 1) == FrameContext::kInvalidOffset);
+
+	frameContext.Finalize();
+}
+
+TEST_CASE("FrameContext: 初期化時のフェンスの値の次からシグナルを送る") {
+
+	FakeFence fence;
+	fence.signaled = 41;
+	fence.completed = 41;
+
+	FrameContext frameContext;
+	frameContext.Initialize(&fence, 2, 0);
+	CHECK(frameContext.GetCurrentFenceValue() == 42);
+
+	frameContext.EndFrame();
+	CHECK(fence.signaled == 42);
+	CHECK(!frameContext.IsCompleted(42));
+	CHECK(frameContext.IsCompleted(41));
+
+	frameContext.Finalize();
+}
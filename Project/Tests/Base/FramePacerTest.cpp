@@ -0,0 +1,131 @@
+#include "TestFramework.h"
+#include "FramePacer.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace Engine;
+
+/// 実時間で待つので、判定は負荷のかかったCIでも通る幅にしてある (精度そのものは計測値として出す)
+
+namespace {
+
+	/// <summary>
+	/// 関数の実行にかかった時間を計る
+	/// </summary>
+	template <typename Function>
+	double ElapsedMilliseconds(Function function) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		function();
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+TEST_CASE("FramePacer: 目標のフレームレートに合わせて待つ") {
+
+	FramePacer framePacer;
+	framePacer.Initialize(120.0f);
+
+	// 最初のWaitは計り始めるだけで待たない
+	CHECK(ElapsedMilliseconds([&]() { framePacer.Wait(); }) < 5.0);
+	CHECK(framePacer.GetStats().frameCount == 0);
+
+	const uint32_t kFrameCount = 60;
+	double totalTime = ElapsedMilliseconds([&]() {
+		for (uint32_t i = 0; i < kFrameCount; ++i) {
+			framePacer.Wait();
+		}
+	});
+
+	FramePacer::Stats stats = framePacer.GetStats();
+	const double period = 1000.0 / 120.0;
+
+	TestFramework::ReportMeasurement("target", period, "ms");
+	TestFramework::ReportMeasurement("average", stats.average, "ms");
+	TestFramework::ReportMeasurement("p50", stats.p50, "ms");
+	TestFramework::ReportMeasurement("p99", stats.p99, "ms");
+	TestFramework::ReportMeasurement("max", stats.max, "ms");
+	TestFramework::ReportMeasurement("spin threshold", framePacer.GetSpinThreshold(), "ms");
+
+	CHECK(stats.frameCount == kFrameCount);
+
+	// 締め切りは前の締め切りから進めるので、寝過ごしても合計はずれていかない
+	CHECK(totalTime > period * kFrameCount * 0.95);
+	CHECK(totalTime < period * kFrameCount * 1.15);
+	CHECK(stats.average > period * 0.95);
+	CHECK(stats.p50 > period * 0.9);
+	CHECK(stats.p50 < period * 1.2);
+
+	// 眠りの見積もりが計られている
+	CHECK(framePacer.GetSpinThreshold() > 0.0f);
+}
+
+TEST_CASE("FramePacer: 無効か目標0なら待たずに統計だけ記録する") {
+
+	FramePacer framePacer;
+	framePacer.Initialize(30.0f);
+	framePacer.SetEnabled(false);
+	framePacer.Wait();
+
+	CHECK(ElapsedMilliseconds([&]() { for (uint32_t i = 0; i < 100; ++i) framePacer.Wait(); }) < 20.0);
+	CHECK(framePacer.GetStats().frameCount == 100);
+
+	framePacer.SetEnabled(true);
+	framePacer.SetTargetFrameRate(0.0f);
+	CHECK(ElapsedMilliseconds([&]() { for (uint32_t i = 0; i < 100; ++i) framePacer.Wait(); }) < 20.0);
+	CHECK(framePacer.GetStats().frameCount == 200);
+
+	// 有効に戻しても待たなかった間の分を取り戻そうとしない (次のフレームは1周期待つ)
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	framePacer.Wait();
+	framePacer.SetTargetFrameRate(100.0f);
+	CHECK(ElapsedMilliseconds([&]() { framePacer.Wait(); }) > 8.0);
+}
+
+TEST_CASE("FramePacer: 1フレーム以上遅れたら取り戻そうとせずに数え直す") {
+
+	FramePacer framePacer;
+	framePacer.Initialize(100.0f);
+	framePacer.Wait();
+	framePacer.Wait();
+
+	// 5フレーム分止まる
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	framePacer.Wait();
+	CHECK(framePacer.GetLastFrameTime() > 45.0f);
+
+	// 次からは詰めずに1周期ずつ待つ
+	for (uint32_t i = 0; i < 3; ++i) {
+		framePacer.Wait();
+		CHECK(framePacer.GetLastFrameTime() > 9.0f);
+	}
+}
+
+TEST_CASE("FramePacer: 中央値と99パーセンタイルは外れ値に引きずられず、最大値は残る") {
+
+	FramePacer framePacer;
+	framePacer.Initialize(0.0f);
+	framePacer.Wait();
+
+	// 99フレームは一瞬、1フレームだけ20ミリ秒
+	for (uint32_t i = 0; i < 99; ++i) {
+		framePacer.Wait();
+	}
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	framePacer.Wait();
+
+	FramePacer::Stats stats = framePacer.GetStats();
+	CHECK(stats.frameCount == 100);
+	CHECK(stats.max >= 20.0f);
+	CHECK(stats.p50 < 2.0f);
+	CHECK(stats.p99 < 2.0f);
+	CHECK(stats.p50 <= stats.p99);
+	CHECK(stats.average > 0.2f);
+
+	// リセットすると空になる
+	framePacer.ResetStats();
+	stats = framePacer.GetStats();
+	CHECK(stats.frameCount == 0);
+	CHECK(stats.max == 0.0f);
+	CHECK(stats.p99 == 0.0f);
+}
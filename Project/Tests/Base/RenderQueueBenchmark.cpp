@@ -0,0 +1,94 @@
+#include "TestFramework.h"
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace Engine;
+
+/// 10万パケットの並べ替えを、RadixSortとstd::sortで比べる
+/// キーはGamePlaySceneと同じ作り方 (パス、パイプライン数個、テクスチャ数十枚、ビュー空間の深度)
+
+namespace {
+
+	// パケット数
+	const uint32_t kPacketCount = 100000;
+
+	/// <summary>
+	/// 並べ替え用の要素をシーンに近い分布で作る
+	/// </summary>
+	std::vector<RenderQueue::SortItem> MakeItems(uint32_t count) {
+
+		std::mt19937 random(42);
+		std::uniform_int_distribution<uint32_t> passDistribution(0, 9);
+		std::uniform_int_distribution<uint32_t> pipelineDistribution(0, 3);
+		std::uniform_int_distribution<uint32_t> materialDistribution(0, 63);
+		std::uniform_real_distribution<float> depthDistribution(0.1f, 1000.0f);
+
+		std::vector<RenderQueue::SortItem> items;
+		items.reserve(count);
+		for (uint32_t i = 0; i < count; ++i) {
+
+			// 不透明7割、半透明2割、エフェクト1割
+			uint32_t passValue = passDistribution(random);
+			RenderQueue::Pass pass = passValue < 7 ? RenderQueue::Pass::Opaque : (passValue < 9 ? RenderQueue::Pass::Transparent : RenderQueue::Pass::Effect);
+
+			items.push_back({ RenderQueue::MakeKey(pass, pipelineDistribution(random), materialDistribution(random), depthDistribution(random)), i });
+		}
+
+		return items;
+	}
+}
+
+TEST_CASE("RenderQueue: 10万パケットの並べ替え") {
+
+	const std::vector<RenderQueue::SortItem> source = MakeItems(kPacketCount);
+
+	std::vector<RenderQueue::SortItem> items;
+	std::vector<RenderQueue::SortItem> scratch;
+
+	double radixTime = TestFramework::MeasureMilliseconds(10, [&]() {
+		items = source;
+		RenderQueue::RadixSort(items, scratch);
+		TestFramework::DoNotOptimize(items.front().key);
+	});
+
+	double stdSortTime = TestFramework::MeasureMilliseconds(10, [&]() {
+		items = source;
+		std::sort(items.begin(), items.end(), [](const RenderQueue::SortItem& a, const RenderQueue::SortItem& b) { return a.key < b.key; });
+		TestFramework::DoNotOptimize(items.front().key);
+	});
+
+	// コピーだけの時間 (両方に含まれるので差し引いて見る)
+	double copyTime = TestFramework::MeasureMilliseconds(10, [&]() {
+		items = source;
+		TestFramework::DoNotOptimize(items.front().key);
+	});
+
+	// 積んでから実行するまで (描画関数は空)
+	RenderQueue renderQueue;
+	uint32_t pipelines[4];
+	for (uint32_t& pipeline : pipelines) {
+		pipeline = renderQueue.RegisterPipeline([]() {});
+	}
+
+	std::mt19937 random(42);
+	std::uniform_real_distribution<float> depthDistribution(0.1f, 1000.0f);
+	double queueTime = TestFramework::MeasureMilliseconds(10, [&]() {
+		for (uint32_t i = 0; i < kPacketCount; ++i) {
+			renderQueue.Submit(RenderQueue::Pass::Opaque, pipelines[i % 4], i % 64, depthDistribution(random), []() {});
+		}
+		renderQueue.Execute();
+	});
+
+	TestFramework::ReportMeasurement("copy only", copyTime, "ms");
+	TestFramework::ReportMeasurement("RadixSort", radixTime, "ms");
+	TestFramework::ReportMeasurement("std::sort", stdSortTime, "ms");
+	TestFramework::ReportMeasurement("Submit + Execute", queueTime, "ms");
+	TestFramework::ReportMeasurement("speedup", stdSortTime / radixTime, "x");
+
+	CHECK(renderQueue.GetPacketCount() == kPacketCount);
+	CHECK(renderQueue.GetPipelineChangeCount() == 4);
+	CHECK(radixTime < stdSortTime);
+}
@@ -0,0 +1,197 @@
+#include "TestFramework.h"
+#include "RenderQueue.h"
+#include "CommandRecorder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+	/// === テスト用のバックエンド === ///
+	/// コマンドリストを作らず、区間ごとのリストの数と開始・終了の回数だけを数える
+	class FakeCommandBackend : public ICommandBackend {
+
+	public:
+
+		void BeginParallel(uint32_t listCount) override { this->listCount = listCount; }
+
+		void BeginList(uint32_t) override { beginCount++; }
+
+		void EndList(uint32_t) override { endCount++; }
+
+		void EndParallel() override { parallelCount++; }
+
+		uint32_t listCount = 0;
+		std::atomic<uint32_t> beginCount = 0;
+		std::atomic<uint32_t> endCount = 0;
+		uint32_t parallelCount = 0;
+	};
+}
+
+TEST_CASE("RenderQueue: パスの順に、不透明は手前から、半透明は奥から並ぶ") {
+
+	RenderQueue renderQueue;
+	uint32_t pipeline = renderQueue.RegisterPipeline([]() {});
+
+	std::vector<std::string> order;
+	auto submit = [&](RenderQueue::Pass pass, float depth, const char* name) {
+		renderQueue.Submit(pass, pipeline, 0, depth, [&order, name]() { order.push_back(name); });
+	};
+
+	// 登録順はばらばらにする
+	submit(RenderQueue::Pass::Effect, 1.0f, "effect");
+	submit(RenderQueue::Pass::Transparent, 5.0f, "transparent5");
+	submit(RenderQueue::Pass::Opaque, 9.0f, "opaque9");
+	submit(RenderQueue::Pass::Transparent, 50.0f, "transparent50");
+	submit(RenderQueue::Pass::Opaque, 2.0f, "opaque2");
+
+	renderQueue.Execute();
+
+	std::vector<std::string> expected = { "opaque2", "opaque9", "transparent50", "transparent5", "effect" };
+	CHECK(order == expected);
+	CHECK(renderQueue.GetPacketCount() == 5);
+}
+
+TEST_CASE("RenderQueue: 不透明は同じマテリアルが続き、その中で手前から並ぶ") {
+
+	RenderQueue renderQueue;
+	uint32_t pipeline = renderQueue.RegisterPipeline([]() {});
+
+	std::vector<std::pair<uint32_t, float>> order;
+	std::mt19937 random(7);
+	std::uniform_real_distribution<float> depthDistribution(0.1f, 100.0f);
+
+	for (uint32_t i = 0; i < 300; ++i) {
+		uint32_t material = i % 5;
+		float depth = depthDistribution(random);
+		renderQueue.Submit(RenderQueue::Pass::Opaque, pipeline, material, depth, [&order, material, depth]() { order.emplace_back(material, depth); });
+	}
+
+	renderQueue.Execute();
+	REQUIRE(order.size() == 300);
+
+	// マテリアルの切り替えは種類の数-1回だけ
+	uint32_t materialChangeCount = 0;
+	for (size_t i = 1; i < order.size(); ++i) {
+		if (order[i].first != order[i - 1].first) {
+			materialChangeCount++;
+		}
+		else {
+			CHECK(order[i - 1].second <= order[i].second);
+		}
+	}
+	CHECK(materialChangeCount == 4);
+}
+
+TEST_CASE("RenderQueue: 負の深度(カメラの後ろ)は一番手前として扱う") {
+
+	RenderQueue::Pass pass = RenderQueue::Pass::Opaque;
+	CHECK(RenderQueue::MakeKey(pass, 0, 0, -3.0f) == RenderQueue::MakeKey(pass, 0, 0, 0.0f));
+	CHECK(RenderQueue::MakeKey(pass, 0, 0, 0.0f) < RenderQueue::MakeKey(pass, 0, 0, 0.5f));
+}
+
+TEST_CASE("RenderQueue: キーからパスとパイプラインを取り出せる") {
+
+	for (RenderQueue::Pass pass : { RenderQueue::Pass::Opaque, RenderQueue::Pass::Transparent, RenderQueue::Pass::Effect }) {
+		for (uint32_t pipeline : { 0u, 1u, 77u, RenderQueue::kMaxPipelineCount - 1 }) {
+
+			uint64_t key = RenderQueue::MakeKey(pass, pipeline, RenderQueue::kMaterialMask, 123.0f);
+			CHECK(RenderQueue::GetPass(key) == pass);
+			CHECK(RenderQueue::GetPipeline(key) == pipeline);
+		}
+	}
+}
+
+TEST_CASE("RenderQueue: 登録順が交互でもパイプラインの切り替えはパスとパイプラインの組の数だけ") {
+
+	RenderQueue renderQueue;
+
+	uint32_t bindCount = 0;
+	uint32_t pipelineA = renderQueue.RegisterPipeline([&]() { bindCount++; });
+	uint32_t pipelineB = renderQueue.RegisterPipeline([&]() { bindCount++; });
+	uint32_t pipelineC = renderQueue.RegisterPipeline([&]() { bindCount++; });
+
+	for (uint32_t i = 0; i < 1000; ++i) {
+		renderQueue.Submit(RenderQueue::Pass::Opaque, (i % 2) ? pipelineA : pipelineB, i % 7, float(i), []() {});
+		renderQueue.Submit(RenderQueue::Pass::Effect, pipelineC, 0, 0.0f, []() {});
+	}
+
+	renderQueue.Execute();
+
+	CHECK(renderQueue.GetPipelineChangeCount() == 3);
+	CHECK(bindCount == 3);
+
+	// 実行後は空になる
+	renderQueue.Execute();
+	CHECK(renderQueue.GetPacketCount() == 0);
+	CHECK(bindCount == 3);
+}
+
+TEST_CASE("RenderQueue: RadixSortはstd::stable_sortと同じ並びになる") {
+
+	std::mt19937_64 random(1);
+
+	std::vector<RenderQueue::SortItem> items;
+	for (uint32_t i = 0; i < 20000; ++i) {
+
+		// 同じキーが多く出るように上位と下位だけを乱数にする
+		uint64_t key = (random() & 0xF000'0000'0000'00FFull) | ((random() % 4) << 20);
+		items.push_back({ key, i });
+	}
+
+	std::vector<RenderQueue::SortItem> expected = items;
+	std::stable_sort(expected.begin(), expected.end(), [](const RenderQueue::SortItem& a, const RenderQueue::SortItem& b) { return a.key < b.key; });
+
+	std::vector<RenderQueue::SortItem> scratch;
+	RenderQueue::RadixSort(items, scratch);
+
+	REQUIRE(items.size() == expected.size());
+	CHECK(std::equal(items.begin(), items.end(), expected.begin(), [](const RenderQueue::SortItem& a, const RenderQueue::SortItem& b) {
+		return a.key == b.key && a.index == b.index;
+	}));
+}
+
+TEST_CASE("RenderQueue: CommandRecorderを渡すとパスごとに1つのコマンドリストに記録する") {
+
+	FakeCommandBackend backend;
+	CommandRecorder recorder;
+	recorder.Initialize(&backend, 2);
+
+	RenderQueue renderQueue;
+	uint32_t pipeline = renderQueue.RegisterPipeline([]() {});
+
+	// パスごとの記録順 (パスの中は1つのスレッドで記録される)
+	std::vector<float> passOrders[RenderQueue::kPassCount];
+
+	for (uint32_t i = 0; i < 30; ++i) {
+		RenderQueue::Pass pass = static_cast<RenderQueue::Pass>(i % RenderQueue::kPassCount);
+		float depth = float((i * 13) % 30);
+		renderQueue.Submit(pass, pipeline, 0, depth, [&passOrders, pass, depth]() { passOrders[static_cast<uint32_t>(pass)].push_back(depth); });
+	}
+
+	renderQueue.Execute(&recorder);
+
+	CHECK(backend.listCount == RenderQueue::kPassCount);
+	CHECK(backend.beginCount == RenderQueue::kPassCount);
+	CHECK(backend.endCount == RenderQueue::kPassCount);
+	CHECK(backend.parallelCount == 1);
+	CHECK(renderQueue.GetPacketCount() == 30);
+
+	// 各リストの先頭でパイプラインを設定し直す
+	CHECK(renderQueue.GetPipelineChangeCount() == RenderQueue::kPassCount);
+
+	const std::vector<float>& opaque = passOrders[static_cast<uint32_t>(RenderQueue::Pass::Opaque)];
+	const std::vector<float>& transparent = passOrders[static_cast<uint32_t>(RenderQueue::Pass::Transparent)];
+	CHECK(opaque.size() == 10);
+	CHECK(std::is_sorted(opaque.begin(), opaque.end()));
+	CHECK(transparent.size() == 10);
+	CHECK(std::is_sorted(transparent.rbegin(), transparent.rend()));
+
+	recorder.Finalize();
+}
@@ -0,0 +1,94 @@
+#include "TestFramework.h"
+#include "ShaderCache.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+/// Resources/Shaders の全シェーダーで、起動時のシェーダーキャッシュの処理を空のキャッシュ(初回)と保存済み(2回目以降)で比べる
+/// 引数はDirectXUtility::CompileShaderと同じにする
+/// DXCのコンパイル自体はWindowsでしか動かないので初回の時間には含まない (エンジンはLogPipelineCacheStatsでコンパイル時間を出す)
+
+namespace {
+
+	// コンパイル結果の代わりのバイナリのサイズ (-Zi -Qembed_debug のDXILと同じくらい)
+	const size_t kBlobSize = 16 * 1024;
+
+	// シェーダー1つ分
+	struct ShaderSource {
+		std::filesystem::path path;
+		std::wstring profile;
+		std::vector<std::wstring> arguments;
+	};
+
+	/// <summary>
+	/// Resources/Shaders の.hlslを集める (ファイル名の .VS. / .PS. からプロファイルを決める)
+	/// </summary>
+	std::vector<ShaderSource> CollectShaders() {
+
+		std::vector<ShaderSource> shaders;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(std::filesystem::path(ENGINE_RESOURCES_DIR) / "Shaders")) {
+
+			if (entry.path().extension() != ".hlsl") continue;
+
+			std::string fileName = entry.path().filename().string();
+			std::wstring profile = fileName.find(".VS.") != std::string::npos ? L"vs_6_0" : L"ps_6_0";
+			std::wstring filePath = entry.path().wstring();
+
+			shaders.push_back({ entry.path(), profile, { filePath, L"-E", L"main", L"-T", profile, L"-Zi", L"-Qembed_debug", L"-Od", L"-Zpr" } });
+		}
+
+		return shaders;
+	}
+}
+
+TEST_CASE("ShaderCache: 全シェーダーの初回と2回目以降の起動") {
+
+	std::vector<ShaderSource> shaders = CollectShaders();
+	REQUIRE(!shaders.empty());
+
+	std::filesystem::path cacheDirectory = std::filesystem::temp_directory_path() / "ShaderCacheBenchmark";
+	std::vector<uint8_t> blob(kBlobSize, 0xCD);
+
+	// 初回 : キーを作り、読めずに、コンパイル結果を保存する
+	double coldTime = TestFramework::MeasureMilliseconds(5, [&]() {
+
+		std::filesystem::remove_all(cacheDirectory);
+
+		ShaderCache cache;
+		cache.Initialize(cacheDirectory);
+
+		std::vector<uint8_t> data;
+		for (const ShaderSource& shader : shaders) {
+			uint64_t key = cache.MakeKey(shader.path, shader.profile, shader.arguments);
+			REQUIRE(!cache.Load(key, data));
+			REQUIRE(cache.Store(key, blob.data(), blob.size()));
+		}
+
+		REQUIRE(cache.GetStats().missCount == shaders.size());
+	});
+
+	// 2回目以降 : キーを作り、保存済みのバイナリを読む
+	double warmTime = TestFramework::MeasureMilliseconds(5, [&]() {
+
+		ShaderCache cache;
+		cache.Initialize(cacheDirectory);
+
+		std::vector<uint8_t> data;
+		for (const ShaderSource& shader : shaders) {
+			uint64_t key = cache.MakeKey(shader.path, shader.profile, shader.arguments);
+			REQUIRE(cache.Load(key, data));
+		}
+
+		REQUIRE(cache.GetStats().hitCount == shaders.size());
+	});
+
+	TestFramework::ReportMeasurement("shaders", static_cast<double>(shaders.size()), "");
+	TestFramework::ReportMeasurement("cold: key + miss + store (excluding DXC)", coldTime, "ms");
+	TestFramework::ReportMeasurement("warm: key + load", warmTime, "ms");
+	TestFramework::ReportMeasurement("warm per shader", warmTime / static_cast<double>(shaders.size()), "ms");
+
+	std::filesystem::remove_all(cacheDirectory);
+}
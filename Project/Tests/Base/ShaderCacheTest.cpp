@@ -0,0 +1,175 @@
+#include "TestFramework.h"
+#include "ShaderCache.h"
+
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+	/// <summary>
+	/// テキストファイルを書く (ディレクトリも作る)
+	/// </summary>
+	void WriteText(const std::filesystem::path& path, const std::string& text) {
+		std::filesystem::create_directories(path.parent_path());
+		std::ofstream(path, std::ios::binary | std::ios::trunc) << text;
+	}
+
+	/// <summary>
+	/// 文字列をバイト列にする
+	/// </summary>
+	std::vector<uint8_t> ToBytes(const std::string& text) {
+		return std::vector<uint8_t>(text.begin(), text.end());
+	}
+
+	/// === テスト用のシェーダーのディレクトリ === ///
+	/// x.hlsl -> common.hlsli -> sub/b.hlsli の入れ子と、保存先のディレクトリを一時ディレクトリに作る
+	struct ShaderDirectory {
+
+		ShaderDirectory(const char* name) {
+			root = std::filesystem::temp_directory_path() / name;
+			std::filesystem::remove_all(root);
+			WriteText(root / "src/x.hlsl", "#include \"common.hlsli\"\nfloat4 main() : SV_TARGET { return Color(); }\n");
+			WriteText(root / "src/common.hlsli", "  #  include \"sub/b.hlsli\"\nfloat4 Color() { return Base(); }\n");
+			WriteText(root / "src/sub/b.hlsli", "float4 Base() { return float4(1, 1, 1, 1); }\n");
+			cache.Initialize(root / "cache");
+		}
+
+		~ShaderDirectory() {
+			std::error_code errorCode;
+			std::filesystem::remove_all(root, errorCode);
+		}
+
+		std::filesystem::path root;
+		ShaderCache cache;
+		std::vector<std::wstring> arguments = { L"x.hlsl", L"-E", L"main", L"-T", L"ps_6_0", L"-Od", L"-Zpr" };
+	};
+}
+
+TEST_CASE("ShaderCache: キーは同じ入力で同じになり、プロファイルとオプションで変わる") {
+
+	ShaderDirectory directory("ShaderCacheTest_Key");
+
+	uint64_t key = directory.cache.MakeKey(directory.root / "src/x.hlsl", L"ps_6_0", directory.arguments);
+	CHECK(key != 0);
+	CHECK(directory.cache.MakeKey(directory.root / "src/x.hlsl", L"ps_6_0", directory.arguments) == key);
+
+	CHECK(directory.cache.MakeKey(directory.root / "src/x.hlsl", L"vs_6_0", directory.arguments) != key);
+
+	std::vector<std::wstring> optimized = directory.arguments;
+	optimized[5] = L"-O3";
+	CHECK(directory.cache.MakeKey(directory.root / "src/x.hlsl", L"ps_6_0", optimized) != key);
+
+	// 区切りがずれても同じにならない ("ab" + "c" と "a" + "bc")
+	CHECK(directory.cache.MakeKey(directory.root / "src/x.hlsl", L"ps_6_0", { L"ab", L"c" }) != directory.cache.MakeKey(directory.root / "src/x.hlsl", L"ps_6_0", { L"a", L"bc" }));
+
+	// ソースが読めなければ0
+	CHECK(directory.cache.MakeKey(directory.root / "src/missing.hlsl", L"ps_6_0", directory.arguments) == 0);
+}
+
+TEST_CASE("ShaderCache: 入れ子のhlsliを書き換えるとキーが変わる") {
+
+	ShaderDirectory directory("ShaderCacheTest_Include");
+
+	uint64_t key = directory.cache.MakeKey(directory.root / "src/x.hlsl", L"ps_6_0", directory.arguments);
+
+	// 2段目のインクルードだけを書き換える
+	WriteText(directory.root / "src/sub/b.hlsli", "float4 Base() { return float4(0, 0, 0, 1); }\n");
+	uint64_t editedKey = directory.cache.MakeKey(directory.root / "src/x.hlsl", L"ps_6_0", directory.arguments);
+	CHECK(editedKey != key);
+
+	// 元に戻せば元のキーになる (前のキャッシュがそのまま使える)
+	WriteText(directory.root / "src/sub/b.hlsli", "float4 Base() { return float4(1, 1, 1, 1); }\n");
+	CHECK(directory.cache.MakeKey(directory.root / "src/x.hlsl", L"ps_6_0", directory.arguments) == key);
+
+	// インクルードしていないファイルは関係ない
+	WriteText(directory.root / "src/unused.hlsli", "float4 Unused() { return 0; }\n");
+	CHECK(directory.cache.MakeKey(directory.root / "src/x.hlsl", L"ps_6_0", directory.arguments) == key);
+}
+
+TEST_CASE("ShaderCache: 循環するインクルードでも止まる") {
+
+	ShaderDirectory directory("ShaderCacheTest_Cycle");
+
+	WriteText(directory.root / "src/a.hlsli", "#include \"b.hlsli\"\n");
+	WriteText(directory.root / "src/b.hlsli", "#include \"a.hlsli\"\n#include \"B.HLSLI\"\n");
+	WriteText(directory.root / "src/cycle.hlsl", "#include \"a.hlsli\"\n");
+
+	uint64_t key = directory.cache.MakeKey(directory.root / "src/cycle.hlsl", L"ps_6_0", directory.arguments);
+	CHECK(key != 0);
+	CHECK(directory.cache.MakeKey(directory.root / "src/cycle.hlsl", L"ps_6_0", directory.arguments) == key);
+}
+
+TEST_CASE("ShaderCache: 保存したバイナリが読め、壊れたファイルは使わない") {
+
+	ShaderDirectory directory("ShaderCacheTest_Store");
+
+	uint64_t key = directory.cache.MakeKey(directory.root / "src/x.hlsl", L"ps_6_0", directory.arguments);
+
+	std::vector<uint8_t> data;
+	CHECK(!directory.cache.Load(key, data));
+	CHECK(directory.cache.GetStats().missCount == 1);
+
+	std::vector<uint8_t> blob(4096);
+	std::iota(blob.begin(), blob.end(), uint8_t(0));
+	REQUIRE(directory.cache.Store(key, blob.data(), blob.size()));
+
+	CHECK(directory.cache.Load(key, data));
+	CHECK(data == blob);
+	CHECK(directory.cache.GetStats().hitCount == 1);
+
+	// 一時ファイルは残らない
+	uint32_t fileCount = 0;
+	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory.cache.GetDirectory())) {
+		CHECK(entry.path().extension() == ".dxil");
+		fileCount++;
+	}
+	CHECK(fileCount == 1);
+
+	// 中身を1バイト書き換えると読まない
+	std::filesystem::path filePath = *std::filesystem::directory_iterator(directory.cache.GetDirectory());
+	{
+		std::fstream file(filePath, std::ios::in | std::ios::out | std::ios::binary);
+		file.seekp(100);
+		file.put(static_cast<char>(0xFF));
+	}
+	CHECK(!directory.cache.Load(key, data));
+
+	// 途中で切れたファイルも読まない
+	REQUIRE(directory.cache.Store(key, blob.data(), blob.size()));
+	std::filesystem::resize_file(filePath, 1000);
+	CHECK(!directory.cache.Load(key, data));
+
+	// 別のキーのファイルを置き換えても読まない
+	uint64_t otherKey = directory.cache.MakeKey(directory.root / "src/x.hlsl", L"vs_6_0", directory.arguments);
+	REQUIRE(directory.cache.Store(otherKey, blob.data(), blob.size()));
+	std::filesystem::path otherPath = filePath.parent_path();
+	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory.cache.GetDirectory())) {
+		if (entry.path() != filePath) otherPath = entry.path();
+	}
+	std::filesystem::copy_file(otherPath, filePath, std::filesystem::copy_options::overwrite_existing);
+	CHECK(!directory.cache.Load(key, data));
+	CHECK(directory.cache.Load(otherKey, data));
+}
+
+TEST_CASE("ShaderCache: #includeの行だけを取り出す") {
+
+	std::vector<std::string> includes = ShaderCache::FindIncludes(ToBytes(
+		"#include \"a.hlsli\"\n"
+		"\t# include <b.hlsli>\r\n"
+		"// #include \"comment.hlsli\" は行頭が#ではないので拾わない\n"
+		"#define X \"not.hlsli\"\n"
+		"#include \"\"\n"
+		"#include \"unterminated.hlsli\n"
+		"#include \"last.hlsli\""
+	));
+
+	std::vector<std::string> expected = { "a.hlsli", "b.hlsli", "last.hlsli" };
+	CHECK(includes == expected);
+
+	CHECK(ShaderCache::FindIncludes({}).empty());
+}
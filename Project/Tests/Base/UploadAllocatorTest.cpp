@@ -0,0 +1,124 @@
+#include "TestFramework.h"
+#include "UploadAllocator.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+	/// === テスト用のフェンス === ///
+	/// GPUの代わりにテストから完了値を進める
+	class FakeFence : public IFence {
+
+	public:
+
+		void Signal(uint64_t value) override { signaled = value; }
+
+		uint64_t GetCompletedValue() const override { return completed; }
+
+		void Wait(uint64_t value) override { completed = (std::max)(completed, value); }
+
+		// GPUがvalueまで処理した
+		void Complete(uint64_t value) { completed = (std::max)(completed, (std::min)(value, signaled)); }
+
+		uint64_t signaled = 0;
+		uint64_t completed = 0;
+	};
+
+	// 定数バッファ1つ分より小さいデータ
+	struct SmallConstants {
+		float values[5];
+	};
+
+	// バッファの先頭のGPUのアドレス (D3D12のリソースと同じく64KB境界)
+	const uint64_t kGpuBase = 0x10000;
+}
+
+TEST_CASE("UploadAllocator: 定数バッファは256バイト境界に置き、CPUとGPUのアドレスは同じオフセットを指す") {
+
+	const uint64_t kRingSize = 4096;
+
+	FakeFence fence;
+	FrameContext frameContext;
+	frameContext.Initialize(&fence, 2, kRingSize);
+
+	std::vector<uint8_t> buffer(kRingSize, 0);
+	UploadAllocator allocator;
+	allocator.Initialize(&frameContext, buffer.data(), kGpuBase);
+
+	// 大きさがばらばらでも定数バッファは全て256バイト境界
+	for (uint32_t i = 0; i < 4; ++i) {
+
+		SmallConstants constants{};
+		constants.values[0] = static_cast<float>(i);
+		UploadAllocator::Allocation allocation = allocator.Push(constants);
+
+		REQUIRE(allocation.IsValid());
+		CHECK(allocation.gpuAddress % UploadAllocator::kConstantBufferAlignment == 0);
+		CHECK(allocation.size == sizeof(SmallConstants));
+		CHECK(static_cast<uint64_t>(allocation.cpuAddress - buffer.data()) == allocation.gpuAddress - kGpuBase);
+		CHECK(reinterpret_cast<const SmallConstants*>(allocation.cpuAddress)->values[0] == static_cast<float>(i));
+
+		// 間に半端な大きさの配列を挟む
+		uint32_t indices[3] = { i, i + 1, i + 2 };
+		UploadAllocator::Allocation array = allocator.PushArray(indices, 3, alignof(uint32_t));
+		REQUIRE(array.IsValid());
+		CHECK(array.gpuAddress % alignof(uint32_t) == 0);
+		CHECK(reinterpret_cast<const uint32_t*>(array.cpuAddress)[2] == i + 2);
+	}
+
+	CHECK(allocator.GetFailedCount() == 0);
+	CHECK(allocator.GetFrameBytes() == 4 * (sizeof(SmallConstants) + sizeof(uint32_t) * 3));
+
+	frameContext.Finalize();
+}
+
+TEST_CASE("UploadAllocator: リングが足りなければ無効な領域を返し、GPUが追いつけばまた確保できる") {
+
+	const uint64_t kRingSize = 1024;
+
+	FakeFence fence;
+	FrameContext frameContext;
+	frameContext.Initialize(&fence, 2, kRingSize);
+
+	std::vector<uint8_t> buffer(kRingSize, 0);
+	UploadAllocator allocator;
+	allocator.Initialize(&frameContext, buffer.data(), kGpuBase);
+
+	// フレーム0でリングを使い切る (256バイト境界で4つまで)
+	SmallConstants constants{};
+	for (uint32_t i = 0; i < 4; ++i) {
+		CHECK(allocator.Push(constants).IsValid());
+	}
+
+	// 足りなければ無効な領域で、書き込まずに戻る
+	UploadAllocator::Allocation exhausted = allocator.Push(constants);
+	CHECK(!exhausted.IsValid());
+	CHECK(exhausted.cpuAddress == nullptr);
+	CHECK(exhausted.gpuAddress == 0);
+	CHECK(allocator.GetFailedCount() == 1);
+
+	// リングより大きいものも確保できない
+	CHECK(!allocator.Allocate(kRingSize * 2).IsValid());
+	CHECK(allocator.GetFailedCount() == 2);
+	frameContext.EndFrame();
+
+	// フレーム0をGPUが処理中の間は、フレーム1でも確保できない
+	frameContext.BeginFrame();
+	CHECK(!allocator.Push(constants).IsValid());
+	CHECK(allocator.GetFailedCount() == 3);
+	frameContext.EndFrame();
+
+	// フレーム0が終われば再利用できる
+	fence.Complete(1);
+	frameContext.BeginFrame();
+	UploadAllocator::Allocation recovered = allocator.Push(constants);
+	CHECK(recovered.IsValid());
+	CHECK(recovered.gpuAddress % UploadAllocator::kConstantBufferAlignment == 0);
+	CHECK(allocator.GetFailedCount() == 3);
+	frameContext.EndFrame();
+
+	frameContext.Finalize();
+}
@@ -0,0 +1,110 @@
+#include "TestFramework.h"
+#include "Camera/FrustumCuller.h"
+#include "MathMatrix.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Engine;
+
+/// 10万個の境界ボックスの視錐台カリングを、SoA + SIMDの判定と境界ボックスごとのスカラーの平面判定で比べる
+
+namespace {
+
+	// 境界ボックスの数
+	const uint32_t kBoxCount = 100000;
+
+	/// <summary>
+	/// 境界ボックスごとにスカラーで6平面と判定する (平面の取り出し方はFrustumCullerと同じ)
+	/// </summary>
+	uint32_t ScalarCull(const std::vector<AABB>& boxes, const Matrix4x4& viewProjectionMatrix, std::vector<uint8_t>& visible) {
+
+		// 行ベクトル * 行列なので、平面は行列の列の組み合わせ
+		float planes[6][4];
+		for (int row = 0; row < 4; ++row) {
+			const float* m = viewProjectionMatrix.m[row];
+			planes[0][row] = m[3] + m[0];
+			planes[1][row] = m[3] - m[0];
+			planes[2][row] = m[3] + m[1];
+			planes[3][row] = m[3] - m[1];
+			planes[4][row] = m[2];
+			planes[5][row] = m[3] - m[2];
+		}
+
+		uint32_t visibleCount = 0;
+		for (size_t i = 0; i < boxes.size(); ++i) {
+
+			const AABB& box = boxes[i];
+			float center[3] = { (box.min.x + box.max.x) * 0.5f, (box.min.y + box.max.y) * 0.5f, (box.min.z + box.max.z) * 0.5f };
+			float extent[3] = { (box.max.x - box.min.x) * 0.5f, (box.max.y - box.min.y) * 0.5f, (box.max.z - box.min.z) * 0.5f };
+
+			bool isVisible = true;
+			for (const float (&plane)[4] : planes) {
+				float distance = (center[0] * plane[0] + center[1] * plane[1]) + (center[2] * plane[2] + plane[3]);
+				float radius = (extent[0] * std::fabs(plane[0]) + extent[1] * std::fabs(plane[1])) + extent[2] * std::fabs(plane[2]);
+				if (distance + radius < 0.0f) {
+					isVisible = false;
+					break;
+				}
+			}
+
+			visible[i] = isVisible ? 1 : 0;
+			visibleCount += visible[i];
+		}
+
+		return visibleCount;
+	}
+}
+
+TEST_CASE("FrustumCuller: 10万個の境界ボックスの判定") {
+
+	Matrix4x4 projectionMatrix = MathMatrix::MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 300.0f);
+	Matrix4x4 viewMatrix = MathMatrix::Inverse(MathMatrix::MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, { 0.1f, 0.0f, 0.0f }, { 0.0f, 4.0f, -20.0f }));
+	Matrix4x4 viewProjectionMatrix = MathMatrix::Multiply(viewMatrix, projectionMatrix);
+
+	// コースの上に並ぶ境界ボックス (一部が視錐台に入る)
+	std::mt19937 random(36);
+	std::uniform_real_distribution<float> xDistribution(-150.0f, 150.0f);
+	std::uniform_real_distribution<float> yDistribution(-5.0f, 20.0f);
+	std::uniform_real_distribution<float> zDistribution(-100.0f, 400.0f);
+	std::uniform_real_distribution<float> sizeDistribution(0.5f, 5.0f);
+
+	std::vector<AABB> boxes(kBoxCount);
+	for (AABB& box : boxes) {
+		box = CreateAABBFromCenter({ xDistribution(random), yDistribution(random), zDistribution(random) }, { sizeDistribution(random), sizeDistribution(random), sizeDistribution(random) });
+	}
+
+	FrustumCuller culler;
+	for (const AABB& box : boxes) {
+		culler.Add(box);
+	}
+	uint32_t generation = culler.GetGeneration();
+
+	double cullTime = TestFramework::MeasureMilliseconds(50, [&]() {
+		culler.Cull(viewProjectionMatrix);
+	});
+
+	std::vector<uint8_t> scalarVisible(kBoxCount);
+	uint32_t scalarVisibleCount = 0;
+	double scalarTime = TestFramework::MeasureMilliseconds(50, [&]() {
+		scalarVisibleCount = ScalarCull(boxes, viewProjectionMatrix, scalarVisible);
+		TestFramework::DoNotOptimize(scalarVisibleCount);
+	});
+
+	// 同じ平面と同じ式なので結果は一致する
+	uint32_t mismatchCount = 0;
+	for (uint32_t i = 0; i < kBoxCount; ++i) {
+		if (culler.IsVisible(i, generation) != (scalarVisible[i] != 0)) {
+			mismatchCount++;
+		}
+	}
+	CHECK(mismatchCount == 0);
+	CHECK(culler.GetVisibleCount() == scalarVisibleCount);
+
+	TestFramework::ReportMeasurement("boxes", static_cast<double>(kBoxCount), "");
+	TestFramework::ReportMeasurement("visible", static_cast<double>(culler.GetVisibleCount()), "");
+	TestFramework::ReportMeasurement("FrustumCuller::Cull (SoA + SSE)", cullTime, "ms");
+	TestFramework::ReportMeasurement("scalar plane test", scalarTime, "ms");
+	TestFramework::ReportMeasurement("speedup", scalarTime / cullTime, "x");
+}
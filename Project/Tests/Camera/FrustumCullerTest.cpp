@@ -0,0 +1,233 @@
+#include "TestFramework.h"
+#include "Camera/FrustumCuller.h"
+#include "MathMatrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+	// 深度の範囲
+	const float kNearClip = 1.0f;
+	const float kFarClip = 100.0f;
+
+	// 判定の境目とみなす平面からの距離 (クリップ座標。floatの誤差でSIMDと結果が分かれてもよい範囲)
+	const double kBoundaryEpsilon = 1e-3;
+
+	// 判定の結果
+	enum class Expected {
+		Visible,	// 見える
+		Culled,		// 除外される
+		Boundary,	// 平面とほぼ接していてどちらにもなりうる
+	};
+
+	/// <summary>
+	/// 8頂点をクリップ座標に変換し、どれかの平面の外側に全ての頂点があれば除外する (doubleのスカラー判定)
+	/// </summary>
+	Expected ScalarTest(const AABB& bounds, const Matrix4x4& viewProjectionMatrix) {
+
+		// 平面ごとの頂点の最大の距離 左、右、下、上、近、遠
+		double maxDistance[6] = { -INFINITY, -INFINITY, -INFINITY, -INFINITY, -INFINITY, -INFINITY };
+
+		for (int corner = 0; corner < 8; ++corner) {
+
+			double point[4] = {
+				(corner & 1) ? bounds.max.x : bounds.min.x,
+				(corner & 2) ? bounds.max.y : bounds.min.y,
+				(corner & 4) ? bounds.max.z : bounds.min.z,
+				1.0
+			};
+
+			// 行ベクトル * 行列
+			double clip[4] = {};
+			for (int column = 0; column < 4; ++column) {
+				for (int row = 0; row < 4; ++row) {
+					clip[column] += point[row] * viewProjectionMatrix.m[row][column];
+				}
+			}
+
+			double distance[6] = { clip[3] + clip[0], clip[3] - clip[0], clip[3] + clip[1], clip[3] - clip[1], clip[2], clip[3] - clip[2] };
+			for (int plane = 0; plane < 6; ++plane) {
+				maxDistance[plane] = (std::max)(maxDistance[plane], distance[plane]);
+			}
+		}
+
+		// 平面とほぼ接しているものは、どちらの結果でもよい
+		bool isBoundary = false;
+		for (double distance : maxDistance) {
+			if (distance < -kBoundaryEpsilon) {
+				return Expected::Culled;
+			}
+			if (distance < kBoundaryEpsilon) {
+				isBoundary = true;
+			}
+		}
+
+		return isBoundary ? Expected::Boundary : Expected::Visible;
+	}
+
+	/// <summary>
+	/// 原点から+Z方向を見る視野角90度の透視投影 (x = ±z、y = ±zが左右上下の平面)
+	/// </summary>
+	Matrix4x4 MakeTestProjection() {
+		return MathMatrix::MakePerspectiveFovMatrix(1.57079632679f, 1.0f, kNearClip, kFarClip);
+	}
+}
+
+TEST_CASE("FrustumCuller: SIMDの判定はスカラーの平面判定と一致する") {
+
+	const uint32_t kBoxCount = 10001;
+
+	// 傾けたカメラで、視錐台の内外と平面をまたぐものを混ぜる
+	Matrix4x4 viewMatrix = MathMatrix::Inverse(MathMatrix::MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, { 0.2f, 0.7f, 0.1f }, { 3.0f, 5.0f, -10.0f }));
+	Matrix4x4 projectionMatrix = MathMatrix::MakePerspectiveFovMatrix(0.8f, 16.0f / 9.0f, 0.1f, 150.0f);
+	Matrix4x4 viewProjectionMatrix = MathMatrix::Multiply(viewMatrix, projectionMatrix);
+
+	std::mt19937 random(36);
+	std::uniform_real_distribution<float> positionDistribution(-80.0f, 80.0f);
+	std::uniform_real_distribution<float> sizeDistribution(0.0f, 20.0f);
+
+	std::vector<AABB> boxes(kBoxCount);
+	for (AABB& box : boxes) {
+		Vector3 center = { positionDistribution(random), positionDistribution(random), positionDistribution(random) };
+		Vector3 halfSize = { sizeDistribution(random), sizeDistribution(random), sizeDistribution(random) };
+		box = CreateAABBFromCenter(center, halfSize);
+	}
+
+	FrustumCuller culler;
+	for (const AABB& box : boxes) {
+		culler.Add(box);
+	}
+	uint32_t generation = culler.GetGeneration();
+	culler.Cull(viewProjectionMatrix);
+
+	// 4の倍数でない数の端数まで、全て比べる
+	uint32_t visibleCount = 0;
+	uint32_t culledCount = 0;
+	uint32_t boundaryCount = 0;
+	for (uint32_t i = 0; i < kBoxCount; ++i) {
+
+		bool isVisible = culler.IsVisible(i, generation);
+		switch (ScalarTest(boxes[i], viewProjectionMatrix)) {
+		case Expected::Visible:
+			CHECK(isVisible);
+			visibleCount++;
+			break;
+		case Expected::Culled:
+			CHECK(!isVisible);
+			culledCount++;
+			break;
+		case Expected::Boundary:
+			boundaryCount++;
+			break;
+		}
+	}
+
+	// 見えるものも除外されるものも十分にあり、境目で比べられなかったものはわずか
+	CHECK(visibleCount > kBoxCount / 20);
+	CHECK(culledCount > kBoxCount / 2);
+	CHECK(boundaryCount < kBoxCount / 100);
+	CHECK(culler.GetTestedCount() == kBoxCount);
+	CHECK(culler.GetVisibleCount() + culler.GetCulledCount() == kBoxCount);
+}
+
+TEST_CASE("FrustumCuller: 平面をまたぐ境界ボックスは見え、平面の外側にあるものは除外される") {
+
+	Matrix4x4 viewProjectionMatrix = MakeTestProjection();
+
+	struct Case {
+		AABB bounds;
+		bool isVisible;
+	};
+	const Case cases[] = {
+
+		// 内側
+		{ CreateAABBFromCenter({ 0.0f, 0.0f, 50.0f }, { 1.0f, 1.0f, 1.0f }), true },
+
+		// 近平面をまたぐ / カメラと近平面の間 / カメラの後ろ
+		{ CreateAABB({ -0.1f, -0.1f, 0.5f }, { 0.1f, 0.1f, 1.5f }), true },
+		{ CreateAABB({ -0.1f, -0.1f, 0.2f }, { 0.1f, 0.1f, 0.8f }), false },
+		{ CreateAABBFromCenter({ 0.0f, 0.0f, -10.0f }, { 1.0f, 1.0f, 1.0f }), false },
+
+		// 遠平面をまたぐ / 遠平面の外
+		{ CreateAABB({ -1.0f, -1.0f, 99.0f }, { 1.0f, 1.0f, 101.0f }), true },
+		{ CreateAABB({ -1.0f, -1.0f, 101.0f }, { 1.0f, 1.0f, 102.0f }), false },
+
+		// 左右の平面 (z = 10ではx = ±10) をまたぐ / 外
+		{ CreateAABB({ -10.5f, -1.0f, 9.9f }, { -9.5f, 1.0f, 10.1f }), true },
+		{ CreateAABB({ -12.0f, -1.0f, 9.9f }, { -11.0f, 1.0f, 10.1f }), false },
+		{ CreateAABB({ 9.5f, -1.0f, 9.9f }, { 10.5f, 1.0f, 10.1f }), true },
+		{ CreateAABB({ 11.0f, -1.0f, 9.9f }, { 12.0f, 1.0f, 10.1f }), false },
+
+		// 上下の平面をまたぐ / 外
+		{ CreateAABB({ -1.0f, 9.5f, 9.9f }, { 1.0f, 10.5f, 10.1f }), true },
+		{ CreateAABB({ -1.0f, -12.0f, 9.9f }, { 1.0f, -11.0f, 10.1f }), false },
+
+		// 視錐台を丸ごと包む
+		{ CreateAABBFromCenter({ 0.0f, 0.0f, 0.0f }, { 500.0f, 500.0f, 500.0f }), true },
+	};
+
+	FrustumCuller culler;
+	for (const Case& testCase : cases) {
+		culler.Add(testCase.bounds);
+	}
+	uint32_t generation = culler.GetGeneration();
+	culler.Cull(viewProjectionMatrix);
+
+	uint32_t visibleCount = 0;
+	for (uint32_t i = 0; i < std::size(cases); ++i) {
+
+		CHECK(culler.IsVisible(i, generation) == cases[i].isVisible);
+
+		// スカラーの平面判定とも一致する
+		Expected expected = ScalarTest(cases[i].bounds, viewProjectionMatrix);
+		CHECK(expected == (cases[i].isVisible ? Expected::Visible : Expected::Culled));
+
+		visibleCount += cases[i].isVisible ? 1 : 0;
+	}
+	CHECK(culler.GetVisibleCount() == visibleCount);
+}
+
+TEST_CASE("FrustumCuller: 別の世代の番号や判定前の番号は見えるものとして扱う") {
+
+	Matrix4x4 viewProjectionMatrix = MakeTestProjection();
+	const AABB outside = CreateAABBFromCenter({ 0.0f, 0.0f, -10.0f }, { 1.0f, 1.0f, 1.0f });
+	const AABB inside = CreateAABBFromCenter({ 0.0f, 0.0f, 50.0f }, { 1.0f, 1.0f, 1.0f });
+
+	FrustumCuller culler;
+
+	// 判定前は見える
+	uint32_t first = culler.Add(outside);
+	uint32_t firstGeneration = culler.GetGeneration();
+	CHECK(culler.IsVisible(first, firstGeneration));
+
+	// 判定後は結果どおり
+	culler.Cull(viewProjectionMatrix);
+	CHECK(!culler.IsVisible(first, firstGeneration));
+
+	// 違う世代、範囲外の番号は見える
+	CHECK(culler.IsVisible(first, firstGeneration + 1));
+	CHECK(culler.IsVisible(first, firstGeneration - 1));
+	CHECK(culler.IsVisible(first + 1, firstGeneration));
+
+	// 次のAddで新しい世代になり、古い世代の番号は判定し直すまで見える
+	uint32_t second = culler.Add(inside);
+	uint32_t secondGeneration = culler.GetGeneration();
+	CHECK(secondGeneration != firstGeneration);
+	CHECK(second == 0);
+	CHECK(culler.IsVisible(first, firstGeneration));
+	CHECK(culler.IsVisible(second, secondGeneration));
+
+	// 同じ番号が新しい世代で別の境界ボックスを指していても、古い世代の結果は使わない
+	culler.Add(outside);
+	culler.Cull(viewProjectionMatrix);
+	CHECK(culler.IsVisible(second, secondGeneration));
+	CHECK(!culler.IsVisible(1, secondGeneration));
+	CHECK(culler.IsVisible(1, firstGeneration));
+	CHECK(culler.GetTestedCount() == 2);
+	CHECK(culler.GetVisibleCount() == 1);
+}
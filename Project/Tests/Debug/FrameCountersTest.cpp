@@ -0,0 +1,126 @@
+#include "TestFramework.h"
+#include "FrameCounters.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Engine;
+
+TEST_CASE("FrameCounters: カウンターはフレームごとに0に戻り、ゲージは残る") {
+
+	FrameCounters* frameCounters = FrameCounters::GetInstance();
+
+	frameCounters->CountDraw(10, 3);
+	frameCounters->CountDraw(1, 1);
+	frameCounters->Set(FrameCounters::kLiveParticles, 42);
+
+	// 取り出すまでは前のフレームの値のまま
+	CHECK(frameCounters->GetValue(FrameCounters::kDrawCalls) == 0);
+
+	frameCounters->BeginFrame();
+	CHECK(frameCounters->GetValue(FrameCounters::kDrawCalls) == 2);
+	CHECK(frameCounters->GetValue(FrameCounters::kInstances) == 11);
+	CHECK(frameCounters->GetValue(FrameCounters::kRootParameterBinds) == 4);
+	CHECK(frameCounters->GetValue(FrameCounters::kLiveParticles) == 42);
+
+	frameCounters->BeginFrame();
+	CHECK(frameCounters->GetValue(FrameCounters::kDrawCalls) == 0);
+	CHECK(frameCounters->GetValue(FrameCounters::kLiveParticles) == 42);
+
+	// 範囲外の番号は無視する
+	frameCounters->Add(FrameCounters::kInvalidCounterID);
+	frameCounters->Set(FrameCounters::kInvalidCounterID, 1);
+	CHECK(frameCounters->GetValue(FrameCounters::kInvalidCounterID) == 0);
+	CHECK(frameCounters->GetName(FrameCounters::kInvalidCounterID).empty());
+
+	frameCounters->Finalize();
+}
+
+TEST_CASE("FrameCounters: 同じ名前の登録は同じ番号になり、上限を超えると無効な番号を返す") {
+
+	FrameCounters* frameCounters = FrameCounters::GetInstance();
+
+	CHECK(frameCounters->Register("DrawCalls") == FrameCounters::kDrawCalls);
+
+	FrameCounters::CounterID id = frameCounters->Register("Jobs");
+	CHECK(id == FrameCounters::kBuiltInCounterCount);
+	CHECK(frameCounters->Register("Jobs") == id);
+	CHECK(frameCounters->GetName(id) == "Jobs");
+	CHECK(frameCounters->GetCounterCount() == FrameCounters::kBuiltInCounterCount + 1);
+
+	for (uint32_t i = frameCounters->GetCounterCount(); i < FrameCounters::kMaxCounterCount; ++i) {
+		CHECK(frameCounters->Register("Counter" + std::to_string(i)) == i);
+	}
+	CHECK(frameCounters->Register("Overflow") == FrameCounters::kInvalidCounterID);
+	CHECK(frameCounters->GetCounterCount() == FrameCounters::kMaxCounterCount);
+
+	// 破棄すると組み込みのカウンターだけに戻る
+	frameCounters->Finalize();
+	frameCounters = FrameCounters::GetInstance();
+	CHECK(frameCounters->GetCounterCount() == FrameCounters::kBuiltInCounterCount);
+	CHECK(frameCounters->GetName(id).empty());
+
+	frameCounters->Finalize();
+}
+
+TEST_CASE("FrameCounters: 複数のスレッドから足しても数え落とさない") {
+
+	FrameCounters* frameCounters = FrameCounters::GetInstance();
+	FrameCounters::CounterID id = frameCounters->Register("Parallel");
+
+	const uint32_t kThreadCount = 4;
+	const uint32_t kAddCount = 100000;
+
+	std::vector<std::thread> threads;
+	for (uint32_t i = 0; i < kThreadCount; ++i) {
+		threads.emplace_back([frameCounters, id]() {
+			for (uint32_t j = 0; j < kAddCount; ++j) {
+				frameCounters->Add(id);
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	frameCounters->BeginFrame();
+	CHECK(frameCounters->GetValue(id) == kThreadCount * kAddCount);
+
+	frameCounters->Finalize();
+}
+
+TEST_CASE("FrameCounters: CSVに見出しと1フレーム1行を書く") {
+
+	std::filesystem::path filePath = std::filesystem::temp_directory_path() / "FrameCountersTest.csv";
+
+	FrameCounters* frameCounters = FrameCounters::GetInstance();
+	FrameCounters::CounterID id = frameCounters->Register("Custom");
+
+	REQUIRE(frameCounters->StartCsv(filePath));
+	CHECK(frameCounters->IsWritingCsv());
+
+	frameCounters->Add(FrameCounters::kDrawCalls, 5);
+	frameCounters->Add(id, 7);
+	frameCounters->BeginFrame();
+	frameCounters->BeginFrame();
+
+	// 破棄するとファイルも閉じる
+	frameCounters->Finalize();
+
+	std::ifstream file(filePath);
+	std::vector<std::string> lines;
+	for (std::string line; std::getline(file, line);) {
+		lines.push_back(line);
+	}
+
+	REQUIRE(lines.size() == 3);
+	CHECK(lines[0] == "Frame,DrawCalls,Instances,RootParameterBinds,UploadBytes,DescriptorAllocations,LiveParticles,ColliderPairTests,HeapAllocations,Custom");
+	CHECK(lines[1] == "0,5,0,0,0,0,0,0,0,7");
+	CHECK(lines[2] == "1,0,0,0,0,0,0,0,0,0");
+
+	file.close();
+	std::filesystem::remove(filePath);
+}
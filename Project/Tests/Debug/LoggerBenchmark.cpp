@@ -0,0 +1,110 @@
+#include "TestFramework.h"
+#include "Logger.h"
+
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Engine;
+
+/// ログ1件を積むのにかかる時間を、呼んだスレッドでそのまま書き込む場合(以前のLogger::Log)と比べる
+/// 書き込み用のスレッドが書き終えるまでの時間は、呼んだスレッドの時間とは別に出す
+
+namespace {
+
+	// 1回に積むログの数
+	const uint32_t kRecordCount = 100000;
+
+	// 同時に積むスレッドの数
+	const uint32_t kThreadCount = 4;
+
+	/// <summary>
+	/// 関数の実行にかかった時間を計る
+	/// </summary>
+	template <typename Function>
+	double ElapsedMilliseconds(Function function) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		function();
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	/// <summary>
+	/// ミリ秒を1件あたりのナノ秒にする
+	/// </summary>
+	double ToNanosecondsPerRecord(double milliseconds, uint32_t recordCount) {
+		return milliseconds * 1000000.0 / static_cast<double>(recordCount);
+	}
+}
+
+TEST_CASE("Logger: 1件を積む時間と書き込む時間") {
+
+	std::filesystem::path directory = std::filesystem::temp_directory_path() / "LoggerBenchmark";
+	std::filesystem::create_directories(directory);
+
+	// ----------呼んだスレッドで1件ずつ整形して書き出す----------
+	double synchronousTime = ElapsedMilliseconds([&]() {
+		std::ofstream file(directory / "Synchronous.log", std::ios::trunc);
+		for (uint32_t i = 0; i < kRecordCount; ++i) {
+			file << std::format("[{:.3f}][Info][T0] record {}\n", 0.0, i);
+			file.flush();
+		}
+	});
+
+	// ----------1つのスレッドから積む----------
+	Logger::Initialize(Logger::kSinkFile, directory / "SingleThread.log");
+
+	double pushTime = ElapsedMilliseconds([&]() {
+		for (uint32_t i = 0; i < kRecordCount; ++i) {
+			LOG_INFO("record {}", i);
+		}
+	});
+
+	// 積み終わってから全て書き込まれるまで
+	double drainTime = ElapsedMilliseconds([&]() { Logger::Flush(); });
+	Logger::Finalize();
+
+	// ----------複数のスレッドから積む----------
+	Logger::Initialize(Logger::kSinkFile, directory / "MultiThread.log");
+
+	double multiThreadPushTime = ElapsedMilliseconds([&]() {
+		std::vector<std::thread> threads;
+		for (uint32_t thread = 0; thread < kThreadCount; ++thread) {
+			threads.emplace_back([]() {
+				for (uint32_t i = 0; i < kRecordCount / kThreadCount; ++i) {
+					LOG_INFO("record {}", i);
+				}
+			});
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+	});
+	Logger::Finalize();
+
+	// ----------出力しない重要度----------
+	Logger::SetMinSeverity(Logger::Severity::Error);
+	double filteredTime = ElapsedMilliseconds([&]() {
+		for (uint32_t i = 0; i < kRecordCount; ++i) {
+			LOG_INFO("record {}", i);
+		}
+	});
+	Logger::SetMinSeverity(Logger::kCompiledMinSeverity);
+
+	TestFramework::ReportMeasurement("records", static_cast<double>(kRecordCount), "");
+	TestFramework::ReportMeasurement("synchronous format + write + flush", ToNanosecondsPerRecord(synchronousTime, kRecordCount), "ns/record");
+	TestFramework::ReportMeasurement("LOG_INFO push (1 thread)", ToNanosecondsPerRecord(pushTime, kRecordCount), "ns/record");
+	TestFramework::ReportMeasurement("LOG_INFO push (4 threads, wall)", ToNanosecondsPerRecord(multiThreadPushTime, kRecordCount), "ns/record");
+	TestFramework::ReportMeasurement("LOG_INFO below min severity", ToNanosecondsPerRecord(filteredTime, kRecordCount), "ns/record");
+	TestFramework::ReportMeasurement("writer drain after push", drainTime, "ms");
+
+	TestFramework::ReportMeasurement("push speedup over synchronous", synchronousTime / pushTime, "x");
+
+	// 積む時間は書き込み用のスレッドとコアを取り合うと伸びるので、コアが1つの環境でも成り立つものだけを確かめる
+	CHECK(filteredTime < pushTime);
+
+	std::filesystem::remove_all(directory);
+}
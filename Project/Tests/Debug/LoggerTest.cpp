@@ -0,0 +1,256 @@
+#include "TestFramework.h"
+#include "Logger.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+	// このスレッドで呼んだnewの数 (ログを積む側の割り当てだけを数える)
+	thread_local uint64_t tAllocationCount = 0;
+
+	/// <summary>
+	/// 数えて割り当てる
+	/// </summary>
+	void* CountedAllocate(size_t size) {
+		tAllocationCount++;
+		void* block = std::malloc(size == 0 ? 1 : size);
+		if (!block) throw std::bad_alloc();
+		return block;
+	}
+
+	/// <summary>
+	/// ファイルを行ごとに読む
+	/// </summary>
+	std::vector<std::string> ReadLines(const std::filesystem::path& filePath) {
+		std::ifstream file(filePath);
+		std::vector<std::string> lines;
+		for (std::string line; std::getline(file, line);) {
+			lines.push_back(line);
+		}
+		return lines;
+	}
+
+	/// <summary>
+	/// 行から本文を取り出す ("[時刻][重要度][T番号] 本文")
+	/// </summary>
+	std::string GetMessage(const std::string& line) {
+		size_t position = line.find("] ", line.find("[T"));
+		return position == std::string::npos ? std::string() : line.substr(position + 2);
+	}
+
+	/// <summary>
+	/// テスト用のログファイルのパス
+	/// </summary>
+	std::filesystem::path MakeLogPath(const char* name) {
+		std::filesystem::path filePath = std::filesystem::temp_directory_path() / "LoggerTest" / name;
+		std::filesystem::remove(filePath);
+		return filePath;
+	}
+}
+
+void* operator new(size_t size) { return CountedAllocate(size); }
+void* operator new[](size_t size) { return CountedAllocate(size); }
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { std::free(pointer); }
+
+TEST_CASE("Logger: 複数のスレッドから積んでも失わず、スレッドごとの順番を保つ") {
+
+	std::filesystem::path filePath = MakeLogPath("MultiProducer.log");
+	Logger::Initialize(Logger::kSinkFile, filePath);
+
+	const uint32_t kThreadCount = 4;
+	const uint32_t kRecordCount = 20000;
+
+	std::vector<std::thread> threads;
+	for (uint32_t thread = 0; thread < kThreadCount; ++thread) {
+		threads.emplace_back([thread]() {
+			for (uint32_t i = 0; i < kRecordCount; ++i) {
+				LOG_INFO("{} {}", thread, i);
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	// 積まれているものは書き込んでから止まる
+	Logger::Finalize();
+
+	std::vector<std::string> lines = ReadLines(filePath);
+	REQUIRE(lines.size() == kThreadCount * kRecordCount);
+
+	std::vector<uint32_t> nextIndices(kThreadCount, 0);
+	for (const std::string& line : lines) {
+
+		CHECK(line.find("[Info]") != std::string::npos);
+
+		uint32_t thread = 0;
+		uint32_t index = 0;
+		REQUIRE(std::sscanf(GetMessage(line).c_str(), "%u %u", &thread, &index) == 2);
+		REQUIRE(thread < kThreadCount);
+
+		// 同じスレッドのログは積んだ順に並ぶ
+		CHECK(index == nextIndices[thread]);
+		nextIndices[thread] = index + 1;
+	}
+	for (uint32_t thread = 0; thread < kThreadCount; ++thread) {
+		CHECK(nextIndices[thread] == kRecordCount);
+	}
+}
+
+TEST_CASE("Logger: Flushとエラーは書き込まれるまで待つ") {
+
+	std::filesystem::path filePath = MakeLogPath("Flush.log");
+	Logger::Initialize(Logger::kSinkFile, filePath);
+
+	for (uint32_t i = 0; i < 1000; ++i) {
+		LOG_WARNING("record {}", i);
+	}
+
+	// 動いている間でもFlushの後にはファイルに書かれている
+	Logger::Flush();
+	std::vector<std::string> lines = ReadLines(filePath);
+	REQUIRE(lines.size() == 1000);
+	CHECK(lines.back().find("[Warning]") != std::string::npos);
+	CHECK(GetMessage(lines.back()) == "record 999");
+
+	// エラーはFlushを呼ばなくても戻った時点で書かれている (末尾の改行は1つにまとめる)
+	LOG_ERROR("failed {}\n", 5);
+	lines = ReadLines(filePath);
+	REQUIRE(lines.size() == 1001);
+	CHECK(lines.back().find("[Error]") != std::string::npos);
+	CHECK(GetMessage(lines.back()) == "failed 5");
+
+	Logger::Finalize();
+
+	// 止めた後のFlushはすぐ戻る
+	Logger::Flush();
+}
+
+TEST_CASE("Logger: 出力しない重要度のログは引数を評価しない") {
+
+	std::filesystem::path filePath = MakeLogPath("Severity.log");
+	Logger::Initialize(Logger::kSinkFile, filePath);
+
+	int evaluatedCount = 0;
+
+	// 実行時の下限より低い
+	Logger::SetMinSeverity(Logger::Severity::Warning);
+	LOG_INFO("{}", ++evaluatedCount);
+	CHECK(evaluatedCount == 0);
+	LOG_WARNING("{}", ++evaluatedCount);
+	CHECK(evaluatedCount == 1);
+
+	// コンパイル時の下限より低いものは実行時の下限を下げても消えたまま
+	Logger::SetMinSeverity(Logger::Severity::Debug);
+	LOG_DEBUG("{}", ++evaluatedCount);
+	CHECK(evaluatedCount == (Logger::IsCompiled(Logger::Severity::Debug) ? 2 : 1));
+	CHECK(Logger::IsEnabled(Logger::Severity::Debug) == Logger::IsCompiled(Logger::Severity::Debug));
+
+	Logger::SetMinSeverity(Logger::kCompiledMinSeverity);
+	Logger::Finalize();
+
+	std::vector<std::string> lines = ReadLines(filePath);
+	REQUIRE(lines.size() == static_cast<size_t>(evaluatedCount));
+	CHECK(GetMessage(lines[0]) == "1");
+}
+
+TEST_CASE("Logger: 初期化し直すと前のファイルを書き終えてから新しいファイルに書く") {
+
+	std::filesystem::path firstPath = MakeLogPath("First.log");
+	std::filesystem::path secondPath = MakeLogPath("Second.log");
+
+	Logger::Initialize(Logger::kSinkFile, firstPath);
+	for (uint32_t i = 0; i < 100; ++i) {
+		Logger::Log("first");
+	}
+
+	// Initializeは動いているものを止めてから始める
+	Logger::Initialize(Logger::kSinkFile, secondPath);
+	Logger::Log("second");
+	Logger::Finalize();
+
+	std::vector<std::string> firstLines = ReadLines(firstPath);
+	std::vector<std::string> secondLines = ReadLines(secondPath);
+	CHECK(firstLines.size() == 100);
+	REQUIRE(secondLines.size() == 1);
+	CHECK(GetMessage(secondLines[0]) == "second");
+
+	std::filesystem::remove_all(firstPath.parent_path());
+}
+
+TEST_CASE("Logger: 書き込み終わったログはプールに返り、積む側は割り当てずに使い回す") {
+
+	std::filesystem::path filePath = MakeLogPath("Pool.log");
+	Logger::Initialize(Logger::kSinkFile, filePath);
+
+	const uint32_t kBatchCount = 100;
+	const uint32_t kBatchSize = 64;
+
+	// 本文は先に作っておき、計るのはプールからの取り出しと積む処理だけにする
+	std::vector<std::string> messages;
+	for (uint32_t i = 0; i < kBatchSize; ++i) {
+		messages.push_back("record " + std::to_string(i));
+	}
+
+	// 積む側のスレッドで計る (スレッドごとのプールは初めて積んだときに作るか、終わったスレッドのものを引き継ぐ)
+	uint64_t writeAllocationCount = 0;
+	uint64_t formatAllocationCount = 0;
+	std::thread producer([&]() {
+
+		// 1回目でプールに同じ数のログが揃う
+		for (const std::string& message : messages) {
+			Logger::Write(Logger::Severity::Info, message);
+		}
+		Logger::Flush();
+
+		// 書き込み終わったものが返っているので、同じ数までなら割り当てない
+		uint64_t start = tAllocationCount;
+		for (uint32_t batch = 0; batch < kBatchCount; ++batch) {
+			for (const std::string& message : messages) {
+				Logger::Write(Logger::Severity::Info, message);
+			}
+			Logger::Flush();
+		}
+		writeAllocationCount = tAllocationCount - start;
+
+		// マクロは使い回しているログの本文に直接整形する
+		start = tAllocationCount;
+		for (uint32_t i = 0; i < kBatchSize; ++i) {
+			LOG_INFO("record {}", i);
+		}
+		Logger::Flush();
+		formatAllocationCount = tAllocationCount - start;
+	});
+	producer.join();
+
+	Logger::Finalize();
+
+	CHECK(writeAllocationCount == 0);
+
+	// 代わりの<format>(TestFramework/Compat)は整形そのものが割り当てるので、標準の<format>があるときだけ確かめる
+#ifdef __cpp_lib_format
+	CHECK(formatAllocationCount == 0);
+#else
+	(void)formatAllocationCount;
+#endif // __cpp_lib_format
+
+	// 使い回したログも全て書かれている
+	std::vector<std::string> lines = ReadLines(filePath);
+	REQUIRE(lines.size() == kBatchSize * (kBatchCount + 2));
+	for (uint32_t i = 0; i < kBatchSize; ++i) {
+		CHECK(GetMessage(lines[lines.size() - kBatchSize + i]) == messages[i]);
+	}
+}
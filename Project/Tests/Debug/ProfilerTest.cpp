@@ -0,0 +1,223 @@
+#include "TestFramework.h"
+#include "Profiler.h"
+
+#include <json.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Engine;
+
+/// キャプチャしたChromeのトレースをJSONとして読み直し、スレッドごとの区間が正しく入れ子になっているかを確かめる
+
+namespace {
+
+	// ワーカースレッドの数
+	const uint32_t kWorkerCount = 4;
+
+	// 1つのワーカースレッドが記録する外側の区間の数
+	const uint32_t kOuterCount = 3;
+
+	// トレースの区間 (時刻はナノ秒に戻す)
+	struct TraceZone {
+		std::string name;
+		uint64_t start;
+		uint64_t end;
+	};
+
+	/// <summary>
+	/// 時刻が進むまで待つ (時計の粗い環境でも、区間の開始と終了が同じ時刻に並ばないようにする)
+	/// </summary>
+	void WaitNextTick() {
+		uint64_t start = Profiler::GetTimestamp();
+		while (Profiler::GetTimestamp() == start) {
+			std::this_thread::yield();
+		}
+	}
+
+	/// <summary>
+	/// 入れ子の区間を記録する (外側1つに内側2つ、内側の1つはさらに1段深い)
+	/// </summary>
+	void RecordNestedZones() {
+
+		PROFILE_SCOPE("Outer");
+		WaitNextTick();
+		{
+			PROFILE_SCOPE("Inner");
+			WaitNextTick();
+			{
+				PROFILE_SCOPE("Innermost");
+				WaitNextTick();
+			}
+			WaitNextTick();
+		}
+		WaitNextTick();
+		{
+			PROFILE_SCOPE("Inner");
+			WaitNextTick();
+		}
+		WaitNextTick();
+	}
+
+	/// <summary>
+	/// マイクロ秒の小数をナノ秒に戻す (書き出しは小数3桁)
+	/// </summary>
+	uint64_t ToNanoseconds(double microseconds) {
+		return static_cast<uint64_t>(microseconds * 1000.0 + 0.5);
+	}
+}
+
+TEST_CASE("Profiler: 複数のスレッドの区間を書き出したトレースはJSONとして読め、スレッドごとに正しく入れ子になる") {
+
+	const std::filesystem::path tracePath = std::filesystem::temp_directory_path() / "ProfilerTest_trace.json";
+
+	Profiler::SetThreadName("Main \"Thread\"");
+	Profiler::StartCapture();
+
+	// 前のフレームの区切り
+	Profiler::BeginFrame();
+
+	{
+		PROFILE_SCOPE("MainFrame");
+
+		// ワーカースレッドで並べて記録する (メインスレッドの区間の中で動くが、スレッドが違うので入れ子にはならない)
+		std::vector<std::thread> workers;
+		for (uint32_t worker = 0; worker < kWorkerCount; ++worker) {
+			workers.emplace_back([worker]() {
+				Profiler::SetThreadName("Worker " + std::to_string(worker));
+				for (uint32_t i = 0; i < kOuterCount; ++i) {
+					RecordNestedZones();
+					WaitNextTick();
+				}
+			});
+		}
+		for (std::thread& worker : workers) worker.join();
+	}
+
+	// 区間を取り出してキャプチャに溜める
+	Profiler::BeginFrame();
+
+	// 取り出した区間の深さは、スレッドごとの入れ子の深さ
+	uint32_t workerZoneCount = 0;
+	for (const Profiler::ThreadZones& threadZones : Profiler::GetLastFrame()) {
+		for (const Profiler::Zone& zone : threadZones.zones) {
+			std::string name = zone.name;
+			if (name == "MainFrame" || name == "Outer") CHECK(zone.depth == 0);
+			if (name == "Inner") CHECK(zone.depth == 1);
+			if (name == "Innermost") CHECK(zone.depth == 2);
+			if (name != "MainFrame") workerZoneCount++;
+		}
+	}
+	CHECK(workerZoneCount == kWorkerCount * kOuterCount * 4);
+
+	REQUIRE(Profiler::StopCapture(tracePath));
+	CHECK(!Profiler::IsCapturing());
+
+	// ----------JSONとして読み直す----------
+	std::ifstream file(tracePath);
+	REQUIRE(file.is_open());
+	nlohmann::json trace = nlohmann::json::parse(file, nullptr, false);
+	file.close();
+	std::filesystem::remove(tracePath);
+
+	REQUIRE(!trace.is_discarded());
+	REQUIRE(trace.is_object());
+	CHECK(trace["displayTimeUnit"] == "ms");
+	REQUIRE(trace["traceEvents"].is_array());
+
+	std::map<uint32_t, std::string> threadNames;
+	std::map<uint32_t, std::vector<TraceZone>> threadZones;
+	uint32_t frameCount = 0;
+
+	for (const nlohmann::json& event : trace["traceEvents"]) {
+
+		REQUIRE(event.contains("ph"));
+		REQUIRE(event.contains("pid"));
+		REQUIRE(event.contains("tid"));
+		std::string phase = event["ph"];
+		uint32_t tid = event["tid"];
+
+		if (phase == "M") {
+			CHECK(event["name"] == "thread_name");
+			threadNames[tid] = event["args"]["name"];
+		}
+		else if (phase == "i") {
+			CHECK(event["name"] == "Frame");
+			frameCount++;
+		}
+		else if (phase == "X") {
+			double ts = event["ts"];
+			double dur = event["dur"];
+			CHECK(dur >= 0.0);
+			threadZones[tid].push_back({ event["name"], ToNanoseconds(ts), ToNanoseconds(ts) + ToNanoseconds(dur) });
+		}
+		else {
+			CHECK(false);
+		}
+	}
+
+	// フレームの区切りは2回のBeginFrameの分
+	CHECK(frameCount == 2);
+
+	// 名前の中の引用符も書き出しで崩れない
+	std::set<std::string> names;
+	for (const auto& [tid, name] : threadNames) names.insert(name);
+	CHECK(names.contains("Main \"Thread\""));
+	for (uint32_t worker = 0; worker < kWorkerCount; ++worker) {
+		CHECK(names.contains("Worker " + std::to_string(worker)));
+	}
+
+	// ----------スレッドごとに入れ子を確かめる----------
+	uint32_t workerThreadCount = 0;
+	for (auto& [tid, zones] : threadZones) {
+
+		// 区間のあるスレッドは名前も書き出されている
+		CHECK(threadNames.contains(tid));
+
+		// 開始の早い順、同時なら長い方(外側)を先に
+		std::sort(zones.begin(), zones.end(), [](const TraceZone& a, const TraceZone& b) {
+			return a.start != b.start ? a.start < b.start : a.end > b.end;
+		});
+
+		// 重なる区間は必ず外側に収まる (部分的に重なるものがあれば入れ子が崩れている)
+		std::vector<const TraceZone*> stack;
+		std::map<std::string, uint32_t> counts;
+		for (const TraceZone& zone : zones) {
+
+			while (!stack.empty() && stack.back()->end <= zone.start) {
+				stack.pop_back();
+			}
+			if (!stack.empty()) {
+				CHECK(zone.end <= stack.back()->end);
+
+				// 内側の区間の外側は決まっている
+				if (zone.name == "Inner") CHECK(stack.back()->name == "Outer");
+				if (zone.name == "Innermost") CHECK(stack.back()->name == "Inner");
+			}
+			else {
+				// 一番外側に来るのは外側の区間だけ (別のスレッドの区間の中に入れ子にならない)
+				CHECK(zone.name == "Outer" || zone.name == "MainFrame");
+			}
+
+			stack.push_back(&zone);
+			counts[zone.name]++;
+		}
+
+		// ワーカースレッドは全ての区間がそろっている
+		if (counts.contains("Outer")) {
+			CHECK(counts["Outer"] == kOuterCount);
+			CHECK(counts["Inner"] == kOuterCount * 2);
+			CHECK(counts["Innermost"] == kOuterCount);
+			CHECK(!counts.contains("MainFrame"));
+			workerThreadCount++;
+		}
+	}
+	CHECK(workerThreadCount == kWorkerCount);
+}
@@ -0,0 +1,108 @@
+#include "TestFramework.h"
+#include "EntityRegistry.h"
+#include "WorldTransform.h"
+#include "GameClock.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+using namespace Engine;
+
+/// 弾10000発の1ステップ (予約の反映、寿命、移動、行列の更新) をBulletSystem::Updateと同じ形で計る
+/// 3Dオブジェクトとコライダーへの反映はGPUのバッファに書くのでヘッドレスでは計らない
+
+namespace {
+
+	// 弾の数
+	const uint32_t kBulletCount = 10000;
+
+	// 計るステップ数
+	const uint32_t kStepCount = 200;
+
+	// 1ステップの時間
+	const float kFixedDeltaTime = 1.0f / 60.0f;
+
+	// 弾の動き (BulletMotionと同じ形)
+	struct Motion {
+		Vector3 velocity;
+		float lifeTime;
+	};
+}
+
+TEST_CASE("EntityRegistry: 弾10000発の1ステップ") {
+
+	GameClock::Initialize(kFixedDeltaTime);
+
+	EntityRegistry registry;
+	registry.Reserve<Motion, WorldTransform>(kBulletCount);
+
+	// 寿命は1秒前後にばらして、毎ステップ一部が消えて同じ数だけ補充されるようにする
+	auto spawn = [&registry](uint32_t i) {
+		Entity entity = registry.Create();
+		WorldTransform worldTransform;
+		worldTransform.Initialize();
+		worldTransform.SetTranslate({ static_cast<float>(i % 100), 0.0f, static_cast<float>(i / 100) });
+		registry.EmplaceDeferred(entity, Motion{ { 0.0f, 0.0f, 4.0f }, 0.5f + static_cast<float>(i % 60) * kFixedDeltaTime });
+		registry.EmplaceDeferred(entity, std::move(worldTransform));
+	};
+
+	for (uint32_t i = 0; i < kBulletCount; ++i) {
+		spawn(i);
+	}
+	registry.Flush();
+
+	std::vector<double> stepTimes;
+	stepTimes.reserve(kStepCount);
+	uint32_t spawnedCount = 0;
+
+	for (uint32_t step = 0; step < kStepCount; ++step) {
+
+		GameClock::Advance(kFixedDeltaTime);
+		GameClock::BeginStep();
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		// 前のステップで予約した生成と破棄を反映
+		registry.Flush();
+
+		// 消えた分を補充する (生成は予約なので次のステップで反映される)
+		while (registry.GetAliveCount() < kBulletCount) {
+			spawn(spawnedCount++);
+		}
+
+		// 寿命と移動と行列の更新
+		float deltaTime = GameClock::GetDeltaTime();
+		registry.ForEach<Motion, WorldTransform>([&registry, deltaTime](Entity entity, Motion& motion, WorldTransform& worldTransform) {
+
+			motion.lifeTime -= deltaTime;
+			if (motion.lifeTime <= 0.0f) {
+				registry.DestroyDeferred(entity);
+			}
+
+			worldTransform.AddTranslate(motion.velocity);
+			worldTransform.Update();
+		});
+
+		stepTimes.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	std::sort(stepTimes.begin(), stepTimes.end());
+	double median = stepTimes[stepTimes.size() / 2];
+	double p99 = stepTimes[stepTimes.size() * 99 / 100];
+
+	TestFramework::ReportMeasurement("bullets", static_cast<double>(kBulletCount), "");
+	TestFramework::ReportMeasurement("respawned during run", static_cast<double>(spawnedCount), "");
+	TestFramework::ReportMeasurement("step median", median, "ms");
+	TestFramework::ReportMeasurement("step p99", p99, "ms");
+	TestFramework::ReportMeasurement("step best", stepTimes.front(), "ms");
+
+	// 入れ替わりがあっても、反映した後は生きているエンティティが全て両方のコンポーネントを持つ
+	registry.Flush();
+	CHECK(spawnedCount > 0);
+	CHECK(registry.GetComponents<Motion>().size() == registry.GetAliveCount());
+	CHECK(registry.GetComponents<WorldTransform>().size() == registry.GetAliveCount());
+
+	// 1ステップは1ミリ秒を十分に下回る
+	CHECK(median < 1.0);
+}
@@ -0,0 +1,236 @@
+#include "TestFramework.h"
+#include "EntityRegistry.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+	// テスト用のコンポーネント
+	struct Tag {
+		int kind = 0;
+	};
+
+	struct Name {
+		std::string text;
+	};
+
+	struct Counted {
+		int value = 0;
+	};
+}
+
+TEST_CASE("EntityRegistry: 破棄した番号は世代を進めて再利用し、古いエンティティは無効になる") {
+
+	EntityRegistry registry;
+
+	Entity a = registry.Create();
+	Entity b = registry.Create();
+	CHECK(!a.IsNull());
+	CHECK(a.index != b.index);
+	CHECK(registry.IsAlive(a));
+	CHECK(registry.GetAliveCount() == 2);
+
+	registry.Destroy(a);
+	CHECK(!registry.IsAlive(a));
+	CHECK(registry.IsAlive(b));
+	CHECK(registry.GetAliveCount() == 1);
+
+	// 同じ番号を別の世代で使う
+	Entity c = registry.Create();
+	CHECK(c.index == a.index);
+	CHECK(c.generation != a.generation);
+	CHECK(registry.IsAlive(c));
+	CHECK(!registry.IsAlive(a));
+
+	// 空のエンティティは生きていない
+	CHECK(Entity{}.IsNull());
+	CHECK(!registry.IsAlive(Entity{}));
+
+	// 全て破棄すると今までのエンティティは全て無効になる
+	registry.Clear();
+	CHECK(!registry.IsAlive(b));
+	CHECK(!registry.IsAlive(c));
+	CHECK(registry.GetAliveCount() == 0);
+}
+
+TEST_CASE("EntityRegistry: 途中を取り除くと末尾の要素で詰め、位置の対応を保つ") {
+
+	EntityRegistry registry;
+
+	std::vector<Entity> entities;
+	for (int i = 0; i < 5; ++i) {
+		Entity entity = registry.Create();
+		registry.Emplace<Tag>(entity, Tag{ i });
+		entities.push_back(entity);
+	}
+
+	// 先頭を破棄すると末尾が先頭に来る
+	registry.Destroy(entities[0]);
+	std::span<Tag> tags = registry.GetComponents<Tag>();
+	std::span<const Entity> owners = registry.GetEntities<Tag>();
+	REQUIRE(tags.size() == 4);
+	CHECK(tags[0].kind == 4);
+	CHECK(owners[0] == entities[4]);
+
+	// コンポーネントだけを取り除いても詰める
+	registry.Remove<Tag>(entities[2]);
+	CHECK(!registry.Has<Tag>(entities[2]));
+	CHECK(registry.IsAlive(entities[2]));
+	CHECK(registry.GetComponents<Tag>().size() == 3);
+
+	// 残りは全てエンティティから正しく引ける
+	for (int i : { 1, 3, 4 }) {
+		REQUIRE(registry.Has<Tag>(entities[i]));
+		CHECK(registry.Get<Tag>(entities[i]).kind == i);
+	}
+
+	// 詰めた配列と持ち主の配列は同じ位置で対応する
+	tags = registry.GetComponents<Tag>();
+	owners = registry.GetEntities<Tag>();
+	for (size_t i = 0; i < tags.size(); ++i) {
+		CHECK(registry.Get<Tag>(owners[i]).kind == tags[i].kind);
+	}
+
+	// 末尾を取り除くときは移さない
+	registry.Destroy(owners.back());
+	CHECK(registry.GetComponents<Tag>().size() == 2);
+
+	// 既にあれば置き換える
+	registry.Emplace<Tag>(entities[1], Tag{ 10 });
+	CHECK(registry.Get<Tag>(entities[1]).kind == 10);
+	CHECK(registry.GetComponents<Tag>().size() == 2);
+}
+
+TEST_CASE("EntityRegistry: ForEachは全ての種類を持つエンティティだけを回す") {
+
+	EntityRegistry registry;
+
+	Entity a = registry.Create();
+	Entity b = registry.Create();
+	Entity c = registry.Create();
+	registry.Emplace<Tag>(a, Tag{ 1 });
+	registry.Emplace<Tag>(b, Tag{ 2 });
+	registry.Emplace<Tag>(c, Tag{ 3 });
+	registry.Emplace<Name>(b, Name{ "b" });
+
+	uint32_t count = 0;
+	registry.ForEach<Tag, Name>([&](Entity entity, Tag& tag, Name& name) {
+		CHECK(entity == b);
+		CHECK(tag.kind == 2);
+		CHECK(name.text == "b");
+		count++;
+	});
+	CHECK(count == 1);
+
+	// 一度も使っていない種類は回さない
+	registry.ForEach<Counted>([&count](Entity, Counted&) { count++; });
+	CHECK(count == 1);
+	CHECK(registry.TryGet<Counted>(a) == nullptr);
+	CHECK(registry.GetComponents<Counted>().empty());
+
+	// 破棄したエンティティのコンポーネントは引けない
+	registry.Destroy(b);
+	CHECK(!registry.Has<Name>(b));
+	CHECK(registry.TryGet<Tag>(b) == nullptr);
+}
+
+TEST_CASE("EntityRegistry: 予約した追加と破棄はFlushで反映し、反復中でも予約できる") {
+
+	EntityRegistry registry;
+
+	Entity a = registry.Create();
+	Entity b = registry.Create();
+	registry.Emplace<Tag>(a, Tag{ 1 });
+	registry.Emplace<Tag>(b, Tag{ 2 });
+
+	// 反復中に生成と追加と破棄を予約する (配列の並びは変わらない)
+	std::vector<Entity> spawned;
+	registry.ForEach<Tag>([&](Entity entity, Tag& tag) {
+
+		Entity child = registry.Create();
+		registry.EmplaceDeferred(child, Tag{ tag.kind * 10 });
+		spawned.push_back(child);
+
+		if (tag.kind == 1) {
+			registry.DestroyDeferred(entity);
+		}
+	});
+
+	// 反映するまでは変わらない
+	CHECK(registry.GetComponents<Tag>().size() == 2);
+	CHECK(registry.IsAlive(a));
+	REQUIRE(spawned.size() == 2);
+	CHECK(!registry.Has<Tag>(spawned[0]));
+
+	registry.Flush();
+	CHECK(!registry.IsAlive(a));
+	CHECK(registry.GetComponents<Tag>().size() == 3);
+	CHECK(registry.Get<Tag>(spawned[0]).kind == 10);
+	CHECK(registry.Get<Tag>(spawned[1]).kind == 20);
+
+	// 同じフレームに作って壊したものは残らない (何度予約してもよい)
+	Entity temporary = registry.Create();
+	registry.EmplaceDeferred(temporary, Tag{ 99 });
+	registry.DestroyDeferred(temporary);
+	registry.DestroyDeferred(temporary);
+	registry.Flush();
+	CHECK(!registry.IsAlive(temporary));
+	CHECK(registry.GetComponents<Tag>().size() == 3);
+
+	// 反映する前に破棄すると予約も捨て、番号を再利用したエンティティには付かない
+	Entity dropped = registry.Create();
+	registry.EmplaceDeferred(dropped, Tag{ 5 });
+	registry.Destroy(dropped);
+	Entity reused = registry.Create();
+	CHECK(reused.index == dropped.index);
+	registry.Flush();
+	CHECK(!registry.Has<Tag>(reused));
+
+	// 全て破棄すると予約も捨てる
+	registry.DestroyDeferred(b);
+	registry.Clear();
+	registry.Flush();
+	CHECK(registry.GetAliveCount() == 0);
+	CHECK(registry.GetComponents<Tag>().empty());
+}
+
+TEST_CASE("EntityRegistry: Reserveした数までは生成と追加で配列を確保し直さない") {
+
+	const uint32_t kCapacity = 512;
+
+	EntityRegistry registry;
+	registry.Reserve<Tag, Counted>(kCapacity);
+
+	// 確保し直すと先頭の位置が変わる
+	Entity first = registry.Create();
+	registry.EmplaceDeferred(first, Tag{ 0 });
+	registry.EmplaceDeferred(first, Counted{ 0 });
+	registry.Flush();
+	const Tag* tagData = registry.GetComponents<Tag>().data();
+	const Counted* countedData = registry.GetComponents<Counted>().data();
+
+	for (uint32_t i = 1; i < kCapacity; ++i) {
+		Entity entity = registry.Create();
+		registry.EmplaceDeferred(entity, Tag{ static_cast<int>(i) });
+		registry.EmplaceDeferred(entity, Counted{ static_cast<int>(i) });
+	}
+	registry.Flush();
+
+	CHECK(registry.GetComponents<Tag>().size() == kCapacity);
+	CHECK(registry.GetComponents<Tag>().data() == tagData);
+	CHECK(registry.GetComponents<Counted>().data() == countedData);
+
+	// 全て破棄して作り直しても同じ配列を使う
+	registry.ForEach<Tag>([&registry](Entity entity, Tag&) { registry.DestroyDeferred(entity); });
+	registry.Flush();
+	CHECK(registry.GetAliveCount() == 0);
+
+	for (uint32_t i = 0; i < kCapacity; ++i) {
+		registry.Emplace<Tag>(registry.Create(), Tag{ static_cast<int>(i) });
+	}
+	CHECK(registry.GetComponents<Tag>().data() == tagData);
+}
@@ -0,0 +1,168 @@
+#include "TestFramework.h"
+#include "GameClock.h"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+	// 比べるシミュレーションのステップ数 (60Hzで10秒)
+	const uint64_t kStepCount = 600;
+
+	/// === テスト用のシミュレーション === ///
+	/// 重力で落ちて床で跳ね返る玉と、速度に比例して減衰するばね。刻みがずれると結果がすぐに変わる
+	struct Simulation {
+
+		struct Ball {
+			float position[3];
+			float velocity[3];
+		};
+
+		Simulation() {
+			for (uint32_t i = 0; i < 32; ++i) {
+				balls.push_back({ { float(i), 5.0f + float(i % 7), 0.0f }, { 1.0f - float(i) * 0.05f, 0.0f, float(i % 3) } });
+			}
+		}
+
+		// 1ステップ進める
+		void Step(float deltaTime) {
+
+			for (Ball& ball : balls) {
+
+				ball.velocity[1] -= 9.8f * deltaTime;
+				for (uint32_t axis = 0; axis < 3; ++axis) {
+					ball.position[axis] += ball.velocity[axis] * deltaTime;
+				}
+
+				// 床で跳ね返る
+				if (ball.position[1] < 0.0f) {
+					ball.position[1] = -ball.position[1];
+					ball.velocity[1] = -ball.velocity[1] * 0.8f;
+				}
+			}
+
+			springVelocity += (-40.0f * springPosition - 0.5f * springVelocity) * deltaTime;
+			springPosition += springVelocity * deltaTime;
+		}
+
+		// ビット単位で同じか
+		bool operator==(const Simulation& other) const {
+			return std::memcmp(balls.data(), other.balls.data(), sizeof(Ball) * balls.size()) == 0 &&
+				std::memcmp(&springPosition, &other.springPosition, sizeof(float)) == 0 &&
+				std::memcmp(&springVelocity, &other.springVelocity, sizeof(float)) == 0;
+		}
+
+		std::vector<Ball> balls;
+		float springPosition = 1.0f;
+		float springVelocity = 0.0f;
+	};
+
+	/// <summary>
+	/// Framework::Updateと同じ手順で、フレームの経過時間を渡してkStepCountステップまで進める
+	/// </summary>
+	/// <param name="nextFrameTime">次のフレームの経過時間を返す関数</param>
+	/// <param name="frameCount">かかったフレーム数</param>
+	template <typename FrameTimeFunction>
+	Simulation Run(FrameTimeFunction nextFrameTime, uint64_t& frameCount) {
+
+		GameClock::Initialize(GameClock::kDefaultFixedDeltaTime);
+
+		Simulation simulation;
+		while (GameClock::GetStepCount() < kStepCount) {
+
+			uint32_t stepCount = GameClock::Advance(nextFrameTime());
+			for (uint32_t i = 0; i < stepCount && GameClock::GetStepCount() < kStepCount; ++i) {
+				GameClock::BeginStep();
+				simulation.Step(GameClock::GetDeltaTime());
+			}
+
+			// 補間係数は常に0~1
+			CHECK(GameClock::GetAlpha() >= 0.0f);
+			CHECK(GameClock::GetAlpha() <= 1.0f);
+		}
+
+		frameCount = GameClock::GetFrameCount();
+		return simulation;
+	}
+}
+
+TEST_CASE("GameClock: 30Hz、60Hz、144Hzで同じステップ数なら結果がビット単位で同じ") {
+
+	uint64_t frameCount30 = 0;
+	uint64_t frameCount60 = 0;
+	uint64_t frameCount144 = 0;
+
+	Simulation result30 = Run([]() { return 1.0f / 30.0f; }, frameCount30);
+	Simulation result60 = Run([]() { return 1.0f / 60.0f; }, frameCount60);
+	Simulation result144 = Run([]() { return 1.0f / 144.0f; }, frameCount144);
+
+	CHECK(result30 == result60);
+	CHECK(result144 == result60);
+
+	// 描画の回数はフレームレートに比例する (最初のフレームは溜めなしで1ステップ進む)
+	CHECK(frameCount30 == kStepCount / 2);
+	CHECK(std::abs(static_cast<double>(frameCount144) - kStepCount * 144.0 / 60.0) <= 2.0);
+	CHECK(frameCount60 <= kStepCount + 1);
+
+	// 刻みを変えれば結果は変わる (比較がうまく働いている)
+	GameClock::Initialize(1.0f / 50.0f);
+	Simulation other;
+	for (uint64_t i = 0; i < kStepCount; ++i) {
+		other.Step(GameClock::GetDeltaTime());
+	}
+	CHECK(!(other == result60));
+}
+
+TEST_CASE("GameClock: フレーム時間が揺れても結果は同じ") {
+
+	uint64_t frameCount = 0;
+	std::mt19937 random(5);
+	std::uniform_real_distribution<float> frameTimeDistribution(0.004f, 0.05f);
+
+	Simulation jittered = Run([&]() { return frameTimeDistribution(random); }, frameCount);
+	Simulation steady = Run([]() { return 1.0f / 60.0f; }, frameCount);
+
+	CHECK(jittered == steady);
+}
+
+TEST_CASE("GameClock: 最初のフレームは経過時間が0でも1ステップ進む") {
+
+	GameClock::Initialize(1.0f / 60.0f);
+	CHECK(GameClock::Advance(0.0f) == 1);
+	CHECK(GameClock::Advance(0.0f) == 0);
+	CHECK(GameClock::GetFrameCount() == 2);
+}
+
+TEST_CASE("GameClock: 144Hzでは2~3フレームに1回ステップが進み、補間係数は端数の割合") {
+
+	GameClock::Initialize(1.0f / 60.0f);
+	GameClock::Advance(0.0f);
+
+	// 1/144秒は1/60秒の0.4167倍
+	CHECK(GameClock::Advance(1.0f / 144.0f) == 0);
+	CHECK(std::abs(GameClock::GetAlpha() - 60.0f / 144.0f) < 1e-4f);
+	CHECK(GameClock::Advance(1.0f / 144.0f) == 0);
+	CHECK(GameClock::Advance(1.0f / 144.0f) == 1);
+	CHECK(std::abs(GameClock::GetAlpha() - (3.0f * 60.0f / 144.0f - 1.0f)) < 1e-4f);
+}
+
+TEST_CASE("GameClock: 長く止まったフレームは上限で切り詰め、1フレームのステップ数にも上限がある") {
+
+	GameClock::Initialize(1.0f / 60.0f);
+	GameClock::Advance(0.0f);
+
+	// 2秒止まっても0.25秒分 (15ステップ) しか取り戻さず、さらに上限で切る
+	CHECK(GameClock::Advance(2.0f) == GameClock::kMaxStepsPerFrame);
+	CHECK(GameClock::GetFrameTime() == GameClock::kMaxFrameTime);
+
+	// 捨てた分は次のフレームに持ち越さない
+	CHECK(GameClock::Advance(0.0f) == 0);
+
+	// 時間が戻っても進まない
+	CHECK(GameClock::Advance(-1.0f) == 0);
+	CHECK(GameClock::GetFrameTime() == 0.0f);
+}
@@ -0,0 +1,152 @@
+#include "TestFramework.h"
+#include "JobSystem.h"
+#include "FrameCounters.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace Engine;
+
+/// ジョブ1つを積むのにかかる時間と、他のキューから盗んだ割合を計る
+/// 積む時間は、以前のようにジョブとstd::functionを毎回ヒープに確保する場合と比べる
+
+namespace {
+
+	// 積むジョブの数
+	const uint32_t kJobCount = 100000;
+
+	// ワーカースレッドの数
+	const uint32_t kWorkerCount = 3;
+
+	// ワーカーを待たせている間に積む数 (キューの容量に収める)
+	const uint32_t kBatchSize = 4000;
+
+	// 以前のジョブ (積むたびに確保していた)
+	struct HeapJob {
+		const char* name;
+		std::function<void()> function;
+		JobSystem::Counter* counter;
+		JobSystem::Affinity affinity;
+	};
+
+	/// <summary>
+	/// 関数の実行にかかった時間を計る
+	/// </summary>
+	template <typename Function>
+	double ElapsedMilliseconds(Function function) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		function();
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	/// <summary>
+	/// ミリ秒をジョブ1つあたりのナノ秒にする
+	/// </summary>
+	double ToNanosecondsPerJob(double milliseconds) {
+		return milliseconds * 1000000.0 / static_cast<double>(kJobCount);
+	}
+}
+
+TEST_CASE("JobSystem: 積む時間と盗んだ割合") {
+
+	FrameCounters* frameCounters = FrameCounters::GetInstance();
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	jobSystem->Initialize(kWorkerCount);
+
+	std::atomic<uint64_t> sum = 0;
+
+	// ----------以前の確保の仕方 (確保と解放だけ)----------
+	double heapTime = ElapsedMilliseconds([&sum]() {
+		for (uint32_t i = 0; i < kJobCount; ++i) {
+			uint64_t values[4] = { i, i, i, i };
+			HeapJob* job = new HeapJob{ "Heap", [&sum, values]() { sum += values[0]; }, nullptr, JobSystem::Affinity::Any };
+			TestFramework::DoNotOptimize(job);
+			delete job;
+		}
+	});
+
+	// ----------メインスレッドから積むだけの時間----------
+	// ワーカーを待たせておき、積む間に実行が重ならないようにする (コアが1つでも積む時間だけを計れる)
+	auto spawnBatch = [jobSystem, &sum](JobSystem::Counter& counter) {
+		std::atomic<bool> gate = false;
+		std::atomic<uint32_t> blockedCount = 0;
+		JobSystem::Counter blockCounter;
+		for (uint32_t i = 0; i < kWorkerCount; ++i) {
+			jobSystem->Spawn("Block", [&gate, &blockedCount]() { blockedCount++; gate.wait(false); }, &blockCounter);
+		}
+
+		// ワーカーが全て待つまで待つ
+		while (blockedCount.load() < kWorkerCount) {
+			std::this_thread::yield();
+		}
+
+		double time = ElapsedMilliseconds([&]() {
+			for (uint32_t i = 0; i < kBatchSize; ++i) {
+				uint64_t values[4] = { i, i, i, i };
+				jobSystem->Spawn("Spawn", [&sum, values]() { sum += values[0]; }, &counter);
+			}
+		});
+
+		gate = true;
+		gate.notify_all();
+		jobSystem->Wait(blockCounter);
+		return time;
+	};
+
+	// 置き場を行き渡らせてから計る
+	{
+		JobSystem::Counter counter;
+		spawnBatch(counter);
+		jobSystem->Wait(counter);
+	}
+
+	double spawnTime = 0.0;
+	for (uint32_t batch = 0; batch < kJobCount / kBatchSize; ++batch) {
+		JobSystem::Counter counter;
+		spawnTime += spawnBatch(counter);
+		jobSystem->Wait(counter);
+	}
+
+	// ----------ジョブの中から積んで盗ませる (積んだスレッドとは別のスレッドが実行した割合)----------
+	frameCounters->BeginFrame();
+	double fanOutTime = ElapsedMilliseconds([&]() {
+		JobSystem::Counter outerCounter;
+		for (uint32_t i = 0; i < kJobCount / 1000; ++i) {
+			jobSystem->Spawn("Outer", [jobSystem, &sum]() {
+				JobSystem::Counter innerCounter;
+				for (uint32_t j = 0; j < 1000; ++j) {
+					jobSystem->Spawn("Inner", [&sum, j]() { sum += j; }, &innerCounter);
+				}
+				jobSystem->Wait(innerCounter);
+			}, &outerCounter);
+		}
+		jobSystem->Wait(outerCounter);
+	});
+	frameCounters->BeginFrame();
+
+	uint64_t jobCount = frameCounters->GetValue(frameCounters->Register("Jobs"));
+	uint64_t stealCount = frameCounters->GetValue(frameCounters->Register("JobSteals"));
+
+	TestFramework::ReportMeasurement("jobs", static_cast<double>(kJobCount), "");
+	TestFramework::ReportMeasurement("hardware threads", static_cast<double>(std::thread::hardware_concurrency()), "");
+	TestFramework::ReportMeasurement("new Job + std::function (previous)", ToNanosecondsPerJob(heapTime), "ns/job");
+	TestFramework::ReportMeasurement("Spawn (pooled, 32-byte capture, queue push included)", ToNanosecondsPerJob(spawnTime), "ns/job");
+	TestFramework::ReportMeasurement("allocated jobs", static_cast<double>(jobSystem->GetAllocatedJobCount()), "");
+	TestFramework::ReportMeasurement("fan-out Spawn + Wait", ToNanosecondsPerJob(fanOutTime), "ns/job");
+	TestFramework::ReportMeasurement("fan-out jobs executed", static_cast<double>(jobCount), "");
+	TestFramework::ReportMeasurement("fan-out steal rate", jobCount ? 100.0 * static_cast<double>(stealCount) / static_cast<double>(jobCount) : 0.0, "%");
+
+	CHECK(jobCount == kJobCount + kJobCount / 1000);
+	CHECK(spawnTime < heapTime * 2.0);
+
+	// 使い回せていれば確保したジョブは積んだ数よりずっと少ない
+	CHECK(jobSystem->GetAllocatedJobCount() < kJobCount);
+
+	TestFramework::DoNotOptimize(sum.load());
+
+	jobSystem->Finalize();
+	frameCounters->Finalize();
+}
@@ -0,0 +1,258 @@
+#include "TestFramework.h"
+#include "JobSystem.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <thread>
+#include <vector>
+
+using namespace Engine;
+
+/// コアが1つの環境でも通るように、並列に速くなることは確かめず、結果と順番だけを確かめる
+/// ThreadSanitizerで確かめるときは -DENGINE_TESTS_TSAN=ON でビルドする
+
+namespace {
+
+	// ワーカースレッドの数 (コアの数に関係なく取り合いが起きるようにする)
+	const uint32_t kWorkerCount = 4;
+}
+
+TEST_CASE("JobSystem: 積んだジョブは全て1回ずつ実行され、カウンターで待てる") {
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	jobSystem->Initialize(kWorkerCount);
+	CHECK(jobSystem->GetWorkerCount() == kWorkerCount);
+
+	const uint32_t kJobCount = 10000;
+	std::vector<std::atomic<uint32_t>> runCounts(kJobCount);
+
+	JobSystem::Counter counter;
+	for (uint32_t i = 0; i < kJobCount; ++i) {
+		jobSystem->Spawn("Count", [&runCounts, i]() { runCounts[i]++; }, &counter);
+	}
+	jobSystem->Wait(counter);
+
+	CHECK(counter.IsDone());
+	for (uint32_t i = 0; i < kJobCount; ++i) {
+		CHECK(runCounts[i].load() == 1);
+	}
+
+	jobSystem->Finalize();
+}
+
+TEST_CASE("JobSystem: 依存するジョブは依存先が全て完了してから実行する") {
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	jobSystem->Initialize(kWorkerCount);
+
+	for (uint32_t repeat = 0; repeat < 100; ++repeat) {
+
+		std::vector<int> values(100, 0);
+		int total = -1;
+		bool isMainThread = false;
+
+		// 値を書く → 合計する → メインスレッドで受け取る
+		JobSystem::Counter writeCounter;
+		JobSystem::Counter sumCounter;
+		JobSystem::Counter mainCounter;
+		for (int i = 0; i < 100; ++i) {
+			jobSystem->Spawn("Write", [&values, i]() { values[i] = i; }, &writeCounter);
+		}
+		jobSystem->SpawnAfter(writeCounter, "Sum", [&values, &total]() { total = std::accumulate(values.begin(), values.end(), 0); }, &sumCounter);
+		jobSystem->SpawnAfter(sumCounter, "Main", [jobSystem, &isMainThread]() { isMainThread = jobSystem->IsMainThread(); }, &mainCounter, JobSystem::Affinity::MainThread);
+		jobSystem->Wait(mainCounter);
+
+		REQUIRE(total == 4950);
+		CHECK(isMainThread);
+	}
+
+	// 完了済みのカウンターに依存させるとすぐに積まれる
+	JobSystem::Counter doneCounter;
+	JobSystem::Counter afterCounter;
+	bool isRun = false;
+	jobSystem->SpawnAfter(doneCounter, "After", [&isRun]() { isRun = true; }, &afterCounter);
+	jobSystem->Wait(afterCounter);
+	CHECK(isRun);
+
+	jobSystem->Finalize();
+}
+
+TEST_CASE("JobSystem: メインスレッド指定のジョブはワーカーから積んでもメインスレッドで実行する") {
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	jobSystem->Initialize(kWorkerCount);
+
+	std::atomic<uint32_t> mainThreadCount = 0;
+	JobSystem::Counter mainCounter;
+
+	JobSystem::Counter workerCounter;
+	for (uint32_t i = 0; i < 32; ++i) {
+		jobSystem->Spawn("Worker", [jobSystem, &mainThreadCount, &mainCounter]() {
+			jobSystem->Spawn("Main", [jobSystem, &mainThreadCount]() {
+				if (jobSystem->IsMainThread()) {
+					mainThreadCount++;
+				}
+			}, &mainCounter, JobSystem::Affinity::MainThread);
+		}, &workerCounter);
+	}
+	jobSystem->Wait(workerCounter);
+
+	// ワーカーは実行しないので、メインスレッドが取り出すまで残る
+	jobSystem->RunMainThreadJobs();
+	CHECK(mainCounter.IsDone());
+	CHECK(mainThreadCount.load() == 32);
+
+	jobSystem->Finalize();
+}
+
+TEST_CASE("JobSystem: ジョブの中やジョブシステムの外のスレッドから積んでも失わない") {
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	jobSystem->Initialize(kWorkerCount);
+
+	std::atomic<uint32_t> runCount = 0;
+
+	// 外のスレッドから積んで待つ
+	std::thread externalThread([jobSystem, &runCount]() {
+		JobSystem::Counter counter;
+		for (uint32_t i = 0; i < 500; ++i) {
+			jobSystem->Spawn("External", [&runCount]() { runCount++; }, &counter);
+		}
+		jobSystem->Wait(counter);
+	});
+
+	// ジョブの中から積んで待つ
+	JobSystem::Counter outerCounter;
+	for (uint32_t i = 0; i < 64; ++i) {
+		jobSystem->Spawn("Outer", [jobSystem, &runCount]() {
+			JobSystem::Counter innerCounter;
+			for (uint32_t j = 0; j < 32; ++j) {
+				jobSystem->Spawn("Inner", [&runCount]() { runCount++; }, &innerCounter);
+			}
+			jobSystem->Wait(innerCounter);
+		}, &outerCounter);
+	}
+	jobSystem->Wait(outerCounter);
+	externalThread.join();
+
+	CHECK(runCount.load() == 64 * 32 + 500);
+
+	jobSystem->Finalize();
+}
+
+TEST_CASE("JobSystem: ParallelForは全ての要素を1回ずつ処理する") {
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	jobSystem->Initialize(kWorkerCount);
+
+	for (uint32_t count : { 0u, 1u, 255u, 256u, 257u, 100000u }) {
+
+		std::vector<uint32_t> values(count, 1);
+		jobSystem->ParallelFor("Double", std::span<uint32_t>(values), 256, [](uint32_t& value) { value *= 2; });
+		CHECK(std::accumulate(values.begin(), values.end(), 0ull) == 2ull * count);
+	}
+
+	// 粒度0は1として扱う
+	std::atomic<uint32_t> rangeCount = 0;
+	jobSystem->ParallelFor("GrainZero", 100, 0, [&rangeCount](uint32_t begin, uint32_t end) {
+		CHECK(end == begin + 1);
+		rangeCount++;
+	});
+	CHECK(rangeCount.load() == 100);
+
+	jobSystem->Finalize();
+}
+
+TEST_CASE("JobSystem: 大きなキャプチャも実行でき、実行後に破棄する") {
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	jobSystem->Initialize(kWorkerCount);
+
+	std::shared_ptr<int> owner = std::make_shared<int>(0);
+	std::array<uint64_t, 32> largeCapture{};
+	largeCapture.back() = 7;
+	uint64_t largeResult = 0;
+
+	JobSystem::Counter counter;
+
+	// ジョブの中に入る大きさ
+	jobSystem->Spawn("Small", [owner]() { (*owner)++; }, &counter);
+
+	// 入らないのでヒープに置く大きさ
+	jobSystem->Spawn("Large", [owner, largeCapture, &largeResult]() { largeResult = largeCapture.back(); (*owner)++; }, &counter);
+
+	// std::functionもそのまま渡せる
+	std::function<void()> function = [owner]() { (*owner)++; };
+	jobSystem->Spawn("Function", function, &counter);
+	function = nullptr;
+
+	jobSystem->Wait(counter);
+
+	CHECK(*owner == 3);
+	CHECK(largeResult == 7);
+
+	// 実行したジョブのキャプチャは残っていない
+	CHECK(owner.use_count() == 1);
+
+	jobSystem->Finalize();
+}
+
+TEST_CASE("JobSystem: 使い終わったジョブを使い回し、積むたびに確保しない") {
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	jobSystem->Initialize(kWorkerCount);
+
+	const uint32_t kJobCount = 2000;
+	std::atomic<uint32_t> runCount = 0;
+
+	auto spawnAll = [jobSystem, &runCount]() {
+		JobSystem::Counter counter;
+		for (uint32_t i = 0; i < kJobCount; ++i) {
+			jobSystem->Spawn("Reuse", [&runCount]() { runCount++; }, &counter);
+		}
+		jobSystem->Wait(counter);
+	};
+
+	// 1回目で置き場が行き渡る
+	spawnAll();
+	uint32_t allocatedJobCount = jobSystem->GetAllocatedJobCount();
+	CHECK(allocatedJobCount >= 1);
+
+	// 盗まれたジョブは他のスレッドに戻るが、共有の置き場を通して積む側に戻るので増え続けない
+	for (uint32_t repeat = 0; repeat < 50; ++repeat) {
+		spawnAll();
+	}
+	CHECK(runCount.load() == kJobCount * 51);
+	CHECK(jobSystem->GetAllocatedJobCount() <= allocatedJobCount + kJobCount);
+
+	jobSystem->Finalize();
+}
+
+TEST_CASE("JobSystem: 初期化の前と終了の後はその場で実行し、初期化し直せる") {
+
+	std::atomic<uint32_t> runCount = 0;
+	auto spawnAll = [&runCount]() {
+		JobSystem::Counter counter;
+		for (uint32_t i = 0; i < 100; ++i) {
+			JobSystem::GetInstance()->Spawn("Count", [&runCount]() { runCount++; }, &counter);
+		}
+		JobSystem::GetInstance()->Wait(counter);
+	};
+
+	for (uint32_t repeat = 0; repeat < 2; ++repeat) {
+
+		// 初期化の前 (前の終了の後) は積んだスレッドでその場で実行する
+		bool isRun = false;
+		JobSystem::GetInstance()->Spawn("Inline", [&isRun]() { isRun = true; });
+		CHECK(isRun);
+
+		JobSystem::GetInstance()->Initialize(kWorkerCount);
+		spawnAll();
+		JobSystem::GetInstance()->Finalize();
+	}
+
+	CHECK(runCount.load() == 200);
+}
@@ -0,0 +1,97 @@
+#include "TestFramework.h"
+#include "LevelFileWriter.h"
+#include "BinaryLevel.h"
+#include "LevelData.h"
+#include "LevelParser.h"
+
+#include "json.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <numbers>
+
+using namespace Engine;
+
+/// 2万オブジェクトのレベルを、JSONの解析とバイナリレベルの読み込みで比べる
+/// JSON側はLoaderやLevelStreamerと同じLevelParser::ParseJsonFileで解析する
+
+namespace {
+
+	// オブジェクト数
+	const uint32_t kObjectCount = 20000;
+}
+
+TEST_CASE("BinaryLevel: 2万オブジェクトのJSONとバイナリ") {
+
+	std::string jsonPath = (std::filesystem::temp_directory_path() / "BinaryLevelBenchmark.json").string();
+	std::string binaryPath = (std::filesystem::temp_directory_path() / "BinaryLevelBenchmark.level").string();
+
+	// 同じ内容のJSONとバイナリを作る
+	const char* modelNames[] = { "floor", "Gate", "Goal", "enemy", "cylinder" };
+	LevelFileWriter writer;
+	for (const char* name : modelNames) writer.AddModel("Stage", name);
+
+	nlohmann::json jsonObjects = nlohmann::json::array();
+
+	for (uint32_t i = 0; i < kObjectCount; ++i) {
+
+		float x = float(i % 100) * 4.0f;
+		float z = float(i / 100) * 4.0f;
+		float angle = float(i % 360);
+		bool hasCollider = (i % 3) == 0;
+
+		LevelFileFormat::Object object{};
+		object.modelIndex = i % 5;
+		object.translation = { x, 0.0f, z };
+		object.rotation = { 0.0f, angle * (std::numbers::pi_v<float> / 180.0f), 0.0f };
+		object.scale = { 1.0f, 1.0f, 1.0f };
+		if (hasCollider) {
+			object.colliderType = LevelFileFormat::ColliderType::Box;
+			object.colliderSize = { 2.0f, 2.0f, 2.0f };
+		}
+		writer.objects.push_back(object);
+
+		// Blender座標系 (yとzが入れ替わり、回転は度数法)
+		nlohmann::json jsonObject = {
+			{ "type", "MESH" },
+			{ "name", modelNames[i % 5] },
+			{ "transform", { { "translation", { x, z, 0.0f } }, { "rotation", { 0.0f, 0.0f, angle } }, { "scaling", { 1.0f, 1.0f, 1.0f } } } },
+		};
+		if (hasCollider) {
+			jsonObject["collider"] = { { "type", "BOX" }, { "center", { 0.0f, 0.0f, 0.0f } }, { "size", { 2.0f, 2.0f, 2.0f } } };
+		}
+		jsonObjects.push_back(std::move(jsonObject));
+	}
+
+	REQUIRE(writer.Write(binaryPath));
+	std::ofstream(jsonPath) << nlohmann::json{ { "name", "scene" }, { "objects", jsonObjects } }.dump();
+
+	double jsonTime = TestFramework::MeasureMilliseconds(5, [&]() {
+		std::unique_ptr<LevelData> levelData = LevelParser::ParseJsonFile(jsonPath);
+		REQUIRE(levelData->GetObjects().size() == kObjectCount);
+	});
+
+	double binaryTime = TestFramework::MeasureMilliseconds(5, [&]() {
+		BinaryLevel level;
+		REQUIRE(level.Open(binaryPath));
+		std::unique_ptr<LevelData> levelData = level.ToLevelData();
+		REQUIRE(levelData->GetObjects().size() == kObjectCount);
+	});
+
+	// 配置せずに参照するだけなら変換もいらない
+	double mapOnlyTime = TestFramework::MeasureMilliseconds(5, [&]() {
+		BinaryLevel level;
+		REQUIRE(level.Open(binaryPath));
+		REQUIRE(level.GetObjects().size() == kObjectCount);
+	});
+
+	TestFramework::ReportMeasurement("json (" + std::to_string(std::filesystem::file_size(jsonPath) / 1024) + " KB)", jsonTime, "ms");
+	TestFramework::ReportMeasurement("binary Open + ToLevelData (" + std::to_string(std::filesystem::file_size(binaryPath) / 1024) + " KB)", binaryTime, "ms");
+	TestFramework::ReportMeasurement("binary Open only", mapOnlyTime, "ms");
+	TestFramework::ReportMeasurement("speedup", jsonTime / binaryTime, "x");
+
+	CHECK(binaryTime < jsonTime);
+
+	std::filesystem::remove(jsonPath);
+	std::filesystem::remove(binaryPath);
+}
@@ -0,0 +1,201 @@
+#include "TestFramework.h"
+#include "LevelFileWriter.h"
+#include "BinaryLevel.h"
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace Engine;
+
+namespace {
+
+	/// <summary>
+	/// テスト用の一時ファイルのパスを作る
+	/// </summary>
+	std::string MakeTempPath(const char* name) {
+		return (std::filesystem::temp_directory_path() / (std::string("BinaryLevelTest_") + name + LevelFileFormat::kExtension)).string();
+	}
+
+	/// <summary>
+	/// モデル2つ、オブジェクト3つ、自キャラ1つ、敵キャラ2つのレベルを作る
+	/// </summary>
+	LevelFileWriter MakeLevel() {
+
+		LevelFileWriter writer;
+		uint32_t floor = writer.AddModel("Floor", "floor");
+		uint32_t gate = writer.AddModel("Gate", "Gate");
+
+		LevelFileFormat::Object object{};
+		object.scale = { 1.0f, 1.0f, 1.0f };
+
+		object.modelIndex = floor;
+		object.translation = { 0.0f, -1.0f, 0.0f };
+		writer.objects.push_back(object);
+
+		object.modelIndex = gate;
+		object.translation = { 0.0f, 0.0f, 50.0f };
+		object.rotation = { 0.0f, 1.5f, 0.0f };
+		object.colliderType = LevelFileFormat::ColliderType::Box;
+		object.colliderCenter = { 0.0f, 2.0f, 0.0f };
+		object.colliderSize = { 4.0f, 4.0f, 1.0f };
+		writer.objects.push_back(object);
+
+		object.translation = { 0.0f, 0.0f, 100.0f };
+		object.colliderType = LevelFileFormat::ColliderType::None;
+		writer.objects.push_back(object);
+
+		writer.players.push_back({ { 0.0f, 0.0f, -10.0f }, { 0.0f, 0.0f, 0.0f } });
+		writer.enemies.push_back({ { 5.0f, 0.0f, 30.0f }, { 0.0f, 3.14f, 0.0f } });
+		writer.enemies.push_back({ { -5.0f, 0.0f, 30.0f }, { 0.0f, 3.14f, 0.0f } });
+
+		return writer;
+	}
+
+	/// <summary>
+	/// ファイルの中身を読み込む
+	/// </summary>
+	std::vector<char> ReadBytes(const std::string& filePath) {
+		std::ifstream file(filePath, std::ios::binary);
+		return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	/// <summary>
+	/// ファイルに書き込む
+	/// </summary>
+	void WriteBytes(const std::string& filePath, const std::vector<char>& bytes) {
+		std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+		file.write(bytes.data(), bytes.size());
+	}
+}
+
+TEST_CASE("BinaryLevel: 書き出した内容がそのままLevelDataになる") {
+
+	std::string filePath = MakeTempPath("RoundTrip");
+	LevelFileWriter writer = MakeLevel();
+	REQUIRE(writer.Write(filePath));
+
+	BinaryLevel level;
+	REQUIRE(level.Open(filePath));
+	CHECK(level.GetModels().size() == 2);
+	CHECK(level.GetObjects().size() == 3);
+
+	std::unique_ptr<LevelData> levelData = level.ToLevelData();
+	REQUIRE(levelData->GetObjects().size() == 3);
+
+	const LevelData::ObjectData& floor = levelData->GetObjects()[0];
+	CHECK(floor.directoryName == "Floor");
+	CHECK(floor.fileName == "floor");
+	CHECK(floor.modelID == writer.models[0].id);
+	CHECK(floor.translation.y == -1.0f);
+	CHECK(floor.collider.type.empty());
+
+	const LevelData::ObjectData& gate = levelData->GetObjects()[1];
+	CHECK(gate.fileName == "Gate");
+	CHECK(gate.rotation.y == 1.5f);
+	CHECK(gate.collider.type == "BOX");
+	CHECK(gate.collider.size.x == 4.0f);
+
+	REQUIRE(levelData->GetPlayers().size() == 1);
+	CHECK(levelData->GetPlayers()[0].translation.z == -10.0f);
+	REQUIRE(levelData->GetEnemies().size() == 2);
+	CHECK(levelData->GetEnemies()[1].translation.x == -5.0f);
+
+	level.Close();
+	CHECK(!level.IsOpen());
+	std::filesystem::remove(filePath);
+}
+
+TEST_CASE("BinaryLevel: モデルテーブルをハンドルに解決し、閉じると手放す") {
+
+	std::string filePath = MakeTempPath("ResolveModels");
+	LevelFileWriter writer = MakeLevel();
+	REQUIRE(writer.Write(filePath));
+
+	ModelManager* modelManager = ModelManager::GetInstance();
+
+	BinaryLevel level;
+	REQUIRE(level.Open(filePath));
+
+	// エクスポーターのIDとModelManagerのIDが一致しなければResolveModelsのassertで止まる
+	level.ResolveModels();
+	CHECK(modelManager->IsLoaded("Floor", "floor.obj"));
+	CHECK(modelManager->IsLoaded("Gate", "Gate.obj"));
+
+	// ハンドルを持っている間は追い出されない
+	modelManager->SetMemoryBudget(0);
+	modelManager->Trim();
+	CHECK(modelManager->IsLoaded("Floor", "floor.obj"));
+
+	// 閉じれば追い出せる
+	level.Close();
+	modelManager->Trim();
+	CHECK(!modelManager->IsLoaded("Floor", "floor.obj"));
+
+	modelManager->Finalize();
+	std::filesystem::remove(filePath);
+}
+
+TEST_CASE("BinaryLevel: 識別子やバージョンが違うファイルは開かない") {
+
+	std::string filePath = MakeTempPath("BadHeader");
+	REQUIRE(MakeLevel().Write(filePath));
+	std::vector<char> bytes = ReadBytes(filePath);
+
+	BinaryLevel level;
+
+	std::vector<char> badMagic = bytes;
+	badMagic[1] ^= 0x7F;
+	WriteBytes(filePath, badMagic);
+	CHECK(!level.Open(filePath));
+	CHECK(!level.IsOpen());
+
+	std::vector<char> badVersion = bytes;
+	uint32_t version = LevelFileFormat::kVersion + 1;
+	std::memcpy(badVersion.data() + offsetof(LevelFileFormat::Header, version), &version, sizeof(version));
+	WriteBytes(filePath, badVersion);
+	CHECK(!level.Open(filePath));
+
+	std::filesystem::remove(filePath);
+}
+
+TEST_CASE("BinaryLevel: 途中で切れたファイルや範囲外のモデル参照は開かない") {
+
+	std::string filePath = MakeTempPath("Broken");
+	LevelFileWriter writer = MakeLevel();
+	REQUIRE(writer.Write(filePath));
+	std::vector<char> bytes = ReadBytes(filePath);
+
+	BinaryLevel level;
+
+	// 途中で切る
+	for (size_t size : { sizeof(LevelFileFormat::Header) - 4, sizeof(LevelFileFormat::Header) + sizeof(LevelFileFormat::Model), bytes.size() - 1 }) {
+		WriteBytes(filePath, std::vector<char>(bytes.begin(), bytes.begin() + size));
+		CHECK(!level.Open(filePath));
+	}
+
+	// 存在しないモデルを参照する
+	writer.objects[2].modelIndex = 7;
+	REQUIRE(writer.Write(filePath));
+	CHECK(!level.Open(filePath));
+
+	std::filesystem::remove(filePath);
+}
+
+TEST_CASE("BinaryLevel: 文字列テーブルの範囲外は空文字列になる") {
+
+	std::string filePath = MakeTempPath("Strings");
+	REQUIRE(MakeLevel().Write(filePath));
+
+	BinaryLevel level;
+	REQUIRE(level.Open(filePath));
+	CHECK(level.GetString(0, 5) == "Floor");
+	CHECK(level.GetString(0, 0).empty());
+	CHECK(level.GetString(1000, 4).empty());
+	CHECK(level.GetString(2, 0xFFFFFFFF).empty());
+
+	level.Close();
+	std::filesystem::remove(filePath);
+}
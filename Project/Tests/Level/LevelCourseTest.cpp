@@ -0,0 +1,215 @@
+#include "TestFramework.h"
+#include "LevelCourse.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+using namespace Engine;
+
+/// ゲームのコース(Resources/Levels/gamePlay.json)を実際のファイルのまま読み、区間が視点の周りだけ残ることを確かめる
+/// メモリはこのテストの中のnew / deleteを数えて、生きているバイト数が走り続けても増えないことを確かめる
+
+namespace {
+
+	// 生きている割り当てのバイト数と数
+	std::atomic<int64_t> gLiveBytes = 0;
+	std::atomic<int64_t> gLiveCount = 0;
+
+	// 割り当ての先頭に大きさを書いておく領域 (返すポインタのアラインメントを保つ)
+	const size_t kHeaderSize = alignof(std::max_align_t);
+
+	/// <summary>
+	/// 大きさを記録して割り当てる
+	/// </summary>
+	void* CountedAllocate(size_t size) {
+
+		void* block = std::malloc(size + kHeaderSize);
+		if (!block) throw std::bad_alloc();
+
+		*static_cast<size_t*>(block) = size;
+		gLiveBytes += static_cast<int64_t>(size);
+		gLiveCount++;
+		return static_cast<char*>(block) + kHeaderSize;
+	}
+
+	/// <summary>
+	/// 記録した大きさを差し引いて解放する
+	/// </summary>
+	void CountedFree(void* pointer) {
+
+		if (!pointer) return;
+
+		void* block = static_cast<char*>(pointer) - kHeaderSize;
+		gLiveBytes -= static_cast<int64_t>(*static_cast<size_t*>(block));
+		gLiveCount--;
+		std::free(block);
+	}
+
+	// ゲームのコース
+	const std::string kCoursePath = std::string(ENGINE_RESOURCES_DIR) + "/Levels/gamePlay.json";
+
+	// ゲームと同じ読み込む範囲 (GamePlaySceneの設定)
+	const int32_t kLoadAhead = 5;
+	const int32_t kKeepBehind = 1;
+
+	/// <summary>
+	/// 範囲内の区間が全て解析済みになるまで進める
+	/// </summary>
+	void UpdateUntilLoaded(LevelCourse& course, float viewerCourseZ) {
+		course.Update(viewerCourseZ);
+		course.WaitLoading();
+		course.Update(viewerCourseZ);
+	}
+}
+
+void* operator new(size_t size) { return CountedAllocate(size); }
+void* operator new[](size_t size) { return CountedAllocate(size); }
+void operator delete(void* pointer) noexcept { CountedFree(pointer); }
+void operator delete[](void* pointer) noexcept { CountedFree(pointer); }
+void operator delete(void* pointer, size_t) noexcept { CountedFree(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { CountedFree(pointer); }
+
+TEST_CASE("LevelCourse: ゲームのコースは区間ごとのファイルに分かれ、区間の中身はその区間の範囲に収まる") {
+
+	LevelCourse course;
+	REQUIRE(course.Open(kCoursePath));
+	course.SetLoadAhead(kLoadAhead);
+	course.SetKeepBehind(kKeepBehind);
+
+	const float segmentLength = course.GetSegmentLength();
+	const int32_t fileCount = static_cast<int32_t>(course.GetSegmentFileCount());
+	CHECK(segmentLength == 200.0f);
+	CHECK(fileCount == 5);
+
+	// 2周目の途中に視点を置く (手前は1周目の最後の区間、先は3周目まで)
+	float viewerZ = segmentLength * static_cast<float>(fileCount) + 10.0f;
+	UpdateUntilLoaded(course, viewerZ);
+
+	CHECK(course.GetFirstIndex() == fileCount - kKeepBehind);
+	CHECK(course.GetLastIndex() == fileCount + kLoadAhead);
+	CHECK(course.GetSegmentCount() == static_cast<size_t>(kKeepBehind + kLoadAhead + 1));
+	CHECK(course.GetLoadingCount() == 0);
+
+	for (int32_t index = course.GetFirstIndex(); index <= course.GetLastIndex(); ++index) {
+
+		const LevelCourse::SegmentContent* content = course.FindContent(index);
+		REQUIRE(content);
+
+		// 床とシリンダーが区間の長さを隙間なく埋める (50ずつ4枚)
+		uint32_t floorCount = 0;
+		uint32_t cylinderCount = 0;
+		for (const LevelData::ObjectData& object : content->objects) {
+
+			// 周回分のずれを足すと区間の範囲に入る
+			float z = object.translation.z + course.GetLoopOffset(index);
+			CHECK(static_cast<float>(index) * segmentLength <= z);
+			CHECK(z < static_cast<float>(index + 1) * segmentLength);
+
+			if (object.directoryName == "Floor" && object.fileName == "floor") {
+				CHECK(object.scale.x == 50.0f && object.scale.y == 1.0f && object.scale.z == 50.0f);
+				floorCount++;
+			}
+			if (object.directoryName == "Cylinder" && object.fileName == "cylinder") {
+				cylinderCount++;
+			}
+		}
+		CHECK(floorCount == 4);
+		CHECK(cylinderCount == 4);
+	}
+
+	// 範囲外の区間は持っていない
+	CHECK(course.FindContent(course.GetFirstIndex() - 1) == nullptr);
+	CHECK(course.FindContent(course.GetLastIndex() + 1) == nullptr);
+}
+
+TEST_CASE("LevelCourse: ループしないなら終端より先は空の区間") {
+
+	LevelCourse course;
+	REQUIRE(course.Open(kCoursePath));
+	course.SetLoop(false);
+	course.SetLoadAhead(kLoadAhead);
+	course.SetKeepBehind(kKeepBehind);
+
+	// 最後の区間にいる
+	const int32_t fileCount = static_cast<int32_t>(course.GetSegmentFileCount());
+	UpdateUntilLoaded(course, course.GetSegmentLength() * (static_cast<float>(fileCount) - 0.5f));
+
+	REQUIRE(course.FindContent(fileCount - 1));
+	CHECK(!course.FindContent(fileCount - 1)->objects.empty());
+	CHECK(course.GetLoopOffset(fileCount + 1) == 0.0f);
+	for (int32_t index = fileCount; index <= course.GetLastIndex(); ++index) {
+		REQUIRE(course.FindContent(index));
+		CHECK(course.FindContent(index)->objects.empty());
+	}
+}
+
+TEST_CASE("LevelCourse: 30分走り続けても残る区間の数とメモリは増えない") {
+
+	// 区間ごとの解析のログは出さない
+	Logger::SetMinSeverity(Logger::Severity::Warning);
+
+	// 60fpsで30分、自機の自動前進と同じ速さで進む
+	const uint32_t kStepCount = 60 * 60 * 30;
+	const float kSpeed = 6.0f;
+
+	LevelCourse course;
+	REQUIRE(course.Open(kCoursePath));
+	course.SetLoadAhead(kLoadAhead);
+	course.SetKeepBehind(kKeepBehind);
+
+	const size_t maxSegmentCount = static_cast<size_t>(kKeepBehind + kLoadAhead + 1);
+	const float lapLength = course.GetSegmentLength() * static_cast<float>(course.GetSegmentFileCount());
+
+	size_t peakSegmentCount = 0;
+	int64_t baselineBytes = -1;
+	int64_t baselineCount = 0;
+	int64_t peakBytes = 0;
+	int64_t peakCount = 0;
+
+	float viewerZ = 0.0f;
+	for (uint32_t step = 0; step < kStepCount; ++step) {
+
+		// 解析は毎ステップ終わらせて、範囲外に出た区間がすぐ手放されるようにする
+		course.Update(viewerZ);
+		course.WaitLoading();
+		viewerZ += kSpeed;
+
+		peakSegmentCount = (std::max)(peakSegmentCount, course.GetSegmentCount());
+
+		// 2周して入れ物の容量が落ち着いてから計り始める
+		if (viewerZ < lapLength * 2.0f) {
+			continue;
+		}
+		if (baselineBytes < 0) {
+			baselineBytes = gLiveBytes;
+			baselineCount = gLiveCount;
+		}
+		peakBytes = (std::max)(peakBytes, gLiveBytes.load());
+		peakCount = (std::max)(peakCount, gLiveCount.load());
+	}
+
+	// 区間は読み込む範囲の分だけ
+	CHECK(peakSegmentCount <= maxSegmentCount);
+	CHECK(course.GetLoadedCount() > static_cast<uint32_t>(viewerZ / course.GetSegmentLength()));
+
+	// ワーカースレッドの後片付けの分の揺れだけ許し、周回ごとに積み上がらない (1区間の中身は数KB。650周分漏れれば数MBになる)
+	const int64_t kToleranceBytes = 64 * 1024;
+	REQUIRE(baselineBytes >= 0);
+	CHECK(peakBytes <= baselineBytes + kToleranceBytes);
+	CHECK(gLiveBytes <= baselineBytes + kToleranceBytes);
+	CHECK(peakCount <= baselineCount + 256);
+
+	TestFramework::ReportMeasurement("distance", static_cast<double>(viewerZ), "units");
+	TestFramework::ReportMeasurement("segments loaded", static_cast<double>(course.GetLoadedCount()), "");
+	TestFramework::ReportMeasurement("peak resident segments", static_cast<double>(peakSegmentCount), "");
+	TestFramework::ReportMeasurement("live heap (baseline)", static_cast<double>(baselineBytes) / 1024.0, "KB");
+	TestFramework::ReportMeasurement("live heap (peak)", static_cast<double>(peakBytes) / 1024.0, "KB");
+
+	course.Close();
+	Logger::SetMinSeverity(Logger::kCompiledMinSeverity);
+}
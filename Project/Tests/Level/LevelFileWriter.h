@@ -0,0 +1,78 @@
+#pragma once
+
+#include "LevelFileFormat.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+/// === テスト用の.levelの書き出し === ///
+/// Blenderのエクスポーター(export_scene.py)と同じレイアウトで書き出す
+class LevelFileWriter {
+
+public:
+
+	/// <summary>
+	/// モデルを追加する
+	/// </summary>
+	/// <returns>モデルテーブルのインデックス</returns>
+	uint32_t AddModel(const std::string& directoryName, const std::string& name) {
+
+		Engine::LevelFileFormat::Model model{};
+		model.id = Engine::AssetRegistry::MakeID("Resources/Models/" + directoryName + "/" + name + ".obj");
+		AddString(directoryName, model.directoryOffset, model.directoryLength);
+		AddString(name, model.nameOffset, model.nameLength);
+		models.push_back(model);
+
+		return static_cast<uint32_t>(models.size() - 1);
+	}
+
+	/// <summary>
+	/// ファイルに書き出す
+	/// </summary>
+	bool Write(const std::string& filePath) const {
+
+		Engine::LevelFileFormat::Header header{};
+		header.magic = Engine::LevelFileFormat::kMagic;
+		header.version = Engine::LevelFileFormat::kVersion;
+		header.modelCount = static_cast<uint32_t>(models.size());
+		header.objectCount = static_cast<uint32_t>(objects.size());
+		header.playerCount = static_cast<uint32_t>(players.size());
+		header.enemyCount = static_cast<uint32_t>(enemies.size());
+		header.stringTableSize = static_cast<uint32_t>(stringTable.size());
+		header.modelOffset = sizeof(header);
+		header.objectOffset = header.modelOffset + sizeof(Engine::LevelFileFormat::Model) * models.size();
+		header.playerOffset = header.objectOffset + sizeof(Engine::LevelFileFormat::Object) * objects.size();
+		header.enemyOffset = header.playerOffset + sizeof(Engine::LevelFileFormat::Spawn) * players.size();
+		header.stringTableOffset = header.enemyOffset + sizeof(Engine::LevelFileFormat::Spawn) * enemies.size();
+
+		std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(models.data()), sizeof(Engine::LevelFileFormat::Model) * models.size());
+		file.write(reinterpret_cast<const char*>(objects.data()), sizeof(Engine::LevelFileFormat::Object) * objects.size());
+		file.write(reinterpret_cast<const char*>(players.data()), sizeof(Engine::LevelFileFormat::Spawn) * players.size());
+		file.write(reinterpret_cast<const char*>(enemies.data()), sizeof(Engine::LevelFileFormat::Spawn) * enemies.size());
+		file.write(stringTable.data(), stringTable.size());
+
+		return file.good();
+	}
+
+	// 書き出す内容
+	std::vector<Engine::LevelFileFormat::Model> models;
+	std::vector<Engine::LevelFileFormat::Object> objects;
+	std::vector<Engine::LevelFileFormat::Spawn> players;
+	std::vector<Engine::LevelFileFormat::Spawn> enemies;
+
+private:
+
+	/// <summary>
+	/// 文字列テーブルに追加する
+	/// </summary>
+	void AddString(const std::string& str, uint32_t& offset, uint32_t& length) {
+		offset = static_cast<uint32_t>(stringTable.size());
+		length = static_cast<uint32_t>(str.size());
+		stringTable.insert(stringTable.end(), str.begin(), str.end());
+	}
+
+	std::vector<char> stringTable;
+};
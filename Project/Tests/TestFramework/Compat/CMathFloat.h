@@ -0,0 +1,15 @@
+#pragma once
+
+// === <cmath>のfloat版の名前(std::cosfなど)が無い標準ライブラリ用の代替 === //
+// エンジンはMSVCにあるstd::cosf / std::sinf / std::powfを使うので、グローバルの同じ関数をstdに入れる
+// CMakeLists.txtでstd::cosfが使えなかったときだけ強制的にインクルードされる
+
+#include <cmath>
+#include <math.h>
+
+namespace std {
+
+	using ::cosf;
+	using ::sinf;
+	using ::powf;
+}
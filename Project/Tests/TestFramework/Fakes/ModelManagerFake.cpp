@@ -0,0 +1,53 @@
+#include "Model/ModelManager.h"
+
+/// === テスト用のModelManager === ///
+/// Assimpやテクスチャを使わずに、空のモデルデータをキャッシュに登録するだけにする
+/// IDの求め方だけは本物と揃える (BinaryLevel::ResolveModelsがエクスポーターのIDと照合するため)
+
+using namespace Engine;
+
+ModelManager* ModelManager::instance = nullptr;
+
+ModelManager* ModelManager::GetInstance() {
+
+	if (instance == nullptr) {
+		instance = new ModelManager;
+	}
+	return instance;
+}
+
+void ModelManager::Finalize() {
+
+	delete instance;
+	instance = nullptr;
+}
+
+void ModelManager::LoadModelData(const std::string& directoryName, const std::string& fileName) {
+
+	AssetID id = MakeModelID(directoryName, fileName);
+
+	if (!modelCache_->Contains(id)) {
+		modelCache_->Insert(id, ModelData{}, sizeof(ModelData));
+	}
+}
+
+bool ModelManager::IsLoaded(const std::string& directoryName, const std::string& fileName) const {
+
+	return modelCache_->Contains(MakeModelID(directoryName, fileName));
+}
+
+ModelHandle ModelManager::AcquireModelData(const std::string& directoryName, const std::string& fileName) {
+
+	LoadModelData(directoryName, fileName);
+	return ModelHandle(modelCache_, MakeModelID(directoryName, fileName));
+}
+
+void ModelManager::Trim() {
+
+	modelCache_->Trim([](ModelData&) {});
+}
+
+AssetID ModelManager::MakeModelID(const std::string& directoryName, const std::string& fileName) const {
+
+	return AssetRegistry::MakeID(baseDirectoryPath + "/" + directoryName + "/" + fileName);
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+/// === テスト用のWinAppの代わり === ///
+/// MathVector.cppなどが参照するクライアントサイズだけを提供する
+namespace Engine {
+
+	class WinApp {
+
+	public:
+
+		// クライアント領域のサイズ
+		static const int32_t kClientWidth = 1280;
+		static const int32_t kClientHeight = 720;
+	};
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/// === ヘッドレステスト用の最小限のフレームワーク === ///
+/// D3D12やウィンドウに依存しないエンジンのファイルだけをビルドして確かめる
+namespace TestFramework {
+
+	// テストケース
+	struct TestCase {
+		const char* name;
+		const char* file;
+		std::function<void()> function;
+	};
+
+	/// <summary>
+	/// 登録済みのテストケースを取得
+	/// </summary>
+	/// <returns>テストケースの一覧</returns>
+	std::vector<TestCase>& GetTestCases();
+
+	/// <summary>
+	/// 失敗を報告する
+	/// </summary>
+	/// <param name="expression">失敗した式</param>
+	/// <param name="file">ファイル名</param>
+	/// <param name="line">行番号</param>
+	void ReportFailure(const char* expression, const char* file, int line);
+
+	/// <summary>
+	/// 計測結果を出力する (ベンチマーク用)
+	/// </summary>
+	/// <param name="label">ラベル</param>
+	/// <param name="value">値</param>
+	/// <param name="unit">単位</param>
+	void ReportMeasurement(const std::string& label, double value, const char* unit);
+
+	/// <summary>
+	/// 関数を繰り返し実行し、1回あたりの最短時間(ミリ秒)を返す
+	/// </summary>
+	/// <param name="iterations">繰り返し回数</param>
+	/// <param name="function">計測する関数</param>
+	/// <returns>最短時間(ミリ秒)</returns>
+	double MeasureMilliseconds(uint32_t iterations, const std::function<void()>& function);
+
+	// REQUIREで中断するときに投げる
+	struct RequireFailed {};
+
+	// テストケースを静的初期化で登録する
+	struct Registrar {
+		Registrar(const char* name, const char* file, std::function<void()> function) {
+			GetTestCases().push_back({ name, file, std::move(function) });
+		}
+	};
+
+	/// <summary>
+	/// 値を使ったことにする (別の翻訳単位で受け取るので、ベンチマークの計算が最適化で消されない)
+	/// </summary>
+	/// <param name="pointer">値へのポインタ</param>
+	void Consume(const void* pointer);
+
+	// ベンチマークで結果が最適化で消されないようにする
+	template <typename T>
+	void DoNotOptimize(const T& value) {
+		Consume(&value);
+	}
+}
+
+#define TEST_CONCAT_INNER(a, b) a##b
+#define TEST_CONCAT(a, b) TEST_CONCAT_INNER(a, b)
+
+// テストケースを定義する
+#define TEST_CASE(name) \
+	static void TEST_CONCAT(TestFunction_, __LINE__)(); \
+	static TestFramework::Registrar TEST_CONCAT(TestRegistrar_, __LINE__)(name, __FILE__, &TEST_CONCAT(TestFunction_, __LINE__)); \
+	static void TEST_CONCAT(TestFunction_, __LINE__)()
+
+// 失敗しても続行する
+#define CHECK(expression) \
+	do { if (!(expression)) TestFramework::ReportFailure(#expression, __FILE__, __LINE__); } while (0)
+
+// 失敗したらそのテストケースを中断する
+#define REQUIRE(expression) \
+	do { if (!(expression)) { TestFramework::ReportFailure(#expression, __FILE__, __LINE__); throw TestFramework::RequireFailed{}; } } while (0)
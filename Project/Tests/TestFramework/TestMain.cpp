@@ -0,0 +1,90 @@
+#include "TestFramework.h"
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+namespace {
+
+	// 現在のテストケースで失敗した数
+	uint32_t failureCount = 0;
+
+	// Consumeで受け取った値
+	const void* volatile consumed = nullptr;
+}
+
+std::vector<TestFramework::TestCase>& TestFramework::GetTestCases() {
+
+	static std::vector<TestCase> testCases;
+	return testCases;
+}
+
+void TestFramework::ReportFailure(const char* expression, const char* file, int line) {
+
+	std::printf("  %s(%d): %s failed\n", file, line, expression);
+	failureCount++;
+}
+
+void TestFramework::ReportMeasurement(const std::string& label, double value, const char* unit) {
+
+	std::printf("  %-48s %12.4f %s\n", label.c_str(), value, unit);
+}
+
+void TestFramework::Consume(const void* pointer) {
+
+	consumed = pointer;
+}
+
+double TestFramework::MeasureMilliseconds(uint32_t iterations, const std::function<void()>& function) {
+
+	double best = 0.0;
+
+	for (uint32_t i = 0; i < iterations; ++i) {
+
+		auto start = std::chrono::steady_clock::now();
+		function();
+		double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		// 最短時間を採用する (他プロセスの割り込みの影響を減らすため)
+		if (i == 0 || elapsed < best) best = elapsed;
+	}
+
+	return best;
+}
+
+int main(int argc, char** argv) {
+
+	// 引数があれば名前に含まれるものだけ実行する
+	const char* filter = argc > 1 ? argv[1] : nullptr;
+
+	uint32_t runCount = 0;
+	uint32_t failedCaseCount = 0;
+
+	for (const TestFramework::TestCase& testCase : TestFramework::GetTestCases()) {
+
+		if (filter && std::strstr(testCase.name, filter) == nullptr) continue;
+
+		std::printf("[ RUN  ] %s\n", testCase.name);
+		failureCount = 0;
+
+		try {
+			testCase.function();
+		}
+		catch (const TestFramework::RequireFailed&) {
+			// REQUIREで中断した (失敗は報告済み)
+		}
+		catch (const std::exception& exception) {
+			std::printf("  unexpected exception: %s\n", exception.what());
+			failureCount++;
+		}
+
+		std::printf("[ %s ] %s\n", failureCount == 0 ? " OK " : "FAIL", testCase.name);
+
+		runCount++;
+		if (failureCount != 0) failedCaseCount++;
+	}
+
+	std::printf("%u test case(s), %u failed\n", runCount, failedCaseCount);
+
+	return failedCaseCount == 0 ? 0 : 1;
+}